@@ -2,7 +2,15 @@
 
 #extension GL_EXT_buffer_reference: enable
 
-#include <libsbx/math/aabb.glsl>
+// Culls the instances of one pipeline of a material draw list against the view frustum and compacts the survivors.
+// Runs in three phases that are separated by barriers:
+//   0: Copies every culled command into the scratch buffer with an instance count of 0
+//   1: Tests every instance and appends the visible ones to the instances of their command
+//   2: Appends every command with at least one instance to its range and counts the draws per range
+
+#define PHASE_RESET 0u
+#define PHASE_CULL 1u
+#define PHASE_COMPACT 2u
 
 struct draw_indexed_indirect_command {
   uint count;
@@ -12,136 +20,141 @@ struct draw_indexed_indirect_command {
   uint base_instance;
 }; // struct draw_indexed_indirect_command
 
-struct draw_data {
-  uint transform_id;
-  uint material_id;
-}; // struct draw_data
+struct instance_data {
+  uint transform_index;
+  uint material_index;
+  uint object_id;
+  uint payload;
+}; // struct instance_data
+
+struct transform_data {
+  mat4 model;
+  mat4 normal;
+}; // struct transform_data
+
+struct cull_instance {
+  vec3 min;
+  uint command_index;
+  vec3 max;
+  uint instance_index;
+}; // struct cull_instance
+
+struct cull_command {
+  uint command_index;
+  uint range_index;
+  uint range_offset;
+  uint _pad0;
+}; // struct cull_command
+
+layout(local_size_x = 64) in;
+
+layout(std430, buffer_reference) readonly buffer draw_command_input_buffer {
+  draw_indexed_indirect_command data[];
+};
 
-layout(local_size_x = 32) in;
+layout(std430, buffer_reference) buffer draw_command_buffer {
+  draw_indexed_indirect_command data[];
+};
 
-layout(std430, buffer_reference) readonly buffer bounding_box_buffer {
-  aabb data[];
+layout(std430, buffer_reference) readonly buffer instance_data_input_buffer {
+  instance_data data[];
 };
 
-layout(std430, buffer_reference) readonly buffer draw_data_buffer {
-  draw_data data[];
+layout(std430, buffer_reference) writeonly buffer instance_data_buffer {
+  instance_data data[];
 };
 
-layout(std430, buffer_reference) buffer draw_command_buffer {
-  draw_indexed_indirect_command data[];
+layout(std430, buffer_reference) readonly buffer transform_data_buffer {
+  transform_data data[];
 };
 
-layout(std430, buffer_reference) buffer frustum_buffer {
+layout(std430, buffer_reference) readonly buffer cull_instance_buffer {
+  cull_instance data[];
+};
+
+layout(std430, buffer_reference) readonly buffer cull_command_buffer {
+  cull_command data[];
+};
+
+layout(std430, buffer_reference) buffer draw_count_buffer {
+  uint data[];
+};
+
+layout(std430, buffer_reference) readonly buffer frustum_buffer {
   vec4 planes[6];
-  vec4 corners[8];
-  uint num_meshes_to_cull;
-  uint num_visible_meshes;
 };
 
 layout(push_constant) uniform push_data {
-  draw_command_buffer draw_commands;
-  draw_data_buffer draw_data;
-  bounding_box_buffer bounding_boxes;
+  draw_command_input_buffer source_commands;
+  instance_data_input_buffer source_instances;
+  cull_instance_buffer cull_instances;
+  cull_command_buffer cull_commands;
+  draw_command_buffer scratch_commands;
+  draw_command_buffer culled_commands;
+  instance_data_buffer culled_instances;
+  draw_count_buffer draw_counts;
+  transform_data_buffer transforms;
   frustum_buffer frustum;
+  uint phase;
+  uint count;
 } push;
 
-bool is_aabb_in_frustum(aabb box) {
-  const vec3 min = aabb_get_min(box);
-  const vec3 max = aabb_get_max(box);
-
-  int r = 0;
+// Planes point inwards and already contain the margin in w
+bool is_visible(vec3 local_min, vec3 local_max, mat4 model) {
+  const vec3 local_center = (local_min + local_max) * 0.5;
+  const vec3 local_extent = (local_max - local_min) * 0.5;
 
-  for (int i = 0; i < 6; i++) {
-    r = 0;
+  const vec3 center = (model * vec4(local_center, 1.0)).xyz;
+  const vec3 extent = abs(mat3(model)) * local_extent;
 
-    r += (dot(push.frustum.planes[i], vec4(min.x, min.y, min.z, 1.0f)) < 0) ? 1 : 0;
-    r += (dot(push.frustum.planes[i], vec4(max.x, min.y, min.z, 1.0f)) < 0) ? 1 : 0;
-    r += (dot(push.frustum.planes[i], vec4(min.x, max.y, min.z, 1.0f)) < 0) ? 1 : 0;
-    r += (dot(push.frustum.planes[i], vec4(max.x, max.y, min.z, 1.0f)) < 0) ? 1 : 0;
-    r += (dot(push.frustum.planes[i], vec4(min.x, min.y, max.z, 1.0f)) < 0) ? 1 : 0;
-    r += (dot(push.frustum.planes[i], vec4(max.x, min.y, max.z, 1.0f)) < 0) ? 1 : 0;
-    r += (dot(push.frustum.planes[i], vec4(min.x, max.y, max.z, 1.0f)) < 0) ? 1 : 0;
-    r += (dot(push.frustum.planes[i], vec4(max.x, max.y, max.z, 1.0f)) < 0) ? 1 : 0;
+  for (int i = 0; i < 6; ++i) {
+    const vec4 plane = push.frustum.planes[i];
 
-    if (r == 8) {
+    if (dot(plane.xyz, center) + plane.w + dot(abs(plane.xyz), extent) < 0.0) {
       return false;
     }
   }
 
-  r = 0; 
-
-  for ( int i = 0; i < 8; i++ ) {
-    r += ((push.frustum.corners[i].x > max.x) ? 1 : 0);
-  }
-
-  if (r == 8)  {
-    return false;
-  }
-
-  r = 0; 
-  
-  for ( int i = 0; i < 8; i++ ) {
-    r += ((push.frustum.corners[i].x < min.x) ? 1 : 0);
-  }
-
-  if ( r == 8 ) {
-    return false;
-  }
-
-  r = 0; 
-  
-  for ( int i = 0; i < 8; i++ ) {
-    r += ((push.frustum.corners[i].y > max.y) ? 1 : 0);
-  }
-
-  if ( r == 8 ) {
-    return false;
-  }
+  return true;
+}
 
-  r = 0; 
-  
-  for (int i = 0; i < 8; i++) {
-    r += ((push.frustum.corners[i].y < min.y) ? 1 : 0);
-  }
+void main() {
+  const uint index = gl_GlobalInvocationID.x;
 
-  if ( r == 8 ) {
-    return false;
+  if (index >= push.count) {
+    return;
   }
 
-  r = 0; 
-  
-  for (int i = 0; i < 8; i++) {
-    r += ((push.frustum.corners[i].z > max.z) ? 1 : 0);
-  }
+  if (push.phase == PHASE_RESET) {
+    const uint command_index = push.cull_commands.data[index].command_index;
 
-  if ( r == 8 ) {
-    return false;
-  }
-  r = 0; 
-  
-  for (int i = 0; i < 8; i++) {
-    r += ((push.frustum.corners[i].z < min.z) ? 1 : 0);
-  }
+    draw_indexed_indirect_command command = push.source_commands.data[command_index];
+    command.instance_count = 0u;
 
-  if ( r == 8 ) {
-    return false;
-  }
+    push.scratch_commands.data[command_index] = command;
+  } else if (push.phase == PHASE_CULL) {
+    const cull_instance instance = push.cull_instances.data[index];
+    const instance_data data = push.source_instances.data[instance.instance_index];
 
-  return true;
-}
+    if (!is_visible(instance.min, instance.max, push.transforms.data[data.transform_index].model)) {
+      return;
+    }
 
-void main() {
-  const uint idx = gl_GlobalInvocationID.x;
+    const uint slot = atomicAdd(push.scratch_commands.data[instance.command_index].instance_count, 1u);
+    const uint target = push.scratch_commands.data[instance.command_index].base_instance + slot;
 
-  if (idx < push.frustum.num_meshes_to_cull) {
-    const uint base_instance = push.draw_commands.data[idx].base_instance;
+    push.culled_instances.data[target] = data;
+  } else if (push.phase == PHASE_COMPACT) {
+    const cull_command entry = push.cull_commands.data[index];
 
-    const aabb box = push.bounding_boxes.data[push.draw_data.data[base_instance].transform_id];
+    const draw_indexed_indirect_command command = push.scratch_commands.data[entry.command_index];
 
-    const uint num_instances = is_aabb_in_frustum(box) ? 1 : 0;
+    if (command.instance_count == 0u) {
+      return;
+    }
 
-    push.draw_commands.data[idx].instance_count = num_instances;
+    const uint slot = atomicAdd(push.draw_counts.data[entry.range_index], 1u);
 
-    atomicAdd(push.frustum.num_visible_meshes, num_instances);
+    push.culled_commands.data[entry.range_offset + slot] = command;
   }
 }
@@ -40,6 +40,7 @@ renderer::renderer()
   auto& graphics_module = sbx::core::engine::get_module<sbx::graphics::graphics_module>();
 
   auto [
+    culling,
     deferred, 
     transparency, 
     resolve,
@@ -53,9 +54,18 @@ renderer::renderer()
     selection, 
     editor
   ] = create_graph(
+    [&](sbx::graphics::render_graph::context& context) -> sbx::graphics::render_graph::compute_pass {
+      auto culling_pass = context.compute_pass("culling");
+
+      culling_pass.writes("culled_draws");
+
+      return culling_pass;
+    },
     [&](sbx::graphics::render_graph::context& context) -> sbx::graphics::render_graph::graphics_pass {
       auto deferred_pass = context.graphics_pass("deferred");
 
+      deferred_pass.uses("culled_draws");
+
       deferred_pass.produces("depth", sbx::graphics::attachment::type::depth);
       deferred_pass.produces("albedo", sbx::graphics::attachment::type::image, _clear_color, sbx::graphics::format::r8g8b8a8_unorm);
       deferred_pass.produces("position", sbx::graphics::attachment::type::image, _clear_color, sbx::graphics::format::r32g32b32a32_sfloat);
@@ -90,6 +100,8 @@ renderer::renderer()
         .color_write_mask = sbx::graphics::color_component::r
       };
 
+      transparency_pass.uses("culled_draws");
+
       transparency_pass.produces("depth", sbx::graphics::attachment::type::depth);
       transparency_pass.produces("accum", sbx::graphics::attachment::type::image, sbx::math::color{0.0f, 0.0f, 0.0f, 0.0f}, sbx::graphics::format::r32g32b32a32_sfloat, accum_blend);
       transparency_pass.produces("revealage", sbx::graphics::attachment::type::image, sbx::math::color{1.0f, 0.0f, 0.0f, 0.0f}, sbx::graphics::format::r32_sfloat, revealage_blend);
@@ -123,6 +135,7 @@ renderer::renderer()
       pass.uses("brightness");
 
       pass.produces("downsample_1", sbx::graphics::attachment::type::image, sbx::math::color::black(), sbx::graphics::format::r32g32b32a32_sfloat);
+      pass.transient("downsample_1");
 
       return pass;
     },
@@ -132,6 +145,7 @@ renderer::renderer()
       pass.uses("downsample_1");
 
       pass.produces("downsample_2", sbx::graphics::attachment::type::image, sbx::math::color::black(), sbx::graphics::format::r32g32b32a32_sfloat);
+      pass.transient("downsample_2");
 
       return pass;
     },
@@ -141,6 +155,7 @@ renderer::renderer()
       pass.uses("downsample_2");
 
       pass.produces("bloom_x", sbx::graphics::attachment::type::image, sbx::math::color::black(), sbx::graphics::format::r32g32b32a32_sfloat);
+      pass.transient("bloom_x");
 
       return pass;
     },
@@ -150,6 +165,7 @@ renderer::renderer()
       pass.uses("bloom_x");
 
       pass.produces("bloom_full", sbx::graphics::attachment::type::image, sbx::math::color::black(), sbx::graphics::format::r32g32b32a32_sfloat);
+      pass.transient("bloom_full");
 
       return pass;
     },
@@ -160,6 +176,7 @@ renderer::renderer()
       pass.uses("downsample_1");
 
       pass.produces("upsample", sbx::graphics::attachment::type::image, sbx::math::color::black(), sbx::graphics::format::r32g32b32a32_sfloat);
+      pass.transient("upsample");
 
       return pass;
     },
@@ -170,6 +187,7 @@ renderer::renderer()
       tonemap_pass.uses("upsample");
 
       tonemap_pass.produces("tonemap", sbx::graphics::attachment::type::image, _clear_color, sbx::graphics::format::r8g8b8a8_unorm);
+      tonemap_pass.transient("tonemap");
 
       return tonemap_pass;
     },
@@ -178,6 +196,7 @@ renderer::renderer()
 
       fxaa_pass.uses("tonemap");
       fxaa_pass.produces("fxaa", sbx::graphics::attachment::type::image, _clear_color, sbx::graphics::format::r8g8b8a8_unorm);
+      fxaa_pass.transient("fxaa");
 
       return fxaa_pass;
     },
@@ -199,8 +218,13 @@ renderer::renderer()
     }
   );
 
+  // culling pass
+  auto& culling_task = add_task<sbx::models::frustum_culling_task>(culling, "res://shaders/frustum_culling");
+
   // draw lists
-  add_draw_list<sbx::models::static_mesh_material_draw_list>("static_mesh_material");
+  auto& static_mesh_material_draw_list = add_draw_list<sbx::models::static_mesh_material_draw_list>("static_mesh_material");
+  static_mesh_material_draw_list.enable_gpu_culling(culling_task);
+
   add_draw_list<sbx::animations::skinned_mesh_material_draw_list>("skinned_mesh_material");
 
   // deferred pass
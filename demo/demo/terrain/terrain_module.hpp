@@ -27,7 +27,7 @@ namespace demo {
 
 class terrain_module final : public sbx::core::module<terrain_module> {
 
-  inline static const auto is_registered = register_module(stage::normal, dependencies<sbx::graphics::graphics_module, sbx::scenes::scenes_module>{});
+  inline static const auto is_registered = register_module(stage::normal, dependencies<sbx::graphics::graphics_module, sbx::scenes::scenes_module>{}, reads<>{});
 
 public:
 
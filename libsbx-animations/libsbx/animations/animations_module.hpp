@@ -19,7 +19,7 @@ namespace sbx::animations {
   
 class animations_module : public core::module<animations_module> {
 
-  inline static const auto is_registered = register_module(stage::post);
+  inline static const auto is_registered = register_module(stage::post, reads<>{}, writes<animations::animator, scenes::skinned_mesh, scenes::transform>{});
 
 public:
 
@@ -75,28 +75,38 @@ struct skinned_mesh_traits {
   inline static const auto bone_matrices_buffer_name = utility::hashed_string{"bone_matrices"};
 
   template<typename DrawList>
-  static auto create_shared_buffers(DrawList& draw_list) -> void {
+  auto create_shared_buffers(DrawList& draw_list) -> void {
     draw_list.create_buffer(bone_matrices_buffer_name, graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
   }
 
   template<typename DrawList>
-  static auto destroy_shared_buffers([[maybe_unused]] DrawList& draw_list) -> void {
+  auto destroy_shared_buffers([[maybe_unused]] DrawList& draw_list) -> void {
 
   }
 
   template<typename DrawList>
-  static auto update_shared_buffers(DrawList& draw_list) -> void {
+  auto update_shared_buffers(DrawList& draw_list) -> void {
     draw_list.update_buffer(_bone_matrices, bone_matrices_buffer_name);
     _bone_matrices.clear();
   }
 
-  template <typename Callable>
-  static auto for_each_submission(scenes::scene& scene, Callable&& callable) -> void {
+  auto prepare(scenes::scene& scene) -> void {
+    _candidates.clear();
+
     // pull id to optionally pack selection; animator is present but we only need the pose already stored in component
     const auto query = scene.query<const scenes::skinned_mesh, const scenes::selection_tag, animations::animator>();
 
     for (auto&& [node, skinned_mesh, selection_tag, animator] : query.each()) {
-      const auto transform = models::transform_data{scene.world_transform(node), scene.world_normal(node)};
+      _candidates.push_back(candidate{node, &skinned_mesh, &scene.world(node), &selection_tag});
+    }
+  }
+
+  template <typename Callable>
+  auto for_each_submission(Callable&& callable) -> void {
+    for (const auto& [node, component, world_transform, tag] : _candidates) {
+      const auto& skinned_mesh = *component;
+      const auto& world = *world_transform;
+      const auto& selection_tag = *tag;
 
       const auto bone_offset = static_cast<std::uint32_t>(_bone_matrices.size());
       const auto& pose = skinned_mesh.pose();
@@ -108,12 +118,13 @@ struct skinned_mesh_traits {
         const auto submesh_index = submesh.index;
         const auto& material_id = submesh.material;
 
-        std::invoke(callable, skinned_mesh, mesh_id, submesh_index, material_id, transform, selection_tag, instance_payload{bone_offset});
+        // Skinned meshes are always drawn at full detail
+        std::invoke(callable, skinned_mesh, node, world, mesh_id, submesh_index, 0u, material_id, selection_tag, true, instance_payload{bone_offset});
       }
     }
   }
 
-  static auto make_instance_data(std::uint32_t transform_index, std::uint32_t material_index, const scenes::selection_tag& selection_tag, const instance_payload& payload) -> models::instance_data {
+  auto make_instance_data(std::uint32_t transform_index, std::uint32_t material_index, const scenes::selection_tag& selection_tag, const instance_payload& payload) -> models::instance_data {
     auto [entry, created] = _selection_tags.try_emplace(selection_tag, 0u);
 
     if (created && selection_tag != scenes::selection_tag::null) {
@@ -125,8 +136,16 @@ struct skinned_mesh_traits {
 
 private:
 
-  inline static auto _bone_matrices = std::vector<math::matrix4x4>{};
-  inline static auto _selection_tags = std::unordered_map<scenes::selection_tag, std::uint32_t>{};
+  struct candidate {
+    scenes::node node;
+    const scenes::skinned_mesh* component;
+    const scenes::global_transform* world;
+    const scenes::selection_tag* selection_tag;
+  }; // struct candidate
+
+  std::vector<math::matrix4x4> _bone_matrices;
+  std::unordered_map<scenes::selection_tag, std::uint32_t> _selection_tags;
+  std::vector<candidate> _candidates;
 
 }; // struct skinned_mesh_traits
 
@@ -149,10 +168,38 @@ public:
   skinned_mesh_subrenderer(const graphics::render_graph::graphics_pass& pass, const std::filesystem::path& base_pipeline, const skinned_mesh_material_draw_list::bucket bucket) 
   : graphics::subrenderer{pass}, 
     _base_pipeline{base_pipeline}, 
-    _bucket{bucket} { }
+    _bucket{bucket} {
+    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+    auto requests = std::vector<graphics::compiler::compile_request>{};
+    requests.reserve(_fs_entry.size());
+
+    for (const auto& entry_point : _fs_entry) {
+      requests.push_back(graphics::compiler::compile_request{
+        .path = _base_pipeline,
+        .per_stage = {
+          {SLANG_STAGE_VERTEX, {.entry_point = "skinned_main"}},
+          {SLANG_STAGE_FRAGMENT, {.entry_point = entry_point}}
+        }
+      });
+    }
 
-  ~skinned_mesh_subrenderer() override {
-    _pipeline_cache.clear();
+    // The alpha mode variants are independent, so they are compiled in parallel up front instead of one by one on first use
+    _compiled_shaders = graphics_module.compiler().compile(requests);
+  }
+
+  ~skinned_mesh_subrenderer() override = default;
+
+  auto is_thread_safe() const noexcept -> bool override {
+    return true;
+  }
+
+  auto prepare() -> void override {
+    auto& draw_list = pass().template draw_list<skinned_mesh_material_draw_list>("skinned_mesh_material");
+
+    for (const auto& [key, data] : draw_list.ranges(_bucket)) {
+      _get_or_create_pipeline(key, pass());
+    }
   }
 
   auto render(graphics::command_buffer& command_buffer) -> void override {
@@ -164,14 +211,15 @@ public:
     auto& draw_list = pass().template draw_list<skinned_mesh_material_draw_list>("skinned_mesh_material");
 
     for (auto& [key, data] : draw_list.ranges(_bucket)) {
-      auto& pipeline_data = _get_or_create_pipeline(key, pass());
+      // Created in prepare, render may run on a worker thread
+      auto& pipeline_data = _pipeline_cache.at(key);
       auto& pipeline = graphics_module.get_resource<graphics::graphics_pipeline>(pipeline_data.pipeline);
 
       pipeline.bind(command_buffer);
 
-      pipeline_data.scene_descriptor_handler.push("scene", scene.uniform_handler());
-      pipeline_data.scene_descriptor_handler.push("images_sampler", draw_list.sampler());
-      pipeline_data.scene_descriptor_handler.push("images", draw_list.images());
+      pipeline_data.scene_descriptor_handler.push(pipeline_data.scene_slot, scene.uniform_handler());
+      pipeline_data.scene_descriptor_handler.push(pipeline_data.images_sampler_slot, draw_list.sampler());
+      pipeline_data.scene_descriptor_handler.push(pipeline_data.images_slot, draw_list.images());
 
       if (!pipeline_data.scene_descriptor_handler.update(pipeline)) {
         return;
@@ -199,7 +247,13 @@ public:
 
         auto& draw_commands_buffer = graphics_module.get_resource<graphics::storage_buffer>(data.draw_commands_buffer);
 
-        command_buffer.draw_indexed_indirect(draw_commands_buffer, range_ref.range.offset, range_ref.range.count);
+        if (data.draw_count_buffer) {
+          auto& draw_count_buffer = graphics_module.get_resource<graphics::storage_buffer>(data.draw_count_buffer);
+
+          command_buffer.draw_indexed_indirect_count(draw_commands_buffer, range_ref.range.offset, draw_count_buffer, range_ref.draw_count_index, range_ref.range.count);
+        } else {
+          command_buffer.draw_indexed_indirect(draw_commands_buffer, range_ref.range.offset, range_ref.range.count);
+        }
       }
     }
   }
@@ -211,11 +265,17 @@ private:
     graphics::graphics_pipeline_handle pipeline;
     graphics::push_handler push_handler;
     graphics::descriptor_handler scene_descriptor_handler;
+    graphics::descriptor_handler::binding_slot scene_slot;
+    graphics::descriptor_handler::binding_slot images_sampler_slot;
+    graphics::descriptor_handler::binding_slot images_slot;
 
     pipeline_data(const graphics::graphics_pipeline_handle& handle)
     : pipeline{handle},
       push_handler{pipeline}, 
-      scene_descriptor_handler{pipeline, 0u} { }
+      scene_descriptor_handler{pipeline, 0u},
+      scene_slot{scene_descriptor_handler.slot("scene")},
+      images_sampler_slot{scene_descriptor_handler.slot("images_sampler")},
+      images_slot{scene_descriptor_handler.slot("images")} { }
 
   }; // struct pipeline_data
 
@@ -231,17 +291,7 @@ private:
     definition.rasterization_state.cull_mode = key.is_double_sided ? graphics::cull_mode::none : graphics::cull_mode::back;
     definition.uses_transparency = (static_cast<models::alpha_mode>(key.alpha) == models::alpha_mode::blend);
 
-    auto& compiler = graphics_module.compiler();
-
-    const auto request = graphics::compiler::compile_request{
-      .path = _base_pipeline,
-      .per_stage = {
-        {SLANG_STAGE_VERTEX, {.entry_point = "skinned_main"}},
-        {SLANG_STAGE_FRAGMENT, {.entry_point = _fs_entry.at(key.alpha)}}
-      }
-    };
-
-    const auto result = compiler.compile(request);
+    const auto& result = _compiled_shaders.at(key.alpha);
 
     auto compiled = graphics::graphics_pipeline::compiled_shaders{ _base_pipeline.filename().string(), result.code };
     auto handle = graphics_module.add_resource<graphics::graphics_pipeline>(compiled, pass, definition);
@@ -260,8 +310,8 @@ private:
 
   std::filesystem::path _base_pipeline;
   skinned_mesh_material_draw_list::bucket _bucket;
-
-  inline static std::unordered_map<models::material_key, pipeline_data, models::material_key_hash> _pipeline_cache{};
+  std::vector<graphics::compiler::compile_result> _compiled_shaders;
+  std::unordered_map<models::material_key, pipeline_data, models::material_key_hash> _pipeline_cache;
   
 }; // class skinned_mesh_subrenderer
 
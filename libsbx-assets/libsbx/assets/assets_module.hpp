@@ -18,8 +18,9 @@
 #include <libsbx/math/uuid.hpp>
 
 #include <libsbx/core/module.hpp>
+#include <libsbx/core/engine.hpp>
 
-#include <libsbx/assets/thread_pool.hpp>
+#include <libsbx/assets/job_system.hpp>
 #include <libsbx/assets/metadata.hpp>
 
 namespace sbx::assets {
@@ -146,14 +147,15 @@ private:
 
 class assets_module : public core::module<assets_module> {
 
-  inline static const auto is_registered = register_module(stage::post);
+  // Assets are loaded through the job system, the update itself does not touch any shared state
+  inline static const auto is_registered = register_module(stage::post, reads<>{});
 
   inline static constexpr auto prefix = std::string_view{"res://"};
 
 public:
 
   assets_module()
-  : _thread_pool{std::thread::hardware_concurrency()},
+  : _job_system{core::engine::executor()},
     _asset_root{std::filesystem::current_path()} {
     utility::logger<"assets">::info("4cc of 'IMAG': {:#010x}", fourcc<"IMAG">());
   }
@@ -198,8 +200,27 @@ public:
 
   template<typename Function, typename... Args>
   requires (std::is_invocable_v<Function, Args...>)
-  auto submit(Function&& function, Args&&... args) -> std::future<std::invoke_result_t<Function, Args...>> {
-    return _thread_pool.submit(std::forward<Function>(function), std::forward<Args>(args)...);
+  [[nodiscard]] auto submit(Function&& function, Args&&... args) -> job_future<std::invoke_result_t<Function, Args...>> {
+    return _job_system.submit(std::forward<Function>(function), std::forward<Args>(args)...);
+  }
+
+  template<typename Function, typename... Args>
+  requires (std::is_invocable_v<Function, Args...>)
+  [[nodiscard]] auto submit(const job_priority priority, Function&& function, Args&&... args) -> job_future<std::invoke_result_t<Function, Args...>> {
+    return _job_system.submit(priority, std::forward<Function>(function), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Schedules a job whose result is not needed. Does not allocate a result state.
+   */
+  template<typename Function, typename... Args>
+  requires (std::is_invocable_v<Function, Args...>)
+  auto dispatch(const job_priority priority, Function&& function, Args&&... args) -> void {
+    _job_system.dispatch(priority, std::forward<Function>(function), std::forward<Args>(args)...);
+  }
+
+  auto job_system() -> assets::job_system& {
+    return _job_system;
   }
 
   template<utility::string_literal Type, typename... Args>
@@ -280,7 +301,7 @@ public:
 
 private:
 
-  thread_pool _thread_pool;
+  assets::job_system _job_system;
   std::filesystem::path _asset_root;
 
   struct container_base {
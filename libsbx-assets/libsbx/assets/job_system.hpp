@@ -0,0 +1,936 @@
+#ifndef LIBSBX_ASSETS_JOB_SYSTEM_HPP_
+#define LIBSBX_ASSETS_JOB_SYSTEM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <random>
+#include <optional>
+#include <exception>
+#include <functional>
+#include <span>
+#include <utility>
+#include <type_traits>
+
+#include <libsbx/utility/assert.hpp>
+#include <libsbx/utility/enum.hpp>
+#include <libsbx/utility/logger.hpp>
+#include <libsbx/utility/small_function.hpp>
+#include <libsbx/utility/exception.hpp>
+
+#include <libsbx/memory/cache.hpp>
+#include <libsbx/memory/thread_local_pool.hpp>
+
+#include <libsbx/containers/work_stealing_deque.hpp>
+#include <libsbx/containers/executor.hpp>
+
+namespace sbx::assets {
+
+/**
+ * @brief Scheduling class of a job. Workers always prefer jobs of a higher class.
+ */
+enum class job_priority : std::uint8_t {
+  frame_critical,
+  streaming,
+  background
+}; // enum class job_priority
+
+/**
+ * @brief Exception that the future of a job carries if the job has been cancelled before it started.
+ */
+struct job_cancelled : public utility::runtime_error {
+
+  job_cancelled()
+  : utility::runtime_error{"Job has been cancelled"} { }
+
+}; // struct job_cancelled
+
+class job_system;
+
+template<typename Type>
+class job_future;
+
+namespace detail {
+
+inline constexpr auto job_priority_count = std::size_t{3u};
+
+inline constexpr auto job_block_size = std::size_t{128u};
+
+using job_block_pool = memory::thread_local_pool<job_block_size>;
+
+template<typename Type>
+inline constexpr auto is_pooled_v = sizeof(Type) <= job_block_size && alignof(Type) <= alignof(std::max_align_t);
+
+template<typename Type, typename... Args>
+requires (is_pooled_v<Type>)
+auto make_pooled(Args&&... args) -> Type* {
+  auto* block = job_block_pool::allocate();
+
+  try {
+    return ::new (block) Type{std::forward<Args>(args)...};
+  } catch (...) {
+    job_block_pool::deallocate(block);
+    throw;
+  }
+}
+
+template<typename Type>
+requires (is_pooled_v<Type>)
+auto destroy_pooled(Type* object) noexcept -> void {
+  std::destroy_at(object);
+  job_block_pool::deallocate(object);
+}
+
+/**
+ * @brief A unit of work. Jobs are allocated from the block pool and small callables are stored inline, so scheduling a job does not touch the heap in the common case.
+ */
+struct job {
+
+  inline static constexpr auto storage_size = std::size_t{96u};
+
+  utility::small_function<void(), storage_size> work;
+  // Intrusive link used by the injection stacks and continuation lists
+  job* next{nullptr};
+  job_priority priority{job_priority::streaming};
+  // Inline jobs are executed directly by the thread that completes the antecedent instead of being scheduled
+  bool is_inline{false};
+
+}; // struct job
+
+static_assert(sizeof(job) <= job_block_size, "Jobs must fit into a single pool block");
+
+/**
+ * @brief Reference counted completion state shared between a job and its futures.
+ */
+class state_base {
+
+public:
+
+  using destroy_function = void(*)(state_base*) noexcept;
+
+  state_base(job_system* system, destroy_function destroy) noexcept
+  : _system{system},
+    _destroy{destroy},
+    _references{1u},
+    _is_ready{false},
+    _is_cancel_requested{false},
+    _continuations{nullptr} { }
+
+  state_base(const state_base& other) = delete;
+
+  state_base(state_base&& other) = delete;
+
+  auto operator=(const state_base& other) -> state_base& = delete;
+
+  auto operator=(state_base&& other) -> state_base& = delete;
+
+  auto acquire() noexcept -> void {
+    _references.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  auto release() noexcept -> void {
+    if (_references.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+      std::invoke(_destroy, this);
+    }
+  }
+
+  [[nodiscard]] auto system() const noexcept -> job_system* {
+    return _system;
+  }
+
+  [[nodiscard]] auto is_ready() const noexcept -> bool {
+    return _is_ready.load(std::memory_order_acquire);
+  }
+
+  /**
+   * @brief Blocks the calling thread until the state is ready. Workers must use job_system::_wait instead.
+   */
+  auto wait() const noexcept -> void {
+    _is_ready.wait(false, std::memory_order_acquire);
+  }
+
+  auto request_cancel() noexcept -> void {
+    _is_cancel_requested.store(true, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto is_cancel_requested() const noexcept -> bool {
+    return _is_cancel_requested.load(std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto exception() const noexcept -> const std::exception_ptr& {
+    return _exception;
+  }
+
+  auto set_exception(std::exception_ptr exception) noexcept -> void {
+    _exception = std::move(exception);
+  }
+
+  /**
+   * @brief Adds a continuation that is run once the state is ready.
+   *
+   * @return false if the state is already ready. The continuation has not been added and must be run by the caller.
+   */
+  auto attach(job* continuation) noexcept -> bool {
+    auto* head = _continuations.load(std::memory_order_acquire);
+
+    do {
+      if (head == _closed()) {
+        return false;
+      }
+
+      continuation->next = head;
+    } while (!_continuations.compare_exchange_weak(head, continuation, std::memory_order_acq_rel, std::memory_order_acquire));
+
+    return true;
+  }
+
+  /**
+   * @brief Marks the state as ready, wakes up blocked threads and runs or schedules all attached continuations.
+   */
+  auto complete() -> void;
+
+protected:
+
+  ~state_base() = default;
+
+private:
+
+  static auto _closed() noexcept -> job* {
+    static auto sentinel = job{};
+    return &sentinel;
+  }
+
+  job_system* _system;
+  destroy_function _destroy;
+  std::atomic<std::uint32_t> _references;
+  std::atomic_bool _is_ready;
+  std::atomic_bool _is_cancel_requested;
+  std::atomic<job*> _continuations;
+  std::exception_ptr _exception;
+
+}; // class state_base
+
+template<typename Type>
+class state final : public state_base {
+
+public:
+
+  explicit state(job_system* system) noexcept
+  : state_base{system, &state::_destroy_self} { }
+
+  ~state() = default;
+
+  [[nodiscard]] static auto create(job_system* system) -> state* {
+    if constexpr (is_pooled_v<state>) {
+      return make_pooled<state>(system);
+    } else {
+      return new state{system};
+    }
+  }
+
+  template<typename... Args>
+  auto set_value(Args&&... args) -> void {
+    _value.emplace(std::forward<Args>(args)...);
+  }
+
+  [[nodiscard]] auto value() -> Type& {
+    return *_value;
+  }
+
+private:
+
+  static auto _destroy_self(state_base* base) noexcept -> void {
+    auto* self = static_cast<state*>(base);
+
+    if constexpr (is_pooled_v<state>) {
+      destroy_pooled(self);
+    } else {
+      delete self;
+    }
+  }
+
+  std::optional<Type> _value;
+
+}; // class state
+
+template<>
+class state<void> final : public state_base {
+
+public:
+
+  explicit state(job_system* system) noexcept
+  : state_base{system, &state::_destroy_self} { }
+
+  ~state() = default;
+
+  [[nodiscard]] static auto create(job_system* system) -> state* {
+    return make_pooled<state>(system);
+  }
+
+  auto set_value() noexcept -> void { }
+
+private:
+
+  static auto _destroy_self(state_base* base) noexcept -> void {
+    destroy_pooled(static_cast<state*>(base));
+  }
+
+}; // class state
+
+/**
+ * @brief Shared counter of a when_all combinator.
+ */
+struct join_state {
+  std::atomic<std::size_t> remaining;
+  std::atomic_bool has_exception;
+  state<void>* result;
+}; // struct join_state
+
+template<typename Type, typename Function>
+struct is_continuation : std::is_invocable<Function, Type&> { };
+
+template<typename Function>
+struct is_continuation<void, Function> : std::is_invocable<Function> { };
+
+template<typename Type, typename Function>
+inline constexpr auto is_continuation_v = is_continuation<Type, Function>::value;
+
+template<typename Type, typename Function>
+struct continuation_result {
+  using type = std::invoke_result_t<Function, Type&>;
+}; // struct continuation_result
+
+template<typename Function>
+struct continuation_result<void, Function> {
+  using type = std::invoke_result_t<Function>;
+}; // struct continuation_result
+
+template<typename Type, typename Function>
+using continuation_result_t = typename continuation_result<Type, Function>::type;
+
+} // namespace detail
+
+/**
+ * @brief Handle to the result of a job.
+ *
+ * Futures are cheap to copy. Waiting on a future from inside a job never blocks the worker, it keeps executing other jobs until the result is ready.
+ */
+template<typename Type>
+class job_future {
+
+  friend class job_system;
+
+  template<typename Other>
+  friend class job_future;
+
+  using state_type = detail::state<Type>;
+
+public:
+
+  using value_type = Type;
+
+  job_future() noexcept
+  : _state{nullptr} { }
+
+  job_future(const job_future& other) noexcept
+  : _state{other._state} {
+    if (_state) {
+      _state->acquire();
+    }
+  }
+
+  job_future(job_future&& other) noexcept
+  : _state{std::exchange(other._state, nullptr)} { }
+
+  ~job_future() {
+    if (_state) {
+      _state->release();
+    }
+  }
+
+  auto operator=(const job_future& other) noexcept -> job_future& {
+    if (this != &other) {
+      auto copy = job_future{other};
+      std::swap(_state, copy._state);
+    }
+
+    return *this;
+  }
+
+  auto operator=(job_future&& other) noexcept -> job_future& {
+    if (this != &other) {
+      auto moved = job_future{std::move(other)};
+      std::swap(_state, moved._state);
+    }
+
+    return *this;
+  }
+
+  [[nodiscard]] auto is_valid() const noexcept -> bool {
+    return _state != nullptr;
+  }
+
+  [[nodiscard]] auto is_ready() const noexcept -> bool {
+    return _state && _state->is_ready();
+  }
+
+  auto wait() const -> void;
+
+  /**
+   * @brief Requests the job to be cancelled. A job that has not started yet is skipped and the future completes with job_cancelled, which is
+   * forwarded to its continuations. Jobs that are already running complete normally.
+   */
+  auto cancel() const -> void {
+    utility::assert_that(_state != nullptr, "Cannot cancel an invalid job_future");
+
+    _state->request_cancel();
+  }
+
+  /**
+   * @brief Waits for the result and returns it. Rethrows the exception thrown by the job.
+   */
+  auto get() const -> std::add_lvalue_reference_t<Type>;
+
+  /**
+   * @brief Schedules a continuation that is invoked with the result of this future once it is ready. No thread waits for the result in the meantime.
+   *
+   * If this future completes with an exception the continuation is skipped and the exception is forwarded to the returned future.
+   */
+  template<typename Function>
+  requires (detail::is_continuation_v<Type, Function>)
+  auto then(job_priority priority, Function&& function) const -> job_future<detail::continuation_result_t<Type, Function>>;
+
+  template<typename Function>
+  requires (detail::is_continuation_v<Type, Function>)
+  auto then(Function&& function) const -> job_future<detail::continuation_result_t<Type, Function>> {
+    return then(job_priority::streaming, std::forward<Function>(function));
+  }
+
+private:
+
+  // Adopts a reference that has already been acquired
+  explicit job_future(state_type* state) noexcept
+  : _state{state} { }
+
+  state_type* _state;
+
+}; // class job_future
+
+/**
+ * @brief Lock-free job system with priority classes and continuations that runs on the workers of a containers::executor.
+ *
+ * The job system does not own any threads. It registers itself as a work source of the executor and every worker of the executor gets one work-stealing
+ * deque per priority class. Scheduling a job only pushes it and wakes a sleeping worker, it never allocates or locks. Idle workers poll the job
+ * system and steal from the others, always draining higher priority classes first. Jobs submitted from threads that are not workers are pushed onto lock-free injection stacks that workers take over as a whole.
+ * Results are delivered through job_futures whose continuations are scheduled by the completing worker, so dependent work never blocks a worker.
+ */
+class job_system final : public containers::work_source {
+
+  template<typename Type>
+  friend class job_future;
+
+  friend class detail::state_base;
+
+  using job_type = detail::job;
+
+  struct worker {
+    std::size_t id;
+    std::array<containers::work_stealing_deque<job_type*>, detail::job_priority_count> queues;
+    std::minstd_rand random;
+  }; // struct worker
+
+  inline static constexpr auto steal_attempts = std::size_t{32u};
+
+public:
+
+  /**
+   * @brief Creates a job system on the workers of the executor. The executor must outlive the job system. Jobs run inline if the executor has no workers.
+   */
+  explicit job_system(containers::executor& executor)
+  : _executor{executor},
+    _pending{0u} {
+    _workers.reserve(_executor.size());
+
+    for (auto i = 0u; i < _executor.size(); ++i) {
+      auto& entry = _workers.emplace_back(std::make_unique<worker>());
+
+      entry->id = i;
+      entry->random.seed(static_cast<std::minstd_rand::result_type>(i + 1u));
+    }
+
+    if (!_workers.empty()) {
+      _executor.add_source(*this);
+    }
+  }
+
+  job_system(const job_system& other) = delete;
+
+  job_system(job_system&& other) = delete;
+
+  /**
+   * @brief Waits until all scheduled jobs have been executed.
+   */
+  ~job_system() override {
+    while (_pending.load(std::memory_order_acquire) > 0u) {
+      auto* current = _current_worker();
+
+      if (auto* job = (current != nullptr) ? _find_work(current) : nullptr) {
+        _run(job);
+      } else {
+        std::this_thread::yield();
+      }
+    }
+
+    if (!_workers.empty()) {
+      _executor.remove_source(*this);
+    }
+  }
+
+  auto operator=(const job_system& other) -> job_system& = delete;
+
+  auto operator=(job_system&& other) -> job_system& = delete;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return _workers.size();
+  }
+
+  /**
+   * @brief Returns the index of the calling worker or std::nullopt if the calling thread is not a worker of the executor.
+   */
+  [[nodiscard]] auto this_worker_id() const noexcept -> std::optional<std::size_t> {
+    return _executor.this_worker_id();
+  }
+
+  /**
+   * @brief Schedules a job and returns a future for its result.
+   */
+  template<typename Function, typename... Args>
+  requires (std::is_invocable_v<Function, Args...>)
+  [[nodiscard]] auto submit(const job_priority priority, Function&& function, Args&&... args) -> job_future<std::invoke_result_t<Function, Args...>> {
+    using result_type = std::invoke_result_t<Function, Args...>;
+
+    auto* state = detail::state<result_type>::create(this);
+    auto future = job_future<result_type>{state};
+
+    state->acquire();
+
+    _schedule(_make_job(priority, false, [state, function = std::forward<Function>(function), ...args = std::forward<Args>(args)]() mutable {
+      auto guard = job_future<result_type>{state};
+
+      if (state->is_cancel_requested()) {
+        state->set_exception(std::make_exception_ptr(job_cancelled{}));
+      } else {
+        try {
+          if constexpr (std::is_void_v<result_type>) {
+            std::invoke(function, std::move(args)...);
+            state->set_value();
+          } else {
+            state->set_value(std::invoke(function, std::move(args)...));
+          }
+        } catch (...) {
+          state->set_exception(std::current_exception());
+        }
+      }
+
+      state->complete();
+    }));
+
+    return future;
+  }
+
+  template<typename Function, typename... Args>
+  requires (std::is_invocable_v<Function, Args...>)
+  [[nodiscard]] auto submit(Function&& function, Args&&... args) -> job_future<std::invoke_result_t<Function, Args...>> {
+    return submit(job_priority::streaming, std::forward<Function>(function), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Schedules a job without a result. Cheaper than submit since no result state is allocated. Exceptions thrown by the job are logged.
+   */
+  template<typename Function, typename... Args>
+  requires (std::is_invocable_v<Function, Args...>)
+  auto dispatch(const job_priority priority, Function&& function, Args&&... args) -> void {
+    _schedule(_make_job(priority, false, [function = std::forward<Function>(function), ...args = std::forward<Args>(args)]() mutable {
+      std::invoke(function, std::move(args)...);
+    }));
+  }
+
+  template<typename Function, typename... Args>
+  requires (std::is_invocable_v<Function, Args...>)
+  auto dispatch(Function&& function, Args&&... args) -> void {
+    dispatch(job_priority::streaming, std::forward<Function>(function), std::forward<Args>(args)...);
+  }
+
+  /**
+   * @brief Returns a future that becomes ready once all given futures are ready. Carries the first exception of the inputs.
+   */
+  template<typename... Types>
+  [[nodiscard]] auto when_all(const job_future<Types>&... futures) -> job_future<void> {
+    const auto states = std::array<detail::state_base*, sizeof...(Types)>{futures._state...};
+
+    return _when_all(states);
+  }
+
+  template<typename Type>
+  [[nodiscard]] auto when_all(std::span<const job_future<Type>> futures) -> job_future<void> {
+    auto states = std::vector<detail::state_base*>{};
+    states.reserve(futures.size());
+
+    for (const auto& future : futures) {
+      states.push_back(future._state);
+    }
+
+    return _when_all(states);
+  }
+
+private:
+
+  [[nodiscard]] static auto _index(const job_priority priority) noexcept -> std::size_t {
+    return static_cast<std::size_t>(utility::to_underlying(priority));
+  }
+
+  auto _current_worker() const noexcept -> worker* {
+    if (const auto id = _executor.this_worker_id()) {
+      return _workers[*id].get();
+    }
+
+    return nullptr;
+  }
+
+  template<typename Function>
+  auto _make_job(const job_priority priority, const bool is_inline, Function&& function) -> job_type* {
+    return detail::make_pooled<job_type>(std::forward<Function>(function), nullptr, priority, is_inline);
+  }
+
+  auto _when_all(std::span<detail::state_base* const> states) -> job_future<void> {
+    auto* result = detail::state<void>::create(this);
+    auto future = job_future<void>{result};
+
+    if (states.empty()) {
+      result->complete();
+      return future;
+    }
+
+    result->acquire();
+
+    auto* join = detail::make_pooled<detail::join_state>(states.size(), false, result);
+
+    for (auto* antecedent : states) {
+      antecedent->acquire();
+
+      _attach(*antecedent, _make_job(job_priority::frame_critical, true, [join, antecedent](){
+        if (antecedent->exception() && !join->has_exception.exchange(true, std::memory_order_relaxed)) {
+          join->result->set_exception(antecedent->exception());
+        }
+
+        antecedent->release();
+
+        if (join->remaining.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+          auto* result = join->result;
+
+          detail::destroy_pooled(join);
+
+          result->complete();
+          result->release();
+        }
+      }));
+    }
+
+    return future;
+  }
+
+  auto _attach(detail::state_base& antecedent, job_type* continuation) -> void {
+    if (!antecedent.attach(continuation)) {
+      _run_continuation(continuation);
+    }
+  }
+
+  auto _run_continuation(job_type* continuation) -> void {
+    if (continuation->is_inline) {
+      _execute(continuation);
+    } else {
+      _schedule(continuation);
+    }
+  }
+
+  auto _schedule(job_type* job) -> void {
+    if (_workers.empty()) {
+      _execute(job);
+      return;
+    }
+
+    const auto index = _index(job->priority);
+
+    if (auto* current = _current_worker()) {
+      current->queues[index].push(job);
+    } else {
+      _inject(job);
+    }
+
+    _pending.fetch_add(1u, std::memory_order_relaxed);
+    _queued[index].data.fetch_add(1, std::memory_order_seq_cst);
+
+    _executor.notify();
+  }
+
+  auto _inject(job_type* job) -> void {
+    auto& head = _injected[_index(job->priority)].data;
+    auto* top = head.load(std::memory_order_relaxed);
+
+    do {
+      job->next = top;
+    } while (!head.compare_exchange_weak(top, job, std::memory_order_release, std::memory_order_relaxed));
+  }
+
+  /**
+   * @brief Takes over all injected jobs of the priority class. The oldest one is returned, the others are moved to the local queue of the worker.
+   *
+   * Threads that are not workers of the executor, e.g. a thread that helps executing a task graph, push the others back onto the injection stack.
+   */
+  auto _take_injected(worker* current, const std::size_t index) -> job_type* {
+    auto& head = _injected[index].data;
+
+    if (head.load(std::memory_order_relaxed) == nullptr) {
+      return nullptr;
+    }
+
+    auto* list = head.exchange(nullptr, std::memory_order_acquire);
+
+    // The stack is in LIFO order, reverse it to run injected jobs in submission order
+    auto* reversed = static_cast<job_type*>(nullptr);
+
+    while (list != nullptr) {
+      auto* next = list->next;
+      list->next = reversed;
+      reversed = list;
+      list = next;
+    }
+
+    if (reversed == nullptr) {
+      return nullptr;
+    }
+
+    for (auto* job = reversed->next; job != nullptr;) {
+      auto* next = job->next;
+
+      if (current != nullptr) {
+        current->queues[index].push(job);
+      } else {
+        _inject(job);
+      }
+
+      job = next;
+    }
+
+    return reversed;
+  }
+
+  auto _take(worker* current, const std::size_t index) -> job_type* {
+    if (current != nullptr) {
+      if (auto job = current->queues[index].pop()) {
+        return *job;
+      }
+    }
+
+    if (auto* job = _take_injected(current, index)) {
+      return job;
+    }
+
+    const auto count = _workers.size();
+
+    for (auto attempt = 0u; attempt < steal_attempts; ++attempt) {
+      const auto victim = (current != nullptr) ? current->random() % count : attempt % count;
+
+      if (current != nullptr && victim == current->id) {
+        continue;
+      }
+
+      if (auto job = _workers[victim]->queues[index].steal()) {
+        return *job;
+      }
+    }
+
+    return nullptr;
+  }
+
+  auto _find_work(worker* current) -> job_type* {
+    for (auto index = 0u; index < detail::job_priority_count; ++index) {
+      if (_queued[index].data.load(std::memory_order_relaxed) <= 0) {
+        continue;
+      }
+
+      if (auto* job = _take(current, index)) {
+        _queued[index].data.fetch_sub(1, std::memory_order_relaxed);
+        return job;
+      }
+    }
+
+    return nullptr;
+  }
+
+  auto try_run(const std::optional<std::size_t> worker_id) -> bool override {
+    auto* current = worker_id ? _workers[*worker_id].get() : nullptr;
+
+    if (auto* job = _find_work(current)) {
+      _run(job);
+      return true;
+    }
+
+    return false;
+  }
+
+  [[nodiscard]] auto has_work() const noexcept -> bool override {
+    for (const auto& queued : _queued) {
+      if (queued.data.load(std::memory_order_seq_cst) > 0) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Executes a job that has been taken from a queue.
+   */
+  auto _run(job_type* job) -> void {
+    _execute(job);
+
+    // Last access to the job system for the final job, it may be destroyed right after this
+    _pending.fetch_sub(1u, std::memory_order_release);
+  }
+
+  auto _execute(job_type* job) -> void {
+    try {
+      std::invoke(job->work);
+    } catch (const std::exception& exception) {
+      utility::logger<"assets">::error("Job failed: {}", exception.what());
+    } catch (...) {
+      utility::logger<"assets">::error("Job failed with an unknown exception");
+    }
+
+    detail::destroy_pooled(job);
+  }
+
+  /**
+   * @brief Waits until the state is ready. Workers keep executing jobs while waiting, other threads block.
+   */
+  auto _wait(const detail::state_base& state) -> void {
+    if (state.is_ready()) {
+      return;
+    }
+
+    if (auto* current = _current_worker()) {
+      while (!state.is_ready()) {
+        if (auto* job = _find_work(current)) {
+          _run(job);
+        } else {
+          std::this_thread::yield();
+        }
+      }
+    } else {
+      state.wait();
+    }
+  }
+
+  containers::executor& _executor;
+
+  std::vector<std::unique_ptr<worker>> _workers;
+
+  std::array<memory::cacheline_aligned<std::atomic<job_type*>>, detail::job_priority_count> _injected;
+  // Number of jobs waiting in any queue per priority class. Only used as a hint to skip empty classes
+  std::array<memory::cacheline_aligned<std::atomic<std::int64_t>>, detail::job_priority_count> _queued;
+
+  // Number of queued jobs that have not finished yet
+  std::atomic<std::size_t> _pending;
+
+}; // class job_system
+
+inline auto detail::state_base::complete() -> void {
+  _is_ready.store(true, std::memory_order_release);
+  _is_ready.notify_all();
+
+  auto* continuation = _continuations.exchange(_closed(), std::memory_order_acq_rel);
+
+  while (continuation != nullptr) {
+    auto* next = continuation->next;
+
+    _system->_run_continuation(continuation);
+
+    continuation = next;
+  }
+}
+
+template<typename Type>
+auto job_future<Type>::wait() const -> void {
+  utility::assert_that(_state != nullptr, "Cannot wait on an invalid job_future");
+
+  _state->system()->_wait(*_state);
+}
+
+template<typename Type>
+auto job_future<Type>::get() const -> std::add_lvalue_reference_t<Type> {
+  wait();
+
+  if (_state->exception()) {
+    std::rethrow_exception(_state->exception());
+  }
+
+  if constexpr (!std::is_void_v<Type>) {
+    return _state->value();
+  }
+}
+
+template<typename Type>
+template<typename Function>
+requires (detail::is_continuation_v<Type, Function>)
+auto job_future<Type>::then(const job_priority priority, Function&& function) const -> job_future<detail::continuation_result_t<Type, Function>> {
+  using result_type = detail::continuation_result_t<Type, Function>;
+
+  utility::assert_that(_state != nullptr, "Cannot attach a continuation to an invalid job_future");
+
+  auto* system = _state->system();
+  auto* state = detail::state<result_type>::create(system);
+  auto future = job_future<result_type>{state};
+
+  state->acquire();
+
+  auto* continuation = system->_make_job(priority, false, [antecedent = *this, state, function = std::forward<Function>(function)]() mutable {
+    auto guard = job_future<result_type>{state};
+
+    if (antecedent._state->exception()) {
+      state->set_exception(antecedent._state->exception());
+    } else if (state->is_cancel_requested()) {
+      state->set_exception(std::make_exception_ptr(job_cancelled{}));
+    } else {
+      try {
+        if constexpr (std::is_void_v<Type> && std::is_void_v<result_type>) {
+          std::invoke(function);
+          state->set_value();
+        } else if constexpr (std::is_void_v<Type>) {
+          state->set_value(std::invoke(function));
+        } else if constexpr (std::is_void_v<result_type>) {
+          std::invoke(function, antecedent._state->value());
+          state->set_value();
+        } else {
+          state->set_value(std::invoke(function, antecedent._state->value()));
+        }
+      } catch (...) {
+        state->set_exception(std::current_exception());
+      }
+    }
+
+    state->complete();
+  });
+
+  system->_attach(*_state, continuation);
+
+  return future;
+}
+
+} // namespace sbx::assets
+
+#endif // LIBSBX_ASSETS_JOB_SYSTEM_HPP_
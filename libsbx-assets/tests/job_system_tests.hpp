@@ -0,0 +1,285 @@
+#ifndef LIBSBX_ASSETS_JOB_SYSTEM_TESTS_HPP_
+#define LIBSBX_ASSETS_JOB_SYSTEM_TESTS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/containers/executor.hpp>
+
+#include <libsbx/assets/job_system.hpp>
+
+TEST(libsbx_assets_job_system, submit_returns_result) {
+  auto executor = sbx::containers::executor{4u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto future = job_system.submit([](const int lhs, const int rhs){ return lhs + rhs; }, 2, 3);
+
+  EXPECT_EQ(future.get(), 5);
+  EXPECT_TRUE(future.is_ready());
+}
+
+TEST(libsbx_assets_job_system, runs_inline_without_workers) {
+  auto executor = sbx::containers::executor{0u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  const auto caller = std::this_thread::get_id();
+
+  auto future = job_system.submit([](){ return std::this_thread::get_id(); });
+
+  EXPECT_TRUE(future.is_ready());
+  EXPECT_EQ(future.get(), caller);
+}
+
+TEST(libsbx_assets_job_system, exceptions_are_forwarded) {
+  auto executor = sbx::containers::executor{2u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto future = job_system.submit([]() -> int { throw std::runtime_error{"failed"}; });
+
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(libsbx_assets_job_system, continuations) {
+  auto executor = sbx::containers::executor{4u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto future = job_system.submit([](){ return 20; })
+    .then([](int& value){ return value + 1; })
+    .then([](int& value){ return value * 2; });
+
+  EXPECT_EQ(future.get(), 42);
+
+  // Continuations attached to a future that is already ready are still executed
+  auto ready = job_system.submit([](){ return 1; });
+  ready.wait();
+
+  EXPECT_EQ(ready.then([](int& value){ return value + 1; }).get(), 2);
+
+  // Exceptions skip the continuation and are forwarded
+  auto is_skipped = std::atomic_bool{true};
+
+  auto failed = job_system.submit([]() -> int { throw std::runtime_error{"failed"}; })
+    .then([&](int&){ is_skipped = false; });
+
+  EXPECT_THROW(failed.get(), std::runtime_error);
+  EXPECT_TRUE(is_skipped.load());
+}
+
+TEST(libsbx_assets_job_system, dependencies) {
+  static constexpr auto count = 64u;
+
+  auto executor = sbx::containers::executor{4u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto completed = std::atomic<std::uint32_t>{0u};
+
+  auto futures = std::vector<sbx::assets::job_future<void>>{};
+
+  for (auto i = 0u; i < count; ++i) {
+    futures.push_back(job_system.submit([&](){
+      std::this_thread::sleep_for(std::chrono::microseconds{50});
+      completed.fetch_add(1u);
+    }));
+  }
+
+  auto observed = job_system.when_all(std::span<const sbx::assets::job_future<void>>{futures}).then([&](){ return completed.load(); });
+
+  EXPECT_EQ(observed.get(), count);
+
+  auto first = job_system.submit([](){ return 1; });
+  auto second = job_system.submit([]() -> int { throw std::runtime_error{"failed"}; });
+
+  EXPECT_THROW(job_system.when_all(first, second).get(), std::runtime_error);
+}
+
+TEST(libsbx_assets_job_system, waiting_inside_a_job_does_not_block_the_worker) {
+  // A single worker has to execute the inner job while the outer one waits for it
+  auto executor = sbx::containers::executor{1u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto future = job_system.submit([&](){
+    auto inner = job_system.submit([](){ return 7; });
+
+    return inner.get() * 6;
+  });
+
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(libsbx_assets_job_system, cancellation) {
+  auto executor = sbx::containers::executor{1u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto is_released = std::atomic_bool{false};
+  auto has_started = std::atomic_bool{false};
+  auto has_run = std::atomic_bool{false};
+
+  // Keeps the only worker busy so the next job can not start before it is cancelled
+  auto blocker = job_system.submit([&](){
+    has_started = true;
+    has_started.notify_all();
+    is_released.wait(false);
+    return 1;
+  });
+
+  has_started.wait(false);
+
+  auto cancelled = job_system.submit([&](){ has_run = true; return 2; });
+  auto continuation = cancelled.then([](int& value){ return value + 1; });
+
+  // Cancelling a job that already runs does not affect it
+  blocker.cancel();
+  cancelled.cancel();
+
+  is_released = true;
+  is_released.notify_all();
+
+  EXPECT_EQ(blocker.get(), 1);
+  EXPECT_THROW(cancelled.get(), sbx::assets::job_cancelled);
+  EXPECT_THROW(continuation.get(), sbx::assets::job_cancelled);
+  EXPECT_FALSE(has_run.load());
+}
+
+TEST(libsbx_assets_job_system, stealing) {
+  static constexpr auto count = 256u;
+
+  auto executor = sbx::containers::executor{4u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto mutex = std::mutex{};
+  auto workers = std::set<std::size_t>{};
+  auto completed = std::atomic<std::uint32_t>{0u};
+
+  // All jobs are pushed onto the queue of the worker that runs the producer, the other workers have to steal them
+  auto producer = job_system.submit([&](){
+    auto futures = std::vector<sbx::assets::job_future<void>>{};
+
+    for (auto i = 0u; i < count; ++i) {
+      futures.push_back(job_system.submit([&](){
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+
+        {
+          auto lock = std::scoped_lock{mutex};
+          workers.insert(*job_system.this_worker_id());
+        }
+
+        completed.fetch_add(1u);
+      }));
+    }
+
+    for (const auto& future : futures) {
+      future.wait();
+    }
+  });
+
+  producer.get();
+
+  EXPECT_EQ(completed.load(), count);
+  EXPECT_GT(workers.size(), 1u);
+}
+
+TEST(libsbx_assets_job_system, higher_priorities_run_first) {
+  auto executor = sbx::containers::executor{1u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto is_released = std::atomic_bool{false};
+  auto has_started = std::atomic_bool{false};
+
+  auto blocker = job_system.submit([&](){
+    has_started = true;
+    has_started.notify_all();
+    is_released.wait(false);
+  });
+
+  has_started.wait(false);
+
+  auto mutex = std::mutex{};
+  auto order = std::vector<sbx::assets::job_priority>{};
+
+  const auto record = [&](const sbx::assets::job_priority priority) {
+    return [&, priority](){
+      auto lock = std::scoped_lock{mutex};
+      order.push_back(priority);
+    };
+  };
+
+  auto background = job_system.submit(sbx::assets::job_priority::background, record(sbx::assets::job_priority::background));
+  auto streaming = job_system.submit(sbx::assets::job_priority::streaming, record(sbx::assets::job_priority::streaming));
+  auto frame_critical = job_system.submit(sbx::assets::job_priority::frame_critical, record(sbx::assets::job_priority::frame_critical));
+
+  is_released = true;
+  is_released.notify_all();
+
+  job_system.when_all(blocker, background, streaming, frame_critical).wait();
+
+  EXPECT_EQ(order, (std::vector<sbx::assets::job_priority>{sbx::assets::job_priority::frame_critical, sbx::assets::job_priority::streaming, sbx::assets::job_priority::background}));
+}
+
+TEST(libsbx_assets_job_system, destructor_waits_for_jobs) {
+  static constexpr auto count = 128u;
+
+  auto executor = sbx::containers::executor{4u};
+  auto completed = std::atomic<std::uint32_t>{0u};
+
+  {
+    auto job_system = sbx::assets::job_system{executor};
+
+    for (auto i = 0u; i < count; ++i) {
+      job_system.dispatch([&](){
+        std::this_thread::sleep_for(std::chrono::microseconds{50});
+        completed.fetch_add(1u);
+      });
+    }
+  }
+
+  EXPECT_EQ(completed.load(), count);
+}
+
+TEST(libsbx_assets_job_system, submits_from_other_threads) {
+  static constexpr auto thread_count = 4u;
+  static constexpr auto count = 1000u;
+
+  auto executor = sbx::containers::executor{4u};
+  auto job_system = sbx::assets::job_system{executor};
+
+  auto completed = std::atomic<std::uint32_t>{0u};
+  auto on_worker = std::atomic<std::uint32_t>{0u};
+
+  auto threads = std::vector<std::thread>{};
+
+  for (auto i = 0u; i < thread_count; ++i) {
+    threads.emplace_back([&](){
+      auto futures = std::vector<sbx::assets::job_future<void>>{};
+
+      for (auto j = 0u; j < count; ++j) {
+        futures.push_back(job_system.submit([&](){
+          if (job_system.this_worker_id()) {
+            on_worker.fetch_add(1u);
+          }
+
+          completed.fetch_add(1u);
+        }));
+      }
+
+      for (const auto& future : futures) {
+        future.wait();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(completed.load(), thread_count * count);
+  EXPECT_EQ(on_worker.load(), thread_count * count);
+}
+
+#endif // LIBSBX_ASSETS_JOB_SYSTEM_TESTS_HPP_
@@ -0,0 +1,299 @@
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <random>
+
+#include <fmt/format.h>
+
+#include <libsbx/containers/task_graph.hpp>
+#include <libsbx/containers/executor.hpp>
+#include <libsbx/containers/dynamic_aabb_tree.hpp>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Callable>
+auto measure(const std::uint32_t iterations, Callable&& callable) -> double {
+  auto samples = std::vector<double>{};
+  samples.reserve(iterations);
+
+  for (auto i = 0u; i < iterations; ++i) {
+    const auto start = clock_type::now();
+    std::invoke(callable);
+    samples.push_back(std::chrono::duration<double, std::milli>(clock_type::now() - start).count());
+  }
+
+  std::ranges::sort(samples);
+
+  return samples[samples.size() / 2u];
+}
+
+// Keeps the optimizer from removing the work
+std::atomic<std::uint64_t> sink{0u};
+
+auto work(const std::uint32_t seed, const std::uint32_t cost) -> void {
+  auto value = static_cast<double>(seed);
+
+  for (auto i = 0u; i < cost; ++i) {
+    value = std::sqrt(value + static_cast<double>(i));
+  }
+
+  sink.fetch_add(static_cast<std::uint64_t>(value), std::memory_order_relaxed);
+}
+
+auto report(const std::string_view name, const double serial, const double parallel) -> void {
+  fmt::print("{:<32} serial: {:>9.3f} ms  parallel: {:>9.3f} ms  speedup: {:>5.2f}x\n", name, serial, parallel, serial / parallel);
+}
+
+auto fork_join(sbx::containers::executor& executor, const std::uint32_t width, const std::uint32_t cost) -> void {
+  auto graph = sbx::containers::task_graph{"fork_join"};
+
+  auto source = graph.emplace([](){ });
+  auto join = graph.emplace([](){ });
+
+  for (auto i = 0u; i < width; ++i) {
+    graph.emplace([i, cost](){ work(i, cost); }).succeed(source).precede(join);
+  }
+
+  const auto serial = measure(10u, [&](){
+    for (auto i = 0u; i < width; ++i) {
+      work(i, cost);
+    }
+  });
+
+  const auto parallel = measure(10u, [&](){ executor.run_and_wait(graph); });
+
+  report(fmt::format("fork_join {}x{}", width, cost), serial, parallel);
+}
+
+auto wide_dag(sbx::containers::executor& executor, const std::uint32_t layers, const std::uint32_t width, const std::uint32_t cost) -> void {
+  auto graph = sbx::containers::task_graph{"wide_dag"};
+
+  auto previous = std::vector<sbx::containers::detail::task>{};
+
+  for (auto layer = 0u; layer < layers; ++layer) {
+    auto current = std::vector<sbx::containers::detail::task>{};
+    current.reserve(width);
+
+    for (auto i = 0u; i < width; ++i) {
+      auto task = graph.emplace([i, cost](){ work(i, cost); });
+
+      if (!previous.empty()) {
+        task.succeed(previous[i], previous[(i + 1u) % width]);
+      }
+
+      current.push_back(task);
+    }
+
+    previous = std::move(current);
+  }
+
+  const auto serial = measure(10u, [&](){
+    for (auto layer = 0u; layer < layers; ++layer) {
+      for (auto i = 0u; i < width; ++i) {
+        work(i, cost);
+      }
+    }
+  });
+
+  const auto parallel = measure(10u, [&](){ executor.run_and_wait(graph); });
+
+  report(fmt::format("wide_dag {}x{}x{}", layers, width, cost), serial, parallel);
+}
+
+auto recursive_sub_graphs(sbx::containers::executor& executor, const std::uint32_t depth, const std::uint32_t fan_out, const std::uint32_t cost) -> void {
+  auto graph = sbx::containers::task_graph{"recursive"};
+
+  auto spawn = std::function<void(sbx::containers::detail::sub_graph&, std::uint32_t)>{};
+
+  spawn = [&](sbx::containers::detail::sub_graph& sub_graph, const std::uint32_t level) {
+    for (auto i = 0u; i < fan_out; ++i) {
+      if (level + 1u < depth) {
+        sub_graph.emplace([&spawn, level](sbx::containers::detail::sub_graph& child){ spawn(child, level + 1u); });
+      } else {
+        sub_graph.emplace([i, cost](){ work(i, cost); });
+      }
+    }
+  };
+
+  graph.emplace([&](sbx::containers::detail::sub_graph& root){ spawn(root, 0u); });
+
+  const auto leaves = static_cast<std::uint32_t>(std::pow(fan_out, depth));
+
+  const auto serial = measure(10u, [&](){
+    for (auto i = 0u; i < leaves; ++i) {
+      work(i % fan_out, cost);
+    }
+  });
+
+  const auto parallel = measure(10u, [&](){ executor.run_and_wait(graph); });
+
+  report(fmt::format("sub_graph {}^{}x{}", fan_out, depth, cost), serial, parallel);
+}
+
+auto report_query(const std::string_view name, const double brute_force, const double tree) -> void {
+  fmt::print("{:<32} brute force: {:>9.3f} ms  tree: {:>9.3f} ms  speedup: {:>7.2f}x\n", name, brute_force, tree, brute_force / tree);
+}
+
+auto spatial_queries(const std::uint32_t count) -> void {
+  auto engine = std::mt19937{42u};
+  auto position = std::uniform_real_distribution<std::float_t>{-500.0f, 500.0f};
+  auto extent = std::uniform_real_distribution<std::float_t>{0.5f, 2.0f};
+
+  auto volumes = std::vector<sbx::math::volume>{};
+  volumes.reserve(count);
+
+  auto tree = sbx::containers::dynamic_aabb_tree<std::uint32_t>{};
+  auto proxies = std::vector<sbx::containers::dynamic_aabb_tree<std::uint32_t>::proxy_type>{};
+  proxies.reserve(count);
+
+  for (auto i = 0u; i < count; ++i) {
+    const auto center = sbx::math::vector3{position(engine), position(engine), position(engine)};
+    const auto half = sbx::math::vector3{extent(engine)};
+
+    volumes.emplace_back(center - half, center + half);
+    proxies.push_back(tree.insert(volumes.back(), i));
+  }
+
+  auto probes = std::vector<sbx::math::vector3>{};
+
+  for (auto i = 0u; i < 256u; ++i) {
+    probes.emplace_back(position(engine), position(engine), position(engine));
+  }
+
+  const auto distance_squared = [](const sbx::math::volume& volume, const sbx::math::vector3& point) {
+    const auto closest = sbx::math::vector3{sbx::math::vector3::min(sbx::math::vector3::max(point, volume.min()), volume.max())};
+    return sbx::math::vector3::distance_squared(point, closest);
+  };
+
+  // Sphere overlap, e.g. gameplay proximity checks
+  {
+    const auto brute_force = measure(10u, [&](){
+      for (const auto& probe : probes) {
+        for (auto i = 0u; i < count; ++i) {
+          if (distance_squared(volumes[i], probe) <= 400.0f) {
+            sink.fetch_add(i, std::memory_order_relaxed);
+          }
+        }
+      }
+    });
+
+    const auto with_tree = measure(10u, [&](){
+      for (const auto& probe : probes) {
+        tree.query(sbx::math::sphere{probe, 20.0f}, [](const std::uint32_t i) { sink.fetch_add(i, std::memory_order_relaxed); });
+      }
+    });
+
+    report_query(fmt::format("sphere {}x{}", probes.size(), count), brute_force, with_tree);
+  }
+
+  // Closest ray hit, e.g. picking
+  {
+    const auto brute_force = measure(10u, [&](){
+      for (const auto& probe : probes) {
+        const auto ray = sbx::math::ray{probe, sbx::math::vector3{1.0f, 0.5f, -0.25f}};
+        auto closest = std::numeric_limits<std::float_t>::max();
+
+        for (const auto& volume : volumes) {
+          auto near = 0.0f;
+          auto far = closest;
+
+          for (auto axis = 0u; axis < 3u && near <= far; ++axis) {
+            const auto inverse = 1.0f / ray.direction()[axis];
+            const auto t0 = (volume.min()[axis] - ray.origin()[axis]) * inverse;
+            const auto t1 = (volume.max()[axis] - ray.origin()[axis]) * inverse;
+
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+          }
+
+          if (near <= far) {
+            closest = near;
+          }
+        }
+
+        sink.fetch_add(static_cast<std::uint64_t>(closest), std::memory_order_relaxed);
+      }
+    });
+
+    const auto with_tree = measure(10u, [&](){
+      for (const auto& probe : probes) {
+        const auto ray = sbx::math::ray{probe, sbx::math::vector3{1.0f, 0.5f, -0.25f}};
+
+        if (const auto hit = tree.ray_cast(ray, std::numeric_limits<std::float_t>::max()); hit) {
+          sink.fetch_add(static_cast<std::uint64_t>(hit->distance), std::memory_order_relaxed);
+        }
+      }
+    });
+
+    report_query(fmt::format("ray {}x{}", probes.size(), count), brute_force, with_tree);
+  }
+
+  // k nearest neighbours
+  {
+    const auto brute_force = measure(10u, [&](){
+      auto distances = std::vector<std::pair<std::float_t, std::uint32_t>>(count);
+
+      for (const auto& probe : probes) {
+        for (auto i = 0u; i < count; ++i) {
+          distances[i] = {distance_squared(volumes[i], probe), i};
+        }
+
+        std::ranges::partial_sort(distances, distances.begin() + 8);
+
+        sink.fetch_add(distances.front().second, std::memory_order_relaxed);
+      }
+    });
+
+    const auto with_tree = measure(10u, [&](){
+      for (const auto& probe : probes) {
+        sink.fetch_add(tree.nearest(probe, 8u).front().value, std::memory_order_relaxed);
+      }
+    });
+
+    report_query(fmt::format("nearest8 {}x{}", probes.size(), count), brute_force, with_tree);
+  }
+
+  // Refit after every value moved a little, most stay inside their fat bounds
+  {
+    auto offset = sbx::math::vector3{0.05f, 0.0f, 0.0f};
+
+    const auto refit = measure(10u, [&](){
+      for (auto i = 0u; i < count; ++i) {
+        volumes[i] = sbx::math::volume{volumes[i].min() + offset, volumes[i].max() + offset};
+        tree.update(proxies[i], volumes[i], offset);
+      }
+
+      offset = -offset;
+    });
+
+    fmt::print("{:<32} refit: {:>9.3f} ms  height: {}\n", fmt::format("update {}", count), refit, tree.height());
+  }
+}
+
+} // namespace
+
+auto main() -> int {
+  auto executor = sbx::containers::executor{std::thread::hardware_concurrency()};
+
+  fmt::print("workers: {}\n", executor.size());
+
+  fork_join(executor, 1024u, 64u);
+  fork_join(executor, 1024u, 4096u);
+  fork_join(executor, 65536u, 256u);
+
+  wide_dag(executor, 64u, 256u, 64u);
+  wide_dag(executor, 64u, 256u, 2048u);
+
+  recursive_sub_graphs(executor, 4u, 8u, 1024u);
+
+  spatial_queries(1000u);
+  spatial_queries(10000u);
+  spatial_queries(100000u);
+
+  return 0;
+}
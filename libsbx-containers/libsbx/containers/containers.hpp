@@ -3,7 +3,10 @@
 
 #include <libsbx/containers/compressed_pair.hpp>
 #include <libsbx/containers/octree.hpp>
+#include <libsbx/containers/dynamic_aabb_tree.hpp>
 #include <libsbx/containers/task_graph.hpp>
+#include <libsbx/containers/work_stealing_deque.hpp>
+#include <libsbx/containers/executor.hpp>
 #include <libsbx/containers/static_vector.hpp>
 #include <libsbx/containers/ring_buffer.hpp>
 
@@ -0,0 +1,640 @@
+#ifndef LIBSBX_CONTAINERS_DYNAMIC_AABB_TREE_HPP_
+#define LIBSBX_CONTAINERS_DYNAMIC_AABB_TREE_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include <libsbx/utility/assert.hpp>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/volume.hpp>
+#include <libsbx/math/sphere.hpp>
+#include <libsbx/math/box.hpp>
+#include <libsbx/math/ray.hpp>
+
+namespace sbx::containers {
+
+/**
+ * @brief Bounding volume hierarchy over axis aligned boxes that is updated incrementally.
+ *
+ * Every value is stored in a leaf together with its tight bounds and a fat box that is enlarged by a margin.
+ * Updating a value only touches the tree if its new bounds leave the fat box, so small movements are free.
+ * Leaves are inserted next to the sibling with the lowest surface area cost and the tree is kept balanced with AVL style rotations.
+ *
+ * Inner nodes are tested against the fat boxes, leaves against the tight bounds, so query results are exact.
+ *
+ * @tparam Type The type of the values stored in the tree.
+ */
+template<std::default_initializable Type>
+class dynamic_aabb_tree {
+
+  struct node {
+    math::volume fat;
+    math::volume tight;
+    std::uint32_t parent;
+    std::uint32_t left;
+    std::uint32_t right;
+    std::int32_t height;
+    Type value;
+
+    auto is_leaf() const noexcept -> bool {
+      return left == null_proxy;
+    }
+  }; // struct node
+
+public:
+
+  using value_type = Type;
+  using size_type = std::size_t;
+  using proxy_type = std::uint32_t;
+
+  inline static constexpr auto null_proxy = std::numeric_limits<proxy_type>::max();
+
+  /**
+   * @brief Result of a nearest neighbour query.
+   */
+  struct neighbour {
+    value_type value;
+    std::float_t distance;
+  }; // struct neighbour
+
+  /**
+   * @param margin Distance the fat box of a leaf extends beyond its tight bounds on every side.
+   * @param displacement_scale Factor applied to the displacement passed to update to predict further movement.
+   */
+  explicit dynamic_aabb_tree(const std::float_t margin = 0.1f, const std::float_t displacement_scale = 2.0f)
+  : _root{null_proxy},
+    _free{null_proxy},
+    _size{0u},
+    _margin{margin},
+    _displacement_scale{displacement_scale} { }
+
+  [[nodiscard]] auto size() const noexcept -> size_type {
+    return _size;
+  }
+
+  [[nodiscard]] auto is_empty() const noexcept -> bool {
+    return _size == 0u;
+  }
+
+  /**
+   * @brief Height of the tree. A single leaf has a height of 0.
+   */
+  [[nodiscard]] auto height() const noexcept -> std::int32_t {
+    return _root == null_proxy ? 0 : _nodes[_root].height;
+  }
+
+  auto clear() -> void {
+    _nodes.clear();
+    _root = null_proxy;
+    _free = null_proxy;
+    _size = 0u;
+  }
+
+  [[nodiscard]] auto value(const proxy_type proxy) const -> const value_type& {
+    return _nodes[proxy].value;
+  }
+
+  [[nodiscard]] auto bounds(const proxy_type proxy) const -> const math::volume& {
+    return _nodes[proxy].tight;
+  }
+
+  [[nodiscard]] auto fat_bounds(const proxy_type proxy) const -> const math::volume& {
+    return _nodes[proxy].fat;
+  }
+
+  auto insert(const math::volume& bounds, const value_type& value) -> proxy_type {
+    const auto proxy = _allocate();
+
+    auto& leaf = _nodes[proxy];
+
+    leaf.fat = _enlarge(bounds, math::vector3::zero);
+    leaf.tight = bounds;
+    leaf.height = 0;
+    leaf.value = value;
+
+    _insert_leaf(proxy);
+
+    ++_size;
+
+    return proxy;
+  }
+
+  auto remove(const proxy_type proxy) -> void {
+    utility::assert_that(proxy < _nodes.size() && _nodes[proxy].is_leaf() && _nodes[proxy].height == 0, "Proxy is not a leaf of the tree");
+
+    _remove_leaf(proxy);
+    _release(proxy);
+
+    --_size;
+  }
+
+  /**
+   * @brief Moves a value to new bounds.
+   *
+   * @param displacement Movement since the last update, the fat box is extended in this direction to anticipate further movement.
+   *
+   * @return true if the leaf was reinserted, false if the new bounds still fit into its fat box.
+   */
+  auto update(const proxy_type proxy, const math::volume& bounds, const math::vector3& displacement = math::vector3::zero) -> bool {
+    auto& leaf = _nodes[proxy];
+
+    leaf.tight = bounds;
+
+    if (leaf.fat.contains(bounds)) {
+      return false;
+    }
+
+    _remove_leaf(proxy);
+
+    _nodes[proxy].fat = _enlarge(bounds, displacement * _displacement_scale);
+
+    _insert_leaf(proxy);
+
+    return true;
+  }
+
+  /**
+   * @brief Invokes the callable with every value whose bounds overlap the volume.
+   */
+  template<std::invocable<const value_type&> Callable>
+  auto query(const math::volume& volume, Callable&& callable) const -> void {
+    _traverse([&volume](const math::volume& bounds) { return bounds.intersects(volume); }, std::forward<Callable>(callable));
+  }
+
+  /**
+   * @brief Invokes the callable with every value whose bounds are not fully outside of one of the planes, e.g. of a view frustum.
+   */
+  template<std::invocable<const value_type&> Callable>
+  auto query(const math::box& box, Callable&& callable) const -> void {
+    _traverse([&box](const math::volume& bounds) { return _intersects(box, bounds); }, std::forward<Callable>(callable));
+  }
+
+  /**
+   * @brief Invokes the callable with every value whose bounds overlap the sphere.
+   */
+  template<std::invocable<const value_type&> Callable>
+  auto query(const math::sphere& sphere, Callable&& callable) const -> void {
+    _traverse([&sphere](const math::volume& bounds) { return _distance_squared(bounds, sphere.center()) <= sphere.radius() * sphere.radius(); }, std::forward<Callable>(callable));
+  }
+
+  /**
+   * @brief Invokes the callable with every value whose bounds are hit by the ray within max_distance, with the distance at which the ray enters the bounds.
+   *
+   * The callable returns the new maximum distance. Returning the hit distance only reports closer hits afterwards, returning 0 stops the cast.
+   * Hits are not reported in order.
+   */
+  template<std::invocable<const value_type&, std::float_t> Callable>
+  auto ray_cast(const math::ray& ray, std::float_t max_distance, Callable&& callable) const -> void {
+    if (_root == null_proxy) {
+      return;
+    }
+
+    auto stack = std::vector<proxy_type>{};
+    stack.reserve(64u);
+    stack.push_back(_root);
+
+    while (!stack.empty() && max_distance > 0.0f) {
+      const auto& current = _nodes[stack.back()];
+      stack.pop_back();
+
+      const auto distance = _intersects(ray, current.is_leaf() ? current.tight : current.fat, max_distance);
+
+      if (!distance) {
+        continue;
+      }
+
+      if (current.is_leaf()) {
+        const auto clip = std::invoke(callable, current.value, *distance);
+
+        max_distance = std::min<std::float_t>(max_distance, clip);
+      } else {
+        stack.push_back(current.left);
+        stack.push_back(current.right);
+      }
+    }
+  }
+
+  /**
+   * @brief Returns the closest value hit by the ray within max_distance.
+   */
+  [[nodiscard]] auto ray_cast(const math::ray& ray, const std::float_t max_distance) const -> std::optional<neighbour> {
+    auto result = std::optional<neighbour>{};
+
+    ray_cast(ray, max_distance, [&result](const value_type& value, const std::float_t distance) {
+      result = neighbour{value, distance};
+      return distance;
+    });
+
+    return result;
+  }
+
+  /**
+   * @brief Returns up to count values closest to the point, ordered by the distance between the point and their bounds.
+   */
+  [[nodiscard]] auto nearest(const math::vector3& point, const size_type count) const -> std::vector<neighbour> {
+    auto result = std::vector<neighbour>{};
+
+    if (_root == null_proxy || count == 0u) {
+      return result;
+    }
+
+    using entry = std::pair<std::float_t, proxy_type>;
+
+    auto candidates = std::priority_queue<entry, std::vector<entry>, std::greater<entry>>{};
+    auto best = std::priority_queue<std::pair<std::float_t, proxy_type>>{};
+
+    candidates.emplace(_distance_squared(_nodes[_root].fat, point), _root);
+
+    while (!candidates.empty()) {
+      const auto [distance, proxy] = candidates.top();
+      candidates.pop();
+
+      // Candidates come in ascending order, nothing left can be closer than the worst result
+      if (best.size() == count && distance >= best.top().first) {
+        break;
+      }
+
+      const auto& current = _nodes[proxy];
+
+      if (current.is_leaf()) {
+        best.emplace(distance, proxy);
+
+        if (best.size() > count) {
+          best.pop();
+        }
+
+        continue;
+      }
+
+      for (const auto child : {current.left, current.right}) {
+        const auto& child_node = _nodes[child];
+        candidates.emplace(_distance_squared(child_node.is_leaf() ? child_node.tight : child_node.fat, point), child);
+      }
+    }
+
+    result.resize(best.size());
+
+    for (auto index = best.size(); index > 0u; --index) {
+      result[index - 1u] = neighbour{_nodes[best.top().second].value, std::sqrt(best.top().first)};
+      best.pop();
+    }
+
+    return result;
+  }
+
+private:
+
+  template<typename Predicate, typename Callable>
+  auto _traverse(Predicate&& predicate, Callable&& callable) const -> void {
+    if (_root == null_proxy) {
+      return;
+    }
+
+    auto stack = std::vector<proxy_type>{};
+    stack.reserve(64u);
+    stack.push_back(_root);
+
+    while (!stack.empty()) {
+      const auto& current = _nodes[stack.back()];
+      stack.pop_back();
+
+      if (current.is_leaf()) {
+        if (std::invoke(predicate, current.tight)) {
+          std::invoke(callable, current.value);
+        }
+      } else if (std::invoke(predicate, current.fat)) {
+        stack.push_back(current.left);
+        stack.push_back(current.right);
+      }
+    }
+  }
+
+  auto _allocate() -> proxy_type {
+    if (_free == null_proxy) {
+      _nodes.emplace_back();
+      _free = static_cast<proxy_type>(_nodes.size() - 1u);
+      _nodes[_free].parent = null_proxy;
+    }
+
+    const auto proxy = _free;
+    auto& allocated = _nodes[proxy];
+
+    // The parent of a free node links to the next free node
+    _free = allocated.parent;
+
+    allocated.parent = null_proxy;
+    allocated.left = null_proxy;
+    allocated.right = null_proxy;
+    allocated.height = 0;
+
+    return proxy;
+  }
+
+  auto _release(const proxy_type proxy) -> void {
+    auto& released = _nodes[proxy];
+
+    released.parent = _free;
+    released.left = null_proxy;
+    released.right = null_proxy;
+    released.height = -1;
+    released.value = value_type{};
+
+    _free = proxy;
+  }
+
+  auto _insert_leaf(const proxy_type leaf) -> void {
+    if (_root == null_proxy) {
+      _root = leaf;
+      _nodes[leaf].parent = null_proxy;
+      return;
+    }
+
+    const auto leaf_bounds = _nodes[leaf].fat;
+
+    // Descend towards the sibling with the lowest surface area cost
+    auto index = _root;
+
+    while (!_nodes[index].is_leaf()) {
+      const auto& current = _nodes[index];
+
+      const auto area = _area(current.fat);
+      const auto combined_area = _area(_merge(current.fat, leaf_bounds));
+
+      // Cost of creating a new parent for this node and the leaf, and the minimum cost of pushing the leaf further down
+      const auto cost = 2.0f * combined_area;
+      const auto inheritance_cost = 2.0f * (combined_area - area);
+
+      const auto cost_left = _descend_cost(current.left, leaf_bounds, inheritance_cost);
+      const auto cost_right = _descend_cost(current.right, leaf_bounds, inheritance_cost);
+
+      if (cost < cost_left && cost < cost_right) {
+        break;
+      }
+
+      index = (cost_left < cost_right) ? current.left : current.right;
+    }
+
+    const auto sibling = index;
+    const auto old_parent = _nodes[sibling].parent;
+    const auto new_parent = _allocate();
+
+    _nodes[new_parent].parent = old_parent;
+    _nodes[new_parent].fat = _merge(leaf_bounds, _nodes[sibling].fat);
+    _nodes[new_parent].height = _nodes[sibling].height + 1;
+    _nodes[new_parent].left = sibling;
+    _nodes[new_parent].right = leaf;
+
+    _nodes[sibling].parent = new_parent;
+    _nodes[leaf].parent = new_parent;
+
+    if (old_parent == null_proxy) {
+      _root = new_parent;
+    } else if (_nodes[old_parent].left == sibling) {
+      _nodes[old_parent].left = new_parent;
+    } else {
+      _nodes[old_parent].right = new_parent;
+    }
+
+    _refit(_nodes[leaf].parent);
+  }
+
+  auto _remove_leaf(const proxy_type leaf) -> void {
+    if (leaf == _root) {
+      _root = null_proxy;
+      return;
+    }
+
+    const auto parent = _nodes[leaf].parent;
+    const auto grand_parent = _nodes[parent].parent;
+    const auto sibling = (_nodes[parent].left == leaf) ? _nodes[parent].right : _nodes[parent].left;
+
+    _nodes[leaf].parent = null_proxy;
+
+    if (grand_parent == null_proxy) {
+      _root = sibling;
+      _nodes[sibling].parent = null_proxy;
+      _release(parent);
+      return;
+    }
+
+    if (_nodes[grand_parent].left == parent) {
+      _nodes[grand_parent].left = sibling;
+    } else {
+      _nodes[grand_parent].right = sibling;
+    }
+
+    _nodes[sibling].parent = grand_parent;
+    _release(parent);
+
+    _refit(grand_parent);
+  }
+
+  /**
+   * @brief Walks from index to the root, rebalancing and recomputing the bounds and heights of all ancestors.
+   */
+  auto _refit(proxy_type index) -> void {
+    while (index != null_proxy) {
+      index = _balance(index);
+
+      auto& current = _nodes[index];
+
+      const auto& left = _nodes[current.left];
+      const auto& right = _nodes[current.right];
+
+      current.height = 1 + std::max(left.height, right.height);
+      current.fat = _merge(left.fat, right.fat);
+
+      index = current.parent;
+    }
+  }
+
+  /**
+   * @brief Performs a left or right rotation if the subtree at a is imbalanced.
+   *
+   * @return The index of the new root of the subtree.
+   */
+  auto _balance(const proxy_type a) -> proxy_type {
+    auto& node_a = _nodes[a];
+
+    if (node_a.is_leaf() || node_a.height < 2) {
+      return a;
+    }
+
+    const auto b = node_a.left;
+    const auto c = node_a.right;
+
+    const auto balance = _nodes[c].height - _nodes[b].height;
+
+    if (balance > 1) {
+      return _rotate(a, c, b);
+    }
+
+    if (balance < -1) {
+      return _rotate(a, b, c);
+    }
+
+    return a;
+  }
+
+  /**
+   * @brief Promotes the child up of a. The shorter child of the promoted node becomes the new child of a.
+   */
+  auto _rotate(const proxy_type a, const proxy_type up, const proxy_type other) -> proxy_type {
+    const auto f = _nodes[up].left;
+    const auto g = _nodes[up].right;
+
+    _nodes[up].left = a;
+    _nodes[up].parent = _nodes[a].parent;
+    _nodes[a].parent = up;
+
+    if (const auto parent = _nodes[up].parent; parent == null_proxy) {
+      _root = up;
+    } else if (_nodes[parent].left == a) {
+      _nodes[parent].left = up;
+    } else {
+      _nodes[parent].right = up;
+    }
+
+    // Keep the taller grand child at the promoted node
+    const auto [keep, lower] = (_nodes[f].height > _nodes[g].height) ? std::pair{f, g} : std::pair{g, f};
+
+    _nodes[up].right = keep;
+
+    if (_nodes[a].left == up) {
+      _nodes[a].left = lower;
+    } else {
+      _nodes[a].right = lower;
+    }
+
+    _nodes[lower].parent = a;
+
+    _nodes[a].fat = _merge(_nodes[other].fat, _nodes[lower].fat);
+    _nodes[a].height = 1 + std::max(_nodes[other].height, _nodes[lower].height);
+
+    _nodes[up].fat = _merge(_nodes[a].fat, _nodes[keep].fat);
+    _nodes[up].height = 1 + std::max(_nodes[a].height, _nodes[keep].height);
+
+    return up;
+  }
+
+  auto _descend_cost(const proxy_type child, const math::volume& bounds, const std::float_t inheritance_cost) const -> std::float_t {
+    const auto& current = _nodes[child];
+    const auto combined_area = _area(_merge(bounds, current.fat));
+
+    if (current.is_leaf()) {
+      return combined_area + inheritance_cost;
+    }
+
+    return (combined_area - _area(current.fat)) + inheritance_cost;
+  }
+
+  auto _enlarge(const math::volume& bounds, const math::vector3& displacement) const -> math::volume {
+    const auto margin = math::vector3{_margin};
+
+    auto min = bounds.min() - margin;
+    auto max = bounds.max() + margin;
+
+    for (auto axis = 0u; axis < 3u; ++axis) {
+      if (displacement[axis] < 0.0f) {
+        min[axis] += displacement[axis];
+      } else {
+        max[axis] += displacement[axis];
+      }
+    }
+
+    return math::volume{min, max};
+  }
+
+  static auto _merge(const math::volume& lhs, const math::volume& rhs) noexcept -> math::volume {
+    return math::volume{math::vector3::min(lhs.min(), rhs.min()), math::vector3::max(lhs.max(), rhs.max())};
+  }
+
+  static auto _area(const math::volume& volume) noexcept -> std::float_t {
+    const auto extent = volume.max() - volume.min();
+
+    return 2.0f * (extent.x() * extent.y() + extent.y() * extent.z() + extent.z() * extent.x());
+  }
+
+  static auto _distance_squared(const math::volume& volume, const math::vector3& point) noexcept -> std::float_t {
+    const auto closest = math::vector3::min(math::vector3::max(point, volume.min()), volume.max());
+
+    return math::vector3::distance_squared(point, closest);
+  }
+
+  static auto _intersects(const math::box& box, const math::volume& volume) noexcept -> bool {
+    for (const auto& plane : box.planes()) {
+      const auto vp = math::vector3{
+        (plane.normal().x() >= 0.0f ? volume.max().x() : volume.min().x()),
+        (plane.normal().y() >= 0.0f ? volume.max().y() : volume.min().y()),
+        (plane.normal().z() >= 0.0f ? volume.max().z() : volume.min().z())
+      };
+
+      if (plane.distance_to_point(vp) < 0.0f) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * @brief Slab test, returns the distance at which the ray enters the volume.
+   */
+  static auto _intersects(const math::ray& ray, const math::volume& volume, const std::float_t max_distance) noexcept -> std::optional<std::float_t> {
+    auto near = 0.0f;
+    auto far = max_distance;
+
+    for (auto axis = 0u; axis < 3u; ++axis) {
+      const auto origin = ray.origin()[axis];
+      const auto direction = ray.direction()[axis];
+
+      if (std::abs(direction) < std::numeric_limits<std::float_t>::epsilon()) {
+        if (origin < volume.min()[axis] || origin > volume.max()[axis]) {
+          return std::nullopt;
+        }
+
+        continue;
+      }
+
+      const auto inverse = 1.0f / direction;
+
+      auto t0 = (volume.min()[axis] - origin) * inverse;
+      auto t1 = (volume.max()[axis] - origin) * inverse;
+
+      if (t0 > t1) {
+        std::swap(t0, t1);
+      }
+
+      near = std::max(near, t0);
+      far = std::min(far, t1);
+
+      if (near > far) {
+        return std::nullopt;
+      }
+    }
+
+    return near;
+  }
+
+  std::vector<node> _nodes;
+  proxy_type _root;
+  proxy_type _free;
+  size_type _size;
+  std::float_t _margin;
+  std::float_t _displacement_scale;
+
+}; // class dynamic_aabb_tree
+
+} // namespace sbx::containers
+
+#endif // LIBSBX_CONTAINERS_DYNAMIC_AABB_TREE_HPP_
@@ -0,0 +1,564 @@
+#ifndef LIBSBX_CONTAINERS_EXECUTOR_HPP_
+#define LIBSBX_CONTAINERS_EXECUTOR_HPP_
+
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <future>
+#include <random>
+#include <exception>
+#include <optional>
+#include <array>
+
+#include <libsbx/utility/assert.hpp>
+
+#include <libsbx/containers/task_graph.hpp>
+#include <libsbx/containers/work_stealing_deque.hpp>
+
+namespace sbx::containers {
+
+namespace detail {
+
+/**
+ * @brief Bookkeeping for a single run of a task graph.
+ */
+struct topology {
+
+  std::atomic<std::size_t> pending{0u};
+  std::atomic_bool is_cancelled{false};
+  std::atomic_bool is_done{false};
+
+  std::mutex exception_mutex;
+  std::exception_ptr exception;
+
+  std::promise<void> promise;
+
+  // Keeps the topology alive until the last node has completed
+  std::shared_ptr<topology> self;
+
+}; // struct topology
+
+} // namespace detail
+
+/**
+ * @brief Work that is not part of a task graph and is polled by idle workers of an executor, e.g. the queues of a job system.
+ *
+ * Sources keep their own queues, so handing work to the executor neither allocates nor locks. After queueing work a source calls executor::notify.
+ */
+class work_source {
+
+public:
+
+  virtual ~work_source() = default;
+
+  /**
+   * @brief Runs one piece of work if there is any.
+   *
+   * @param worker_id The index of the calling worker or std::nullopt if the calling thread helps while waiting on a task graph.
+   *
+   * @return true if work has been run.
+   */
+  virtual auto try_run(std::optional<std::size_t> worker_id) -> bool = 0;
+
+  /**
+   * @brief Returns true if the source has queued work. Checked by workers before they go to sleep.
+   */
+  [[nodiscard]] virtual auto has_work() const noexcept -> bool = 0;
+
+}; // class work_source
+
+/**
+ * @brief Work-stealing executor for task graphs.
+ *
+ * Every worker owns a lock-free deque. Ready tasks are pushed to the deque of the worker that made them ready and idle workers steal from the others.
+ * Submissions from threads that are not workers of this executor go through a shared injection queue. Workers that run out of tasks poll the
+ * registered work sources before they go to sleep.
+ */
+class executor {
+
+  using node_type = detail::graph_node;
+
+  struct worker {
+    std::size_t id;
+    executor* owner;
+    work_stealing_deque<node_type*> queue;
+    std::minstd_rand random;
+    std::thread thread;
+  }; // struct worker
+
+  struct source_slot {
+    std::atomic<work_source*> source{nullptr};
+    // Number of threads that are currently inside the source
+    std::atomic<std::size_t> users{0u};
+  }; // struct source_slot
+
+  inline static constexpr auto steal_attempts = std::size_t{64u};
+  inline static constexpr auto max_sources = std::size_t{8u};
+
+public:
+
+  explicit executor(const std::size_t size = std::thread::hardware_concurrency())
+  : _epoch{0u},
+    _sleeping{0u},
+    _is_running{true} {
+    _workers.reserve(size);
+
+    for (auto i = 0u; i < size; ++i) {
+      auto& entry = _workers.emplace_back(std::make_unique<worker>());
+
+      entry->id = i;
+      entry->owner = this;
+      entry->random.seed(static_cast<std::minstd_rand::result_type>(i + 1u));
+    }
+
+    for (auto& entry : _workers) {
+      entry->thread = std::thread{[this, current = entry.get()](){ _worker_loop(current); }};
+    }
+  }
+
+  executor(const executor& other) = delete;
+
+  executor(executor&& other) = delete;
+
+  ~executor() {
+    _is_running.store(false, std::memory_order_seq_cst);
+    _epoch.fetch_add(1u, std::memory_order_seq_cst);
+    _epoch.notify_all();
+
+    for (auto& entry : _workers) {
+      entry->thread.join();
+    }
+  }
+
+  auto operator=(const executor& other) -> executor& = delete;
+
+  auto operator=(executor&& other) -> executor& = delete;
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return _workers.size();
+  }
+
+  /**
+   * @brief Returns the index of the calling worker or std::nullopt if the calling thread is not a worker of this executor.
+   */
+  [[nodiscard]] auto this_worker_id() const noexcept -> std::optional<std::size_t> {
+    if (_this_worker != nullptr && _this_worker->owner == this) {
+      return _this_worker->id;
+    }
+
+    return std::nullopt;
+  }
+
+  /**
+   * @brief Schedules all tasks of the graph. The graph must outlive the run and may not be run concurrently.
+   *
+   * @return A future that becomes ready once every task (including dynamically spawned sub graph tasks) has completed. Rethrows the first exception thrown by a task.
+   */
+  auto run(task_graph& graph) -> std::future<void> {
+    auto state = _start(graph._graph);
+
+    if (!state) {
+      auto promise = std::promise<void>{};
+      promise.set_value();
+      return promise.get_future();
+    }
+
+    return state->promise.get_future();
+  }
+
+  /**
+   * @brief Runs the graph and blocks until it has completed. The calling thread helps executing tasks while waiting.
+   */
+  auto run_and_wait(task_graph& graph) -> void {
+    auto future = std::future<void>{};
+    auto state = std::shared_ptr<detail::topology>{};
+
+    {
+      auto started = _start(graph._graph);
+
+      if (!started) {
+        return;
+      }
+
+      future = started->promise.get_future();
+      state = std::move(started);
+    }
+
+    auto* current = _current_worker();
+
+    while (!state->is_done.load(std::memory_order_acquire)) {
+      if (auto* node = _find_work(current)) {
+        _execute(current, node);
+      } else if (_run_source(current)) {
+        continue;
+      } else if (_workers.empty() || current != nullptr) {
+        std::this_thread::yield();
+      } else {
+        state->is_done.wait(false, std::memory_order_acquire);
+      }
+    }
+
+    future.get();
+  }
+
+  /**
+   * @brief Registers a source that idle workers poll for work. The source must be removed again before it is destroyed.
+   */
+  auto add_source(work_source& source) -> void {
+    for (auto& slot : _sources) {
+      auto* expected = static_cast<work_source*>(nullptr);
+
+      if (slot.source.compare_exchange_strong(expected, &source, std::memory_order_seq_cst)) {
+        notify();
+        return;
+      }
+    }
+
+    utility::assert_that(false, "Too many work sources");
+  }
+
+  /**
+   * @brief Unregisters the source and waits until no thread is inside of it anymore.
+   */
+  auto remove_source(work_source& source) -> void {
+    for (auto& slot : _sources) {
+      if (slot.source.load(std::memory_order_seq_cst) != &source) {
+        continue;
+      }
+
+      slot.source.store(nullptr, std::memory_order_seq_cst);
+
+      while (slot.users.load(std::memory_order_seq_cst) > 0u) {
+        std::this_thread::yield();
+      }
+
+      return;
+    }
+  }
+
+  /**
+   * @brief Wakes up a sleeping worker. Called by work sources after they queued work.
+   */
+  auto notify() -> void {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    if (_sleeping.load(std::memory_order_seq_cst) > 0u) {
+      _epoch.fetch_add(1u, std::memory_order_seq_cst);
+      _epoch.notify_one();
+    }
+  }
+
+private:
+
+  auto _current_worker() const noexcept -> worker* {
+    return (_this_worker != nullptr && _this_worker->owner == this) ? _this_worker : nullptr;
+  }
+
+  auto _start(detail::graph_base& graph) -> std::shared_ptr<detail::topology> {
+    if (graph.is_empty()) {
+      return nullptr;
+    }
+
+    auto state = std::make_shared<detail::topology>();
+
+    state->self = state;
+    state->pending.store(graph.size(), std::memory_order_relaxed);
+
+    auto sources = _prepare(graph, state.get(), nullptr);
+
+    auto* current = _current_worker();
+
+    for (auto* node : sources) {
+      _schedule(current, node);
+    }
+
+    return state;
+  }
+
+  /**
+   * @brief Resets the runtime state of all nodes in the graph and collects the nodes without predecessors.
+   */
+  auto _prepare(detail::graph_base& graph, detail::topology* state, node_type* parent) -> std::vector<node_type*> {
+    auto sources = std::vector<node_type*>{};
+
+    for (auto& node : graph) {
+      node->_topology = state;
+      node->_parent = parent;
+      node->_pending_children.store(0u, std::memory_order_relaxed);
+      node->_join_counter.store(node->num_predecessors(), std::memory_order_relaxed);
+
+      if (node->num_predecessors() == 0u) {
+        sources.push_back(node.get());
+      }
+    }
+
+    return sources;
+  }
+
+  auto _schedule(worker* current, node_type* node) -> void {
+    if (current != nullptr) {
+      current->queue.push(node);
+    } else {
+      auto lock = std::scoped_lock{_injection_mutex};
+      _injection_queue.push_back(node);
+    }
+
+    notify();
+  }
+
+  /**
+   * @brief Lets the first source that has work run one piece of it.
+   */
+  auto _run_source(worker* current) -> bool {
+    const auto id = (current != nullptr) ? std::optional<std::size_t>{current->id} : std::nullopt;
+
+    for (auto& slot : _sources) {
+      // Announce the access before loading the source, remove_source clears the slot first and then waits for the users
+      slot.users.fetch_add(1u, std::memory_order_seq_cst);
+
+      auto* source = slot.source.load(std::memory_order_seq_cst);
+      const auto has_run = (source != nullptr) && source->try_run(id);
+
+      slot.users.fetch_sub(1u, std::memory_order_seq_cst);
+
+      if (has_run) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  auto _steal_injected() -> node_type* {
+    auto lock = std::scoped_lock{_injection_mutex};
+
+    if (_injection_queue.empty()) {
+      return nullptr;
+    }
+
+    auto* node = _injection_queue.front();
+    _injection_queue.pop_front();
+
+    return node;
+  }
+
+  auto _find_work(worker* current) -> node_type* {
+    if (current != nullptr) {
+      if (auto node = current->queue.pop()) {
+        return *node;
+      }
+    }
+
+    if (auto* node = _steal_injected()) {
+      return node;
+    }
+
+    const auto count = _workers.size();
+
+    if (count == 0u) {
+      return nullptr;
+    }
+
+    for (auto attempt = 0u; attempt < steal_attempts; ++attempt) {
+      const auto victim = (current != nullptr) ? current->random() % count : attempt % count;
+
+      if (current != nullptr && victim == current->id) {
+        continue;
+      }
+
+      if (auto node = _workers[victim]->queue.steal()) {
+        return *node;
+      }
+    }
+
+    return nullptr;
+  }
+
+  [[nodiscard]] auto _has_work() -> bool {
+    for (auto& entry : _workers) {
+      if (!entry->queue.is_empty()) {
+        return true;
+      }
+    }
+
+    for (auto& slot : _sources) {
+      slot.users.fetch_add(1u, std::memory_order_seq_cst);
+
+      auto* source = slot.source.load(std::memory_order_seq_cst);
+      const auto has_work = (source != nullptr) && source->has_work();
+
+      slot.users.fetch_sub(1u, std::memory_order_seq_cst);
+
+      if (has_work) {
+        return true;
+      }
+    }
+
+    auto lock = std::scoped_lock{_injection_mutex};
+
+    return !_injection_queue.empty();
+  }
+
+  auto _worker_loop(worker* current) -> void {
+    _this_worker = current;
+
+    while (true) {
+      if (auto* node = _find_work(current)) {
+        _execute(current, node);
+        continue;
+      }
+
+      if (_run_source(current)) {
+        continue;
+      }
+
+      const auto epoch = _epoch.load(std::memory_order_seq_cst);
+
+      _sleeping.fetch_add(1u, std::memory_order_seq_cst);
+
+      if (!_is_running.load(std::memory_order_seq_cst)) {
+        _sleeping.fetch_sub(1u, std::memory_order_seq_cst);
+        break;
+      }
+
+      if (!_has_work()) {
+        _epoch.wait(epoch, std::memory_order_seq_cst);
+      }
+
+      _sleeping.fetch_sub(1u, std::memory_order_seq_cst);
+    }
+
+    _this_worker = nullptr;
+  }
+
+  /**
+   * @brief Executes the node and then keeps executing one of the successors it made ready, pushing the others to the local queue.
+   */
+  auto _execute(worker* current, node_type* node) -> void {
+    while (node != nullptr) {
+      auto* next = static_cast<node_type*>(nullptr);
+
+      if (_invoke(current, node)) {
+        _complete(current, node, next);
+      }
+
+      node = next;
+    }
+  }
+
+  /**
+   * @brief Invokes the work of the node.
+   *
+   * @return false if the node spawned a sub graph and completes once its children have completed, true otherwise.
+   */
+  auto _invoke(worker* current, node_type* node) -> bool {
+    auto* state = node->_topology;
+
+    if (state->is_cancelled.load(std::memory_order_relaxed)) {
+      return true;
+    }
+
+    try {
+      switch (node->_handle.index()) {
+        case node_type::static_work: {
+          std::invoke(std::get<node_type::static_work>(node->_handle).work);
+          break;
+        }
+        case node_type::sub_graph_work: {
+          auto& handle = std::get<node_type::sub_graph_work>(node->_handle);
+
+          handle.graph.clear();
+
+          auto builder = detail::sub_graph{node, handle.graph};
+
+          std::invoke(handle.work, builder);
+
+          if (handle.graph.is_empty()) {
+            return true;
+          }
+
+          node->_pending_children.store(handle.graph.size(), std::memory_order_relaxed);
+
+          for (auto* child : _prepare(handle.graph, state, node)) {
+            _schedule(current, child);
+          }
+
+          return false;
+        }
+        default: {
+          break;
+        }
+      }
+    } catch (...) {
+      auto lock = std::scoped_lock{state->exception_mutex};
+
+      if (!state->exception) {
+        state->exception = std::current_exception();
+      }
+
+      state->is_cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    return true;
+  }
+
+  auto _complete(worker* current, node_type* node, node_type*& next) -> void {
+    auto* state = node->_topology;
+    auto* parent = node->_parent;
+
+    for (auto i = 0u; i < node->_num_successors; ++i) {
+      auto* successor = node->_edges[i];
+
+      if (successor->_join_counter.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+        if (next == nullptr) {
+          next = successor;
+        } else {
+          _schedule(current, successor);
+        }
+      }
+    }
+
+    if (parent != nullptr) {
+      if (parent->_pending_children.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+        _complete(current, parent, next);
+      }
+    } else if (state->pending.fetch_sub(1u, std::memory_order_acq_rel) == 1u) {
+      _finish(state);
+    }
+  }
+
+  auto _finish(detail::topology* state) -> void {
+    auto self = std::move(state->self);
+
+    if (self->exception) {
+      self->promise.set_exception(self->exception);
+    } else {
+      self->promise.set_value();
+    }
+
+    self->is_done.store(true, std::memory_order_release);
+    self->is_done.notify_all();
+  }
+
+  inline static thread_local worker* _this_worker{nullptr};
+
+  std::vector<std::unique_ptr<worker>> _workers;
+
+  std::mutex _injection_mutex;
+  std::deque<node_type*> _injection_queue;
+
+  std::array<source_slot, max_sources> _sources;
+
+  std::atomic<std::uint64_t> _epoch;
+  std::atomic<std::size_t> _sleeping;
+  std::atomic_bool _is_running;
+
+}; // class executor
+
+} // namespace sbx::containers
+
+#endif // LIBSBX_CONTAINERS_EXECUTOR_HPP_
@@ -9,9 +9,14 @@
 #include <memory>
 #include <functional>
 #include <algorithm>
+#include <atomic>
+#include <tuple>
+#include <type_traits>
 
 namespace sbx::containers {
 
+class executor;
+
 namespace detail {
 
 enum class node_state : std::uint32_t {
@@ -52,11 +57,13 @@ class graph_base;
 class graph_builder;
 class task;
 class sub_graph;
+struct topology;
 
 class graph_base : std::vector<std::unique_ptr<graph_node>> {
 
   friend class graph_node;
   friend class graph_builder;
+  friend class containers::executor;
 
   using base = std::vector<std::unique_ptr<graph_node>>;
 
@@ -72,6 +79,13 @@ public:
 
   auto operator=(graph_base&& other) -> graph_base& = default;
 
+  using base::size;
+  using base::clear;
+
+  auto is_empty() const noexcept -> bool {
+    return base::empty();
+  }
+
 private:
 
   auto _reserve(const std::size_t capacity) -> void;
@@ -102,10 +116,20 @@ struct is_static_task<Callable, std::enable_if_t<std::is_invocable_v<Callable>>>
 template <typename Callable>
 constexpr bool is_static_task_v = is_static_task<Callable>::value;
 
+template<typename Callable, typename = void>
+struct is_sub_graph_task : std::false_type { };
+
+template<typename Callable>
+struct is_sub_graph_task<Callable, std::enable_if_t<std::is_invocable_v<Callable, sub_graph&>>> : std::is_same<std::invoke_result_t<Callable, sub_graph&>, void> { };
+
+template <typename Callable>
+constexpr bool is_sub_graph_task_v = is_sub_graph_task<Callable>::value;
+
 class graph_node {
   
   friend class graph_builder;
   friend class task;
+  friend class containers::executor;
 
   using placeholder_task = std::monostate;
   
@@ -117,22 +141,22 @@ class graph_node {
     std::function<void()> work;
   }; // struct static_task
 
-  struct sub_graph {
+  struct sub_graph_task {
     
     template<typename Callable>
-    sub_graph(Callable&& callable);
+    sub_graph_task(Callable&& callable);
     
-    std::function<void(sub_graph&)> work;
+    std::function<void(detail::sub_graph&)> work;
     graph_base graph;
-  }; // struct sub_graph
+  }; // struct sub_graph_task
   
-  
-  using task_handle = std::variant<placeholder_task, static_task>;
+  using task_handle = std::variant<placeholder_task, static_task, sub_graph_task>;
 
 public:
 
   inline static constexpr auto placeholder = get_index_v<placeholder_task, task_handle>;
   inline static constexpr auto static_work = get_index_v<static_task, task_handle>;
+  inline static constexpr auto sub_graph_work = get_index_v<sub_graph_task, task_handle>;
 
   graph_node();
   
@@ -162,6 +186,11 @@ private:
   std::vector<graph_node*> _edges;
   task_handle _handle;
 
+  // Runtime state, only touched by the executor while the owning graph is running
+  std::atomic<std::size_t> _join_counter;
+  std::atomic<std::size_t> _pending_children;
+  topology* _topology;
+
 }; // class graph_node
 
 class task {
@@ -199,6 +228,13 @@ public:
   requires (is_static_task_v<Callable>)
   auto emplace(Callable&& callable) -> task;
 
+  /**
+   * @brief Emplaces a task that builds a sub graph at runtime. The task only completes once all tasks of its sub graph have completed.
+   */
+  template <typename Callable>
+  requires (is_sub_graph_task_v<Callable>)
+  auto emplace(Callable&& callable) -> task;
+
   template<typename... Callables>
   requires (sizeof...(Callables) > 1u)
   auto emplace(Callables&&... callables) -> decltype(auto);
@@ -213,8 +249,14 @@ private:
 
 class sub_graph : public graph_builder {
 
+  friend class containers::executor;
+
 public:
 
+  auto parent() const noexcept -> const graph_node* {
+    return _parent;
+  }
+
 private:
 
   sub_graph(graph_node* parent, graph_base& graph)
@@ -225,11 +267,11 @@ private:
 
 }; // class subgraph
 
-auto graph_base::_reserve(const std::size_t capacity) -> void {
+inline auto graph_base::_reserve(const std::size_t capacity) -> void {
   base::reserve(capacity);
 }
 
-auto graph_base::_erase(graph_node* node) -> void {
+inline auto graph_base::_erase(graph_node* node) -> void {
   base::erase(std::remove_if(base::begin(), base::end(), [&](auto& entry){ return entry.get() == node; }), base::end() );
 } 
 
@@ -244,14 +286,17 @@ graph_node::static_task::static_task(Callable&& callable)
 : work{std::forward<Callable>(callable)} { }
 
 template<typename Callable>
-graph_node::sub_graph::sub_graph(Callable&& callable)
+graph_node::sub_graph_task::sub_graph_task(Callable&& callable)
 : work{std::forward<Callable>(callable)} { }
 
-graph_node::graph_node()
+inline graph_node::graph_node()
 : _state{node_state::none},
   _data{nullptr},
   _parent{nullptr},
-  _num_successors{0u} { }
+  _num_successors{0u},
+  _join_counter{0u},
+  _pending_children{0u},
+  _topology{nullptr} { }
 
 template<typename... Args>
 graph_node::graph_node(node_state node_state, const task_parameters& parameters, graph_node* parent, Args&&... args)
@@ -260,7 +305,10 @@ graph_node::graph_node(node_state node_state, const task_parameters& parameters,
   _data{parameters.data},
   _parent{parent},
   _num_successors{0u},
-  _handle{std::forward<Args>(args)...} { }
+  _handle{std::forward<Args>(args)...},
+  _join_counter{0u},
+  _pending_children{0u},
+  _topology{nullptr} { }
 
 template<typename... Args>
 graph_node::graph_node(node_state node_state, const default_task_parameters& parameters, graph_node* parent, Args&&...args)
@@ -268,27 +316,30 @@ graph_node::graph_node(node_state node_state, const default_task_parameters& par
   _data{nullptr},
   _parent{parent},
   _num_successors{0u},
-  _handle{std::forward<Args>(args)...} { }
+  _handle{std::forward<Args>(args)...},
+  _join_counter{0u},
+  _pending_children{0u},
+  _topology{nullptr} { }
 
-auto graph_node::num_successors() const -> std::size_t {
+inline auto graph_node::num_successors() const -> std::size_t {
   return _num_successors;
 }
 
-auto graph_node::num_predecessors() const -> std::size_t {
+inline auto graph_node::num_predecessors() const -> std::size_t {
   return _edges.size() - _num_successors;
 }
 
-auto graph_node::name() const -> const std::string& {
+inline auto graph_node::name() const -> const std::string& {
   return _name;
 }
 
-auto graph_node::_precede(graph_node* node) -> void {
+inline auto graph_node::_precede(graph_node* node) -> void {
   _edges.push_back(node);
   std::swap(_edges[_num_successors++], _edges[_edges.size() - 1]);
   node->_edges.push_back(this);
 }
 
-auto graph_node::_remove_successors(graph_node* node) -> void {
+inline auto graph_node::_remove_successors(graph_node* node) -> void {
   auto sit = std::remove(_edges.begin(), _edges.begin() + _num_successors, node);
   size_t new_num_successors = std::distance(_edges.begin(), sit);
   std::move(_edges.begin() + _num_successors, _edges.end(), sit);
@@ -296,20 +347,20 @@ auto graph_node::_remove_successors(graph_node* node) -> void {
   _num_successors = new_num_successors;
 }
 
-auto graph_node::_remove_predecessors(graph_node* node) -> void {
+inline auto graph_node::_remove_predecessors(graph_node* node) -> void {
   _edges.erase(std::remove(_edges.begin() + _num_successors, _edges.end(), node), _edges.end());
 }
 
-auto task::name() const -> const std::string& {
+inline auto task::name() const -> const std::string& {
   return _node->name();
 }
 
-auto task::num_predecessors() const -> std::size_t {
+inline auto task::num_predecessors() const -> std::size_t {
   return _node->num_predecessors();
 }
 
-auto task::num_successors() const -> std::size_t {
-  return _node->num_predecessors();
+inline auto task::num_successors() const -> std::size_t {
+  return _node->num_successors();
 }
 
 template<typename... Tasks>
@@ -324,10 +375,10 @@ auto task::succeed(Tasks&&... tasks) -> task& {
   return *this;
 }
 
-task::task(graph_node* node)
+inline task::task(graph_node* node)
 : _node{node} { }
 
-graph_builder::graph_builder(graph_base& graph)
+inline graph_builder::graph_builder(graph_base& graph)
 : _graph{graph} { }
 
 template <typename Callable>
@@ -336,6 +387,12 @@ auto graph_builder::emplace(Callable&& callable) -> task {
   return task{_graph._emplace_back(node_state::none, default_task_parameters{}, nullptr, std::in_place_type_t<graph_node::static_task>{}, std::forward<Callable>(callable) )};
 }
 
+template <typename Callable>
+requires (is_sub_graph_task_v<Callable>)
+auto graph_builder::emplace(Callable&& callable) -> task {
+  return task{_graph._emplace_back(node_state::none, default_task_parameters{}, nullptr, std::in_place_type_t<graph_node::sub_graph_task>{}, std::forward<Callable>(callable))};
+}
+
 template<typename... Callables>
 requires (sizeof...(Callables) > 1u)
 auto graph_builder::emplace(Callables&&... callables) -> decltype(auto) {
@@ -347,6 +404,8 @@ auto graph_builder::emplace(Callables&&... callables) -> decltype(auto) {
 
 class task_graph : public detail::graph_builder {
 
+  friend class executor;
+
   using base = detail::graph_builder; 
 
 public:
@@ -355,6 +414,22 @@ public:
   : base{_graph},
     _name{name} { }
 
+  auto name() const noexcept -> const std::string& {
+    return _name;
+  }
+
+  auto size() const noexcept -> std::size_t {
+    return _graph.size();
+  }
+
+  auto is_empty() const noexcept -> bool {
+    return _graph.is_empty();
+  }
+
+  auto clear() -> void {
+    _graph.clear();
+  }
+
 private:
 
   detail::graph_base _graph;
@@ -0,0 +1,195 @@
+#ifndef LIBSBX_CONTAINERS_WORK_STEALING_DEQUE_HPP_
+#define LIBSBX_CONTAINERS_WORK_STEALING_DEQUE_HPP_
+
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <optional>
+#include <bit>
+
+#include <libsbx/utility/assert.hpp>
+
+#include <libsbx/memory/cache.hpp>
+
+namespace sbx::containers {
+
+/**
+ * @brief A lock-free single-producer multi-consumer deque (Chase-Lev).
+ *
+ * The owning thread pushes and pops at the bottom, any other thread may steal from the top.
+ * Retired buffers are kept alive until the deque is destroyed since a concurrent thief may still read from them.
+ *
+ * @tparam Type Trivially copyable element type, usually a pointer.
+ */
+template<typename Type>
+requires (std::is_trivially_copyable_v<Type>)
+class work_stealing_deque {
+
+  class buffer {
+
+  public:
+
+    explicit buffer(const std::int64_t capacity)
+    : _capacity{capacity},
+      _mask{capacity - 1},
+      _data{std::make_unique<std::atomic<Type>[]>(static_cast<std::size_t>(capacity))} {
+      utility::assert_that(std::has_single_bit(static_cast<std::uint64_t>(capacity)), "Capacity must be a power of two");
+    }
+
+    auto capacity() const noexcept -> std::int64_t {
+      return _capacity;
+    }
+
+    auto store(const std::int64_t index, const Type value) noexcept -> void {
+      _data[static_cast<std::size_t>(index & _mask)].store(value, std::memory_order_relaxed);
+    }
+
+    auto load(const std::int64_t index) const noexcept -> Type {
+      return _data[static_cast<std::size_t>(index & _mask)].load(std::memory_order_relaxed);
+    }
+
+    auto grow(const std::int64_t bottom, const std::int64_t top) const -> std::unique_ptr<buffer> {
+      auto result = std::make_unique<buffer>(_capacity * 2);
+
+      for (auto i = top; i != bottom; ++i) {
+        result->store(i, load(i));
+      }
+
+      return result;
+    }
+
+  private:
+
+    std::int64_t _capacity;
+    std::int64_t _mask;
+    std::unique_ptr<std::atomic<Type>[]> _data;
+
+  }; // class buffer
+
+public:
+
+  using value_type = Type;
+  using size_type = std::size_t;
+
+  explicit work_stealing_deque(const std::int64_t capacity = 1024)
+  : _top{0},
+    _bottom{0} {
+    _buffers.push_back(std::make_unique<buffer>(capacity));
+    _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+  }
+
+  work_stealing_deque(const work_stealing_deque& other) = delete;
+
+  work_stealing_deque(work_stealing_deque&& other) = delete;
+
+  ~work_stealing_deque() = default;
+
+  auto operator=(const work_stealing_deque& other) -> work_stealing_deque& = delete;
+
+  auto operator=(work_stealing_deque&& other) -> work_stealing_deque& = delete;
+
+  /**
+   * @brief Pushes a value to the bottom of the deque. May only be called by the owning thread.
+   */
+  auto push(const value_type value) -> void {
+    const auto bottom = _bottom.data.load(std::memory_order_relaxed);
+    const auto top = _top.data.load(std::memory_order_acquire);
+
+    auto* current = _buffer.load(std::memory_order_relaxed);
+
+    if (current->capacity() - 1 < (bottom - top)) {
+      _buffers.push_back(current->grow(bottom, top));
+      current = _buffers.back().get();
+      _buffer.store(current, std::memory_order_release);
+    }
+
+    current->store(bottom, value);
+
+    _bottom.data.store(bottom + 1, std::memory_order_release);
+  }
+
+  /**
+   * @brief Pops a value from the bottom of the deque. May only be called by the owning thread.
+   */
+  auto pop() -> std::optional<value_type> {
+    const auto bottom = _bottom.data.load(std::memory_order_relaxed) - 1;
+    auto* current = _buffer.load(std::memory_order_relaxed);
+
+    _bottom.data.store(bottom, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    auto top = _top.data.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+      _bottom.data.store(bottom + 1, std::memory_order_relaxed);
+      return std::nullopt;
+    }
+
+    auto value = current->load(bottom);
+
+    if (top == bottom) {
+      // Last element, race against thieves for it
+      if (!_top.data.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        _bottom.data.store(bottom + 1, std::memory_order_relaxed);
+        return std::nullopt;
+      }
+
+      _bottom.data.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    return value;
+  }
+
+  /**
+   * @brief Steals a value from the top of the deque. May be called by any thread.
+   */
+  auto steal() -> std::optional<value_type> {
+    auto top = _top.data.load(std::memory_order_acquire);
+
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    const auto bottom = _bottom.data.load(std::memory_order_acquire);
+
+    if (top >= bottom) {
+      return std::nullopt;
+    }
+
+    auto* current = _buffer.load(std::memory_order_acquire);
+    auto value = current->load(top);
+
+    if (!_top.data.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      return std::nullopt;
+    }
+
+    return value;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_type {
+    const auto bottom = _bottom.data.load(std::memory_order_relaxed);
+    const auto top = _top.data.load(std::memory_order_relaxed);
+
+    return static_cast<size_type>(bottom >= top ? bottom - top : 0);
+  }
+
+  [[nodiscard]] auto is_empty() const noexcept -> bool {
+    return size() == 0u;
+  }
+
+  [[nodiscard]] auto capacity() const noexcept -> size_type {
+    return static_cast<size_type>(_buffer.load(std::memory_order_relaxed)->capacity());
+  }
+
+private:
+
+  memory::cacheline_aligned<std::atomic<std::int64_t>> _top;
+  memory::cacheline_aligned<std::atomic<std::int64_t>> _bottom;
+  std::atomic<buffer*> _buffer;
+  std::vector<std::unique_ptr<buffer>> _buffers;
+
+}; // class work_stealing_deque
+
+} // namespace sbx::containers
+
+#endif // LIBSBX_CONTAINERS_WORK_STEALING_DEQUE_HPP_
@@ -0,0 +1,124 @@
+#ifndef LIBSBX_CONTAINERS_DYNAMIC_AABB_TREE_TESTS_HPP_
+#define LIBSBX_CONTAINERS_DYNAMIC_AABB_TREE_TESTS_HPP_
+
+#include <cmath>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/containers/dynamic_aabb_tree.hpp>
+
+namespace {
+
+auto unit_volume(const sbx::math::vector3& center) -> sbx::math::volume {
+  return sbx::math::volume{center - sbx::math::vector3{0.5f}, center + sbx::math::vector3{0.5f}};
+}
+
+template<typename Query>
+auto collect(const sbx::containers::dynamic_aabb_tree<std::uint32_t>& tree, const Query& query) -> std::vector<std::uint32_t> {
+  auto result = std::vector<std::uint32_t>{};
+
+  tree.query(query, [&result](const std::uint32_t value) { result.push_back(value); });
+
+  std::ranges::sort(result);
+
+  return result;
+}
+
+} // namespace
+
+TEST(libsbx_containers_dynamic_aabb_tree, queries_match_brute_force) {
+  auto tree = sbx::containers::dynamic_aabb_tree<std::uint32_t>{};
+  auto volumes = std::vector<sbx::math::volume>{};
+  auto proxies = std::vector<sbx::containers::dynamic_aabb_tree<std::uint32_t>::proxy_type>{};
+
+  auto engine = std::mt19937{42u};
+  auto distribution = std::uniform_real_distribution<std::float_t>{-50.0f, 50.0f};
+
+  for (auto i = 0u; i < 1000u; ++i) {
+    volumes.push_back(unit_volume(sbx::math::vector3{distribution(engine), distribution(engine), distribution(engine)}));
+    proxies.push_back(tree.insert(volumes.back(), i));
+  }
+
+  // Move half of the values, some of them far enough to leave their fat bounds
+  for (auto i = 0u; i < 1000u; i += 2u) {
+    const auto offset = sbx::math::vector3{distribution(engine), 0.0f, 0.0f} * 0.1f;
+
+    volumes[i] = sbx::math::volume{volumes[i].min() + offset, volumes[i].max() + offset};
+    tree.update(proxies[i], volumes[i], offset);
+  }
+
+  EXPECT_EQ(tree.size(), 1000u);
+  EXPECT_LE(tree.height(), 24);
+
+  const auto region = sbx::math::volume{sbx::math::vector3{-10.0f}, sbx::math::vector3{10.0f}};
+  const auto sphere = sbx::math::sphere{sbx::math::vector3{5.0f, 0.0f, -5.0f}, 12.0f};
+
+  auto expected_region = std::vector<std::uint32_t>{};
+  auto expected_sphere = std::vector<std::uint32_t>{};
+
+  for (auto i = 0u; i < 1000u; ++i) {
+    if (volumes[i].intersects(region)) {
+      expected_region.push_back(i);
+    }
+
+    const auto closest = sbx::math::vector3{sbx::math::vector3::min(sbx::math::vector3::max(sphere.center(), volumes[i].min()), volumes[i].max())};
+
+    if (sbx::math::vector3::distance_squared(closest, sphere.center()) <= sphere.radius() * sphere.radius()) {
+      expected_sphere.push_back(i);
+    }
+  }
+
+  EXPECT_EQ(collect(tree, region), expected_region);
+  EXPECT_EQ(collect(tree, sphere), expected_sphere);
+}
+
+TEST(libsbx_containers_dynamic_aabb_tree, ray_cast_returns_closest_hit) {
+  auto tree = sbx::containers::dynamic_aabb_tree<std::uint32_t>{};
+
+  tree.insert(unit_volume(sbx::math::vector3{0.0f, 0.0f, -10.0f}), 1u);
+  tree.insert(unit_volume(sbx::math::vector3{0.0f, 0.0f, -5.0f}), 2u);
+  tree.insert(unit_volume(sbx::math::vector3{3.0f, 0.0f, -2.0f}), 3u);
+
+  const auto ray = sbx::math::ray{sbx::math::vector3::zero, sbx::math::vector3::forward};
+
+  const auto hit = tree.ray_cast(ray, 100.0f);
+
+  ASSERT_TRUE(hit.has_value());
+  EXPECT_EQ(hit->value, 2u);
+  EXPECT_FLOAT_EQ(hit->distance, 4.5f);
+
+  EXPECT_FALSE(tree.ray_cast(ray, 4.0f).has_value());
+}
+
+TEST(libsbx_containers_dynamic_aabb_tree, nearest_is_ordered_by_distance) {
+  auto tree = sbx::containers::dynamic_aabb_tree<std::uint32_t>{};
+  auto proxies = std::vector<sbx::containers::dynamic_aabb_tree<std::uint32_t>::proxy_type>{};
+
+  for (auto i = 0u; i < 64u; ++i) {
+    proxies.push_back(tree.insert(unit_volume(sbx::math::vector3{static_cast<std::float_t>(i) * 2.0f, 0.0f, 0.0f}), i));
+  }
+
+  tree.remove(proxies[1u]);
+
+  const auto nearest = tree.nearest(sbx::math::vector3{0.0f, 0.0f, 0.0f}, 3u);
+
+  ASSERT_EQ(nearest.size(), 3u);
+  EXPECT_EQ(nearest[0u].value, 0u);
+  EXPECT_EQ(nearest[1u].value, 2u);
+  EXPECT_EQ(nearest[2u].value, 3u);
+  EXPECT_FLOAT_EQ(nearest[1u].distance, 3.5f);
+
+  for (const auto proxy : proxies) {
+    if (proxy != proxies[1u]) {
+      tree.remove(proxy);
+    }
+  }
+
+  EXPECT_TRUE(tree.is_empty());
+  EXPECT_TRUE(tree.nearest(sbx::math::vector3::zero, 3u).empty());
+}
+
+#endif // LIBSBX_CONTAINERS_DYNAMIC_AABB_TREE_TESTS_HPP_
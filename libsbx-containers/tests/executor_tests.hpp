@@ -0,0 +1,291 @@
+#ifndef LIBSBX_CONTAINERS_EXECUTOR_TESTS_HPP_
+#define LIBSBX_CONTAINERS_EXECUTOR_TESTS_HPP_
+
+#include <atomic>
+#include <mutex>
+#include <optional>
+#include <vector>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/containers/task_graph.hpp>
+#include <libsbx/containers/executor.hpp>
+
+namespace executor_tests {
+
+/**
+ * @brief A work source that counts down a number of queued items.
+ */
+class counting_source final : public sbx::containers::work_source {
+
+public:
+
+  auto push(const std::size_t count) -> void {
+    _queued.fetch_add(count, std::memory_order_seq_cst);
+  }
+
+  auto try_run(const std::optional<std::size_t> worker_id) -> bool override {
+    auto queued = _queued.load(std::memory_order_relaxed);
+
+    while (queued > 0u) {
+      if (_queued.compare_exchange_weak(queued, queued - 1u, std::memory_order_acq_rel)) {
+        if (worker_id) {
+          _on_worker.fetch_add(1u, std::memory_order_relaxed);
+        }
+
+        _completed.fetch_add(1u, std::memory_order_release);
+        _completed.notify_all();
+
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  [[nodiscard]] auto has_work() const noexcept -> bool override {
+    return _queued.load(std::memory_order_seq_cst) > 0u;
+  }
+
+  auto wait_for(const std::size_t count) const -> void {
+    for (auto completed = _completed.load(std::memory_order_acquire); completed < count; completed = _completed.load(std::memory_order_acquire)) {
+      _completed.wait(completed, std::memory_order_acquire);
+    }
+  }
+
+  [[nodiscard]] auto on_worker() const noexcept -> std::size_t {
+    return _on_worker.load(std::memory_order_relaxed);
+  }
+
+private:
+
+  std::atomic<std::size_t> _queued{0u};
+  std::atomic<std::size_t> _completed{0u};
+  std::atomic<std::size_t> _on_worker{0u};
+
+}; // class counting_source
+
+} // namespace executor_tests
+
+TEST(libsbx_containers_executor, empty_graph) {
+  auto executor = sbx::containers::executor{2u};
+  auto graph = sbx::containers::task_graph{"empty"};
+
+  executor.run(graph).get();
+  executor.run_and_wait(graph);
+
+  SUCCEED();
+}
+
+TEST(libsbx_containers_executor, linear_chain_runs_in_order) {
+  auto executor = sbx::containers::executor{4u};
+  auto graph = sbx::containers::task_graph{"chain"};
+
+  auto order = std::vector<std::uint32_t>{};
+
+  auto [a, b, c] = graph.emplace(
+    [&](){ order.push_back(0u); },
+    [&](){ order.push_back(1u); },
+    [&](){ order.push_back(2u); }
+  );
+
+  a.precede(b);
+  c.succeed(b);
+
+  EXPECT_EQ(a.num_successors(), 1u);
+  EXPECT_EQ(b.num_predecessors(), 1u);
+  EXPECT_EQ(b.num_successors(), 1u);
+
+  executor.run(graph).get();
+
+  EXPECT_EQ(order, (std::vector<std::uint32_t>{0u, 1u, 2u}));
+}
+
+TEST(libsbx_containers_executor, fork_join) {
+  static constexpr auto width = 1000u;
+
+  auto executor = sbx::containers::executor{4u};
+  auto graph = sbx::containers::task_graph{"fork_join"};
+
+  auto counter = std::atomic<std::uint32_t>{0u};
+  auto observed = std::uint32_t{0u};
+
+  auto source = graph.emplace([&](){ counter.store(0u); });
+  auto sink = graph.emplace([&](){ observed = counter.load(); });
+
+  for (auto i = 0u; i < width; ++i) {
+    auto task = graph.emplace([&](){ counter.fetch_add(1u); });
+    task.succeed(source).precede(sink);
+  }
+
+  for (auto run = 0u; run < 10u; ++run) {
+    observed = 0u;
+    executor.run_and_wait(graph);
+    EXPECT_EQ(observed, width);
+  }
+}
+
+TEST(libsbx_containers_executor, wide_dag_respects_dependencies) {
+  static constexpr auto layers = 16u;
+  static constexpr auto width = 64u;
+
+  auto executor = sbx::containers::executor{4u};
+  auto graph = sbx::containers::task_graph{"wide_dag"};
+
+  auto completed = std::vector<std::atomic<std::uint32_t>>(layers);
+  auto violations = std::atomic<std::uint32_t>{0u};
+
+  auto previous = std::vector<sbx::containers::detail::task>{};
+
+  for (auto layer = 0u; layer < layers; ++layer) {
+    auto current = std::vector<sbx::containers::detail::task>{};
+
+    for (auto i = 0u; i < width; ++i) {
+      auto task = graph.emplace([&, layer](){
+        if (layer > 0u && completed[layer - 1u].load() != width) {
+          violations.fetch_add(1u);
+        }
+
+        completed[layer].fetch_add(1u);
+      });
+
+      for (auto& predecessor : previous) {
+        task.succeed(predecessor);
+      }
+
+      current.push_back(task);
+    }
+
+    previous = std::move(current);
+  }
+
+  executor.run(graph).get();
+
+  EXPECT_EQ(violations.load(), 0u);
+
+  for (const auto& entry : completed) {
+    EXPECT_EQ(entry.load(), width);
+  }
+}
+
+TEST(libsbx_containers_executor, sub_graph_completes_before_successors) {
+  auto executor = sbx::containers::executor{4u};
+  auto graph = sbx::containers::task_graph{"sub_graph"};
+
+  auto children = std::atomic<std::uint32_t>{0u};
+  auto observed = std::uint32_t{0u};
+
+  auto parent = graph.emplace([&](sbx::containers::detail::sub_graph& sub_graph){
+    auto first = sub_graph.emplace([&](){ children.fetch_add(1u); });
+
+    for (auto i = 0u; i < 31u; ++i) {
+      auto child = sub_graph.emplace([&](){ children.fetch_add(1u); });
+      child.succeed(first);
+    }
+  });
+
+  auto after = graph.emplace([&](){ observed = children.load(); });
+
+  parent.precede(after);
+
+  executor.run_and_wait(graph);
+
+  EXPECT_EQ(observed, 32u);
+
+  // Sub graphs are rebuilt on every run
+  children.store(0u);
+  executor.run_and_wait(graph);
+
+  EXPECT_EQ(observed, 32u);
+}
+
+TEST(libsbx_containers_executor, nested_sub_graphs) {
+  auto executor = sbx::containers::executor{3u};
+  auto graph = sbx::containers::task_graph{"nested"};
+
+  auto leaves = std::atomic<std::uint32_t>{0u};
+
+  graph.emplace([&](sbx::containers::detail::sub_graph& outer){
+    for (auto i = 0u; i < 8u; ++i) {
+      outer.emplace([&](sbx::containers::detail::sub_graph& inner){
+        for (auto j = 0u; j < 8u; ++j) {
+          inner.emplace([&](){ leaves.fetch_add(1u); });
+        }
+      });
+    }
+  });
+
+  executor.run(graph).get();
+
+  EXPECT_EQ(leaves.load(), 64u);
+}
+
+TEST(libsbx_containers_executor, exception_is_propagated) {
+  auto executor = sbx::containers::executor{2u};
+  auto graph = sbx::containers::task_graph{"exception"};
+
+  auto is_skipped = true;
+
+  auto [a, b] = graph.emplace(
+    [](){ throw std::runtime_error{"failure"}; },
+    [&](){ is_skipped = false; }
+  );
+
+  a.precede(b);
+
+  EXPECT_THROW(executor.run(graph).get(), std::runtime_error);
+  EXPECT_TRUE(is_skipped);
+}
+
+TEST(libsbx_containers_executor, caller_executes_without_workers) {
+  auto executor = sbx::containers::executor{0u};
+  auto graph = sbx::containers::task_graph{"inline"};
+
+  auto counter = std::uint32_t{0u};
+
+  auto [a, b] = graph.emplace(
+    [&](){ ++counter; },
+    [&](){ counter *= 10u; }
+  );
+
+  a.precede(b);
+
+  executor.run_and_wait(graph);
+
+  EXPECT_EQ(counter, 10u);
+}
+
+TEST(libsbx_containers_executor, work_sources_are_polled) {
+  static constexpr auto count = 1000u;
+
+  auto executor = sbx::containers::executor{4u};
+  auto source = executor_tests::counting_source{};
+
+  executor.add_source(source);
+
+  // Sleeping workers are woken up by notify
+  for (auto i = 0u; i < count; ++i) {
+    source.push(1u);
+    executor.notify();
+  }
+
+  source.wait_for(count);
+
+  EXPECT_EQ(source.on_worker(), count);
+  EXPECT_FALSE(source.has_work());
+
+  executor.remove_source(source);
+
+  // Removed sources are not polled anymore
+  source.push(1u);
+  executor.notify();
+
+  auto graph = sbx::containers::task_graph{"after_remove"};
+  graph.emplace([](){});
+  executor.run_and_wait(graph);
+
+  EXPECT_TRUE(source.has_work());
+}
+
+#endif // LIBSBX_CONTAINERS_EXECUTOR_TESTS_HPP_
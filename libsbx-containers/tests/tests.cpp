@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
 
-#include <libsbx/containers/task_graph.hpp>
+#include <tests/work_stealing_deque_tests.hpp>
+#include <tests/executor_tests.hpp>
+#include <tests/dynamic_aabb_tree_tests.hpp>
 
 auto main(int argc, char* argv[]) -> int {
   testing::InitGoogleTest(&argc, argv);
@@ -0,0 +1,107 @@
+#ifndef LIBSBX_CONTAINERS_WORK_STEALING_DEQUE_TESTS_HPP_
+#define LIBSBX_CONTAINERS_WORK_STEALING_DEQUE_TESTS_HPP_
+
+#include <thread>
+#include <vector>
+#include <atomic>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/containers/work_stealing_deque.hpp>
+
+TEST(libsbx_containers_work_stealing_deque, pop_is_lifo) {
+  auto deque = sbx::containers::work_stealing_deque<std::uint32_t>{};
+
+  deque.push(1u);
+  deque.push(2u);
+  deque.push(3u);
+
+  EXPECT_EQ(deque.size(), 3u);
+
+  EXPECT_EQ(deque.pop(), 3u);
+  EXPECT_EQ(deque.pop(), 2u);
+  EXPECT_EQ(deque.pop(), 1u);
+  EXPECT_FALSE(deque.pop().has_value());
+  EXPECT_TRUE(deque.is_empty());
+}
+
+TEST(libsbx_containers_work_stealing_deque, steal_is_fifo) {
+  auto deque = sbx::containers::work_stealing_deque<std::uint32_t>{};
+
+  deque.push(1u);
+  deque.push(2u);
+  deque.push(3u);
+
+  EXPECT_EQ(deque.steal(), 1u);
+  EXPECT_EQ(deque.steal(), 2u);
+  EXPECT_EQ(deque.pop(), 3u);
+  EXPECT_FALSE(deque.steal().has_value());
+}
+
+TEST(libsbx_containers_work_stealing_deque, grows) {
+  auto deque = sbx::containers::work_stealing_deque<std::uint32_t>{2};
+
+  for (auto i = 0u; i < 100u; ++i) {
+    deque.push(i);
+  }
+
+  EXPECT_EQ(deque.size(), 100u);
+  EXPECT_GE(deque.capacity(), 100u);
+
+  for (auto i = 100u; i > 0u; --i) {
+    EXPECT_EQ(deque.pop(), i - 1u);
+  }
+}
+
+TEST(libsbx_containers_work_stealing_deque, concurrent_steal_takes_every_element_once) {
+  static constexpr auto count = 100000u;
+  static constexpr auto thieves = 4u;
+
+  auto deque = sbx::containers::work_stealing_deque<std::uint32_t>{16};
+  auto seen = std::vector<std::atomic<std::uint32_t>>(count);
+  auto taken = std::atomic<std::uint32_t>{0u};
+  auto is_done = std::atomic_bool{false};
+
+  auto threads = std::vector<std::thread>{};
+
+  for (auto i = 0u; i < thieves; ++i) {
+    threads.emplace_back([&](){
+      while (!is_done.load() || !deque.is_empty()) {
+        if (auto value = deque.steal()) {
+          seen[*value].fetch_add(1u);
+          taken.fetch_add(1u);
+        }
+      }
+    });
+  }
+
+  for (auto i = 0u; i < count; ++i) {
+    deque.push(i);
+
+    if (i % 3u == 0u) {
+      if (auto value = deque.pop()) {
+        seen[*value].fetch_add(1u);
+        taken.fetch_add(1u);
+      }
+    }
+  }
+
+  is_done.store(true);
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  while (auto value = deque.pop()) {
+    seen[*value].fetch_add(1u);
+    taken.fetch_add(1u);
+  }
+
+  EXPECT_EQ(taken.load(), count);
+
+  for (const auto& entry : seen) {
+    EXPECT_EQ(entry.load(), 1u);
+  }
+}
+
+#endif // LIBSBX_CONTAINERS_WORK_STEALING_DEQUE_TESTS_HPP_
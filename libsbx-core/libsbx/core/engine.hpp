@@ -10,6 +10,9 @@
 #include <cmath>
 #include <chrono>
 #include <ranges>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
 
 #include <range/v3/all.hpp>
 
@@ -20,10 +23,16 @@
 #include <libsbx/utility/assert.hpp>
 #include <libsbx/utility/type_name.hpp>
 #include <libsbx/utility/timer.hpp>
+#include <libsbx/utility/exception.hpp>
+#include <libsbx/utility/logger.hpp>
 
 #include <libsbx/units/time.hpp>
 
+#include <libsbx/containers/task_graph.hpp>
+#include <libsbx/containers/executor.hpp>
+
 #include <libsbx/core/module.hpp>
+#include <libsbx/core/stage_graph.hpp>
 #include <libsbx/core/application.hpp>
 #include <libsbx/core/cli.hpp>
 #include <libsbx/core/profiler.hpp>
@@ -40,17 +49,27 @@ class engine : public utility::noncopyable {
 public:
 
   engine(std::span<std::string_view> args)
-  : _cli{args} {
+  : _cli{args},
+    _executor{_cli.argument<std::uint32_t>("workers").value_or(std::max(std::thread::hardware_concurrency(), 1u) - 1u)} {
     utility::assert_that(_instance == nullptr, "Engine already exists.");
 
     _instance = this;
 
+    utility::logger<"core">::info("Running module stages on {} worker thread(s)", _executor.size());
+
+    core::profiler::instance().set_thread_name("main");
+    core::profiler::instance().set_history_size(_cli.argument<std::uint32_t>("profiler-history").value_or(core::profiler::default_history_size));
+
     for (auto&& [type, factory] : module_manager::_factories() | ranges::views::filter([](const auto& entry) { return entry.has_value(); }) | ranges::views::enumerate) {
       _create_module(type, *factory);
     }
+
+    _build_stage_graphs();
   }
 
   ~engine() {
+    _stage_graphs.clear();
+
     for (auto&& [type, entry] : _modules | ranges::views::enumerate | std::views::reverse) {
       _destroy_module(type);
     }
@@ -78,14 +97,21 @@ public:
     return _instance->_cli;
   }
 
-  // static auto profiler() noexcept -> core::profiler& {
-  //   return _instance->_profiler;
-  // }
+  static auto profiler() noexcept -> core::profiler& {
+    return core::profiler::instance();
+  }
 
   static auto settings() noexcept -> core::settings& {
     return _instance->_settings;
   }
 
+  /**
+   * @brief The executor that runs the module stages. Modules may use it to run their own task graphs.
+   */
+  static auto executor() noexcept -> containers::executor& {
+    return _instance->_executor;
+  }
+
   template<typename Module>
   requires (std::is_base_of_v<module_base, Module>)
   [[nodiscard]] static auto get_module() -> Module& {
@@ -159,6 +185,21 @@ public:
       EASY_BLOCK("stage rendering");
       _update_stage(stage::rendering);
       EASY_END_BLOCK;
+
+      core::profiler::instance().end_frame();
+    }
+
+    // Allows capturing the frame history of headless runs, e.g. --profiler-output=capture.json
+    if (const auto output = _cli.argument<std::string>("profiler-output")) {
+      const auto path = std::filesystem::path{*output};
+
+      if (path.extension() == ".json") {
+        core::profiler::instance().write_chrome_trace(path);
+      } else {
+        core::profiler::instance().write_capture(path);
+      }
+
+      utility::logger<"core">::info("Wrote profiler capture of {} frame(s) to '{}'", core::profiler::instance().frame_count(), path.string());
     }
   }
 
@@ -169,8 +210,14 @@ private:
       return;
     }
 
-    for (const auto& dependency : factory.dependencies) {
-      _create_module(dependency, *module_manager::_factories().at(dependency));
+    for (const auto& dependency : factory.access.dependencies) {
+      const auto& factories = module_manager::_factories();
+
+      if (dependency >= factories.size() || !factories[dependency]) {
+        throw utility::runtime_error{"Module dependency with id {} is not registered", dependency};
+      }
+
+      _create_module(dependency, *factories[dependency]);
     }
 
     if (type >= _modules.size()) {
@@ -188,7 +235,7 @@ private:
 
     auto& factory = module_manager::_factories().at(type);
 
-    for (const auto& dependency : factory->dependencies) {
+    for (const auto& dependency : factory->access.dependencies) {
       _destroy_module(dependency);
     }
 
@@ -197,8 +244,31 @@ private:
     _modules.at(type) = nullptr;
   }
 
+  /**
+   * @brief Builds one task graph per stage. Modules of a stage are ordered by their declared dependencies and conflicting accesses, everything else may run concurrently.
+   */
+  auto _build_stage_graphs() -> void {
+    const auto& factories = module_manager::_factories();
+
+    for (const auto& [stage, types] : _module_by_stage) {
+      auto nodes = std::vector<stage_node>{};
+      nodes.reserve(types.size());
+
+      for (const auto type : types) {
+        nodes.push_back(stage_node{type, &factories.at(type)->access, [module_instance = _modules.at(type)](){ module_instance->update(); }});
+      }
+
+      // Fully serialized stages keep running inline on the calling thread
+      if (auto graph = build_stage_graph(fmt::format("stage {}", static_cast<std::uint32_t>(stage)), nodes)) {
+        _stage_graphs[stage] = std::move(graph);
+      }
+    }
+  }
+
   auto _update_stage(stage stage) -> void {
-    if (auto entry = _module_by_stage.find(stage); entry != _module_by_stage.end()) {
+    if (auto graph = _stage_graphs.find(stage); graph != _stage_graphs.end()) {
+      _executor.run_and_wait(*graph->second);
+    } else if (auto entry = _module_by_stage.find(stage); entry != _module_by_stage.end()) {
       for (const auto& type : entry->second) {
         _modules.at(type)->update();
       }
@@ -213,11 +283,13 @@ private:
   bool _is_running{};
   // std::vector<std::string_view> _args{};
   core::cli _cli;
-  // core::profiler _profiler;
   core::settings _settings;
 
+  containers::executor _executor;
+
   std::vector<module_base*> _modules{};
   std::map<stage, std::vector<std::uint32_t>> _module_by_stage{};
+  std::map<stage, std::unique_ptr<containers::task_graph>> _stage_graphs{};
 
 }; // class engine
 
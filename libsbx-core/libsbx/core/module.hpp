@@ -10,16 +10,21 @@
 #include <cinttypes>
 #include <cmath>
 #include <optional>
+#include <algorithm>
 
 #include <libsbx/utility/noncopyable.hpp>
 #include <libsbx/utility/type_id.hpp>
 
+#include <libsbx/core/stage_graph.hpp>
+
 namespace sbx::core {
 
 namespace detail {
 
 struct core_type_id_scope { };
 
+struct core_access_id_scope { };
+
 } // namespace detail
 
 /**
@@ -30,6 +35,14 @@ struct core_type_id_scope { };
 template<typename Type>
 using type_id = utility::scoped_type_id<detail::core_type_id_scope, Type>;
 
+/**
+ * @brief A scoped type ID generator for resources that modules declare read or write access to.
+ *
+ * @tparam Type The resource type for which the ID is generated.
+ */
+template<typename Type>
+using access_id = utility::scoped_type_id<detail::core_access_id_scope, Type>;
+
 template<typename Derived, typename Base>
 concept derived_from = std::is_base_of_v<Base, Derived>;
 
@@ -58,15 +71,6 @@ private:
     rendering
   }; // enum class stage
 
-  template<typename... Types>
-  struct dependencies {
-    auto get() const noexcept -> std::unordered_set<std::uint32_t> {
-      auto types = std::unordered_set<std::uint32_t>{};
-      (types.insert(utility::type_id<Types>::value()), ...);
-      return types;
-    }
-  }; // struct dependencies
-
   struct module_base {
     virtual ~module_base() = default;
     virtual auto update() -> void = 0;
@@ -74,11 +78,52 @@ private:
 
   struct module_factory {
     module_manager::stage stage{};
-    std::unordered_set<std::uint32_t> dependencies{};
+    module_access access{};
     std::function<module_base*()> create{};
     std::function<void(module_base*)> destroy{};
   }; // module_factory
 
+  template<typename... Types>
+  struct dependencies {
+    auto get() const noexcept -> std::unordered_set<std::uint32_t> {
+      auto types = std::unordered_set<std::uint32_t>{};
+      (types.insert(type_id<Types>::value()), ...);
+      return types;
+    }
+
+    auto apply(module_factory& factory) const -> void {
+      factory.access.dependencies.merge(get());
+    }
+  }; // struct dependencies
+
+  template<typename... Types>
+  struct reads {
+    auto get() const noexcept -> std::unordered_set<std::uint32_t> {
+      auto types = std::unordered_set<std::uint32_t>{};
+      (types.insert(access_id<Types>::value()), ...);
+      return types;
+    }
+
+    auto apply(module_factory& factory) const -> void {
+      factory.access.reads.merge(get());
+      factory.access.is_exclusive = false;
+    }
+  }; // struct reads
+
+  template<typename... Types>
+  struct writes {
+    auto get() const noexcept -> std::unordered_set<std::uint32_t> {
+      auto types = std::unordered_set<std::uint32_t>{};
+      (types.insert(access_id<Types>::value()), ...);
+      return types;
+    }
+
+    auto apply(module_factory& factory) const -> void {
+      factory.access.writes.merge(get());
+      factory.access.is_exclusive = false;
+    }
+  }; // struct writes
+
   static auto _factories() -> std::vector<std::optional<module_factory>>& {
     static auto instance = std::vector<std::optional<module_factory>>{};
     return instance;
@@ -100,22 +145,36 @@ protected:
 
   using base_type = module_manager::module_base;
 
-  template<typename... Dependencies>
+  template<derived_from<base_type>... Dependencies>
   using dependencies = module_manager::dependencies<Dependencies...>;
 
+  template<typename... Types>
+  using reads = module_manager::reads<Types...>;
+
+  template<typename... Types>
+  using writes = module_manager::writes<Types...>;
+
   using stage = module_manager::stage;
 
-  template<derived_from<base_type>... Dependencies>
-  static auto register_module(stage stage, dependencies<Dependencies...>&& dependencies = {}) -> bool {
+  /**
+   * @brief Registers the module for the given stage.
+   *
+   * @param stage The stage in which the update of the module is called.
+   * @param declarations Any number of dependencies<...>, reads<...> and writes<...> declarations. 
+   * Modules of the same stage that neither depend on each other nor have conflicting accesses may be updated concurrently.
+   * Modules without any reads or writes declaration are never updated concurrently with other modules. An empty reads<> declares that the update
+   * does not touch any shared state.
+   */
+  template<typename... Declarations>
+  static auto register_module(stage stage, Declarations&&... declarations) -> bool {
     const auto type = type_id<Derived>::value();
 
     auto& factories = module_manager::_factories();
 
     factories.resize(std::max(factories.size(), static_cast<std::size_t>(type + 1u)));
 
-    factories[type] = module_manager::module_factory{
+    auto factory = module_manager::module_factory{
       .stage = stage,
-      .dependencies = dependencies.get(),
       .create = [](){
         auto* instance = reinterpret_cast<Derived*>(std::malloc(sizeof(Derived)));
 
@@ -133,6 +192,10 @@ protected:
       }
     };
 
+    (declarations.apply(factory), ...);
+
+    factories[type] = std::move(factory);
+
     return true;
   }
 
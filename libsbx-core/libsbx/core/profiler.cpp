@@ -0,0 +1,381 @@
+#include <libsbx/core/profiler.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <limits>
+#include <algorithm>
+#include <cmath>
+
+#include <fmt/format.h>
+
+#include <libsbx/utility/logger.hpp>
+
+namespace sbx::core {
+
+namespace {
+
+auto summarize(std::vector<std::uint64_t>& samples) -> duration_statistics {
+  if (samples.empty()) {
+    return duration_statistics{};
+  }
+
+  std::ranges::sort(samples);
+
+  const auto count = samples.size();
+
+  // Nearest rank percentile
+  const auto percentile = [&](const double fraction) -> std::chrono::nanoseconds {
+    const auto rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(count)));
+    return std::chrono::nanoseconds{static_cast<std::int64_t>(samples[std::max(rank, std::size_t{1u}) - 1u])};
+  };
+
+  auto sum = std::uint64_t{0u};
+
+  for (const auto sample : samples) {
+    sum += sample;
+  }
+
+  return duration_statistics{
+    .min = std::chrono::nanoseconds{static_cast<std::int64_t>(samples.front())},
+    .average = std::chrono::nanoseconds{static_cast<std::int64_t>(sum / count)},
+    .max = std::chrono::nanoseconds{static_cast<std::int64_t>(samples.back())},
+    .p50 = percentile(0.50),
+    .p95 = percentile(0.95),
+    .p99 = percentile(0.99)
+  };
+}
+
+auto escape_json(const std::string_view string) -> std::string {
+  auto result = std::string{};
+  result.reserve(string.size());
+
+  for (const auto character : string) {
+    switch (character) {
+      case '"': result += "\\\""; break;
+      case '\\': result += "\\\\"; break;
+      case '\n': result += "\\n"; break;
+      case '\t': result += "\\t"; break;
+      default: {
+        if (static_cast<unsigned char>(character) < 0x20u) {
+          result += fmt::format("\\u{:04x}", static_cast<unsigned int>(character));
+        } else {
+          result += character;
+        }
+      }
+    }
+  }
+
+  return result;
+}
+
+auto write_varint(std::ostream& stream, std::uint64_t value) -> void {
+  while (value >= 0x80u) {
+    stream.put(static_cast<char>((value & 0x7Fu) | 0x80u));
+    value >>= 7u;
+  }
+
+  stream.put(static_cast<char>(value));
+}
+
+auto write_string(std::ostream& stream, const std::string_view string) -> void {
+  write_varint(stream, string.size());
+  stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+}
+
+auto zigzag(const std::int64_t value) -> std::uint64_t {
+  return (static_cast<std::uint64_t>(value) << 1u) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+} // namespace
+
+auto profiler::set_history_size(const std::size_t size) -> void {
+  utility::assert_that(size > 0u, "History must hold at least one frame");
+
+  auto lock = std::scoped_lock{_history_mutex};
+
+  _history_size = size;
+  _frames.clear();
+  _next_frame = 0u;
+}
+
+auto profiler::register_scope(const std::string_view label, const std::string_view file, const std::string_view function, const std::uint32_t line) -> std::uint32_t {
+  auto key = fmt::format("{}:{}:{}", file, line, label);
+
+  auto lock = std::scoped_lock{_scopes_mutex};
+
+  if (auto entry = _scope_ids.find(key); entry != _scope_ids.end()) {
+    return entry->second;
+  }
+
+  const auto id = static_cast<std::uint32_t>(_scopes.size());
+
+  _scopes.push_back(scope_descriptor{
+    .label = label,
+    .file = file,
+    .function = function,
+    .line = line
+  });
+
+  _scope_ids.emplace(std::move(key), id);
+
+  return id;
+}
+
+auto profiler::scope(const std::uint32_t id) const -> scope_descriptor {
+  auto lock = std::scoped_lock{_scopes_mutex};
+
+  return _scopes.at(id);
+}
+
+auto profiler::set_thread_name(std::string name) -> void {
+  auto* ring = _thread_ring();
+
+  auto lock = std::scoped_lock{_threads_mutex};
+
+  _threads[ring->thread()].name = std::move(name);
+}
+
+auto profiler::_acquire_ring() -> detail::event_ring* {
+  auto lock = std::scoped_lock{_threads_mutex};
+
+  // Rings of threads that have exited are handed to new threads. Their pending events keep the thread index of the ring
+  for (auto& entry : _threads) {
+    if (entry.ring->is_retired()) {
+      entry.ring->revive();
+      entry.name = fmt::format("thread {}", entry.ring->thread());
+
+      return entry.ring.get();
+    }
+  }
+
+  utility::assert_that(_threads.size() < std::numeric_limits<std::uint16_t>::max(), "Too many profiled threads");
+
+  const auto index = static_cast<std::uint16_t>(_threads.size());
+
+  auto& entry = _threads.emplace_back(thread_entry{
+    .name = fmt::format("thread {}", index),
+    .ring = std::make_unique<detail::event_ring>(index, ring_capacity)
+  });
+
+  return entry.ring.get();
+}
+
+auto profiler::end_frame() -> void {
+  auto lock = std::scoped_lock{_history_mutex};
+
+  const auto end = now();
+
+  auto& target = (_frames.size() < _history_size) ? _frames.emplace_back() : _frames[_next_frame];
+
+  _next_frame = (_next_frame + 1u) % _history_size;
+
+  target.index = _frame_index++;
+  target.begin = _frame_begin;
+  target.end = end;
+  target.events.clear();
+
+  _frame_begin = end;
+
+  auto threads_lock = std::scoped_lock{_threads_mutex};
+
+  for (auto& entry : _threads) {
+    entry.ring->drain([&](const profiler_event& event){
+      target.events.push_back(event);
+    });
+  }
+}
+
+auto profiler::frame_statistics() const -> duration_statistics {
+  auto samples = std::vector<std::uint64_t>{};
+
+  for_each_frame([&](const frame& frame){
+    samples.push_back(frame.end - frame.begin);
+  });
+
+  return summarize(samples);
+}
+
+auto profiler::statistics() const -> std::vector<scope_statistics> {
+  const auto scope_count = [&](){
+    auto lock = std::scoped_lock{_scopes_mutex};
+    return _scopes.size();
+  }();
+
+  auto samples = std::vector<std::vector<std::uint64_t>>(scope_count);
+  auto calls = std::vector<std::uint64_t>(scope_count, 0u);
+
+  auto totals = std::vector<std::uint64_t>(scope_count, 0u);
+  auto touched = std::vector<std::uint32_t>{};
+
+  for_each_frame([&](const frame& frame){
+    for (const auto& event : frame.events) {
+      if (event.scope >= scope_count) {
+        continue;
+      }
+
+      if (totals[event.scope] == 0u) {
+        touched.push_back(event.scope);
+      }
+
+      // Zero length scopes still count as being present in the frame
+      totals[event.scope] += std::max(event.end - event.begin, std::uint64_t{1u});
+      ++calls[event.scope];
+    }
+
+    for (const auto scope : touched) {
+      samples[scope].push_back(totals[scope]);
+      totals[scope] = 0u;
+    }
+
+    touched.clear();
+  });
+
+  auto result = std::vector<scope_statistics>{};
+
+  for (auto scope = 0u; scope < scope_count; ++scope) {
+    if (samples[scope].empty()) {
+      continue;
+    }
+
+    result.push_back(scope_statistics{
+      .scope = scope,
+      .frames = static_cast<std::uint32_t>(samples[scope].size()),
+      .calls = calls[scope],
+      .time = summarize(samples[scope])
+    });
+  }
+
+  return result;
+}
+
+auto profiler::dropped_events() const -> std::uint64_t {
+  auto lock = std::scoped_lock{_threads_mutex};
+
+  auto dropped = std::uint64_t{0u};
+
+  for (const auto& entry : _threads) {
+    dropped += entry.ring->dropped();
+  }
+
+  return dropped;
+}
+
+auto profiler::write_chrome_trace(const std::filesystem::path& path) const -> void {
+  auto stream = std::ofstream{path, std::ios::out | std::ios::trunc};
+
+  if (!stream.is_open()) {
+    throw utility::runtime_error{"Failed to open profiler trace '{}'", path.string()};
+  }
+
+  // Frames are shown as a separate track below all threads
+  static constexpr auto frame_thread = std::numeric_limits<std::uint16_t>::max();
+
+  const auto microseconds = [](const std::uint64_t nanoseconds) -> double {
+    return static_cast<double>(nanoseconds) / 1000.0;
+  };
+
+  auto is_first = true;
+
+  const auto separator = [&]() -> std::string_view {
+    return std::exchange(is_first, false) ? "\n" : ",\n";
+  };
+
+  stream << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+  {
+    auto lock = std::scoped_lock{_threads_mutex};
+
+    for (const auto& entry : _threads) {
+      stream << separator() << fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"{}"}}}})", entry.ring->thread(), escape_json(entry.name));
+    }
+  }
+
+  stream << separator() << fmt::format(R"({{"name":"thread_name","ph":"M","pid":1,"tid":{},"args":{{"name":"frames"}}}})", frame_thread);
+
+  auto lock = std::scoped_lock{_scopes_mutex};
+
+  for_each_frame([&](const frame& frame){
+    stream << separator() << fmt::format(R"({{"name":"frame {}","cat":"frame","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f}}})", frame.index, frame_thread, microseconds(frame.begin), microseconds(frame.end - frame.begin));
+
+    for (const auto& event : frame.events) {
+      const auto& scope = _scopes[event.scope];
+
+      stream << separator() << fmt::format(R"({{"name":"{}","cat":"scope","ph":"X","pid":1,"tid":{},"ts":{:.3f},"dur":{:.3f},"args":{{"file":"{}","line":{}}}}})", escape_json(scope.label), event.thread, microseconds(event.begin), microseconds(event.end - event.begin), escape_json(scope.file), scope.line);
+    }
+  });
+
+  stream << "\n]}\n";
+}
+
+/**
+ * Capture layout. All integers are LEB128 varints, strings are a varint length followed by the characters.
+ *
+ *   magic 'SBXP' (4 bytes), version
+ *   scope count,  scopes:  label, file, function, line
+ *   thread count, threads: name
+ *   frame count,  frames:  index, begin, duration, event count,
+ *                          events: scope, thread, depth, zigzag(begin - frame begin), duration
+ *
+ * Times are nanoseconds since the profiler was created.
+ */
+auto profiler::write_capture(const std::filesystem::path& path) const -> void {
+  static constexpr auto magic = std::string_view{"SBXP"};
+  static constexpr auto version = std::uint64_t{1u};
+
+  auto stream = std::ofstream{path, std::ios::out | std::ios::binary | std::ios::trunc};
+
+  if (!stream.is_open()) {
+    throw utility::runtime_error{"Failed to open profiler capture '{}'", path.string()};
+  }
+
+  stream.write(magic.data(), static_cast<std::streamsize>(magic.size()));
+  write_varint(stream, version);
+
+  {
+    auto lock = std::scoped_lock{_scopes_mutex};
+
+    write_varint(stream, _scopes.size());
+
+    for (const auto& scope : _scopes) {
+      write_string(stream, scope.label);
+      write_string(stream, scope.file);
+      write_string(stream, scope.function);
+      write_varint(stream, scope.line);
+    }
+  }
+
+  {
+    auto lock = std::scoped_lock{_threads_mutex};
+
+    write_varint(stream, _threads.size());
+
+    for (const auto& entry : _threads) {
+      write_string(stream, entry.name);
+    }
+  }
+
+  auto frames = std::ostringstream{std::ios::out | std::ios::binary};
+  auto count = std::size_t{0u};
+
+  for_each_frame([&](const frame& frame){
+    write_varint(frames, frame.index);
+    write_varint(frames, frame.begin);
+    write_varint(frames, frame.end - frame.begin);
+    write_varint(frames, frame.events.size());
+
+    for (const auto& event : frame.events) {
+      write_varint(frames, event.scope);
+      write_varint(frames, event.thread);
+      write_varint(frames, event.depth);
+      write_varint(frames, zigzag(static_cast<std::int64_t>(event.begin) - static_cast<std::int64_t>(frame.begin)));
+      write_varint(frames, event.end - event.begin);
+    }
+
+    ++count;
+  });
+
+  write_varint(stream, count);
+  stream << frames.view();
+}
+
+} // namespace sbx::core
@@ -1,17 +1,29 @@
 #ifndef LIBSBX_CORE_PROFILER_HPP_
 #define LIBSBX_CORE_PROFILER_HPP_
 
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <ranges>
 #include <chrono>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <vector>
+#include <deque>
+#include <span>
+#include <filesystem>
+#include <functional>
 
 #include <libsbx/units/time.hpp>
 
 #include <libsbx/utility/hashed_string.hpp>
 #include <libsbx/utility/iterator.hpp>
 #include <libsbx/utility/exception.hpp>
+#include <libsbx/utility/assert.hpp>
+
+#include <libsbx/memory/cache.hpp>
 
 namespace sbx::core {
 
@@ -99,12 +111,333 @@ private:
 
 }; // class sampler
 
+
+/**
+ * @brief Source location of a profiled scope. Scopes are registered once per call site and shared by all threads.
+ */
+struct scope_descriptor {
+  std::string_view label;
+  std::string_view file;
+  std::string_view function;
+  std::uint32_t line;
+}; // struct scope_descriptor
+
+/**
+ * @brief A single completed scope. Times are in nanoseconds since the profiler was created.
+ */
+struct profiler_event {
+  std::uint32_t scope;
+  std::uint16_t thread;
+  std::uint16_t depth;
+  std::uint64_t begin;
+  std::uint64_t end;
+}; // struct profiler_event
+
+struct duration_statistics {
+  std::chrono::nanoseconds min;
+  std::chrono::nanoseconds average;
+  std::chrono::nanoseconds max;
+  std::chrono::nanoseconds p50;
+  std::chrono::nanoseconds p95;
+  std::chrono::nanoseconds p99;
+}; // struct duration_statistics
+
+/**
+ * @brief Aggregate of a scope over the recorded frame history. Durations are the time spent in the scope per frame, summed over all calls and threads.
+ */
+struct scope_statistics {
+  std::uint32_t scope;
+  std::uint32_t frames;
+  std::uint64_t calls;
+  duration_statistics time;
+}; // struct scope_statistics
+
+namespace detail {
+
+/**
+ * @brief Single producer single consumer ring of events. The owning thread pushes, the thread that ends the frame drains.
+ *
+ * Events are dropped instead of blocking the producer when the ring is full.
+ */
+class event_ring {
+
+public:
+
+  event_ring(const std::uint16_t thread, const std::size_t capacity)
+  : _thread{thread},
+    _mask{capacity - 1u},
+    _events{std::make_unique_for_overwrite<profiler_event[]>(capacity)},
+    _head{0u},
+    _tail{0u},
+    _dropped{0u},
+    _is_retired{false} {
+    utility::assert_that(capacity > 0u && (capacity & _mask) == 0u, "Capacity must be a power of two");
+  }
+
+  [[nodiscard]] auto thread() const noexcept -> std::uint16_t {
+    return _thread;
+  }
+
+  auto push(const profiler_event& event) noexcept -> void {
+    const auto head = _head.data.load(std::memory_order_relaxed);
+    const auto tail = _tail.data.load(std::memory_order_acquire);
+
+    if (head - tail > _mask) {
+      _dropped.fetch_add(1u, std::memory_order_relaxed);
+      return;
+    }
+
+    _events[head & _mask] = event;
+
+    _head.data.store(head + 1u, std::memory_order_release);
+  }
+
+  template<typename Consumer>
+  auto drain(Consumer&& consumer) -> void {
+    const auto tail = _tail.data.load(std::memory_order_relaxed);
+    const auto head = _head.data.load(std::memory_order_acquire);
+
+    for (auto i = tail; i != head; ++i) {
+      std::invoke(consumer, _events[i & _mask]);
+    }
+
+    _tail.data.store(head, std::memory_order_release);
+  }
+
+  [[nodiscard]] auto dropped() const noexcept -> std::uint64_t {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+  auto retire() noexcept -> void {
+    _is_retired.store(true, std::memory_order_release);
+  }
+
+  [[nodiscard]] auto is_retired() const noexcept -> bool {
+    return _is_retired.load(std::memory_order_acquire);
+  }
+
+  auto revive() noexcept -> void {
+    _is_retired.store(false, std::memory_order_relaxed);
+  }
+
+private:
+
+  std::uint16_t _thread;
+  std::size_t _mask;
+  std::unique_ptr<profiler_event[]> _events;
+  memory::cacheline_aligned<std::atomic<std::size_t>> _head;
+  memory::cacheline_aligned<std::atomic<std::size_t>> _tail;
+  std::atomic<std::uint64_t> _dropped;
+  std::atomic_bool _is_retired;
+
+}; // class event_ring
+
+} // namespace detail
+
+/**
+ * @brief Frame based profiler that collects scopes from all threads.
+ *
+ * Every thread records completed scopes into its own lock-free ring. At the end of every frame the rings are drained into the frame history which keeps the last N frames.
+ * The history can be aggregated into per scope statistics or exported as a Chrome trace (chrome://tracing, Perfetto) or as a compact binary capture. Nothing depends on a window or the editor.
+ */
+class profiler {
+
+  struct thread_entry {
+    std::string name;
+    std::unique_ptr<detail::event_ring> ring;
+  }; // struct thread_entry
+
+  struct thread_state {
+
+    ~thread_state() {
+      if (ring != nullptr) {
+        ring->retire();
+      }
+    }
+
+    detail::event_ring* ring{nullptr};
+
+  }; // struct thread_state
+
+public:
+
+  struct frame {
+    std::uint64_t index;
+    std::uint64_t begin;
+    std::uint64_t end;
+    std::vector<profiler_event> events;
+  }; // struct frame
+
+  inline static constexpr auto default_history_size = std::size_t{300u};
+  inline static constexpr auto ring_capacity = std::size_t{8192u};
+
+  profiler(const profiler& other) = delete;
+
+  profiler(profiler&& other) = delete;
+
+  auto operator=(const profiler& other) -> profiler& = delete;
+
+  auto operator=(profiler&& other) -> profiler& = delete;
+
+  /**
+   * @brief The process wide profiler. It is never destroyed so threads may still record while the program exits.
+   */
+  static auto instance() -> profiler& {
+    static auto* instance = new profiler{};
+    return *instance;
+  }
+
+  [[nodiscard]] auto now() const noexcept -> std::uint64_t {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - _epoch).count());
+  }
+
+  [[nodiscard]] auto is_enabled() const noexcept -> bool {
+    return _is_enabled.load(std::memory_order_relaxed);
+  }
+
+  auto set_enabled(const bool is_enabled) noexcept -> void {
+    _is_enabled.store(is_enabled, std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto history_size() const -> std::size_t {
+    auto lock = std::scoped_lock{_history_mutex};
+    return _history_size;
+  }
+
+  /**
+   * @brief Sets the number of frames that are kept. Clears the current history.
+   */
+  auto set_history_size(const std::size_t size) -> void;
+
+  /**
+   * @brief Returns the id of the scope at the given call site, registering it on first use.
+   */
+  auto register_scope(const std::string_view label, const std::string_view file, const std::string_view function, const std::uint32_t line) -> std::uint32_t;
+
+  [[nodiscard]] auto scope(const std::uint32_t id) const -> scope_descriptor;
+
+  /**
+   * @brief Names the calling thread in exported traces.
+   */
+  auto set_thread_name(std::string name) -> void;
+
+  /**
+   * @brief Records a completed scope of the calling thread. Never blocks and never allocates after the first event of a thread.
+   */
+  auto record(const std::uint32_t scope, const std::uint16_t depth, const std::uint64_t begin, const std::uint64_t end) -> void {
+    if (!is_enabled()) {
+      return;
+    }
+
+    auto* ring = _thread_ring();
+
+    ring->push(profiler_event{
+      .scope = scope,
+      .thread = ring->thread(),
+      .depth = depth,
+      .begin = begin,
+      .end = end
+    });
+  }
+
+  /**
+   * @brief Closes the current frame. Drains the events of all threads into the frame history. Usually called once per frame by the engine.
+   */
+  auto end_frame() -> void;
+
+  [[nodiscard]] auto frame_count() const -> std::size_t {
+    auto lock = std::scoped_lock{_history_mutex};
+    return _frames.size();
+  }
+
+  /**
+   * @brief Invokes the function for every frame in the history from oldest to newest.
+   */
+  template<typename Function>
+  requires (std::is_invocable_v<Function, const frame&>)
+  auto for_each_frame(Function&& function) const -> void {
+    auto lock = std::scoped_lock{_history_mutex};
+
+    const auto count = _frames.size();
+    const auto first = (count < _history_size) ? 0u : _next_frame;
+
+    for (auto i = 0u; i < count; ++i) {
+      std::invoke(function, _frames[(first + i) % count]);
+    }
+  }
+
+  [[nodiscard]] auto frame_statistics() const -> duration_statistics;
+
+  [[nodiscard]] auto statistics() const -> std::vector<scope_statistics>;
+
+  /**
+   * @brief Number of events that were lost because a thread ring was full.
+   */
+  [[nodiscard]] auto dropped_events() const -> std::uint64_t;
+
+  /**
+   * @brief Writes the history in the Chrome trace event format.
+   */
+  auto write_chrome_trace(const std::filesystem::path& path) const -> void;
+
+  /**
+   * @brief Writes the history as a binary capture. See profiler.cpp for the layout.
+   */
+  auto write_capture(const std::filesystem::path& path) const -> void;
+
+private:
+
+  using clock_type = std::chrono::steady_clock;
+
+  profiler()
+  : _epoch{clock_type::now()},
+    _is_enabled{true},
+    _history_size{default_history_size},
+    _next_frame{0u},
+    _frame_index{0u},
+    _frame_begin{0u} { }
+
+  ~profiler() = default;
+
+  auto _thread_ring() -> detail::event_ring* {
+    thread_local auto state = thread_state{};
+
+    if (state.ring == nullptr) [[unlikely]] {
+      state.ring = _acquire_ring();
+    }
+
+    return state.ring;
+  }
+
+  auto _acquire_ring() -> detail::event_ring*;
+
+  clock_type::time_point _epoch;
+  std::atomic_bool _is_enabled;
+
+  mutable std::mutex _scopes_mutex;
+  std::deque<scope_descriptor> _scopes;
+  std::unordered_map<std::string, std::uint32_t> _scope_ids;
+
+  mutable std::mutex _threads_mutex;
+  std::vector<thread_entry> _threads;
+
+  mutable std::mutex _history_mutex;
+  std::size_t _history_size;
+  std::vector<frame> _frames;
+  std::size_t _next_frame;
+  std::uint64_t _frame_index;
+  std::uint64_t _frame_begin;
+
+}; // class profiler
+
+/**
+ * @brief Live per thread call tree of the most recent scope timings, used by the editor.
+ */
 struct scope_info {
 
   using node_id = std::uint64_t;
 
   inline static constexpr auto null_node = static_cast<node_id>(-1);
-  inline static constexpr auto max_nodes = std::uint64_t{516u};
 
   inline static constexpr auto null_time = std::chrono::microseconds{static_cast<std::uint64_t>(-1)};
 
@@ -121,27 +454,24 @@ struct scope_info {
 
   std::uint32_t depth;
 
+  std::uint32_t scope;
+
 }; // struct scope_info
 
 namespace detail {
 
 struct database {
 
-  std::array<scope_info, scope_info::max_nodes> nodes;
+  std::vector<scope_info> nodes;
 
-  scope_info::node_id next_node_id = 0u;
   scope_info::node_id current_node_id = scope_info::null_node;
 
   std::uint32_t current_depth = 0u;
 
-  [[nodiscard]] auto create_node(const std::string_view label, const std::string_view file, const std::string_view function, const std::uint32_t line) -> scope_info& {
-    if (next_node_id >= scope_info::max_nodes) [[unlikely]] {
-      throw utility::runtime_error("Profiler exceeded maximum number of nodes ({})", scope_info::max_nodes);
-    }
-
-    const auto id = next_node_id++;
+  [[nodiscard]] auto create_node(const std::string_view label, const std::string_view file, const std::string_view function, const std::uint32_t line) -> scope_info::node_id {
+    const auto id = scope_info::node_id{nodes.size()};
 
-    nodes[id] = scope_info{
+    nodes.push_back(scope_info{
       .label = label,
       .file = file,
       .function = function,
@@ -150,9 +480,10 @@ struct database {
       .id = id,
       .parent_id = scope_info::null_node,
       .depth = current_depth,
-    };
+      .scope = profiler::instance().register_scope(label, file, function, line)
+    });
 
-    return nodes[id];
+    return id;
   }
 
   inline static auto instance() -> database& {
@@ -164,28 +495,34 @@ struct database {
 
 struct scope_guard {
 
-  using clock = std::chrono::steady_clock;
-
-  scope_info& info;
-  clock::time_point start_time;
+  scope_info::node_id id;
+  std::uint64_t start_time;
   scope_info::node_id previous_node_id;
 
-
-  explicit scope_guard(scope_info& info)
-  : info{info},
-    start_time{clock::now()},
+  explicit scope_guard(const scope_info::node_id id)
+  : id{id},
+    start_time{profiler::instance().now()},
     previous_node_id{database::instance().current_node_id} {
-    info.parent_id = database::instance().current_node_id;
-    database::instance().current_node_id = info.id;
-    database::instance().current_depth = info.depth + 1u;
+    auto& nodes = database::instance();
+    auto& info = nodes.nodes[id];
+
+    info.parent_id = nodes.current_node_id;
+    nodes.current_node_id = info.id;
+    nodes.current_depth = info.depth + 1u;
   }
 
+  ~scope_guard() {
+    auto& recorder = profiler::instance();
+    auto& nodes = database::instance();
+    auto& info = nodes.nodes[id];
 
+    const auto end_time = recorder.now();
 
-  ~scope_guard() {
-    info.time = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - start_time);
-    database::instance().current_node_id = previous_node_id;
-    database::instance().current_depth = info.depth;
+    info.time = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::nanoseconds{static_cast<std::int64_t>(end_time - start_time)});
+    nodes.current_node_id = previous_node_id;
+    nodes.current_depth = info.depth;
+
+    recorder.record(info.scope, static_cast<std::uint16_t>(info.depth), start_time, end_time);
   }
   
 }; // struct scope_guard
@@ -207,15 +544,15 @@ struct scope_guard {
 } // namespace detail
 
 #define SBX_PROFILE_SCOPE(label) \
-  static thread_local auto& SBX_UNIQUE_NAME(profiler_scope_info) = ::sbx::core::detail::database::instance().create_node((label), __FILE__, FUNC_NAME, __LINE__); \
-  const auto SBX_UNIQUE_NAME(profiler_scope_guard) = ::sbx::core::detail::scope_guard{SBX_UNIQUE_NAME(profiler_scope_info)}
+  static thread_local const auto SBX_UNIQUE_NAME(profiler_scope_node) = ::sbx::core::detail::database::instance().create_node((label), __FILE__, FUNC_NAME, __LINE__); \
+  const auto SBX_UNIQUE_NAME(profiler_scope_guard) = ::sbx::core::detail::scope_guard{SBX_UNIQUE_NAME(profiler_scope_node)}
 
 #define SBX_PROFILE_BLOCK(label) \
-  static thread_local auto& SBX_UNIQUE_NAME(profiler_scope_info) = ::sbx::core::detail::database::instance().create_node((label), __FILE__, FUNC_NAME, __LINE__); \
-  if (const auto SBX_UNIQUE_NAME(profiler_scope_guard) = ::sbx::core::detail::scope_guard{SBX_UNIQUE_NAME(profiler_scope_info)}; true)
+  static thread_local const auto SBX_UNIQUE_NAME(profiler_scope_node) = ::sbx::core::detail::database::instance().create_node((label), __FILE__, FUNC_NAME, __LINE__); \
+  if (const auto SBX_UNIQUE_NAME(profiler_scope_guard) = ::sbx::core::detail::scope_guard{SBX_UNIQUE_NAME(profiler_scope_node)}; true)
 
 inline auto scope_infos() -> std::span<const scope_info> {
-  return std::span<const scope_info>{detail::database::instance().nodes.data(), detail::database::instance().next_node_id};
+  return std::span<const scope_info>{detail::database::instance().nodes};
 }
 
 } // namespace sbx::core
@@ -0,0 +1,99 @@
+#ifndef LIBSBX_CORE_STAGE_GRAPH_HPP_
+#define LIBSBX_CORE_STAGE_GRAPH_HPP_
+
+#include <cinttypes>
+#include <string>
+#include <span>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <unordered_set>
+
+#include <libsbx/containers/task_graph.hpp>
+
+namespace sbx::core {
+
+/**
+ * @brief The dependencies of a module and the resources its update reads or writes.
+ */
+struct module_access {
+  std::unordered_set<std::uint32_t> dependencies{};
+  std::unordered_set<std::uint32_t> reads{};
+  std::unordered_set<std::uint32_t> writes{};
+  // Modules that declare neither reads nor writes may touch anything
+  bool is_exclusive{true};
+}; // struct module_access
+
+/**
+ * @brief Checks if two modules of the same stage have to run one after the other.
+ *
+ * Modules that declare neither reads nor writes are exclusive and are ordered against every other module of their stage.
+ */
+inline auto must_serialize(const std::uint32_t lhs_type, const module_access& lhs, const std::uint32_t rhs_type, const module_access& rhs) -> bool {
+  if (lhs.is_exclusive || rhs.is_exclusive) {
+    return true;
+  }
+
+  if (lhs.dependencies.contains(rhs_type) || rhs.dependencies.contains(lhs_type)) {
+    return true;
+  }
+
+  const auto intersects = [](const auto& first, const auto& second) {
+    return std::ranges::any_of(first, [&](const auto id) { return second.contains(id); });
+  };
+
+  return intersects(lhs.writes, rhs.writes) || intersects(lhs.writes, rhs.reads) || intersects(rhs.writes, lhs.reads);
+}
+
+/**
+ * @brief A module update that is scheduled as part of a stage.
+ */
+struct stage_node {
+  std::uint32_t type;
+  const module_access* access;
+  std::function<void()> update;
+}; // struct stage_node
+
+/**
+ * @brief Builds the task graph of a stage. Nodes are expected in creation order, conflicting pairs are ordered by their index which keeps the graph
+ * acyclic and the order identical to the serial one.
+ *
+ * @return The task graph, or nullptr if no two nodes may run concurrently. Such stages are better run inline on the calling thread.
+ */
+inline auto build_stage_graph(const std::string& name, std::span<const stage_node> nodes) -> std::unique_ptr<containers::task_graph> {
+  if (nodes.size() < 2u) {
+    return nullptr;
+  }
+
+  auto graph = std::make_unique<containers::task_graph>(name);
+  auto tasks = std::vector<containers::detail::task>{};
+
+  tasks.reserve(nodes.size());
+
+  for (const auto& node : nodes) {
+    tasks.push_back(graph->emplace(node.update));
+  }
+
+  auto has_concurrency = false;
+
+  for (auto j = 1u; j < nodes.size(); ++j) {
+    for (auto i = 0u; i < j; ++i) {
+      if (must_serialize(nodes[i].type, *nodes[i].access, nodes[j].type, *nodes[j].access)) {
+        tasks[i].precede(tasks[j]);
+      } else {
+        has_concurrency = true;
+      }
+    }
+  }
+
+  if (!has_concurrency) {
+    return nullptr;
+  }
+
+  return graph;
+}
+
+} // namespace sbx::core
+
+#endif // LIBSBX_CORE_STAGE_GRAPH_HPP_
@@ -0,0 +1,485 @@
+#ifndef LIBSBX_CORE_PROFILER_TESTS_HPP_
+#define LIBSBX_CORE_PROFILER_TESTS_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <latch>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <yaml-cpp/yaml.h>
+
+#include <libsbx/core/profiler.hpp>
+
+namespace profiler_tests {
+
+// The profiler is process wide, so every test starts from an empty history without pending events
+inline auto reset(const std::size_t history_size = sbx::core::profiler::default_history_size) -> sbx::core::profiler& {
+  auto& profiler = sbx::core::profiler::instance();
+
+  profiler.set_enabled(true);
+  profiler.end_frame();
+  profiler.set_history_size(history_size);
+
+  return profiler;
+}
+
+inline auto last_frame(const sbx::core::profiler& profiler) -> sbx::core::profiler::frame {
+  auto result = sbx::core::profiler::frame{};
+
+  profiler.for_each_frame([&](const sbx::core::profiler::frame& frame){
+    result = frame;
+  });
+
+  return result;
+}
+
+inline auto find_statistics(const std::vector<sbx::core::scope_statistics>& statistics, const std::uint32_t scope) -> const sbx::core::scope_statistics* {
+  const auto entry = std::ranges::find(statistics, scope, &sbx::core::scope_statistics::scope);
+
+  return entry != statistics.end() ? &*entry : nullptr;
+}
+
+inline auto nested_work() -> void {
+  SBX_PROFILE_SCOPE("outer");
+
+  std::this_thread::sleep_for(std::chrono::microseconds{50});
+
+  {
+    SBX_PROFILE_SCOPE("inner");
+
+    std::this_thread::sleep_for(std::chrono::microseconds{50});
+
+    {
+      SBX_PROFILE_SCOPE("leaf");
+
+      std::this_thread::sleep_for(std::chrono::microseconds{50});
+    }
+  }
+
+  {
+    SBX_PROFILE_SCOPE("inner");
+
+    std::this_thread::sleep_for(std::chrono::microseconds{50});
+  }
+}
+
+class capture_reader {
+
+public:
+
+  explicit capture_reader(const std::filesystem::path& path) {
+    auto stream = std::ifstream{path, std::ios::in | std::ios::binary};
+    _data.assign(std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{});
+  }
+
+  auto bytes(const std::size_t count) -> std::string {
+    auto result = _data.substr(_position, count);
+    _position += count;
+    return result;
+  }
+
+  auto varint() -> std::uint64_t {
+    auto value = std::uint64_t{0u};
+    auto shift = 0u;
+
+    while (true) {
+      const auto byte = static_cast<std::uint8_t>(_data.at(_position++));
+
+      value |= static_cast<std::uint64_t>(byte & 0x7Fu) << shift;
+
+      if ((byte & 0x80u) == 0u) {
+        return value;
+      }
+
+      shift += 7u;
+    }
+  }
+
+  auto string() -> std::string {
+    return bytes(varint());
+  }
+
+  [[nodiscard]] auto is_at_end() const -> bool {
+    return _position == _data.size();
+  }
+
+private:
+
+  std::string _data;
+  std::size_t _position{0u};
+
+}; // class capture_reader
+
+} // namespace profiler_tests
+
+TEST(libsbx_core_profiler, ring_drops_when_full) {
+  auto ring = sbx::core::detail::event_ring{3u, 8u};
+
+  for (auto i = 0u; i < 10u; ++i) {
+    ring.push(sbx::core::profiler_event{.scope = i, .thread = 3u, .depth = 0u, .begin = i, .end = i + 1u});
+  }
+
+  EXPECT_EQ(ring.dropped(), 2u);
+
+  auto drained = std::vector<std::uint32_t>{};
+
+  ring.drain([&](const sbx::core::profiler_event& event){
+    drained.push_back(event.scope);
+  });
+
+  // The oldest events are kept, the ones that did not fit are dropped
+  EXPECT_EQ(drained, (std::vector<std::uint32_t>{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u}));
+}
+
+TEST(libsbx_core_profiler, ring_wraps_around) {
+  auto ring = sbx::core::detail::event_ring{0u, 8u};
+
+  auto next = 0u;
+  auto expected = 0u;
+
+  for (auto round = 0u; round < 100u; ++round) {
+    for (auto i = 0u; i < 5u; ++i, ++next) {
+      ring.push(sbx::core::profiler_event{.scope = next, .thread = 0u, .depth = 0u, .begin = 0u, .end = 0u});
+    }
+
+    ring.drain([&](const sbx::core::profiler_event& event){
+      EXPECT_EQ(event.scope, expected);
+      ++expected;
+    });
+  }
+
+  EXPECT_EQ(expected, 500u);
+  EXPECT_EQ(ring.dropped(), 0u);
+}
+
+TEST(libsbx_core_profiler, threads_record_into_their_own_rings) {
+  static constexpr auto thread_count = 4u;
+  static constexpr auto event_count = 100u;
+
+  auto& profiler = profiler_tests::reset();
+
+  const auto scope = profiler.register_scope("thread_event", __FILE__, "threads_record_into_their_own_rings", __LINE__);
+
+  // All threads stay alive until every one has recorded, so none of them can reuse the ring of another
+  auto recorded = std::latch{thread_count};
+  auto threads = std::vector<std::thread>{};
+
+  for (auto t = 0u; t < thread_count; ++t) {
+    threads.emplace_back([&, t](){
+      for (auto i = 0u; i < event_count; ++i) {
+        profiler.record(scope, 0u, t * event_count + i, t * event_count + i + 1u);
+      }
+
+      recorded.arrive_and_wait();
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  profiler.end_frame();
+
+  auto events = std::map<std::uint16_t, std::vector<std::uint64_t>>{};
+
+  for (const auto& event : profiler_tests::last_frame(profiler).events) {
+    if (event.scope == scope) {
+      events[event.thread].push_back(event.begin);
+    }
+  }
+
+  ASSERT_EQ(events.size(), thread_count);
+
+  for (const auto& [thread, begins] : events) {
+    ASSERT_EQ(begins.size(), event_count);
+
+    // Every ring holds the events of exactly one thread in recording order
+    const auto first = begins.front();
+
+    EXPECT_EQ(first % event_count, 0u);
+
+    for (auto i = 0u; i < event_count; ++i) {
+      EXPECT_EQ(begins[i], first + i);
+    }
+  }
+}
+
+TEST(libsbx_core_profiler, history_keeps_last_frames) {
+  auto& profiler = profiler_tests::reset(3u);
+
+  const auto scope = profiler.register_scope("history_event", __FILE__, "history_keeps_last_frames", __LINE__);
+
+  for (auto i = 0u; i < 5u; ++i) {
+    profiler.record(scope, 0u, i, i + 1u);
+    profiler.end_frame();
+  }
+
+  EXPECT_EQ(profiler.frame_count(), 3u);
+
+  auto indices = std::vector<std::uint64_t>{};
+  auto begins = std::vector<std::uint64_t>{};
+
+  profiler.for_each_frame([&](const sbx::core::profiler::frame& frame){
+    indices.push_back(frame.index);
+
+    for (const auto& event : frame.events) {
+      begins.push_back(event.begin);
+    }
+  });
+
+  ASSERT_EQ(indices.size(), 3u);
+
+  // Frames are visited from oldest to newest
+  EXPECT_EQ(indices[1u], indices[0u] + 1u);
+  EXPECT_EQ(indices[2u], indices[1u] + 1u);
+  EXPECT_EQ(begins, (std::vector<std::uint64_t>{2u, 3u, 4u}));
+}
+
+TEST(libsbx_core_profiler, scope_statistics) {
+  auto& profiler = profiler_tests::reset(200u);
+
+  const auto single = profiler.register_scope("single", __FILE__, "scope_statistics", __LINE__);
+  const auto twice = profiler.register_scope("twice", __FILE__, "scope_statistics", __LINE__);
+  const auto absent = profiler.register_scope("absent", __FILE__, "scope_statistics", __LINE__);
+
+  // Frame i spends i nanoseconds in the first scope and 3 * i nanoseconds in two calls of the second scope
+  for (auto i = 1u; i <= 100u; ++i) {
+    profiler.record(single, 0u, 1000u, 1000u + i);
+    profiler.record(twice, 0u, 2000u, 2000u + i);
+    profiler.record(twice, 0u, 3000u, 3000u + 2u * i);
+    profiler.end_frame();
+  }
+
+  const auto statistics = profiler.statistics();
+
+  const auto* single_statistics = profiler_tests::find_statistics(statistics, single);
+  const auto* twice_statistics = profiler_tests::find_statistics(statistics, twice);
+
+  ASSERT_NE(single_statistics, nullptr);
+  ASSERT_NE(twice_statistics, nullptr);
+  EXPECT_EQ(profiler_tests::find_statistics(statistics, absent), nullptr);
+
+  EXPECT_EQ(single_statistics->frames, 100u);
+  EXPECT_EQ(single_statistics->calls, 100u);
+  EXPECT_EQ(single_statistics->time.min.count(), 1);
+  EXPECT_EQ(single_statistics->time.max.count(), 100);
+  EXPECT_EQ(single_statistics->time.average.count(), 50);
+  EXPECT_EQ(single_statistics->time.p50.count(), 50);
+  EXPECT_EQ(single_statistics->time.p95.count(), 95);
+  EXPECT_EQ(single_statistics->time.p99.count(), 99);
+
+  EXPECT_EQ(twice_statistics->frames, 100u);
+  EXPECT_EQ(twice_statistics->calls, 200u);
+  EXPECT_EQ(twice_statistics->time.min.count(), 3);
+  EXPECT_EQ(twice_statistics->time.max.count(), 300);
+  EXPECT_EQ(twice_statistics->time.p50.count(), 150);
+  EXPECT_EQ(twice_statistics->time.p99.count(), 297);
+
+  const auto frames = profiler.frame_statistics();
+
+  EXPECT_LE(frames.min, frames.p50);
+  EXPECT_LE(frames.p50, frames.p95);
+  EXPECT_LE(frames.p95, frames.p99);
+  EXPECT_LE(frames.p99, frames.max);
+  EXPECT_LE(frames.min, frames.average);
+  EXPECT_LE(frames.average, frames.max);
+}
+
+TEST(libsbx_core_profiler, statistics_of_single_sample) {
+  auto& profiler = profiler_tests::reset();
+
+  const auto scope = profiler.register_scope("single_sample", __FILE__, "statistics_of_single_sample", __LINE__);
+
+  profiler.record(scope, 0u, 10u, 52u);
+  profiler.end_frame();
+
+  const auto statistics = profiler.statistics();
+  const auto* entry = profiler_tests::find_statistics(statistics, scope);
+
+  ASSERT_NE(entry, nullptr);
+
+  EXPECT_EQ(entry->time.min.count(), 42);
+  EXPECT_EQ(entry->time.p50.count(), 42);
+  EXPECT_EQ(entry->time.p99.count(), 42);
+  EXPECT_EQ(entry->time.max.count(), 42);
+}
+
+TEST(libsbx_core_profiler, chrome_trace_is_valid_and_nested) {
+  static constexpr auto frame_count = 2u;
+
+  auto& profiler = profiler_tests::reset();
+
+  for (auto i = 0u; i < frame_count; ++i) {
+    auto worker = std::thread{[](){
+      sbx::core::profiler::instance().set_thread_name("worker \"quoted\"");
+      profiler_tests::nested_work();
+    }};
+
+    profiler_tests::nested_work();
+
+    worker.join();
+
+    profiler.end_frame();
+  }
+
+  const auto path = std::filesystem::temp_directory_path() / "libsbx_core_profiler_trace.json";
+
+  profiler.write_chrome_trace(path);
+
+  const auto trace = YAML::LoadFile(path.string());
+
+  std::filesystem::remove(path);
+
+  const auto events = trace["traceEvents"];
+
+  ASSERT_TRUE(events.IsSequence());
+
+  struct interval {
+    double begin;
+    double end;
+    std::string name;
+  }; // struct interval
+
+  auto scopes = std::map<std::uint32_t, std::vector<interval>>{};
+  auto frames = 0u;
+  auto has_worker_name = false;
+
+  for (const auto& event : events) {
+    const auto phase = event["ph"].as<std::string>();
+
+    if (phase == "M") {
+      has_worker_name |= event["args"]["name"].as<std::string>() == "worker \"quoted\"";
+      continue;
+    }
+
+    ASSERT_EQ(phase, "X");
+
+    if (event["cat"].as<std::string>() == "frame") {
+      ++frames;
+      continue;
+    }
+
+    const auto begin = event["ts"].as<double>();
+
+    scopes[event["tid"].as<std::uint32_t>()].push_back(interval{begin, begin + event["dur"].as<double>(), event["name"].as<std::string>()});
+  }
+
+  EXPECT_EQ(frames, frame_count);
+  EXPECT_TRUE(has_worker_name);
+  EXPECT_EQ(scopes.size(), 2u);
+
+  const auto expected_depth = std::map<std::string, std::size_t>{{"outer", 0u}, {"inner", 1u}, {"leaf", 2u}};
+
+  for (auto& [thread, intervals] : scopes) {
+    EXPECT_EQ(intervals.size(), 4u * frame_count);
+
+    // Events of a thread form a tree: an event either ends before the next one starts or contains it completely
+    std::ranges::sort(intervals, [](const interval& lhs, const interval& rhs){
+      return lhs.begin != rhs.begin ? lhs.begin < rhs.begin : lhs.end > rhs.end;
+    });
+
+    auto stack = std::vector<const interval*>{};
+
+    for (const auto& current : intervals) {
+      while (!stack.empty() && stack.back()->end <= current.begin) {
+        stack.pop_back();
+      }
+
+      if (!stack.empty()) {
+        EXPECT_LE(current.end, stack.back()->end) << current.name << " overlaps " << stack.back()->name;
+      }
+
+      EXPECT_EQ(stack.size(), expected_depth.at(current.name)) << current.name;
+
+      stack.push_back(&current);
+    }
+  }
+}
+
+TEST(libsbx_core_profiler, binary_capture_round_trip) {
+  auto& profiler = profiler_tests::reset();
+
+  const auto scope = profiler.register_scope("capture_event", __FILE__, "binary_capture_round_trip", __LINE__);
+
+  for (auto i = 0u; i < 3u; ++i) {
+    const auto begin = profiler.now();
+
+    for (auto j = 0u; j <= i; ++j) {
+      profiler.record(scope, static_cast<std::uint16_t>(j), begin + j, begin + j + 1000u * (j + 1u));
+    }
+
+    profiler.end_frame();
+  }
+
+  const auto path = std::filesystem::temp_directory_path() / "libsbx_core_profiler_capture.sbxp";
+
+  profiler.write_capture(path);
+
+  auto reader = profiler_tests::capture_reader{path};
+
+  std::filesystem::remove(path);
+
+  EXPECT_EQ(reader.bytes(4u), "SBXP");
+  EXPECT_EQ(reader.varint(), 1u);
+
+  const auto scope_count = reader.varint();
+
+  ASSERT_GT(scope_count, scope);
+
+  auto labels = std::vector<std::string>{};
+
+  for (auto i = 0u; i < scope_count; ++i) {
+    labels.push_back(reader.string());
+    reader.string();
+    reader.string();
+    reader.varint();
+  }
+
+  EXPECT_EQ(labels[scope], "capture_event");
+
+  const auto thread_count = reader.varint();
+
+  for (auto i = 0u; i < thread_count; ++i) {
+    reader.string();
+  }
+
+  auto expected = std::vector<sbx::core::profiler::frame>{};
+
+  profiler.for_each_frame([&](const sbx::core::profiler::frame& frame){
+    expected.push_back(frame);
+  });
+
+  ASSERT_EQ(reader.varint(), expected.size());
+
+  for (const auto& frame : expected) {
+    EXPECT_EQ(reader.varint(), frame.index);
+    EXPECT_EQ(reader.varint(), frame.begin);
+    EXPECT_EQ(reader.varint(), frame.end - frame.begin);
+    ASSERT_EQ(reader.varint(), frame.events.size());
+
+    for (const auto& event : frame.events) {
+      EXPECT_EQ(reader.varint(), event.scope);
+      EXPECT_EQ(reader.varint(), event.thread);
+      EXPECT_EQ(reader.varint(), event.depth);
+
+      // Event begins are stored zigzag encoded relative to the frame begin
+      const auto offset = reader.varint();
+      const auto delta = static_cast<std::int64_t>(offset >> 1u) ^ -static_cast<std::int64_t>(offset & 1u);
+
+      EXPECT_EQ(static_cast<std::int64_t>(frame.begin) + delta, static_cast<std::int64_t>(event.begin));
+      EXPECT_EQ(reader.varint(), event.end - event.begin);
+    }
+  }
+
+  EXPECT_TRUE(reader.is_at_end());
+}
+
+#endif // LIBSBX_CORE_PROFILER_TESTS_HPP_
@@ -0,0 +1,241 @@
+#ifndef LIBSBX_CORE_STAGE_GRAPH_TESTS_HPP_
+#define LIBSBX_CORE_STAGE_GRAPH_TESTS_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/containers/executor.hpp>
+
+#include <libsbx/core/module.hpp>
+#include <libsbx/core/stage_graph.hpp>
+
+namespace stage_graph_tests {
+
+struct position { };
+struct velocity { };
+struct health { };
+
+template<typename... Types>
+auto reading() -> sbx::core::module_access {
+  auto access = sbx::core::module_access{};
+  (access.reads.insert(sbx::core::access_id<Types>::value()), ...);
+  access.is_exclusive = false;
+  return access;
+}
+
+template<typename... Types>
+auto writing() -> sbx::core::module_access {
+  auto access = sbx::core::module_access{};
+  (access.writes.insert(sbx::core::access_id<Types>::value()), ...);
+  access.is_exclusive = false;
+  return access;
+}
+
+// Waits until count tasks have arrived, returns false if they did not arrive in time
+inline auto rendezvous(std::atomic<std::uint32_t>& arrived, const std::uint32_t count) -> bool {
+  arrived.fetch_add(1u);
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+
+  while (arrived.load() < count) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+
+    std::this_thread::yield();
+  }
+
+  return true;
+}
+
+} // namespace stage_graph_tests
+
+TEST(libsbx_core_stage_graph, must_serialize) {
+  using namespace stage_graph_tests;
+
+  const auto exclusive = sbx::core::module_access{};
+
+  EXPECT_TRUE(sbx::core::must_serialize(0u, exclusive, 1u, writing<position>()));
+  EXPECT_TRUE(sbx::core::must_serialize(0u, reading<>(), 1u, exclusive));
+
+  EXPECT_FALSE(sbx::core::must_serialize(0u, writing<position>(), 1u, writing<velocity>()));
+  EXPECT_FALSE(sbx::core::must_serialize(0u, reading<position>(), 1u, reading<position>()));
+
+  EXPECT_TRUE(sbx::core::must_serialize(0u, writing<position>(), 1u, writing<position, velocity>()));
+  EXPECT_TRUE(sbx::core::must_serialize(0u, writing<position>(), 1u, reading<position>()));
+  EXPECT_TRUE(sbx::core::must_serialize(0u, reading<health>(), 1u, writing<health>()));
+
+  auto dependent = reading<>();
+  dependent.dependencies.insert(0u);
+
+  EXPECT_TRUE(sbx::core::must_serialize(0u, reading<>(), 1u, dependent));
+  EXPECT_TRUE(sbx::core::must_serialize(1u, dependent, 0u, reading<>()));
+}
+
+TEST(libsbx_core_stage_graph, serialized_stage_has_no_graph) {
+  using namespace stage_graph_tests;
+
+  const auto exclusive = sbx::core::module_access{};
+  const auto writer = writing<position>();
+
+  const auto single = std::vector<sbx::core::stage_node>{
+    {0u, &writer, [](){ }}
+  };
+
+  const auto all_exclusive = std::vector<sbx::core::stage_node>{
+    {0u, &exclusive, [](){ }},
+    {1u, &exclusive, [](){ }},
+    {2u, &exclusive, [](){ }}
+  };
+
+  const auto conflicting = std::vector<sbx::core::stage_node>{
+    {0u, &writer, [](){ }},
+    {1u, &writer, [](){ }}
+  };
+
+  EXPECT_EQ(sbx::core::build_stage_graph("single", single), nullptr);
+  EXPECT_EQ(sbx::core::build_stage_graph("all_exclusive", all_exclusive), nullptr);
+  EXPECT_EQ(sbx::core::build_stage_graph("conflicting", conflicting), nullptr);
+}
+
+TEST(libsbx_core_stage_graph, disjoint_writers_run_concurrently) {
+  using namespace stage_graph_tests;
+
+  auto executor = sbx::containers::executor{2u};
+
+  const auto position_writer = writing<position>();
+  const auto velocity_writer = writing<velocity>();
+
+  auto arrived = std::atomic<std::uint32_t>{0u};
+  auto met = std::atomic<std::uint32_t>{0u};
+
+  // Both updates only return once the other one started, which can only happen if they run at the same time
+  const auto nodes = std::vector<sbx::core::stage_node>{
+    {0u, &position_writer, [&](){ met.fetch_add(rendezvous(arrived, 2u) ? 1u : 0u); }},
+    {1u, &velocity_writer, [&](){ met.fetch_add(rendezvous(arrived, 2u) ? 1u : 0u); }}
+  };
+
+  auto graph = sbx::core::build_stage_graph("disjoint", nodes);
+
+  ASSERT_NE(graph, nullptr);
+
+  executor.run_and_wait(*graph);
+
+  EXPECT_EQ(met.load(), 2u);
+}
+
+TEST(libsbx_core_stage_graph, conflicting_writers_are_ordered) {
+  using namespace stage_graph_tests;
+
+  auto executor = sbx::containers::executor{4u};
+
+  const auto position_writer = writing<position>();
+  const auto position_reader = reading<position>();
+  const auto velocity_writer = writing<velocity>();
+
+  auto mutex = std::mutex{};
+  auto order = std::vector<std::uint32_t>{};
+
+  const auto record = [&](const std::uint32_t type) {
+    return [&, type](){
+      auto lock = std::scoped_lock{mutex};
+      order.push_back(type);
+    };
+  };
+
+  const auto nodes = std::vector<sbx::core::stage_node>{
+    {0u, &position_writer, record(0u)},
+    {1u, &velocity_writer, record(1u)},
+    {2u, &position_writer, record(2u)},
+    {3u, &position_reader, record(3u)}
+  };
+
+  auto graph = sbx::core::build_stage_graph("conflicting", nodes);
+
+  ASSERT_NE(graph, nullptr);
+
+  for (auto run = 0u; run < 100u; ++run) {
+    order.clear();
+
+    executor.run_and_wait(*graph);
+
+    ASSERT_EQ(order.size(), 4u);
+
+    const auto index_of = [&](const std::uint32_t type) {
+      return std::ranges::find(order, type) - order.begin();
+    };
+
+    // Modules that access position keep their creation order
+    EXPECT_LT(index_of(0u), index_of(2u));
+    EXPECT_LT(index_of(2u), index_of(3u));
+  }
+}
+
+TEST(libsbx_core_stage_graph, exclusive_module_serializes) {
+  using namespace stage_graph_tests;
+
+  auto executor = sbx::containers::executor{4u};
+
+  const auto exclusive = sbx::core::module_access{};
+  const auto position_writer = writing<position>();
+  const auto velocity_writer = writing<velocity>();
+  const auto health_writer = writing<health>();
+
+  auto running = std::atomic<std::uint32_t>{0u};
+  auto overlaps = std::atomic<std::uint32_t>{0u};
+
+  auto mutex = std::mutex{};
+  auto order = std::vector<std::uint32_t>{};
+
+  const auto record = [&](const std::uint32_t type) {
+    return [&, type](){
+      running.fetch_add(1u);
+
+      {
+        auto lock = std::scoped_lock{mutex};
+        order.push_back(type);
+      }
+
+      std::this_thread::sleep_for(std::chrono::microseconds{100});
+
+      running.fetch_sub(1u);
+    };
+  };
+
+  const auto nodes = std::vector<sbx::core::stage_node>{
+    {0u, &position_writer, record(0u)},
+    {1u, &velocity_writer, record(1u)},
+    {2u, &exclusive, [&](){
+      overlaps.fetch_add(running.load() != 0u ? 1u : 0u);
+
+      auto lock = std::scoped_lock{mutex};
+      order.push_back(2u);
+    }},
+    {3u, &health_writer, record(3u)}
+  };
+
+  auto graph = sbx::core::build_stage_graph("exclusive", nodes);
+
+  ASSERT_NE(graph, nullptr);
+
+  for (auto run = 0u; run < 50u; ++run) {
+    order.clear();
+
+    executor.run_and_wait(*graph);
+
+    ASSERT_EQ(order.size(), 4u);
+
+    // Everything created before the exclusive module runs before it, everything created after it runs after it
+    EXPECT_EQ(order[2u], 2u);
+    EXPECT_EQ(order[3u], 3u);
+  }
+
+  EXPECT_EQ(overlaps.load(), 0u);
+}
+
+#endif // LIBSBX_CORE_STAGE_GRAPH_TESTS_HPP_
@@ -0,0 +1,10 @@
+#include <gtest/gtest.h>
+
+#include <tests/profiler_tests.hpp>
+#include <tests/stage_graph_tests.hpp>
+
+auto main(int argc, char* argv[]) -> int {
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -25,6 +25,7 @@ namespace sbx::devices {
 
 class devices_module final : public core::module<devices_module> {
 
+  // Stays exclusive, events must be polled on the main thread
   inline static const auto is_registered = register_module(stage::pre);
 
 public:
@@ -0,0 +1,125 @@
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <functional>
+
+#include <fmt/format.h>
+
+#include <libsbx/containers/executor.hpp>
+
+#include <libsbx/ecs/registry.hpp>
+#include <libsbx/ecs/parallel.hpp>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Callable>
+auto measure(const std::uint32_t iterations, Callable&& callable) -> double {
+  auto samples = std::vector<double>{};
+  samples.reserve(iterations);
+
+  for (auto i = 0u; i < iterations; ++i) {
+    const auto start = clock_type::now();
+    std::invoke(callable);
+    samples.push_back(std::chrono::duration<double, std::milli>(clock_type::now() - start).count());
+  }
+
+  std::ranges::sort(samples);
+
+  return samples[samples.size() / 2u];
+}
+
+auto report(const std::string_view name, const double serial, const double parallel) -> void {
+  fmt::print("{:<40} serial: {:>9.3f} ms  parallel: {:>9.3f} ms  speedup: {:>5.2f}x\n", name, serial, parallel, serial / parallel);
+}
+
+struct position {
+  float x;
+  float y;
+  float z;
+}; // struct position
+
+struct velocity {
+  float x;
+  float y;
+  float z;
+}; // struct velocity
+
+struct frozen_tag { };
+
+auto populate(sbx::ecs::registry& registry, const std::uint32_t count) -> void {
+  for (auto i = 0u; i < count; ++i) {
+    const auto entity = registry.create();
+
+    registry.emplace<position>(entity, 0.0f, 0.0f, 0.0f);
+
+    if (i % 4u != 3u) {
+      registry.emplace<velocity>(entity, 1.0f, static_cast<float>(i % 7u), 0.5f);
+    }
+
+    if (i % 16u == 0u) {
+      registry.emplace<frozen_tag>(entity);
+    }
+  }
+}
+
+// Cheap per entity work, bound by memory bandwidth
+auto integrate(position& value, const velocity& delta) -> void {
+  value.x += delta.x * 0.016f;
+  value.y += delta.y * 0.016f;
+  value.z += delta.z * 0.016f;
+}
+
+// Expensive per entity work, bound by compute
+auto simulate(position& value, const velocity& delta) -> void {
+  for (auto i = 0u; i < 32u; ++i) {
+    value.x = std::sqrt(value.x * value.x + delta.x);
+    value.y = std::sqrt(value.y * value.y + delta.y);
+    value.z = std::sqrt(value.z * value.z + delta.z);
+  }
+}
+
+template<typename View, typename Work>
+auto compare(const std::string_view name, sbx::containers::executor& executor, const View& view, Work work, const std::size_t pages) -> void {
+  auto parallel = sbx::ecs::task_executor{executor};
+
+  const auto serial_time = measure(10u, [&](){
+    for (auto&& [entity, value, delta] : view.each()) {
+      work(value, delta);
+    }
+  });
+
+  const auto parallel_time = measure(10u, [&](){
+    view.each_par(parallel, [&work](position& value, const velocity& delta) { work(value, delta); }, pages);
+  });
+
+  report(fmt::format("{} ({} pages/chunk)", name, pages), serial_time, parallel_time);
+}
+
+} // namespace
+
+auto main() -> int {
+  auto executor = sbx::containers::executor{std::thread::hardware_concurrency()};
+
+  fmt::print("workers: {}\n", executor.size());
+
+  auto registry = sbx::ecs::registry{};
+
+  populate(registry, 1'000'000u);
+
+  const auto view = registry.view<position, const velocity>(sbx::ecs::exclude<frozen_tag>);
+
+  for (const auto pages : {1u, 8u, 32u}) {
+    compare("integrate 1M", executor, view, integrate, pages);
+  }
+
+  for (const auto pages : {1u, 8u}) {
+    compare("simulate 1M", executor, view, simulate, pages);
+  }
+
+  return 0;
+}
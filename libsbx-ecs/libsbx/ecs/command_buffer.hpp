@@ -0,0 +1,377 @@
+#ifndef LIBSBX_ECS_COMMAND_BUFFER_HPP_
+#define LIBSBX_ECS_COMMAND_BUFFER_HPP_
+
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <optional>
+#include <algorithm>
+#include <functional>
+#include <ranges>
+#include <type_traits>
+#include <unordered_map>
+
+#include <libsbx/utility/assert.hpp>
+#include <libsbx/utility/target.hpp>
+
+#include <libsbx/containers/dense_map.hpp>
+
+#include <libsbx/ecs/entity.hpp>
+#include <libsbx/ecs/registry.hpp>
+
+namespace sbx::ecs {
+
+/**
+ * @brief Orders the commands of a command buffer during playback. Commands are played back by ascending key.
+ *
+ * Keys only need to be unique between threads, e.g. the entity, chunk or job index of the work that records the command.
+ */
+enum class sort_key : std::uint64_t { };
+
+/**
+ * @brief Records structural changes to a registry and applies them later at a sync point.
+ *
+ * Commands can be recorded from any number of threads at the same time, every thread writes to its own stream without taking a lock.
+ * Created entities are provisional until playback, they can be used as targets of other commands of the same buffer but not with the registry.
+ *
+ * Playback applies the commands in this order:
+ * - Creates, by ascending sort key. Provisional entities are mapped to the created entities.
+ * - Emplaces and removes, batched per storage. The commands of a storage are applied by ascending sort key. Emplacing a component that already exists replaces it.
+ * - Destroys, by ascending sort key.
+ *
+ * Every command takes an explicit sort key. Commands with the same sort key keep the order in which they were recorded, which is only defined within a thread.
+ * A sort key must therefore not be used by more than one thread, which makes playback independent of how the work was distributed over the threads.
+ * Debug builds assert that no two threads recorded commands with the same key.
+ * Commands that target an entity that is no longer valid at playback are dropped.
+ *
+ * @tparam Registry The registry type the commands are played back on.
+ */
+template<typename Registry>
+class basic_command_buffer {
+
+  using entity_traits = ecs::entity_traits<typename Registry::entity_type>;
+
+  struct batch_base {
+    virtual ~batch_base() = default;
+    virtual auto id() const -> std::uint32_t = 0;
+    virtual auto clear() -> void = 0;
+    virtual auto playback(Registry& registry, const std::vector<batch_base*>& batches, const basic_command_buffer& buffer) -> void = 0;
+  }; // struct batch_base
+
+  template<typename Type>
+  struct batch final : batch_base {
+
+    struct entry {
+      sort_key key;
+      typename Registry::entity_type entity;
+      std::optional<Type> value;
+    }; // struct entry
+
+    // Only the address is used, it identifies the batch type without touching the type ids of the registry from worker threads
+    inline static constexpr auto tag = char{};
+
+    auto id() const -> std::uint32_t override {
+      return type_id<Type>::value();
+    }
+
+    auto clear() -> void override {
+      entries.clear();
+    }
+
+    auto playback(Registry& registry, const std::vector<batch_base*>& batches, const basic_command_buffer& buffer) -> void override {
+      auto merged = std::vector<std::pair<entry*, std::size_t>>{};
+      auto emplaces = std::size_t{0u};
+
+      for (auto* base : batches) {
+        auto* current = static_cast<batch*>(base);
+
+        for (auto& element : current->entries) {
+          merged.emplace_back(&element, current->stream);
+          emplaces += static_cast<std::size_t>(element.value.has_value());
+        }
+      }
+
+      std::ranges::stable_sort(merged, std::less{}, [](const auto& element) { return element.first->key; });
+
+      _check_keys(merged, [](const auto& element) { return element.first->key; }, [](const auto& element) { return element.second; });
+
+      auto& pool = registry.template storage<Type>();
+
+      pool.reserve(pool.size() + emplaces);
+
+      for (auto* element : merged | std::views::keys) {
+        const auto entity = buffer._resolve(element->entity);
+
+        if (!registry.is_valid(entity)) {
+          continue;
+        }
+
+        if (!element->value) {
+          registry.template remove<Type>(entity);
+        } else if (!registry.template all_of<Type>(entity)) {
+          registry.template emplace<Type>(entity, std::move(*element->value));
+        } else if constexpr (!std::is_empty_v<Type>) {
+          registry.template replace<Type>(entity, std::move(*element->value));
+        }
+      }
+    }
+
+    std::size_t stream{};
+    std::vector<entry> entries;
+
+  }; // struct batch
+
+  struct entity_entry {
+    sort_key key;
+    typename Registry::entity_type entity;
+    std::size_t stream;
+  }; // struct entity_entry
+
+  struct stream {
+    std::size_t index;
+    std::vector<entity_entry> creates;
+    std::vector<entity_entry> destroys;
+    containers::dense_map<const void*, std::unique_ptr<batch_base>> batches;
+  }; // struct stream
+
+  struct stream_cache {
+    std::uint64_t owner;
+    stream* value;
+  }; // struct stream_cache
+
+public:
+
+  using registry_type = Registry;
+  using entity_type = typename registry_type::entity_type;
+  using size_type = std::size_t;
+
+  basic_command_buffer()
+  : _id{_next_id.fetch_add(1u, std::memory_order_relaxed)},
+    _provisional{0u} { }
+
+  basic_command_buffer(const basic_command_buffer& other) = delete;
+
+  basic_command_buffer(basic_command_buffer&& other) = delete;
+
+  ~basic_command_buffer() = default;
+
+  auto operator=(const basic_command_buffer& other) -> basic_command_buffer& = delete;
+
+  auto operator=(basic_command_buffer&& other) -> basic_command_buffer& = delete;
+
+  /**
+   * @brief Returns true if the entity is a provisional entity of a command buffer.
+   */
+  [[nodiscard]] static constexpr auto is_provisional(const entity_type entity) noexcept -> bool {
+    return entity != null_entity && entity_traits::to_version(entity) == entity_traits::version_mask;
+  }
+
+  /**
+   * @brief Records the creation of an entity.
+   *
+   * @return A provisional entity that can be used with the other commands of this buffer until the next playback.
+   */
+  [[nodiscard]] auto create(const sort_key key) -> entity_type {
+    const auto index = _provisional.fetch_add(1u, std::memory_order_relaxed);
+
+    utility::assert_that(index < entity_traits::entity_mask, "No more provisional entities available");
+
+    const auto entity = entity_traits::construct(static_cast<typename entity_traits::entity_type>(index), static_cast<typename entity_traits::version_type>(entity_traits::version_mask));
+
+    auto& current = _stream();
+
+    current.creates.push_back(entity_entry{key, entity, current.index});
+
+    return entity;
+  }
+
+  auto destroy(const sort_key key, const entity_type entity) -> void {
+    auto& current = _stream();
+
+    current.destroys.push_back(entity_entry{key, entity, current.index});
+  }
+
+  /**
+   * @brief Records adding a component to the entity. The component is constructed right away and moved into the storage during playback.
+   */
+  template<typename Type, typename... Args>
+  requires (std::is_constructible_v<Type, Args...> && std::is_move_constructible_v<Type>)
+  auto emplace(const sort_key key, const entity_type entity, Args&&... args) -> void {
+    _batch<Type>().entries.push_back({key, entity, std::optional<Type>{std::in_place, std::forward<Args>(args)...}});
+  }
+
+  template<typename Type>
+  auto remove(const sort_key key, const entity_type entity) -> void {
+    _batch<Type>().entries.push_back({key, entity, std::nullopt});
+  }
+
+  /**
+   * @brief Applies all recorded commands to the registry and clears the buffer.
+   *
+   * Must not be called while commands are being recorded.
+   */
+  auto playback(registry_type& registry) -> void {
+    auto streams = std::vector<stream*>{};
+
+    {
+      auto lock = std::scoped_lock{_mutex};
+
+      streams.reserve(_streams.size());
+
+      for (auto& entry : _streams) {
+        streams.push_back(entry.get());
+      }
+    }
+
+    _mapping.assign(_provisional.load(std::memory_order_relaxed), entity_type{null_entity});
+
+    for (const auto& entry : _merge(streams, &stream::creates)) {
+      _mapping[entity_traits::to_entity(entry.entity)] = registry.create();
+    }
+
+    auto batches = std::vector<std::pair<std::uint32_t, std::vector<batch_base*>>>{};
+
+    for (auto* current : streams) {
+      for (auto&& entry : current->batches) {
+        auto* batch = entry.second.get();
+        const auto id = batch->id();
+        const auto group = std::ranges::find(batches, id, [](const auto& element) { return element.first; });
+
+        if (group == batches.end()) {
+          batches.emplace_back(id, std::vector<batch_base*>{batch});
+        } else {
+          group->second.push_back(batch);
+        }
+      }
+    }
+
+    std::ranges::sort(batches, std::less{}, [](const auto& element) { return element.first; });
+
+    for (auto& [id, group] : batches) {
+      group.front()->playback(registry, group, *this);
+    }
+
+    for (const auto& entry : _merge(streams, &stream::destroys)) {
+      if (const auto entity = _resolve(entry.entity); registry.is_valid(entity)) {
+        registry.destroy(entity);
+      }
+    }
+
+    clear();
+  }
+
+  /**
+   * @brief Drops all recorded commands. Must not be called while commands are being recorded.
+   */
+  auto clear() -> void {
+    auto lock = std::scoped_lock{_mutex};
+
+    for (auto& current : _streams) {
+      current->creates.clear();
+      current->destroys.clear();
+
+      for (auto&& entry : current->batches) {
+        entry.second->clear();
+      }
+    }
+
+    _provisional.store(0u, std::memory_order_relaxed);
+    _mapping.clear();
+  }
+
+private:
+
+  [[nodiscard]] auto _resolve(const entity_type entity) const -> entity_type {
+    if (!is_provisional(entity)) {
+      return entity;
+    }
+
+    const auto index = static_cast<std::size_t>(entity_traits::to_entity(entity));
+
+    return index < _mapping.size() ? _mapping[index] : entity_type{null_entity};
+  }
+
+  [[nodiscard]] static auto _merge(const std::vector<stream*>& streams, std::vector<entity_entry> stream::* member) -> std::vector<entity_entry> {
+    auto result = std::vector<entity_entry>{};
+
+    for (auto* current : streams) {
+      result.insert(result.end(), (current->*member).begin(), (current->*member).end());
+    }
+
+    std::ranges::stable_sort(result, std::less{}, &entity_entry::key);
+
+    _check_keys(result, &entity_entry::key, &entity_entry::stream);
+
+    return result;
+  }
+
+  template<typename Entries, typename Key, typename Stream>
+  static auto _check_keys(const Entries& entries, Key&& key, Stream&& stream) -> void {
+    if constexpr (utility::is_build_configuration_debug_v) {
+      for (auto i = 1u; i < entries.size(); ++i) {
+        const auto is_shared = std::invoke(key, entries[i - 1u]) == std::invoke(key, entries[i]) && std::invoke(stream, entries[i - 1u]) != std::invoke(stream, entries[i]);
+
+        utility::assert_that(!is_shared, "Commands recorded by different threads must not share a sort key");
+      }
+    }
+  }
+
+  template<typename Type>
+  [[nodiscard]] auto _batch() -> batch<Type>& {
+    auto& current = _stream();
+
+    if (auto entry = current.batches.find(&batch<Type>::tag); entry != current.batches.end()) {
+      return static_cast<batch<Type>&>(*entry->second);
+    }
+
+    auto instance = std::make_unique<batch<Type>>();
+    instance->stream = current.index;
+
+    auto entry = current.batches.emplace(&batch<Type>::tag, std::move(instance)).first;
+
+    return static_cast<batch<Type>&>(*entry->second);
+  }
+
+  [[nodiscard]] auto _stream() -> stream& {
+    thread_local auto cache = stream_cache{0u, nullptr};
+
+    if (cache.owner == _id) {
+      return *cache.value;
+    }
+
+    auto lock = std::scoped_lock{_mutex};
+
+    auto& index = _thread_streams[std::this_thread::get_id()];
+
+    if (index == 0u) {
+      _streams.push_back(std::make_unique<stream>());
+      _streams.back()->index = _streams.size() - 1u;
+      index = _streams.size();
+    }
+
+    cache = stream_cache{_id, _streams[index - 1u].get()};
+
+    return *cache.value;
+  }
+
+  inline static auto _next_id = std::atomic<std::uint64_t>{1u};
+
+  std::uint64_t _id;
+  std::atomic<std::uint64_t> _provisional;
+
+  std::mutex _mutex;
+  std::vector<std::unique_ptr<stream>> _streams;
+  std::unordered_map<std::thread::id, std::size_t> _thread_streams;
+
+  std::vector<entity_type> _mapping;
+
+}; // class basic_command_buffer
+
+using command_buffer = basic_command_buffer<registry>;
+
+} // namespace sbx::ecs
+
+#endif // LIBSBX_ECS_COMMAND_BUFFER_HPP_
@@ -0,0 +1,114 @@
+#ifndef LIBSBX_ECS_DETAIL_GROUP_ITERATOR_HPP_
+#define LIBSBX_ECS_DETAIL_GROUP_ITERATOR_HPP_
+
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+#include <libsbx/memory/iterable_adaptor.hpp>
+
+namespace sbx::ecs::detail {
+
+/**
+ * @brief Stand-in for the element iterator of storages of empty types.
+ */
+struct empty_storage_iterator {
+
+  constexpr auto operator++() noexcept -> empty_storage_iterator& {
+    return *this;
+  }
+
+}; // struct empty_storage_iterator
+
+template<typename Storage>
+using owned_iterator_t = std::conditional_t<std::is_void_v<typename Storage::value_type>, empty_storage_iterator, decltype(std::declval<Storage&>().end())>;
+
+template<typename Iterator, typename Owned, typename Get>
+class extended_group_iterator;
+
+/**
+ * @brief Iterates the entities of a group together with their components.
+ *
+ * Owned components are read by advancing the element iterators of the owned storages in lockstep with the entity iterator, only the components of get storages are looked up.
+ */
+template<typename Iterator, template<typename...> typename OwnedList, typename... Owned, template<typename...> typename GetList, typename... Get>
+class extended_group_iterator<Iterator, OwnedList<Owned...>, GetList<Get...>> final {
+
+  template<typename... Lhs, typename... Rhs>
+  friend constexpr auto operator==(const extended_group_iterator<Lhs...>&, const extended_group_iterator<Rhs...>&) noexcept -> bool;
+
+public:
+
+  using iterator_type = Iterator;
+  using value_type = decltype(std::tuple_cat(std::make_tuple(*std::declval<Iterator>()), std::declval<Owned>().get_as_tuple(std::declval<typename Owned::entity_type>())..., std::declval<Get>().get_as_tuple(std::declval<typename Get::entity_type>())...));
+  using pointer = memory::input_iterator_pointer<value_type>;
+  using reference = value_type;
+  using difference_type = std::ptrdiff_t;
+  using iterator_category = std::input_iterator_tag;
+  using iterator_concept = std::forward_iterator_tag;
+
+  constexpr extended_group_iterator()
+  : _iterator{},
+    _owned{},
+    _pools{} { }
+
+  extended_group_iterator(iterator_type from, std::tuple<owned_iterator_t<Owned>...> owned, std::tuple<Get*...> pools)
+  : _iterator{from},
+    _owned{owned},
+    _pools{pools} { }
+
+  auto operator++() noexcept -> extended_group_iterator& {
+    ++_iterator;
+    std::apply([](auto&... element) { (++element, ...); }, _owned);
+    return *this;
+  }
+
+  auto operator++(int) noexcept -> extended_group_iterator {
+    const auto original = *this;
+    ++(*this);
+    return original;
+  }
+
+  [[nodiscard]] auto operator*() const noexcept -> reference {
+    return _dereference(std::index_sequence_for<Owned...>{}, std::index_sequence_for<Get...>{});
+  }
+
+  [[nodiscard]] auto operator->() const noexcept -> pointer {
+    return operator*();
+  }
+
+  [[nodiscard]] constexpr auto base() const noexcept -> iterator_type {
+    return _iterator;
+  }
+
+private:
+
+  template<typename Element>
+  [[nodiscard]] static auto _as_tuple(const Element& element) noexcept {
+    if constexpr (std::is_same_v<Element, empty_storage_iterator>) {
+      return std::tuple{};
+    } else {
+      return std::forward_as_tuple(*element);
+    }
+  }
+
+  template<std::size_t... OwnedIndex, std::size_t... GetIndex>
+  [[nodiscard]] auto _dereference(std::index_sequence<OwnedIndex...>, std::index_sequence<GetIndex...>) const noexcept -> reference {
+    const auto entity = *_iterator;
+    return std::tuple_cat(std::make_tuple(entity), _as_tuple(std::get<OwnedIndex>(_owned))..., std::get<GetIndex>(_pools)->get_as_tuple(entity)...);
+  }
+
+  Iterator _iterator;
+  std::tuple<owned_iterator_t<Owned>...> _owned;
+  std::tuple<Get*...> _pools;
+
+}; // class extended_group_iterator
+
+template<typename... Lhs, typename... Rhs>
+[[nodiscard]] constexpr auto operator==(const extended_group_iterator<Lhs...>& lhs, const extended_group_iterator<Rhs...>& rhs) noexcept -> bool {
+  return lhs._iterator == rhs._iterator;
+}
+
+} // namespace sbx::ecs::detail
+
+#endif // LIBSBX_ECS_DETAIL_GROUP_ITERATOR_HPP_
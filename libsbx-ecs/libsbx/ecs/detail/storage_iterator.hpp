@@ -152,6 +152,15 @@ public:
     return original;
   }
 
+  constexpr auto operator+=(const difference_type value) noexcept -> extended_storage_iterator& {
+    return std::get<iterator>(_values) += value, ((std::get<Other>(_values) += value), ...), *this;
+  }
+
+  constexpr auto operator+(const difference_type value) const noexcept -> extended_storage_iterator {
+    auto copy = *this;
+    return (copy += value);
+  }
+
   [[nodiscard]] constexpr auto operator->() const noexcept -> pointer {
     return operator*();
   }
@@ -5,6 +5,11 @@
 
 #include <libsbx/ecs/entity.hpp>
 #include <libsbx/ecs/registry.hpp>
+#include <libsbx/ecs/group.hpp>
+#include <libsbx/ecs/observer.hpp>
+#include <libsbx/ecs/parallel.hpp>
+#include <libsbx/ecs/command_buffer.hpp>
+#include <libsbx/ecs/snapshot.hpp>
 #include <libsbx/ecs/range.hpp>
 #include <libsbx/ecs/zip.hpp>
 
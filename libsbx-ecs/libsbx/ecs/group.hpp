@@ -0,0 +1,547 @@
+#ifndef LIBSBX_GROUP_HPP_
+#define LIBSBX_GROUP_HPP_
+
+#include <array>
+#include <tuple>
+#include <algorithm>
+#include <type_traits>
+
+#include <libsbx/utility/assert.hpp>
+#include <libsbx/utility/type_list.hpp>
+
+#include <libsbx/memory/iterable_adaptor.hpp>
+
+#include <libsbx/ecs/entity.hpp>
+#include <libsbx/ecs/sparse_set.hpp>
+#include <libsbx/ecs/view.hpp>
+
+#include <libsbx/ecs/detail/group_iterator.hpp>
+
+namespace sbx::ecs {
+
+template<typename... Type>
+struct owned_t final : utility::type_list<Type...> {
+  explicit constexpr owned_t() = default;
+}; // struct owned_t
+
+template<typename... Type>
+inline constexpr owned_t<Type...> owned{};
+
+namespace detail {
+
+/**
+ * @brief Type erased interface the registry uses to keep its groups up to date.
+ *
+ * on_construct is called after a component was added to a pool, on_destroy before a component is removed from a pool.
+ */
+template<typename Type>
+class group_handler_base {
+
+public:
+
+  using common_type = Type;
+  using entity_type = typename common_type::entity_type;
+  using size_type = std::size_t;
+
+  virtual ~group_handler_base() = default;
+
+  virtual auto on_construct(const common_type& pool, const entity_type entity) -> void = 0;
+
+  virtual auto on_destroy(const common_type& pool, const entity_type entity) -> void = 0;
+
+  virtual auto clear() -> void = 0;
+
+  [[nodiscard]] virtual auto owns([[maybe_unused]] const common_type& pool) const noexcept -> bool {
+    return false;
+  }
+
+protected:
+
+  template<std::size_t Size>
+  [[nodiscard]] static auto is_one_of(const common_type& pool, const std::array<common_type*, Size>& pools) noexcept -> bool {
+    return std::ranges::find(pools, &pool) != pools.end();
+  }
+
+  template<std::size_t Size>
+  [[nodiscard]] static auto is_one_of(const common_type& pool, const std::array<const common_type*, Size>& pools) noexcept -> bool {
+    return std::ranges::find(pools, &pool) != pools.end();
+  }
+
+  template<std::size_t Size>
+  [[nodiscard]] static auto count_of(const std::array<const common_type*, Size>& pools, const entity_type entity) noexcept -> size_type {
+    return static_cast<size_type>(std::ranges::count_if(pools, [entity](const auto* pool) { return pool->contains(entity); }));
+  }
+
+}; // class group_handler_base
+
+/**
+ * @brief Keeps the entities of an owning group packed at the front of all owned storages.
+ *
+ * The first length() entries of every owned storage belong to the same entities in the same order, so the components of a group can be iterated without any sparse lookups.
+ */
+template<typename Type, std::size_t Owned, std::size_t Get, std::size_t Exclude>
+class group_handler final : public group_handler_base<Type> {
+
+  using base_type = group_handler_base<Type>;
+
+public:
+
+  using common_type = typename base_type::common_type;
+  using entity_type = typename base_type::entity_type;
+  using size_type = typename base_type::size_type;
+
+  group_handler(std::array<common_type*, Owned> owned, std::array<common_type*, Get> get, std::array<const common_type*, Exclude> filter)
+  : _owned{owned},
+    _get{get},
+    _filter{filter},
+    _length{0u} {
+    for (const auto* pool : _owned) {
+      utility::assert_that(pool->policy() == deletion_policy::swap_and_pop, "Groups can only own storages that use swap and pop deletion");
+    }
+
+    const auto& leading = *_owned.front();
+
+    for (auto position = size_type{0u}; position < leading.size(); ++position) {
+      _push(leading.data()[position]);
+    }
+  }
+
+  ~group_handler() override = default;
+
+  [[nodiscard]] auto length() const noexcept -> size_type {
+    return _length;
+  }
+
+  [[nodiscard]] auto owned(const size_type index) const noexcept -> common_type* {
+    return _owned[index];
+  }
+
+  [[nodiscard]] auto get(const size_type index) const noexcept -> common_type* {
+    return _get[index];
+  }
+
+  auto on_construct(const common_type& pool, const entity_type entity) -> void override {
+    if (base_type::is_one_of(pool, _filter)) {
+      _pop(entity);
+    } else if (base_type::is_one_of(pool, _owned) || base_type::is_one_of(pool, _get)) {
+      _push(entity);
+    }
+  }
+
+  auto on_destroy(const common_type& pool, const entity_type entity) -> void override {
+    if (base_type::is_one_of(pool, _filter)) {
+      // The entity is still in the excluded pool, so it is a candidate if that pool is the only excluded one containing it
+      if (_has_required(entity) && base_type::count_of(_filter, entity) == 1u) {
+        _insert(entity);
+      }
+    } else if (base_type::is_one_of(pool, _owned) || base_type::is_one_of(pool, _get)) {
+      _pop(entity);
+    }
+  }
+
+  auto clear() -> void override {
+    _length = 0u;
+  }
+
+  [[nodiscard]] auto owns(const common_type& pool) const noexcept -> bool override {
+    return base_type::is_one_of(pool, _owned);
+  }
+
+private:
+
+  [[nodiscard]] auto _has_required(const entity_type entity) const noexcept -> bool {
+    return detail::all_of(_owned.begin(), _owned.end(), entity) && detail::all_of(_get.begin(), _get.end(), entity);
+  }
+
+  auto _push(const entity_type entity) -> void {
+    if (_has_required(entity) && detail::none_of(_filter.begin(), _filter.end(), entity)) {
+      _insert(entity);
+    }
+  }
+
+  auto _insert(const entity_type entity) -> void {
+    if (_owned.front()->index(entity) < _length) {
+      return;
+    }
+
+    const auto position = _length++;
+
+    for (auto* pool : _owned) {
+      pool->swap_elements(pool->data()[position], entity);
+    }
+  }
+
+  auto _pop(const entity_type entity) -> void {
+    const auto& leading = *_owned.front();
+
+    if (!leading.contains(entity) || !(leading.index(entity) < _length)) {
+      return;
+    }
+
+    const auto position = --_length;
+
+    for (auto* pool : _owned) {
+      pool->swap_elements(pool->data()[position], entity);
+    }
+  }
+
+  std::array<common_type*, Owned> _owned;
+  std::array<common_type*, Get> _get;
+  std::array<const common_type*, Exclude> _filter;
+  size_type _length;
+
+}; // class group_handler
+
+/**
+ * @brief Keeps the entities of a non-owning group in a packed set of its own.
+ */
+template<typename Type, std::size_t Get, std::size_t Exclude>
+class group_handler<Type, 0u, Get, Exclude> final : public group_handler_base<Type> {
+
+  using base_type = group_handler_base<Type>;
+
+public:
+
+  using common_type = typename base_type::common_type;
+  using entity_type = typename base_type::entity_type;
+  using size_type = typename base_type::size_type;
+  using allocator_type = typename common_type::allocator_type;
+
+  group_handler(const allocator_type& allocator, std::array<common_type*, Get> get, std::array<const common_type*, Exclude> filter)
+  : _elements{deletion_policy::swap_and_pop, allocator},
+    _get{get},
+    _filter{filter} {
+    const auto& leading = **std::ranges::min_element(_get, std::ranges::less{}, [](const auto* pool) { return pool->size(); });
+
+    for (const auto entity : leading) {
+      _push(entity);
+    }
+  }
+
+  ~group_handler() override = default;
+
+  [[nodiscard]] auto elements() const noexcept -> const common_type& {
+    return _elements;
+  }
+
+  [[nodiscard]] auto get(const size_type index) const noexcept -> common_type* {
+    return _get[index];
+  }
+
+  auto on_construct(const common_type& pool, const entity_type entity) -> void override {
+    if (base_type::is_one_of(pool, _filter)) {
+      _elements.remove(entity);
+    } else if (base_type::is_one_of(pool, _get)) {
+      _push(entity);
+    }
+  }
+
+  auto on_destroy(const common_type& pool, const entity_type entity) -> void override {
+    if (base_type::is_one_of(pool, _filter)) {
+      if (detail::all_of(_get.begin(), _get.end(), entity) && base_type::count_of(_filter, entity) == 1u && !_elements.contains(entity)) {
+        _elements.push(entity);
+      }
+    } else if (base_type::is_one_of(pool, _get)) {
+      _elements.remove(entity);
+    }
+  }
+
+  auto clear() -> void override {
+    _elements.clear();
+  }
+
+private:
+
+  auto _push(const entity_type entity) -> void {
+    if (!_elements.contains(entity) && detail::all_of(_get.begin(), _get.end(), entity) && detail::none_of(_filter.begin(), _filter.end(), entity)) {
+      _elements.push(entity);
+    }
+  }
+
+  common_type _elements;
+  std::array<common_type*, Get> _get;
+  std::array<const common_type*, Exclude> _filter;
+
+}; // class group_handler
+
+} // namespace detail
+
+template<typename, typename, typename>
+class basic_group;
+
+/**
+ * @brief Non-owning group. The matching entities are kept in a packed set that is updated whenever a component of one of the involved types is added or removed.
+ *
+ * Iterating the group never checks which entities match, but the components are still looked up through the sparse sets of the storages.
+ */
+template<typename... Get, typename... Exclude>
+requires (sizeof...(Get) != 0u)
+class basic_group<owned_t<>, get_t<Get...>, exclude_t<Exclude...>> {
+
+  using base_type = std::common_type_t<typename Get::base_type..., typename Exclude::base_type...>;
+
+  template<std::size_t Index>
+  using element_at = utility::type_list_element_t<Index, utility::type_list<Get...>>;
+
+  template<typename Type>
+  inline static constexpr auto index_of = utility::type_list_index_v<std::remove_const_t<Type>, utility::type_list<typename Get::element_type...>>;
+
+public:
+
+  using common_type = base_type;
+  using entity_type = typename common_type::entity_type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = typename common_type::iterator;
+  using handler_type = detail::group_handler<common_type, 0u, sizeof...(Get), sizeof...(Exclude)>;
+  using iterable = memory::iterable_adaptor<detail::extended_group_iterator<iterator, owned_t<>, get_t<Get...>>>;
+
+  basic_group() noexcept
+  : _handler{nullptr} { }
+
+  basic_group(handler_type& handler) noexcept
+  : _handler{&handler} { }
+
+  [[nodiscard]] auto handle() const noexcept -> const common_type& {
+    return _handler->elements();
+  }
+
+  template<typename Type>
+  [[nodiscard]] auto* storage() const noexcept {
+    return storage<index_of<Type>>();
+  }
+
+  template<std::size_t Index>
+  [[nodiscard]] auto* storage() const noexcept {
+    return static_cast<element_at<Index>*>(_handler->get(Index));
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_type {
+    return _handler ? handle().size() : size_type{};
+  }
+
+  [[nodiscard]] auto is_empty() const noexcept -> bool {
+    return !_handler || handle().is_empty();
+  }
+
+  [[nodiscard]] auto begin() const noexcept -> iterator {
+    return _handler ? handle().begin() : iterator{};
+  }
+
+  [[nodiscard]] auto end() const noexcept -> iterator {
+    return _handler ? handle().end() : iterator{};
+  }
+
+  [[nodiscard]] auto front() const noexcept -> entity_type {
+    return is_empty() ? null_entity : *begin();
+  }
+
+  [[nodiscard]] auto back() const noexcept -> entity_type {
+    return is_empty() ? null_entity : *(end() - 1);
+  }
+
+  [[nodiscard]] auto find(const entity_type entity) const noexcept -> iterator {
+    return _handler ? handle().find(entity) : iterator{};
+  }
+
+  [[nodiscard]] explicit operator bool() const noexcept {
+    return _handler != nullptr;
+  }
+
+  [[nodiscard]] auto contains(const entity_type entity) const noexcept -> bool {
+    return _handler && handle().contains(entity);
+  }
+
+  template<typename Type, typename... Other>
+  [[nodiscard]] auto get(const entity_type entity) const -> decltype(auto) {
+    return get<index_of<Type>, index_of<Other>...>(entity);
+  }
+
+  template<std::size_t... Index>
+  [[nodiscard]] auto get(const entity_type entity) const -> decltype(auto) {
+    if constexpr (sizeof...(Index) == 0) {
+      return _get(entity, std::index_sequence_for<Get...>{});
+    } else if constexpr (sizeof...(Index) == 1) {
+      return (storage<Index>()->get(entity), ...);
+    } else {
+      return std::tuple_cat(storage<Index>()->get_as_tuple(entity)...);
+    }
+  }
+
+  [[nodiscard]] auto each() const noexcept -> iterable {
+    return _each(std::index_sequence_for<Get...>{});
+  }
+
+private:
+
+  template<std::size_t... Index>
+  [[nodiscard]] auto _get(const entity_type entity, std::index_sequence<Index...>) const noexcept {
+    return std::tuple_cat(storage<Index>()->get_as_tuple(entity)...);
+  }
+
+  template<std::size_t... Index>
+  [[nodiscard]] auto _each(std::index_sequence<Index...>) const noexcept -> iterable {
+    if (!_handler) {
+      return iterable{};
+    }
+
+    const auto pools = std::make_tuple(storage<Index>()...);
+
+    return iterable{{begin(), {}, pools}, {end(), {}, pools}};
+  }
+
+  handler_type* _handler;
+
+}; // class basic_group
+
+/**
+ * @brief Owning group. The owned storages are arranged so that the entities of the group and their components are packed at the front of each of them.
+ *
+ * Owned components are iterated linearly and in lockstep. A storage can be owned by at most one group and owned storages must not be sorted by other means.
+ * Components added or removed while iterating a group invalidate its iterators.
+ */
+template<typename... Owned, typename... Get, typename... Exclude>
+requires (sizeof...(Owned) != 0u)
+class basic_group<owned_t<Owned...>, get_t<Get...>, exclude_t<Exclude...>> {
+
+  using base_type = std::common_type_t<typename Owned::base_type..., typename Get::base_type..., typename Exclude::base_type...>;
+
+  template<std::size_t Index>
+  using element_at = utility::type_list_element_t<Index, utility::type_list<Owned..., Get...>>;
+
+  template<typename Type>
+  inline static constexpr auto index_of = utility::type_list_index_v<std::remove_const_t<Type>, utility::type_list<typename Owned::element_type..., typename Get::element_type...>>;
+
+public:
+
+  using common_type = base_type;
+  using entity_type = typename common_type::entity_type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using iterator = typename common_type::iterator;
+  using handler_type = detail::group_handler<common_type, sizeof...(Owned), sizeof...(Get), sizeof...(Exclude)>;
+  using iterable = memory::iterable_adaptor<detail::extended_group_iterator<iterator, owned_t<Owned...>, get_t<Get...>>>;
+
+  basic_group() noexcept
+  : _handler{nullptr} { }
+
+  basic_group(handler_type& handler) noexcept
+  : _handler{&handler} { }
+
+  [[nodiscard]] auto handle() const noexcept -> const common_type& {
+    return *_handler->owned(0u);
+  }
+
+  template<typename Type>
+  [[nodiscard]] auto* storage() const noexcept {
+    return storage<index_of<Type>>();
+  }
+
+  template<std::size_t Index>
+  [[nodiscard]] auto* storage() const noexcept {
+    if constexpr (Index < sizeof...(Owned)) {
+      return static_cast<element_at<Index>*>(_handler->owned(Index));
+    } else {
+      return static_cast<element_at<Index>*>(_handler->get(Index - sizeof...(Owned)));
+    }
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_type {
+    return _handler ? _handler->length() : size_type{};
+  }
+
+  [[nodiscard]] auto is_empty() const noexcept -> bool {
+    return size() == 0u;
+  }
+
+  [[nodiscard]] auto begin() const noexcept -> iterator {
+    return _handler ? (handle().end() - static_cast<difference_type>(_handler->length())) : iterator{};
+  }
+
+  [[nodiscard]] auto end() const noexcept -> iterator {
+    return _handler ? handle().end() : iterator{};
+  }
+
+  [[nodiscard]] auto front() const noexcept -> entity_type {
+    return is_empty() ? null_entity : *begin();
+  }
+
+  [[nodiscard]] auto back() const noexcept -> entity_type {
+    return is_empty() ? null_entity : *(end() - 1);
+  }
+
+  [[nodiscard]] auto find(const entity_type entity) const noexcept -> iterator {
+    return contains(entity) ? handle().find(entity) : end();
+  }
+
+  [[nodiscard]] explicit operator bool() const noexcept {
+    return _handler != nullptr;
+  }
+
+  [[nodiscard]] auto contains(const entity_type entity) const noexcept -> bool {
+    return _handler && handle().contains(entity) && (handle().index(entity) < _handler->length());
+  }
+
+  template<typename Type, typename... Other>
+  [[nodiscard]] auto get(const entity_type entity) const -> decltype(auto) {
+    return get<index_of<Type>, index_of<Other>...>(entity);
+  }
+
+  template<std::size_t... Index>
+  [[nodiscard]] auto get(const entity_type entity) const -> decltype(auto) {
+    if constexpr (sizeof...(Index) == 0) {
+      return _get(entity, std::index_sequence_for<Owned..., Get...>{});
+    } else if constexpr (sizeof...(Index) == 1) {
+      return (storage<Index>()->get(entity), ...);
+    } else {
+      return std::tuple_cat(storage<Index>()->get_as_tuple(entity)...);
+    }
+  }
+
+  [[nodiscard]] auto each() const noexcept -> iterable {
+    return _each(std::index_sequence_for<Owned...>{}, std::index_sequence_for<Get...>{});
+  }
+
+private:
+
+  template<std::size_t... Index>
+  [[nodiscard]] auto _get(const entity_type entity, std::index_sequence<Index...>) const noexcept {
+    return std::tuple_cat(storage<Index>()->get_as_tuple(entity)...);
+  }
+
+  template<typename Storage>
+  [[nodiscard]] auto _owned_begin(Storage* pool) const noexcept -> detail::owned_iterator_t<Storage> {
+    if constexpr (std::is_void_v<typename Storage::value_type>) {
+      return detail::empty_storage_iterator{};
+    } else {
+      return pool->end() - static_cast<difference_type>(_handler->length());
+    }
+  }
+
+  template<typename Storage>
+  [[nodiscard]] auto _owned_end(Storage* pool) const noexcept -> detail::owned_iterator_t<Storage> {
+    if constexpr (std::is_void_v<typename Storage::value_type>) {
+      return detail::empty_storage_iterator{};
+    } else {
+      return pool->end();
+    }
+  }
+
+  template<std::size_t... OwnedIndex, std::size_t... GetIndex>
+  [[nodiscard]] auto _each(std::index_sequence<OwnedIndex...>, std::index_sequence<GetIndex...>) const noexcept -> iterable {
+    if (!_handler) {
+      return iterable{};
+    }
+
+    const auto pools = std::make_tuple(storage<sizeof...(Owned) + GetIndex>()...);
+
+    return iterable{{begin(), std::make_tuple(_owned_begin(storage<OwnedIndex>())...), pools}, {end(), std::make_tuple(_owned_end(storage<OwnedIndex>())...), pools}};
+  }
+
+  handler_type* _handler;
+
+}; // class basic_group
+
+} // namespace sbx::ecs
+
+#endif // LIBSBX_GROUP_HPP_
@@ -0,0 +1,173 @@
+#ifndef LIBSBX_OBSERVER_HPP_
+#define LIBSBX_OBSERVER_HPP_
+
+#include <vector>
+#include <type_traits>
+#include <functional>
+
+#include <libsbx/utility/type_list.hpp>
+
+#include <libsbx/memory/concepts.hpp>
+
+#include <libsbx/signals/connection.hpp>
+
+#include <libsbx/ecs/sparse_set.hpp>
+#include <libsbx/ecs/view.hpp>
+#include <libsbx/ecs/registry.hpp>
+
+namespace sbx::ecs {
+
+/**
+ * @brief Selects the components and the kind of changes an observer reacts to.
+ */
+template<bool Construct, bool Update, typename... Type>
+requires (Construct || Update)
+struct watch_t final : utility::type_list<Type...> {
+  explicit constexpr watch_t() = default;
+}; // struct watch_t
+
+/** @brief Reacts to components of any of the types being added. */
+template<typename... Type>
+inline constexpr watch_t<true, false, Type...> constructed{};
+
+/** @brief Reacts to components of any of the types being patched or replaced. */
+template<typename... Type>
+inline constexpr watch_t<false, true, Type...> updated{};
+
+/** @brief Reacts to components of any of the types being added, patched or replaced. */
+template<typename... Type>
+inline constexpr watch_t<true, true, Type...> changed{};
+
+/**
+ * @brief Collects the entities whose watched components changed since the last time the observer was drained.
+ *
+ * An entity is collected if one of the watched changes happens while it has all of the Get and none of the Exclude components.
+ * It is dropped again as soon as it loses a watched or Get component or gains an Exclude component, so the collected entities always match the filter.
+ * The entities are kept in a packed set, every entity is reported once no matter how often it changed.
+ *
+ * @tparam Registry The registry type to observe.
+ */
+template<typename Registry>
+class basic_observer {
+
+  using set_type = basic_sparse_set<typename Registry::entity_type, memory::rebound_allocator_t<typename Registry::allocator_type, typename Registry::entity_type>>;
+
+public:
+
+  using registry_type = Registry;
+  using entity_type = typename registry_type::entity_type;
+  using size_type = std::size_t;
+  using iterator = typename set_type::iterator;
+
+  template<bool Construct, bool Update, typename... Type, typename... Get, typename... Exclude>
+  basic_observer(registry_type& registry, watch_t<Construct, Update, Type...>, get_t<Get...> = get_t{}, exclude_t<Exclude...> = exclude_t{})
+  : _elements{deletion_policy::swap_and_pop, registry.get_allocator()} {
+    const auto collect = [this](registry_type& owner, const entity_type entity) {
+      if (!_elements.contains(entity) && owner.template all_of<Get...>(entity) && !owner.template any_of<Exclude...>(entity)) {
+        _elements.push(entity);
+      }
+    };
+
+    const auto discard = [this]([[maybe_unused]] registry_type& owner, const entity_type entity) {
+      _elements.remove(entity);
+    };
+
+    ([&]() {
+      if constexpr (Construct) {
+        _connections.emplace_back(registry.template on_construct<Type>().connect(collect));
+      }
+
+      if constexpr (Update) {
+        _connections.emplace_back(registry.template on_update<Type>().connect(collect));
+      }
+
+      _connections.emplace_back(registry.template on_destroy<Type>().connect(discard));
+    }(), ...);
+
+    (_connections.emplace_back(registry.template on_destroy<Get>().connect(discard)), ...);
+    (_connections.emplace_back(registry.template on_construct<Exclude>().connect(discard)), ...);
+  }
+
+  basic_observer(const basic_observer& other) = delete;
+
+  basic_observer(basic_observer&& other) = delete;
+
+  ~basic_observer() = default;
+
+  auto operator=(const basic_observer& other) -> basic_observer& = delete;
+
+  auto operator=(basic_observer&& other) -> basic_observer& = delete;
+
+  [[nodiscard]] auto size() const noexcept -> size_type {
+    return _elements.size();
+  }
+
+  [[nodiscard]] auto is_empty() const noexcept -> bool {
+    return _elements.is_empty();
+  }
+
+  [[nodiscard]] auto data() const noexcept -> const entity_type* {
+    return _elements.data();
+  }
+
+  [[nodiscard]] auto begin() const noexcept -> iterator {
+    return _elements.begin();
+  }
+
+  [[nodiscard]] auto end() const noexcept -> iterator {
+    return _elements.end();
+  }
+
+  [[nodiscard]] auto contains(const entity_type entity) const noexcept -> bool {
+    return _elements.contains(entity);
+  }
+
+  auto clear() -> void {
+    _elements.clear();
+  }
+
+  /**
+   * @brief Invokes the callable for every collected entity and clears the observer afterwards.
+   *
+   * The callable must not add or remove components of the observed types.
+   */
+  template<typename Callable>
+  requires (std::is_invocable_v<Callable, const entity_type>)
+  auto each(Callable&& callable) -> void {
+    for (const auto entity : _elements) {
+      std::invoke(callable, entity);
+    }
+
+    clear();
+  }
+
+  /**
+   * @brief Temporarily stops collecting entities.
+   */
+  auto block() -> void {
+    for (auto& connection : _connections) {
+      connection.block();
+    }
+  }
+
+  /**
+   * @brief Resumes collecting entities after block().
+   */
+  auto unblock() -> void {
+    for (auto& connection : _connections) {
+      connection.unblock();
+    }
+  }
+
+private:
+
+  set_type _elements;
+  std::vector<signals::scoped_connection> _connections;
+
+}; // class basic_observer
+
+using observer = basic_observer<registry>;
+
+} // namespace sbx::ecs
+
+#endif // LIBSBX_OBSERVER_HPP_
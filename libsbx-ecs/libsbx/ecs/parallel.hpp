@@ -0,0 +1,130 @@
+#ifndef LIBSBX_ECS_PARALLEL_HPP_
+#define LIBSBX_ECS_PARALLEL_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+#include <concepts>
+#include <functional>
+#include <type_traits>
+
+#include <libsbx/containers/task_graph.hpp>
+#include <libsbx/containers/executor.hpp>
+
+#include <libsbx/ecs/component.hpp>
+
+namespace sbx::ecs {
+
+/**
+ * @brief Runs a number of independent jobs, possibly in parallel.
+ *
+ * parallel_for(count, callable) must invoke callable(index) exactly once for every index in [0, count) and may only return once all invocations have completed.
+ */
+template<typename Type>
+concept parallel_executor = requires(Type& executor, const std::size_t count, void(*callable)(std::size_t)) {
+  { executor.parallel_for(count, callable) } -> std::same_as<void>;
+}; // concept parallel_executor
+
+/**
+ * @brief Executor that runs all jobs on the calling thread. Useful for debugging and as a baseline.
+ */
+struct sequential_executor {
+
+  template<typename Callable>
+  requires (std::is_invocable_v<Callable&, std::size_t>)
+  auto parallel_for(const std::size_t count, Callable&& callable) const -> void {
+    for (auto index = std::size_t{0u}; index < count; ++index) {
+      std::invoke(callable, index);
+    }
+  }
+
+}; // struct sequential_executor
+
+/**
+ * @brief Executor that runs every job as a task of a containers::executor.
+ *
+ * The calling thread helps executing the tasks while waiting, so it is safe to use from within a task of the same executor.
+ */
+class task_executor {
+
+public:
+
+  explicit task_executor(containers::executor& executor) noexcept
+  : _executor{&executor} { }
+
+  template<typename Callable>
+  requires (std::is_invocable_v<Callable&, std::size_t>)
+  auto parallel_for(const std::size_t count, Callable&& callable) const -> void {
+    if (count <= 1u || _executor->size() == 0u) {
+      sequential_executor{}.parallel_for(count, callable);
+      return;
+    }
+
+    auto graph = containers::task_graph{"ecs::parallel_for"};
+
+    for (auto index = std::size_t{0u}; index < count; ++index) {
+      graph.emplace([&callable, index](){ std::invoke(callable, index); });
+    }
+
+    _executor->run_and_wait(graph);
+  }
+
+private:
+
+  containers::executor* _executor;
+
+}; // class task_executor
+
+namespace detail {
+
+inline constexpr auto default_chunk_size = std::size_t{1024u};
+
+/**
+ * @brief Number of packed elements in a chunk. Chunks start and end on a page boundary of every one of the storages, no matter which one drives the iteration.
+ */
+template<typename... Storage>
+[[nodiscard]] consteval auto chunk_size() -> std::size_t {
+  auto result = std::size_t{1u};
+
+  ((result = std::lcm(result, std::max(component_traits<typename Storage::element_type, typename Storage::entity_type>::page_size, std::size_t{1u}))), ...);
+
+  return (result == 1u) ? default_chunk_size : result;
+}
+
+template<typename Callable, typename Tuple>
+inline constexpr auto is_applicable_v = false;
+
+template<typename Callable, typename... Type>
+inline constexpr auto is_applicable_v<Callable, std::tuple<Type...>> = std::is_invocable_v<Callable, Type...>;
+
+/**
+ * @brief Invokes the callable with the entity and its components or with the components only.
+ */
+template<typename Callable, typename Tuple>
+auto apply_each(Callable& callable, Tuple&& value) -> void {
+  if constexpr (is_applicable_v<Callable&, std::remove_cvref_t<Tuple>>) {
+    std::apply(callable, std::forward<Tuple>(value));
+  } else {
+    std::apply([&callable]([[maybe_unused]] const auto entity, auto&&... components) { std::invoke(callable, std::forward<decltype(components)>(components)...); }, std::forward<Tuple>(value));
+  }
+}
+
+/**
+ * @brief Splits the packed range [0, count) into chunks of chunk elements and hands them to the executor as half open ranges of packed positions.
+ */
+template<parallel_executor Executor, typename Callable>
+auto for_each_chunk(Executor& executor, const std::size_t count, const std::size_t chunk, Callable&& callable) -> void {
+  const auto chunks = (count + chunk - 1u) / chunk;
+
+  executor.parallel_for(chunks, [&callable, count, chunk](const std::size_t index) {
+    const auto first = index * chunk;
+    std::invoke(callable, first, std::min(first + chunk, count));
+  });
+}
+
+} // namespace detail
+
+} // namespace sbx::ecs
+
+#endif // LIBSBX_ECS_PARALLEL_HPP_
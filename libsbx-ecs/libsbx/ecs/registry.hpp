@@ -23,10 +23,13 @@
 
 #include <libsbx/containers/dense_map.hpp>
 
+#include <libsbx/signals/signal.hpp>
+
 #include <libsbx/ecs/entity.hpp>
 #include <libsbx/ecs/sparse_set.hpp>
 #include <libsbx/ecs/storage.hpp>
 #include <libsbx/ecs/view.hpp>
+#include <libsbx/ecs/group.hpp>
 
 #include <libsbx/ecs/detail/registry_storage_iterator.hpp>
 
@@ -46,6 +49,19 @@ struct ecs_type_id_scope { };
 template<typename Type>
 using type_id = utility::scoped_type_id<detail::ecs_type_id_scope, Type>;
 
+namespace detail {
+
+template<typename Registry>
+struct storage_signals {
+  using signal_type = signals::signal_st<Registry&, const typename Registry::entity_type>;
+
+  signal_type on_construct;
+  signal_type on_update;
+  signal_type on_destroy;
+}; // struct storage_signals
+
+} // namespace detail
+
 template<typename Type, typename Entity = entity, memory::allocator_for<Type> Allocator = std::allocator<Type>>
 struct storage_type {
   using type = basic_storage<Type, Entity, Allocator>;
@@ -69,6 +85,10 @@ class basic_registry {
   using allocator_traits = std::allocator_traits<Allocator>;
 
   using pool_container_type = containers::dense_map<std::uint32_t, std::shared_ptr<base_type>, std::identity, std::equal_to<>, memory::rebound_allocator_t<Allocator, std::pair<const std::uint32_t, std::shared_ptr<base_type>>>>;
+  using group_handler_type = detail::group_handler_base<base_type>;
+  using group_container_type = containers::dense_map<std::uint32_t, std::shared_ptr<group_handler_type>, std::identity, std::equal_to<>, memory::rebound_allocator_t<Allocator, std::pair<const std::uint32_t, std::shared_ptr<group_handler_type>>>>;
+  using signals_type = detail::storage_signals<basic_registry>;
+  using signal_container_type = containers::dense_map<std::uint32_t, std::shared_ptr<signals_type>, std::identity, std::equal_to<>, memory::rebound_allocator_t<Allocator, std::pair<const std::uint32_t, std::shared_ptr<signals_type>>>>;
   using entity_traits = ecs::entity_traits<Entity>;
 
   template<typename Type>
@@ -84,6 +104,7 @@ public:
   using common_type = base_type;
   using iterable = memory::iterable_adaptor<detail::registry_storage_iterator<typename pool_container_type::iterator>>;
   using const_iterable = memory::iterable_adaptor<detail::registry_storage_iterator<typename pool_container_type::const_iterator>>;
+  using signal_type = signals::signal_st<basic_registry&, const entity_type>;
 
   // template<typename... Get, typename... Exclude>
   // using view_type = basic_view<get_t<storage_for_type<Get>...>, exclude_t<storage_for_type<Exclude>...>>;
@@ -99,6 +120,8 @@ public:
 
   basic_registry(const size_type count, const allocator_type &allocator = allocator_type{})
   : _pools{allocator},
+    _groups{allocator},
+    _signals{allocator},
     _entities{allocator} {
     _pools.reserve(count);
   }
@@ -107,6 +130,8 @@ public:
 
   basic_registry(basic_registry&& other) noexcept
   : _pools{std::move(other._pools)},
+    _groups{std::move(other._groups)},
+    _signals{std::move(other._signals)},
     _entities{std::move(other._entities)} { }
 
   ~basic_registry() = default;
@@ -121,6 +146,8 @@ public:
   auto swap(basic_registry& other) noexcept -> void {
     using std::swap;
     swap(_pools, other._pools);
+    swap(_groups, other._groups);
+    swap(_signals, other._signals);
     swap(_entities, other._entities);
   }
 
@@ -138,7 +165,9 @@ public:
 
   auto destroy(const entity_type entity) -> version_type {
     for (auto position = _pools.size(); position != 0u; --position) {
-      _pools.begin()[static_cast<typename pool_container_type::difference_type>(position - 1u)].second->remove(entity);
+      auto&& [id, pool] = _pools.begin()[static_cast<typename pool_container_type::difference_type>(position - 1u)];
+
+      _remove(id, *pool, entity);
     }
 
     _entities.erase(entity);
@@ -149,12 +178,37 @@ public:
   requires (std::is_constructible_v<Type, Args...>)
   auto emplace(const entity_type entity, Args&&... args) -> decltype(auto) {
     utility::assert_that(is_valid(entity), "Invalid entity");
-    return _assure<Type>().emplace(entity, std::forward<Args>(args)...);
+    return _emplace<Type>(_assure<Type>(), entity, std::forward<Args>(args)...);
   }
 
   template<typename Type, typename... Other>
   auto remove(const entity_type entity) -> size_type {
-    return (_assure<Type>().remove(entity) + ... + _assure<Other>().remove(entity));
+    return (_remove(type_id<Type>::value(), _assure<Type>(), entity) + ... + _remove(type_id<Other>::value(), _assure<Other>(), entity));
+  }
+
+  /**
+   * @brief Invokes the functions on the component of the entity and notifies the on_update listeners.
+   */
+  template<typename Type, typename... Function>
+  requires (std::is_invocable_v<Function, Type&> && ...)
+  auto patch(const entity_type entity, Function&&... function) -> Type& {
+    auto& pool = _assure<Type>();
+    auto& element = pool.get(entity);
+
+    (std::invoke(std::forward<Function>(function), element), ...);
+
+    _on_update(type_id<Type>::value(), entity);
+
+    return pool.get(entity);
+  }
+
+  /**
+   * @brief Replaces the component of the entity and notifies the on_update listeners.
+   */
+  template<typename Type, typename... Args>
+  requires (std::is_constructible_v<Type, Args...>)
+  auto replace(const entity_type entity, Args&&... args) -> Type& {
+    return patch<Type>(entity, [&args...](auto& element) { element = Type{std::forward<Args>(args)...}; });
   }
 
   template<typename... Type>
@@ -195,7 +249,7 @@ public:
   [[nodiscard]] auto get_or_emplace(const entity_type entity, Args&&... args) -> decltype(auto) {
     auto& pool = _assure<Type>();
     utility::assert_that(is_valid(entity), "Invalid entity");
-    return pool.contains(entity) ? pool.get(entity) : pool.emplace(entity, std::forward<Args>(args)...);
+    return pool.contains(entity) ? pool.get(entity) : _emplace<Type>(pool, entity, std::forward<Args>(args)...);
   }
 
   template<typename... Type>
@@ -221,13 +275,27 @@ public:
   auto clear() -> void {
     if constexpr (sizeof...(Type) == 0u) {
       for (auto position = _pools.size(); position; --position) {
-        _pools.begin()[static_cast<typename pool_container_type::difference_type>(position - 1u)].second->clear();
+        auto&& [id, pool] = _pools.begin()[static_cast<typename pool_container_type::difference_type>(position - 1u)];
+
+        if (auto* signals = _find_signals(id); signals != nullptr) {
+          for (const auto entity : *pool) {
+            if (entity != tombstone_entity) {
+              signals->on_destroy.emit(*this, entity_type{entity});
+            }
+          }
+        }
+
+        pool->clear();
+      }
+
+      for (auto&& entry : _groups) {
+        entry.second->clear();
       }
 
       const auto element = _entities.each();
       _entities.erase(element.begin().base(), element.end().base());
     } else {
-      (_assure<Type>().clear(), ...);
+      (_clear(type_id<Type>::value(), _assure<Type>()), ...);
     }
   }
 
@@ -243,9 +311,90 @@ public:
     return basic_view<get_t<storage_for_type<Type>, storage_for_type<Other>...>, exclude_t<storage_for_type<Exclude>...>>{_assure<std::remove_const_t<Type>>(), _assure<std::remove_const_t<Other>>()..., _assure<std::remove_const_t<Exclude>>()...};
   }
 
+  /**
+   * @brief Returns the group of entities that have all of the Owned and Get components and none of the Exclude components, creating it on first use.
+   *
+   * With at least one owned type the group is owning and rearranges the owned storages so that their components can be iterated linearly. Without owned types it is a non-owning group that keeps the matching entities in a packed set.
+   * Groups are kept up to date when components are added or removed through the registry.
+   */
+  template<typename... Owned, typename... Get, typename... Exclude>
+  requires (sizeof...(Owned) + sizeof...(Get) != 0u)
+  [[nodiscard]] auto group(get_t<Get...> = get_t{}, exclude_t<Exclude...> = exclude_t{}) -> basic_group<owned_t<storage_for_type<Owned>...>, get_t<storage_for_type<Get>...>, exclude_t<storage_for_type<Exclude>...>> {
+    using group_type = basic_group<owned_t<storage_for_type<Owned>...>, get_t<storage_for_type<Get>...>, exclude_t<storage_for_type<Exclude>...>>;
+    using handler_type = typename group_type::handler_type;
+
+    const auto id = type_id<group_type>::value();
+
+    if (auto iterator = _groups.find(id); iterator != _groups.end()) {
+      return group_type{static_cast<handler_type&>(*iterator->second)};
+    }
+
+    utility::assert_that((!owned<Owned>() && ...), "Storage is already owned by another group");
+
+    const auto get_pools = std::array<base_type*, sizeof...(Get)>{&_assure<std::remove_const_t<Get>>()...};
+    const auto filter_pools = std::array<const base_type*, sizeof...(Exclude)>{&_assure<std::remove_const_t<Exclude>>()...};
+
+    auto handler = std::shared_ptr<handler_type>{};
+
+    if constexpr (sizeof...(Owned) == 0u) {
+      handler = std::allocate_shared<handler_type>(get_allocator(), get_allocator(), get_pools, filter_pools);
+    } else {
+      const auto owned_pools = std::array<base_type*, sizeof...(Owned)>{&_assure<std::remove_const_t<Owned>>()...};
+      handler = std::allocate_shared<handler_type>(get_allocator(), owned_pools, get_pools, filter_pools);
+    }
+
+    _groups.emplace(id, handler);
+
+    return group_type{*handler};
+  }
+
+  /**
+   * @brief Signal that is emitted after a component of Type was added to an entity.
+   */
+  template<typename Type>
+  [[nodiscard]] auto on_construct() -> signal_type& {
+    return _assure_signals(type_id<Type>::value()).on_construct;
+  }
+
+  /**
+   * @brief Signal that is emitted after a component of Type was changed through patch or replace.
+   */
+  template<typename Type>
+  [[nodiscard]] auto on_update() -> signal_type& {
+    return _assure_signals(type_id<Type>::value()).on_update;
+  }
+
+  /**
+   * @brief Signal that is emitted before a component of Type is removed from an entity, either explicitly or because the entity is destroyed.
+   */
+  template<typename Type>
+  [[nodiscard]] auto on_destroy() -> signal_type& {
+    return _assure_signals(type_id<Type>::value()).on_destroy;
+  }
+
+  /**
+   * @brief Checks whether the storage of Type is owned by a group.
+   */
+  template<typename Type>
+  [[nodiscard]] auto owned() const -> bool {
+    const auto* pool = _assure<std::remove_const_t<Type>>();
+
+    if (pool == nullptr) {
+      return false;
+    }
+
+    for (auto&& entry : _groups) {
+      if (entry.second->owns(*pool)) {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
   template<typename Type, typename Compare, typename Sort = utility::std_sort, typename... Args>
   auto sort(Compare compare, Sort sort = Sort{}, Args&&... args) -> void {
-    // utility::assert_that(!owned<Type>(), "Cannot sort owned storage");
+    utility::assert_that(!owned<Type>(), "Cannot sort owned storage");
     auto& pool = _assure<Type>();
 
     if constexpr(std::is_invocable_v<Compare, decltype(pool.get(std::declval<entity_type>())), decltype(pool.get(std::declval<entity_type>()))>) {
@@ -256,6 +405,22 @@ public:
     }
   }
 
+  /**
+   * @brief Returns the storage of the component type, creating it if it does not exist yet.
+   */
+  template<typename Type>
+  [[nodiscard]] auto storage() -> storage_for_type<Type>& {
+    return _assure<Type>();
+  }
+
+  /**
+   * @brief Returns the storage of the component type or nullptr if it does not exist.
+   */
+  template<typename Type>
+  [[nodiscard]] auto storage() const -> const storage_for_type<Type>* {
+    return _assure<Type>();
+  }
+
   [[nodiscard]] auto storage() noexcept -> iterable {
     return iterable{_pools.begin(), _pools.end()};
   }
@@ -283,6 +448,98 @@ public:
 
 private:
 
+  [[nodiscard]] auto _find_signals(const std::uint32_t id) const -> signals_type* {
+    if (_signals.empty()) {
+      return nullptr;
+    }
+
+    const auto iterator = _signals.find(id);
+
+    return iterator != _signals.cend() ? iterator->second.get() : nullptr;
+  }
+
+  auto _assure_signals(const std::uint32_t id) -> signals_type& {
+    if (auto* signals = _find_signals(id); signals != nullptr) {
+      return *signals;
+    }
+
+    auto signals = std::allocate_shared<signals_type>(get_allocator());
+
+    _signals.emplace(id, signals);
+
+    return *signals;
+  }
+
+  auto _on_construct(const std::uint32_t id, const base_type& pool, const entity_type entity) -> void {
+    for (auto&& entry : _groups) {
+      entry.second->on_construct(pool, entity);
+    }
+
+    if (auto* signals = _find_signals(id); signals != nullptr) {
+      signals->on_construct.emit(*this, entity_type{entity});
+    }
+  }
+
+  auto _on_update(const std::uint32_t id, const entity_type entity) -> void {
+    if (auto* signals = _find_signals(id); signals != nullptr) {
+      signals->on_update.emit(*this, entity_type{entity});
+    }
+  }
+
+  auto _on_destroy(const std::uint32_t id, const base_type& pool, const entity_type entity) -> void {
+    // Listeners can still access the component before groups move it around
+    if (auto* signals = _find_signals(id); signals != nullptr) {
+      signals->on_destroy.emit(*this, entity_type{entity});
+    }
+
+    for (auto&& entry : _groups) {
+      entry.second->on_destroy(pool, entity);
+    }
+  }
+
+  template<typename Type, typename Storage, typename... Args>
+  auto _emplace(Storage& pool, const entity_type entity, Args&&... args) -> decltype(auto) {
+    if constexpr (std::is_void_v<typename Storage::value_type>) {
+      pool.emplace(entity, std::forward<Args>(args)...);
+      _on_construct(type_id<Type>::value(), pool, entity);
+    } else {
+      auto& element = pool.emplace(entity, std::forward<Args>(args)...);
+
+      if (_groups.empty() && _signals.empty()) {
+        return element;
+      }
+
+      _on_construct(type_id<Type>::value(), pool, entity);
+
+      // Owning groups and listeners may have moved the component
+      return pool.get(entity);
+    }
+  }
+
+  auto _remove(const std::uint32_t id, base_type& pool, const entity_type entity) -> size_type {
+    if (!pool.contains(entity)) {
+      return 0u;
+    }
+
+    _on_destroy(id, pool, entity);
+    pool.erase(entity);
+
+    return 1u;
+  }
+
+  auto _clear(const std::uint32_t id, base_type& pool) -> void {
+    if (!_groups.empty() || _find_signals(id) != nullptr) {
+      // Back to front, so that owning groups only ever swap entities that were already visited
+      for (auto position = pool.size(); position != 0u; --position) {
+        if (const auto entity = pool.data()[position - 1u]; entity != tombstone_entity) {
+          _on_destroy(id, pool, entity);
+        }
+      }
+    }
+
+    pool.clear();
+  }
+
   template<typename Type>
   requires (std::is_same_v<Type, std::decay_t<Type>>)
   [[nodiscard]] auto _assure([[maybe_unused]] const std::uint32_t id = type_id<Type>::value()) -> storage_for_type<Type>& {
@@ -329,6 +586,8 @@ private:
   }
 
   pool_container_type _pools;
+  group_container_type _groups;
+  signal_container_type _signals;
   storage_for_type<entity_type> _entities;
 
 }; // class basic_registry
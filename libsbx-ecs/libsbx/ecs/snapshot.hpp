@@ -0,0 +1,792 @@
+#ifndef LIBSBX_ECS_SNAPSHOT_HPP_
+#define LIBSBX_ECS_SNAPSHOT_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <array>
+#include <bit>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <functional>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <libsbx/utility/exception.hpp>
+#include <libsbx/utility/hashed_string.hpp>
+
+#include <libsbx/ecs/entity.hpp>
+#include <libsbx/ecs/component.hpp>
+#include <libsbx/ecs/registry.hpp>
+
+namespace sbx::ecs {
+
+/**
+ * @brief Appends binary data to the buffer of a snapshot. Passed to the save hooks of components that are not trivially copyable.
+ */
+class snapshot_writer {
+
+public:
+
+  explicit snapshot_writer(std::vector<std::byte>& buffer) noexcept
+  : _buffer{&buffer} { }
+
+  auto write(const void* data, const std::size_t size) -> void {
+    const auto* bytes = static_cast<const std::byte*>(data);
+    _buffer->insert(_buffer->end(), bytes, bytes + size);
+  }
+
+  template<typename Type>
+  requires (std::is_trivially_copyable_v<Type>)
+  auto write(const Type& value) -> void {
+    write(std::addressof(value), sizeof(Type));
+  }
+
+  auto write_string(const std::string_view value) -> void {
+    write<std::uint64_t>(value.size());
+    write(value.data(), value.size());
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return _buffer->size();
+  }
+
+private:
+
+  std::vector<std::byte>* _buffer;
+
+}; // class snapshot_writer
+
+/**
+ * @brief Reads binary data from a snapshot. Passed to the load hooks of components that are not trivially copyable.
+ *
+ * Reading past the end throws a utility::runtime_error.
+ */
+class snapshot_reader {
+
+public:
+
+  explicit snapshot_reader(const std::span<const std::byte> data) noexcept
+  : _data{data},
+    _position{0u} { }
+
+  auto read(void* data, const std::size_t size) -> void {
+    std::memcpy(data, read_bytes(size).data(), size);
+  }
+
+  template<typename Type>
+  requires (std::is_trivially_copyable_v<Type>)
+  [[nodiscard]] auto read() -> Type {
+    auto bytes = std::array<std::byte, sizeof(Type)>{};
+    read(bytes.data(), sizeof(Type));
+    return std::bit_cast<Type>(bytes);
+  }
+
+  [[nodiscard]] auto read_string() -> std::string {
+    const auto size = read<std::uint64_t>();
+    const auto bytes = read_bytes(size);
+
+    return std::string{reinterpret_cast<const char*>(bytes.data()), size};
+  }
+
+  /**
+   * @brief Returns a view of the next size bytes without copying them.
+   */
+  [[nodiscard]] auto read_bytes(const std::size_t size) -> std::span<const std::byte> {
+    if (size > remaining()) {
+      throw utility::runtime_error{"Unexpected end of snapshot data (requested {} bytes, {} remaining)", size, remaining()};
+    }
+
+    const auto result = _data.subspan(_position, size);
+    _position += size;
+
+    return result;
+  }
+
+  [[nodiscard]] auto remaining() const noexcept -> std::size_t {
+    return _data.size() - _position;
+  }
+
+private:
+
+  std::span<const std::byte> _data;
+  std::size_t _position;
+
+}; // class snapshot_reader
+
+/**
+ * @brief Binary image of the entities and components of a registry.
+ */
+class snapshot {
+
+public:
+
+  snapshot() = default;
+
+  explicit snapshot(std::vector<std::byte> data) noexcept
+  : _data{std::move(data)} { }
+
+  [[nodiscard]] auto data() const noexcept -> std::span<const std::byte> {
+    return _data;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return _data.size();
+  }
+
+private:
+
+  std::vector<std::byte> _data;
+
+}; // class snapshot
+
+/**
+ * @brief Binary difference between two snapshots.
+ */
+class snapshot_delta {
+
+public:
+
+  snapshot_delta() = default;
+
+  explicit snapshot_delta(std::vector<std::byte> data) noexcept
+  : _data{std::move(data)} { }
+
+  [[nodiscard]] auto data() const noexcept -> std::span<const std::byte> {
+    return _data;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return _data.size();
+  }
+
+private:
+
+  std::vector<std::byte> _data;
+
+}; // class snapshot_delta
+
+/**
+ * @brief Saves registries to binary snapshots, restores them and computes and applies deltas between snapshots.
+ *
+ * Only registered component types are saved. Components are identified by the hash of the name they were registered with, so snapshots stay valid across builds as long as the names do not change.
+ * Trivially copyable components are copied page by page with memcpy, other components are written with a pair of save and load hooks. Empty types only store their entities.
+ *
+ * A snapshot restores the entities with their exact versions and the released entities that are recycled next, so entities that are created after a restore match the ones created after the snapshot was taken.
+ * Data is stored in native byte order and is not meant to be exchanged between platforms.
+ *
+ * Snapshot layout:
+ * - magic "SBXS", u32 version
+ * - entities: u64 size, u64 free list, size x entity
+ * - u32 section count, per section: u64 id, u8 kind, u64 element size, u64 count, count x entity, u64 payload size, payload
+ *
+ * Delta layout:
+ * - magic "SBXD", u32 version
+ * - u8 has entities, entities as above if set
+ * - u32 section count, per section: u64 id, u8 kind, u64 element size, u64 removed count, removed entities, u64 changed count, changed entities, u64 payload size, payload
+ *
+ * The payload of a trivially copyable component is count x element size bytes, the payload of a hooked component is a u64 length prefixed record per entity.
+ *
+ * @tparam Registry The registry type.
+ */
+template<typename Registry>
+class basic_snapshot_serializer {
+
+  using entity_traits = ecs::entity_traits<typename Registry::entity_type>;
+  using entity_integral = typename entity_traits::entity_type;
+
+  inline static constexpr auto snapshot_magic = std::string_view{"SBXS"};
+  inline static constexpr auto delta_magic = std::string_view{"SBXD"};
+  inline static constexpr auto format_version = std::uint32_t{1u};
+
+  enum class section_kind : std::uint8_t {
+    empty,
+    trivial,
+    hooked
+  }; // enum class section_kind
+
+  struct handler {
+    section_kind kind;
+    std::uint64_t element_size;
+    std::function<void(const Registry&, snapshot_writer&)> save;
+    std::function<void(Registry&, typename Registry::entity_type, std::span<const std::byte>)> assign;
+    std::function<void(Registry&, typename Registry::entity_type)> remove;
+  }; // struct handler
+
+  struct entity_block {
+    std::vector<entity_integral> entities;
+    std::uint64_t free_list;
+    std::span<const std::byte> bytes;
+  }; // struct entity_block
+
+  struct section {
+    std::uint64_t id;
+    section_kind kind;
+    std::uint64_t element_size;
+    std::vector<entity_integral> entities;
+    std::vector<std::span<const std::byte>> records;
+  }; // struct section
+
+public:
+
+  using registry_type = Registry;
+  using entity_type = typename registry_type::entity_type;
+
+  /**
+   * @brief Registers a trivially copyable or empty component type. Its storage is saved with memcpy.
+   */
+  template<typename Type>
+  requires (std::is_trivially_copyable_v<Type> && std::is_copy_constructible_v<Type>)
+  auto register_component(const utility::hashed_string& name) -> void {
+    auto entry = handler{};
+
+    entry.kind = std::is_empty_v<Type> ? section_kind::empty : section_kind::trivial;
+    entry.element_size = std::is_empty_v<Type> ? 0u : sizeof(Type);
+
+    entry.save = [id = name.hash(), kind = entry.kind, element_size = entry.element_size](const registry_type& registry, snapshot_writer& writer) {
+      _save_section<Type>(registry, writer, id, kind, element_size, [&writer](const auto* pool, const std::size_t count, const std::vector<std::size_t>& live) {
+        if constexpr (std::is_empty_v<Type>) {
+          writer.write(std::uint64_t{0u});
+        } else {
+          constexpr auto page_size = component_traits<Type, entity_type>::page_size;
+
+          writer.write<std::uint64_t>(count * sizeof(Type));
+
+          if (!live.empty()) {
+            for (const auto position : live) {
+              writer.write(std::addressof(pool->get(pool->data()[position])), sizeof(Type));
+            }
+
+            return;
+          }
+
+          // Elements are contiguous within a page, so every page is copied at once
+          for (auto first = std::size_t{0u}; first < count; first += page_size) {
+            const auto length = std::min(page_size, count - first);
+            writer.write(std::addressof(pool->get(pool->data()[first])), length * sizeof(Type));
+          }
+        }
+      });
+    };
+
+    entry.assign = [](registry_type& registry, const entity_type entity, const std::span<const std::byte> record) {
+      if constexpr (std::is_empty_v<Type>) {
+        if (!registry.template all_of<Type>(entity)) {
+          registry.template emplace<Type>(entity);
+        }
+      } else {
+        auto bytes = std::array<std::byte, sizeof(Type)>{};
+        std::memcpy(bytes.data(), record.data(), sizeof(Type));
+
+        _assign<Type>(registry, entity, std::bit_cast<Type>(bytes));
+      }
+    };
+
+    entry.remove = [](registry_type& registry, const entity_type entity) {
+      registry.template remove<Type>(entity);
+    };
+
+    _register(name, std::move(entry));
+  }
+
+  /**
+   * @brief Registers a component type that is saved and loaded with hooks.
+   *
+   * @param save Writes a component, invoked as save(snapshot_writer&, const Type&).
+   * @param load Reads a component, invoked as load(snapshot_reader&) and returning the component.
+   */
+  template<typename Type, typename Save, typename Load>
+  requires (std::is_invocable_v<Save, snapshot_writer&, const Type&> && std::is_invocable_r_v<Type, Load, snapshot_reader&>)
+  auto register_component(const utility::hashed_string& name, Save save, Load load) -> void {
+    auto entry = handler{};
+
+    entry.kind = section_kind::hooked;
+    entry.element_size = 0u;
+
+    entry.save = [id = name.hash(), save = std::move(save)](const registry_type& registry, snapshot_writer& writer) {
+      _save_section<Type>(registry, writer, id, section_kind::hooked, 0u, [&writer, &save](const auto* pool, const std::size_t count, const std::vector<std::size_t>& live) {
+        auto payload = std::vector<std::byte>{};
+        auto payload_writer = snapshot_writer{payload};
+
+        for (auto index = std::size_t{0u}; index < count; ++index) {
+          const auto start = payload.size();
+          const auto position = live.empty() ? index : live[index];
+
+          payload_writer.write(std::uint64_t{0u});
+          std::invoke(save, payload_writer, pool->get(pool->data()[position]));
+
+          const auto length = std::uint64_t{payload.size() - start - sizeof(std::uint64_t)};
+          std::memcpy(payload.data() + start, &length, sizeof(length));
+        }
+
+        writer.write<std::uint64_t>(payload.size());
+        writer.write(payload.data(), payload.size());
+      });
+    };
+
+    entry.assign = [load = std::move(load)](registry_type& registry, const entity_type entity, const std::span<const std::byte> record) {
+      auto reader = snapshot_reader{record};
+      _assign<Type>(registry, entity, std::invoke(load, reader));
+    };
+
+    entry.remove = [](registry_type& registry, const entity_type entity) {
+      registry.template remove<Type>(entity);
+    };
+
+    _register(name, std::move(entry));
+  }
+
+  /**
+   * @brief Saves the entities and the registered components of the registry.
+   */
+  [[nodiscard]] auto save(const registry_type& registry) const -> snapshot {
+    auto data = std::vector<std::byte>{};
+    auto writer = snapshot_writer{data};
+
+    writer.write(snapshot_magic.data(), snapshot_magic.size());
+    writer.write(format_version);
+
+    const auto* entities = registry.template storage<entity_type>();
+
+    writer.write<std::uint64_t>(entities->size());
+    writer.write<std::uint64_t>(entities->free_list());
+
+    for (auto position = std::size_t{0u}; position < entities->size(); ++position) {
+      writer.write(entity_traits::to_integral(entities->data()[position]));
+    }
+
+    writer.write(static_cast<std::uint32_t>(_order.size()));
+
+    for (const auto id : _order) {
+      _handlers.at(id).save(registry, writer);
+    }
+
+    return snapshot{std::move(data)};
+  }
+
+  /**
+   * @brief Replaces the content of the registry with the content of the snapshot.
+   *
+   * Components of types that are not registered are dropped, sections of unknown types are skipped.
+   */
+  auto load(registry_type& registry, const snapshot& source) const -> void {
+    auto reader = snapshot_reader{source.data()};
+
+    _read_header(reader, snapshot_magic);
+
+    const auto block = _read_entities(reader);
+
+    registry.clear();
+    _restore_entities(registry, block);
+
+    const auto count = reader.template read<std::uint32_t>();
+
+    for (auto index = 0u; index < count; ++index) {
+      const auto current = _read_section(reader);
+
+      _assign_section(registry, current);
+    }
+  }
+
+  /**
+   * @brief Computes the changes that turn the registry state of the first snapshot into the one of the second snapshot.
+   *
+   * Only entities whose components differ are stored. The entities are stored as a whole if any entity was created or destroyed.
+   */
+  [[nodiscard]] static auto diff(const snapshot& from, const snapshot& to) -> snapshot_delta {
+    auto from_reader = snapshot_reader{from.data()};
+    auto to_reader = snapshot_reader{to.data()};
+
+    _read_header(from_reader, snapshot_magic);
+    _read_header(to_reader, snapshot_magic);
+
+    const auto from_block = _read_entities(from_reader);
+    const auto to_block = _read_entities(to_reader);
+
+    const auto from_sections = _read_sections(from_reader);
+    const auto to_sections = _read_sections(to_reader);
+
+    auto data = std::vector<std::byte>{};
+    auto writer = snapshot_writer{data};
+
+    writer.write(delta_magic.data(), delta_magic.size());
+    writer.write(format_version);
+
+    const auto is_same_entities = std::ranges::equal(from_block.bytes, to_block.bytes);
+
+    writer.write(static_cast<std::uint8_t>(!is_same_entities));
+
+    if (!is_same_entities) {
+      writer.write(to_block.bytes.data(), to_block.bytes.size());
+    }
+
+    auto ids = std::vector<std::uint64_t>{};
+
+    for (const auto& current : to_sections) {
+      ids.push_back(current.id);
+    }
+
+    for (const auto& current : from_sections) {
+      if (std::ranges::find(ids, current.id) == ids.end()) {
+        ids.push_back(current.id);
+      }
+    }
+
+    writer.write(static_cast<std::uint32_t>(ids.size()));
+
+    static const auto empty_section = section{};
+
+    for (const auto id : ids) {
+      const auto from_entry = std::ranges::find(from_sections, id, &section::id);
+      const auto to_entry = std::ranges::find(to_sections, id, &section::id);
+
+      const auto& old_section = (from_entry != from_sections.end()) ? *from_entry : empty_section;
+      const auto& new_section = (to_entry != to_sections.end()) ? *to_entry : empty_section;
+      const auto& layout = (to_entry != to_sections.end()) ? new_section : old_section;
+
+      auto previous = std::unordered_map<entity_integral, std::size_t>{};
+      previous.reserve(old_section.entities.size());
+
+      for (auto position = std::size_t{0u}; position < old_section.entities.size(); ++position) {
+        previous.emplace(old_section.entities[position], position);
+      }
+
+      auto changed = std::vector<std::size_t>{};
+
+      for (auto position = std::size_t{0u}; position < new_section.entities.size(); ++position) {
+        const auto entry = previous.find(new_section.entities[position]);
+
+        if (entry == previous.end() || !std::ranges::equal(old_section.records[entry->second], new_section.records[position])) {
+          changed.push_back(position);
+        }
+
+        if (entry != previous.end()) {
+          previous.erase(entry);
+        }
+      }
+
+      auto removed = std::vector<entity_integral>{};
+
+      for (const auto entity : old_section.entities) {
+        if (previous.contains(entity)) {
+          removed.push_back(entity);
+        }
+      }
+
+      writer.write(id);
+      writer.write(static_cast<std::uint8_t>(layout.kind));
+      writer.write(layout.element_size);
+
+      writer.write<std::uint64_t>(removed.size());
+
+      for (const auto entity : removed) {
+        writer.write(entity);
+      }
+
+      writer.write<std::uint64_t>(changed.size());
+
+      for (const auto position : changed) {
+        writer.write(new_section.entities[position]);
+      }
+
+      auto payload = std::vector<std::byte>{};
+      auto payload_writer = snapshot_writer{payload};
+
+      for (const auto position : changed) {
+        const auto& record = new_section.records[position];
+
+        if (layout.kind == section_kind::hooked) {
+          payload_writer.write<std::uint64_t>(record.size());
+        }
+
+        payload_writer.write(record.data(), record.size());
+      }
+
+      writer.write<std::uint64_t>(payload.size());
+      writer.write(payload.data(), payload.size());
+    }
+
+    return snapshot_delta{std::move(data)};
+  }
+
+  /**
+   * @brief Applies a delta to a registry that is in the state of the first snapshot the delta was computed from.
+   *
+   * Afterwards the entities and the values of the registered components match the second snapshot. The order of the components within their storages may differ.
+   */
+  auto apply(registry_type& registry, const snapshot_delta& delta) const -> void {
+    auto reader = snapshot_reader{delta.data()};
+
+    _read_header(reader, delta_magic);
+
+    const auto has_entities = reader.template read<std::uint8_t>() != 0u;
+    const auto block = has_entities ? _read_entities(reader) : entity_block{};
+
+    const auto count = reader.template read<std::uint32_t>();
+
+    auto changes = std::vector<section>{};
+    changes.reserve(count);
+
+    for (auto index = 0u; index < count; ++index) {
+      const auto id = reader.template read<std::uint64_t>();
+      const auto kind = static_cast<section_kind>(reader.template read<std::uint8_t>());
+      const auto element_size = reader.template read<std::uint64_t>();
+
+      const auto removed = _read_entity_list(reader);
+
+      if (const auto entry = _handlers.find(id); entry != _handlers.end()) {
+        for (const auto entity : removed) {
+          if (registry.is_valid(_from_integral(entity))) {
+            entry->second.remove(registry, _from_integral(entity));
+          }
+        }
+      }
+
+      auto current = section{id, kind, element_size, _read_entity_list(reader), {}};
+      current.records = _read_records(reader, current.kind, current.element_size, current.entities.size());
+
+      changes.push_back(std::move(current));
+    }
+
+    if (has_entities) {
+      auto alive = std::unordered_set<entity_integral>{};
+      alive.reserve(block.free_list);
+
+      for (auto position = std::size_t{0u}; position < block.free_list; ++position) {
+        alive.insert(block.entities[position]);
+      }
+
+      auto destroyed = std::vector<entity_type>{};
+
+      for (const auto [entity] : registry.template storage<entity_type>().each()) {
+        if (!alive.contains(entity_traits::to_integral(entity))) {
+          destroyed.push_back(entity);
+        }
+      }
+
+      for (const auto entity : destroyed) {
+        registry.destroy(entity);
+      }
+
+      _restore_entities(registry, block);
+    }
+
+    for (const auto& current : changes) {
+      _assign_section(registry, current);
+    }
+  }
+
+private:
+
+  auto _register(const utility::hashed_string& name, handler&& entry) -> void {
+    const auto id = name.hash();
+
+    utility::assert_that(!_handlers.contains(id), "Component registered twice or name hash collision");
+
+    _handlers.emplace(id, std::move(entry));
+    _order.push_back(id);
+  }
+
+  /**
+   * @brief Writes the header and entities of a section and invokes payload(pool, count, live) for the components.
+   *
+   * Storages with in-place deletion may contain tombstones. Those are skipped, live then holds the positions of the count remaining elements. It is empty if the storage has no holes.
+   */
+  template<typename Type, typename Payload>
+  static auto _save_section(const registry_type& registry, snapshot_writer& writer, const std::uint64_t id, const section_kind kind, const std::uint64_t element_size, Payload&& payload) -> void {
+    const auto* pool = registry.template storage<Type>();
+
+    auto live = std::vector<std::size_t>{};
+
+    if (pool && !pool->is_contiguous()) {
+      for (auto position = std::size_t{0u}; position < pool->size(); ++position) {
+        if (pool->data()[position] != tombstone_entity) {
+          live.push_back(position);
+        }
+      }
+    }
+
+    const auto count = pool ? (pool->is_contiguous() ? pool->size() : live.size()) : std::size_t{0u};
+
+    writer.write(id);
+    writer.write(static_cast<std::uint8_t>(kind));
+    writer.write(element_size);
+
+    writer.write<std::uint64_t>(count);
+
+    for (auto index = std::size_t{0u}; index < count; ++index) {
+      writer.write(entity_traits::to_integral(pool->data()[live.empty() ? index : live[index]]));
+    }
+
+    std::invoke(payload, pool, count, live);
+  }
+
+  [[nodiscard]] static constexpr auto _from_integral(const entity_integral value) noexcept -> entity_type {
+    return entity_traits::combine(value, value);
+  }
+
+  auto _assign_section(registry_type& registry, const section& current) const -> void {
+    const auto entry = _handlers.find(current.id);
+
+    if (entry == _handlers.end()) {
+      return;
+    }
+
+    if (entry->second.kind != current.kind || entry->second.element_size != current.element_size) {
+      throw utility::runtime_error{"Snapshot section {} does not match the registered component layout", current.id};
+    }
+
+    for (auto position = std::size_t{0u}; position < current.entities.size(); ++position) {
+      entry->second.assign(registry, _from_integral(current.entities[position]), current.records[position]);
+    }
+  }
+
+  template<typename Type>
+  static auto _assign(registry_type& registry, const entity_type entity, Type&& value) -> void {
+    if (registry.template all_of<Type>(entity)) {
+      registry.template replace<Type>(entity, std::forward<Type>(value));
+    } else {
+      registry.template emplace<Type>(entity, std::forward<Type>(value));
+    }
+  }
+
+  static auto _read_header(snapshot_reader& reader, const std::string_view magic) -> void {
+    const auto bytes = reader.read_bytes(magic.size());
+
+    if (!std::ranges::equal(bytes, std::as_bytes(std::span{magic}))) {
+      throw utility::runtime_error{"Invalid snapshot data, expected '{}'", magic};
+    }
+
+    if (const auto version = reader.template read<std::uint32_t>(); version != format_version) {
+      throw utility::runtime_error{"Unsupported snapshot version {} (expected {})", version, format_version};
+    }
+  }
+
+  [[nodiscard]] static auto _read_entity_list(snapshot_reader& reader) -> std::vector<entity_integral> {
+    const auto count = reader.template read<std::uint64_t>();
+    const auto bytes = reader.read_bytes(count * sizeof(entity_integral));
+
+    auto result = std::vector<entity_integral>(count);
+    std::ranges::copy(bytes, reinterpret_cast<std::byte*>(result.data()));
+
+    return result;
+  }
+
+  [[nodiscard]] static auto _read_entities(snapshot_reader& reader) -> entity_block {
+    auto block = entity_block{};
+
+    const auto header = reader.read_bytes(2u * sizeof(std::uint64_t));
+    auto local = snapshot_reader{header};
+
+    const auto size = local.template read<std::uint64_t>();
+    block.free_list = local.template read<std::uint64_t>();
+
+    if (block.free_list > size) {
+      throw utility::runtime_error{"Invalid snapshot data, free list {} exceeds {} entities", block.free_list, size};
+    }
+
+    const auto entities = reader.read_bytes(size * sizeof(entity_integral));
+
+    block.entities.resize(size);
+    std::ranges::copy(entities, reinterpret_cast<std::byte*>(block.entities.data()));
+
+    // Header and entities are adjacent in the source buffer
+    block.bytes = std::span<const std::byte>{header.data(), header.size() + entities.size()};
+
+    return block;
+  }
+
+  [[nodiscard]] static auto _read_records(snapshot_reader& reader, const section_kind kind, const std::uint64_t element_size, const std::size_t count) -> std::vector<std::span<const std::byte>> {
+    const auto payload = reader.read_bytes(reader.template read<std::uint64_t>());
+
+    auto records = std::vector<std::span<const std::byte>>{};
+    records.reserve(count);
+
+    switch (kind) {
+      case section_kind::empty: {
+        records.resize(count);
+        break;
+      }
+      case section_kind::trivial: {
+        const auto size = element_size;
+
+        if (payload.size() != size * count) {
+          throw utility::runtime_error{"Invalid snapshot data, payload of {} bytes for {} elements of {} bytes", payload.size(), count, size};
+        }
+
+        for (auto position = std::size_t{0u}; position < count; ++position) {
+          records.push_back(payload.subspan(position * size, size));
+        }
+
+        break;
+      }
+      case section_kind::hooked: {
+        auto local = snapshot_reader{payload};
+
+        for (auto position = std::size_t{0u}; position < count; ++position) {
+          records.push_back(local.read_bytes(local.template read<std::uint64_t>()));
+        }
+
+        break;
+      }
+      default: {
+        throw utility::runtime_error{"Invalid snapshot data, unknown section kind {}", static_cast<std::uint32_t>(kind)};
+      }
+    }
+
+    return records;
+  }
+
+  [[nodiscard]] static auto _read_section(snapshot_reader& reader) -> section {
+    auto result = section{};
+
+    result.id = reader.template read<std::uint64_t>();
+    result.kind = static_cast<section_kind>(reader.template read<std::uint8_t>());
+    result.element_size = reader.template read<std::uint64_t>();
+    result.entities = _read_entity_list(reader);
+    result.records = _read_records(reader, result.kind, result.element_size, result.entities.size());
+
+    return result;
+  }
+
+  [[nodiscard]] static auto _read_sections(snapshot_reader& reader) -> std::vector<section> {
+    const auto count = reader.template read<std::uint32_t>();
+
+    auto result = std::vector<section>{};
+    result.reserve(count);
+
+    for (auto index = 0u; index < count; ++index) {
+      result.push_back(_read_section(reader));
+    }
+
+    return result;
+  }
+
+  static auto _restore_entities(registry_type& registry, const entity_block& block) -> void {
+    auto& entities = registry.template storage<entity_type>();
+
+    entities.clear();
+    entities.reserve(block.entities.size());
+
+    for (const auto entity : block.entities) {
+      entities.push(_from_integral(entity));
+    }
+
+    entities.free_list(block.free_list);
+  }
+
+  std::unordered_map<std::uint64_t, handler> _handlers;
+  std::vector<std::uint64_t> _order;
+
+}; // class basic_snapshot_serializer
+
+using snapshot_serializer = basic_snapshot_serializer<registry>;
+
+} // namespace sbx::ecs
+
+#endif // LIBSBX_ECS_SNAPSHOT_HPP_
@@ -112,6 +112,14 @@ public:
     return _head;
   }
 
+  /**
+   * @brief Sets the number of elements in use. Only meaningful for the swap_only policy, where the elements behind the free list are the released ones.
+   */
+  auto free_list(const size_type value) noexcept -> void {
+    utility::assert_that((_policy == deletion_policy::swap_only) && !(value > _dense.size()), "Invalid free list");
+    _head = value;
+  }
+
   virtual void reserve(const size_type capacity) {
     _dense.reserve(capacity);
   }
@@ -197,11 +205,29 @@ public:
     return _entity_to_position(_sparse_reference(entity));
   }
 
+  auto push(const entity_type entity) -> iterator {
+    return try_emplace(entity, false);
+  }
+
+  auto swap_elements(const entity_type lhs, const entity_type rhs) -> void {
+    const auto from = index(lhs);
+    const auto to = index(rhs);
+
+    if (from != to) {
+      _swap_or_move(from, to);
+      _swap_at(from, to);
+    }
+  }
+
   auto erase(const entity_type entity) -> void {
     const auto it = _to_iterator(entity);
     pop(it, it + 1u);
   }
 
+  auto erase(const iterator first, const iterator last) -> void {
+    pop(first, last);
+  }
+
   auto remove(const entity_type entity) -> bool {
     if (!contains(entity)) {
       return false;
@@ -243,7 +243,7 @@ private:
 
     if constexpr(!is_pinned_type) {
       if constexpr(component_traits::in_place_delete) {
-        (base_type::operator[](to) == tombstone_entity) ? _move_to(from, to) : _swap_at(from, to);
+        (base_type::data()[to] == tombstone_entity) ? _move_to(from, to) : _swap_at(from, to);
       } else {
         _swap_at(from, to);
       }
@@ -12,6 +12,8 @@
 #include <libsbx/memory/concepts.hpp>
 #include <libsbx/memory/iterable_adaptor.hpp>
 
+#include <libsbx/ecs/parallel.hpp>
+
 #include <libsbx/ecs/detail/view_iterator.hpp>
 
 namespace sbx::ecs {
@@ -116,6 +118,13 @@ protected:
     _index = (_index != Get) ? position : Get;
   }
 
+  /**
+   * @brief Returns an iterator to the first matching entity whose packed position in the leading pool is below offset.
+   */
+  [[nodiscard]] auto iterator_at(const size_type offset) const noexcept -> iterator {
+    return (_index != Get) ? iterator{_pools[_index]->end() - static_cast<difference_type>(offset), _pools, _filter, _index} : iterator{};
+  }
+
 private:
 
   [[nodiscard]] auto _offset() const noexcept {
@@ -388,6 +397,32 @@ public:
     return {base_type::begin(), base_type::end()};
   }
 
+  /**
+   * @brief Invokes the callable for every entity of the view, either with the entity and its components or with the components only.
+   *
+   * The packed range of the leading pool is split into chunks that start and end on component page boundaries and the chunks are handed to the executor.
+   * Different chunks never share a page of the leading pool and never share an element of any other pool, so the callable may write the components it receives without synchronization.
+   * The callable is invoked concurrently and must not add or remove entities or components of the viewed types.
+   *
+   * @param executor The executor that runs the chunks, e.g. a task_executor or a sequential_executor.
+   * @param callable The callable to invoke for every entity.
+   * @param pages Number of pages per chunk.
+   */
+  template<parallel_executor Executor, typename Callable>
+  auto each_par(Executor& executor, Callable callable, const size_type pages = 1u) const -> void {
+    constexpr auto chunk_size = detail::chunk_size<Get...>();
+
+    const auto count = base_type::size_hint();
+
+    detail::for_each_chunk(executor, count, chunk_size * std::max(pages, size_type{1u}), [this, &callable](const size_type first, const size_type last) {
+      const auto end = detail::extended_view_iterator<iterator, Get...>{base_type::iterator_at(first)};
+
+      for (auto it = detail::extended_view_iterator<iterator, Get...>{base_type::iterator_at(last)}; it != end; ++it) {
+        detail::apply_each(callable, *it);
+      }
+    });
+  }
+
 private:
 
   template<std::size_t... Index>
@@ -475,6 +510,54 @@ public:
     }
   }
 
+  /**
+   * @brief Invokes the callable for every entity of the view, either with the entity and its components or with the components only.
+   *
+   * The packed range of the storage is split into chunks that start and end on component page boundaries and the chunks are handed to the executor, so no two chunks share a page.
+   * The callable is invoked concurrently and must not add or remove entities or components of the viewed type.
+   *
+   * @param executor The executor that runs the chunks, e.g. a task_executor or a sequential_executor.
+   * @param callable The callable to invoke for every entity.
+   * @param pages Number of pages per chunk.
+   */
+  template<parallel_executor Executor, typename Callable>
+  auto each_par(Executor& executor, Callable callable, const size_type pages = 1u) const -> void {
+    constexpr auto chunk_size = detail::chunk_size<Get>();
+
+    if (!base_type::handle()) {
+      return;
+    }
+
+    auto count = size_type{};
+
+    if constexpr (Get::storage_policy == deletion_policy::in_place) {
+      count = base_type::size_hint();
+    } else {
+      count = base_type::size();
+    }
+
+    detail::for_each_chunk(executor, count, chunk_size * std::max(pages, size_type{1u}), [this, &callable, count](const size_type first, const size_type last) {
+      if constexpr(Get::storage_policy == deletion_policy::swap_and_pop || Get::storage_policy == deletion_policy::swap_only) {
+        const auto range = storage()->each();
+
+        const auto end = range.begin() + static_cast<difference_type>(count - first);
+
+        for (auto it = range.begin() + static_cast<difference_type>(count - last); it != end; ++it) {
+          detail::apply_each(callable, *it);
+        }
+      } else {
+        using extended_iterator = detail::extended_view_iterator<iterator, Get>;
+
+        const auto* leading = base_type::handle();
+        const auto end = extended_iterator{iterator{leading->end() - static_cast<difference_type>(first), {leading}, {}, 0u}};
+
+        for (auto it = extended_iterator{iterator{leading->end() - static_cast<difference_type>(last), {leading}, {}, 0u}}; it != end; ++it) {
+          detail::apply_each(callable, *it);
+        }
+      }
+    });
+  }
+
 }; // class basic_view
 
 template<typename... Type>
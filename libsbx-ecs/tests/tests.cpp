@@ -1,6 +1,19 @@
+#include <vector>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <random>
+#include <numeric>
+#include <span>
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include <libsbx/ecs/registry.hpp>
+#include <libsbx/ecs/observer.hpp>
+#include <libsbx/ecs/parallel.hpp>
+#include <libsbx/ecs/command_buffer.hpp>
+#include <libsbx/ecs/snapshot.hpp>
 
 class node {
 
@@ -74,6 +87,626 @@ TEST(libsbx_math_registry, initialize) {
   EXPECT_EQ(kept, 3u);
 }
 
+struct position {
+  float x;
+  float y;
+}; // struct position
+
+struct velocity {
+  float x;
+  float y;
+}; // struct velocity
+
+TEST(libsbx_ecs_group, owning_group_packs_owned_storages) {
+  auto registry = registry_type{};
+
+  auto entities = std::vector<node>{};
+
+  for (auto i = 0u; i < 16u; ++i) {
+    const auto entity = registry.create();
+
+    registry.emplace<position>(entity, static_cast<float>(i), 0.0f);
+
+    if (i % 2u == 0u) {
+      registry.emplace<velocity>(entity, 1.0f, 0.0f);
+    }
+
+    if (i % 4u == 0u) {
+      registry.emplace<exclude_tag>(entity);
+    }
+
+    entities.push_back(entity);
+  }
+
+  auto group = registry.group<position, velocity>(sbx::ecs::get_t{}, sbx::ecs::exclude<exclude_tag>);
+
+  EXPECT_TRUE(registry.owned<position>());
+  EXPECT_TRUE(registry.owned<velocity>());
+  EXPECT_EQ(group.size(), 4u);
+
+  registry.remove<exclude_tag>(entities[4u]);
+  registry.emplace<velocity>(entities[1u], 1.0f, 0.0f);
+  registry.remove<velocity>(entities[2u]);
+  registry.destroy(entities[6u]);
+
+  EXPECT_EQ(group.size(), 4u);
+  EXPECT_TRUE(group.contains(entities[4u]));
+  EXPECT_TRUE(group.contains(entities[1u]));
+  EXPECT_FALSE(group.contains(entities[2u]));
+  EXPECT_FALSE(group.contains(entities[8u]));
+
+  const auto* positions = group.storage<position>();
+  const auto* velocities = group.storage<velocity>();
+
+  for (auto index = 0u; index < group.size(); ++index) {
+    EXPECT_EQ(static_cast<node::entity_type>(positions->data()[index]), static_cast<node::entity_type>(velocities->data()[index]));
+  }
+
+  auto visited = 0u;
+
+  for (auto&& [entity, entity_position, entity_velocity] : group.each()) {
+    EXPECT_EQ(&entity_position, &registry.get<position>(entity));
+    EXPECT_EQ(&entity_velocity, &registry.get<velocity>(entity));
+    EXPECT_TRUE(registry.all_of<position>(entity) && registry.all_of<velocity>(entity));
+    ++visited;
+  }
+
+  EXPECT_EQ(visited, group.size());
+}
+
+TEST(libsbx_ecs_group, non_owning_group_tracks_matching_entities) {
+  auto registry = registry_type{};
+
+  const auto first = registry.create();
+  const auto second = registry.create();
+  const auto third = registry.create();
+
+  registry.emplace<position>(first, 0.0f, 0.0f);
+  registry.emplace<velocity>(first, 1.0f, 0.0f);
+  registry.emplace<position>(second, 0.0f, 0.0f);
+
+  auto group = registry.group(sbx::ecs::get<position, velocity>, sbx::ecs::exclude<exclude_tag>);
+
+  EXPECT_FALSE(registry.owned<position>());
+  EXPECT_EQ(group.size(), 1u);
+
+  registry.emplace<velocity>(second, 2.0f, 0.0f);
+  registry.emplace<position>(third, 0.0f, 0.0f);
+  registry.emplace<velocity>(third, 3.0f, 0.0f);
+  registry.emplace<exclude_tag>(third);
+
+  EXPECT_EQ(group.size(), 2u);
+  EXPECT_FALSE(group.contains(third));
+
+  registry.remove<exclude_tag>(third);
+  registry.remove<position>(first);
+
+  EXPECT_EQ(group.size(), 2u);
+  EXPECT_TRUE(group.contains(third));
+  EXPECT_FALSE(group.contains(first));
+
+  auto sum = 0.0f;
+
+  for (auto&& [entity, entity_position, entity_velocity] : group.each()) {
+    sum += entity_velocity.x;
+  }
+
+  EXPECT_EQ(sum, 5.0f);
+
+  registry.clear();
+
+  EXPECT_TRUE(group.is_empty());
+}
+
+TEST(libsbx_ecs_signals, lifecycle_signals_are_emitted) {
+  auto registry = registry_type{};
+
+  auto constructed = 0u;
+  auto updated = 0u;
+  auto destroyed = 0u;
+
+  registry.on_construct<position>().connect([&](registry_type& owner, const node entity) { EXPECT_TRUE(owner.all_of<position>(entity)); ++constructed; });
+  registry.on_update<position>().connect([&](registry_type&, const node) { ++updated; });
+  registry.on_destroy<position>().connect([&](registry_type& owner, const node entity) { EXPECT_TRUE(owner.all_of<position>(entity)); ++destroyed; });
+
+  const auto first = registry.create();
+  const auto second = registry.create();
+
+  registry.emplace<position>(first, 0.0f, 0.0f);
+  registry.emplace<position>(second, 0.0f, 0.0f);
+  registry.patch<position>(first, [](auto& value) { value.x = 1.0f; });
+  registry.replace<position>(second, 2.0f, 2.0f);
+  registry.remove<position>(first);
+  registry.destroy(second);
+
+  EXPECT_EQ(constructed, 2u);
+  EXPECT_EQ(updated, 2u);
+  EXPECT_EQ(destroyed, 2u);
+}
+
+TEST(libsbx_ecs_observer, collects_changed_entities) {
+  auto registry = registry_type{};
+
+  auto observer = sbx::ecs::basic_observer<registry_type>{registry, sbx::ecs::changed<position>, sbx::ecs::get<velocity>, sbx::ecs::exclude<exclude_tag>};
+
+  const auto first = registry.create();
+  const auto second = registry.create();
+  const auto third = registry.create();
+
+  registry.emplace<velocity>(first, 0.0f, 0.0f);
+  registry.emplace<position>(first, 0.0f, 0.0f);
+  registry.emplace<position>(second, 0.0f, 0.0f);
+  registry.emplace<velocity>(third, 0.0f, 0.0f);
+  registry.emplace<exclude_tag>(third);
+  registry.emplace<position>(third, 0.0f, 0.0f);
+
+  EXPECT_EQ(observer.size(), 1u);
+  EXPECT_TRUE(observer.contains(first));
+
+  registry.patch<position>(first, [](auto& value) { value.x = 1.0f; });
+
+  auto visited = 0u;
+
+  observer.each([&](const node entity) { EXPECT_TRUE(registry.all_of<velocity>(entity)); ++visited; });
+
+  EXPECT_EQ(visited, 1u);
+  EXPECT_TRUE(observer.is_empty());
+
+  registry.emplace<velocity>(second, 0.0f, 0.0f);
+  registry.replace<position>(second, 1.0f, 1.0f);
+
+  EXPECT_TRUE(observer.contains(second));
+
+  registry.remove<velocity>(second);
+
+  EXPECT_TRUE(observer.is_empty());
+}
+
+TEST(libsbx_ecs_view, each_par_visits_every_entity_once) {
+  auto registry = registry_type{};
+
+  for (auto i = 0u; i < 5000u; ++i) {
+    const auto entity = registry.create();
+
+    registry.emplace<position>(entity, 0.0f, 0.0f);
+
+    if (i % 2u == 0u) {
+      registry.emplace<velocity>(entity, 1.0f, 2.0f);
+    }
+
+    if (i % 10u == 0u) {
+      registry.emplace<exclude_tag>(entity);
+    }
+  }
+
+  auto executor = sbx::containers::executor{4u};
+  auto parallel = sbx::ecs::task_executor{executor};
+
+  auto visited = std::atomic<std::uint32_t>{0u};
+
+  registry.view<position, const velocity>(sbx::ecs::exclude<exclude_tag>).each_par(parallel, [&](position& value, const velocity& delta) {
+    value.x += delta.x;
+    value.y += delta.y;
+    visited.fetch_add(1u, std::memory_order_relaxed);
+  });
+
+  EXPECT_EQ(visited.load(), 2000u);
+
+  registry.view<position>().each_par(parallel, [&](const node entity, position& value) {
+    const auto is_moved = registry.all_of<velocity>(entity) && !registry.all_of<exclude_tag>(entity);
+
+    EXPECT_EQ(value.x, is_moved ? 1.0f : 0.0f);
+    EXPECT_EQ(value.y, is_moved ? 2.0f : 0.0f);
+
+    visited.fetch_add(1u, std::memory_order_relaxed);
+  }, 2u);
+
+  EXPECT_EQ(visited.load(), 7000u);
+
+  auto serial = sbx::ecs::sequential_executor{};
+
+  registry.view<exclude_tag>().each_par(serial, [&](const node entity) { EXPECT_TRUE(registry.all_of<exclude_tag>(entity)); visited.fetch_add(1u, std::memory_order_relaxed); });
+
+  EXPECT_EQ(visited.load(), 7500u);
+}
+
+TEST(libsbx_ecs_command_buffer, plays_back_recorded_commands) {
+  auto registry = registry_type{};
+  auto buffer = sbx::ecs::basic_command_buffer<registry_type>{};
+
+  const auto first = registry.create();
+  const auto second = registry.create();
+
+  registry.emplace<position>(first, 0.0f, 0.0f);
+  registry.emplace<velocity>(second, 1.0f, 1.0f);
+
+  const auto key = sbx::ecs::sort_key{0u};
+
+  const auto created = buffer.create(key);
+
+  EXPECT_TRUE(buffer.is_provisional(created));
+  EXPECT_FALSE(registry.is_valid(created));
+
+  buffer.emplace<position>(key, created, 2.0f, 3.0f);
+  buffer.emplace<keep_tag>(key, created);
+  buffer.emplace<position>(key, first, 4.0f, 5.0f);
+  buffer.remove<velocity>(key, second);
+  buffer.emplace<velocity>(sbx::ecs::sort_key{1u}, second, 6.0f, 7.0f);
+  buffer.destroy(key, first);
+
+  EXPECT_TRUE(registry.all_of<position>(first));
+  EXPECT_TRUE(registry.all_of<velocity>(second));
+
+  buffer.playback(registry);
+
+  EXPECT_FALSE(registry.is_valid(first));
+  EXPECT_EQ(registry.get<velocity>(second).x, 6.0f);
+
+  auto count = 0u;
+
+  for (auto&& [entity, value] : registry.view<position, keep_tag>().each()) {
+    EXPECT_EQ(value.x, 2.0f);
+    EXPECT_EQ(value.y, 3.0f);
+    ++count;
+  }
+
+  EXPECT_EQ(count, 1u);
+
+  buffer.playback(registry);
+
+  EXPECT_EQ(registry.view<position>().size(), 1u);
+}
+
+TEST(libsbx_ecs_command_buffer, playback_is_deterministic) {
+  const auto simulate = []() {
+    auto registry = registry_type{};
+    auto buffer = sbx::ecs::basic_command_buffer<registry_type>{};
+
+    for (auto i = 0u; i < 4096u; ++i) {
+      registry.emplace<position>(registry.create(), static_cast<float>(i), 0.0f);
+    }
+
+    auto executor = sbx::containers::executor{4u};
+    auto parallel = sbx::ecs::task_executor{executor};
+
+    registry.view<position>().each_par(parallel, [&buffer](const node entity, const position& value) {
+      const auto key = sbx::ecs::sort_key{static_cast<node::entity_type>(entity)};
+
+      if (static_cast<std::uint32_t>(value.x) % 3u == 0u) {
+        buffer.destroy(key, entity);
+      } else {
+        const auto child = buffer.create(key);
+
+        buffer.emplace<velocity>(key, child, value.x, 0.0f);
+        buffer.emplace<velocity>(key, entity, value.x, 1.0f);
+      }
+    });
+
+    buffer.playback(registry);
+
+    auto result = std::vector<std::pair<node::entity_type, float>>{};
+
+    for (auto&& [entity, value] : registry.view<velocity>().each()) {
+      result.emplace_back(static_cast<node::entity_type>(entity), value.x);
+    }
+
+    return result;
+  };
+
+  const auto expected = simulate();
+
+  EXPECT_EQ(expected.size(), 2u * (4096u - 1366u));
+
+  for (auto i = 0u; i < 4u; ++i) {
+    EXPECT_EQ(simulate(), expected);
+  }
+}
+
+TEST(libsbx_ecs_command_buffer, playback_order_is_independent_of_threads) {
+  static constexpr auto count = 1024u;
+  static constexpr auto thread_count = 4u;
+
+  const auto simulate = [](const std::uint32_t seed) {
+    auto registry = registry_type{};
+    auto buffer = sbx::ecs::basic_command_buffer<registry_type>{};
+
+    auto keys = std::vector<std::uint32_t>(count);
+    std::iota(keys.begin(), keys.end(), 0u);
+    std::ranges::shuffle(keys, std::mt19937{seed});
+
+    // Every thread records a shuffled share of the keys, the threads start in a different order every run
+    auto threads = std::vector<std::thread>{};
+
+    for (auto t = 0u; t < thread_count; ++t) {
+      const auto share = std::span<const std::uint32_t>{keys}.subspan((seed + t) % thread_count * (count / thread_count), count / thread_count);
+
+      threads.emplace_back([&buffer, share](){
+        for (const auto value : share) {
+          const auto key = sbx::ecs::sort_key{value};
+          const auto entity = buffer.create(key);
+
+          buffer.emplace<position>(key, entity, static_cast<float>(value), 0.0f);
+          buffer.emplace<position>(key, entity, static_cast<float>(value), 1.0f);
+        }
+      });
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    auto order = std::vector<float>{};
+
+    registry.on_construct<position>().connect([&order](registry_type& owner, const node entity) { order.push_back(owner.get<position>(entity).x); });
+
+    buffer.playback(registry);
+
+    auto result = std::vector<std::pair<node::entity_type, position>>{};
+
+    for (auto&& [entity, value] : registry.view<position>().each()) {
+      result.emplace_back(static_cast<node::entity_type>(entity), value);
+    }
+
+    std::ranges::sort(result, std::less{}, [](const auto& entry) { return entry.first; });
+
+    return std::make_pair(order, result);
+  };
+
+  const auto [order, expected] = simulate(0u);
+
+  ASSERT_EQ(order.size(), count);
+  ASSERT_EQ(expected.size(), count);
+
+  // Components are constructed and entities are created by ascending key
+  for (auto i = 0u; i < count; ++i) {
+    EXPECT_EQ(order[i], static_cast<float>(i));
+    EXPECT_EQ(expected[i].second.x, static_cast<float>(i));
+
+    // Commands with the same key are applied in recording order
+    EXPECT_EQ(expected[i].second.y, 1.0f);
+  }
+
+  for (auto seed = 1u; seed < 8u; ++seed) {
+    const auto [other_order, other] = simulate(seed);
+
+    EXPECT_EQ(other_order, order);
+
+    ASSERT_EQ(other.size(), expected.size());
+
+    for (auto i = 0u; i < count; ++i) {
+      EXPECT_EQ(other[i].first, expected[i].first);
+      EXPECT_EQ(other[i].second.x, expected[i].second.x);
+    }
+  }
+}
+
+TEST(libsbx_ecs_command_buffer, shared_key_between_threads_asserts) {
+  GTEST_FLAG_SET(death_test_style, "threadsafe");
+
+  const auto record = []() {
+    auto registry = registry_type{};
+    auto buffer = sbx::ecs::basic_command_buffer<registry_type>{};
+
+    const auto entity = registry.create();
+
+    auto thread = std::thread{[&](){ buffer.emplace<position>(sbx::ecs::sort_key{7u}, entity, 1.0f, 0.0f); }};
+    thread.join();
+
+    buffer.emplace<position>(sbx::ecs::sort_key{7u}, entity, 2.0f, 0.0f);
+    buffer.playback(registry);
+  };
+
+  EXPECT_DEBUG_DEATH(record(), "must not share a sort key");
+}
+
+struct label {
+  std::string value;
+}; // struct label
+
+auto make_snapshot_serializer() -> sbx::ecs::basic_snapshot_serializer<registry_type> {
+  auto serializer = sbx::ecs::basic_snapshot_serializer<registry_type>{};
+
+  serializer.register_component<position>("position");
+  serializer.register_component<velocity>("velocity");
+  serializer.register_component<keep_tag>("keep_tag");
+  serializer.register_component<label>("label", [](sbx::ecs::snapshot_writer& writer, const label& value) {
+    writer.write_string(value.value);
+  }, [](sbx::ecs::snapshot_reader& reader) {
+    return label{reader.read_string()};
+  });
+
+  return serializer;
+}
+
+TEST(libsbx_ecs_snapshot, save_and_load_restores_registry) {
+  auto registry = registry_type{};
+  const auto serializer = make_snapshot_serializer();
+
+  auto entities = std::vector<node>{};
+
+  for (auto i = 0u; i < 3000u; ++i) {
+    const auto entity = registry.create();
+
+    registry.emplace<position>(entity, static_cast<float>(i), 0.0f);
+
+    if (i % 2u == 0u) {
+      registry.emplace<velocity>(entity, 1.0f, static_cast<float>(i));
+    }
+
+    if (i % 7u == 0u) {
+      registry.emplace<keep_tag>(entity);
+      registry.emplace<label>(entity, std::to_string(i));
+    }
+
+    entities.push_back(entity);
+  }
+
+  for (auto i = 0u; i < 3000u; i += 5u) {
+    registry.destroy(entities[i]);
+  }
+
+  const auto saved = serializer.save(registry);
+
+  auto restored = registry_type{};
+
+  restored.emplace<position>(restored.create(), -1.0f, -1.0f);
+
+  serializer.load(restored, saved);
+
+  for (const auto entity : entities) {
+    EXPECT_EQ(restored.is_valid(entity), registry.is_valid(entity));
+
+    if (!registry.is_valid(entity)) {
+      continue;
+    }
+
+    EXPECT_EQ(restored.get<position>(entity).x, registry.get<position>(entity).x);
+    EXPECT_EQ(restored.all_of<velocity>(entity), registry.all_of<velocity>(entity));
+    EXPECT_EQ(restored.all_of<keep_tag>(entity), registry.all_of<keep_tag>(entity));
+
+    if (registry.all_of<velocity>(entity)) {
+      EXPECT_EQ(restored.get<velocity>(entity).y, registry.get<velocity>(entity).y);
+    }
+
+    if (registry.all_of<label>(entity)) {
+      EXPECT_EQ(restored.get<label>(entity).value, registry.get<label>(entity).value);
+    }
+  }
+
+  EXPECT_EQ(restored.view<position>().size(), registry.view<position>().size());
+
+  // Released entities are recycled in the same order
+  EXPECT_EQ(static_cast<node::entity_type>(restored.create()), static_cast<node::entity_type>(registry.create()));
+  EXPECT_EQ(static_cast<node::entity_type>(restored.create()), static_cast<node::entity_type>(registry.create()));
+}
+
+struct stable_position {
+  static constexpr auto in_place_delete = true;
+  float x;
+  float y;
+}; // struct stable_position
+
+struct stable_label {
+  static constexpr auto in_place_delete = true;
+  std::string value;
+}; // struct stable_label
+
+TEST(libsbx_ecs_snapshot, save_skips_tombstones) {
+  auto registry = registry_type{};
+  auto serializer = sbx::ecs::basic_snapshot_serializer<registry_type>{};
+
+  serializer.register_component<stable_position>("stable_position");
+  serializer.register_component<stable_label>("stable_label", [](sbx::ecs::snapshot_writer& writer, const stable_label& value) {
+    writer.write_string(value.value);
+  }, [](sbx::ecs::snapshot_reader& reader) {
+    return stable_label{reader.read_string()};
+  });
+
+  auto entities = std::vector<node>{};
+
+  for (auto i = 0u; i < 200u; ++i) {
+    const auto entity = registry.create();
+
+    registry.emplace<stable_position>(entity, static_cast<float>(i), 1.0f);
+    registry.emplace<stable_label>(entity, std::to_string(i));
+
+    entities.push_back(entity);
+  }
+
+  // Removing from in-place delete storages leaves tombstones behind
+  for (auto i = 0u; i < 200u; i += 3u) {
+    registry.remove<stable_position>(entities[i]);
+    registry.remove<stable_label>(entities[i + 1u]);
+  }
+
+  registry.destroy(entities[10u]);
+
+  ASSERT_FALSE(registry.storage<stable_position>().is_contiguous());
+
+  auto restored = registry_type{};
+
+  serializer.load(restored, serializer.save(registry));
+
+  auto positions = 0u;
+  auto labels = 0u;
+
+  for (const auto entity : entities) {
+    ASSERT_EQ(restored.is_valid(entity), registry.is_valid(entity));
+
+    if (!registry.is_valid(entity)) {
+      continue;
+    }
+
+    ASSERT_EQ(restored.all_of<stable_position>(entity), registry.all_of<stable_position>(entity));
+    ASSERT_EQ(restored.all_of<stable_label>(entity), registry.all_of<stable_label>(entity));
+
+    if (registry.all_of<stable_position>(entity)) {
+      EXPECT_EQ(restored.get<stable_position>(entity).x, registry.get<stable_position>(entity).x);
+      ++positions;
+    }
+
+    if (registry.all_of<stable_label>(entity)) {
+      EXPECT_EQ(restored.get<stable_label>(entity).value, registry.get<stable_label>(entity).value);
+      ++labels;
+    }
+  }
+
+  EXPECT_EQ(positions, 200u - 67u - 1u);
+  EXPECT_EQ(labels, 200u - 67u);
+}
+
+TEST(libsbx_ecs_snapshot, delta_reproduces_target_state) {
+  auto registry = registry_type{};
+  const auto serializer = make_snapshot_serializer();
+
+  auto entities = std::vector<node>{};
+
+  for (auto i = 0u; i < 100u; ++i) {
+    const auto entity = registry.create();
+
+    registry.emplace<position>(entity, static_cast<float>(i), 0.0f);
+    registry.emplace<label>(entity, std::to_string(i));
+
+    entities.push_back(entity);
+  }
+
+  const auto from = serializer.save(registry);
+
+  auto replica = registry_type{};
+  serializer.load(replica, from);
+
+  registry.get<position>(entities[3]).y = 42.0f;
+  registry.get<label>(entities[4]).value = "changed";
+  registry.remove<label>(entities[5]);
+  registry.emplace<velocity>(entities[6], 2.0f, 3.0f);
+  registry.destroy(entities[7]);
+
+  const auto created = registry.create();
+  registry.emplace<keep_tag>(created);
+
+  const auto to = serializer.save(registry);
+  const auto delta = decltype(serializer)::diff(from, to);
+
+  EXPECT_LT(delta.size(), to.size());
+
+  serializer.apply(replica, delta);
+
+  EXPECT_EQ(replica.get<position>(entities[3]).y, 42.0f);
+  EXPECT_EQ(replica.get<label>(entities[4]).value, "changed");
+  EXPECT_FALSE(replica.all_of<label>(entities[5]));
+  EXPECT_EQ(replica.get<velocity>(entities[6]).y, 3.0f);
+  EXPECT_FALSE(replica.is_valid(entities[7]));
+  EXPECT_TRUE(replica.is_valid(created));
+  EXPECT_TRUE(replica.all_of<keep_tag>(created));
+  EXPECT_EQ(replica.view<position>().size(), registry.view<position>().size());
+  EXPECT_EQ(replica.view<label>().size(), registry.view<label>().size());
+  EXPECT_EQ(static_cast<node::entity_type>(replica.create()), static_cast<node::entity_type>(registry.create()));
+
+  const auto unchanged = decltype(serializer)::diff(to, to);
+
+  EXPECT_LT(unchanged.size(), delta.size());
+}
+
 auto main(int argc, char* argv[]) -> int {
   testing::InitGoogleTest(&argc, argv);
 
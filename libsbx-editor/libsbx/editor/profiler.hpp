@@ -17,7 +17,7 @@ template<typename Type>
 using sampler_vector = std::vector<core::sampler<Type>>;
 
 inline auto populate_nodes(std::span<const core::scope_info> infos, child_map& children_map, std::vector<core::scope_info::node_id>& root_nodes) -> void {
-  children_map.resize(core::scope_info::max_nodes);
+  children_map.resize(infos.size());
 
   for (auto& entry : children_map) {
     entry.clear();
@@ -180,10 +180,14 @@ inline void show_profiler() {
   }
 
   // Pre-process the flat list into a tree structure
-  static thread_local auto children_map = utility::make_vector<std::vector<core::scope_info::node_id>>(core::scope_info::max_nodes);
+  static thread_local auto children_map = child_map{};
   static thread_local auto root_nodes = std::vector<core::scope_info::node_id>{};
-  static thread_local auto node_time_samplers = utility::make_vector<core::sampler<std::uint64_t>>(core::scope_info::max_nodes, core::sampler<std::uint64_t>{64u});
-  static thread_local auto node_percent_samplers = utility::make_vector<core::sampler<std::double_t>>(core::scope_info::max_nodes, core::sampler<std::double_t>{64u});
+  static thread_local auto node_time_samplers = sampler_vector<std::uint64_t>{};
+  static thread_local auto node_percent_samplers = sampler_vector<std::double_t>{};
+
+  // Nodes are created lazily the first time a scope is entered on this thread
+  node_time_samplers.resize(scope_infos.size(), core::sampler<std::uint64_t>{64u});
+  node_percent_samplers.resize(scope_infos.size(), core::sampler<std::double_t>{64u});
 
   populate_nodes(scope_infos, children_map, root_nodes);
 
@@ -0,0 +1,202 @@
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <filesystem>
+
+#include <fmt/format.h>
+
+#include <libsbx/containers/executor.hpp>
+#include <libsbx/containers/task_graph.hpp>
+
+#include <libsbx/graphics/pipeline/compiler.hpp>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Callable>
+auto measure(const std::uint32_t iterations, Callable&& callable) -> double {
+  auto samples = std::vector<double>{};
+  samples.reserve(iterations);
+
+  for (auto i = 0u; i < iterations; ++i) {
+    const auto start = clock_type::now();
+    std::invoke(callable);
+    samples.push_back(std::chrono::duration<double, std::milli>(clock_type::now() - start).count());
+  }
+
+  std::ranges::sort(samples);
+
+  return samples[samples.size() / 2u];
+}
+
+auto read_file(const std::filesystem::path& path) -> std::string {
+  auto file = std::ifstream{path, std::ios::binary};
+
+  return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+auto write_file(const std::filesystem::path& path, const std::string& contents) -> void {
+  auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+  file << contents;
+}
+
+// A small shader with a shared module, similar to the mesh shaders the renderers compile at startup
+auto write_shader(const std::filesystem::path& directory) -> void {
+  std::filesystem::create_directories(directory);
+
+  write_file(directory / "common.slang", R"(
+struct VertexOutput {
+  float4 position : SV_Position;
+  float3 normal : NORMAL;
+  float2 uv : TEXCOORD0;
+};
+
+float3 shade(float3 normal, float3 light, float3 albedo) {
+  const float diffuse = max(dot(normalize(normal), normalize(light)), 0.0);
+  return albedo * (0.1 + diffuse * VARIANT);
+}
+)");
+
+  write_file(directory / "vertex.slang", R"(
+import common;
+
+struct Uniforms {
+  float4x4 view_projection;
+  float4x4 model;
+};
+
+ConstantBuffer<Uniforms> uniforms;
+
+[shader("vertex")]
+VertexOutput main(float3 position : POSITION, float3 normal : NORMAL, float2 uv : TEXCOORD0) {
+  var output : VertexOutput;
+  output.position = mul(uniforms.view_projection, mul(uniforms.model, float4(position, 1.0)));
+  output.normal = mul((float3x3)uniforms.model, normal);
+  output.uv = uv;
+  return output;
+}
+)");
+
+  write_file(directory / "fragment.slang", R"(
+import common;
+
+Sampler2D albedo;
+
+[shader("fragment")]
+float4 main(VertexOutput input) : SV_Target {
+  const float4 color = albedo.Sample(input.uv);
+  return float4(shade(input.normal, float3(0.0, 1.0, 1.0), color.rgb), color.a);
+}
+)");
+}
+
+auto make_requests(const std::filesystem::path& directory, const std::uint32_t count) -> std::vector<sbx::graphics::compiler::compile_request> {
+  auto requests = std::vector<sbx::graphics::compiler::compile_request>{};
+  requests.reserve(count);
+
+  // Every variant has its own define, so every request is compiled and cached separately
+  for (auto i = 0u; i < count; ++i) {
+    requests.push_back(sbx::graphics::compiler::compile_request{
+      .path = directory,
+      .defines = {{"VARIANT", fmt::format("{:.1f}", 1.0 + static_cast<double>(i) * 0.5)}},
+      .per_stage = {
+        {SLANG_STAGE_VERTEX, {.entry_point = "main"}},
+        {SLANG_STAGE_FRAGMENT, {.entry_point = "main"}}
+      }
+    });
+  }
+
+  return requests;
+}
+
+auto compile_all(sbx::graphics::compiler& compiler, const std::vector<sbx::graphics::compiler::compile_request>& requests) -> void {
+  for (const auto& request : requests) {
+    compiler.compile_resolved(request);
+  }
+}
+
+auto compile_all(sbx::containers::executor& executor, sbx::graphics::compiler& compiler, const std::vector<sbx::graphics::compiler::compile_request>& requests) -> void {
+  auto graph = sbx::containers::task_graph{"shader_compilation"};
+
+  for (const auto& request : requests) {
+    graph.emplace([&compiler, &request]() {
+      compiler.compile_resolved(request);
+    });
+  }
+
+  executor.run_and_wait(graph);
+}
+
+auto startup(const std::uint32_t count, const std::uint32_t iterations) -> void {
+  const auto root = std::filesystem::temp_directory_path() / "sbx-shader-cache-benchmark";
+  const auto shader_directory = root / "shaders" / "mesh";
+  const auto cache_directory = root / "cache";
+
+  std::filesystem::remove_all(root);
+
+  write_shader(shader_directory);
+
+  const auto requests = make_requests(shader_directory, count);
+
+  auto executor = sbx::containers::executor{};
+
+  // Every startup creates a new compiler, so the cost of creating the Slang session is part of the measurement
+  const auto uncached_time = measure(iterations, [&]() {
+    auto compiler = sbx::graphics::compiler{};
+    compile_all(compiler, requests);
+  });
+
+  const auto cold_time = measure(iterations, [&]() {
+    std::filesystem::remove_all(cache_directory);
+
+    auto compiler = sbx::graphics::compiler{};
+    compiler.set_cache_directory(cache_directory);
+    compile_all(compiler, requests);
+  });
+
+  const auto cold_parallel_time = measure(iterations, [&]() {
+    std::filesystem::remove_all(cache_directory);
+
+    auto compiler = sbx::graphics::compiler{};
+    compiler.set_cache_directory(cache_directory);
+    compile_all(executor, compiler, requests);
+  });
+
+  const auto warm_time = measure(iterations, [&]() {
+    auto compiler = sbx::graphics::compiler{};
+    compiler.set_cache_directory(cache_directory);
+    compile_all(compiler, requests);
+  });
+
+  // Changing the shared module invalidates every entry through its recorded dependency hash
+  const auto invalidated_time = measure(iterations, [&]() {
+    const auto common = read_file(shader_directory / "common.slang");
+    write_file(shader_directory / "common.slang", fmt::format("// {}\n{}", clock_type::now().time_since_epoch().count(), common));
+
+    auto compiler = sbx::graphics::compiler{};
+    compiler.set_cache_directory(cache_directory);
+    compile_all(compiler, requests);
+  });
+
+  fmt::print("{} shader variants ({} worker threads)\n", count, executor.size());
+  fmt::print("  {:<28} {:>9.3f} ms\n", "without cache", uncached_time);
+  fmt::print("  {:<28} {:>9.3f} ms\n", "cold cache", cold_time);
+  fmt::print("  {:<28} {:>9.3f} ms\n", "cold cache, parallel", cold_parallel_time);
+  fmt::print("  {:<28} {:>9.3f} ms  ({:.1f}x faster than cold)\n", "warm cache", warm_time, cold_time / warm_time);
+  fmt::print("  {:<28} {:>9.3f} ms\n", "changed shared module", invalidated_time);
+
+  std::filesystem::remove_all(root);
+}
+
+} // namespace
+
+auto main() -> int {
+  startup(4u, 5u);
+  startup(16u, 3u);
+
+  return 0;
+}
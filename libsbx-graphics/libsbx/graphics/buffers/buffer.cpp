@@ -10,15 +10,28 @@
 
 #include <libsbx/graphics/commands/command_buffer.hpp>
 
+#include <libsbx/graphics/descriptor/descriptor.hpp>
+
 namespace sbx::graphics {
 
+static auto retire_buffer(VkBuffer handle, VmaAllocation allocation) -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto allocator = graphics_module.allocator().handle();
+
+  graphics_module.deletion_queue().push([allocator, handle, allocation]() {
+    vmaDestroyBuffer(allocator, handle, allocation);
+  });
+}
+
 buffer::buffer(size_type size, VkBufferUsageFlags usage, VkMemoryPropertyFlags properties, memory::observer_ptr<const void> memory)
 : _size{size},
   _usage{usage},
   _properties{properties},
   _handle{VK_NULL_HANDLE},
   _allocation{VK_NULL_HANDLE},
-  _address{0u} {
+  _address{0u},
+  _generation{0u} {
   resize(size);
 
   if (memory) {
@@ -27,15 +40,9 @@ buffer::buffer(size_type size, VkBufferUsageFlags usage, VkMemoryPropertyFlags p
 }
 
 buffer::~buffer() {
-  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
-
-  auto& allocator = graphics_module.allocator();
-
-  const auto& logical_device = graphics_module.logical_device();
-
-  logical_device.wait_idle();
+  unmap();
 
-  vmaDestroyBuffer(allocator, _handle, _allocation);
+  retire_buffer(_handle, _allocation);
 }
 
 auto buffer::handle() const noexcept -> VkBuffer {
@@ -60,12 +67,15 @@ auto buffer::resize(const size_type new_size) -> void {
 
   const auto was_mapped = _mapped_memory != nullptr;
 
-  // Destroy the old buffer
+  // Destroy the old buffer once the frames in flight are done with it
   if (_handle != VK_NULL_HANDLE) {   
     unmap();
-    vmaDestroyBuffer(allocator, _handle, _allocation);
+    retire_buffer(_handle, _allocation);
   }
 
+  _mapped_memory.reset();
+  _is_persistently_mapped = false;
+
   // Create a new buffer with the new size
   _size = new_size;
 
@@ -89,11 +99,20 @@ auto buffer::resize(const size_type new_size) -> void {
     allocation_create_info.requiredFlags |= VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
   }
 
-  validate(vmaCreateBuffer(allocator, &buffer_create_info, &allocation_create_info, &_handle, &_allocation, nullptr));
+  auto allocation_info = VmaAllocationInfo{};
+
+  validate(vmaCreateBuffer(allocator, &buffer_create_info, &allocation_create_info, &_handle, &_allocation, &allocation_info));
+
+  // Shares the id counter of the descriptors, so descriptor sets written with the old buffer are never reused for the new one
+  _generation = descriptor::next_descriptor_id();
 
   vmaSetAllocationName(allocator, _allocation, name().c_str());
 
-  if (was_mapped) {
+  // Host visible buffers stay mapped for their whole lifetime, so writes are a plain memcpy
+  if (allocation_info.pMappedData) {
+    _mapped_memory.reset(allocation_info.pMappedData);
+    _is_persistently_mapped = true;
+  } else if (was_mapped) {
     map();
   }
 
@@ -112,6 +131,10 @@ auto buffer::size() const noexcept -> std::size_t {
 }
 
 auto buffer::map() -> void {
+  if (_mapped_memory) {
+    return;
+  }
+
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
   auto& allocator = graphics_module.allocator();
@@ -124,6 +147,10 @@ auto buffer::map() -> void {
 }
 
 auto buffer::unmap() -> void {
+  if (!_mapped_memory || _is_persistently_mapped) {
+    return;
+  }
+
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
   auto& allocator = graphics_module.allocator();
@@ -134,6 +161,11 @@ auto buffer::unmap() -> void {
 }
 
 auto buffer::write(memory::observer_ptr<const void> data, size_type size, size_type offset) -> void {
+  if (_is_persistently_mapped) {
+    std::memcpy(static_cast<std::uint8_t*>(_mapped_memory.get()) + offset, data.get(), size);
+    return;
+  }
+
   map();
   std::memcpy(static_cast<std::uint8_t*>(_mapped_memory.get()) + offset, data.get(), size);
   unmap();
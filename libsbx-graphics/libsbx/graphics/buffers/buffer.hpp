@@ -36,6 +36,13 @@ public:
 
   auto resize(const size_type new_size) -> void;
 
+  /**
+   * @brief Changes every time the underlying VkBuffer is recreated by resize.
+   */
+  auto generation() const noexcept -> std::uint64_t {
+    return _generation;
+  }
+
   virtual auto size() const noexcept -> size_type;
 
   virtual auto write(memory::observer_ptr<const void> data, size_type size, size_type offset = 0) -> void;
@@ -46,8 +53,14 @@ public:
     return "Buffer";
   }
 
+  /**
+   * @brief Maps the memory of the buffer. Does nothing if the buffer is host visible, since those are persistently mapped.
+   */
   auto map() -> void;
   
+  /**
+   * @brief Unmaps the memory of the buffer. Does nothing if the buffer is persistently mapped.
+   */
   auto unmap() -> void;
 
   auto mapped_memory() -> memory::observer_ptr<void> {
@@ -68,6 +81,8 @@ private:
   VkBuffer _handle;
   VmaAllocation _allocation;
   std::uint64_t _address;
+  std::uint64_t _generation;
+  bool _is_persistently_mapped{false};
 
 }; // class buffer
 
@@ -0,0 +1,281 @@
+#ifndef LIBSBX_GRAPHICS_BUFFERS_SLOT_BUFFER_HPP_
+#define LIBSBX_GRAPHICS_BUFFERS_SLOT_BUFFER_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+#include <concepts>
+#include <functional>
+#include <limits>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <libsbx/graphics/buffers/storage_buffer.hpp>
+
+namespace sbx::graphics {
+
+/**
+ * @brief CPU mirror of a storage buffer with one stable slot per key.
+ *
+ * Slots keep their index across frames, so data that references them does not have to be rebuilt when other keys come and go.
+ * A slot is only rewritten if the version passed for its key changed and only dirty ranges are uploaded, unchanged slots cost nothing per frame.
+ *
+ * Every frame is bracketed by begin_frame and end_frame. Slots of keys that were not assigned in between are released to a free list and reused.
+ * Once enough slots are free the buffer is compacted at the start of a frame, which moves slots from the end into the holes.
+ *
+ * @tparam Key Identifies the owner of a slot.
+ * @tparam Type Trivially copyable element type of the storage buffer.
+ */
+template<typename Key, typename Type>
+requires (std::is_trivially_copyable_v<Type>)
+class slot_buffer {
+
+public:
+
+  using key_type = Key;
+  using value_type = Type;
+  using size_type = std::size_t;
+  using index_type = std::uint32_t;
+
+  /**
+   * @param compaction_ratio Compacts once more than this fraction of the slots is free.
+   * @param compaction_minimum Never compacts with fewer free slots than this.
+   */
+  explicit slot_buffer(const std::float_t compaction_ratio = 0.25f, const size_type compaction_minimum = 1024u)
+  : _frame{0u},
+    _compaction_ratio{compaction_ratio},
+    _compaction_minimum{compaction_minimum},
+    _is_full_upload{true} { }
+
+  /**
+   * @brief Number of slots, including free ones.
+   */
+  [[nodiscard]] auto size() const noexcept -> size_type {
+    return _values.size();
+  }
+
+  [[nodiscard]] auto free_count() const noexcept -> size_type {
+    return _free.size();
+  }
+
+  [[nodiscard]] auto data() const noexcept -> const value_type* {
+    return _values.data();
+  }
+
+  /**
+   * @brief Starts a frame. Compacts the slots if too many of them are free, which may change the index of every slot.
+   */
+  auto begin_frame() -> void {
+    ++_frame;
+
+    if (_free.size() >= _compaction_minimum && static_cast<std::float_t>(_free.size()) > static_cast<std::float_t>(_values.size()) * _compaction_ratio) {
+      _compact();
+    }
+  }
+
+  /**
+   * @brief Returns the slot of the key and marks it as used in this frame.
+   *
+   * The factory is only invoked if the slot is new or the version differs from the one of the last assignment.
+   */
+  template<std::invocable Factory>
+  auto assign(const key_type& key, const std::uint64_t version, Factory&& factory) -> index_type {
+    auto [entry, is_new] = _slots.try_emplace(key, index_type{0u});
+
+    if (is_new) {
+      entry->second = _allocate(key);
+    }
+
+    const auto index = entry->second;
+
+    _used[index] = _frame;
+
+    if (is_new || _versions[index] != version) {
+      _values[index] = std::invoke(factory);
+      _versions[index] = version;
+      _mark_dirty(index);
+    }
+
+    return index;
+  }
+
+  /**
+   * @brief Ends a frame and releases the slots of all keys that were not assigned since begin_frame.
+   *
+   * @return true if any slot was released.
+   */
+  auto end_frame() -> bool {
+    auto is_released = false;
+
+    for (auto entry = _slots.begin(); entry != _slots.end();) {
+      if (_used[entry->second] == _frame) {
+        ++entry;
+        continue;
+      }
+
+      _free.push_back(entry->second);
+      _used[entry->second] = free_slot;
+
+      entry = _slots.erase(entry);
+      is_released = true;
+    }
+
+    return is_released;
+  }
+
+  /**
+   * @brief Writes the dirty slots to the buffer. Grows the buffer if needed, in which case all slots are written.
+   *
+   * @tparam Buffer A storage_buffer or any type with the same size, resize and update functions.
+   */
+  template<typename Buffer = storage_buffer>
+  auto upload(Buffer& buffer) -> void {
+    const auto required_size = _values.size() * sizeof(value_type);
+
+    if (required_size == 0u) {
+      _clear_dirty();
+      return;
+    }
+
+    if (buffer.size() < required_size) {
+      buffer.resize(static_cast<std::size_t>(static_cast<std::float_t>(required_size) * 1.5f));
+      _is_full_upload = true;
+    }
+
+    if (_is_full_upload) {
+      buffer.update(_values.data(), required_size);
+
+      _is_full_upload = false;
+      _clear_dirty();
+
+      return;
+    }
+
+    std::ranges::sort(_dirty);
+
+    for (auto first = _dirty.begin(); first != _dirty.end();) {
+      // Slots at or beyond the end were moved away by a compaction
+      if (*first >= _values.size()) {
+        break;
+      }
+
+      auto last = std::next(first);
+
+      while (last != _dirty.end() && *last < _values.size() && *last - *std::prev(last) <= merge_distance) {
+        ++last;
+      }
+
+      const auto begin = static_cast<std::size_t>(*first);
+      const auto count = static_cast<std::size_t>(*std::prev(last)) - begin + 1u;
+
+      buffer.update(_values.data() + begin, count * sizeof(value_type), begin * sizeof(value_type));
+
+      first = last;
+    }
+
+    _clear_dirty();
+  }
+
+private:
+
+  inline static constexpr auto free_slot = std::numeric_limits<std::uint64_t>::max();
+
+  // Clean slots between dirty ones are written along with them up to this distance, fewer small copies are faster
+  inline static constexpr auto merge_distance = index_type{4u};
+
+  auto _allocate(const key_type& key) -> index_type {
+    if (!_free.empty()) {
+      const auto index = _free.back();
+      _free.pop_back();
+
+      _keys[index] = key;
+
+      return index;
+    }
+
+    const auto index = static_cast<index_type>(_values.size());
+
+    _values.emplace_back();
+    _keys.push_back(key);
+    _versions.push_back(0u);
+    _used.push_back(0u);
+    _is_dirty.push_back(false);
+
+    return index;
+  }
+
+  auto _mark_dirty(const index_type index) -> void {
+    if (!_is_dirty[index]) {
+      _is_dirty[index] = true;
+      _dirty.push_back(index);
+    }
+  }
+
+  auto _clear_dirty() -> void {
+    for (const auto index : _dirty) {
+      if (index < _is_dirty.size()) {
+        _is_dirty[index] = false;
+      }
+    }
+
+    _dirty.clear();
+  }
+
+  auto _pop_back() -> void {
+    _values.pop_back();
+    _keys.pop_back();
+    _versions.pop_back();
+    _used.pop_back();
+    _is_dirty.pop_back();
+  }
+
+  auto _compact() -> void {
+    std::ranges::sort(_free);
+
+    for (const auto hole : _free) {
+      while (!_used.empty() && _used.back() == free_slot) {
+        _pop_back();
+      }
+
+      if (hole >= _values.size()) {
+        break;
+      }
+
+      const auto last = static_cast<index_type>(_values.size() - 1u);
+
+      _values[hole] = _values[last];
+      _keys[hole] = _keys[last];
+      _versions[hole] = _versions[last];
+      _used[hole] = _used[last];
+
+      _slots[_keys[hole]] = hole;
+
+      _mark_dirty(hole);
+      _pop_back();
+    }
+
+    _free.clear();
+  }
+
+  std::vector<value_type> _values;
+  std::vector<key_type> _keys;
+  std::vector<std::uint64_t> _versions;
+  std::vector<std::uint64_t> _used;
+  std::vector<bool> _is_dirty;
+
+  std::unordered_map<key_type, index_type> _slots;
+  std::vector<index_type> _free;
+  std::vector<index_type> _dirty;
+
+  std::uint64_t _frame;
+  std::float_t _compaction_ratio;
+  size_type _compaction_minimum;
+  bool _is_full_upload;
+
+}; // class slot_buffer
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_BUFFERS_SLOT_BUFFER_HPP_
@@ -39,6 +39,10 @@ public:
 
   auto write_descriptor_set(std::uint32_t binding, VkDescriptorType descriptor_type) const noexcept -> graphics::write_descriptor_set override;
 
+  auto descriptor_id() const noexcept -> std::uint64_t override {
+    return generation();
+  }
+
   static auto create_descriptor_set_layout_binding(std::uint32_t binding, VkDescriptorType descriptor_type, VkShaderStageFlags stage_flags) noexcept -> VkDescriptorSetLayoutBinding;
 
 }; // class storage_buffer
@@ -0,0 +1,379 @@
+#include <libsbx/graphics/buffers/upload_manager.hpp>
+
+#include <limits>
+#include <cstring>
+
+#include <libsbx/utility/logger.hpp>
+
+#include <libsbx/core/engine.hpp>
+
+#include <libsbx/graphics/graphics_module.hpp>
+
+#include <libsbx/graphics/images/image.hpp>
+
+namespace sbx::graphics {
+
+static constexpr auto align_up(const std::uint64_t value, const std::uint64_t alignment) -> std::uint64_t {
+  return (value + alignment - 1u) / alignment * alignment;
+}
+
+static auto create_timeline_semaphore(const logical_device& logical_device) -> VkSemaphore {
+  auto semaphore_type_create_info = VkSemaphoreTypeCreateInfo{};
+  semaphore_type_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+  semaphore_type_create_info.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+  semaphore_type_create_info.initialValue = 0u;
+
+  auto semaphore_create_info = VkSemaphoreCreateInfo{};
+  semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+  semaphore_create_info.pNext = &semaphore_type_create_info;
+
+  auto semaphore = VkSemaphore{};
+
+  validate(vkCreateSemaphore(logical_device, &semaphore_create_info, nullptr, &semaphore));
+
+  return semaphore;
+}
+
+static auto make_image_barrier(const upload_manager::image_upload& upload, VkImageLayout old_layout, VkImageLayout new_layout) -> VkImageMemoryBarrier2 {
+  auto barrier = VkImageMemoryBarrier2{};
+  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+  barrier.oldLayout = old_layout;
+  barrier.newLayout = new_layout;
+  barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+  barrier.image = upload.image;
+  barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+  barrier.subresourceRange.baseMipLevel = 0u;
+  barrier.subresourceRange.levelCount = upload.mip_levels;
+  barrier.subresourceRange.baseArrayLayer = 0u;
+  barrier.subresourceRange.layerCount = upload.layer_count;
+
+  return barrier;
+}
+
+upload_manager::upload_manager()
+: _next_value{0u},
+  _staging_head{0u},
+  _staging_tail{0u} {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto& logical_device = graphics_module.logical_device();
+
+  _graphics_queue_family = logical_device.queue<queue::type::graphics>().family();
+  _transfer_queue_family = logical_device.queue<queue::type::transfer>().family();
+  _has_dedicated_transfer_queue = _transfer_queue_family != _graphics_queue_family;
+
+  // The manager owns its pools since recording may happen on any thread, the pools handed out by the graphics module are only safe to use on their own thread
+  _graphics_command_pool = std::make_shared<command_pool>(VK_QUEUE_GRAPHICS_BIT);
+
+  if (_has_dedicated_transfer_queue) {
+    _transfer_command_pool = std::make_shared<command_pool>(VK_QUEUE_TRANSFER_BIT);
+  }
+
+  _semaphore = create_timeline_semaphore(logical_device);
+  _transfer_semaphore = _has_dedicated_transfer_queue ? create_timeline_semaphore(logical_device) : VK_NULL_HANDLE;
+
+  _staging_buffer = std::make_unique<staging_buffer>(staging_capacity);
+
+  utility::logger<"graphics">::debug("Upload manager uses {} queue (family {})", _has_dedicated_transfer_queue ? "dedicated transfer" : "graphics", _transfer_queue_family);
+}
+
+upload_manager::~upload_manager() {
+  wait_idle();
+
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto& logical_device = graphics_module.logical_device();
+
+  // Command buffers must be freed before the command pools
+  _free.clear();
+  _staging_buffer.reset();
+
+  vkDestroySemaphore(logical_device, _semaphore, nullptr);
+
+  if (_transfer_semaphore) {
+    vkDestroySemaphore(logical_device, _transfer_semaphore, nullptr);
+  }
+}
+
+auto upload_manager::upload(const buffer& destination, memory::observer_ptr<const void> data, VkDeviceSize size, VkDeviceSize offset) -> future_type {
+  auto lock = std::scoped_lock{_mutex};
+
+  auto& batch = _current_batch();
+
+  const auto staging = _stage(batch, data, size, 4u);
+
+  auto copy_region = VkBufferCopy{};
+  copy_region.srcOffset = staging.offset;
+  copy_region.dstOffset = offset;
+  copy_region.size = size;
+
+  // Only whole buffers are moved over to the transfer queue. Partial updates go to buffers that are already in use on the graphics queue, which would first have to release them.
+  if (!_has_dedicated_transfer_queue || offset != 0u || size != destination.buffer::size()) {
+    batch.graphics_command_buffer.copy_buffer(staging.buffer, destination, copy_region);
+
+    return batch.future;
+  }
+
+  batch.transfer_command_buffer->copy_buffer(staging.buffer, destination, copy_region);
+  batch.has_transfer_commands = true;
+
+  batch.transfer_command_buffer->release_ownership({command_buffer::release_ownership_data{
+    .src_stage_mask = VK_PIPELINE_STAGE_2_TRANSFER_BIT,
+    .src_access_mask = VK_ACCESS_2_TRANSFER_WRITE_BIT,
+    .src_queue_family = _transfer_queue_family,
+    .dst_queue_family = _graphics_queue_family,
+    .buffer = destination
+  }});
+
+  batch.graphics_command_buffer.acquire_ownership({command_buffer::acquire_ownership_data{
+    .dst_stage_mask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT,
+    .dst_access_mask = VK_ACCESS_2_MEMORY_READ_BIT,
+    .src_queue_family = _transfer_queue_family,
+    .dst_queue_family = _graphics_queue_family,
+    .buffer = destination
+  }});
+
+  return batch.future;
+}
+
+auto upload_manager::upload(const image_upload& destination, memory::observer_ptr<const void> data, VkDeviceSize size) -> future_type {
+  auto lock = std::scoped_lock{_mutex};
+
+  auto& batch = _current_batch();
+
+  // Buffer offsets for image copies need to be a multiple of the texel size and of 4
+  const auto staging = _stage(batch, data, size, 16u);
+
+  // Images that already hold data are owned by the graphics queue, so only fresh images are uploaded on the transfer queue
+  const auto uses_transfer_queue = _has_dedicated_transfer_queue && destination.old_layout == VK_IMAGE_LAYOUT_UNDEFINED;
+
+  auto& copy_command_buffer = uses_transfer_queue ? *batch.transfer_command_buffer : batch.graphics_command_buffer;
+
+  auto to_transfer_dst = make_image_barrier(destination, destination.old_layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+  to_transfer_dst.srcStageMask = (destination.old_layout == VK_IMAGE_LAYOUT_UNDEFINED) ? VK_PIPELINE_STAGE_2_NONE : VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+  to_transfer_dst.srcAccessMask = (destination.old_layout == VK_IMAGE_LAYOUT_UNDEFINED) ? VK_ACCESS_2_NONE : VK_ACCESS_2_MEMORY_READ_BIT;
+  to_transfer_dst.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  to_transfer_dst.dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+
+  copy_command_buffer.pipeline_barrier(std::span{&to_transfer_dst, 1u});
+
+  image::copy_buffer_to_image(copy_command_buffer, staging.buffer, destination.image, destination.extent, destination.layer_count, 0u, staging.offset);
+
+  if (uses_transfer_queue) {
+    batch.has_transfer_commands = true;
+
+    // The layout stays the same, ownership transfers only move the image between the queue families
+    auto release = make_image_barrier(destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    release.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    release.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    release.srcQueueFamilyIndex = _transfer_queue_family;
+    release.dstQueueFamilyIndex = _graphics_queue_family;
+
+    batch.transfer_command_buffer->pipeline_barrier(std::span{&release, 1u});
+
+    auto acquire = make_image_barrier(destination, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    acquire.dstStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+    acquire.dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT;
+    acquire.srcQueueFamilyIndex = _transfer_queue_family;
+    acquire.dstQueueFamilyIndex = _graphics_queue_family;
+
+    batch.graphics_command_buffer.pipeline_barrier(std::span{&acquire, 1u});
+  }
+
+  // Blitting the mip chain needs the graphics queue
+  if (destination.generate_mipmaps) {
+    image::create_mipmaps(batch.graphics_command_buffer, destination.image, destination.extent, destination.format, destination.new_layout, destination.mip_levels, 0u, destination.layer_count);
+  } else {
+    image::transition_image_layout(batch.graphics_command_buffer, destination.image, destination.format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, destination.new_layout, VK_IMAGE_ASPECT_COLOR_BIT, destination.mip_levels, 0u, destination.layer_count, 0u);
+  }
+
+  return batch.future;
+}
+
+auto upload_manager::flush() -> void {
+  auto lock = std::scoped_lock{_mutex};
+
+  if (!_current) {
+    return;
+  }
+
+  auto batch = std::move(_current);
+
+  batch->staging_end = _staging_head;
+
+  // Makes the copies recorded on the graphics queue visible to everything submitted after this batch
+  auto memory_barrier = VkMemoryBarrier2{};
+  memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+  memory_barrier.srcStageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+  memory_barrier.srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+  memory_barrier.dstStageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+  memory_barrier.dstAccessMask = VK_ACCESS_2_MEMORY_READ_BIT;
+
+  batch->graphics_command_buffer.pipeline_barrier({}, std::span{&memory_barrier, 1u});
+
+  auto wait_infos = std::vector<VkSemaphoreSubmitInfo>{};
+
+  if (batch->transfer_command_buffer) {
+    batch->transfer_command_buffer->end();
+
+    if (batch->has_transfer_commands) {
+      auto transfer_signal_info = VkSemaphoreSubmitInfo{};
+      transfer_signal_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+      transfer_signal_info.semaphore = _transfer_semaphore;
+      transfer_signal_info.value = batch->value;
+      transfer_signal_info.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+      batch->transfer_command_buffer->submit({}, std::span{&transfer_signal_info, 1u});
+
+      auto& wait_info = wait_infos.emplace_back();
+      wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+      wait_info.semaphore = _transfer_semaphore;
+      wait_info.value = batch->value;
+      wait_info.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+    }
+  }
+
+  auto signal_info = VkSemaphoreSubmitInfo{};
+  signal_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO;
+  signal_info.semaphore = _semaphore;
+  signal_info.value = batch->value;
+  signal_info.stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+  batch->graphics_command_buffer.submit(wait_infos, std::span{&signal_info, 1u});
+
+  _in_flight.push_back(std::move(batch));
+}
+
+auto upload_manager::collect() -> void {
+  auto lock = std::scoped_lock{_mutex};
+
+  _collect();
+}
+
+auto upload_manager::wait_idle() -> void {
+  flush();
+
+  auto lock = std::scoped_lock{_mutex};
+
+  if (_in_flight.empty()) {
+    return;
+  }
+
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto& logical_device = graphics_module.logical_device();
+
+  const auto value = _in_flight.back()->value;
+
+  auto semaphore_wait_info = VkSemaphoreWaitInfo{};
+  semaphore_wait_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+  semaphore_wait_info.semaphoreCount = 1u;
+  semaphore_wait_info.pSemaphores = &_semaphore;
+  semaphore_wait_info.pValues = &value;
+
+  validate(vkWaitSemaphores(logical_device, &semaphore_wait_info, std::numeric_limits<std::uint64_t>::max()));
+
+  _collect();
+}
+
+auto upload_manager::_current_batch() -> upload_batch& {
+  if (_current) {
+    return *_current;
+  }
+
+  if (!_free.empty()) {
+    _current = std::move(_free.back());
+    _free.pop_back();
+  } else {
+    auto transfer_command_buffer = std::optional<command_buffer>{};
+
+    if (_has_dedicated_transfer_queue) {
+      transfer_command_buffer.emplace(_transfer_command_pool, VK_QUEUE_TRANSFER_BIT, VK_COMMAND_BUFFER_LEVEL_PRIMARY);
+    }
+
+    _current = std::make_unique<upload_batch>(upload_batch{
+      .value = 0u,
+      .graphics_command_buffer = command_buffer{_graphics_command_pool, VK_QUEUE_GRAPHICS_BIT, VK_COMMAND_BUFFER_LEVEL_PRIMARY},
+      .transfer_command_buffer = std::move(transfer_command_buffer),
+      .has_transfer_commands = false,
+      .staging_end = 0u,
+      .overflow_buffers = {},
+      .promise = {},
+      .future = {}
+    });
+  }
+
+  _current->value = ++_next_value;
+  _current->has_transfer_commands = false;
+  _current->promise = std::promise<void>{};
+  _current->future = _current->promise.get_future().share();
+
+  _current->graphics_command_buffer.begin();
+
+  if (_current->transfer_command_buffer) {
+    _current->transfer_command_buffer->begin();
+  }
+
+  return *_current;
+}
+
+auto upload_manager::_stage(upload_batch& batch, memory::observer_ptr<const void> data, VkDeviceSize size, VkDeviceSize alignment) -> staging_allocation {
+  auto offset = align_up(_staging_head, alignment);
+
+  // Allocations never wrap around the end of the ring
+  if ((offset % staging_capacity) + size > staging_capacity) {
+    offset = align_up(offset, staging_capacity);
+  }
+
+  if (size <= staging_capacity && offset + size - _staging_tail <= staging_capacity) {
+    _staging_head = offset + size;
+
+    const auto ring_offset = offset % staging_capacity;
+
+    std::memcpy(static_cast<std::uint8_t*>(_staging_buffer->mapped_memory().get()) + ring_offset, data.get(), size);
+
+    return staging_allocation{_staging_buffer->handle(), ring_offset};
+  }
+
+  // The ring is full or the upload is larger than the ring. Instead of waiting on the GPU the data goes into its own buffer that lives as long as the batch.
+  utility::logger<"graphics">::debug("Staging ring is full, allocating {} bytes for a single upload", size);
+
+  auto& overflow_buffer = batch.overflow_buffers.emplace_back(std::make_unique<staging_buffer>(std::span{static_cast<const std::uint8_t*>(data.get()), size}));
+
+  return staging_allocation{overflow_buffer->handle(), 0u};
+}
+
+auto upload_manager::_collect() -> void {
+  if (_in_flight.empty()) {
+    return;
+  }
+
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto& logical_device = graphics_module.logical_device();
+
+  auto completed = std::uint64_t{0u};
+
+  validate(vkGetSemaphoreCounterValue(logical_device, _semaphore, &completed));
+
+  while (!_in_flight.empty() && _in_flight.front()->value <= completed) {
+    auto batch = std::move(_in_flight.front());
+    _in_flight.pop_front();
+
+    _staging_tail = batch->staging_end;
+
+    batch->overflow_buffers.clear();
+    batch->promise.set_value();
+
+    vkResetCommandBuffer(batch->graphics_command_buffer, 0);
+
+    if (batch->transfer_command_buffer) {
+      vkResetCommandBuffer(*batch->transfer_command_buffer, 0);
+    }
+
+    _free.push_back(std::move(batch));
+  }
+}
+
+} // namespace sbx::graphics
@@ -0,0 +1,145 @@
+#ifndef LIBSBX_GRAPHICS_BUFFERS_UPLOAD_MANAGER_HPP_
+#define LIBSBX_GRAPHICS_BUFFERS_UPLOAD_MANAGER_HPP_
+
+#include <memory>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <future>
+#include <optional>
+#include <functional>
+#include <cinttypes>
+
+#include <vulkan/vulkan.hpp>
+
+#include <libsbx/utility/noncopyable.hpp>
+
+#include <libsbx/memory/observer_ptr.hpp>
+
+#include <libsbx/graphics/commands/command_pool.hpp>
+#include <libsbx/graphics/commands/command_buffer.hpp>
+
+#include <libsbx/graphics/buffers/buffer.hpp>
+
+namespace sbx::graphics {
+
+/**
+ * @brief Batches uploads to device local resources into one submission per frame.
+ *
+ * Data is copied into a persistently mapped staging ring buffer and the copies are recorded into the batch of the current frame. If the device exposes a transfer queue in its own family the copies run there and are handed over to the graphics queue with queue family ownership transfers. Completion is tracked with a timeline semaphore, every batch signals its own value.
+ *
+ * Recording is thread safe. @ref flush, @ref collect and @ref wait_idle submit to the graphics queue and must only be called from the thread that drives the @ref graphics_module.
+ */
+class upload_manager : public utility::noncopyable {
+
+public:
+
+  inline static constexpr auto staging_capacity = VkDeviceSize{64u * 1024u * 1024u};
+
+  using future_type = std::shared_future<void>;
+
+  struct image_upload {
+    VkImage image;
+    VkFormat format;
+    VkExtent3D extent;
+    VkImageLayout old_layout{VK_IMAGE_LAYOUT_UNDEFINED};
+    VkImageLayout new_layout{VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL};
+    std::uint32_t mip_levels{1u};
+    std::uint32_t layer_count{1u};
+    bool generate_mipmaps{false};
+  }; // struct image_upload
+
+  upload_manager();
+
+  ~upload_manager();
+
+  /**
+   * @brief Copies the data into the buffer. The buffer needs to be created with VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+   */
+  auto upload(const buffer& destination, memory::observer_ptr<const void> data, VkDeviceSize size, VkDeviceSize offset = 0u) -> future_type;
+
+  /**
+   * @brief Copies the data into the first mip level of the image and transitions it into its final layout, generating the remaining mip levels if requested.
+   */
+  auto upload(const image_upload& destination, memory::observer_ptr<const void> data, VkDeviceSize size) -> future_type;
+
+  /**
+   * @brief Records commands into the graphics command buffer of the current batch. The callable is invoked immediately.
+   */
+  template<typename Callable>
+  requires (std::is_invocable_v<Callable, command_buffer&>)
+  auto record(Callable&& callable) -> future_type {
+    auto lock = std::scoped_lock{_mutex};
+
+    auto& batch = _current_batch();
+
+    std::invoke(std::forward<Callable>(callable), batch.graphics_command_buffer);
+
+    return batch.future;
+  }
+
+  /**
+   * @brief Submits the current batch. Does nothing if nothing was recorded since the last flush.
+   */
+  auto flush() -> void;
+
+  /**
+   * @brief Retires all batches that finished executing, releasing their staging memory and making their futures ready.
+   */
+  auto collect() -> void;
+
+  /**
+   * @brief Submits the current batch and blocks until every batch finished executing.
+   */
+  auto wait_idle() -> void;
+
+private:
+
+  struct upload_batch {
+    std::uint64_t value;
+    command_buffer graphics_command_buffer;
+    std::optional<command_buffer> transfer_command_buffer;
+    bool has_transfer_commands;
+    std::uint64_t staging_end;
+    std::vector<std::unique_ptr<staging_buffer>> overflow_buffers;
+    std::promise<void> promise;
+    future_type future;
+  }; // struct upload_batch
+
+  struct staging_allocation {
+    VkBuffer buffer;
+    VkDeviceSize offset;
+  }; // struct staging_allocation
+
+  auto _current_batch() -> upload_batch&;
+
+  auto _stage(upload_batch& batch, memory::observer_ptr<const void> data, VkDeviceSize size, VkDeviceSize alignment) -> staging_allocation;
+
+  auto _collect() -> void;
+
+  std::mutex _mutex;
+
+  bool _has_dedicated_transfer_queue;
+  std::uint32_t _graphics_queue_family;
+  std::uint32_t _transfer_queue_family;
+
+  std::shared_ptr<command_pool> _graphics_command_pool;
+  std::shared_ptr<command_pool> _transfer_command_pool;
+
+  VkSemaphore _semaphore;
+  VkSemaphore _transfer_semaphore;
+  std::uint64_t _next_value;
+
+  std::unique_ptr<staging_buffer> _staging_buffer;
+  std::uint64_t _staging_head;
+  std::uint64_t _staging_tail;
+
+  std::unique_ptr<upload_batch> _current;
+  std::deque<std::unique_ptr<upload_batch>> _in_flight;
+  std::vector<std::unique_ptr<upload_batch>> _free;
+
+}; // class upload_manager
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_BUFFERS_UPLOAD_MANAGER_HPP_
@@ -18,23 +18,22 @@ command_buffer::command_buffer(bool should_begin, VkQueueFlagBits queue_type, Vk
   _is_running{false} {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-  auto& logical_device = graphics_module.logical_device();
-
   _command_pool = graphics_module.command_pool(queue_type);
 
-  auto command_buffer_allocate_info = VkCommandBufferAllocateInfo{};
-	command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-	command_buffer_allocate_info.commandPool = *_command_pool;
-	command_buffer_allocate_info.level = buffer_level;
-	command_buffer_allocate_info.commandBufferCount = 1;
-
-  validate(vkAllocateCommandBuffers(logical_device, &command_buffer_allocate_info, &_handle));
+  _allocate(buffer_level);
 
   if (should_begin) {
     begin();
   }
 }
 
+command_buffer::command_buffer(std::shared_ptr<command_pool> pool, VkQueueFlagBits queue_type, VkCommandBufferLevel buffer_level)
+: _command_pool{std::move(pool)},
+  _queue_type{queue_type},
+  _is_running{false} {
+  _allocate(buffer_level);
+}
+
 command_buffer::command_buffer(command_buffer&& other) noexcept
 : _command_pool{std::move(other._command_pool)},
   _handle{std::exchange(other._handle, nullptr)},
@@ -88,6 +87,22 @@ auto command_buffer::begin(VkCommandBufferUsageFlags usage) -> void {
 	_is_running = true;
 }
 
+auto command_buffer::begin(VkCommandBufferUsageFlags usage, const VkCommandBufferInheritanceInfo& inheritance_info) -> void {
+  if (_is_running) {
+    utility::logger<"graphics">::warn("Tried to begin recording a command buffer that was already beeing recorded");
+    return;
+  }
+
+  auto command_buffer_begin_info = VkCommandBufferBeginInfo{};
+  command_buffer_begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  command_buffer_begin_info.flags = usage;
+  command_buffer_begin_info.pInheritanceInfo = &inheritance_info;
+
+  validate(vkBeginCommandBuffer(_handle, &command_buffer_begin_info));
+
+  _is_running = true;
+}
+
 auto command_buffer::end() -> void {
   if (!_is_running) {
     utility::logger<"graphics">::warn("Tried to stop recording a command buffer that was not beeing recorded");
@@ -174,6 +189,36 @@ auto command_buffer::submit(const std::vector<wait_data>& wait_data, const VkSem
 	validate(vkQueueSubmit(selected_queue, 1, &submit_info, fence));
 }
 
+auto command_buffer::submit(std::span<const VkSemaphoreSubmitInfo> wait_infos, std::span<const VkSemaphoreSubmitInfo> signal_infos, const VkFence& fence) -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto& logical_device = graphics_module.logical_device();
+  const auto& selected_queue = _queue();
+
+  if (_is_running) {
+    end();
+  }
+
+  auto command_buffer_submit_info = VkCommandBufferSubmitInfo{};
+  command_buffer_submit_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO;
+  command_buffer_submit_info.commandBuffer = _handle;
+
+  auto submit_info = VkSubmitInfo2{};
+  submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+  submit_info.waitSemaphoreInfoCount = static_cast<std::uint32_t>(wait_infos.size());
+  submit_info.pWaitSemaphoreInfos = wait_infos.data();
+  submit_info.commandBufferInfoCount = 1;
+  submit_info.pCommandBufferInfos = &command_buffer_submit_info;
+  submit_info.signalSemaphoreInfoCount = static_cast<std::uint32_t>(signal_infos.size());
+  submit_info.pSignalSemaphoreInfos = signal_infos.data();
+
+  if (fence) {
+    validate(vkResetFences(logical_device, 1, &fence));
+  }
+
+  validate(vkQueueSubmit2(selected_queue, 1, &submit_info, fence));
+}
+
 auto command_buffer::copy_buffer(const VkBuffer& source, const VkBuffer& destination, const VkBufferCopy& region) -> void {
   vkCmdCopyBuffer(_handle, source, destination, 1, &region);
 }
@@ -208,6 +253,21 @@ auto command_buffer::memory_dependency(const VkMemoryBarrier2& memory_barrier) -
   vkCmdPipelineBarrier2(_handle, &dependency_info);
 }
 
+auto command_buffer::pipeline_barrier(std::span<const VkImageMemoryBarrier2> image_barriers, std::span<const VkMemoryBarrier2> memory_barriers) -> void {
+  if (image_barriers.empty() && memory_barriers.empty()) {
+    return;
+  }
+
+  auto dependency_info = VkDependencyInfo{};
+  dependency_info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependency_info.memoryBarrierCount = static_cast<std::uint32_t>(memory_barriers.size());
+  dependency_info.pMemoryBarriers = memory_barriers.data();
+  dependency_info.imageMemoryBarrierCount = static_cast<std::uint32_t>(image_barriers.size());
+  dependency_info.pImageMemoryBarriers = image_barriers.data();
+
+  vkCmdPipelineBarrier2(_handle, &dependency_info);
+}
+
 auto command_buffer::release_ownership(const std::vector<release_ownership_data>& releases) -> void {
   if (releases.empty()) {
     return;
@@ -307,6 +367,18 @@ auto command_buffer::draw_indexed_indirect(VkBuffer buffer, std::uint32_t offset
   vkCmdDrawIndexedIndirect(_handle, buffer, offset * sizeof(VkDrawIndexedIndirectCommand), count, sizeof(VkDrawIndexedIndirectCommand));
 }
 
+auto command_buffer::draw_indexed_indirect_count(VkBuffer buffer, std::uint32_t offset, VkBuffer count_buffer, std::uint32_t count_offset, std::uint32_t max_count) -> void {
+  vkCmdDrawIndexedIndirectCount(_handle, buffer, offset * sizeof(VkDrawIndexedIndirectCommand), count_buffer, count_offset * sizeof(std::uint32_t), max_count, sizeof(VkDrawIndexedIndirectCommand));
+}
+
+auto command_buffer::execute_commands(std::span<const VkCommandBuffer> command_buffers) -> void {
+  if (command_buffers.empty()) {
+    return;
+  }
+
+  vkCmdExecuteCommands(_handle, static_cast<std::uint32_t>(command_buffers.size()), command_buffers.data());
+}
+
 auto command_buffer::begin_render_pass(const VkRenderPassBeginInfo& renderpass_begin_info, VkSubpassContents subpass_contents) -> void {
   vkCmdBeginRenderPass(_handle, &renderpass_begin_info, subpass_contents);
 }
@@ -319,6 +391,20 @@ auto command_buffer::fill_buffer(const VkBuffer& buffer, VkDeviceSize offset, Vk
   vkCmdFillBuffer(_handle, buffer, offset, size, data);
 }
 
+auto command_buffer::_allocate(VkCommandBufferLevel buffer_level) -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  auto& logical_device = graphics_module.logical_device();
+
+  auto command_buffer_allocate_info = VkCommandBufferAllocateInfo{};
+  command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+  command_buffer_allocate_info.commandPool = *_command_pool;
+  command_buffer_allocate_info.level = buffer_level;
+  command_buffer_allocate_info.commandBufferCount = 1;
+
+  validate(vkAllocateCommandBuffers(logical_device, &command_buffer_allocate_info, &_handle));
+}
+
 auto command_buffer::_queue() const -> const graphics::queue& {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
@@ -2,6 +2,7 @@
 #define LIBSBX_GRAPHICS_COMMANDS_COMMAND_BUFFER_HPP_
 
 #include <memory>
+#include <span>
 
 #include <vulkan/vulkan.hpp>
 
@@ -52,6 +53,11 @@ public:
 
   command_buffer(bool should_begin = true, VkQueueFlagBits queue_type = VK_QUEUE_GRAPHICS_BIT, VkCommandBufferLevel buffer_level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
+  /**
+   * @brief Allocates the command buffer from the given pool instead of the pool of the calling thread. Used for secondary command buffers that are recorded on worker threads.
+   */
+  command_buffer(std::shared_ptr<command_pool> pool, VkQueueFlagBits queue_type = VK_QUEUE_GRAPHICS_BIT, VkCommandBufferLevel buffer_level = VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+
   command_buffer(const command_buffer&) = delete;
 
   command_buffer(command_buffer&&) noexcept;
@@ -70,18 +76,33 @@ public:
 
   auto begin(VkCommandBufferUsageFlags usage = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT) -> void;
 
+  /**
+   * @brief Begins recording a secondary command buffer that inherits the state described by the inheritance info.
+   */
+  auto begin(VkCommandBufferUsageFlags usage, const VkCommandBufferInheritanceInfo& inheritance_info) -> void;
+
   auto end() -> void;
 
   auto submit_idle() -> void;
 
   auto submit(const std::vector<wait_data>& wait_data = {}, const VkSemaphore &signal_semaphore = nullptr, const VkFence& fence = nullptr) -> void;
 
+  /**
+   * @brief Submits the command buffer through vkQueueSubmit2. Used to wait on and signal timeline semaphores.
+   */
+  auto submit(std::span<const VkSemaphoreSubmitInfo> wait_infos, std::span<const VkSemaphoreSubmitInfo> signal_infos, const VkFence& fence = nullptr) -> void;
+
   auto copy_buffer(const VkBuffer& source, const VkBuffer& destination, const VkBufferCopy& region) -> void;
 
   auto buffer_barrier(const buffer_barrier_data& buffer_barrier_data) -> void;
 
   auto memory_dependency(const VkMemoryBarrier2& memory_barrier) -> void;
 
+  /**
+   * @brief Records all barriers in a single vkCmdPipelineBarrier2 call. Does nothing if there are no barriers.
+   */
+  auto pipeline_barrier(std::span<const VkImageMemoryBarrier2> image_barriers, std::span<const VkMemoryBarrier2> memory_barriers = {}) -> void;
+
   auto release_ownership(const std::vector<release_ownership_data>& releases) -> void;
 
   auto acquire_ownership(const std::vector<acquire_ownership_data>& acquires) -> void;
@@ -102,6 +123,10 @@ public:
 
   auto draw_indexed_indirect(VkBuffer buffer, std::uint32_t offset, std::uint32_t count) -> void;
 
+  auto draw_indexed_indirect_count(VkBuffer buffer, std::uint32_t offset, VkBuffer count_buffer, std::uint32_t count_offset, std::uint32_t max_count) -> void;
+
+  auto execute_commands(std::span<const VkCommandBuffer> command_buffers) -> void;
+
   auto begin_render_pass(const VkRenderPassBeginInfo& renderpass_begin_info, VkSubpassContents subpass_contents) -> void;
 
   auto end_render_pass() -> void;
@@ -120,6 +145,8 @@ private:
 
   auto _queue() const -> const graphics::queue&;
 
+  auto _allocate(VkCommandBufferLevel buffer_level) -> void;
+
   std::shared_ptr<command_pool> _command_pool{};
 
   VkCommandBuffer _handle{};
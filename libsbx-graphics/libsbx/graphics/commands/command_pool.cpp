@@ -32,6 +32,14 @@ auto command_pool::handle() const noexcept -> const VkCommandPool& {
   return _handle;
 }
 
+auto command_pool::reset() -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  auto& logical_device = graphics_module.logical_device();
+
+  validate(vkResetCommandPool(logical_device, _handle, 0));
+}
+
 command_pool::operator const VkCommandPool&() const noexcept {
   return _handle;
 }
@@ -19,6 +19,11 @@ public:
 
   auto handle() const noexcept -> const VkCommandPool&;
 
+  /**
+   * @brief Resets all command buffers allocated from the pool. None of them may still be pending execution.
+   */
+  auto reset() -> void;
+
   operator const VkCommandPool&() const noexcept;
 
 private:
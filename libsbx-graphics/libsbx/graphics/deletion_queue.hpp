@@ -0,0 +1,112 @@
+#ifndef LIBSBX_GRAPHICS_DELETION_QUEUE_HPP_
+#define LIBSBX_GRAPHICS_DELETION_QUEUE_HPP_
+
+#include <array>
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <utility>
+#include <cinttypes>
+
+#include <libsbx/utility/noncopyable.hpp>
+
+#include <libsbx/graphics/render_pass/swapchain.hpp>
+
+namespace sbx::graphics {
+
+/**
+ * @brief Defers the destruction of GPU resources until no frame in flight can reference them anymore.
+ *
+ * Deleters are collected per frame in flight. When the @ref graphics_module waited for the fence of a frame it flushes that frames deleters, which were pushed the last time the frame was recorded.
+ *
+ * Pushing is thread safe. Deleters of the same frame run in the order they were pushed.
+ */
+class deletion_queue : public utility::noncopyable {
+
+public:
+
+  using deleter_type = std::function<void()>;
+
+  deletion_queue(const std::size_t reserved_size) {
+    for (auto& deleters : _frames) {
+      deleters.reserve(reserved_size);
+    }
+  }
+
+  ~deletion_queue() {
+    flush_all();
+  }
+
+  template<typename Callable>
+  requires (std::is_invocable_v<Callable>)
+  auto push(Callable&& callable) -> void {
+    auto lock = std::scoped_lock{_mutex};
+
+    _frames[_current_frame].emplace_back(std::forward<Callable>(callable));
+  }
+
+  /**
+   * @brief Runs the deleters of the frame. Must only be called after the fence of the frame was waited on.
+   */
+  auto flush(const std::uint32_t frame) -> void {
+    auto deleters = std::vector<deleter_type>{};
+
+    {
+      auto lock = std::scoped_lock{_mutex};
+
+      _current_frame = frame;
+
+      std::swap(deleters, _frames[frame]);
+    }
+
+    // Deleters may release resources that push deleters themselves, so they are run without holding the lock
+    for (auto& deleter : deleters) {
+      std::invoke(deleter);
+    }
+
+    deleters.clear();
+
+    // Hand the storage back so the frame does not allocate again the next time it is recorded
+    auto lock = std::scoped_lock{_mutex};
+
+    if (_frames[frame].empty()) {
+      std::swap(deleters, _frames[frame]);
+    }
+  }
+
+  /**
+   * @brief Runs all pending deleters, oldest frame first. Must only be called while the device is idle.
+   */
+  auto flush_all() -> void {
+    while (!_is_empty()) {
+      const auto current_frame = _current_frame;
+
+      for (auto i = 1u; i <= swapchain::max_frames_in_flight; ++i) {
+        flush((current_frame + i) % swapchain::max_frames_in_flight);
+      }
+    }
+  }
+
+private:
+
+  auto _is_empty() -> bool {
+    auto lock = std::scoped_lock{_mutex};
+
+    for (const auto& deleters : _frames) {
+      if (!deleters.empty()) {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  std::mutex _mutex;
+  std::uint32_t _current_frame{0u};
+  std::array<std::vector<deleter_type>, swapchain::max_frames_in_flight> _frames;
+
+}; // class deletion_queue
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_DELETION_QUEUE_HPP_
@@ -0,0 +1,169 @@
+#include <libsbx/graphics/descriptor/bindless_table.hpp>
+
+#include <array>
+
+#include <libsbx/utility/assert.hpp>
+#include <libsbx/utility/exception.hpp>
+
+#include <libsbx/core/engine.hpp>
+
+#include <libsbx/graphics/graphics_module.hpp>
+
+namespace sbx::graphics {
+
+static constexpr auto bindless_binding_flags = VkDescriptorBindingFlags{VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT};
+
+auto bindless_table::is_supported(const logical_device& logical_device) -> bool {
+  const auto& features = logical_device.enabled_features().vulkan12;
+
+  return features.runtimeDescriptorArray
+    && features.descriptorBindingPartiallyBound
+    && features.descriptorBindingSampledImageUpdateAfterBind
+    && features.descriptorBindingStorageBufferUpdateAfterBind
+    && features.descriptorBindingUpdateUnusedWhilePending
+    && features.shaderSampledImageArrayNonUniformIndexing
+    && features.shaderStorageBufferArrayNonUniformIndexing;
+}
+
+auto bindless_table::create_descriptor_set_layout() -> VkDescriptorSetLayout {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto bindings = std::array<VkDescriptorSetLayoutBinding, 2u>{
+    VkDescriptorSetLayoutBinding{image_binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, max_images, VK_SHADER_STAGE_ALL, nullptr},
+    VkDescriptorSetLayoutBinding{buffer_binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, max_buffers, VK_SHADER_STAGE_ALL, nullptr}
+  };
+
+  const auto binding_flags = std::array<VkDescriptorBindingFlags, 2u>{bindless_binding_flags, bindless_binding_flags};
+
+  return graphics_module.descriptor_layout_cache().get_or_create(bindings, binding_flags, VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT);
+}
+
+bindless_table::slot_allocator::slot_allocator(const handle_type capacity, graphics::deletion_queue& deletion_queue)
+: _deletion_queue{deletion_queue},
+  _next_handle{0u},
+  _capacity{capacity} { }
+
+auto bindless_table::slot_allocator::allocate() -> handle_type {
+  auto lock = std::scoped_lock{_mutex};
+
+  if (!_free_handles.empty()) {
+    const auto handle = _free_handles.back();
+    _free_handles.pop_back();
+
+    return handle;
+  }
+
+  if (_next_handle == _capacity) {
+    throw utility::runtime_error{"Bindless table is full ({} entries)", _capacity};
+  }
+
+  return _next_handle++;
+}
+
+auto bindless_table::slot_allocator::release(const handle_type handle) -> void {
+  utility::assert_that(handle < _capacity, "Invalid bindless handle");
+
+  // Command buffers still in flight may index the slot, so it is handed out again only once they finished. The slot is left partially bound.
+  _deletion_queue.push([this, handle]() {
+    auto lock = std::scoped_lock{_mutex};
+
+    _free_handles.push_back(handle);
+  });
+}
+
+bindless_table::bindless_table(const logical_device& logical_device, graphics::deletion_queue& deletion_queue, VkDescriptorSetLayout layout)
+: _logical_device{logical_device},
+  _descriptor_set_layout{layout},
+  _descriptor_pool{VK_NULL_HANDLE},
+  _descriptor_set{VK_NULL_HANDLE},
+  _images{max_images, deletion_queue},
+  _buffers{max_buffers, deletion_queue} {
+  if (!is_supported(_logical_device)) {
+    throw utility::runtime_error{"Selected GPU does not support the features needed by the bindless table"};
+  }
+
+  const auto descriptor_pool_sizes = std::array<VkDescriptorPoolSize, 2u>{
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, max_images},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, max_buffers}
+  };
+
+  auto descriptor_pool_create_info = VkDescriptorPoolCreateInfo{};
+  descriptor_pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  descriptor_pool_create_info.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+  descriptor_pool_create_info.poolSizeCount = static_cast<std::uint32_t>(descriptor_pool_sizes.size());
+  descriptor_pool_create_info.pPoolSizes = descriptor_pool_sizes.data();
+  descriptor_pool_create_info.maxSets = 1u;
+
+  validate(vkCreateDescriptorPool(_logical_device, &descriptor_pool_create_info, nullptr, &_descriptor_pool));
+
+  auto descriptor_set_allocate_info = VkDescriptorSetAllocateInfo{};
+  descriptor_set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  descriptor_set_allocate_info.descriptorPool = _descriptor_pool;
+  descriptor_set_allocate_info.descriptorSetCount = 1u;
+  descriptor_set_allocate_info.pSetLayouts = &_descriptor_set_layout;
+
+  validate(vkAllocateDescriptorSets(_logical_device, &descriptor_set_allocate_info, &_descriptor_set));
+}
+
+bindless_table::~bindless_table() {
+  // The layout is owned by the descriptor layout cache
+  vkDestroyDescriptorPool(_logical_device, _descriptor_pool, nullptr);
+}
+
+auto bindless_table::add_image(const descriptor& descriptor) -> handle_type {
+  const auto handle = _images.allocate();
+
+  _write(image_binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, handle, descriptor);
+
+  return handle;
+}
+
+auto bindless_table::add_buffer(const descriptor& descriptor) -> handle_type {
+  const auto handle = _buffers.allocate();
+
+  _write(buffer_binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, handle, descriptor);
+
+  return handle;
+}
+
+auto bindless_table::update_image(const handle_type handle, const descriptor& descriptor) -> void {
+  utility::assert_that(handle < _images.capacity(), "Invalid bindless image handle");
+
+  _write(image_binding, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, handle, descriptor);
+}
+
+auto bindless_table::update_buffer(const handle_type handle, const descriptor& descriptor) -> void {
+  utility::assert_that(handle < _buffers.capacity(), "Invalid bindless buffer handle");
+
+  _write(buffer_binding, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, handle, descriptor);
+}
+
+auto bindless_table::remove_image(const handle_type handle) -> void {
+  _images.release(handle);
+}
+
+auto bindless_table::remove_buffer(const handle_type handle) -> void {
+  _buffers.release(handle);
+}
+
+auto bindless_table::bind(command_buffer& command_buffer, const pipeline& pipeline) const noexcept -> void {
+  vkCmdBindDescriptorSets(command_buffer, pipeline.bind_point(), pipeline.layout(), set, 1u, &_descriptor_set, 0u, nullptr);
+}
+
+auto bindless_table::_write(const std::uint32_t binding, VkDescriptorType descriptor_type, const handle_type handle, const descriptor& descriptor) -> void {
+  const auto write_descriptor_set = descriptor.write_descriptor_set(binding, descriptor_type);
+
+  utility::assert_that(write_descriptor_set.handle().descriptorCount == 1u, "Bindless table entries must hold a single descriptor");
+
+  auto write = write_descriptor_set.handle();
+  write.dstSet = _descriptor_set;
+  write.dstArrayElement = handle;
+
+  // Writes to different slots of an update after bind set do not need to be synchronized with command buffers that are recorded or pending,
+  // but updates of the set itself have to be synchronized on the host
+  auto lock = std::scoped_lock{_mutex};
+
+  vkUpdateDescriptorSets(_logical_device, 1u, &write, 0u, nullptr);
+}
+
+} // namespace sbx::graphics
@@ -0,0 +1,150 @@
+#ifndef LIBSBX_GRAPHICS_DESCRIPTOR_BINDLESS_TABLE_HPP_
+#define LIBSBX_GRAPHICS_DESCRIPTOR_BINDLESS_TABLE_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <mutex>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/utility/noncopyable.hpp>
+
+#include <libsbx/graphics/deletion_queue.hpp>
+
+#include <libsbx/graphics/devices/logical_device.hpp>
+
+#include <libsbx/graphics/commands/command_buffer.hpp>
+
+#include <libsbx/graphics/pipeline/pipeline.hpp>
+
+#include <libsbx/graphics/descriptor/descriptor.hpp>
+
+namespace sbx::graphics {
+
+/**
+ * @brief A single descriptor set holding large arrays of images and storage buffers, indexed by handles that stay valid across frames.
+ *
+ * Shaders declare the arrays in set bindless_table::set:
+ *
+ * [[vk::binding(0, 3)]] Sampler2D images[];
+ * [[vk::binding(1, 3)]] StructuredBuffer<Type> buffers[];
+ *
+ * Pipelines use the layout of the table for that set, so the table is bound once per command buffer instead of writing descriptors per draw.
+ * Entries can be added and removed while the set is bound. Removed handles are reused only after the frames in flight that might still read them
+ * finished. Entries can be added and removed from multiple threads.
+ */
+class bindless_table final : public utility::noncopyable {
+
+public:
+
+  using handle_type = std::uint32_t;
+
+  inline static constexpr auto invalid_handle = std::numeric_limits<handle_type>::max();
+
+  inline static constexpr auto set = std::uint32_t{3u};
+
+  inline static constexpr auto image_binding = std::uint32_t{0u};
+  inline static constexpr auto buffer_binding = std::uint32_t{1u};
+
+  inline static constexpr auto max_images = std::uint32_t{16384u};
+  inline static constexpr auto max_buffers = std::uint32_t{4096u};
+
+  /**
+   * @brief Hands out the handles of one binding. Released handles are handed out again only after the deletion queue flushed them.
+   */
+  class slot_allocator final : public utility::noncopyable {
+
+  public:
+
+    slot_allocator(const handle_type capacity, graphics::deletion_queue& deletion_queue);
+
+    /**
+     * @brief Returns a free handle. Throws if all handles are in use.
+     */
+    auto allocate() -> handle_type;
+
+    /**
+     * @brief Releases the handle once the frames in flight that might still read it finished.
+     */
+    auto release(const handle_type handle) -> void;
+
+    auto capacity() const noexcept -> handle_type {
+      return _capacity;
+    }
+
+  private:
+
+    graphics::deletion_queue& _deletion_queue;
+    std::vector<handle_type> _free_handles;
+    handle_type _next_handle;
+    handle_type _capacity;
+    std::mutex _mutex;
+
+  }; // class slot_allocator
+
+  /**
+   * @brief Returns true if the device was created with the features the table needs.
+   */
+  static auto is_supported(const logical_device& logical_device) -> bool;
+
+  bindless_table(const logical_device& logical_device, graphics::deletion_queue& deletion_queue, VkDescriptorSetLayout layout);
+
+  ~bindless_table();
+
+  /**
+   * @brief Creates the layout of the table. The layout is shared through the descriptor layout cache of the module.
+   */
+  static auto create_descriptor_set_layout() -> VkDescriptorSetLayout;
+
+  /**
+   * @brief Writes the combined image sampler of the descriptor into a free slot and returns its handle.
+   */
+  auto add_image(const descriptor& descriptor) -> handle_type;
+
+  /**
+   * @brief Writes the storage buffer of the descriptor into a free slot and returns its handle.
+   */
+  auto add_buffer(const descriptor& descriptor) -> handle_type;
+
+  /**
+   * @brief Rewrites the slot of handle, e.g. after the resource has been recreated. The handle stays the same.
+   */
+  auto update_image(const handle_type handle, const descriptor& descriptor) -> void;
+
+  auto update_buffer(const handle_type handle, const descriptor& descriptor) -> void;
+
+  auto remove_image(const handle_type handle) -> void;
+
+  auto remove_buffer(const handle_type handle) -> void;
+
+  auto descriptor_set_layout() const noexcept -> VkDescriptorSetLayout {
+    return _descriptor_set_layout;
+  }
+
+  auto descriptor_set() const noexcept -> VkDescriptorSet {
+    return _descriptor_set;
+  }
+
+  auto bind(command_buffer& command_buffer, const pipeline& pipeline) const noexcept -> void;
+
+private:
+
+  auto _write(const std::uint32_t binding, VkDescriptorType descriptor_type, const handle_type handle, const descriptor& descriptor) -> void;
+
+  const logical_device& _logical_device;
+
+  VkDescriptorSetLayout _descriptor_set_layout;
+  VkDescriptorPool _descriptor_pool;
+  VkDescriptorSet _descriptor_set;
+
+  slot_allocator _images;
+  slot_allocator _buffers;
+  // Guards updates of the set
+  std::mutex _mutex;
+
+}; // class bindless_table
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_DESCRIPTOR_BINDLESS_TABLE_HPP_
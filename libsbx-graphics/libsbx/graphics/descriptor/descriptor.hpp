@@ -3,6 +3,7 @@
 
 #include <variant>
 #include <memory>
+#include <atomic>
 #include <cinttypes>
 
 #include <vulkan/vulkan.hpp>
@@ -38,12 +39,33 @@ class descriptor {
 
 public:
 
-  descriptor() = default;
+  descriptor()
+  : _descriptor_id{next_descriptor_id()} { }
 
   virtual ~descriptor() = default;
 
   virtual auto write_descriptor_set(std::uint32_t binding, VkDescriptorType descriptor_type) const noexcept -> graphics::write_descriptor_set = 0;
 
+  /**
+   * @brief Identifies the resources the descriptor currently refers to.
+   *
+   * Descriptors that recreate their resources in place return a new id afterwards. Cached descriptor sets are keyed by this id together with the
+   * Vulkan handles, since the driver is free to hand out the handle of a destroyed resource again.
+   */
+  virtual auto descriptor_id() const noexcept -> std::uint64_t {
+    return _descriptor_id;
+  }
+
+  static auto next_descriptor_id() noexcept -> std::uint64_t {
+    static auto next_id = std::atomic<std::uint64_t>{1u};
+
+    return next_id.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+private:
+
+  std::uint64_t _descriptor_id;
+
 }; // class descriptor
 
 } // namespace sbx::graphics
@@ -1,5 +1,10 @@
 #include <libsbx/graphics/descriptor/descriptor_handler.hpp>
 
+#include <range/v3/all.hpp>
+
+#include <libsbx/utility/assert.hpp>
+#include <libsbx/utility/exception.hpp>
+
 #include <libsbx/graphics/graphics_module.hpp>
 
 namespace sbx::graphics {
@@ -28,87 +33,217 @@ descriptor_handler::descriptor_handler(const graphics_pipeline_handle& handle, s
   _recreate_descriptor_sets();
 }
 
-descriptor_handler::~descriptor_handler() {
-  for (auto& descriptor_set : _descriptor_sets) {
-    descriptor_set.reset();
+// The descriptor sets are owned by the descriptor set cache of the module
+descriptor_handler::~descriptor_handler() = default;
+
+auto descriptor_handler::slot(const std::string& name) -> binding_slot {
+  if (auto entry = _slot_indices.find(name); entry != _slot_indices.end()) {
+    return binding_slot{entry->second};
   }
+
+  const auto index = static_cast<std::uint32_t>(_slots.size());
+
+  _slots.push_back(slot_data{name, std::nullopt, VK_DESCRIPTOR_TYPE_MAX_ENUM, std::nullopt});
+  _slot_indices.emplace(name, index);
+
+  return binding_slot{index};
 }
 
 auto descriptor_handler::push(const std::string& name, uniform_handler& uniform_handler) -> void {
+  push(slot(name), uniform_handler);
+}
+
+auto descriptor_handler::push(const binding_slot& slot, uniform_handler& uniform_handler) -> void {
   if (_pipeline) {
-    uniform_handler.update(_pipeline->descriptor_block(name, _set));
-    _push(name, uniform_handler.uniform_buffer());
+    uniform_handler.update(_descriptor_block(_resolve(slot)));
+    push(slot, uniform_handler.uniform_buffer());
   }
 }
 
 auto descriptor_handler::push(const std::string& name, storage_handler& storage_handler) -> void {
+  push(slot(name), storage_handler);
+}
+
+auto descriptor_handler::push(const binding_slot& slot, storage_handler& storage_handler) -> void {
   if (_pipeline) {
-    storage_handler.update(_pipeline->descriptor_block(name, _set));
-    _push(name, storage_handler.storage_buffer());
+    storage_handler.update(_descriptor_block(_resolve(slot)));
+    push(slot, storage_handler.storage_buffer());
   }
 }
 
 auto descriptor_handler::bind_descriptors(command_buffer& command_buffer) -> void {
-  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
-
-  const auto current_frame = graphics_module.current_frame();
+  if (!_pipeline || _descriptor_set == VK_NULL_HANDLE) {
+    return;
+  }
 
-  _descriptor_sets[current_frame]->bind(command_buffer);
+  vkCmdBindDescriptorSets(command_buffer, _pipeline->bind_point(), _pipeline->layout(), _set, 1u, &_descriptor_set, 0u, nullptr);
 }
 
 auto descriptor_handler::descriptor_set() const noexcept -> VkDescriptorSet {
-  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
-
-  const auto current_frame = graphics_module.current_frame();
-
-  return *_descriptor_sets[current_frame];
+  return _descriptor_set;
 }
 
 auto descriptor_handler::update(const pipeline& pipeline) -> bool {
   if (_pipeline.get() != &pipeline) {
     _pipeline = &pipeline;
 
-    _descriptors.clear();
-
     _recreate_descriptor_sets();
 
     return false;
   }
 
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  auto& descriptor_set_cache = graphics_module.descriptor_set_cache();
+
   if (_has_changed) {
-    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+    _resources.clear();
 
-    const auto current_frame = graphics_module.current_frame();
+    for (const auto& descriptor : _descriptors) {
+      if (descriptor.write_descriptor_set) {
+        _resources.insert(_resources.end(), descriptor.resources.begin(), descriptor.resources.end());
+      }
+    }
 
-    auto& descriptor_set = _descriptor_sets[current_frame];
+    _resource_hash = descriptor_set_cache::hash(_resources);
+    _descriptor_set = VK_NULL_HANDLE;
+    _has_changed = false;
+  }
 
+  // The set is looked up once per frame, which keeps it from being evicted while it is in use
+  if (_descriptor_set != VK_NULL_HANDLE && _descriptor_set_frame == descriptor_set_cache.frame()) {
+    return true;
+  }
+
+  _descriptor_set = descriptor_set_cache.find(_descriptor_set_layout, _resource_hash, _resources);
+
+  if (_descriptor_set == VK_NULL_HANDLE) {
     auto write_descriptor_sets = std::vector<VkWriteDescriptorSet>{};
     write_descriptor_sets.reserve(_descriptors.size());
 
-    for (const auto& [name, descriptor] : _descriptors) {
-      auto write_descriptor_set = descriptor.write_descriptor_set.handle();
-      write_descriptor_set.dstSet = *descriptor_set;
+    for (const auto& descriptor : _descriptors) {
+      if (descriptor.write_descriptor_set) {
+        write_descriptor_sets.push_back(descriptor.write_descriptor_set->handle());
+      }
+    }
+
+    _descriptor_set = descriptor_set_cache.emplace(_descriptor_set_layout, _resource_hash, _resources, _variable_descriptor_count, write_descriptor_sets);
+  }
+
+  _descriptor_set_frame = descriptor_set_cache.frame();
+
+  return true;
+}
+
+template<typename Handle>
+static auto _handle_bits(Handle handle) noexcept -> std::uint64_t {
+  // Non-dispatchable handles are pointers on 64 bit platforms and integers everywhere else
+  if constexpr (std::is_pointer_v<Handle>) {
+    return reinterpret_cast<std::uintptr_t>(handle);
+  } else {
+    return handle;
+  }
+}
+
+auto descriptor_handler::_encode(const std::uint64_t descriptor_id, const VkWriteDescriptorSet& write_descriptor_set, std::vector<std::uint64_t>& resources) -> void {
+  resources.insert(resources.end(), {
+    descriptor_id,
+    write_descriptor_set.dstBinding,
+    write_descriptor_set.dstArrayElement,
+    write_descriptor_set.descriptorCount,
+    static_cast<std::uint64_t>(write_descriptor_set.descriptorType)
+  });
+
+  if (write_descriptor_set.pImageInfo) {
+    for (auto i = 0u; i < write_descriptor_set.descriptorCount; ++i) {
+      const auto& image_info = write_descriptor_set.pImageInfo[i];
 
-      write_descriptor_sets.push_back(write_descriptor_set);
+      resources.insert(resources.end(), {_handle_bits(image_info.sampler), _handle_bits(image_info.imageView), static_cast<std::uint64_t>(image_info.imageLayout)});
     }
+  }
 
-    graphics::descriptor_set::update(write_descriptor_sets);
+  if (write_descriptor_set.pBufferInfo) {
+    for (auto i = 0u; i < write_descriptor_set.descriptorCount; ++i) {
+      const auto& buffer_info = write_descriptor_set.pBufferInfo[i];
 
-    _has_changed = false;
+      resources.insert(resources.end(), {_handle_bits(buffer_info.buffer), buffer_info.offset, buffer_info.range});
+    }
   }
+}
 
+auto descriptor_handler::_resolve(const binding_slot& slot) -> slot_data& {
+  utility::assert_that(slot._index < _slots.size(), "Invalid descriptor slot");
 
-  return true;
+  auto& slot_data = _slots[slot._index];
+
+  if (slot_data.binding) {
+    return slot_data;
+  }
+
+  const auto binding = _pipeline->find_descriptor_binding(slot_data.name, _set);
+
+  if (!binding) {
+    throw utility::runtime_error{"Failed to find descriptor binding for descriptor '{}'", slot_data.name};
+  }
+
+  const auto descriptor_type = _pipeline->find_descriptor_type_at_binding(_set, *binding);
+
+  if (!descriptor_type) {
+    throw utility::runtime_error{"Failed to find descriptor type for descriptor '{}' set: {} binding {}", slot_data.name, _set, *binding};
+  }
+
+  slot_data.binding = *binding;
+  slot_data.descriptor_type = *descriptor_type;
+
+  return slot_data;
+}
+
+auto descriptor_handler::_descriptor_block(slot_data& slot_data) -> const std::optional<shader::uniform_block>& {
+  if (!slot_data.uniform_block) {
+    slot_data.uniform_block = _pipeline->descriptor_block(slot_data.name, _set);
+  }
+
+  return slot_data.uniform_block;
+}
+
+auto descriptor_handler::_set_descriptor(const std::uint32_t binding, const std::uint64_t descriptor_id, graphics::write_descriptor_set&& write_descriptor_set) -> void {
+  if (binding >= _descriptors.size()) {
+    _descriptors.resize(binding + 1u);
+  }
+
+  auto& entry = _descriptors[binding];
+
+  _pushed_resources.clear();
+  _encode(descriptor_id, write_descriptor_set.handle(), _pushed_resources);
+
+  // Pushing the same resources again is the common case, it must not cause the set to be looked up or written again
+  if (entry.write_descriptor_set && entry.resources == _pushed_resources) {
+    return;
+  }
+
+  entry.write_descriptor_set = std::move(write_descriptor_set);
+  std::swap(entry.resources, _pushed_resources);
+
+  _has_changed = true;
 }
 
 auto descriptor_handler::_recreate_descriptor_sets() -> void {
+  // Slots keep their names, their bindings are resolved against the new pipeline on the next push
+  for (auto& slot_data : _slots) {
+    slot_data.binding.reset();
+    slot_data.uniform_block.reset();
+  }
+
+  const auto descriptor_counts = _pipeline->descriptor_counts(_set);
+
   _descriptors.clear();
+  _descriptors.resize(descriptor_counts.size());
 
-  for (auto& descriptor_set : _descriptor_sets) {
-    descriptor_set = std::make_unique<graphics::descriptor_set>(*_pipeline, _set);
-  }
+  _descriptor_set_layout = _pipeline->descriptor_set_layout(_set);
+  _variable_descriptor_count = ranges::any_of(descriptor_counts, [](const auto& count) { return count > 1u; }) ? 32u : 0u;
 
-  _has_changed = false;
+  _descriptor_set = VK_NULL_HANDLE;
+  _has_changed = true;
 }
 
 } // namespace sbx::graphics
@@ -3,8 +3,10 @@
 
 #include <memory>
 #include <map>
+#include <string>
 #include <vector>
 #include <optional>
+#include <unordered_map>
 
 #include <libsbx/memory/observer_ptr.hpp>
 
@@ -18,10 +20,18 @@
 #include <libsbx/graphics/pipeline/graphics_pipeline.hpp>
 
 #include <libsbx/graphics/descriptor/descriptor.hpp>
-#include <libsbx/graphics/descriptor/descriptor_set.hpp>
 
 namespace sbx::graphics {
 
+/**
+ * @brief Collects the descriptors of one set and binds a matching descriptor set.
+ *
+ * Descriptors are stored per binding together with the handles of the resources they refer to. Pushing the same resources again does not change
+ * anything, and the written descriptor sets are shared through the descriptor set cache of the module, so sets are only written when a new
+ * combination of resources is bound.
+ *
+ * Descriptors can be pushed by name or by a slot that was resolved once with slot(). Pushing by slot does no string lookups.
+ */
 class descriptor_handler {
 
 public:
@@ -29,6 +39,26 @@ public:
   inline static constexpr auto global_set_id = std::uint32_t{0u};
   inline static constexpr auto per_draw_call_set_id = std::uint32_t{1u};
 
+  /**
+   * @brief Pre-resolved binding of a named descriptor. Slots stay valid when the handler switches to another pipeline.
+   */
+  class binding_slot {
+
+    friend class descriptor_handler;
+
+  public:
+
+    binding_slot() = default;
+
+  private:
+
+    explicit binding_slot(const std::uint32_t index)
+    : _index{index} { }
+
+    std::uint32_t _index{0u};
+
+  }; // class binding_slot
+
   descriptor_handler(std::uint32_t set);
 
   explicit descriptor_handler(const pipeline& pipeline, std::uint32_t set);
@@ -37,35 +67,59 @@ public:
 
   ~descriptor_handler();
 
+  /**
+   * @brief Returns the slot of the descriptor with the given name. Meant to be called once, e.g. when the renderer is created.
+   */
+  auto slot(const std::string& name) -> descriptor_handler::binding_slot;
+
   template<typename Descriptor>
   requires (std::is_base_of_v<descriptor, Descriptor>)
   auto push(const std::string& name, const Descriptor& descriptor) -> void {
-    if (_pipeline) {
-      _push(name, descriptor);
-    }
+    push(slot(name), descriptor);
   }
 
   template<typename Descriptor>
   requires (std::is_base_of_v<descriptor, Descriptor>)
-  auto push(const std::string& name, const Descriptor& descriptor, write_descriptor_set&& write_descriptor_set) -> void {
+  auto push(const descriptor_handler::binding_slot& slot, const Descriptor& descriptor) -> void {
     if (!_pipeline) {
       return;
     }
 
-    auto binding = _pipeline->find_descriptor_binding(name, _set);
+    const auto& slot_data = _resolve(slot);
+
+    auto write_descriptor_set = descriptor.write_descriptor_set(*slot_data.binding, slot_data.descriptor_type);
+
+    if (write_descriptor_set) {
+      _set_descriptor(*slot_data.binding, descriptor.descriptor_id(), std::move(write_descriptor_set));
+    }
+  }
+
+  template<typename Descriptor>
+  requires (std::is_base_of_v<descriptor, Descriptor>)
+  auto push(const std::string& name, const Descriptor& descriptor, write_descriptor_set&& write_descriptor_set) -> void {
+    push(slot(name), descriptor, std::move(write_descriptor_set));
+  }
 
-    if (!binding) {
-      throw std::runtime_error(fmt::format("Failed to find descriptor binding for descriptor '{}'", name));
+  template<typename Descriptor>
+  requires (std::is_base_of_v<descriptor, Descriptor>)
+  auto push(const descriptor_handler::binding_slot& slot, const Descriptor& descriptor, write_descriptor_set&& write_descriptor_set) -> void {
+    if (!_pipeline) {
+      return;
     }
 
-    _descriptors.insert_or_assign(name, descriptor_entry{std::addressof(descriptor), std::move(write_descriptor_set), *binding});
-    _has_changed = true;
+    const auto& slot_data = _resolve(slot);
+
+    _set_descriptor(*slot_data.binding, descriptor.descriptor_id(), std::move(write_descriptor_set));
   }
 
   auto push(const std::string& name, uniform_handler& uniform_handler) -> void;
 
+  auto push(const descriptor_handler::binding_slot& slot, uniform_handler& uniform_handler) -> void;
+
   auto push(const std::string& name, storage_handler& storage_handler) -> void;
 
+  auto push(const descriptor_handler::binding_slot& slot, storage_handler& storage_handler) -> void;
+
   auto bind_descriptors(command_buffer& command_buffer) -> void;
 
   auto descriptor_set() const noexcept -> VkDescriptorSet;
@@ -74,36 +128,29 @@ public:
 
 private:
 
+  struct slot_data {
+    std::string name;
+    // Resolved against the current pipeline on first use
+    std::optional<std::uint32_t> binding;
+    VkDescriptorType descriptor_type;
+    std::optional<shader::uniform_block> uniform_block;
+  }; // struct slot_data
+
   struct descriptor_entry {
-    memory::observer_ptr<const graphics::descriptor> descriptor;
-    graphics::write_descriptor_set write_descriptor_set;
-    std::uint32_t binding;
+    std::optional<graphics::write_descriptor_set> write_descriptor_set;
+    std::vector<std::uint64_t> resources;
   }; // struct descriptor_entry
 
-  template<typename Descriptor>
-  requires (std::is_base_of_v<descriptor, Descriptor>)
-  auto _push(const std::string& name, const Descriptor& descriptor) -> void {
-    auto binding = _pipeline->find_descriptor_binding(name, _set);
+  /**
+   * @brief Appends the words that identify the write to resources: the descriptor id, the binding, the descriptor type and the handles of all infos.
+   */
+  static auto _encode(const std::uint64_t descriptor_id, const VkWriteDescriptorSet& write_descriptor_set, std::vector<std::uint64_t>& resources) -> void;
 
-    if (!binding) {
-      throw std::runtime_error(fmt::format("Failed to find descriptor binding for descriptor '{}'", name));
-    }
+  auto _resolve(const binding_slot& slot) -> slot_data&;
 
-    auto descriptor_type = _pipeline->find_descriptor_type_at_binding(_set, *binding);
+  auto _descriptor_block(slot_data& slot_data) -> const std::optional<shader::uniform_block>&;
 
-    if (!descriptor_type) {
-
-      throw std::runtime_error(fmt::format("Failed to find descriptor type for descriptor '{}' set: {} binding {}", name, _set, *binding));
-    }
-
-    auto write_descriptor_set = descriptor.write_descriptor_set(*binding, *descriptor_type);
-
-    if (write_descriptor_set) {
-      _descriptors.insert_or_assign(name, descriptor_entry{std::addressof(descriptor), std::move(write_descriptor_set), *binding});
-      _has_changed = true;
-    }
-
-  }
+  auto _set_descriptor(const std::uint32_t binding, const std::uint64_t descriptor_id, graphics::write_descriptor_set&& write_descriptor_set) -> void;
 
   auto _recreate_descriptor_sets() -> void;
 
@@ -111,11 +158,24 @@ private:
 
   memory::observer_ptr<const pipeline> _pipeline;
 
-  std::array<std::unique_ptr<graphics::descriptor_set>, graphics::swapchain::max_frames_in_flight> _descriptor_sets{};
+  std::vector<slot_data> _slots{};
+  std::unordered_map<std::string, std::uint32_t> _slot_indices{};
 
-  std::map<std::string, descriptor_entry> _descriptors{};
+  // Indexed by binding
+  std::vector<descriptor_entry> _descriptors{};
   bool _has_changed{};
 
+  VkDescriptorSetLayout _descriptor_set_layout{VK_NULL_HANDLE};
+  std::uint32_t _variable_descriptor_count{0u};
+
+  // Resources of all bindings, the key of the set in the descriptor set cache
+  std::vector<std::uint64_t> _resources{};
+  std::uint64_t _resource_hash{0u};
+  // Reused by every push, so pushing the same resources again does not allocate
+  std::vector<std::uint64_t> _pushed_resources{};
+  VkDescriptorSet _descriptor_set{VK_NULL_HANDLE};
+  std::uint64_t _descriptor_set_frame{0u};
+
 }; // class descriptor_handler
 
 } // namespace sbx::graphics
@@ -0,0 +1,95 @@
+#include <libsbx/graphics/descriptor/descriptor_layout_cache.hpp>
+
+#include <algorithm>
+
+#include <libsbx/utility/hash.hpp>
+#include <libsbx/utility/assert.hpp>
+
+#include <libsbx/graphics/graphics_module.hpp>
+
+namespace sbx::graphics {
+
+descriptor_layout_cache::descriptor_layout_cache(const logical_device& logical_device)
+: _logical_device{logical_device} { }
+
+descriptor_layout_cache::~descriptor_layout_cache() {
+  for (const auto& [key, layout] : _layouts) {
+    vkDestroyDescriptorSetLayout(_logical_device, layout, nullptr);
+  }
+}
+
+auto descriptor_layout_cache::get_or_create(std::span<const VkDescriptorSetLayoutBinding> bindings, std::span<const VkDescriptorBindingFlags> binding_flags, VkDescriptorSetLayoutCreateFlags flags) -> VkDescriptorSetLayout {
+  utility::assert_that(binding_flags.empty() || binding_flags.size() == bindings.size(), "Binding flags must be empty or match the bindings");
+
+  auto key = layout_key{};
+  key.bindings.reserve(bindings.size());
+  key.flags = flags;
+
+  for (auto i = 0u; i < bindings.size(); ++i) {
+    const auto& binding = bindings[i];
+
+    utility::assert_that(binding.pImmutableSamplers == nullptr, "Immutable samplers are not supported by the descriptor layout cache");
+
+    key.bindings.push_back(binding_key{binding.binding, binding.descriptorType, binding.descriptorCount, binding.stageFlags, binding_flags.empty() ? 0u : binding_flags[i]});
+  }
+
+  // The order of the bindings does not matter to Vulkan, so the key is sorted to match reflection data that is iterated in any order
+  std::ranges::sort(key.bindings, [](const auto& lhs, const auto& rhs) { return lhs.binding < rhs.binding; });
+
+  auto lock = std::scoped_lock{_mutex};
+
+  if (auto entry = _layouts.find(key); entry != _layouts.end()) {
+    return entry->second;
+  }
+
+  auto layout_bindings = std::vector<VkDescriptorSetLayoutBinding>{};
+  layout_bindings.reserve(key.bindings.size());
+
+  auto layout_binding_flags = std::vector<VkDescriptorBindingFlags>{};
+  layout_binding_flags.reserve(key.bindings.size());
+
+  for (const auto& binding : key.bindings) {
+    layout_bindings.push_back(VkDescriptorSetLayoutBinding{binding.binding, binding.descriptor_type, binding.descriptor_count, binding.stage_flags, nullptr});
+    layout_binding_flags.push_back(binding.binding_flags);
+  }
+
+  auto descriptor_set_layout_binding_flags_create_info = VkDescriptorSetLayoutBindingFlagsCreateInfo{};
+  descriptor_set_layout_binding_flags_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+  descriptor_set_layout_binding_flags_create_info.bindingCount = static_cast<std::uint32_t>(layout_binding_flags.size());
+  descriptor_set_layout_binding_flags_create_info.pBindingFlags = layout_binding_flags.data();
+
+  auto descriptor_set_layout_create_info = VkDescriptorSetLayoutCreateInfo{};
+  descriptor_set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+  descriptor_set_layout_create_info.pNext = &descriptor_set_layout_binding_flags_create_info;
+  descriptor_set_layout_create_info.flags = key.flags;
+  descriptor_set_layout_create_info.bindingCount = static_cast<std::uint32_t>(layout_bindings.size());
+  descriptor_set_layout_create_info.pBindings = layout_bindings.data();
+
+  auto layout = VkDescriptorSetLayout{};
+
+  validate(vkCreateDescriptorSetLayout(_logical_device, &descriptor_set_layout_create_info, nullptr, &layout));
+
+  _layouts.emplace(std::move(key), layout);
+
+  return layout;
+}
+
+auto descriptor_layout_cache::size() const -> std::size_t {
+  auto lock = std::scoped_lock{_mutex};
+
+  return _layouts.size();
+}
+
+auto descriptor_layout_cache::layout_key_hash::operator()(const layout_key& key) const noexcept -> std::size_t {
+  auto hash = std::size_t{0u};
+
+  utility::hash_combine(hash, key.flags, key.bindings.size());
+
+  for (const auto& binding : key.bindings) {
+    utility::hash_combine(hash, binding.binding, static_cast<std::uint32_t>(binding.descriptor_type), binding.descriptor_count, binding.stage_flags, binding.binding_flags);
+  }
+
+  return hash;
+}
+
+} // namespace sbx::graphics
@@ -0,0 +1,73 @@
+#ifndef LIBSBX_GRAPHICS_DESCRIPTOR_DESCRIPTOR_LAYOUT_CACHE_HPP_
+#define LIBSBX_GRAPHICS_DESCRIPTOR_DESCRIPTOR_LAYOUT_CACHE_HPP_
+
+#include <span>
+#include <vector>
+#include <mutex>
+#include <unordered_map>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/utility/noncopyable.hpp>
+
+#include <libsbx/graphics/devices/logical_device.hpp>
+
+namespace sbx::graphics {
+
+/**
+ * @brief Deduplicates descriptor set layouts. Pipelines with the same bindings in a set share the same VkDescriptorSetLayout.
+ *
+ * Layouts are owned by the cache and live until it is destroyed. Layouts can be requested from multiple threads.
+ */
+class descriptor_layout_cache final : public utility::noncopyable {
+
+public:
+
+  descriptor_layout_cache(const logical_device& logical_device);
+
+  ~descriptor_layout_cache();
+
+  /**
+   * @brief Returns the layout for the bindings and creates it on first use.
+   *
+   * @param bindings Bindings of the set in any order
+   * @param binding_flags Either empty or one entry per binding in the same order as bindings
+   * @param flags Create flags of the layout
+   */
+  auto get_or_create(std::span<const VkDescriptorSetLayoutBinding> bindings, std::span<const VkDescriptorBindingFlags> binding_flags = {}, VkDescriptorSetLayoutCreateFlags flags = 0u) -> VkDescriptorSetLayout;
+
+  auto size() const -> std::size_t;
+
+private:
+
+  struct binding_key {
+    std::uint32_t binding;
+    VkDescriptorType descriptor_type;
+    std::uint32_t descriptor_count;
+    VkShaderStageFlags stage_flags;
+    VkDescriptorBindingFlags binding_flags;
+
+    auto operator==(const binding_key& other) const noexcept -> bool = default;
+  }; // struct binding_key
+
+  struct layout_key {
+    std::vector<binding_key> bindings;
+    VkDescriptorSetLayoutCreateFlags flags;
+
+    auto operator==(const layout_key& other) const noexcept -> bool = default;
+  }; // struct layout_key
+
+  struct layout_key_hash {
+    auto operator()(const layout_key& key) const noexcept -> std::size_t;
+  }; // struct layout_key_hash
+
+  const logical_device& _logical_device;
+
+  std::unordered_map<layout_key, VkDescriptorSetLayout, layout_key_hash> _layouts;
+  mutable std::mutex _mutex;
+
+}; // class descriptor_layout_cache
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_DESCRIPTOR_DESCRIPTOR_LAYOUT_CACHE_HPP_
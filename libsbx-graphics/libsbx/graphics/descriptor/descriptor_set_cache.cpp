@@ -0,0 +1,196 @@
+#include <libsbx/graphics/descriptor/descriptor_set_cache.hpp>
+
+#include <array>
+#include <ranges>
+#include <algorithm>
+
+#include <libsbx/utility/hash.hpp>
+#include <libsbx/utility/logger.hpp>
+
+#include <libsbx/graphics/graphics_module.hpp>
+
+namespace sbx::graphics {
+
+descriptor_set_cache::descriptor_set_cache(const VkDevice& logical_device, graphics::deletion_queue& deletion_queue)
+: _logical_device{logical_device},
+  _deletion_queue{deletion_queue},
+  _frame{0u} { }
+
+descriptor_set_cache::~descriptor_set_cache() {
+  // Destroying the pools frees all sets allocated from them
+  for (const auto& pool : _pools) {
+    vkDestroyDescriptorPool(_logical_device, pool, nullptr);
+  }
+}
+
+auto descriptor_set_cache::hash(std::span<const std::uint64_t> resources) noexcept -> std::uint64_t {
+  return utility::xxhash64{}(std::span<const char>{reinterpret_cast<const char*>(resources.data()), resources.size_bytes()});
+}
+
+auto descriptor_set_cache::find(VkDescriptorSetLayout layout, std::uint64_t resource_hash, std::span<const std::uint64_t> resources) -> VkDescriptorSet {
+  auto& shard = _shard(resource_hash);
+
+  auto lock = std::shared_lock{shard.mutex};
+
+  if (auto entry = shard.sets.find(set_key_view{layout, resource_hash, resources}); entry != shard.sets.end()) {
+    entry->second.last_used_frame.store(frame(), std::memory_order_relaxed);
+
+    return entry->second.handle;
+  }
+
+  return VK_NULL_HANDLE;
+}
+
+auto descriptor_set_cache::emplace(VkDescriptorSetLayout layout, std::uint64_t resource_hash, std::span<const std::uint64_t> resources, std::uint32_t variable_descriptor_count, std::span<const VkWriteDescriptorSet> write_descriptor_sets) -> VkDescriptorSet {
+  auto& shard = _shard(resource_hash);
+
+  auto lock = std::scoped_lock{shard.mutex};
+
+  if (auto entry = shard.sets.find(set_key_view{layout, resource_hash, resources}); entry != shard.sets.end()) {
+    entry->second.last_used_frame.store(frame(), std::memory_order_relaxed);
+
+    return entry->second.handle;
+  }
+
+  const auto [handle, pool] = _allocate(layout, variable_descriptor_count);
+
+  auto writes = std::vector<VkWriteDescriptorSet>{write_descriptor_sets.begin(), write_descriptor_sets.end()};
+
+  for (auto& write : writes) {
+    write.dstSet = handle;
+  }
+
+  vkUpdateDescriptorSets(_logical_device, static_cast<std::uint32_t>(writes.size()), writes.data(), 0, nullptr);
+
+  shard.sets.try_emplace(set_key{layout, resource_hash, std::vector<std::uint64_t>{resources.begin(), resources.end()}}, handle, pool, frame());
+
+  return handle;
+}
+
+auto descriptor_set_cache::advance() -> void {
+  const auto current_frame = _frame.fetch_add(1u, std::memory_order_relaxed) + 1u;
+
+  if (current_frame <= max_unused_frames) {
+    return;
+  }
+
+  const auto logical_device = _logical_device;
+
+  for (auto& shard : _shards) {
+    auto lock = std::scoped_lock{shard.mutex};
+
+    // Sets referencing destroyed resources are never requested again, so they are freed here as well
+    for (auto entry = shard.sets.begin(); entry != shard.sets.end();) {
+      if (entry->second.last_used_frame.load(std::memory_order_relaxed) + max_unused_frames >= current_frame) {
+        ++entry;
+        continue;
+      }
+
+      _deletion_queue.push([logical_device, pool = entry->second.pool, set = entry->second.handle]() {
+        vkFreeDescriptorSets(logical_device, pool, 1u, &set);
+      });
+
+      entry = shard.sets.erase(entry);
+    }
+  }
+}
+
+auto descriptor_set_cache::size() const -> std::size_t {
+  auto size = std::size_t{0u};
+
+  for (const auto& shard : _shards) {
+    auto lock = std::shared_lock{shard.mutex};
+
+    size += shard.sets.size();
+  }
+
+  return size;
+}
+
+auto descriptor_set_cache::set_key_hash::operator()(const set_key_view& key) const noexcept -> std::size_t {
+  auto hash = std::size_t{0u};
+
+  utility::hash_combine(hash, key.layout, key.resource_hash);
+
+  return hash;
+}
+
+auto descriptor_set_cache::set_key_equal::operator()(const set_key_view& lhs, const set_key_view& rhs) const noexcept -> bool {
+  return lhs.layout == rhs.layout && lhs.resource_hash == rhs.resource_hash && std::ranges::equal(lhs.resources, rhs.resources);
+}
+
+auto descriptor_set_cache::_shard(std::uint64_t resource_hash) -> shard& {
+  // The low bits select the bucket inside of the shard
+  return _shards[(resource_hash >> 58u) % shard_count];
+}
+
+auto descriptor_set_cache::_allocate(VkDescriptorSetLayout layout, std::uint32_t variable_descriptor_count) -> std::pair<VkDescriptorSet, VkDescriptorPool> {
+  auto descriptor_set_variable_descriptor_count_allocate_info = VkDescriptorSetVariableDescriptorCountAllocateInfo{};
+  descriptor_set_variable_descriptor_count_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+  descriptor_set_variable_descriptor_count_allocate_info.descriptorSetCount = 1u;
+  descriptor_set_variable_descriptor_count_allocate_info.pDescriptorCounts = &variable_descriptor_count;
+
+  auto descriptor_set_allocate_info = VkDescriptorSetAllocateInfo{};
+  descriptor_set_allocate_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+  descriptor_set_allocate_info.pNext = variable_descriptor_count > 0u ? &descriptor_set_variable_descriptor_count_allocate_info : nullptr;
+  descriptor_set_allocate_info.descriptorSetCount = 1u;
+  descriptor_set_allocate_info.pSetLayouts = &layout;
+
+  auto set = VkDescriptorSet{};
+
+  auto lock = std::scoped_lock{_pool_mutex};
+
+  // Newer pools are tried first, older ones only have room left for the sets that were evicted from them
+  for (const auto& pool : _pools | std::views::reverse) {
+    descriptor_set_allocate_info.descriptorPool = pool;
+
+    const auto result = vkAllocateDescriptorSets(_logical_device, &descriptor_set_allocate_info, &set);
+
+    if (result == VK_SUCCESS) {
+      return {set, pool};
+    }
+
+    if (result != VK_ERROR_OUT_OF_POOL_MEMORY && result != VK_ERROR_FRAGMENTED_POOL) {
+      validate(result);
+    }
+  }
+
+  _pools.push_back(_create_pool());
+
+  utility::logger<"graphics">::debug("Descriptor set cache grew to {} pools", _pools.size());
+
+  descriptor_set_allocate_info.descriptorPool = _pools.back();
+
+  validate(vkAllocateDescriptorSets(_logical_device, &descriptor_set_allocate_info, &set));
+
+  return {set, descriptor_set_allocate_info.descriptorPool};
+}
+
+auto descriptor_set_cache::_create_pool() -> VkDescriptorPool {
+  const auto descriptor_pool_sizes = std::array<VkDescriptorPoolSize, 9u>{
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, sets_per_pool * 4u},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLER, sets_per_pool},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, sets_per_pool * 8u},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, sets_per_pool * 2u},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, sets_per_pool},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER, sets_per_pool / 4u},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER, sets_per_pool / 4u},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, sets_per_pool * 4u},
+    VkDescriptorPoolSize{VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT, sets_per_pool / 2u}
+  };
+
+  auto descriptor_pool_create_info = VkDescriptorPoolCreateInfo{};
+  descriptor_pool_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+  descriptor_pool_create_info.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+  descriptor_pool_create_info.poolSizeCount = static_cast<std::uint32_t>(descriptor_pool_sizes.size());
+  descriptor_pool_create_info.pPoolSizes = descriptor_pool_sizes.data();
+  descriptor_pool_create_info.maxSets = sets_per_pool;
+
+  auto pool = VkDescriptorPool{};
+
+  validate(vkCreateDescriptorPool(_logical_device, &descriptor_pool_create_info, nullptr, &pool));
+
+  return pool;
+}
+
+} // namespace sbx::graphics
@@ -0,0 +1,139 @@
+#ifndef LIBSBX_GRAPHICS_DESCRIPTOR_DESCRIPTOR_SET_CACHE_HPP_
+#define LIBSBX_GRAPHICS_DESCRIPTOR_DESCRIPTOR_SET_CACHE_HPP_
+
+#include <span>
+#include <array>
+#include <vector>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <unordered_map>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/utility/noncopyable.hpp>
+
+#include <libsbx/graphics/deletion_queue.hpp>
+
+namespace sbx::graphics {
+
+/**
+ * @brief Cache of written descriptor sets, keyed by their layout and the resources bound to them.
+ *
+ * Resources are described by a list of words that identify every write of the set (see descriptor_handler). The cache stores the full list of
+ * every set and compares it on a hit, the hash of the list only selects the bucket. Sets are written once when they are created and never
+ * updated afterwards, so a cached set can be bound by any number of command buffers and frames at the same time. Sets that have not been used for
+ * max_unused_frames frames are freed through the deletion queue.
+ *
+ * Sets can be requested from multiple threads. The sets are spread over shards by their hash, lookups only take a shared lock on one shard.
+ */
+class descriptor_set_cache final : public utility::noncopyable {
+
+public:
+
+  inline static constexpr auto max_unused_frames = std::uint64_t{8u};
+
+  inline static constexpr auto sets_per_pool = std::uint32_t{1024u};
+
+  inline static constexpr auto shard_count = std::size_t{16u};
+
+  descriptor_set_cache(const VkDevice& logical_device, graphics::deletion_queue& deletion_queue);
+
+  ~descriptor_set_cache();
+
+  /**
+   * @brief Hashes the resource list of a set.
+   */
+  static auto hash(std::span<const std::uint64_t> resources) noexcept -> std::uint64_t;
+
+  /**
+   * @brief Returns the cached set for the layout and resources or VK_NULL_HANDLE. Marks the set as used in the current frame.
+   *
+   * @param resource_hash Hash of resources as returned by hash()
+   */
+  auto find(VkDescriptorSetLayout layout, std::uint64_t resource_hash, std::span<const std::uint64_t> resources) -> VkDescriptorSet;
+
+  /**
+   * @brief Allocates a set, writes it and adds it to the cache. Returns the cached set instead if another thread added the key first.
+   *
+   * @param resource_hash Hash of resources as returned by hash()
+   * @param variable_descriptor_count Number of descriptors allocated for a variable sized binding, 0 if the layout has none
+   * @param write_descriptor_sets Writes for the set, their dstSet is set by the cache
+   */
+  auto emplace(VkDescriptorSetLayout layout, std::uint64_t resource_hash, std::span<const std::uint64_t> resources, std::uint32_t variable_descriptor_count, std::span<const VkWriteDescriptorSet> write_descriptor_sets) -> VkDescriptorSet;
+
+  /**
+   * @brief Starts a new frame and frees the sets that have not been used recently. Must not be called while descriptor sets are requested.
+   */
+  auto advance() -> void;
+
+  auto frame() const noexcept -> std::uint64_t {
+    return _frame.load(std::memory_order_relaxed);
+  }
+
+  auto size() const -> std::size_t;
+
+private:
+
+  struct set_key_view {
+    VkDescriptorSetLayout layout;
+    std::uint64_t resource_hash;
+    std::span<const std::uint64_t> resources;
+  }; // struct set_key_view
+
+  struct set_key {
+    VkDescriptorSetLayout layout;
+    std::uint64_t resource_hash;
+    std::vector<std::uint64_t> resources;
+
+    operator set_key_view() const noexcept {
+      return set_key_view{layout, resource_hash, resources};
+    }
+  }; // struct set_key
+
+  // Transparent, so lookups with a set_key_view do not copy the resources
+  struct set_key_hash {
+    using is_transparent = void;
+
+    auto operator()(const set_key_view& key) const noexcept -> std::size_t;
+  }; // struct set_key_hash
+
+  struct set_key_equal {
+    using is_transparent = void;
+
+    auto operator()(const set_key_view& lhs, const set_key_view& rhs) const noexcept -> bool;
+  }; // struct set_key_equal
+
+  struct cached_set {
+    VkDescriptorSet handle;
+    VkDescriptorPool pool;
+    // Written under a shared lock by every lookup
+    std::atomic<std::uint64_t> last_used_frame;
+  }; // struct cached_set
+
+  struct shard {
+    std::unordered_map<set_key, cached_set, set_key_hash, set_key_equal> sets;
+    mutable std::shared_mutex mutex;
+  }; // struct shard
+
+  auto _shard(std::uint64_t resource_hash) -> shard&;
+
+  auto _allocate(VkDescriptorSetLayout layout, std::uint32_t variable_descriptor_count) -> std::pair<VkDescriptorSet, VkDescriptorPool>;
+
+  auto _create_pool() -> VkDescriptorPool;
+
+  VkDevice _logical_device;
+  graphics::deletion_queue& _deletion_queue;
+
+  std::array<shard, shard_count> _shards;
+
+  std::vector<VkDescriptorPool> _pools;
+  std::mutex _pool_mutex;
+
+  std::atomic<std::uint64_t> _frame;
+
+}; // class descriptor_set_cache
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_DESCRIPTOR_DESCRIPTOR_SET_CACHE_HPP_
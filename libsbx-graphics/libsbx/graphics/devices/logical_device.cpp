@@ -307,6 +307,12 @@ auto logical_device::_get_enabled_features(const physical_device& physical_devic
     utility::logger<"graphics">::warn("Selected GPU does not support buffer device address");
   }
 
+  if (available_vulkan12_features.drawIndirectCount) {
+    enabled_vulkan12_features.drawIndirectCount = true;
+  } else {
+    utility::logger<"graphics">::warn("Selected GPU does not support draw indirect count");
+  }
+
   if (available_vulkan12_features.shaderSampledImageArrayNonUniformIndexing) {
     enabled_vulkan12_features.shaderSampledImageArrayNonUniformIndexing = true;
   } else {
@@ -331,6 +337,32 @@ auto logical_device::_get_enabled_features(const physical_device& physical_devic
     utility::logger<"graphics">::warn("Selected GPU does not support descriptor binding partially bound");
   }
 
+  // Only needed by the bindless table, which is optional
+  if (available_vulkan12_features.shaderStorageBufferArrayNonUniformIndexing) {
+    enabled_vulkan12_features.shaderStorageBufferArrayNonUniformIndexing = true;
+  } else {
+    utility::logger<"graphics">::warn("Selected GPU does not support storage buffer array non uniform indexing");
+  }
+
+  if (available_vulkan12_features.descriptorBindingSampledImageUpdateAfterBind && available_vulkan12_features.descriptorBindingStorageBufferUpdateAfterBind) {
+    enabled_vulkan12_features.descriptorBindingSampledImageUpdateAfterBind = true;
+    enabled_vulkan12_features.descriptorBindingStorageBufferUpdateAfterBind = true;
+  } else {
+    utility::logger<"graphics">::warn("Selected GPU does not support descriptor binding update after bind");
+  }
+
+  if (available_vulkan12_features.descriptorBindingUpdateUnusedWhilePending) {
+    enabled_vulkan12_features.descriptorBindingUpdateUnusedWhilePending = true;
+  } else {
+    utility::logger<"graphics">::warn("Selected GPU does not support descriptor binding update unused while pending");
+  }
+
+  if (available_vulkan12_features.timelineSemaphore) {
+    enabled_vulkan12_features.timelineSemaphore = true;
+  } else {
+    utility::logger<"graphics">::warn("Selected GPU does not support timeline semaphores");
+  }
+
   if (available_vulkan13_features.synchronization2) {
     enabled_vulkan13_features.synchronization2 = true;
   } else {
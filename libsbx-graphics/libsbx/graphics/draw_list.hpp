@@ -32,8 +32,25 @@ public:
 
   virtual ~draw_list();
 
+  /**
+   * @brief Runs on the rendering thread before any draw list is updated. Thread safe lists resolve everything here that is shared with other lists, e.g. the components of the scene.
+   */
+  virtual auto prepare() -> void { }
+
   virtual auto update() -> void = 0;
 
+  /**
+   * @brief Runs on the rendering thread after every draw list has been updated. Thread safe lists create, resize and upload their graphics resources here.
+   */
+  virtual auto flush() -> void { }
+
+  /**
+   * @brief Whether update may run on a worker thread concurrently with the updates of other draw lists. Implementations that opt in must not touch state shared with other lists or create and destroy graphics resources while updating.
+   */
+  virtual auto is_thread_safe() const noexcept -> bool {
+    return false;
+  }
+
   auto buffers() const noexcept -> const storage_buffer_container&;
 
   auto buffer(const utility::hashed_string& name) const -> const storage_buffer&;
@@ -25,7 +25,6 @@
 #include <libsbx/graphics/commands/command_buffer.hpp>
 
 #include <libsbx/graphics/descriptor/descriptor.hpp>
-#include <libsbx/graphics/descriptor/descriptor_set.hpp>
 #include <libsbx/graphics/descriptor/descriptor_handler.hpp>
 
 #include <libsbx/graphics/render_pass/swapchain.hpp>
@@ -34,6 +33,7 @@
 #include <libsbx/graphics/buffers/uniform_buffer.hpp>
 #include <libsbx/graphics/buffers/uniform_handler.hpp>
 #include <libsbx/graphics/buffers/storage_buffer.hpp>
+#include <libsbx/graphics/buffers/slot_buffer.hpp>
 #include <libsbx/graphics/buffers/storage_handler.hpp>
 #include <libsbx/graphics/buffers/push_handler.hpp>
 
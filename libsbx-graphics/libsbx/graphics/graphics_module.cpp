@@ -10,6 +10,8 @@
 
 #include <libsbx/core/engine.hpp>
 
+#include <libsbx/assets/assets_module.hpp>
+
 namespace sbx::graphics {
 
 #include <vulkan/vulkan.h>
@@ -95,6 +97,8 @@ graphics_module::graphics_module()
   _logical_device{std::make_unique<graphics::logical_device>(*_physical_device)},
   _surface{std::make_unique<graphics::surface>(*_instance, *_physical_device, *_logical_device)},
   _allocator{*_instance, *_physical_device, *_logical_device},
+  _descriptor_layout_cache{std::make_unique<graphics::descriptor_layout_cache>(*_logical_device)},
+  _descriptor_set_cache{std::make_unique<graphics::descriptor_set_cache>(*_logical_device, _deletion_queue)},
   _is_framebuffer_resized{true},
   _is_viewport_resized{true} {
   auto& devices_module = core::engine::get_module<devices::devices_module>();
@@ -128,6 +132,8 @@ graphics_module::~graphics_module() {
     vkDestroySemaphore(*_logical_device, image_data.render_finished_semaphore, nullptr);
   }
 
+  _upload_manager.reset();
+
   // [NOTE] KAJ 2023-02-19 : Command buffers must be freed before the command pools
   _graphics_command_buffers.clear();
   _compute_command_buffers.clear();
@@ -142,6 +148,14 @@ graphics_module::~graphics_module() {
   _images.clear();
   _depth_images.clear();
   _cube_images.clear();
+
+  _deletion_queue.flush_all();
+
+  _bindless_table.reset();
+  _descriptor_set_cache.reset();
+  _descriptor_layout_cache.reset();
+
+  _pipeline_cache.reset();
 }
 
 auto graphics_module::update() -> void {
@@ -151,6 +165,10 @@ auto graphics_module::update() -> void {
 
   const auto& window = devices_module.window();
 
+  // Uploads recorded since the last frame are submitted even if nothing is rendered, so their futures make progress
+  upload_manager().flush();
+  upload_manager().collect();
+
   if (!_renderer || window.is_iconified()) {
     return;
   }
@@ -205,6 +223,12 @@ auto graphics_module::update() -> void {
     }
   }
 
+  // The fence of the frame has been waited on, so nothing retired during its last recording is in use anymore
+  _deletion_queue.flush(_current_frame);
+
+  // Runs after the flush, so sets evicted now are freed once the frames in flight that might still bind them finished
+  _descriptor_set_cache->advance();
+
   // [NOTE] KAJ 2023-02-19 : Drawing happens here
 
   EASY_BLOCK("draw");
@@ -217,10 +241,13 @@ auto graphics_module::update() -> void {
   // Needs to be acquired AFTER acquire_next_image!
   auto& image_data = _per_image_data[_swapchain->active_image_index()];
 
-  _renderer->render(command_buffer, *_swapchain);
+  _renderer->render(command_buffer, *_swapchain, _current_frame);
 
   command_buffer.end();
 
+  // Resources created while recording the frame have to be uploaded before the frame is submitted
+  upload_manager().flush();
+
   auto wait_semaphores = std::vector<command_buffer::wait_data>{};
   wait_semaphores.push_back({frame_data.image_available_semaphore, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT});
   // wait_semaphores.push_back({frame_data.compute_finished_semaphore, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT});
@@ -282,6 +309,9 @@ auto graphics_module::surface() -> graphics::surface& {
 auto graphics_module::command_pool(VkQueueFlagBits queue_type, const std::thread::id& thread_id) -> const std::shared_ptr<graphics::command_pool>& {
   const auto key = command_pool_key{queue_type, thread_id};
 
+  // Command buffers may be created from worker threads while recording in parallel
+  auto lock = std::scoped_lock{_command_pools_mutex};
+
   if (auto entry = _command_pools.find(key); entry != _command_pools.end()) {
     return entry->second;
   }
@@ -289,6 +319,35 @@ auto graphics_module::command_pool(VkQueueFlagBits queue_type, const std::thread
   return _command_pools.insert({key, std::make_shared<graphics::command_pool>(queue_type)}).first->second;
 }
 
+auto graphics_module::upload_manager() -> graphics::upload_manager& {
+  // The manager is created on first use since it allocates its resources through the module
+  std::call_once(_upload_manager_created, [this]() {
+    _upload_manager = std::make_unique<graphics::upload_manager>();
+  });
+
+  return *_upload_manager;
+}
+
+auto graphics_module::pipeline_cache() -> graphics::pipeline_cache& {
+  // Created on first use so the application had the chance to set the asset root
+  std::call_once(_pipeline_cache_created, [this]() {
+    auto& assets_module = core::engine::get_module<assets::assets_module>();
+
+    _pipeline_cache = std::make_unique<graphics::pipeline_cache>(*_physical_device, *_logical_device, assets_module.asset_root() / ".cache" / "pipelines.bin");
+  });
+
+  return *_pipeline_cache;
+}
+
+auto graphics_module::bindless_table() -> graphics::bindless_table& {
+  // Created on first use, since it is optional and pipelines only need its layout if a shader uses its set
+  std::call_once(_bindless_table_created, [this]() {
+    _bindless_table = std::make_unique<graphics::bindless_table>(*_logical_device, _deletion_queue, graphics::bindless_table::create_descriptor_set_layout());
+  });
+
+  return *_bindless_table;
+}
+
 auto graphics_module::swapchain() -> graphics::swapchain& {
   return *_swapchain;
 };
@@ -379,6 +438,8 @@ auto graphics_module::attachment(const std::string& name) const -> const descrip
 auto graphics_module::_recreate_viewport() -> void {
   _logical_device->wait_idle();
 
+  _deletion_queue.flush_all();
+
   _renderer->resize(viewport::type::dynamic);
   _on_viewport_changed.emit(_viewport);
 }
@@ -386,6 +447,8 @@ auto graphics_module::_recreate_viewport() -> void {
 auto graphics_module::_recreate_swapchain() -> void {
   _logical_device->wait_idle();
 
+  _deletion_queue.flush_all();
+
   _swapchain = std::make_unique<graphics::swapchain>(_swapchain);
 
   _recreate_per_frame_data();
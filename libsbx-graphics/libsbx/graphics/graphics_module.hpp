@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <vector>
 #include <typeindex>
+#include <mutex>
 
 #include <libsbx/core/module.hpp>
 #include <libsbx/core/delegate.hpp>
@@ -34,16 +35,23 @@
 #include <libsbx/graphics/pipeline/graphics_pipeline.hpp>
 #include <libsbx/graphics/pipeline/compute_pipeline.hpp>
 #include <libsbx/graphics/pipeline/compiler.hpp>
+#include <libsbx/graphics/pipeline/pipeline_cache.hpp>
 
 #include <libsbx/graphics/buffers/buffer.hpp>
 #include <libsbx/graphics/buffers/storage_buffer.hpp>
+#include <libsbx/graphics/buffers/upload_manager.hpp>
 
 #include <libsbx/graphics/images/image2d.hpp>
 #include <libsbx/graphics/images/cube_image.hpp>
 
+#include <libsbx/graphics/descriptor/descriptor_layout_cache.hpp>
+#include <libsbx/graphics/descriptor/descriptor_set_cache.hpp>
+#include <libsbx/graphics/descriptor/bindless_table.hpp>
+
 #include <libsbx/graphics/renderer.hpp>
 
 #include <libsbx/graphics/resource_storage.hpp>
+#include <libsbx/graphics/deletion_queue.hpp>
 
 namespace sbx::graphics {
 
@@ -67,6 +75,7 @@ constexpr auto to_vk_enum(Enum value) -> VkEnum {
  */
 class graphics_module final : public core::module<graphics_module> {
 
+  // Stays exclusive, subrenderers may read any component of the scene while recording
   inline static const auto is_registered = register_module(stage::rendering, dependencies<devices::devices_module>{});
 
   inline static constexpr auto max_deletion_queue_size = std::size_t{16u};
@@ -171,6 +180,42 @@ public:
     return _compiler;
   }
 
+  /**
+   * @brief Batches uploads to device local resources. Recorded uploads are submitted once per frame.
+   */
+  auto upload_manager() -> graphics::upload_manager&;
+
+  /**
+   * @brief Pipeline cache shared by all pipelines. It is loaded from .cache/pipelines.bin in the asset root on first use and written back on shutdown.
+   */
+  auto pipeline_cache() -> graphics::pipeline_cache&;
+
+  /**
+   * @brief Defers the destruction of GPU resources until the frames in flight that might use them finished executing.
+   */
+  auto deletion_queue() -> graphics::deletion_queue& {
+    return _deletion_queue;
+  }
+
+  /**
+   * @brief Deduplicates the descriptor set layouts of all pipelines.
+   */
+  auto descriptor_layout_cache() -> graphics::descriptor_layout_cache& {
+    return *_descriptor_layout_cache;
+  }
+
+  /**
+   * @brief Written descriptor sets shared by all descriptor handlers with the same layout and resources.
+   */
+  auto descriptor_set_cache() -> graphics::descriptor_set_cache& {
+    return *_descriptor_set_cache;
+  }
+
+  /**
+   * @brief Bindless descriptor table bound at bindless_table::set. Created on first use, throws if the GPU does not support it.
+   */
+  auto bindless_table() -> graphics::bindless_table&;
+
 private:
 
   static constexpr auto _access_mask_from_stage(VkPipelineStageFlagBits2 stage) -> VkAccessFlagBits2 {
@@ -302,6 +347,7 @@ private:
   std::unique_ptr<graphics::logical_device> _logical_device{};
 
   std::unordered_map<command_pool_key, std::shared_ptr<graphics::command_pool>, command_pool_key_hash, command_pool_key_equality> _command_pools{};
+  std::mutex _command_pools_mutex{};
 
   std::map<std::string, memory::observer_ptr<const descriptor>> _attachments{};
 
@@ -328,8 +374,22 @@ private:
 
   graphics::allocator _allocator;
 
+  graphics::deletion_queue _deletion_queue{max_deletion_queue_size};
+
+  std::unique_ptr<graphics::descriptor_layout_cache> _descriptor_layout_cache;
+  std::unique_ptr<graphics::descriptor_set_cache> _descriptor_set_cache;
+
+  std::unique_ptr<graphics::bindless_table> _bindless_table;
+  std::once_flag _bindless_table_created;
+
   graphics::compiler _compiler;
 
+  std::unique_ptr<graphics::upload_manager> _upload_manager;
+  std::once_flag _upload_manager_created;
+
+  std::unique_ptr<graphics::pipeline_cache> _pipeline_cache;
+  std::once_flag _pipeline_cache_created;
+
   std::vector<command_buffer::acquire_ownership_data> _acquire_ownership_data;
   std::vector<command_buffer::release_ownership_data> _release_ownership_data;
 
@@ -8,6 +8,8 @@
 
 #include <libsbx/assets/assets_module.hpp>
 
+#include <libsbx/graphics/graphics_module.hpp>
+
 namespace sbx::graphics {
 
 cube_image::cube_image(const std::filesystem::path& path, const std::string& suffix, VkFilter filter, VkSamplerAddressMode address_mode, bool anisotropic, bool mipmap)
@@ -99,22 +101,25 @@ auto cube_image::_load(const std::filesystem::path& path, const std::string& suf
   create_image_sampler(_sampler, _filter, _address_mode, _anisotropic, _mip_levels);
   create_image_view(_handle, _view, VK_IMAGE_VIEW_TYPE_CUBE, _format, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
 
-  if (data || _mipmap) {
-    transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
-  }
-
   if (data) {
-    // [NOTE] KAJ 2023-07-28 : Since we loaded the image with STBI_rgb_alpha, we need to multiply the buffer size by 4.
-    auto buffer_size = _extent.width * _extent.height * 4 * _array_layers;
-    auto staging_buffer = graphics::staging_buffer{std::span{data, buffer_size}};
+    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-    copy_buffer_to_image(staging_buffer, _handle, _extent, _array_layers, 0);
-  }
-
-  if (_mipmap) {
+    // [NOTE] KAJ 2023-07-28 : Since we loaded the image with STBI_rgb_alpha, we need to multiply the buffer size by 4.
+    const auto buffer_size = _extent.width * _extent.height * 4 * _array_layers;
+
+    graphics_module.upload_manager().upload(upload_manager::image_upload{
+      .image = _handle,
+      .format = _format,
+      .extent = _extent,
+      .old_layout = VK_IMAGE_LAYOUT_UNDEFINED,
+      .new_layout = _layout,
+      .mip_levels = _mip_levels,
+      .layer_count = _array_layers,
+      .generate_mipmaps = _mipmap
+    }, data, buffer_size);
+  } else if (_mipmap) {
+    transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
     create_mipmaps(_handle, _extent, _format, _layout, _mip_levels, 0, _array_layers);
-  } else if (data) {
-    transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, _layout, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
   } else {
     transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_UNDEFINED, _layout, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
   }
@@ -50,13 +50,21 @@ image::image(const VkExtent3D extent, VkFilter filter, VkSamplerAddressMode addr
 image::~image() {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-  auto& logical_device = graphics_module.logical_device();
+  const auto logical_device = graphics_module.logical_device().handle();
 
-  auto& allocator = graphics_module.allocator();
+  const auto allocator = graphics_module.allocator().handle();
+
+  graphics_module.deletion_queue().push([logical_device, allocator, view = _view, sampler = _sampler, handle = _handle, allocation = _allocation, is_aliasing = _is_aliasing]() {
+    vkDestroyImageView(logical_device, view, nullptr);
+    vkDestroySampler(logical_device, sampler, nullptr);
+
+    if (is_aliasing) {
+      vkDestroyImage(logical_device, handle, nullptr);
+    } else {
+      vmaDestroyImage(allocator, handle, allocation);
+    }
+  });
 
-  vkDestroyImageView(logical_device, _view, nullptr);
-  vkDestroySampler(logical_device, _sampler, nullptr);
-  vmaDestroyImage(allocator, _handle, _allocation);
   // vkFreeMemory(logical_device, _memory, nullptr);
   // vkDestroyImage(logical_device, _handle, nullptr);
 }
@@ -105,14 +113,7 @@ auto image::has_stencil_component(VkFormat format) noexcept -> bool {
   return std::find(stencil_formats.begin(), stencil_formats.end(), format) != stencil_formats.end();
 }
 
-auto image::create_image(VkImage& image, VmaAllocation& allocation, const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> void {
-  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
-
-  auto& physical_device = graphics_module.physical_device();
-  auto& logical_device = graphics_module.logical_device();
-
-  auto& allocator = graphics_module.allocator();
-
+static auto make_image_create_info(const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageUsageFlags usage, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> VkImageCreateInfo {
   auto image_create_info = VkImageCreateInfo{};
   image_create_info.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
   image_create_info.flags = array_layers == 6 ? VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT : 0;
@@ -127,6 +128,19 @@ auto image::create_image(VkImage& image, VmaAllocation& allocation, const VkExte
   image_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
   image_create_info.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 
+  return image_create_info;
+}
+
+auto image::create_image(VkImage& image, VmaAllocation& allocation, const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  auto& physical_device = graphics_module.physical_device();
+  auto& logical_device = graphics_module.logical_device();
+
+  auto& allocator = graphics_module.allocator();
+
+  const auto image_create_info = make_image_create_info(extent, format, samples, usage, mip_levels, array_layers, type);
+
   // validate(vkCreateImage(logical_device, &image_create_info, nullptr, &image));
 
   // auto memory_requirements = VkMemoryRequirements{};
@@ -151,6 +165,35 @@ auto image::create_image(VkImage& image, VmaAllocation& allocation, const VkExte
   // vmaSetAllocationName(allocator, allocation, name().c_str());
 }
 
+auto image::create_aliasing_image(VkImage& image, const VmaAllocation& allocation, const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageUsageFlags usage, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  auto& allocator = graphics_module.allocator();
+
+  const auto image_create_info = make_image_create_info(extent, format, samples, usage, mip_levels, array_layers, type);
+
+  validate(vmaCreateAliasingImage(allocator, allocation, &image_create_info, &image));
+}
+
+auto image::memory_requirements(const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageUsageFlags usage, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> VkMemoryRequirements {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  auto& logical_device = graphics_module.logical_device();
+
+  const auto image_create_info = make_image_create_info(extent, format, samples, usage, mip_levels, array_layers, type);
+
+  auto device_image_memory_requirements = VkDeviceImageMemoryRequirements{};
+  device_image_memory_requirements.sType = VK_STRUCTURE_TYPE_DEVICE_IMAGE_MEMORY_REQUIREMENTS;
+  device_image_memory_requirements.pCreateInfo = &image_create_info;
+
+  auto memory_requirements = VkMemoryRequirements2{};
+  memory_requirements.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2;
+
+  vkGetDeviceImageMemoryRequirements(logical_device, &device_image_memory_requirements, &memory_requirements);
+
+  return memory_requirements.memoryRequirements;
+}
+
 auto image::create_image_view(const VkImage& image, VkImageView& image_view, VkImageViewType type, VkFormat format, VkImageAspectFlags image_aspect, std::uint32_t mip_levels, std::uint32_t base_mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
@@ -201,6 +244,14 @@ auto image::create_image_sampler(VkSampler& sampler, VkFilter filter, VkSamplerA
 auto image::create_mipmaps(const VkImage& image, const VkExtent3D& extent, VkFormat format, VkImageLayout dst_image_layout, std::uint32_t mip_levels, std::uint32_t base_array_layer, std::uint32_t layer_count) -> void {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
+  graphics_module.upload_manager().record([&](graphics::command_buffer& command_buffer) {
+    create_mipmaps(command_buffer, image, extent, format, dst_image_layout, mip_levels, base_array_layer, layer_count);
+  });
+}
+
+auto image::create_mipmaps(command_buffer& command_buffer, const VkImage& image, const VkExtent3D& extent, VkFormat format, VkImageLayout dst_image_layout, std::uint32_t mip_levels, std::uint32_t base_array_layer, std::uint32_t layer_count) -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
   auto& physical_device = graphics_module.physical_device();
 
   auto format_properties = VkFormatProperties{};
@@ -210,8 +261,6 @@ auto image::create_mipmaps(const VkImage& image, const VkExtent3D& extent, VkFor
     throw std::runtime_error{"Texture image format does not support linear blitting"};
   }
 
-  auto command_buffer = graphics::command_buffer{};
-
   for (auto i : std::views::iota(1u, mip_levels)) {
     auto barrier0 = VkImageMemoryBarrier{};
     barrier0.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
@@ -278,110 +327,14 @@ auto image::create_mipmaps(const VkImage& image, const VkExtent3D& extent, VkFor
 	barrier.subresourceRange.layerCount = layer_count;
 
   vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
-
-  command_buffer.submit_idle();
 }
 
 auto image::transition_image_layout(const VkImage& image, VkFormat format, VkImageLayout src_image_layout, VkImageLayout dst_image_layout, VkImageAspectFlags image_aspect, std::uint32_t mip_levels, std::uint32_t base_mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void {
-  auto command_buffer = graphics::command_buffer{};
-
-  auto barrier = VkImageMemoryBarrier{};
-  barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	barrier.oldLayout = src_image_layout;
-	barrier.newLayout = dst_image_layout;
-	barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-	barrier.image = image;
-	barrier.subresourceRange.aspectMask = image_aspect;
-	barrier.subresourceRange.baseMipLevel = base_mip_level;
-	barrier.subresourceRange.levelCount = mip_levels;
-	barrier.subresourceRange.baseArrayLayer = base_array_layer;
-	barrier.subresourceRange.layerCount = layer_count;
-
-  switch (src_image_layout) {
-    case VK_IMAGE_LAYOUT_UNDEFINED: {
-      barrier.srcAccessMask = 0;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: {
-      barrier.srcAccessMask = 0;  // No specific access mask required
-      break;
-    }
-    case VK_IMAGE_LAYOUT_GENERAL: {
-      // General can be written or read — safest is to assume both
-      barrier.srcAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_PREINITIALIZED: {
-      barrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: {
-      barrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: {
-      barrier.srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: {
-      barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: {
-      barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: {
-      barrier.srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-      break;
-    }
-    default: {
-      throw std::runtime_error{fmt::format("Unsupported image layout transition source: {}", src_image_layout)};
-    }
-	}
-
-  switch (dst_image_layout) {
-    case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL: {
-      barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_GENERAL: {
-      barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: {
-      barrier.dstAccessMask = 0;  // No specific access mask required
-      break;
-    }
-    case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL: {
-      barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: {
-      barrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: {
-      barrier.dstAccessMask = barrier.dstAccessMask | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-      break;
-    }
-    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: {
-      if (barrier.srcAccessMask == 0) {
-        barrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
-      }
-
-      barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-      break;
-    }
-    default: {
-      throw std::runtime_error{fmt::format("Unsupported image layout transition destination: {}", dst_image_layout)};
-    }
-	}
-
-  vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-  command_buffer.submit_idle();
+  graphics_module.upload_manager().record([&](graphics::command_buffer& command_buffer) {
+    transition_image_layout(command_buffer, image, format, src_image_layout, dst_image_layout, image_aspect, mip_levels, base_mip_level, layer_count, base_array_layer);
+  });
 }
 
 auto image::transition_image_layout(command_buffer& command_buffer, const VkImage& image, VkFormat format, VkImageLayout src_image_layout, VkImageLayout dst_image_layout, VkImageAspectFlags image_aspect, std::uint32_t mip_levels, std::uint32_t base_mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void {
@@ -501,11 +454,9 @@ auto image::insert_image_memory_barrier(command_buffer& command_buffer, const Vk
   vkCmdPipelineBarrier(command_buffer, src_stage_mask, dst_stage_mask, 0, 0, nullptr, 0, nullptr, 1, &barrier);
 }
 
-auto image::copy_buffer_to_image(const VkBuffer& buffer, const VkImage& image, const VkExtent3D& extent, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void {
-  auto command_buffer = graphics::command_buffer{};
-
+auto image::copy_buffer_to_image(command_buffer& command_buffer, const VkBuffer& buffer, const VkImage& image, const VkExtent3D& extent, std::uint32_t layer_count, std::uint32_t base_array_layer, VkDeviceSize buffer_offset) -> void {
 	auto region = VkBufferImageCopy{};
-	region.bufferOffset = 0;
+	region.bufferOffset = buffer_offset;
 	region.bufferRowLength = 0;
 	region.bufferImageHeight = 0;
 	region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -516,8 +467,6 @@ auto image::copy_buffer_to_image(const VkBuffer& buffer, const VkImage& image, c
 	region.imageExtent = extent;
 
 	vkCmdCopyBufferToImage(command_buffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
-
-	command_buffer.submit_idle();
 }
 
 auto image::copy_image_to_buffer(const VkImage& image, VkFormat format, const VkBuffer& buffer, const VkOffset3D& offset, const VkExtent3D& extent, std::uint32_t mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void {
@@ -37,19 +37,34 @@ public:
 
   static auto create_image(VkImage& image, VmaAllocation& allocation, const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageTiling tiling, VkImageUsageFlags usage, VkMemoryPropertyFlags properties, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> void;
 
+  /**
+   * @brief Creates an image that is bound to memory owned by someone else. Used to alias the memory of transient attachments whose lifetimes do not overlap.
+   */
+  static auto create_aliasing_image(VkImage& image, const VmaAllocation& allocation, const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageUsageFlags usage, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> void;
+
+  static auto memory_requirements(const VkExtent3D& extent, VkFormat format, VkSampleCountFlagBits samples, VkImageUsageFlags usage, std::uint32_t mip_levels, std::uint32_t array_layers, VkImageType type) -> VkMemoryRequirements;
+
   static auto create_image_view(const VkImage& image, VkImageView& image_view, VkImageViewType type, VkFormat format, VkImageAspectFlags image_aspect, std::uint32_t mip_levels, std::uint32_t base_mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void;
 
   static auto create_image_sampler(VkSampler& sampler, VkFilter filter, VkSamplerAddressMode address_mode, bool anisotropic, std::uint32_t mip_levels) -> void;
 
+  /**
+   * @brief Records the mipmap generation into the current batch of the upload manager. The work is submitted with the next flush.
+   */
   static auto create_mipmaps(const VkImage& image, const VkExtent3D& extent, VkFormat format, VkImageLayout dst_image_layout, std::uint32_t mip_levels, std::uint32_t base_array_layer, std::uint32_t layer_count) -> void;
 
+  static auto create_mipmaps(command_buffer& command_buffer, const VkImage& image, const VkExtent3D& extent, VkFormat format, VkImageLayout dst_image_layout, std::uint32_t mip_levels, std::uint32_t base_array_layer, std::uint32_t layer_count) -> void;
+
+  /**
+   * @brief Records the layout transition into the current batch of the upload manager. The work is submitted with the next flush.
+   */
   static auto transition_image_layout(const VkImage& image, VkFormat format, VkImageLayout src_image_layout, VkImageLayout dst_image_layout, VkImageAspectFlags image_aspect, std::uint32_t mip_levels, std::uint32_t base_mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void;
 
   static auto transition_image_layout(command_buffer& command_buffer, const VkImage& image, VkFormat format, VkImageLayout src_image_layout, VkImageLayout dst_image_layout, VkImageAspectFlags image_aspect, std::uint32_t mip_levels, std::uint32_t base_mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void;
 
   static auto insert_image_memory_barrier(command_buffer& command_buffer, const VkImage& image, VkAccessFlags src_access_mask, VkAccessFlags dst_access_mask, VkImageLayout old_image_layout, VkImageLayout new_image_layout, VkPipelineStageFlags src_stage_mask, VkPipelineStageFlags dst_stage_mask, VkImageAspectFlags image_aspect, uint32_t mip_levels, uint32_t base_mip_level, uint32_t layer_count, uint32_t base_array_layer) -> void;
 
-  static auto copy_buffer_to_image(const VkBuffer& buffer, const VkImage& image, const VkExtent3D& extent, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void;
+  static auto copy_buffer_to_image(command_buffer& command_buffer, const VkBuffer& buffer, const VkImage& image, const VkExtent3D& extent, std::uint32_t layer_count, std::uint32_t base_array_layer, VkDeviceSize buffer_offset = 0u) -> void;
 
   static auto copy_image_to_buffer(const VkImage& image, VkFormat format, const VkBuffer& buffer, const VkOffset3D& offset, const VkExtent3D& extent, std::uint32_t mip_level, std::uint32_t layer_count, std::uint32_t base_array_layer) -> void;
 
@@ -108,7 +123,9 @@ protected:
   std::uint32_t _array_layers;
 
   VkImage _handle;
-  VmaAllocation _allocation;
+  VmaAllocation _allocation{};
+  // The allocation is not owned if the image aliases memory
+  bool _is_aliasing{false};
   // VkDeviceMemory _memory;
   VkImageView _view;
   VkSampler _sampler;
@@ -33,6 +33,20 @@ image2d::image2d(const std::filesystem::path& path, VkFilter filter, VkSamplerAd
   _load(assets_module.resolve_path(path));
 }
 
+image2d::image2d(const VmaAllocation& memory, const math::vector2u& extent, VkFormat format, VkImageLayout layout, VkImageUsageFlags usage, VkFilter filter, VkSamplerAddressMode address_mode)
+: image{VkExtent3D{extent.x(), extent.y(), 1}, filter, address_mode, VK_SAMPLE_COUNT_1_BIT, layout, (usage | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), format, 1, 1},
+  _anisotropic{false},
+  _mipmap{false} {
+  _allocation = memory;
+  _is_aliasing = true;
+
+  _load();
+}
+
+auto image2d::memory_requirements(const math::vector2u& extent, VkFormat format, VkImageUsageFlags usage) -> VkMemoryRequirements {
+  return image::memory_requirements(VkExtent3D{extent.x(), extent.y(), 1}, format, VK_SAMPLE_COUNT_1_BIT, (usage | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT), 1, 1, VK_IMAGE_TYPE_2D);
+}
+
 image2d::image2d(const math::vector2u& extent, VkFormat format , memory::observer_ptr<const std::uint8_t> pixels)
 : image2d{extent, format} {
   set_pixels(pixels);
@@ -70,18 +84,20 @@ static auto bytes_per_channel(VkFormat format) -> std::uint8_t {
 }
 
 auto image2d::set_pixels(memory::observer_ptr<const std::uint8_t> pixels) -> void {
-  auto buffer_size = _extent.width * _extent.height * _channels * bytes_per_channel(_format);
-  auto staging_buffer = graphics::staging_buffer{std::span{pixels.get(), buffer_size}};
-
-  transition_image_layout(_handle, _format, _layout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
-
-  copy_buffer_to_image(staging_buffer, _handle, _extent, _array_layers, 0);
-
-  if (_mipmap) {
-    create_mipmaps(_handle, _extent, _format, _layout, _mip_levels, 0, _array_layers);
-  } else {
-    transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, _layout, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
-  }
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto buffer_size = _extent.width * _extent.height * _channels * bytes_per_channel(_format);
+
+  graphics_module.upload_manager().upload(upload_manager::image_upload{
+    .image = _handle,
+    .format = _format,
+    .extent = _extent,
+    .old_layout = _layout,
+    .new_layout = _layout,
+    .mip_levels = _mip_levels,
+    .layer_count = _array_layers,
+    .generate_mipmaps = _mipmap
+  }, pixels.get(), buffer_size);
 }
 
 struct file_header {
@@ -129,28 +145,37 @@ auto image2d::_load(const std::filesystem::path& path) -> void {
 
   _mip_levels = _mipmap ? mip_levels(_extent) : 1;
 
-  create_image(_handle, _allocation, _extent, _format, _samples, VK_IMAGE_TILING_OPTIMAL, _usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, _mip_levels, _array_layers, VK_IMAGE_TYPE_2D);
+  if (_is_aliasing) {
+    create_aliasing_image(_handle, _allocation, _extent, _format, _samples, _usage, _mip_levels, _array_layers, VK_IMAGE_TYPE_2D);
+  } else {
+    create_image(_handle, _allocation, _extent, _format, _samples, VK_IMAGE_TILING_OPTIMAL, _usage, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, _mip_levels, _array_layers, VK_IMAGE_TYPE_2D);
+  }
+
   create_image_sampler(_sampler, _filter, _address_mode, _anisotropic, _mip_levels);
   create_image_view(_handle, _view, VK_IMAGE_VIEW_TYPE_2D, _format, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
 
-  if (data.pixels || _mipmap) {
-    transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
-  }
-
   if (data.pixels) {
+    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
     // [NOTE] KAJ 2023-07-28 : Since we loaded the image with STBI_rgb_alpha, we need to multiply the buffer size by 4.
     const auto buffer_size = _extent.width * _extent.height * 4u;
-    auto staging_buffer = graphics::staging_buffer{std::span{data.pixels, buffer_size}};
 
-    copy_buffer_to_image(staging_buffer, _handle, _extent, _array_layers, 0);
+    // The pixels are copied into the staging ring right away, so they can be freed before the upload is submitted
+    graphics_module.upload_manager().upload(upload_manager::image_upload{
+      .image = _handle,
+      .format = _format,
+      .extent = _extent,
+      .old_layout = VK_IMAGE_LAYOUT_UNDEFINED,
+      .new_layout = _layout,
+      .mip_levels = _mip_levels,
+      .layer_count = _array_layers,
+      .generate_mipmaps = _mipmap
+    }, data.pixels, buffer_size);
 
     stbi_image_free(data.pixels);
-  }
-
-  if (_mipmap) {
+  } else if (_mipmap) {
+    transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
     create_mipmaps(_handle, _extent, _format, _layout, _mip_levels, 0, _array_layers);
-  } else if (data.pixels) {
-    transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, _layout, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
   } else {
     transition_image_layout(_handle, _format, VK_IMAGE_LAYOUT_UNDEFINED, _layout, VK_IMAGE_ASPECT_COLOR_BIT, _mip_levels, 0, _array_layers, 0);
   }
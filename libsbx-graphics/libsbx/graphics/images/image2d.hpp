@@ -23,8 +23,15 @@ public:
 
   image2d(const math::vector2u& extent, VkFormat format, memory::observer_ptr<const std::uint8_t> pixels);
 
+  /**
+   * @brief Creates an image that aliases the given memory. The allocation has to satisfy memory_requirements for the same parameters and outlive the image.
+   */
+  image2d(const VmaAllocation& memory, const math::vector2u& extent, VkFormat format, VkImageLayout layout, VkImageUsageFlags usage, VkFilter filter, VkSamplerAddressMode address_mode);
+
   ~image2d() override = default;
 
+  static auto memory_requirements(const math::vector2u& extent, VkFormat format, VkImageUsageFlags usage) -> VkMemoryRequirements;
+
   auto set_pixels(memory::observer_ptr<const std::uint8_t> pixels) -> void;
 
   auto name() const noexcept -> std::string override {
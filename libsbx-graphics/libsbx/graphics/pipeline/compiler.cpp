@@ -1,10 +1,18 @@
 #include <libsbx/graphics/pipeline/compiler.hpp>
 
+#include <algorithm>
+#include <fstream>
+#include <thread>
+
+#include <fmt/format.h>
+
 #include <libsbx/core/engine.hpp>
 
+#include <libsbx/containers/task_graph.hpp>
+
 #include <libsbx/assets/assets_module.hpp>
 
-#include <fstream>
+#include <libsbx/graphics/pipeline/shader_cache.hpp>
 
 namespace sbx::graphics {
 
@@ -31,8 +39,41 @@ static constexpr auto stage_infos = std::array<stage_info, 14u>{
   stage_info{ SLANG_STAGE_CALLABLE,       "callable",      "callable.slang"      }
 };
 
-compiler::compiler() {
-  createGlobalSession(_global_session.writeRef());
+compiler::global_session_lease::global_session_lease(compiler& owner)
+: _compiler{owner} {
+  {
+    auto lock = std::scoped_lock{_compiler._mutex};
+
+    if (!_compiler._global_sessions.empty()) {
+      _global_session = std::move(_compiler._global_sessions.back());
+      _compiler._global_sessions.pop_back();
+    }
+  }
+
+  // Creating a global session is expensive, but it does not touch the pool
+  if (!_global_session) {
+    createGlobalSession(_global_session.writeRef());
+  }
+
+  if (!_global_session) {
+    throw utility::runtime_error{"Failed to create Slang global session"};
+  }
+}
+
+compiler::global_session_lease::~global_session_lease() {
+  auto lock = std::scoped_lock{_compiler._mutex};
+
+  // Sessions beyond the limit are released once their compilation is done
+  if (_global_session && _compiler._global_sessions.size() < _compiler._max_global_sessions) {
+    _compiler._global_sessions.push_back(std::move(_global_session));
+  }
+}
+
+compiler::compiler()
+: _max_global_sessions{std::max(std::size_t{1u}, static_cast<std::size_t>(std::thread::hardware_concurrency()))} {
+  auto global_session = global_session_lease{*this};
+
+  _version = global_session->getBuildTagString();
 }
 
 compiler::~compiler() {
@@ -40,14 +81,77 @@ compiler::~compiler() {
 }
 
 auto compiler::compile(const compile_request& compile_request) -> compile_result {
-  auto& assets_module = core::engine::get_module<assets::assets_module>();
+  return compile_resolved(_resolve(compile_request));
+}
 
-  auto session = _create_session(compile_request);
+auto compiler::compile(std::span<const compile_request> compile_requests) -> std::vector<compile_result> {
+  auto& executor = core::engine::executor();
 
-  auto result = compile_result{};
+  // Resolving touches the assets module, so it happens on the calling thread before the requests are handed to the workers
+  auto resolved_requests = std::vector<compile_request>{};
+  resolved_requests.reserve(compile_requests.size());
+
+  for (const auto& compile_request : compile_requests) {
+    resolved_requests.push_back(_resolve(compile_request));
+  }
+
+  auto results = std::vector<compile_result>(resolved_requests.size());
+
+  auto graph = containers::task_graph{"shader_compilation"};
+
+  for (auto i = 0u; i < resolved_requests.size(); ++i) {
+    graph.emplace([this, &resolved_requests, &results, i]() {
+      results[i] = compile_resolved(resolved_requests[i]);
+    });
+  }
+
+  executor.run_and_wait(graph);
+
+  return results;
+}
+
+auto compiler::compile_resolved(const compile_request& compile_request) -> compile_result {
+  auto sources = std::vector<std::string>{};
+  sources.reserve(stage_infos.size());
 
   for (const auto& [stage, name, file] : stage_infos) {
-    const auto file_path = assets_module.resolve_path(std::filesystem::path{compile_request.path}.append(file));
+    const auto file_path = std::filesystem::path{compile_request.path}.append(file);
+
+    sources.push_back(std::filesystem::exists(file_path) ? _read_file(file_path) : std::string{});
+  }
+
+  const auto key = _cache_key(compile_request, sources);
+
+  const auto cache_path = [&]() {
+    auto lock = std::scoped_lock{_mutex};
+
+    return _cache_directory.empty() ? std::filesystem::path{} : shader_cache::path(_cache_directory, key);
+  }();
+
+  if (!cache_path.empty()) {
+    try {
+      if (auto code = shader_cache::read(cache_path, key)) {
+        utility::logger<"graphics">::debug("Loaded shaders '{}' from cache '{}'", compile_request.path.string(), cache_path.string());
+
+        return compile_result{std::move(*code)};
+      }
+    } catch (const std::exception& exception) {
+      utility::logger<"graphics">::warn("Ignoring shader cache '{}': {}", cache_path.string(), exception.what());
+    }
+  }
+
+  auto global_session = global_session_lease{*this};
+
+  auto session = _create_session(global_session.get(), compile_request);
+
+  auto result = compile_result{};
+
+  auto dependencies = std::vector<std::filesystem::path>{};
+
+  for (auto i = 0u; i < stage_infos.size(); ++i) {
+    const auto& [stage, name, file] = stage_infos[i];
+
+    const auto file_path = std::filesystem::path{compile_request.path}.append(file);
 
     if (!std::filesystem::exists(file_path)) {
       continue;
@@ -55,7 +159,7 @@ auto compiler::compile(const compile_request& compile_request) -> compile_result
 
     auto& per_stage = compile_request.per_stage.at(stage);
 
-    const auto source = _read_file(file_path);
+    const auto& source = sources[i];
 
     auto shader_module = Slang::ComPtr<slang::IModule>{};
 
@@ -71,6 +175,10 @@ auto compiler::compile(const compile_request& compile_request) -> compile_result
       if (!shader_module) {
         throw utility::runtime_error{"Failed to load shader_module '{}'.", file_path.string()};
       }
+
+      for (auto dependency = SlangInt32{0}; dependency < shader_module->getDependencyFileCount(); ++dependency) {
+        dependencies.emplace_back(shader_module->getDependencyFilePath(dependency));
+      }
     }
 
     auto entry_point = Slang::ComPtr<slang::IEntryPoint>{};
@@ -167,6 +275,17 @@ auto compiler::compile(const compile_request& compile_request) -> compile_result
     std::memcpy(result.code[stage].data(), code_blob->getBufferPointer(), byte_size);
   }
 
+  if (!cache_path.empty()) {
+    std::ranges::sort(dependencies);
+    dependencies.erase(std::ranges::unique(dependencies).begin(), dependencies.end());
+
+    try {
+      shader_cache::write(cache_path, key, dependencies, result.code);
+    } catch (const std::exception& exception) {
+      utility::logger<"graphics">::warn("Failed to write shader cache '{}': {}", cache_path.string(), exception.what());
+    }
+  }
+
   return result;
 }
 
@@ -189,16 +308,60 @@ auto compiler::_read_file(const std::filesystem::path& path) -> std::string {
   return std::string{buffer.data(), size};
 }
 
-auto compiler::_create_session(const compile_request& compile_request) -> Slang::ComPtr<slang::ISession> {
+auto compiler::_resolve(const compile_request& compile_request) -> compiler::compile_request {
   auto& assets_module = core::engine::get_module<assets::assets_module>();
 
+  {
+    auto lock = std::scoped_lock{_mutex};
+
+    if (_cache_directory.empty()) {
+      _cache_directory = assets_module.asset_root() / ".cache" / "shaders";
+    }
+  }
+
+  auto resolved_request = compile_request;
+  resolved_request.path = assets_module.resolve_path(compile_request.path);
+
+  return resolved_request;
+}
+
+auto compiler::_cache_key(const compile_request& compile_request, std::span<const std::string> sources) const -> std::uint64_t {
+  auto defines = compile_request.defines;
+
+  std::ranges::sort(defines, [](const auto& lhs, const auto& rhs) { return lhs.key < rhs.key; });
+
+  // Everything that changes the generated code has to be part of the key
+  auto description = fmt::format("{}|{}|{}|{}\n", shader_cache_version, _version, utility::is_build_configuration_debug_v, compile_request.path.string());
+
+  for (const auto& [key, value] : defines) {
+    description += fmt::format("define|{}|{}\n", key, value);
+  }
+
+  for (auto i = 0u; i < stage_infos.size(); ++i) {
+    const auto& [stage, name, file] = stage_infos[i];
+
+    if (auto entry = compile_request.per_stage.find(stage); entry != compile_request.per_stage.end()) {
+      description += fmt::format("stage|{}|{}|{:016x}", name, entry->second.entry_point, shader_cache::hash(sources[i]));
+
+      for (const auto& specialization : entry->second.specializations) {
+        description += fmt::format("|{}", specialization);
+      }
+
+      description += '\n';
+    }
+  }
+
+  return shader_cache::hash(description);
+}
+
+auto compiler::_create_session(slang::IGlobalSession* global_session, const compile_request& compile_request) -> Slang::ComPtr<slang::ISession> {
   auto session = Slang::ComPtr<slang::ISession>{};
 
   auto session_description = slang::SessionDesc{};
 
   auto target_description = slang::TargetDesc{};
   target_description.format = SLANG_SPIRV;
-  target_description.profile = _global_session->findProfile("spirv_1_5");
+  target_description.profile = global_session->findProfile("spirv_1_5");
 
   session_description.targets = &target_description;
   session_description.targetCount = 1u;
@@ -239,8 +402,8 @@ auto compiler::_create_session(const compile_request& compile_request) -> Slang:
   session_description.preprocessorMacros = preprocessor_macro_descriptions.data();
   session_description.preprocessorMacroCount = preprocessor_macro_descriptions.size();
 
-  const auto parent_path = assets_module.resolve_path(compile_request.path.parent_path()).string();
-  const auto path = assets_module.resolve_path(compile_request.path).string();
+  const auto parent_path = compile_request.path.parent_path().string();
+  const auto path = compile_request.path.string();
 
   auto search_paths = std::array<const char*, 2u>{
     parent_path.c_str(),
@@ -250,7 +413,7 @@ auto compiler::_create_session(const compile_request& compile_request) -> Slang:
   session_description.searchPaths = search_paths.data();
   session_description.searchPathCount = search_paths.size();
 
-  _global_session->createSession(session_description, session.writeRef());
+  global_session->createSession(session_description, session.writeRef());
 
   return session;
 }
@@ -1,6 +1,12 @@
 #ifndef LIBSBX_GRAPHICS_PIPELINE_COMPILER_HPP_
 #define LIBSBX_GRAPHICS_PIPELINE_COMPILER_HPP_
 
+#include <span>
+#include <mutex>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+
 #include <vulkan/vulkan.hpp>
 
 #include <slang.h>
@@ -45,15 +51,83 @@ public:
 
   ~compiler();
 
+  /**
+   * @brief Compiles the request. Paths with the res:// prefix are resolved against the asset root.
+   *
+   * Results are cached on disk in @ref cache_directory, which defaults to .cache/shaders in the asset root.
+   */
   auto compile(const compile_request& compile_request) -> compile_result;
 
+  /**
+   * @brief Compiles independent requests in parallel on the executor of the engine. The results are in the order of the requests.
+   */
+  auto compile(std::span<const compile_request> compile_requests) -> std::vector<compile_result>;
+
+  /**
+   * @brief Compiles a request whose path already points to the shader directory on disk. Does not need a running engine.
+   *
+   * Results are only cached if a cache directory was set. Thread safe.
+   */
+  auto compile_resolved(const compile_request& compile_request) -> compile_result;
+
+  auto set_cache_directory(const std::filesystem::path& cache_directory) -> void {
+    auto lock = std::scoped_lock{_mutex};
+
+    _cache_directory = cache_directory;
+  }
+
+  auto cache_directory() const noexcept -> const std::filesystem::path& {
+    return _cache_directory;
+  }
+
 private:
 
+  /**
+   * @brief A global session taken from the pool of the compiler for one compilation. It is returned to the pool when the lease ends.
+   */
+  class global_session_lease {
+
+  public:
+
+    explicit global_session_lease(compiler& owner);
+
+    global_session_lease(const global_session_lease&) = delete;
+
+    ~global_session_lease();
+
+    auto operator=(const global_session_lease&) -> global_session_lease& = delete;
+
+    auto operator->() const noexcept -> slang::IGlobalSession* {
+      return _global_session.get();
+    }
+
+    auto get() const noexcept -> slang::IGlobalSession* {
+      return _global_session.get();
+    }
+
+  private:
+
+    compiler& _compiler;
+    Slang::ComPtr<slang::IGlobalSession> _global_session;
+
+  }; // class global_session_lease
+
   static auto _read_file(const std::filesystem::path& path) -> std::string;
 
-  auto _create_session(const compile_request& compile_request) -> Slang::ComPtr<slang::ISession>;
+  auto _resolve(const compile_request& compile_request) -> compiler::compile_request;
+
+  auto _cache_key(const compile_request& compile_request, std::span<const std::string> sources) const -> std::uint64_t;
+
+  auto _create_session(slang::IGlobalSession* global_session, const compile_request& compile_request) -> Slang::ComPtr<slang::ISession>;
+
+  // Slang sessions must not be used from multiple threads at the same time, so every compilation leases its own global session. Idle sessions
+  // are kept for later compilations, up to one per hardware thread.
+  std::mutex _mutex;
+  std::vector<Slang::ComPtr<slang::IGlobalSession>> _global_sessions;
+  std::size_t _max_global_sessions;
 
-  Slang::ComPtr<slang::IGlobalSession> _global_session;
+  std::string _version;
+  std::filesystem::path _cache_directory;
 
 }; // class compiler
 
@@ -182,14 +182,15 @@ compute_pipeline::compute_pipeline(const std::filesystem::path& path)
   }
 
   for (auto&& [set, descriptor_set_layout_binding] : ranges::views::enumerate(descriptor_set_layout_bindings)) {
+    // Shaders that declare the bindless set use the layout of the bindless table, so the table can be bound with this pipeline
+    if (set == bindless_table::set) {
+      _set_data[set].layout = graphics_module.bindless_table().descriptor_set_layout();
+      continue;
+    }
+
     const auto bindings = utility::map_to<std::vector>(descriptor_set_layout_binding, [](const auto& entry) -> VkDescriptorSetLayoutBinding { return entry.second; });
 
-    auto descriptor_set_layout_create_info = VkDescriptorSetLayoutCreateInfo{};
-    descriptor_set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    descriptor_set_layout_create_info.bindingCount = static_cast<std::uint32_t>(bindings.size());
-    descriptor_set_layout_create_info.pBindings = bindings.data();
-  
-    validate(vkCreateDescriptorSetLayout(logical_device, &descriptor_set_layout_create_info, nullptr, &_set_data[set].layout));
+    _set_data[set].layout = graphics_module.descriptor_layout_cache().get_or_create(bindings);
   }
 
 
@@ -247,7 +248,7 @@ compute_pipeline::compute_pipeline(const std::filesystem::path& path)
   pipeline_create_info.basePipelineIndex = -1;
   pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE;
 
-  validate(vkCreateComputePipelines(logical_device, VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &_handle));
+  validate(vkCreateComputePipelines(logical_device, graphics_module.pipeline_cache(), 1, &pipeline_create_info, nullptr, &_handle));
 
   utility::logger<"graphics">::debug("Pipeline '{}' created in {:.2f}ms", _name, units::quantity_cast<units::millisecond>(timer.elapsed()).value());
 }
@@ -255,21 +256,18 @@ compute_pipeline::compute_pipeline(const std::filesystem::path& path)
 compute_pipeline::~compute_pipeline() {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-  const auto& logical_device = graphics_module.logical_device();
+  const auto logical_device = graphics_module.logical_device().handle();
 
   _shader.reset();
 
-  logical_device.wait_idle();
-
-  vkDestroyDescriptorPool(logical_device, _descriptor_pool, nullptr);
-
-  for (const auto& set_data : _set_data) {
-    vkDestroyDescriptorSetLayout(logical_device, set_data.layout, nullptr);
-  }
+  // The descriptor set layouts are owned by the descriptor layout cache of the module
+  graphics_module.deletion_queue().push([logical_device, descriptor_pool = _descriptor_pool, layout = _layout, handle = _handle]() {
+    vkDestroyDescriptorPool(logical_device, descriptor_pool, nullptr);
 
-  vkDestroyPipelineLayout(logical_device, _layout, nullptr);
+    vkDestroyPipelineLayout(logical_device, layout, nullptr);
 
-  vkDestroyPipeline(logical_device, _handle, nullptr);
+    vkDestroyPipeline(logical_device, handle, nullptr);
+  });
 }
 
 auto compute_pipeline::_get_stage_from_name(const std::string& name) const noexcept -> VkShaderStageFlagBits {
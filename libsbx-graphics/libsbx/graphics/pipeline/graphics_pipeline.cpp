@@ -425,6 +425,12 @@ auto graphics_pipeline::_initialize(const pipeline_definition& definition, const
   input_assembly_state.primitiveRestartEnable = false;
 
   for (auto&& [set, descriptor_set_layout_binding] : ranges::views::enumerate(descriptor_set_layout_bindings)) {
+    // Shaders that declare the bindless set use the layout of the bindless table, so the table can be bound with this pipeline
+    if (set == bindless_table::set) {
+      _set_data[set].layout = graphics_module.bindless_table().descriptor_set_layout();
+      continue;
+    }
+
     auto binding_flags = std::vector<VkDescriptorBindingFlags>{};
 
     for (const auto& [id, binding] : descriptor_set_layout_binding) {
@@ -437,18 +443,8 @@ auto graphics_pipeline::_initialize(const pipeline_definition& definition, const
 
     const auto bindings = utility::map_to<std::vector>(descriptor_set_layout_binding, [](const auto& entry) -> VkDescriptorSetLayoutBinding { return entry.second; });
 
-    auto descriptor_set_layout_binding_flags_create_info = VkDescriptorSetLayoutBindingFlagsCreateInfo{};
-    descriptor_set_layout_binding_flags_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
-    descriptor_set_layout_binding_flags_create_info.bindingCount = static_cast<std::uint32_t>(binding_flags.size());
-    descriptor_set_layout_binding_flags_create_info.pBindingFlags = binding_flags.data();
-
-    auto descriptor_set_layout_create_info = VkDescriptorSetLayoutCreateInfo{};
-    descriptor_set_layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-    descriptor_set_layout_create_info.pNext = &descriptor_set_layout_binding_flags_create_info;
-    descriptor_set_layout_create_info.bindingCount = static_cast<std::uint32_t>(bindings.size());
-    descriptor_set_layout_create_info.pBindings = bindings.data();
-
-    validate(vkCreateDescriptorSetLayout(logical_device, &descriptor_set_layout_create_info, nullptr, &_set_data[set].layout));
+    // Layouts are shared between pipelines with the same bindings, so descriptor sets from the set cache can be reused across them
+    _set_data[set].layout = graphics_module.descriptor_layout_cache().get_or_create(bindings, binding_flags);
   }
 
   // [NOTE] KAJ 2023-09-13 : Workaround
@@ -532,7 +528,7 @@ auto graphics_pipeline::_initialize(const pipeline_definition& definition, const
   pipeline_create_info.basePipelineIndex = -1;
   pipeline_create_info.basePipelineHandle = VK_NULL_HANDLE;
 
-  validate(vkCreateGraphicsPipelines(logical_device, VK_NULL_HANDLE, 1, &pipeline_create_info, nullptr, &_handle));
+  validate(vkCreateGraphicsPipelines(logical_device, graphics_module.pipeline_cache(), 1, &pipeline_create_info, nullptr, &_handle));
 
   utility::logger<"graphics">::debug("Pipeline '{}' created in {:.2f}ms", _name, units::quantity_cast<units::millisecond>(timer.elapsed()).value());
 }
@@ -540,21 +536,18 @@ auto graphics_pipeline::_initialize(const pipeline_definition& definition, const
 graphics_pipeline::~graphics_pipeline() {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-  const auto& logical_device = graphics_module.logical_device();
+  const auto logical_device = graphics_module.logical_device().handle();
 
   _shaders.clear();
 
-  logical_device.wait_idle();
-
-  vkDestroyDescriptorPool(logical_device, _descriptor_pool, nullptr);
-  
-  for (const auto& set_data : _set_data) {
-    vkDestroyDescriptorSetLayout(logical_device, set_data.layout, nullptr);
-  }
+  // The descriptor set layouts are owned by the descriptor layout cache of the module
+  graphics_module.deletion_queue().push([logical_device, descriptor_pool = _descriptor_pool, layout = _layout, handle = _handle]() {
+    vkDestroyDescriptorPool(logical_device, descriptor_pool, nullptr);
 
-  vkDestroyPipelineLayout(logical_device, _layout, nullptr);
+    vkDestroyPipelineLayout(logical_device, layout, nullptr);
 
-  vkDestroyPipeline(logical_device, _handle, nullptr);
+    vkDestroyPipeline(logical_device, handle, nullptr);
+  });
 }
 
 auto graphics_pipeline::handle() const noexcept -> VkPipeline {
@@ -26,7 +26,6 @@
 #include <libsbx/graphics/pipeline/vertex_input_description.hpp>
 
 #include <libsbx/graphics/descriptor/descriptor.hpp>
-#include <libsbx/graphics/descriptor/descriptor_set.hpp>
 
 #include <libsbx/graphics/images/image2d.hpp>
 
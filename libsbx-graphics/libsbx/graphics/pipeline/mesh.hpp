@@ -1,7 +1,10 @@
 #ifndef LIBSBX_GRAPHICS_PIPELINE_MESH_HPP_
 #define LIBSBX_GRAPHICS_PIPELINE_MESH_HPP_
 
+#include <array>
+#include <algorithm>
 #include <memory>
+#include <span>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -29,13 +32,38 @@ namespace sbx::graphics {
 // template<typename Type>
 // using index_buffer = typed_buffer<Type, (VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT), VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT>;
 
+struct submesh_lod {
+  std::uint32_t index_count;
+  std::uint32_t index_offset;
+  // Largest deviation from the full detail surface in the space of the mesh
+  std::float_t error;
+}; // struct submesh_lod
+
 struct submesh {
+
+  inline static constexpr auto max_lod_count = std::size_t{4u};
+
   std::uint32_t index_count;
   std::uint32_t index_offset;
   std::uint32_t vertex_offset;
   math::volume bounds;
   math::matrix4x4 local_transform;
   utility::hashed_string name;
+  // Simplified levels of detail with increasing error, they share the vertices of the submesh
+  std::uint32_t lod_count{0u};
+  std::array<submesh_lod, max_lod_count> lods{};
+
+  /**
+   * @brief Returns the indices of a level of detail, level 0 is the submesh itself and levels above lod_count are clamped.
+   */
+  auto lod(const std::uint32_t level) const noexcept -> submesh_lod {
+    if (level == 0u || lod_count == 0u) {
+      return submesh_lod{index_count, index_offset, 0.0f};
+    }
+
+    return lods[std::min(level, lod_count) - 1u];
+  }
+
 }; // struct submesh
 
 template<vertex Vertex>
@@ -132,10 +160,17 @@ protected:
 
   mesh(mesh_data&& mesh_data);
 
+  /**
+   * @brief Uploads vertices and indices that are owned by someone else, e.g. a memory mapped file. They are only read during construction.
+   */
+  mesh(std::span<const vertex_type> vertices, std::span<const index_type> indices, std::vector<graphics::submesh>&& submeshes, const math::volume& bounds = math::volume{});
+
   auto _upload_vertices(const std::vector<vertex_type>& vertices, const std::vector<index_type>& indices) -> void;
 
   auto _upload_vertices(std::vector<vertex_type>&& vertices, std::vector<index_type>&& indices) -> void;
 
+  auto _upload_vertices(std::span<const vertex_type> vertices, std::span<const index_type> indices) -> void;
+
   auto _calculate_bounds_from_submeshes(math::volume&& bounds) const -> math::volume;
 
   // vertex_buffer_type _vertex_buffer;
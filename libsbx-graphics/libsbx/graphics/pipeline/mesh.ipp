@@ -69,6 +69,27 @@ mesh<Vertex>::mesh(mesh_data&& mesh_data)
   _upload_vertices(std::move(mesh_data.vertices), std::move(mesh_data.indices));
 }
 
+template<vertex Vertex>
+mesh<Vertex>::mesh(std::span<const vertex_type> vertices, std::span<const index_type> indices, std::vector<graphics::submesh>&& submeshes, const math::volume& bounds)
+: _submeshes{std::move(submeshes)},
+  _bounds{_calculate_bounds_from_submeshes(math::volume{bounds})} {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  _vertex_buffer = graphics_module.add_resource<buffer>(
+    (vertices.size() * sizeof(vertex_type)),
+    (VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT), 
+    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+  );
+
+  _index_buffer = graphics_module.add_resource<buffer>(
+    (indices.size() * sizeof(index_type)),
+    (VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT),
+    VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+  );
+
+  _upload_vertices(vertices, indices);
+}
+
 template<vertex Vertex>
 mesh<Vertex>::~mesh() {
 
@@ -130,51 +151,29 @@ auto mesh<Vertex>::submeshes() const noexcept -> const std::vector<graphics::sub
 
 template<vertex Vertex>
 auto mesh<Vertex>::_upload_vertices(const std::vector<vertex_type>& vertices, const std::vector<index_type>& indices) -> void {
-
+  _upload_vertices(std::span<const vertex_type>{vertices}, std::span<const index_type>{indices});
 }
 
 template<vertex Vertex>
 auto mesh<Vertex>::_upload_vertices(std::vector<vertex_type>&& vertices, std::vector<index_type>&& indices) -> void {
+  _upload_vertices(std::span<const vertex_type>{vertices}, std::span<const index_type>{indices});
+}
+
+template<vertex Vertex>
+auto mesh<Vertex>::_upload_vertices(std::span<const vertex_type> vertices, std::span<const index_type> indices) -> void {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
   auto vertex_buffer_size = vertices.size() * sizeof(vertex_type);
   auto index_buffer_size = indices.size() * sizeof(index_type);
 
-  auto staging_buffer_size = vertex_buffer_size + index_buffer_size;
-
-  // [NOTE] KAJ 2024-01-19 : We basically store two different types in here. The staging_buffer_size is in bytes so we use std::uint8_t.
-  auto staging_buffer = graphics::staging_buffer{staging_buffer_size};
-
-  staging_buffer.write(vertices.data(), vertex_buffer_size);
-  staging_buffer.write(indices.data(), index_buffer_size, vertex_buffer_size);
-
-  // _vertex_buffer = std::make_unique<vertex_buffer_type>(vertices.size());
-  // _index_buffer = std::make_unique<index_buffer_type>(indices.size());
-
-  auto command_buffer = graphics::command_buffer{true, VK_QUEUE_TRANSFER_BIT};
-
   auto& index_buffer = graphics_module.get_resource<buffer>(_index_buffer);
   auto& vertex_buffer = graphics_module.get_resource<buffer>(_vertex_buffer); 
 
-  {
-    auto copy_region = VkBufferCopy{};
-    copy_region.size = vertex_buffer_size;
-    copy_region.dstOffset = 0;
-    copy_region.srcOffset = 0;
-
-    command_buffer.copy_buffer(staging_buffer, vertex_buffer, copy_region);
-  }
-
-  {
-    auto copy_region = VkBufferCopy{};
-    copy_region.size = index_buffer_size;
-    copy_region.dstOffset = 0;
-    copy_region.srcOffset = vertex_buffer_size;
-
-    command_buffer.copy_buffer(staging_buffer, index_buffer, copy_region);
-  }
+  // The copies are batched with the other uploads of this frame and submitted before the frame is rendered
+  auto& upload_manager = graphics_module.upload_manager();
 
-  command_buffer.submit_idle();
+  upload_manager.upload(vertex_buffer, vertices.data(), vertex_buffer_size);
+  upload_manager.upload(index_buffer, indices.data(), index_buffer_size);
 }
 
 template<vertex Vertex>
@@ -183,7 +182,7 @@ auto mesh<Vertex>::_calculate_bounds_from_submeshes(math::volume&& bounds) const
     return bounds;
   }
 
-  auto min = _submeshes[0].bounds.max();
+  auto min = _submeshes[0].bounds.min();
   auto max = _submeshes[0].bounds.max();
 
   for (auto i = 1u; i < _submeshes.size(); ++i) {
@@ -0,0 +1,117 @@
+#include <libsbx/graphics/pipeline/pipeline_cache.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+#include <libsbx/utility/logger.hpp>
+#include <libsbx/utility/exception.hpp>
+
+#include <libsbx/graphics/graphics_module.hpp>
+
+namespace sbx::graphics {
+
+static auto read_file(const std::filesystem::path& path) -> std::vector<char> {
+  auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+
+  if (!file) {
+    return {};
+  }
+
+  const auto size = static_cast<std::size_t>(file.tellg());
+
+  file.seekg(0, std::ios::beg);
+
+  auto data = std::vector<char>(size);
+
+  if (!file.read(data.data(), static_cast<std::streamsize>(size))) {
+    return {};
+  }
+
+  return data;
+}
+
+pipeline_cache::pipeline_cache(const physical_device& physical_device, const logical_device& logical_device, const std::filesystem::path& path)
+: _logical_device{logical_device},
+  _path{path},
+  _handle{VK_NULL_HANDLE} {
+  auto data = read_file(_path);
+
+  if (!data.empty() && !_is_compatible(data, physical_device.properties())) {
+    utility::logger<"graphics">::info("Ignoring pipeline cache '{}' written by a different driver or device", _path.string());
+    data.clear();
+  }
+
+  auto pipeline_cache_create_info = VkPipelineCacheCreateInfo{};
+  pipeline_cache_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+  pipeline_cache_create_info.initialDataSize = data.size();
+  pipeline_cache_create_info.pInitialData = data.empty() ? nullptr : data.data();
+
+  validate(vkCreatePipelineCache(_logical_device, &pipeline_cache_create_info, nullptr, &_handle));
+
+  utility::logger<"graphics">::debug("Loaded pipeline cache '{}' ({} bytes)", _path.string(), data.size());
+}
+
+pipeline_cache::~pipeline_cache() {
+  try {
+    save();
+  } catch (const std::exception& exception) {
+    utility::logger<"graphics">::warn("Failed to save pipeline cache '{}': {}", _path.string(), exception.what());
+  }
+
+  vkDestroyPipelineCache(_logical_device, _handle, nullptr);
+}
+
+auto pipeline_cache::save() const -> void {
+  auto size = std::size_t{0u};
+
+  validate(vkGetPipelineCacheData(_logical_device, _handle, &size, nullptr));
+
+  auto data = std::vector<char>(size);
+
+  validate(vkGetPipelineCacheData(_logical_device, _handle, &size, data.data()));
+
+  data.resize(size);
+
+  std::filesystem::create_directories(_path.parent_path());
+
+  // Write to a temporary file first so a crash never leaves a truncated cache behind
+  auto temporary_path = _path;
+  temporary_path += ".tmp";
+
+  {
+    auto file = std::ofstream{temporary_path, std::ios::binary | std::ios::trunc};
+
+    if (!file.is_open()) {
+      throw utility::runtime_error{"Failed to open pipeline cache '{}' for writing", temporary_path.string()};
+    }
+
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+
+    if (!file) {
+      throw utility::runtime_error{"Failed to write pipeline cache '{}'", temporary_path.string()};
+    }
+  }
+
+  std::filesystem::rename(temporary_path, _path);
+
+  utility::logger<"graphics">::debug("Saved pipeline cache '{}' ({} bytes)", _path.string(), data.size());
+}
+
+auto pipeline_cache::_is_compatible(std::span<const char> data, const VkPhysicalDeviceProperties& properties) -> bool {
+  if (data.size() < sizeof(VkPipelineCacheHeaderVersionOne)) {
+    return false;
+  }
+
+  auto header = VkPipelineCacheHeaderVersionOne{};
+
+  std::memcpy(&header, data.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+
+  return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)
+    && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+    && header.vendorID == properties.vendorID
+    && header.deviceID == properties.deviceID
+    && std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+}
+
+} // namespace sbx::graphics
@@ -0,0 +1,54 @@
+#ifndef LIBSBX_GRAPHICS_PIPELINE_PIPELINE_CACHE_HPP_
+#define LIBSBX_GRAPHICS_PIPELINE_PIPELINE_CACHE_HPP_
+
+#include <span>
+#include <filesystem>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/utility/noncopyable.hpp>
+
+#include <libsbx/graphics/devices/physical_device.hpp>
+#include <libsbx/graphics/devices/logical_device.hpp>
+
+namespace sbx::graphics {
+
+/**
+ * @brief VkPipelineCache that is loaded from disk when it is created and written back when it is destroyed.
+ *
+ * Data written by another driver or device is ignored, the cache then starts empty. Pipelines can be created with the cache from multiple threads.
+ */
+class pipeline_cache final : public utility::noncopyable {
+
+public:
+
+  pipeline_cache(const physical_device& physical_device, const logical_device& logical_device, const std::filesystem::path& path);
+
+  ~pipeline_cache();
+
+  auto handle() const noexcept -> VkPipelineCache {
+    return _handle;
+  }
+
+  operator VkPipelineCache() const noexcept {
+    return _handle;
+  }
+
+  /**
+   * @brief Writes the current contents of the cache to disk.
+   */
+  auto save() const -> void;
+
+private:
+
+  static auto _is_compatible(std::span<const char> data, const VkPhysicalDeviceProperties& properties) -> bool;
+
+  const logical_device& _logical_device;
+  std::filesystem::path _path;
+  VkPipelineCache _handle;
+
+}; // class pipeline_cache
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_PIPELINE_PIPELINE_CACHE_HPP_
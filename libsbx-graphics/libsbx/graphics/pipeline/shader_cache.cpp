@@ -0,0 +1,230 @@
+#include <libsbx/graphics/pipeline/shader_cache.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <thread>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+#include <libsbx/utility/exception.hpp>
+#include <libsbx/utility/hash.hpp>
+
+namespace sbx::graphics {
+
+static_assert(std::endian::native == std::endian::little, "The shader cache format is only supported on little endian targets");
+
+static_assert(std::is_trivially_copyable_v<shader_cache_header>);
+static_assert(std::is_trivially_copyable_v<shader_cache_dependency>);
+static_assert(std::is_trivially_copyable_v<shader_cache_stage>);
+
+namespace {
+
+auto read_file(const std::filesystem::path& path) -> std::optional<std::string> {
+  auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+
+  if (!file) {
+    return std::nullopt;
+  }
+
+  const auto size = static_cast<std::size_t>(file.tellg());
+
+  file.seekg(0, std::ios::beg);
+
+  auto contents = std::string(size, '\0');
+
+  if (!file.read(contents.data(), static_cast<std::streamsize>(size))) {
+    return std::nullopt;
+  }
+
+  return contents;
+}
+
+class payload_reader {
+
+public:
+
+  payload_reader(const std::filesystem::path& path, std::string_view payload)
+  : _path{path},
+    _payload{payload} { }
+
+  template<typename Type>
+  requires (std::is_trivially_copyable_v<Type>)
+  auto read() -> Type {
+    auto value = Type{};
+
+    std::memcpy(&value, _take(sizeof(Type)).data(), sizeof(Type));
+
+    return value;
+  }
+
+  auto read_string(const std::size_t size) -> std::string_view {
+    return _take(size);
+  }
+
+  auto read_words(std::vector<std::uint32_t>& words) -> void {
+    const auto bytes = _take(words.size() * sizeof(std::uint32_t));
+
+    std::memcpy(words.data(), bytes.data(), bytes.size());
+  }
+
+  auto is_done() const noexcept -> bool {
+    return _offset == _payload.size();
+  }
+
+private:
+
+  auto _take(const std::size_t size) -> std::string_view {
+    if (size > _payload.size() - _offset) {
+      throw utility::runtime_error{"Shader cache '{}' is truncated", _path.string()};
+    }
+
+    const auto result = _payload.substr(_offset, size);
+
+    _offset += size;
+
+    return result;
+  }
+
+  const std::filesystem::path& _path;
+  std::string_view _payload;
+  std::size_t _offset{0u};
+
+}; // class payload_reader
+
+template<typename Type>
+requires (std::is_trivially_copyable_v<Type>)
+auto append(std::string& payload, const Type& value) -> void {
+  payload.append(reinterpret_cast<const char*>(&value), sizeof(Type));
+}
+
+} // namespace
+
+auto shader_cache::hash(std::string_view contents) noexcept -> std::uint64_t {
+  return utility::fnv1a_hash<char>{}(contents);
+}
+
+auto shader_cache::path(const std::filesystem::path& directory, const std::uint64_t key) -> std::filesystem::path {
+  return directory / fmt::format("{:016x}{}", key, shader_cache_extension);
+}
+
+auto shader_cache::read(const std::filesystem::path& path, const std::uint64_t key) -> std::optional<code_type> {
+  const auto contents = read_file(path);
+
+  if (!contents) {
+    return std::nullopt;
+  }
+
+  if (contents->size() < sizeof(shader_cache_header)) {
+    throw utility::runtime_error{"Shader cache '{}' is too small", path.string()};
+  }
+
+  auto header = shader_cache_header{};
+
+  std::memcpy(&header, contents->data(), sizeof(shader_cache_header));
+
+  if (header.magic != shader_cache_magic) {
+    throw utility::runtime_error{"Shader cache '{}' has an invalid magic", path.string()};
+  }
+
+  if (header.version != shader_cache_version || header.key != key) {
+    return std::nullopt;
+  }
+
+  const auto payload = std::string_view{*contents}.substr(sizeof(shader_cache_header));
+
+  if (header.payload_size != payload.size()) {
+    throw utility::runtime_error{"Shader cache '{}' is truncated", path.string()};
+  }
+
+  if (hash(payload) != header.checksum) {
+    throw utility::runtime_error{"Shader cache '{}' failed its checksum", path.string()};
+  }
+
+  auto reader = payload_reader{path, payload};
+
+  for (auto i = 0u; i < header.dependency_count; ++i) {
+    const auto dependency = reader.read<shader_cache_dependency>();
+    const auto dependency_path = std::filesystem::path{reader.read_string(dependency.path_size)};
+
+    const auto dependency_contents = read_file(dependency_path);
+
+    if (!dependency_contents || hash(*dependency_contents) != dependency.hash) {
+      return std::nullopt;
+    }
+  }
+
+  auto code = code_type{};
+
+  for (auto i = 0u; i < header.stage_count; ++i) {
+    const auto stage = reader.read<shader_cache_stage>();
+
+    auto& words = code[static_cast<SlangStage>(stage.stage)];
+    words.resize(stage.word_count);
+
+    reader.read_words(words);
+  }
+
+  if (!reader.is_done()) {
+    throw utility::runtime_error{"Shader cache '{}' has trailing data", path.string()};
+  }
+
+  return code;
+}
+
+auto shader_cache::write(const std::filesystem::path& path, const std::uint64_t key, std::span<const std::filesystem::path> dependencies, const code_type& code) -> void {
+  auto payload = std::string{};
+
+  for (const auto& dependency : dependencies) {
+    const auto contents = read_file(dependency);
+
+    if (!contents) {
+      throw utility::runtime_error{"Failed to read shader cache dependency '{}'", dependency.string()};
+    }
+
+    const auto dependency_path = dependency.string();
+
+    append(payload, shader_cache_dependency{hash(*contents), static_cast<std::uint32_t>(dependency_path.size()), 0u});
+    payload.append(dependency_path);
+  }
+
+  for (const auto& [stage, words] : code) {
+    append(payload, shader_cache_stage{static_cast<std::uint32_t>(stage), static_cast<std::uint32_t>(words.size())});
+    payload.append(reinterpret_cast<const char*>(words.data()), words.size() * sizeof(std::uint32_t));
+  }
+
+  auto header = shader_cache_header{};
+  header.magic = shader_cache_magic;
+  header.version = shader_cache_version;
+  header.stage_count = static_cast<std::uint32_t>(code.size());
+  header.dependency_count = static_cast<std::uint32_t>(dependencies.size());
+  header.key = key;
+  header.payload_size = payload.size();
+  header.checksum = hash(payload);
+
+  std::filesystem::create_directories(path.parent_path());
+
+  // Requests compiled in parallel may write the same entry, so every thread writes its own temporary file
+  auto temporary_path = path;
+  temporary_path += fmt::format(".{:x}.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+
+  {
+    auto file = std::ofstream{temporary_path, std::ios::binary | std::ios::trunc};
+
+    if (!file.is_open()) {
+      throw utility::runtime_error{"Failed to open shader cache '{}' for writing", temporary_path.string()};
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(shader_cache_header));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+
+    if (!file) {
+      throw utility::runtime_error{"Failed to write shader cache '{}'", temporary_path.string()};
+    }
+  }
+
+  std::filesystem::rename(temporary_path, path);
+}
+
+} // namespace sbx::graphics
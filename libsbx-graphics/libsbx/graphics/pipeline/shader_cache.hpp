@@ -0,0 +1,91 @@
+#ifndef LIBSBX_GRAPHICS_PIPELINE_SHADER_CACHE_HPP_
+#define LIBSBX_GRAPHICS_PIPELINE_SHADER_CACHE_HPP_
+
+#include <cstdint>
+#include <array>
+#include <span>
+#include <vector>
+#include <optional>
+#include <string_view>
+#include <filesystem>
+#include <unordered_map>
+
+#include <slang.h>
+
+namespace sbx::graphics {
+
+/**
+ * @brief Content addressed on-disk cache of compiled SPIR-V, one .sbxspv file per compile request.
+ *
+ * The file name is the key of the request, a hash over the compiler version, the compiler options, the defines, the entry points and the contents
+ * of the stage sources. Files that are only pulled in by the stage sources are recorded in the entry together with the hash of their contents, an
+ * entry is only used while all of them are unchanged.
+ *
+ * The file starts with a shader_cache_header followed by the payload. The payload holds one shader_cache_dependency per dependency followed by its
+ * path, then one shader_cache_stage per stage followed by its SPIR-V words. Data is stored in little endian byte order.
+ */
+inline constexpr auto shader_cache_extension = std::string_view{".sbxspv"};
+
+inline constexpr auto shader_cache_magic = std::array<char, 8u>{'S', 'B', 'X', 'S', 'P', 'V', '\0', '\0'};
+
+inline constexpr auto shader_cache_version = std::uint32_t{1u};
+
+struct shader_cache_header {
+  std::array<char, 8u> magic;
+  std::uint32_t version;
+  std::uint32_t stage_count;
+  std::uint32_t dependency_count;
+  std::uint32_t _pad0;
+  std::uint64_t key;
+  std::uint64_t payload_size;
+  // FNV-1a hash of the payload
+  std::uint64_t checksum;
+}; // struct shader_cache_header
+
+struct shader_cache_dependency {
+  // FNV-1a hash of the file contents
+  std::uint64_t hash;
+  std::uint32_t path_size;
+  std::uint32_t _pad0;
+}; // struct shader_cache_dependency
+
+struct shader_cache_stage {
+  std::uint32_t stage;
+  std::uint32_t word_count;
+}; // struct shader_cache_stage
+
+class shader_cache final {
+
+public:
+
+  using code_type = std::unordered_map<SlangStage, std::vector<std::uint32_t>>;
+
+  shader_cache() = delete;
+
+  /**
+   * @brief Hashes the contents of a source file the way the cache does.
+   */
+  static auto hash(std::string_view contents) noexcept -> std::uint64_t;
+
+  /**
+   * @brief Returns the path of the entry for key in directory.
+   */
+  static auto path(const std::filesystem::path& directory, const std::uint64_t key) -> std::filesystem::path;
+
+  /**
+   * @brief Reads the entry at path. Returns std::nullopt if there is no entry for key or one of its dependencies changed.
+   *
+   * Throws a utility::runtime_error if the file is malformed.
+   */
+  static auto read(const std::filesystem::path& path, const std::uint64_t key) -> std::optional<code_type>;
+
+  /**
+   * @brief Writes the entry for key, recording the current contents of the dependencies.
+   */
+  static auto write(const std::filesystem::path& path, const std::uint64_t key, std::span<const std::filesystem::path> dependencies, const code_type& code) -> void;
+
+}; // class shader_cache
+
+} // namespace sbx::graphics
+
+#endif // LIBSBX_GRAPHICS_PIPELINE_SHADER_CACHE_HPP_
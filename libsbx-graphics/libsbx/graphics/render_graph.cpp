@@ -1,12 +1,16 @@
 #include <libsbx/graphics/render_graph.hpp>
 
-#include <queue>
+#include <algorithm>
 
 #include <libsbx/utility/logger.hpp>
 #include <libsbx/utility/exception.hpp>
 
 #include <libsbx/math/color.hpp>
 
+#include <libsbx/containers/task_graph.hpp>
+
+#include <libsbx/core/engine.hpp>
+
 #include <libsbx/graphics/graphics_module.hpp>
 
 #include <libsbx/graphics/descriptor/descriptor.hpp>
@@ -94,6 +98,18 @@ graphics_pass::graphics_pass(graph_base& graph, graphics_node& node)
 compute_pass::compute_pass(compute_node& node)
 : _node{node} { }
 
+auto compute_pass::name() const -> const utility::hashed_string& {
+  return _node._name;
+}
+
+auto compute_pass::inputs() const -> const std::vector<utility::hashed_string>& {
+  return _node._inputs;
+}
+
+auto compute_pass::outputs() const -> const std::vector<utility::hashed_string>& {
+  return _node._outputs;
+}
+
 auto context::graphics_pass(const utility::hashed_string& name, const viewport& viewport) -> detail::graphics_pass {
   return detail::graphics_pass{_graph, _graph.emplace_back<detail::graphics_node>(name, viewport)};
 }
@@ -109,125 +125,82 @@ graph_builder::graph_builder(graph_base& graph)
 : _graph{graph} { }
 
 auto graph_builder::build() -> void {
-  auto attachment_producers = std::unordered_map<utility::hashed_string, utility::hashed_string>{};
-  auto pass_dependencies = std::unordered_map<utility::hashed_string, std::unordered_set<utility::hashed_string>>{};
+  auto passes = std::vector<pass_description>{};
+  passes.reserve(_graph._graphics_nodes.size() + _graph._compute_nodes.size());
 
+  // Passes in declaration order, graphics passes first
   for (const auto& node : _graph._graphics_nodes) {
-    for (const auto& output : node._outputs) {
-      attachment_producers[output.name()] = node._name;
-    }
-  }
+    auto& pass = passes.emplace_back(pass_description{node._name, false, node._inputs, {}});
 
-  for (const auto& node : _graph._graphics_nodes) {
-    for (const auto& input : node._inputs) {
-      if (auto entry = attachment_producers.find(input); entry != attachment_producers.end()) {
-        pass_dependencies[node._name].insert(entry->second);
-      } else {
-        throw utility::runtime_error{"No producer for attachment '{}'", input.str()};
+    for (const auto& output : node._outputs) {
+      switch (output.image_type()) {
+        case attachment::type::depth: {
+          pass.outputs.push_back(pass_output{output.name(), output_type::depth});
+          break;
+        }
+        case attachment::type::swapchain: {
+          pass.outputs.push_back(pass_output{output.name(), output_type::swapchain});
+          break;
+        }
+        default: {
+          pass.outputs.push_back(pass_output{output.name(), output_type::color});
+          break;
+        }
       }
     }
   }
 
-  auto dependents = std::unordered_map<utility::hashed_string, std::uint32_t>{};
-
-  for (const auto& [pass, dependencies] : pass_dependencies) {
-    dependents[pass] = dependencies.size();
-  }
-
-  for (const auto& node : _graph._graphics_nodes) {
-    // This only inserts 0 is the key does not already exist
-    dependents.emplace(node._name, 0u);
-  }
+  for (const auto& node : _graph._compute_nodes) {
+    auto& pass = passes.emplace_back(pass_description{node._name, true, node._inputs, {}});
 
-  auto ready = std::queue<utility::hashed_string>{};
-
-  for (const auto& [pass, dependencies] : dependents) {
-    if (dependencies == 0u) {
-      ready.push(pass);
-    }
-  }
-
-  auto sorted_passes = std::vector<utility::hashed_string>{};
-
-  while (!ready.empty()) {
-    auto current = ready.front();
-    ready.pop();
-    
-    sorted_passes.push_back(current);
-
-    for (auto& [pass, dependencies] : pass_dependencies) {
-      if (dependencies.erase(current) && --dependents[pass] == 0) {
-        ready.push(pass);
-      }
+    for (const auto& output : node._outputs) {
+      pass.outputs.push_back(pass_output{output, output_type::buffer});
     }
   }
 
-  auto swapchain_attachment_name = utility::hashed_string{};
-
-  for (const auto& pass_name : sorted_passes) {
-    auto node = std::ranges::find_if(_graph._graphics_nodes, [&](const auto& n) {
-      return n._name == pass_name;
+  for (const auto& name : _graph._transient_attachments) {
+    const auto is_color_image = std::ranges::any_of(_graph._graphics_nodes, [&](const auto& node) {
+      return std::ranges::any_of(node._outputs, [&](const auto& output) { return output.name() == name && output.image_type() == attachment::type::image; });
     });
 
-    if (node == _graph._graphics_nodes.end()) {
-      continue;
+    if (!is_color_image) {
+      throw utility::runtime_error{"Transient attachment '{}' is not a color image attachment", name.str()};
     }
+  }
 
-    for (const auto& input : node->_inputs) {
-      const auto required_layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+  const auto order = sort_passes(passes);
 
-      auto& attachment_state = _attachment_states[input];
+  auto plan = plan_barriers(passes, order);
 
-      if (attachment_state.current_layout != required_layout) {
-        _instructions.emplace_back(transition_instruction{
-          .attachment = input,
-          .old_layout = attachment_state.current_layout,
-          .new_layout = required_layout
-        });
+  _attachment_lifetimes = std::move(plan.lifetimes);
 
-        attachment_state.current_layout = required_layout;
-      }
+  for (auto index = 0u; index < order.size(); ++index) {
+    if (!plan.barriers[index].is_empty()) {
+      _instructions.emplace_back(std::move(plan.barriers[index]));
     }
 
-    auto attachments = std::vector<utility::hashed_string>{};
-
-    for (const auto& output : node->_outputs) {
-      const auto target_layout = output.image_type() == attachment::type::depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    if (order[index] < _graph._graphics_nodes.size()) {
+      auto& node = _graph._graphics_nodes[order[index]];
 
-      auto& attachment_state = _attachment_states[output.name()];
+      auto attachments = std::vector<utility::hashed_string>{};
+      attachments.reserve(node._outputs.size());
 
-      if (attachment_state.current_layout != target_layout) {
-        _instructions.emplace_back(transition_instruction{
-          .attachment = output.name(),
-          .old_layout = attachment_state.current_layout,
-          .new_layout = target_layout
-        });
-
-        attachment_state.current_layout = target_layout;
-      } 
-      
-      if (output.image_type() == attachment::type::swapchain) {
-        swapchain_attachment_name = output.name();
+      for (const auto& output : node._outputs) {
+        attachments.push_back(output.name());
       }
 
-      attachments.push_back(output.name());
+      _instructions.emplace_back(pass_instruction{
+        .node = node,
+        .attachments = std::move(attachments)
+      });
+    } else {
+      _instructions.emplace_back(compute_instruction{
+        .node = _graph._compute_nodes[order[index] - _graph._graphics_nodes.size()]
+      });
     }
-
-    _instructions.emplace_back(pass_instruction{
-      .node = *node,
-      .attachments = attachments
-    });
-  }
-
-  if (swapchain_attachment_name.is_empty()) {
-    throw utility::runtime_error("Render graph does not containe swapchain attachment");
   }
 
-  _instructions.emplace_back(transition_instruction{
-    .attachment = swapchain_attachment_name,
-    .old_layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
-    .new_layout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
-  });
+  _instructions.emplace_back(std::move(plan.present));
 }
 
 auto graph_builder::resize(const viewport::type flags) -> void {
@@ -238,6 +211,8 @@ auto graph_builder::resize(const viewport::type flags) -> void {
   for (const auto& node : _graph._graphics_nodes) {
     _create_attachments(flags, node);
   }
+
+  _create_transient_attachments();
 }
 
 auto graph_builder::attachment(const std::string& name) const -> const descriptor& {
@@ -275,6 +250,34 @@ auto graph_builder::_update_viewports() -> void {
   }
 }
 
+auto graph_builder::_update_draw_lists() -> void {
+  auto& executor = core::engine::executor();
+
+  auto graph = containers::task_graph{"draw_lists"};
+
+  for (auto& [key, draw_list] : _graph._draw_lists) {
+    draw_list->clear();
+    draw_list->prepare();
+  }
+
+  // Lists that are not thread safe are updated on the calling thread before the rest runs on the workers
+  for (auto& [key, draw_list] : _graph._draw_lists) {
+    if (draw_list->is_thread_safe() && executor.size() > 0u) {
+      graph.emplace([&draw_list]() {
+        draw_list->update();
+      });
+    } else {
+      draw_list->update();
+    }
+  }
+
+  executor.run_and_wait(graph);
+
+  for (auto& [key, draw_list] : _graph._draw_lists) {
+    draw_list->flush();
+  }
+}
+
 auto graph_builder::_clear_all_attachments() -> void {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
@@ -291,11 +294,21 @@ auto graph_builder::_clear_all_attachments() -> void {
   _depth_images.clear();
 
   _attachment_states.clear();
+
+  auto& allocator = graphics_module.allocator();
+
+  for (auto& memory : _transient_memory) {
+    vmaFreeMemory(allocator, memory);
+  }
+
+  _transient_memory.clear();
 }
 
 auto graph_builder::_clear_attachments(const viewport::type flags) -> void {
   auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
+  auto has_transient_attachments = false;
+
   for (auto& node : _graph._graphics_nodes) {
     const auto& viewport = node._viewport;
 
@@ -306,6 +319,11 @@ auto graph_builder::_clear_attachments(const viewport::type flags) -> void {
     for (const auto& attachment : node._outputs) {
       switch (attachment.image_type()) {
         case attachment::type::image: {
+          if (_graph._transient_attachments.contains(attachment.name())) {
+            has_transient_attachments = true;
+            break;
+          }
+
           auto entry = _color_images.find(attachment.name());
 
           if (entry != _color_images.end()) {
@@ -341,6 +359,21 @@ auto graph_builder::_clear_attachments(const viewport::type flags) -> void {
       }
     }
   }
+
+  // Aliased attachments share memory, so they are always recreated together
+  if (has_transient_attachments) {
+    _destroy_transient_attachments();
+  }
+}
+
+static constexpr auto color_attachment_usage = VkImageUsageFlags{VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT};
+
+static auto color_attachment_filter(const attachment& attachment) -> VkFilter {
+  if (attachment.format() == format::r32_uint || attachment.format() == format::r64_uint || attachment.format() == format::r32g32_uint) {
+    return VK_FILTER_NEAREST;
+  }
+
+  return VK_FILTER_LINEAR;
 }
 
 auto graph_builder::_create_attachments(const viewport::type flags, const graphics_node& node) -> void {
@@ -353,44 +386,13 @@ auto graph_builder::_create_attachments(const viewport::type flags, const graphi
   for (const auto& attachment : node._outputs) {
     switch (attachment.image_type()) {
       case attachment::type::image: {
-        if (_color_images.contains(attachment.name())) {
+        if (_color_images.contains(attachment.name()) || _graph._transient_attachments.contains(attachment.name())) {
           break;
         }
 
-        auto filter = VK_FILTER_LINEAR;
-
-        if (attachment.format() == format::r32_uint || attachment.format() == format::r64_uint || attachment.format() == format::r32g32_uint) {
-          filter = VK_FILTER_NEAREST;
-        }
-
-        const auto usage = VkImageUsageFlags{VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT};
+        const auto handle = graphics_module.add_resource<image2d>(extent, to_vk_enum<VkFormat>(attachment.format()), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, color_attachment_usage, color_attachment_filter(attachment), to_vk_enum<VkSamplerAddressMode>(attachment.address_mode()), VK_SAMPLE_COUNT_1_BIT);
 
-        const auto handle = graphics_module.add_resource<image2d>(extent, to_vk_enum<VkFormat>(attachment.format()), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, usage, filter, to_vk_enum<VkSamplerAddressMode>(attachment.address_mode()), VK_SAMPLE_COUNT_1_BIT);
-        const auto& image = graphics_module.get_resource<image2d>(handle);
-        
-        _color_images.emplace(attachment.name(), handle);
-
-        _attachment_states.insert_or_assign(attachment.name(), attachment_state{
-          .image = image.handle(),
-          .view = image.view(),
-          .current_layout = VK_IMAGE_LAYOUT_UNDEFINED,
-          // .format = to_vk_enum<VkFormat>(attachment.format()),
-          .format = image.format(),
-          .extent = VkExtent2D{extent.x(), extent.y()},
-          .type = attachment::type::image,
-          .is_first_use = false
-        });
-
-        _clear_values.insert_or_assign(attachment.name(), VkClearValue{
-          .color = {
-            .float32 = {
-              attachment.clear_color().r(), 
-              attachment.clear_color().g(), 
-              attachment.clear_color().b(), 
-              attachment.clear_color().a()
-            }
-          }
-        });
+        _register_color_attachment(attachment, handle);
 
         utility::logger<"graphics">::debug("Created color attachment '{}' with extent {}x{}", attachment.name().str(), extent.x(), extent.y());
 
@@ -466,6 +468,132 @@ auto graph_builder::_create_attachments(const viewport::type flags, const graphi
   }
 }
 
+auto graph_builder::_create_transient_attachments() -> void {
+  if (_graph._transient_attachments.empty() || !_transient_memory.empty()) {
+    return;
+  }
+
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  auto& allocator = graphics_module.allocator();
+
+  struct candidate {
+    const graphics::attachment* attachment;
+    math::vector2u extent;
+  }; // struct candidate
+
+  auto candidates = std::vector<candidate>{};
+  auto requests = std::vector<alias_request>{};
+
+  for (const auto& node : _graph._graphics_nodes) {
+    for (const auto& attachment : node._outputs) {
+      if (!_graph._transient_attachments.contains(attachment.name())) {
+        continue;
+      }
+
+      if (std::ranges::any_of(candidates, [&](const auto& entry) { return entry.attachment->name() == attachment.name(); })) {
+        continue;
+      }
+
+      const auto extent = node._render_area.extent();
+
+      candidates.push_back(candidate{
+        .attachment = &attachment,
+        .extent = extent
+      });
+
+      requests.push_back(alias_request{
+        .uses = _attachment_lifetimes.at(attachment.name()),
+        .requirements = image2d::memory_requirements(extent, to_vk_enum<VkFormat>(attachment.format()), color_attachment_usage)
+      });
+    }
+  }
+
+  const auto blocks = assign_aliases(requests);
+
+  auto allocation_create_info = VmaAllocationCreateInfo{};
+  allocation_create_info.flags = VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT;
+  allocation_create_info.requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+  allocation_create_info.priority = 1.0f;
+
+  auto unaliased_size = VkDeviceSize{0};
+  auto aliased_size = VkDeviceSize{0};
+
+  for (const auto& block : blocks) {
+    auto memory = VmaAllocation{};
+
+    validate(vmaAllocateMemory(allocator, &block.requirements, &allocation_create_info, &memory, nullptr));
+
+    _transient_memory.push_back(memory);
+
+    aliased_size += block.requirements.size;
+
+    for (const auto index : block.requests) {
+      const auto& current = candidates[index];
+      const auto& attachment = *current.attachment;
+
+      const auto handle = graphics_module.add_resource<image2d>(memory, current.extent, to_vk_enum<VkFormat>(attachment.format()), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, color_attachment_usage, color_attachment_filter(attachment), to_vk_enum<VkSamplerAddressMode>(attachment.address_mode()));
+
+      _register_color_attachment(attachment, handle);
+
+      unaliased_size += requests[index].requirements.size;
+    }
+  }
+
+  utility::logger<"graphics">::debug("Aliased {} transient attachments into {} memory blocks ({} KiB instead of {} KiB)", candidates.size(), blocks.size(), aliased_size / 1024u, unaliased_size / 1024u);
+}
+
+auto graph_builder::_destroy_transient_attachments() -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  // The images have to be gone before the memory they alias is freed
+  for (const auto& name : _graph._transient_attachments) {
+    if (auto entry = _color_images.find(name); entry != _color_images.end()) {
+      graphics_module.remove_resource<image2d>(entry->second);
+      _color_images.erase(entry);
+      _attachment_states.erase(name);
+    }
+  }
+
+  auto& allocator = graphics_module.allocator();
+
+  for (auto& memory : _transient_memory) {
+    vmaFreeMemory(allocator, memory);
+  }
+
+  _transient_memory.clear();
+}
+
+auto graph_builder::_register_color_attachment(const graphics::attachment& attachment, const image2d_handle& handle) -> void {
+  auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+  const auto& image = graphics_module.get_resource<image2d>(handle);
+
+  _color_images.emplace(attachment.name(), handle);
+
+  _attachment_states.insert_or_assign(attachment.name(), attachment_state{
+    .image = image.handle(),
+    .view = image.view(),
+    .current_layout = VK_IMAGE_LAYOUT_UNDEFINED,
+    // .format = to_vk_enum<VkFormat>(attachment.format()),
+    .format = image.format(),
+    .extent = VkExtent2D{image.extent().width, image.extent().height},
+    .type = attachment::type::image,
+    .is_first_use = false
+  });
+
+  _clear_values.insert_or_assign(attachment.name(), VkClearValue{
+    .color = {
+      .float32 = {
+        attachment.clear_color().r(), 
+        attachment.clear_color().g(), 
+        attachment.clear_color().b(), 
+        attachment.clear_color().a()
+      }
+    }
+  });
+}
+
 // auto graph_builder::_execute_instruction(command_buffer& command_buffer, const transition_instruction& instruction) -> void {
 //   auto& state = _attachment_states.at(instruction.attachment);
 
@@ -6,8 +6,10 @@
 #include <string>
 #include <memory>
 #include <unordered_map>
+#include <unordered_set>
 #include <optional>
 #include <functional>
+#include <span>
 
 #include <vulkan/vulkan.h>
 
@@ -22,6 +24,7 @@
 
 #include <libsbx/graphics/viewport.hpp>
 #include <libsbx/graphics/draw_list.hpp>
+#include <libsbx/graphics/render_graph_schedule.hpp>
 
 #include <libsbx/graphics/images/image2d.hpp>
 #include <libsbx/graphics/images/depth_image.hpp>
@@ -174,6 +177,9 @@ private:
 
   utility::hashed_string _name;
 
+  std::vector<utility::hashed_string> _inputs;
+  std::vector<utility::hashed_string> _outputs;
+
 }; // class compute_node
 
 class graph_base  {
@@ -193,6 +199,7 @@ private:
   std::vector<graphics_node> _graphics_nodes;
   std::vector<compute_node> _compute_nodes;
   std::unordered_map<utility::hashed_string, std::unique_ptr<graphics::draw_list>> _draw_lists;
+  std::unordered_set<utility::hashed_string> _transient_attachments;
 
 }; // class graph_base
 
@@ -210,6 +217,13 @@ public:
   requires (std::is_constructible_v<attachment, Args...>)
   auto produces(Args&&... args) -> void;
 
+  /**
+   * @brief Marks color attachments produced by this pass as only being used within a frame. Transient attachments whose lifetimes do not overlap share memory, so they may not be read outside of the graph or in the next frame.
+   */
+  template<typename... Names>
+  requires (... && (std::is_same_v<std::remove_cvref_t<Names>, utility::hashed_string> || std::is_constructible_v<utility::hashed_string, Names>))
+  auto transient(Names&&... names) -> void;
+
   // template<typename Type, typename... Args>
   // requires (std::is_constructible_v<Type, Args...>)
   // auto add_draw_list(const utility::hashed_string& name, Args&&... args) -> Type&;
@@ -245,6 +259,26 @@ class compute_pass {
 
 public:
 
+  /**
+   * @brief Declares attachments or buffers that the pass reads. Buffers have to be written by another compute pass.
+   */
+  template<typename... Names>
+  requires (... && (std::is_same_v<std::remove_cvref_t<Names>, utility::hashed_string> || std::is_constructible_v<utility::hashed_string, Names>))
+  auto reads(Names&&... names) -> void;
+
+  /**
+   * @brief Declares buffers that the pass writes. Graphics passes can depend on them through uses.
+   */
+  template<typename... Names>
+  requires (... && (std::is_same_v<std::remove_cvref_t<Names>, utility::hashed_string> || std::is_constructible_v<utility::hashed_string, Names>))
+  auto writes(Names&&... names) -> void;
+
+  auto name() const -> const utility::hashed_string&;
+
+  auto inputs() const -> const std::vector<utility::hashed_string>&;
+
+  auto outputs() const -> const std::vector<utility::hashed_string>&;
+
 private:
 
   compute_pass(compute_node& node);
@@ -271,18 +305,16 @@ private:
 
 }; // class context
 
-struct transition_instruction {
-  utility::hashed_string attachment;
-  VkImageLayout old_layout;
-  VkImageLayout new_layout;
-}; // struct transition_instruction
-
 struct pass_instruction {
   graphics_node& node;
   std::vector<utility::hashed_string> attachments;
 }; // struct pass_instruction
 
-using instruction = std::variant<transition_instruction, pass_instruction>;
+struct compute_instruction {
+  compute_node& node;
+}; // struct compute_instruction
+
+using instruction = std::variant<barrier_instruction, pass_instruction, compute_instruction>;
 
 template<typename... Callables>
 struct overload : Callables... {
@@ -328,12 +360,32 @@ public:
 
   auto attachment(const std::string& name) const -> const descriptor&;
 
-  template<typename Callable>
-  auto execute(command_buffer& command_buffer, const swapchain& swapchain, Callable&& callable) -> void {
-    for (auto& [key, draw_list] : _graph._draw_lists) {
-      draw_list->clear();
-      draw_list->update();
-    }
+  /**
+   * @brief Everything needed to record the draws of a pass. Only valid for the duration of the pass callback.
+   */
+  struct pass_context {
+    utility::hashed_string name;
+    VkViewport viewport;
+    VkRect2D scissor;
+    std::span<const VkFormat> color_formats;
+    VkFormat depth_format;
+    bool is_secondary;
+  }; // struct pass_context
+
+  struct compute_context {
+    utility::hashed_string name;
+  }; // struct compute_context
+
+  /**
+   * @brief Updates all draw lists and records the passes of the graph.
+   *
+   * @param records_secondary Returns whether the draws of a pass are recorded into secondary command buffers. The rendering of such a pass is begun with secondary contents, so the callback may only execute secondary command buffers.
+   * @param callable Records a pass. Invoked with the pass_context of graphics passes and the compute_context of compute passes.
+   */
+  template<typename Predicate, typename Callable>
+  requires (std::is_invocable_r_v<bool, Predicate, const utility::hashed_string&> && std::is_invocable_v<Callable, const pass_context&> && std::is_invocable_v<Callable, const compute_context&>)
+  auto execute(command_buffer& command_buffer, const swapchain& swapchain, Predicate&& records_secondary, Callable&& callable) -> void {
+    _update_draw_lists();
 
     // Reset clear states so we can correctly set loadOp
     for (auto& [key, state] : _attachment_states) {
@@ -342,16 +394,42 @@ public:
 
     for (const auto& instruction : _instructions) {
       std::visit(overload{
-        [this, &command_buffer, &swapchain](const transition_instruction& instruction) {
-          auto& state = _attachment_states.at(instruction.attachment);
+        [this, &command_buffer, &swapchain](const barrier_instruction& instruction) {
+          _image_barriers.clear();
+
+          for (const auto& barrier : instruction.images) {
+            const auto& state = _attachment_states.at(barrier.attachment);
+
+            auto image_barrier = VkImageMemoryBarrier2{};
+            image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2;
+            image_barrier.srcStageMask = barrier.src_stage;
+            image_barrier.srcAccessMask = barrier.src_access;
+            image_barrier.dstStageMask = barrier.dst_stage;
+            image_barrier.dstAccessMask = barrier.dst_access;
+            image_barrier.oldLayout = barrier.old_layout;
+            image_barrier.newLayout = barrier.new_layout;
+            image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+            image_barrier.image = (state.type == attachment::type::swapchain) ? swapchain.image(swapchain.active_image_index()) : state.image;
+            image_barrier.subresourceRange.aspectMask = (state.type == attachment::type::depth) ? (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) : VK_IMAGE_ASPECT_COLOR_BIT;
+            image_barrier.subresourceRange.baseMipLevel = 0;
+            image_barrier.subresourceRange.levelCount = 1;
+            image_barrier.subresourceRange.baseArrayLayer = 0;
+            image_barrier.subresourceRange.layerCount = 1;
+
+            _image_barriers.push_back(image_barrier);
+          }
 
-          if (state.type == attachment::type::swapchain) {
-            image::transition_image_layout(command_buffer, swapchain.image(swapchain.active_image_index()), swapchain.formt(), instruction.old_layout, instruction.new_layout, VK_IMAGE_ASPECT_COLOR_BIT, 1, 0, 1, 0);
+          if (instruction.memory) {
+            command_buffer.pipeline_barrier(_image_barriers, std::span{&instruction.memory.value(), 1u});
           } else {
-            image::transition_image_layout(command_buffer, state.image, state.format, instruction.old_layout, instruction.new_layout, (state.type == attachment::type::depth) ? (VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT) : VK_IMAGE_ASPECT_COLOR_BIT, 1, 0, 1, 0);
+            command_buffer.pipeline_barrier(_image_barriers);
           }
         },
-        [this, &command_buffer, &swapchain, &callable](const pass_instruction& instruction) {
+        [&callable](const compute_instruction& instruction) {
+          std::invoke(callable, compute_context{instruction.node._name});
+        },
+        [this, &command_buffer, &swapchain, &records_secondary, &callable](const pass_instruction& instruction) {
           const auto& area = _pass_render_areas[instruction.node._name];
 
           const auto& offset = area.offset();
@@ -380,6 +458,9 @@ public:
           auto color_attachments = std::vector<VkRenderingAttachmentInfo>{};
           auto depth_attachment = std::optional<VkRenderingAttachmentInfo>{};
 
+          auto color_formats = std::vector<VkFormat>{};
+          auto depth_format = VK_FORMAT_UNDEFINED;
+
           for (const auto& attachment : instruction.attachments) {
             const auto& clear_value = _clear_values[attachment];
             auto& state = _attachment_states[attachment];
@@ -402,6 +483,7 @@ public:
               rendering_attachment_info.clearValue = clear_value;
 
               color_attachments.push_back(rendering_attachment_info);
+              color_formats.push_back(state.format);
             } else if (state.type == attachment::type::depth) {
               auto rendering_attachment_info = VkRenderingAttachmentInfo{};
               rendering_attachment_info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
@@ -413,6 +495,7 @@ public:
               rendering_attachment_info.clearValue = clear_value;
 
               depth_attachment = rendering_attachment_info;
+              depth_format = state.format;
             } else if (state.type == attachment::type::swapchain) {
               auto rendering_attachment_info = VkRenderingAttachmentInfo{};
               rendering_attachment_info.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO;
@@ -424,11 +507,15 @@ public:
               rendering_attachment_info.clearValue = clear_value;
 
               color_attachments.push_back(rendering_attachment_info);
+              color_formats.push_back(swapchain.formt());
             }
           }
 
+          const auto is_secondary = std::invoke(records_secondary, instruction.node._name);
+
           auto rendering_info = VkRenderingInfo{};
           rendering_info.sType = VK_STRUCTURE_TYPE_RENDERING_INFO;
+          rendering_info.flags = is_secondary ? VK_RENDERING_CONTENTS_SECONDARY_COMMAND_BUFFERS_BIT : 0;
           rendering_info.renderArea = render_area;
           rendering_info.layerCount = 1;
           rendering_info.colorAttachmentCount = static_cast<std::uint32_t>(color_attachments.size());
@@ -438,7 +525,7 @@ public:
 
           command_buffer.begin_rendering(rendering_info);
 
-          std::invoke(callable, instruction.node._name);
+          std::invoke(callable, pass_context{instruction.node._name, viewport, scissor, color_formats, depth_format, is_secondary});
 
           command_buffer.end_rendering();
         }
@@ -460,12 +547,20 @@ private:
 
   auto _update_viewports() -> void;
 
+  auto _update_draw_lists() -> void;
+
   auto _clear_all_attachments() -> void;
 
   auto _clear_attachments(const viewport::type flags) -> void;
 
   auto _create_attachments(const viewport::type flags, const graphics_node& node) -> void;
 
+  auto _create_transient_attachments() -> void;
+
+  auto _destroy_transient_attachments() -> void;
+
+  auto _register_color_attachment(const graphics::attachment& attachment, const image2d_handle& handle) -> void;
+
   graph_base& _graph;
 
   std::unordered_map<utility::hashed_string, image2d_handle> _color_images;
@@ -478,6 +573,11 @@ private:
 
   std::unordered_map<utility::hashed_string, render_area> _pass_render_areas;
 
+  std::unordered_map<utility::hashed_string, lifetime> _attachment_lifetimes;
+  std::vector<VmaAllocation> _transient_memory;
+
+  std::vector<VkImageMemoryBarrier2> _image_barriers;
+
 }; // class graph_builder
 
 } // namespace detail
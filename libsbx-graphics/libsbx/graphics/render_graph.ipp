@@ -44,6 +44,24 @@ auto graphics_pass::produces(Args&&... args) -> void {
   _node._outputs.emplace_back(std::forward<Args>(args)...);
 }
 
+template<typename... Names>
+requires (... && (std::is_same_v<std::remove_cvref_t<Names>, utility::hashed_string> || std::is_constructible_v<utility::hashed_string, Names>))
+auto graphics_pass::transient(Names&&... names) -> void {
+  (_graph._transient_attachments.emplace(std::forward<Names>(names)), ...);
+}
+
+template<typename... Names>
+requires (... && (std::is_same_v<std::remove_cvref_t<Names>, utility::hashed_string> || std::is_constructible_v<utility::hashed_string, Names>))
+auto compute_pass::reads(Names&&... names) -> void {
+  (_node._inputs.emplace_back(std::forward<Names>(names)), ...);
+}
+
+template<typename... Names>
+requires (... && (std::is_same_v<std::remove_cvref_t<Names>, utility::hashed_string> || std::is_constructible_v<utility::hashed_string, Names>))
+auto compute_pass::writes(Names&&... names) -> void {
+  (_node._outputs.emplace_back(std::forward<Names>(names)), ...);
+}
+
 // template<typename Type, typename... Args>
 // requires (std::is_constructible_v<Type, Args...>)
 // auto graphics_pass::add_draw_list(const utility::hashed_string& name, Args&&... args) -> Type& {
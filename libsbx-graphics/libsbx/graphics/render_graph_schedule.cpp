@@ -0,0 +1,293 @@
+#include <libsbx/graphics/render_graph_schedule.hpp>
+
+#include <queue>
+#include <algorithm>
+#include <numeric>
+#include <limits>
+#include <unordered_set>
+
+#include <libsbx/utility/exception.hpp>
+
+namespace sbx::graphics::detail {
+
+struct access_scope {
+  VkPipelineStageFlags2 stage;
+  VkAccessFlags2 access;
+}; // struct access_scope
+
+// Accesses that have to finish before an attachment can leave the given layout
+static auto src_scope(const VkImageLayout layout) -> access_scope {
+  switch (layout) {
+    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: {
+      return access_scope{VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT};
+    }
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: {
+      return access_scope{VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+    }
+    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: {
+      // Reads only need an execution dependency
+      return access_scope{VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_NONE};
+    }
+    default: {
+      // The contents are discarded, but the memory may still be in use by the previous frame or by an aliased transient attachment
+      return access_scope{VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_NONE};
+    }
+  }
+}
+
+// Accesses that wait for an attachment to enter the given layout
+static auto dst_scope(const VkImageLayout layout, const bool is_compute) -> access_scope {
+  switch (layout) {
+    case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL: {
+      return access_scope{VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT};
+    }
+    case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL: {
+      return access_scope{VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT, VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+    }
+    case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL: {
+      return access_scope{is_compute ? VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT : VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_SHADER_SAMPLED_READ_BIT};
+    }
+    case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR: {
+      // Presentation waits on the semaphore signaled by the submit
+      return access_scope{VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE};
+    }
+    default: {
+      return access_scope{VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT};
+    }
+  }
+}
+
+static constexpr auto buffer_write_scope = access_scope{VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT};
+static constexpr auto compute_buffer_read_scope = access_scope{VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT};
+static constexpr auto graphics_buffer_read_scope = access_scope{VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_2_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT, VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_2_INDEX_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_READ_BIT};
+
+static auto collect_buffers(std::span<const pass_description> passes) -> std::unordered_set<utility::hashed_string> {
+  auto buffers = std::unordered_set<utility::hashed_string>{};
+
+  for (const auto& pass : passes) {
+    for (const auto& output : pass.outputs) {
+      if (output.type == output_type::buffer) {
+        buffers.insert(output.name);
+      }
+    }
+  }
+
+  return buffers;
+}
+
+auto sort_passes(std::span<const pass_description> passes) -> std::vector<std::uint32_t> {
+  const auto buffers = collect_buffers(passes);
+
+  auto producers = std::unordered_map<utility::hashed_string, std::uint32_t>{};
+
+  for (auto index = 0u; index < passes.size(); ++index) {
+    for (const auto& output : passes[index].outputs) {
+      if (output.type != output_type::buffer && buffers.contains(output.name)) {
+        throw utility::runtime_error{"Buffer '{}' has the same name as an attachment of pass '{}'", output.name.str(), passes[index].name.str()};
+      }
+
+      producers[output.name] = index;
+    }
+  }
+
+  auto dependents = std::vector<std::vector<std::uint32_t>>(passes.size());
+  auto dependency_counts = std::vector<std::uint32_t>(passes.size(), 0u);
+
+  for (auto index = 0u; index < passes.size(); ++index) {
+    auto dependencies = std::unordered_set<std::uint32_t>{};
+
+    for (const auto& input : passes[index].inputs) {
+      const auto entry = producers.find(input);
+
+      if (entry == producers.end()) {
+        throw utility::runtime_error{"No producer for attachment '{}'", input.str()};
+      }
+
+      if (dependencies.insert(entry->second).second) {
+        dependents[entry->second].push_back(index);
+        ++dependency_counts[index];
+      }
+    }
+  }
+
+  auto ready = std::queue<std::uint32_t>{};
+
+  for (auto index = 0u; index < passes.size(); ++index) {
+    if (dependency_counts[index] == 0u) {
+      ready.push(index);
+    }
+  }
+
+  auto order = std::vector<std::uint32_t>{};
+  order.reserve(passes.size());
+
+  while (!ready.empty()) {
+    const auto current = ready.front();
+    ready.pop();
+
+    order.push_back(current);
+
+    // Dependents were added in declaration order, which keeps the order stable
+    for (const auto dependent : dependents[current]) {
+      if (--dependency_counts[dependent] == 0u) {
+        ready.push(dependent);
+      }
+    }
+  }
+
+  if (order.size() != passes.size()) {
+    throw utility::runtime_error{"Render graph contains a cycle"};
+  }
+
+  return order;
+}
+
+auto plan_barriers(std::span<const pass_description> passes, std::span<const std::uint32_t> order) -> barrier_plan {
+  const auto buffers = collect_buffers(passes);
+
+  auto plan = barrier_plan{};
+  plan.barriers.resize(order.size());
+
+  auto layouts = std::unordered_map<utility::hashed_string, VkImageLayout>{};
+  auto written_buffers = std::unordered_set<utility::hashed_string>{};
+
+  // Reads in the same layout need no barrier, writes still have to wait for the previous pass writing the attachment
+  const auto transition = [&](barrier_instruction& barrier, const utility::hashed_string& name, const VkImageLayout new_layout, const bool is_compute, const bool is_write) {
+    auto [entry, inserted] = layouts.try_emplace(name, VK_IMAGE_LAYOUT_UNDEFINED);
+
+    if (entry->second == new_layout && !is_write) {
+      return;
+    }
+
+    const auto src = src_scope(entry->second);
+    const auto dst = dst_scope(new_layout, is_compute);
+
+    barrier.images.push_back(image_barrier{
+      .attachment = name,
+      .old_layout = entry->second,
+      .new_layout = new_layout,
+      .src_stage = src.stage,
+      .src_access = src.access,
+      .dst_stage = dst.stage,
+      .dst_access = dst.access
+    });
+
+    entry->second = new_layout;
+  };
+
+  const auto depend_on_buffer = [](barrier_instruction& barrier, const access_scope& dst) {
+    if (!barrier.memory) {
+      auto memory_barrier = VkMemoryBarrier2{};
+      memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+
+      barrier.memory = memory_barrier;
+    }
+
+    barrier.memory->srcStageMask |= buffer_write_scope.stage;
+    barrier.memory->srcAccessMask |= buffer_write_scope.access;
+    barrier.memory->dstStageMask |= dst.stage;
+    barrier.memory->dstAccessMask |= dst.access;
+  };
+
+  const auto touch = [&](const utility::hashed_string& name, const std::uint32_t index) {
+    auto [entry, inserted] = plan.lifetimes.try_emplace(name, lifetime{index, index});
+    entry->second.last = index;
+  };
+
+  auto swapchain = std::optional<utility::hashed_string>{};
+
+  for (auto index = 0u; index < order.size(); ++index) {
+    const auto& pass = passes[order[index]];
+
+    // All transitions and buffer dependencies of a pass end up in its barrier
+    auto& barrier = plan.barriers[index];
+
+    for (const auto& input : pass.inputs) {
+      if (buffers.contains(input)) {
+        depend_on_buffer(barrier, pass.is_compute ? compute_buffer_read_scope : graphics_buffer_read_scope);
+      } else {
+        transition(barrier, input, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, pass.is_compute, false);
+        touch(input, index);
+      }
+    }
+
+    for (const auto& output : pass.outputs) {
+      if (output.type == output_type::buffer) {
+        // Writes to a buffer that an earlier pass wrote have to wait for that pass
+        if (!written_buffers.insert(output.name).second) {
+          depend_on_buffer(barrier, buffer_write_scope);
+        }
+
+        continue;
+      }
+
+      const auto target_layout = output.type == output_type::depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL : VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+      transition(barrier, output.name, target_layout, pass.is_compute, true);
+      touch(output.name, index);
+
+      if (output.type == output_type::swapchain) {
+        swapchain = output.name;
+      }
+    }
+  }
+
+  if (!swapchain) {
+    throw utility::runtime_error{"Render graph does not contain a swapchain attachment"};
+  }
+
+  transition(plan.present, *swapchain, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, false, false);
+
+  return plan;
+}
+
+auto assign_aliases(std::span<const alias_request> requests) -> std::vector<alias_block> {
+  auto sorted = std::vector<std::size_t>(requests.size());
+  std::iota(sorted.begin(), sorted.end(), std::size_t{0u});
+
+  std::ranges::stable_sort(sorted, [&](const auto lhs, const auto rhs) { return requests[lhs].uses.first < requests[rhs].uses.first; });
+
+  auto blocks = std::vector<alias_block>{};
+  auto last_uses = std::vector<std::uint32_t>{};
+
+  for (const auto index : sorted) {
+    const auto& current = requests[index];
+
+    auto best = blocks.size();
+    auto best_growth = std::numeric_limits<VkDeviceSize>::max();
+
+    for (auto block = 0u; block < blocks.size(); ++block) {
+      const auto& requirements = blocks[block].requirements;
+
+      if (last_uses[block] >= current.uses.first || (requirements.memoryTypeBits & current.requirements.memoryTypeBits) == 0u) {
+        continue;
+      }
+
+      const auto growth = std::max(requirements.size, current.requirements.size) - requirements.size;
+
+      if (growth < best_growth) {
+        best = block;
+        best_growth = growth;
+      }
+    }
+
+    if (best == blocks.size()) {
+      blocks.push_back(alias_block{current.requirements, {index}});
+      last_uses.push_back(current.uses.last);
+      continue;
+    }
+
+    auto& block = blocks[best];
+
+    block.requirements.size = std::max(block.requirements.size, current.requirements.size);
+    block.requirements.alignment = std::max(block.requirements.alignment, current.requirements.alignment);
+    block.requirements.memoryTypeBits &= current.requirements.memoryTypeBits;
+    block.requests.push_back(index);
+
+    last_uses[best] = current.uses.last;
+  }
+
+  return blocks;
+}
+
+} // namespace sbx::graphics::detail
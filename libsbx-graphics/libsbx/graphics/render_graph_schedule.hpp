@@ -0,0 +1,118 @@
+#ifndef LIBSBX_GRAPHICS_RENDER_GRAPH_SCHEDULE_HPP_
+#define LIBSBX_GRAPHICS_RENDER_GRAPH_SCHEDULE_HPP_
+
+#include <cinttypes>
+#include <vector>
+#include <span>
+#include <optional>
+#include <unordered_map>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/utility/hashed_string.hpp>
+
+namespace sbx::graphics::detail {
+
+/**
+ * @brief How a pass writes one of its outputs.
+ */
+enum class output_type : std::uint8_t {
+  color,
+  depth,
+  swapchain,
+  buffer
+}; // enum class output_type
+
+struct pass_output {
+  utility::hashed_string name;
+  output_type type;
+}; // struct pass_output
+
+/**
+ * @brief The resources a pass reads and writes. Everything the schedule of a render graph is derived from, without touching the device.
+ */
+struct pass_description {
+  utility::hashed_string name;
+  bool is_compute;
+  std::vector<utility::hashed_string> inputs;
+  std::vector<pass_output> outputs;
+}; // struct pass_description
+
+/**
+ * @brief Indices into the sorted passes of the first and last pass touching an attachment.
+ */
+struct lifetime {
+  std::uint32_t first;
+  std::uint32_t last;
+}; // struct lifetime
+
+struct image_barrier {
+  utility::hashed_string attachment;
+  VkImageLayout old_layout;
+  VkImageLayout new_layout;
+  VkPipelineStageFlags2 src_stage;
+  VkAccessFlags2 src_access;
+  VkPipelineStageFlags2 dst_stage;
+  VkAccessFlags2 dst_access;
+}; // struct image_barrier
+
+/**
+ * @brief All transitions needed before a pass, recorded with a single pipeline barrier. Buffer dependencies between passes are covered by one global memory barrier.
+ */
+struct barrier_instruction {
+  std::vector<image_barrier> images;
+  std::optional<VkMemoryBarrier2> memory;
+
+  auto is_empty() const noexcept -> bool {
+    return images.empty() && !memory.has_value();
+  }
+}; // struct barrier_instruction
+
+struct barrier_plan {
+  // One barrier per entry of the pass order, recorded right before that pass. Empty if the pass needs none
+  std::vector<barrier_instruction> barriers;
+  // Transitions the swapchain image for presentation after the last pass
+  barrier_instruction present;
+  std::unordered_map<utility::hashed_string, lifetime> lifetimes;
+}; // struct barrier_plan
+
+/**
+ * @brief Topologically sorts the passes so that every pass runs after the passes producing its inputs. Passes without dependencies between each other keep their relative order.
+ *
+ * @return Indices into passes in execution order.
+ *
+ * @throws utility::runtime_error if an input has no producer, a buffer shares its name with an attachment or the passes contain a cycle.
+ */
+auto sort_passes(std::span<const pass_description> passes) -> std::vector<std::uint32_t>;
+
+/**
+ * @brief Collects the layout transitions and buffer dependencies of every pass into one barrier per pass boundary and records the lifetimes of all attachments.
+ *
+ * @param order The execution order returned by sort_passes.
+ *
+ * @throws utility::runtime_error if no pass writes the swapchain.
+ */
+auto plan_barriers(std::span<const pass_description> passes, std::span<const std::uint32_t> order) -> barrier_plan;
+
+struct alias_request {
+  lifetime uses;
+  VkMemoryRequirements requirements;
+}; // struct alias_request
+
+/**
+ * @brief A memory allocation shared by all requests whose lifetimes do not overlap.
+ */
+struct alias_block {
+  VkMemoryRequirements requirements;
+  // Indices into the requests, ordered by their first use
+  std::vector<std::size_t> requests;
+}; // struct alias_block
+
+/**
+ * @brief Assigns memory blocks to the requests by greedy interval coloring. A request reuses the block that grows the least among the ones whose last use ends before it is first used and whose memory types are compatible.
+ */
+auto assign_aliases(std::span<const alias_request> requests) -> std::vector<alias_block>;
+
+} // namespace sbx::graphics::detail
+
+#endif // LIBSBX_GRAPHICS_RENDER_GRAPH_SCHEDULE_HPP_
@@ -4,6 +4,8 @@
 #include <memory>
 #include <vector>
 #include <typeindex>
+#include <array>
+#include <algorithm>
 
 #include <easy/profiler.h>
 
@@ -11,6 +13,11 @@
 #include <libsbx/utility/concepts.hpp>
 #include <libsbx/utility/hash.hpp>
 
+#include <libsbx/containers/task_graph.hpp>
+
+#include <libsbx/core/engine.hpp>
+
+#include <libsbx/graphics/commands/command_pool.hpp>
 #include <libsbx/graphics/commands/command_buffer.hpp>
 
 #include <libsbx/graphics/pipeline/pipeline.hpp>
@@ -33,19 +40,48 @@ public:
 
   // virtual auto initialize() -> void = 0;
 
-  auto render(command_buffer& command_buffer, const swapchain& swapchain) -> void {
-    _graph.execute(command_buffer, swapchain, [this, &command_buffer](const auto& pass_name) {
-      if (auto entry = _subrenderers.find(pass_name); entry != _subrenderers.end()) {
+  auto render(command_buffer& command_buffer, const swapchain& swapchain, const std::uint32_t frame) -> void {
+    _reset_secondary_command_buffers(frame);
+
+    _graph.execute(command_buffer, swapchain, [this](const utility::hashed_string& pass_name) {
+      return _records_secondary(pass_name);
+    }, detail::overload{
+      [this, &command_buffer, frame](const render_graph::pass_context& context) {
+        auto entry = _subrenderers.find(context.name);
+
+        if (entry == _subrenderers.end()) {
+          return;
+        }
+
         for (auto& subrenderer : entry->second) {
-          subrenderer->render(command_buffer);
+          subrenderer->prepare();
+        }
+
+        if (!context.is_secondary) {
+          for (auto& subrenderer : entry->second) {
+            subrenderer->render(command_buffer);
+          }
+
+          return;
+        }
+
+        _render_secondary(command_buffer, frame, context, entry->second);
+      },
+      [this, &command_buffer](const render_graph::compute_context& context) {
+        if (auto entry = _tasks.find(context.name); entry != _tasks.end()) {
+          for (auto& task : entry->second) {
+            task->execute(command_buffer);
+          }
         }
       }
     });
   }
 
   auto execute_tasks(command_buffer& command_buffer) -> void {
-    for (const auto& task : _tasks) {
-      task->execute(command_buffer);
+    for (const auto& [pass_name, tasks] : _tasks) {
+      for (const auto& task : tasks) {
+        task->execute(command_buffer);
+      }
     }
   }
 
@@ -85,19 +121,126 @@ protected:
     return passes;
   }
 
-  // template<typename Type, typename... Args>
-  // requires (std::is_constructible_v<Type, std::filesystem::path, Args...>)
-  // auto add_task(const std::filesystem::path& path, Args&&... args) -> Type& {
-  //   _tasks.push_back(std::make_unique<Type>(path, std::forward<Args>(args)...));
+  template<typename Type, typename... Args>
+  requires (std::is_constructible_v<Type, const render_graph::compute_pass&, Args...>)
+  auto add_task(const render_graph::compute_pass& pass, Args&&... args) -> Type& {
+    auto& tasks = _tasks[pass.name()];
+
+    tasks.emplace_back(std::make_unique<Type>(pass, std::forward<Args>(args)...));
 
-  //   return *static_cast<Type*>(_tasks.back().get());
-  // }
+    return *static_cast<Type*>(tasks.back().get());
+  }
 
 private:
 
-  std::vector<std::unique_ptr<graphics::task>> _tasks;
+  using subrenderer_container = std::vector<std::unique_ptr<subrenderer>>;
+
+  /**
+   * @brief Secondary command buffers of one thread for one frame in flight. Only ever touched by the thread it belongs to while recording.
+   */
+  struct secondary_command_buffers {
+    std::shared_ptr<command_pool> pool;
+    std::vector<command_buffer> command_buffers;
+    std::size_t used{};
+  }; // struct secondary_command_buffers
+
+  auto _records_secondary(const utility::hashed_string& pass_name) const -> bool {
+    if (core::engine::executor().size() == 0u) {
+      return false;
+    }
+
+    if (auto entry = _subrenderers.find(pass_name); entry != _subrenderers.end()) {
+      return std::ranges::any_of(entry->second, [](const auto& subrenderer) { return subrenderer->is_thread_safe(); });
+    }
+
+    return false;
+  }
+
+  auto _reset_secondary_command_buffers(const std::uint32_t frame) -> void {
+    auto& per_thread = _secondary_command_buffers[frame];
+
+    // One set for every worker and one for the thread driving the renderer
+    per_thread.resize(core::engine::executor().size() + 1u);
+
+    // The fence of the frame has been waited on, so none of its command buffers are pending anymore
+    for (auto& buffers : per_thread) {
+      if (buffers.used > 0u) {
+        buffers.pool->reset();
+        buffers.used = 0u;
+      }
+    }
+  }
+
+  auto _render_secondary(command_buffer& command_buffer, const std::uint32_t frame, const render_graph::pass_context& context, subrenderer_container& subrenderers) -> void {
+    EASY_FUNCTION();
+
+    auto recorded = std::vector<VkCommandBuffer>(subrenderers.size(), VK_NULL_HANDLE);
+
+    auto graph = containers::task_graph{"subrenderers"};
+
+    for (auto i = 0u; i < subrenderers.size(); ++i) {
+      auto& subrenderer = *subrenderers[i];
+
+      if (subrenderer.is_thread_safe()) {
+        graph.emplace([this, frame, &context, &subrenderer, &recorded, i]() {
+          recorded[i] = _record_secondary(frame, context, subrenderer);
+        });
+      } else {
+        recorded[i] = _record_secondary(frame, context, subrenderer);
+      }
+    }
+
+    core::engine::executor().run_and_wait(graph);
+
+    // Executed in the order the subrenderers were added, regardless of which thread recorded them
+    command_buffer.execute_commands(recorded);
+  }
+
+  auto _record_secondary(const std::uint32_t frame, const render_graph::pass_context& context, subrenderer& subrenderer) -> VkCommandBuffer {
+    auto& executor = core::engine::executor();
+
+    auto& buffers = _secondary_command_buffers[frame][executor.this_worker_id().value_or(executor.size())];
+
+    if (!buffers.pool) {
+      buffers.pool = std::make_shared<command_pool>();
+    }
+
+    if (buffers.used == buffers.command_buffers.size()) {
+      buffers.command_buffers.emplace_back(buffers.pool, VK_QUEUE_GRAPHICS_BIT, VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+    }
+
+    auto& secondary = buffers.command_buffers[buffers.used++];
+
+    auto inheritance_rendering_info = VkCommandBufferInheritanceRenderingInfo{};
+    inheritance_rendering_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_RENDERING_INFO;
+    inheritance_rendering_info.colorAttachmentCount = static_cast<std::uint32_t>(context.color_formats.size());
+    inheritance_rendering_info.pColorAttachmentFormats = context.color_formats.data();
+    inheritance_rendering_info.depthAttachmentFormat = context.depth_format;
+    inheritance_rendering_info.stencilAttachmentFormat = context.depth_format;
+    inheritance_rendering_info.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+    auto inheritance_info = VkCommandBufferInheritanceInfo{};
+    inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+    inheritance_info.pNext = &inheritance_rendering_info;
+
+    secondary.begin(VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT, inheritance_info);
+
+    // Dynamic state is not inherited from the primary command buffer
+    secondary.set_viewport(context.viewport);
+    secondary.set_scissor(context.scissor);
+
+    subrenderer.render(secondary);
+
+    secondary.end();
+
+    return secondary.handle();
+  }
+
+  std::unordered_map<utility::hashed_string, std::vector<std::unique_ptr<graphics::task>>> _tasks;
+
+  std::unordered_map<utility::hashed_string, subrenderer_container> _subrenderers;
 
-  std::unordered_map<utility::hashed_string, std::vector<std::unique_ptr<subrenderer>>> _subrenderers;
+  std::array<std::vector<secondary_command_buffers>, swapchain::max_frames_in_flight> _secondary_command_buffers;
 
   render_graph _graph;
 
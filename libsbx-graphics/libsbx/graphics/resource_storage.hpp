@@ -128,6 +128,7 @@ public:
     utility::assert_that(handle.handle() < _storage.size(), "Handle is out of bounds");
     utility::assert_that(handle.generation() == _generations[handle.handle()], "Handle generation does not match");
 
+    // The destructors of graphics resources hand their Vulkan objects to the deletion queue, so frames in flight can still use them
     std::destroy_at(_ptr(handle.handle()));
     _free_handles.push_back(handle.handle());
   }
@@ -18,8 +18,20 @@ public:
 
   virtual ~subrenderer() = default;
 
+  /**
+   * @brief Runs on the rendering thread right before the pass is recorded. Thread safe subrenderers create the graphics resources they need for rendering here.
+   */
+  virtual auto prepare() -> void { }
+
   virtual auto render(command_buffer& command_buffer) -> void = 0;
 
+  /**
+   * @brief Whether render may record into a secondary command buffer on a worker thread concurrently with other subrenderers of the same pass. Implementations that opt in must not create or destroy graphics resources while rendering.
+   */
+  virtual auto is_thread_safe() const noexcept -> bool {
+    return false;
+  }
+
   auto pass() noexcept -> render_graph::graphics_pass& {
     return _pass;
   }
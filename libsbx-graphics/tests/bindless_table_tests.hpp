@@ -0,0 +1,80 @@
+#ifndef LIBSBX_GRAPHICS_BINDLESS_TABLE_TESTS_HPP_
+#define LIBSBX_GRAPHICS_BINDLESS_TABLE_TESTS_HPP_
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/utility/exception.hpp>
+
+#include <libsbx/graphics/deletion_queue.hpp>
+#include <libsbx/graphics/descriptor/bindless_table.hpp>
+
+namespace bindless_table_tests {
+
+using slot_allocator = sbx::graphics::bindless_table::slot_allocator;
+
+/**
+ * @brief Flushes every frame of the queue once, like the graphics module does after waiting for the fences of all frames in flight.
+ */
+inline auto finish_frames(sbx::graphics::deletion_queue& deletion_queue) -> void {
+  for (auto frame = 0u; frame < sbx::graphics::swapchain::max_frames_in_flight; ++frame) {
+    deletion_queue.flush(frame);
+  }
+}
+
+} // namespace bindless_table_tests
+
+TEST(libsbx_graphics_bindless_table, allocates_unique_handles) {
+  auto deletion_queue = sbx::graphics::deletion_queue{4u};
+  auto allocator = bindless_table_tests::slot_allocator{8u, deletion_queue};
+
+  auto handles = std::set<sbx::graphics::bindless_table::handle_type>{};
+
+  for (auto i = 0u; i < allocator.capacity(); ++i) {
+    const auto handle = allocator.allocate();
+
+    EXPECT_LT(handle, allocator.capacity());
+    EXPECT_TRUE(handles.insert(handle).second);
+  }
+
+  EXPECT_THROW(allocator.allocate(), sbx::utility::runtime_error);
+}
+
+TEST(libsbx_graphics_bindless_table, released_handles_are_reused_after_the_frames_in_flight) {
+  auto deletion_queue = sbx::graphics::deletion_queue{4u};
+  auto allocator = bindless_table_tests::slot_allocator{4u, deletion_queue};
+
+  const auto first = allocator.allocate();
+  const auto second = allocator.allocate();
+
+  allocator.release(first);
+
+  // Frames in flight may still index the released slot, so it is not handed out yet
+  const auto third = allocator.allocate();
+
+  EXPECT_NE(third, first);
+  EXPECT_NE(third, second);
+
+  bindless_table_tests::finish_frames(deletion_queue);
+
+  EXPECT_EQ(allocator.allocate(), first);
+}
+
+TEST(libsbx_graphics_bindless_table, full_tables_accept_handles_again_after_release) {
+  auto deletion_queue = sbx::graphics::deletion_queue{4u};
+  auto allocator = bindless_table_tests::slot_allocator{2u, deletion_queue};
+
+  const auto first = allocator.allocate();
+  allocator.allocate();
+
+  allocator.release(first);
+
+  EXPECT_THROW(allocator.allocate(), sbx::utility::runtime_error);
+
+  bindless_table_tests::finish_frames(deletion_queue);
+
+  EXPECT_EQ(allocator.allocate(), first);
+}
+
+#endif // LIBSBX_GRAPHICS_BINDLESS_TABLE_TESTS_HPP_
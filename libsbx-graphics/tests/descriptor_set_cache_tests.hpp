@@ -0,0 +1,162 @@
+#ifndef LIBSBX_GRAPHICS_DESCRIPTOR_SET_CACHE_TESTS_HPP_
+#define LIBSBX_GRAPHICS_DESCRIPTOR_SET_CACHE_TESTS_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/graphics/deletion_queue.hpp>
+#include <libsbx/graphics/descriptor/descriptor_set_cache.hpp>
+
+#include <graphics_tests/headless_device.hpp>
+
+namespace descriptor_set_cache_tests {
+
+/**
+ * @brief A layout with a single storage buffer and a write of a buffer of the device to it.
+ */
+class storage_buffer_set {
+
+public:
+
+  explicit storage_buffer_set(graphics_tests::headless_device& device)
+  : _device{device.handle()} {
+    auto binding = VkDescriptorSetLayoutBinding{};
+    binding.binding = 0u;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    binding.descriptorCount = 1u;
+    binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+
+    auto layout_create_info = VkDescriptorSetLayoutCreateInfo{};
+    layout_create_info.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layout_create_info.bindingCount = 1u;
+    layout_create_info.pBindings = &binding;
+
+    vkCreateDescriptorSetLayout(_device, &layout_create_info, nullptr, &_layout);
+
+    _buffer_info.buffer = device.create_buffer(256u).handle;
+    _buffer_info.offset = 0u;
+    _buffer_info.range = VK_WHOLE_SIZE;
+
+    _write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    _write.dstBinding = 0u;
+    _write.descriptorCount = 1u;
+    _write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    _write.pBufferInfo = &_buffer_info;
+  }
+
+  ~storage_buffer_set() {
+    vkDestroyDescriptorSetLayout(_device, _layout, nullptr);
+  }
+
+  auto layout() const noexcept -> VkDescriptorSetLayout {
+    return _layout;
+  }
+
+  auto writes() const noexcept -> std::span<const VkWriteDescriptorSet> {
+    return {&_write, 1u};
+  }
+
+private:
+
+  VkDevice _device;
+  VkDescriptorSetLayout _layout{VK_NULL_HANDLE};
+  VkDescriptorBufferInfo _buffer_info{};
+  VkWriteDescriptorSet _write{};
+
+}; // class storage_buffer_set
+
+// The cache does not interpret the resources, any words identify a set
+inline const auto first_resources = std::vector<std::uint64_t>{1u, 2u, 3u};
+inline const auto second_resources = std::vector<std::uint64_t>{1u, 2u, 4u};
+
+} // namespace descriptor_set_cache_tests
+
+TEST(libsbx_graphics_descriptor_set_cache, hits_compare_the_resources) {
+  using namespace descriptor_set_cache_tests;
+
+  auto device = graphics_tests::headless_device{};
+
+  if (!device.is_valid()) {
+    GTEST_SKIP() << "No Vulkan 1.3 device available";
+  }
+
+  const auto set = storage_buffer_set{device};
+
+  auto deletion_queue = sbx::graphics::deletion_queue{4u};
+
+  auto cache = sbx::graphics::descriptor_set_cache{device.handle(), deletion_queue};
+
+  const auto hash = sbx::graphics::descriptor_set_cache::hash(first_resources);
+
+  EXPECT_NE(hash, sbx::graphics::descriptor_set_cache::hash(second_resources));
+
+  EXPECT_EQ(cache.find(set.layout(), hash, first_resources), VkDescriptorSet{VK_NULL_HANDLE});
+
+  const auto first = cache.emplace(set.layout(), hash, first_resources, 0u, set.writes());
+
+  ASSERT_NE(first, VkDescriptorSet{VK_NULL_HANDLE});
+  EXPECT_EQ(cache.find(set.layout(), hash, first_resources), first);
+
+  // A colliding hash with different resources is not a hit
+  EXPECT_EQ(cache.find(set.layout(), hash, second_resources), VkDescriptorSet{VK_NULL_HANDLE});
+
+  const auto second = cache.emplace(set.layout(), hash, second_resources, 0u, set.writes());
+
+  EXPECT_NE(second, first);
+  EXPECT_EQ(cache.find(set.layout(), hash, first_resources), first);
+  EXPECT_EQ(cache.find(set.layout(), hash, second_resources), second);
+  EXPECT_EQ(cache.size(), 2u);
+
+  // Emplacing a cached key returns the cached set
+  EXPECT_EQ(cache.emplace(set.layout(), hash, first_resources, 0u, set.writes()), first);
+  EXPECT_EQ(cache.size(), 2u);
+}
+
+TEST(libsbx_graphics_descriptor_set_cache, advance_evicts_unused_sets) {
+  using namespace descriptor_set_cache_tests;
+
+  auto device = graphics_tests::headless_device{};
+
+  if (!device.is_valid()) {
+    GTEST_SKIP() << "No Vulkan 1.3 device available";
+  }
+
+  const auto set = storage_buffer_set{device};
+
+  auto deletion_queue = sbx::graphics::deletion_queue{4u};
+
+  auto cache = sbx::graphics::descriptor_set_cache{device.handle(), deletion_queue};
+
+  const auto first_hash = sbx::graphics::descriptor_set_cache::hash(first_resources);
+  const auto second_hash = sbx::graphics::descriptor_set_cache::hash(second_resources);
+
+  const auto first = cache.emplace(set.layout(), first_hash, first_resources, 0u, set.writes());
+  cache.emplace(set.layout(), second_hash, second_resources, 0u, set.writes());
+
+  // Only the first set is used in every frame
+  for (auto frame = 1u; frame <= sbx::graphics::descriptor_set_cache::max_unused_frames; ++frame) {
+    cache.advance();
+
+    EXPECT_EQ(cache.find(set.layout(), first_hash, first_resources), first);
+  }
+
+  EXPECT_EQ(cache.size(), 2u);
+
+  cache.advance();
+
+  EXPECT_EQ(cache.size(), 1u);
+  EXPECT_EQ(cache.find(set.layout(), first_hash, first_resources), first);
+  EXPECT_EQ(cache.find(set.layout(), second_hash, second_resources), VkDescriptorSet{VK_NULL_HANDLE});
+
+  // The evicted set is freed through the deletion queue, its pool still has to exist
+  deletion_queue.flush_all();
+
+  EXPECT_NE(cache.emplace(set.layout(), second_hash, second_resources, 0u, set.writes()), VkDescriptorSet{VK_NULL_HANDLE});
+  EXPECT_EQ(cache.size(), 2u);
+}
+
+#endif // LIBSBX_GRAPHICS_DESCRIPTOR_SET_CACHE_TESTS_HPP_
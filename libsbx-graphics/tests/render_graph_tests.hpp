@@ -0,0 +1,259 @@
+#ifndef LIBSBX_GRAPHICS_RENDER_GRAPH_TESTS_HPP_
+#define LIBSBX_GRAPHICS_RENDER_GRAPH_TESTS_HPP_
+
+#include <vector>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/utility/exception.hpp>
+#include <libsbx/utility/hashed_string.hpp>
+
+#include <libsbx/graphics/render_graph_schedule.hpp>
+
+namespace render_graph_tests {
+
+using namespace sbx::utility::literals;
+
+inline auto graphics(const sbx::utility::hashed_string& name, std::vector<sbx::utility::hashed_string> inputs, std::vector<sbx::graphics::detail::pass_output> outputs) -> sbx::graphics::detail::pass_description {
+  return sbx::graphics::detail::pass_description{name, false, std::move(inputs), std::move(outputs)};
+}
+
+inline auto compute(const sbx::utility::hashed_string& name, std::vector<sbx::utility::hashed_string> inputs, std::vector<sbx::utility::hashed_string> outputs) -> sbx::graphics::detail::pass_description {
+  auto pass = sbx::graphics::detail::pass_description{name, true, std::move(inputs), {}};
+
+  for (const auto& output : outputs) {
+    pass.outputs.push_back(sbx::graphics::detail::pass_output{output, sbx::graphics::detail::output_type::buffer});
+  }
+
+  return pass;
+}
+
+inline auto color(const sbx::utility::hashed_string& name) -> sbx::graphics::detail::pass_output {
+  return sbx::graphics::detail::pass_output{name, sbx::graphics::detail::output_type::color};
+}
+
+inline auto depth(const sbx::utility::hashed_string& name) -> sbx::graphics::detail::pass_output {
+  return sbx::graphics::detail::pass_output{name, sbx::graphics::detail::output_type::depth};
+}
+
+inline auto swapchain(const sbx::utility::hashed_string& name) -> sbx::graphics::detail::pass_output {
+  return sbx::graphics::detail::pass_output{name, sbx::graphics::detail::output_type::swapchain};
+}
+
+inline auto request(const std::uint32_t first, const std::uint32_t last, const VkDeviceSize size, const std::uint32_t memory_type_bits = 0b1u) -> sbx::graphics::detail::alias_request {
+  return sbx::graphics::detail::alias_request{
+    .uses = sbx::graphics::detail::lifetime{first, last},
+    .requirements = VkMemoryRequirements{size, 256u, memory_type_bits}
+  };
+}
+
+// A deferred renderer: culling, geometry buffer, lighting, post processing and the final blit to the swapchain
+inline auto deferred() -> std::vector<sbx::graphics::detail::pass_description> {
+  return {
+    graphics("post"_hs, {"lighting"_hs}, {color("bloom"_hs)}),
+    graphics("geometry"_hs, {"commands"_hs}, {color("albedo"_hs), color("normal"_hs), depth("depth"_hs)}),
+    graphics("present"_hs, {"bloom"_hs}, {swapchain("swapchain"_hs)}),
+    graphics("lighting"_hs, {"albedo"_hs, "normal"_hs, "depth"_hs}, {color("lighting"_hs)}),
+    compute("cull"_hs, {}, {"commands"_hs})
+  };
+}
+
+} // namespace render_graph_tests
+
+TEST(libsbx_graphics_render_graph, passes_run_after_their_producers) {
+  using namespace render_graph_tests;
+
+  const auto passes = deferred();
+  const auto order = sbx::graphics::detail::sort_passes(passes);
+
+  ASSERT_EQ(order.size(), passes.size());
+
+  auto names = std::vector<sbx::utility::hashed_string>{};
+
+  for (const auto index : order) {
+    names.push_back(passes[index].name);
+  }
+
+  EXPECT_EQ(names, (std::vector<sbx::utility::hashed_string>{"cull"_hs, "geometry"_hs, "lighting"_hs, "post"_hs, "present"_hs}));
+}
+
+TEST(libsbx_graphics_render_graph, independent_passes_keep_declaration_order) {
+  using namespace render_graph_tests;
+
+  const auto passes = std::vector<sbx::graphics::detail::pass_description>{
+    graphics("shadow"_hs, {}, {depth("shadow_map"_hs)}),
+    graphics("sky"_hs, {}, {color("sky"_hs)}),
+    graphics("present"_hs, {"shadow_map"_hs, "sky"_hs}, {swapchain("swapchain"_hs)}),
+    graphics("ui"_hs, {}, {color("ui"_hs)})
+  };
+
+  EXPECT_EQ(sbx::graphics::detail::sort_passes(passes), (std::vector<std::uint32_t>{0u, 1u, 3u, 2u}));
+}
+
+TEST(libsbx_graphics_render_graph, invalid_graphs_throw) {
+  using namespace render_graph_tests;
+
+  const auto cycle = std::vector<sbx::graphics::detail::pass_description>{
+    graphics("first"_hs, {"second"_hs}, {color("first"_hs)}),
+    graphics("second"_hs, {"first"_hs}, {color("second"_hs)})
+  };
+
+  const auto missing = std::vector<sbx::graphics::detail::pass_description>{
+    graphics("present"_hs, {"unknown"_hs}, {swapchain("swapchain"_hs)})
+  };
+
+  const auto clash = std::vector<sbx::graphics::detail::pass_description>{
+    graphics("geometry"_hs, {}, {color("albedo"_hs)}),
+    compute("cull"_hs, {}, {"albedo"_hs})
+  };
+
+  const auto headless = std::vector<sbx::graphics::detail::pass_description>{
+    graphics("geometry"_hs, {}, {color("albedo"_hs)})
+  };
+
+  EXPECT_THROW(sbx::graphics::detail::sort_passes(cycle), sbx::utility::runtime_error);
+  EXPECT_THROW(sbx::graphics::detail::sort_passes(missing), sbx::utility::runtime_error);
+  EXPECT_THROW(sbx::graphics::detail::sort_passes(clash), sbx::utility::runtime_error);
+
+  const auto order = sbx::graphics::detail::sort_passes(headless);
+
+  EXPECT_THROW(sbx::graphics::detail::plan_barriers(headless, order), sbx::utility::runtime_error);
+}
+
+TEST(libsbx_graphics_render_graph, one_barrier_per_pass_boundary) {
+  using namespace render_graph_tests;
+
+  const auto passes = deferred();
+  const auto order = sbx::graphics::detail::sort_passes(passes);
+  const auto plan = sbx::graphics::detail::plan_barriers(passes, order);
+
+  ASSERT_EQ(plan.barriers.size(), order.size());
+
+  // The culling pass writes a buffer nobody wrote before, so it needs no barrier
+  EXPECT_TRUE(plan.barriers[0u].is_empty());
+
+  // The geometry pass waits for the indirect commands and transitions all of its attachments in the same barrier
+  const auto& geometry = plan.barriers[1u];
+
+  ASSERT_TRUE(geometry.memory.has_value());
+  EXPECT_NE(geometry.memory->dstStageMask & VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT, 0u);
+  EXPECT_NE(geometry.memory->srcAccessMask & VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, 0u);
+  ASSERT_EQ(geometry.images.size(), 3u);
+
+  for (const auto& barrier : geometry.images) {
+    EXPECT_EQ(barrier.old_layout, VK_IMAGE_LAYOUT_UNDEFINED);
+  }
+
+  EXPECT_EQ(std::ranges::count(geometry.images, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, &sbx::graphics::detail::image_barrier::new_layout), 1);
+
+  // The lighting pass reads all three attachments of the geometry pass and writes its own
+  const auto& lighting = plan.barriers[2u];
+
+  EXPECT_FALSE(lighting.memory.has_value());
+  ASSERT_EQ(lighting.images.size(), 4u);
+  EXPECT_EQ(std::ranges::count(lighting.images, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, &sbx::graphics::detail::image_barrier::new_layout), 3);
+
+  for (const auto& barrier : plan.barriers) {
+    auto names = std::vector<sbx::utility::hashed_string>{};
+
+    for (const auto& image : barrier.images) {
+      names.push_back(image.attachment);
+    }
+
+    std::ranges::sort(names, std::less{}, &sbx::utility::hashed_string::hash);
+
+    // Every attachment is transitioned at most once per boundary
+    EXPECT_EQ(std::ranges::adjacent_find(names), names.end());
+  }
+
+  ASSERT_EQ(plan.present.images.size(), 1u);
+  EXPECT_EQ(plan.present.images[0u].attachment, "swapchain"_hs);
+  EXPECT_EQ(plan.present.images[0u].old_layout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+  EXPECT_EQ(plan.present.images[0u].new_layout, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+}
+
+TEST(libsbx_graphics_render_graph, repeated_reads_need_no_barrier) {
+  using namespace render_graph_tests;
+
+  const auto passes = std::vector<sbx::graphics::detail::pass_description>{
+    graphics("shadow"_hs, {}, {depth("shadow_map"_hs)}),
+    graphics("opaque"_hs, {"shadow_map"_hs}, {color("opaque"_hs)}),
+    graphics("transparent"_hs, {"shadow_map"_hs, "opaque"_hs}, {color("transparent"_hs)}),
+    graphics("present"_hs, {"transparent"_hs}, {swapchain("swapchain"_hs)})
+  };
+
+  const auto order = sbx::graphics::detail::sort_passes(passes);
+  const auto plan = sbx::graphics::detail::plan_barriers(passes, order);
+
+  const auto& transparent = plan.barriers[2u];
+
+  // The shadow map is already readable, only the opaque output and the new attachment are transitioned
+  ASSERT_EQ(transparent.images.size(), 2u);
+  EXPECT_TRUE(std::ranges::none_of(transparent.images, [](const auto& barrier) { return barrier.attachment == "shadow_map"_hs; }));
+
+  EXPECT_EQ(plan.lifetimes.at("shadow_map"_hs).first, 0u);
+  EXPECT_EQ(plan.lifetimes.at("shadow_map"_hs).last, 2u);
+  EXPECT_EQ(plan.lifetimes.at("opaque"_hs).first, 1u);
+  EXPECT_EQ(plan.lifetimes.at("opaque"_hs).last, 2u);
+}
+
+TEST(libsbx_graphics_render_graph, non_overlapping_lifetimes_share_memory) {
+  using namespace render_graph_tests;
+
+  const auto requests = std::vector<sbx::graphics::detail::alias_request>{
+    request(0u, 1u, 1024u),
+    request(2u, 3u, 4096u),
+    request(4u, 5u, 2048u)
+  };
+
+  const auto blocks = sbx::graphics::detail::assign_aliases(requests);
+
+  ASSERT_EQ(blocks.size(), 1u);
+  EXPECT_EQ(blocks[0u].requests, (std::vector<std::size_t>{0u, 1u, 2u}));
+  EXPECT_EQ(blocks[0u].requirements.size, 4096u);
+}
+
+TEST(libsbx_graphics_render_graph, overlapping_lifetimes_do_not_share_memory) {
+  using namespace render_graph_tests;
+
+  // Lifetimes are inclusive, an attachment last used by a pass can not be aliased by one first used in the same pass
+  const auto requests = std::vector<sbx::graphics::detail::alias_request>{
+    request(0u, 2u, 1024u),
+    request(1u, 3u, 1024u),
+    request(2u, 4u, 1024u)
+  };
+
+  const auto blocks = sbx::graphics::detail::assign_aliases(requests);
+
+  ASSERT_EQ(blocks.size(), 3u);
+
+  for (const auto& block : blocks) {
+    EXPECT_EQ(block.requests.size(), 1u);
+  }
+}
+
+TEST(libsbx_graphics_render_graph, aliasing_respects_memory_types) {
+  using namespace render_graph_tests;
+
+  const auto requests = std::vector<sbx::graphics::detail::alias_request>{
+    request(3u, 4u, 512u, 0b01u),
+    request(0u, 1u, 1024u, 0b10u),
+    request(0u, 2u, 2048u, 0b11u),
+    request(5u, 6u, 4096u, 0b11u)
+  };
+
+  const auto blocks = sbx::graphics::detail::assign_aliases(requests);
+
+  ASSERT_EQ(blocks.size(), 2u);
+
+  // The request that only supports the first memory type can not reuse the block of the one that only supports the second
+  EXPECT_EQ(blocks[0u].requests, (std::vector<std::size_t>{1u}));
+  EXPECT_EQ(blocks[0u].requirements.memoryTypeBits, 0b10u);
+
+  EXPECT_EQ(blocks[1u].requests, (std::vector<std::size_t>{2u, 0u, 3u}));
+  EXPECT_EQ(blocks[1u].requirements.memoryTypeBits, 0b01u);
+  EXPECT_EQ(blocks[1u].requirements.size, 4096u);
+}
+
+#endif // LIBSBX_GRAPHICS_RENDER_GRAPH_TESTS_HPP_
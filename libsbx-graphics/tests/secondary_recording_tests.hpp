@@ -0,0 +1,134 @@
+#ifndef LIBSBX_GRAPHICS_SECONDARY_RECORDING_TESTS_HPP_
+#define LIBSBX_GRAPHICS_SECONDARY_RECORDING_TESTS_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/containers/task_graph.hpp>
+#include <libsbx/containers/executor.hpp>
+
+#include <graphics_tests/headless_device.hpp>
+
+namespace secondary_recording_tests {
+
+/**
+ * @brief Secondary command buffers of one thread, allocated from a pool only that thread records with. Mirrors how the renderer records thread safe subrenderers.
+ */
+struct per_thread_buffers {
+  VkCommandPool pool{VK_NULL_HANDLE};
+  std::vector<VkCommandBuffer> command_buffers;
+  std::size_t used{0u};
+}; // struct per_thread_buffers
+
+inline auto record(VkDevice device, per_thread_buffers& buffers, VkBuffer target, const std::uint32_t index, const VkDeviceSize slice_size) -> VkCommandBuffer {
+  if (buffers.used == buffers.command_buffers.size()) {
+    auto allocate_info = VkCommandBufferAllocateInfo{};
+    allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocate_info.commandPool = buffers.pool;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+    allocate_info.commandBufferCount = 1u;
+
+    auto command_buffer = VkCommandBuffer{};
+    vkAllocateCommandBuffers(device, &allocate_info, &command_buffer);
+
+    buffers.command_buffers.push_back(command_buffer);
+  }
+
+  auto command_buffer = buffers.command_buffers[buffers.used++];
+
+  auto inheritance_info = VkCommandBufferInheritanceInfo{};
+  inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+
+  auto begin_info = VkCommandBufferBeginInfo{};
+  begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+  begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+  begin_info.pInheritanceInfo = &inheritance_info;
+
+  vkBeginCommandBuffer(command_buffer, &begin_info);
+  vkCmdFillBuffer(command_buffer, target, index * slice_size, slice_size, index + 1u);
+  vkEndCommandBuffer(command_buffer);
+
+  return command_buffer;
+}
+
+} // namespace secondary_recording_tests
+
+TEST(libsbx_graphics_secondary_recording, workers_record_into_their_own_pools) {
+  using namespace secondary_recording_tests;
+
+  auto device = graphics_tests::headless_device{};
+
+  if (!device.is_valid()) {
+    GTEST_SKIP() << "No Vulkan 1.3 device available";
+  }
+
+  static constexpr auto count = 64u;
+  static constexpr auto slice_size = VkDeviceSize{256u};
+
+  auto executor = sbx::containers::executor{4u};
+
+  const auto target = device.create_buffer(count * slice_size);
+
+  // One set for every worker and one for the thread running the graph
+  auto per_thread = std::vector<per_thread_buffers>(executor.size() + 1u);
+
+  for (auto& buffers : per_thread) {
+    buffers.pool = device.create_command_pool();
+  }
+
+  // Recorded twice to reuse the command buffers of the first frame after their pools were reset
+  for (auto frame = 0u; frame < 2u; ++frame) {
+    for (auto& buffers : per_thread) {
+      vkResetCommandPool(device.handle(), buffers.pool, 0u);
+      buffers.used = 0u;
+    }
+
+    std::memset(target.mapped, 0, count * slice_size);
+
+    auto recorded = std::vector<VkCommandBuffer>(count, VK_NULL_HANDLE);
+
+    auto graph = sbx::containers::task_graph{"secondary_recording"};
+
+    for (auto i = 0u; i < count; ++i) {
+      graph.emplace([&, i]() {
+        auto& buffers = per_thread[executor.this_worker_id().value_or(executor.size())];
+
+        recorded[i] = record(device.handle(), buffers, target.handle, i, slice_size);
+      });
+    }
+
+    executor.run_and_wait(graph);
+
+    auto recorded_count = std::size_t{0u};
+
+    for (const auto& buffers : per_thread) {
+      recorded_count += buffers.used;
+    }
+
+    ASSERT_EQ(recorded_count, count);
+
+    device.submit([&](VkCommandBuffer command_buffer) {
+      vkCmdExecuteCommands(command_buffer, count, recorded.data());
+
+      graphics_tests::memory_barrier(command_buffer, VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+    });
+
+    const auto* values = static_cast<const std::uint32_t*>(target.mapped);
+
+    for (auto i = 0u; i < count; ++i) {
+      const auto first = i * slice_size / sizeof(std::uint32_t);
+      const auto last = (i + 1u) * slice_size / sizeof(std::uint32_t);
+
+      for (auto j = first; j < last; ++j) {
+        ASSERT_EQ(values[j], i + 1u) << "slice " << i << " in frame " << frame;
+      }
+    }
+  }
+}
+
+#endif // LIBSBX_GRAPHICS_SECONDARY_RECORDING_TESTS_HPP_
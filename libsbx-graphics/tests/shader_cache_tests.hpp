@@ -0,0 +1,163 @@
+#ifndef LIBSBX_GRAPHICS_SHADER_CACHE_TESTS_HPP_
+#define LIBSBX_GRAPHICS_SHADER_CACHE_TESTS_HPP_
+
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/utility/exception.hpp>
+
+#include <libsbx/graphics/pipeline/shader_cache.hpp>
+
+namespace shader_cache_tests {
+
+inline constexpr auto key = std::uint64_t{0x1234abcdu};
+
+inline auto write_file(const std::filesystem::path& path, const std::string& contents) -> void {
+  auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+  file << contents;
+}
+
+/**
+ * @brief A cache entry with one dependency in a temporary directory that is removed again at the end of the test.
+ */
+class scoped_entry {
+
+public:
+
+  explicit scoped_entry(const std::string& name)
+  : _directory{std::filesystem::temp_directory_path() / name} {
+    std::filesystem::create_directories(_directory);
+
+    write_file(dependency(), "float4 shade() { return 1.0; }\n");
+
+    const auto dependencies = std::vector<std::filesystem::path>{dependency()};
+
+    sbx::graphics::shader_cache::write(path(), key, dependencies, code());
+  }
+
+  ~scoped_entry() {
+    auto error = std::error_code{};
+    std::filesystem::remove_all(_directory, error);
+  }
+
+  auto path() const -> std::filesystem::path {
+    return sbx::graphics::shader_cache::path(_directory, key);
+  }
+
+  auto dependency() const -> std::filesystem::path {
+    return _directory / "common.slang";
+  }
+
+  static auto code() -> sbx::graphics::shader_cache::code_type {
+    auto code = sbx::graphics::shader_cache::code_type{};
+
+    code[SLANG_STAGE_VERTEX] = {0x07230203u, 0x00010500u, 1u, 2u, 3u};
+    code[SLANG_STAGE_FRAGMENT] = {0x07230203u, 0x00010500u, 4u};
+
+    return code;
+  }
+
+private:
+
+  std::filesystem::path _directory;
+
+}; // class scoped_entry
+
+inline auto overwrite(const std::filesystem::path& path, const std::streamoff offset, const char value) -> void {
+  auto file = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+  file.seekp(offset);
+  file.put(value);
+}
+
+} // namespace shader_cache_tests
+
+TEST(libsbx_graphics_shader_cache, round_trip) {
+  const auto entry = shader_cache_tests::scoped_entry{"libsbx_graphics_shader_cache_round_trip"};
+
+  EXPECT_EQ(entry.path().extension(), sbx::graphics::shader_cache_extension);
+
+  const auto code = sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key);
+
+  ASSERT_TRUE(code.has_value());
+  EXPECT_EQ(*code, shader_cache_tests::scoped_entry::code());
+}
+
+TEST(libsbx_graphics_shader_cache, misses) {
+  const auto entry = shader_cache_tests::scoped_entry{"libsbx_graphics_shader_cache_misses"};
+
+  EXPECT_FALSE(sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key + 1u).has_value());
+
+  auto missing = entry.path();
+  missing.replace_filename("missing.sbxspv");
+
+  EXPECT_FALSE(sbx::graphics::shader_cache::read(missing, shader_cache_tests::key).has_value());
+}
+
+TEST(libsbx_graphics_shader_cache, changed_dependency_misses) {
+  const auto entry = shader_cache_tests::scoped_entry{"libsbx_graphics_shader_cache_changed_dependency_misses"};
+
+  shader_cache_tests::write_file(entry.dependency(), "float4 shade() { return 0.5; }\n");
+
+  EXPECT_FALSE(sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key).has_value());
+
+  std::filesystem::remove(entry.dependency());
+
+  EXPECT_FALSE(sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key).has_value());
+}
+
+TEST(libsbx_graphics_shader_cache, corrupt_entries_throw) {
+  const auto entry = shader_cache_tests::scoped_entry{"libsbx_graphics_shader_cache_corrupt_entries_throw"};
+
+  const auto size = std::filesystem::file_size(entry.path());
+
+  // Last byte of the SPIR-V of a stage
+  shader_cache_tests::overwrite(entry.path(), static_cast<std::streamoff>(size - 1u), '\x7f');
+
+  EXPECT_THROW(sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key), sbx::utility::runtime_error);
+
+  shader_cache_tests::overwrite(entry.path(), 0, 'X');
+
+  EXPECT_THROW(sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key), sbx::utility::runtime_error);
+}
+
+TEST(libsbx_graphics_shader_cache, truncated_entries_throw) {
+  const auto entry = shader_cache_tests::scoped_entry{"libsbx_graphics_shader_cache_truncated_entries_throw"};
+
+  std::filesystem::resize_file(entry.path(), std::filesystem::file_size(entry.path()) - 4u);
+
+  EXPECT_THROW(sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key), sbx::utility::runtime_error);
+
+  std::filesystem::resize_file(entry.path(), sizeof(sbx::graphics::shader_cache_header) - 1u);
+
+  EXPECT_THROW(sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key), sbx::utility::runtime_error);
+}
+
+TEST(libsbx_graphics_shader_cache, rewrite_replaces_entry) {
+  const auto entry = shader_cache_tests::scoped_entry{"libsbx_graphics_shader_cache_rewrite_replaces_entry"};
+
+  auto code = sbx::graphics::shader_cache::code_type{};
+  code[SLANG_STAGE_COMPUTE] = {0x07230203u, 42u};
+
+  sbx::graphics::shader_cache::write(entry.path(), shader_cache_tests::key, {}, code);
+
+  const auto result = sbx::graphics::shader_cache::read(entry.path(), shader_cache_tests::key);
+
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(*result, code);
+
+  // No temporary files are left behind
+  auto count = 0u;
+
+  for ([[maybe_unused]] const auto& file : std::filesystem::directory_iterator{entry.path().parent_path()}) {
+    ++count;
+  }
+
+  EXPECT_EQ(count, 2u);
+}
+
+#endif // LIBSBX_GRAPHICS_SHADER_CACHE_TESTS_HPP_
@@ -0,0 +1,209 @@
+#ifndef LIBSBX_GRAPHICS_SLOT_BUFFER_TESTS_HPP_
+#define LIBSBX_GRAPHICS_SLOT_BUFFER_TESTS_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+#include <utility>
+#include <initializer_list>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/graphics/buffers/slot_buffer.hpp>
+
+namespace slot_buffer_tests {
+
+using slot_buffer = sbx::graphics::slot_buffer<std::uint32_t, std::uint32_t>;
+
+/**
+ * @brief Stands in for a storage buffer. Keeps a copy of the uploaded bytes and records every update as a range of slots.
+ */
+struct recording_buffer {
+
+  struct range {
+    std::size_t first;
+    std::size_t count;
+
+    auto operator==(const range& other) const noexcept -> bool = default;
+  }; // struct range
+
+  auto size() const noexcept -> std::size_t {
+    return bytes.size();
+  }
+
+  auto resize(const std::size_t size) -> void {
+    bytes.resize(size);
+  }
+
+  auto update(const void* data, const std::size_t size, const std::size_t offset = 0u) -> void {
+    std::memcpy(bytes.data() + offset, data, size);
+
+    updates.push_back(range{offset / sizeof(std::uint32_t), size / sizeof(std::uint32_t)});
+  }
+
+  auto value(const std::size_t index) const -> std::uint32_t {
+    auto result = std::uint32_t{};
+
+    std::memcpy(&result, bytes.data() + index * sizeof(std::uint32_t), sizeof(std::uint32_t));
+
+    return result;
+  }
+
+  std::vector<std::byte> bytes;
+  std::vector<range> updates;
+
+}; // struct recording_buffer
+
+/**
+ * @brief Runs one frame that assigns the keys with the given version. The value of a slot is its key plus the version.
+ *
+ * @return The number of times the factory was invoked.
+ */
+inline auto run_frame(slot_buffer& buffer, std::initializer_list<std::uint32_t> keys, const std::uint64_t version = 1u) -> std::size_t {
+  auto created = std::size_t{0u};
+
+  buffer.begin_frame();
+
+  for (const auto key : keys) {
+    buffer.assign(key, version, [&](){
+      ++created;
+      return key + static_cast<std::uint32_t>(version);
+    });
+  }
+
+  buffer.end_frame();
+
+  return created;
+}
+
+inline auto expect_mirrored(const slot_buffer& buffer, const recording_buffer& target) -> void {
+  for (auto i = 0u; i < buffer.size(); ++i) {
+    EXPECT_EQ(target.value(i), buffer.data()[i]) << "slot " << i;
+  }
+}
+
+} // namespace slot_buffer_tests
+
+TEST(libsbx_graphics_slot_buffer, static_entries_are_not_uploaded_again) {
+  auto buffer = slot_buffer_tests::slot_buffer{};
+  auto target = slot_buffer_tests::recording_buffer{};
+
+  EXPECT_EQ(slot_buffer_tests::run_frame(buffer, {0u, 1u, 2u, 3u}), 4u);
+
+  buffer.upload(target);
+
+  // The first upload grows the buffer and writes everything at once
+  EXPECT_EQ(target.updates, (std::vector<slot_buffer_tests::recording_buffer::range>{{0u, 4u}}));
+  slot_buffer_tests::expect_mirrored(buffer, target);
+
+  target.updates.clear();
+
+  EXPECT_EQ(slot_buffer_tests::run_frame(buffer, {0u, 1u, 2u, 3u}), 0u);
+
+  buffer.upload(target);
+
+  EXPECT_TRUE(target.updates.empty());
+}
+
+TEST(libsbx_graphics_slot_buffer, freed_slots_are_reused) {
+  auto buffer = slot_buffer_tests::slot_buffer{};
+
+  buffer.begin_frame();
+
+  const auto first = buffer.assign(10u, 1u, [](){ return 10u; });
+  const auto second = buffer.assign(20u, 1u, [](){ return 20u; });
+  const auto third = buffer.assign(30u, 1u, [](){ return 30u; });
+
+  EXPECT_FALSE(buffer.end_frame());
+
+  buffer.begin_frame();
+
+  EXPECT_EQ(buffer.assign(10u, 1u, [](){ return 10u; }), first);
+  EXPECT_EQ(buffer.assign(30u, 1u, [](){ return 30u; }), third);
+
+  EXPECT_TRUE(buffer.end_frame());
+  EXPECT_EQ(buffer.free_count(), 1u);
+
+  buffer.begin_frame();
+
+  buffer.assign(10u, 1u, [](){ return 10u; });
+  buffer.assign(30u, 1u, [](){ return 30u; });
+
+  EXPECT_EQ(buffer.assign(40u, 1u, [](){ return 40u; }), second);
+  EXPECT_EQ(buffer.data()[second], 40u);
+
+  EXPECT_FALSE(buffer.end_frame());
+  EXPECT_EQ(buffer.size(), 3u);
+  EXPECT_EQ(buffer.free_count(), 0u);
+}
+
+TEST(libsbx_graphics_slot_buffer, compaction_keeps_keys_consistent) {
+  auto buffer = slot_buffer_tests::slot_buffer{0.25f, 1u};
+  auto target = slot_buffer_tests::recording_buffer{};
+
+  slot_buffer_tests::run_frame(buffer, {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u});
+
+  buffer.upload(target);
+
+  // Frees the slots of keys 1 to 4, the holes are in the middle of the buffer
+  slot_buffer_tests::run_frame(buffer, {0u, 5u, 6u, 7u});
+
+  EXPECT_EQ(buffer.free_count(), 4u);
+
+  buffer.upload(target);
+
+  // Compacts at the start of the frame, the surviving keys keep their values
+  buffer.begin_frame();
+
+  EXPECT_EQ(buffer.size(), 4u);
+  EXPECT_EQ(buffer.free_count(), 0u);
+
+  for (const auto key : {0u, 5u, 6u, 7u}) {
+    auto is_created = false;
+
+    const auto index = buffer.assign(key, 1u, [&](){
+      is_created = true;
+      return 0u;
+    });
+
+    ASSERT_LT(index, buffer.size());
+    EXPECT_FALSE(is_created) << "key " << key;
+    EXPECT_EQ(buffer.data()[index], key + 1u) << "key " << key;
+  }
+
+  EXPECT_FALSE(buffer.end_frame());
+
+  // The moved slots are written to their new place
+  buffer.upload(target);
+
+  slot_buffer_tests::expect_mirrored(buffer, target);
+}
+
+TEST(libsbx_graphics_slot_buffer, adjacent_dirty_ranges_merge) {
+  auto buffer = slot_buffer_tests::slot_buffer{};
+  auto target = slot_buffer_tests::recording_buffer{};
+
+  slot_buffer_tests::run_frame(buffer, {0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u, 8u, 9u, 10u, 11u, 12u, 13u, 14u, 15u});
+
+  buffer.upload(target);
+  target.updates.clear();
+
+  buffer.begin_frame();
+
+  // Keys are assigned in order, so every key is also the index of its slot
+  for (auto key = 0u; key < 16u; ++key) {
+    const auto is_changed = (key == 2u || key == 3u || key == 6u || key == 14u);
+
+    buffer.assign(key, is_changed ? 2u : 1u, [&](){ return key + (is_changed ? 2u : 1u); });
+  }
+
+  buffer.end_frame();
+  buffer.upload(target);
+
+  // 2, 3 and 6 are close enough to be written as one range, the clean slots 4 and 5 are written along with them
+  EXPECT_EQ(target.updates, (std::vector<slot_buffer_tests::recording_buffer::range>{{2u, 5u}, {14u, 1u}}));
+  slot_buffer_tests::expect_mirrored(buffer, target);
+}
+
+#endif // LIBSBX_GRAPHICS_SLOT_BUFFER_TESTS_HPP_
@@ -0,0 +1,292 @@
+#ifndef LIBSBX_GRAPHICS_HEADLESS_DEVICE_HPP_
+#define LIBSBX_GRAPHICS_HEADLESS_DEVICE_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <iterator>
+
+#include <vulkan/vulkan.h>
+
+namespace graphics_tests {
+
+/**
+ * @brief A compute capable device without a window or surface, e.g. lavapipe on CI machines. Tests using it are skipped if none is available.
+ */
+class headless_device {
+
+public:
+
+  struct buffer {
+    VkBuffer handle{VK_NULL_HANDLE};
+    VkDeviceMemory memory{VK_NULL_HANDLE};
+    void* mapped{nullptr};
+    VkDeviceAddress address{0u};
+  }; // struct buffer
+
+  headless_device() {
+    auto application_info = VkApplicationInfo{};
+    application_info.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    application_info.pApplicationName = "libsbx-tests";
+    application_info.apiVersion = VK_API_VERSION_1_3;
+
+    auto instance_create_info = VkInstanceCreateInfo{};
+    instance_create_info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    instance_create_info.pApplicationInfo = &application_info;
+
+    if (vkCreateInstance(&instance_create_info, nullptr, &_instance) != VK_SUCCESS) {
+      _instance = VK_NULL_HANDLE;
+      return;
+    }
+
+    auto physical_device_count = std::uint32_t{0u};
+    vkEnumeratePhysicalDevices(_instance, &physical_device_count, nullptr);
+
+    auto physical_devices = std::vector<VkPhysicalDevice>(physical_device_count);
+    vkEnumeratePhysicalDevices(_instance, &physical_device_count, physical_devices.data());
+
+    for (const auto physical_device : physical_devices) {
+      auto properties = VkPhysicalDeviceProperties{};
+      vkGetPhysicalDeviceProperties(physical_device, &properties);
+
+      if (properties.apiVersion < VK_API_VERSION_1_3) {
+        continue;
+      }
+
+      auto queue_family_count = std::uint32_t{0u};
+      vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, nullptr);
+
+      auto queue_families = std::vector<VkQueueFamilyProperties>(queue_family_count);
+      vkGetPhysicalDeviceQueueFamilyProperties(physical_device, &queue_family_count, queue_families.data());
+
+      const auto queue_family = std::ranges::find_if(queue_families, [](const auto& family) { return (family.queueFlags & VK_QUEUE_COMPUTE_BIT) != 0u; });
+
+      if (queue_family != queue_families.end()) {
+        _physical_device = physical_device;
+        _queue_family = static_cast<std::uint32_t>(std::distance(queue_families.begin(), queue_family));
+        break;
+      }
+    }
+
+    if (_physical_device == VK_NULL_HANDLE) {
+      return;
+    }
+
+    const auto priority = 1.0f;
+
+    auto queue_create_info = VkDeviceQueueCreateInfo{};
+    queue_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue_create_info.queueFamilyIndex = _queue_family;
+    queue_create_info.queueCount = 1u;
+    queue_create_info.pQueuePriorities = &priority;
+
+    auto vulkan13_features = VkPhysicalDeviceVulkan13Features{};
+    vulkan13_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_3_FEATURES;
+    vulkan13_features.synchronization2 = VK_TRUE;
+
+    auto vulkan12_features = VkPhysicalDeviceVulkan12Features{};
+    vulkan12_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+    vulkan12_features.pNext = &vulkan13_features;
+    vulkan12_features.bufferDeviceAddress = VK_TRUE;
+
+    auto device_create_info = VkDeviceCreateInfo{};
+    device_create_info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_create_info.pNext = &vulkan12_features;
+    device_create_info.queueCreateInfoCount = 1u;
+    device_create_info.pQueueCreateInfos = &queue_create_info;
+
+    if (vkCreateDevice(_physical_device, &device_create_info, nullptr, &_device) != VK_SUCCESS) {
+      _device = VK_NULL_HANDLE;
+      return;
+    }
+
+    vkGetDeviceQueue(_device, _queue_family, 0u, &_queue);
+
+    auto command_pool_create_info = VkCommandPoolCreateInfo{};
+    command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    command_pool_create_info.queueFamilyIndex = _queue_family;
+
+    vkCreateCommandPool(_device, &command_pool_create_info, nullptr, &_command_pool);
+  }
+
+  ~headless_device() {
+    if (_device != VK_NULL_HANDLE) {
+      vkDeviceWaitIdle(_device);
+
+      for (auto& buffer : _buffers) {
+        vkDestroyBuffer(_device, buffer.handle, nullptr);
+        vkFreeMemory(_device, buffer.memory, nullptr);
+      }
+
+      for (const auto command_pool : _command_pools) {
+        vkDestroyCommandPool(_device, command_pool, nullptr);
+      }
+
+      vkDestroyCommandPool(_device, _command_pool, nullptr);
+      vkDestroyDevice(_device, nullptr);
+    }
+
+    if (_instance != VK_NULL_HANDLE) {
+      vkDestroyInstance(_instance, nullptr);
+    }
+  }
+
+  auto is_valid() const noexcept -> bool {
+    return _device != VK_NULL_HANDLE;
+  }
+
+  auto handle() const noexcept -> VkDevice {
+    return _device;
+  }
+
+  /**
+   * @brief Creates a host visible storage buffer with a device address. The buffer lives as long as the device.
+   */
+  auto create_buffer(const VkDeviceSize size, const void* data = nullptr) -> buffer {
+    auto result = buffer{};
+
+    auto buffer_create_info = VkBufferCreateInfo{};
+    buffer_create_info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    buffer_create_info.size = size;
+    buffer_create_info.usage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
+    buffer_create_info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    vkCreateBuffer(_device, &buffer_create_info, nullptr, &result.handle);
+
+    auto requirements = VkMemoryRequirements{};
+    vkGetBufferMemoryRequirements(_device, result.handle, &requirements);
+
+    auto memory_properties = VkPhysicalDeviceMemoryProperties{};
+    vkGetPhysicalDeviceMemoryProperties(_physical_device, &memory_properties);
+
+    const auto required_flags = VkMemoryPropertyFlags{VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT};
+
+    auto memory_type = std::uint32_t{0u};
+
+    while (((requirements.memoryTypeBits >> memory_type) & 1u) == 0u || (memory_properties.memoryTypes[memory_type].propertyFlags & required_flags) != required_flags) {
+      ++memory_type;
+    }
+
+    auto allocate_flags_info = VkMemoryAllocateFlagsInfo{};
+    allocate_flags_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO;
+    allocate_flags_info.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT;
+
+    auto allocate_info = VkMemoryAllocateInfo{};
+    allocate_info.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocate_info.pNext = &allocate_flags_info;
+    allocate_info.allocationSize = requirements.size;
+    allocate_info.memoryTypeIndex = memory_type;
+
+    vkAllocateMemory(_device, &allocate_info, nullptr, &result.memory);
+    vkBindBufferMemory(_device, result.handle, result.memory, 0u);
+    vkMapMemory(_device, result.memory, 0u, VK_WHOLE_SIZE, 0u, &result.mapped);
+
+    if (data) {
+      std::memcpy(result.mapped, data, size);
+    } else {
+      std::memset(result.mapped, 0, size);
+    }
+
+    auto address_info = VkBufferDeviceAddressInfo{};
+    address_info.sType = VK_STRUCTURE_TYPE_BUFFER_DEVICE_ADDRESS_INFO;
+    address_info.buffer = result.handle;
+
+    result.address = vkGetBufferDeviceAddress(_device, &address_info);
+
+    _buffers.push_back(result);
+
+    return result;
+  }
+
+  /**
+   * @brief Creates a command pool on the queue family of the device. The pool lives as long as the device.
+   */
+  auto create_command_pool() -> VkCommandPool {
+    auto command_pool_create_info = VkCommandPoolCreateInfo{};
+    command_pool_create_info.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    command_pool_create_info.queueFamilyIndex = _queue_family;
+
+    auto command_pool = VkCommandPool{};
+    vkCreateCommandPool(_device, &command_pool_create_info, nullptr, &command_pool);
+
+    _command_pools.push_back(command_pool);
+
+    return command_pool;
+  }
+
+  /**
+   * @brief Records the commands of the callable into a one time command buffer, submits it and waits until it finished.
+   */
+  template<typename Callable>
+  auto submit(Callable&& callable) -> void {
+    auto allocate_info = VkCommandBufferAllocateInfo{};
+    allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocate_info.commandPool = _command_pool;
+    allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocate_info.commandBufferCount = 1u;
+
+    auto command_buffer = VkCommandBuffer{};
+    vkAllocateCommandBuffers(_device, &allocate_info, &command_buffer);
+
+    auto begin_info = VkCommandBufferBeginInfo{};
+    begin_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    begin_info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    vkBeginCommandBuffer(command_buffer, &begin_info);
+
+    std::invoke(callable, command_buffer);
+
+    vkEndCommandBuffer(command_buffer);
+
+    auto fence_create_info = VkFenceCreateInfo{};
+    fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+
+    auto fence = VkFence{};
+    vkCreateFence(_device, &fence_create_info, nullptr, &fence);
+
+    auto submit_info = VkSubmitInfo{};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1u;
+    submit_info.pCommandBuffers = &command_buffer;
+
+    vkQueueSubmit(_queue, 1u, &submit_info, fence);
+    vkWaitForFences(_device, 1u, &fence, VK_TRUE, UINT64_MAX);
+
+    vkDestroyFence(_device, fence, nullptr);
+    vkFreeCommandBuffers(_device, _command_pool, 1u, &command_buffer);
+  }
+
+private:
+
+  VkInstance _instance{VK_NULL_HANDLE};
+  VkPhysicalDevice _physical_device{VK_NULL_HANDLE};
+  VkDevice _device{VK_NULL_HANDLE};
+  VkQueue _queue{VK_NULL_HANDLE};
+  VkCommandPool _command_pool{VK_NULL_HANDLE};
+  std::uint32_t _queue_family{0u};
+  std::vector<buffer> _buffers;
+  std::vector<VkCommandPool> _command_pools;
+
+}; // class headless_device
+
+inline auto memory_barrier(VkCommandBuffer command_buffer, const VkPipelineStageFlags2 src_stage, const VkAccessFlags2 src_access, const VkPipelineStageFlags2 dst_stage, const VkAccessFlags2 dst_access) -> void {
+  auto barrier = VkMemoryBarrier2{};
+  barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+  barrier.srcStageMask = src_stage;
+  barrier.srcAccessMask = src_access;
+  barrier.dstStageMask = dst_stage;
+  barrier.dstAccessMask = dst_access;
+
+  auto dependency_info = VkDependencyInfo{};
+  dependency_info.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO;
+  dependency_info.memoryBarrierCount = 1u;
+  dependency_info.pMemoryBarriers = &barrier;
+
+  vkCmdPipelineBarrier2(command_buffer, &dependency_info);
+}
+
+} // namespace graphics_tests
+
+#endif // LIBSBX_GRAPHICS_HEADLESS_DEVICE_HPP_
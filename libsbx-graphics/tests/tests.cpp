@@ -0,0 +1,14 @@
+#include <gtest/gtest.h>
+
+#include <tests/render_graph_tests.hpp>
+#include <tests/shader_cache_tests.hpp>
+#include <tests/secondary_recording_tests.hpp>
+#include <tests/descriptor_set_cache_tests.hpp>
+#include <tests/bindless_table_tests.hpp>
+#include <tests/slot_buffer_tests.hpp>
+
+auto main(int argc, char* argv[]) -> int {
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,62 @@
+#include <libsbx/math/cluster_culler.hpp>
+
+#include <algorithm>
+
+namespace sbx::math {
+
+cluster_culler::cluster_culler(const box& frustum, const vector3& camera_position, const std::float_t margin)
+: _frustum{frustum},
+  _camera_position{camera_position},
+  _margin{margin} { }
+
+auto cluster_culler::is_visible(const cluster_bounds& bounds, const matrix4x4& model) const noexcept -> bool {
+  const auto scale_x = vector3{model[0]}.length();
+  const auto scale_y = vector3{model[1]}.length();
+  const auto scale_z = vector3{model[2]}.length();
+
+  const auto scale = std::max({scale_x, scale_y, scale_z});
+
+  const auto center = vector3{model * vector4{bounds.center, 1.0f}};
+  const auto radius = bounds.radius * scale;
+
+  if (is_outside(_frustum, center, radius, _margin)) {
+    return false;
+  }
+
+  const auto is_uniform = (scale - std::min({scale_x, scale_y, scale_z})) <= scale * 0.001f;
+
+  if (!is_uniform || bounds.cone_cutoff >= 1.0f) {
+    return true;
+  }
+
+  const auto cone_axis = vector3::normalized(vector3{model * vector4{bounds.cone_axis, 0.0f}});
+
+  return !is_backfacing(center, radius, cone_axis, bounds.cone_cutoff, _camera_position);
+}
+
+auto cluster_culler::cull(std::span<const cluster_bounds> clusters, const matrix4x4& model, std::vector<std::uint32_t>& visible) const -> void {
+  for (auto i = 0u; i < clusters.size(); ++i) {
+    if (is_visible(clusters[i], model)) {
+      visible.push_back(i);
+    }
+  }
+}
+
+auto cluster_culler::is_outside(const box& frustum, const vector3& center, const std::float_t radius, const std::float_t margin) noexcept -> bool {
+  for (const auto& plane : frustum.planes()) {
+    if (plane.distance_to_point(center) < -(radius + margin)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+auto cluster_culler::is_backfacing(const vector3& center, const std::float_t radius, const vector3& cone_axis, const std::float_t cone_cutoff, const vector3& camera_position) noexcept -> bool {
+  const auto direction = center - camera_position;
+
+  // Conservative for the whole sphere, the cone apex is not needed
+  return vector3::dot(direction, cone_axis) >= cone_cutoff * direction.length() + radius;
+}
+
+} // namespace sbx::math
@@ -0,0 +1,71 @@
+#ifndef LIBSBX_MATH_CLUSTER_CULLER_HPP_
+#define LIBSBX_MATH_CLUSTER_CULLER_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+#include <libsbx/math/volume.hpp>
+#include <libsbx/math/box.hpp>
+
+namespace sbx::math {
+
+/**
+ * @brief Bounds of a cluster of triangles in the space of its mesh.
+ *
+ * All triangles of the cluster face away from a viewer at position p if dot(normalize(center - p), cone_axis) >= cone_cutoff holds for
+ * every point of the bounding sphere. A cone_cutoff of 1 disables the test.
+ */
+struct cluster_bounds {
+  vector3 center;
+  std::float_t radius;
+  vector3 cone_axis;
+  std::float_t cone_cutoff;
+}; // struct cluster_bounds
+
+/**
+ * @brief Reference implementation of per cluster culling against the view frustum and the normal cones of the clusters.
+ *
+ * Meant to validate GPU implementations and for tools, it tests one cluster at a time.
+ */
+class cluster_culler {
+
+public:
+
+  /**
+   * @param frustum Planes in world space with normals pointing inwards.
+   * @param camera_position Position of the camera in world space.
+   * @param margin Distance a cluster may be outside of a plane and still count as visible.
+   */
+  cluster_culler(const box& frustum, const vector3& camera_position, const std::float_t margin = 0.0f);
+
+  /**
+   * @brief Returns true if any triangle of the cluster may be visible when its mesh is drawn with the model matrix.
+   *
+   * The cone test is skipped for non uniformly scaled models, their cones can not be transformed.
+   */
+  auto is_visible(const cluster_bounds& bounds, const matrix4x4& model) const noexcept -> bool;
+
+  /**
+   * @brief Appends the indices of all visible clusters to visible, in ascending order.
+   */
+  auto cull(std::span<const cluster_bounds> clusters, const matrix4x4& model, std::vector<std::uint32_t>& visible) const -> void;
+
+  static auto is_outside(const box& frustum, const vector3& center, const std::float_t radius, const std::float_t margin = 0.0f) noexcept -> bool;
+
+  static auto is_backfacing(const vector3& center, const std::float_t radius, const vector3& cone_axis, const std::float_t cone_cutoff, const vector3& camera_position) noexcept -> bool;
+
+private:
+
+  box _frustum;
+  vector3 _camera_position;
+  std::float_t _margin;
+
+}; // class cluster_culler
+
+} // namespace sbx::math
+
+#endif // LIBSBX_MATH_CLUSTER_CULLER_HPP_
@@ -0,0 +1,223 @@
+#include <libsbx/math/frustum_culler.hpp>
+
+#include <algorithm>
+#include <bit>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+namespace sbx::math {
+
+auto bounds_set::push_back(const volume& aabb, const sphere& sphere) -> void {
+  const auto lane = _size % bounds_batch::lane_count;
+
+  if (lane == 0u) {
+    // Unused lanes stay empty boxes at the origin, they are masked out by cull
+    _batches.emplace_back();
+  }
+
+  auto& batch = _batches.back();
+
+  const auto center = aabb.center();
+  const auto extent = (aabb.max() - aabb.min()) * 0.5f;
+
+  batch.center_x[lane] = center.x();
+  batch.center_y[lane] = center.y();
+  batch.center_z[lane] = center.z();
+  batch.extent_x[lane] = extent.x();
+  batch.extent_y[lane] = extent.y();
+  batch.extent_z[lane] = extent.z();
+  batch.sphere_x[lane] = sphere.center().x();
+  batch.sphere_y[lane] = sphere.center().y();
+  batch.sphere_z[lane] = sphere.center().z();
+  batch.radius[lane] = sphere.radius();
+
+  ++_size;
+}
+
+auto bounds_set::push_back(const volume& local, const matrix4x4& model) -> void {
+  const auto local_center = local.center();
+  const auto local_extent = (local.max() - local.min()) * 0.5f;
+
+  const auto center = vector3{model * vector4{local_center, 1.0f}};
+
+  const auto axis_x = vector3{model[0]};
+  const auto axis_y = vector3{model[1]};
+  const auto axis_z = vector3{model[2]};
+
+  // Extent of the transformed box projected on the world axes
+  const auto extent = vector3{
+    std::abs(axis_x.x()) * local_extent.x() + std::abs(axis_y.x()) * local_extent.y() + std::abs(axis_z.x()) * local_extent.z(),
+    std::abs(axis_x.y()) * local_extent.x() + std::abs(axis_y.y()) * local_extent.y() + std::abs(axis_z.y()) * local_extent.z(),
+    std::abs(axis_x.z()) * local_extent.x() + std::abs(axis_y.z()) * local_extent.y() + std::abs(axis_z.z()) * local_extent.z()
+  };
+
+  const auto scale = std::max({axis_x.length(), axis_y.length(), axis_z.length()});
+
+  push_back(volume{center - extent, center + extent}, sphere{center, local_extent.length() * scale});
+}
+
+frustum_culler::frustum_culler(const box& frustum, const std::float_t margin) {
+  for (auto i = 0u; i < _planes.size(); ++i) {
+    const auto& plane = frustum.plane(i);
+    const auto& normal = plane.normal();
+
+    _planes[i] = plane_lanes{
+      .normal_x = normal.x(),
+      .normal_y = normal.y(),
+      .normal_z = normal.z(),
+      .absolute_x = std::abs(normal.x()),
+      .absolute_y = std::abs(normal.y()),
+      .absolute_z = std::abs(normal.z()),
+      .distance = plane.distance() + margin
+    };
+  }
+}
+
+#if defined(__AVX__)
+
+auto frustum_culler::test(const bounds_batch& batch) const noexcept -> std::uint8_t {
+  const auto center_x = _mm256_load_ps(batch.center_x.data());
+  const auto center_y = _mm256_load_ps(batch.center_y.data());
+  const auto center_z = _mm256_load_ps(batch.center_z.data());
+  const auto extent_x = _mm256_load_ps(batch.extent_x.data());
+  const auto extent_y = _mm256_load_ps(batch.extent_y.data());
+  const auto extent_z = _mm256_load_ps(batch.extent_z.data());
+  const auto sphere_x = _mm256_load_ps(batch.sphere_x.data());
+  const auto sphere_y = _mm256_load_ps(batch.sphere_y.data());
+  const auto sphere_z = _mm256_load_ps(batch.sphere_z.data());
+  const auto radius = _mm256_load_ps(batch.radius.data());
+
+  auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+  for (const auto& plane : _planes) {
+    const auto normal_x = _mm256_set1_ps(plane.normal_x);
+    const auto normal_y = _mm256_set1_ps(plane.normal_y);
+    const auto normal_z = _mm256_set1_ps(plane.normal_z);
+    const auto distance = _mm256_set1_ps(plane.distance);
+
+    // Box: signed distance of the center plus the projected extent
+    auto box_distance = _mm256_add_ps(_mm256_mul_ps(normal_x, center_x), distance);
+    box_distance = _mm256_add_ps(box_distance, _mm256_mul_ps(normal_y, center_y));
+    box_distance = _mm256_add_ps(box_distance, _mm256_mul_ps(normal_z, center_z));
+    box_distance = _mm256_add_ps(box_distance, _mm256_mul_ps(_mm256_set1_ps(plane.absolute_x), extent_x));
+    box_distance = _mm256_add_ps(box_distance, _mm256_mul_ps(_mm256_set1_ps(plane.absolute_y), extent_y));
+    box_distance = _mm256_add_ps(box_distance, _mm256_mul_ps(_mm256_set1_ps(plane.absolute_z), extent_z));
+
+    // Sphere: signed distance of the center plus the radius
+    auto sphere_distance = _mm256_add_ps(_mm256_mul_ps(normal_x, sphere_x), distance);
+    sphere_distance = _mm256_add_ps(sphere_distance, _mm256_mul_ps(normal_y, sphere_y));
+    sphere_distance = _mm256_add_ps(sphere_distance, _mm256_mul_ps(normal_z, sphere_z));
+    sphere_distance = _mm256_add_ps(sphere_distance, radius);
+
+    const auto zero = _mm256_setzero_ps();
+
+    inside = _mm256_and_ps(inside, _mm256_cmp_ps(box_distance, zero, _CMP_GE_OQ));
+    inside = _mm256_and_ps(inside, _mm256_cmp_ps(sphere_distance, zero, _CMP_GE_OQ));
+  }
+
+  return static_cast<std::uint8_t>(_mm256_movemask_ps(inside));
+}
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+auto frustum_culler::test(const bounds_batch& batch) const noexcept -> std::uint8_t {
+  auto mask = 0;
+
+  // Two halves of four lanes each
+  for (auto half = 0u; half < 2u; ++half) {
+    const auto offset = half * 4u;
+
+    const auto center_x = _mm_load_ps(batch.center_x.data() + offset);
+    const auto center_y = _mm_load_ps(batch.center_y.data() + offset);
+    const auto center_z = _mm_load_ps(batch.center_z.data() + offset);
+    const auto extent_x = _mm_load_ps(batch.extent_x.data() + offset);
+    const auto extent_y = _mm_load_ps(batch.extent_y.data() + offset);
+    const auto extent_z = _mm_load_ps(batch.extent_z.data() + offset);
+    const auto sphere_x = _mm_load_ps(batch.sphere_x.data() + offset);
+    const auto sphere_y = _mm_load_ps(batch.sphere_y.data() + offset);
+    const auto sphere_z = _mm_load_ps(batch.sphere_z.data() + offset);
+    const auto radius = _mm_load_ps(batch.radius.data() + offset);
+
+    auto inside = _mm_cmpeq_ps(center_x, center_x);
+
+    for (const auto& plane : _planes) {
+      const auto normal_x = _mm_set1_ps(plane.normal_x);
+      const auto normal_y = _mm_set1_ps(plane.normal_y);
+      const auto normal_z = _mm_set1_ps(plane.normal_z);
+      const auto distance = _mm_set1_ps(plane.distance);
+
+      // Box: signed distance of the center plus the projected extent
+      auto box_distance = _mm_add_ps(_mm_mul_ps(normal_x, center_x), distance);
+      box_distance = _mm_add_ps(box_distance, _mm_mul_ps(normal_y, center_y));
+      box_distance = _mm_add_ps(box_distance, _mm_mul_ps(normal_z, center_z));
+      box_distance = _mm_add_ps(box_distance, _mm_mul_ps(_mm_set1_ps(plane.absolute_x), extent_x));
+      box_distance = _mm_add_ps(box_distance, _mm_mul_ps(_mm_set1_ps(plane.absolute_y), extent_y));
+      box_distance = _mm_add_ps(box_distance, _mm_mul_ps(_mm_set1_ps(plane.absolute_z), extent_z));
+
+      // Sphere: signed distance of the center plus the radius
+      auto sphere_distance = _mm_add_ps(_mm_mul_ps(normal_x, sphere_x), distance);
+      sphere_distance = _mm_add_ps(sphere_distance, _mm_mul_ps(normal_y, sphere_y));
+      sphere_distance = _mm_add_ps(sphere_distance, _mm_mul_ps(normal_z, sphere_z));
+      sphere_distance = _mm_add_ps(sphere_distance, radius);
+
+      const auto zero = _mm_setzero_ps();
+
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(box_distance, zero));
+      inside = _mm_and_ps(inside, _mm_cmpge_ps(sphere_distance, zero));
+    }
+
+    mask |= _mm_movemask_ps(inside) << offset;
+  }
+
+  return static_cast<std::uint8_t>(mask);
+}
+
+#else
+
+auto frustum_culler::test(const bounds_batch& batch) const noexcept -> std::uint8_t {
+  auto mask = std::uint8_t{0xFFu};
+
+  for (const auto& plane : _planes) {
+    for (auto lane = 0u; lane < bounds_batch::lane_count; ++lane) {
+      const auto box_distance = plane.normal_x * batch.center_x[lane] + plane.distance + plane.normal_y * batch.center_y[lane] + plane.normal_z * batch.center_z[lane] + plane.absolute_x * batch.extent_x[lane] + plane.absolute_y * batch.extent_y[lane] + plane.absolute_z * batch.extent_z[lane];
+      const auto sphere_distance = plane.normal_x * batch.sphere_x[lane] + plane.distance + plane.normal_y * batch.sphere_y[lane] + plane.normal_z * batch.sphere_z[lane] + batch.radius[lane];
+
+      if (!(box_distance >= 0.0f && sphere_distance >= 0.0f)) {
+        mask = static_cast<std::uint8_t>(mask & ~(1u << lane));
+      }
+    }
+  }
+
+  return mask;
+}
+
+#endif
+
+auto frustum_culler::cull(const bounds_set& bounds, std::vector<std::uint32_t>& visible) const -> void {
+  const auto& batches = bounds.batches();
+
+  for (auto i = 0u; i < batches.size(); ++i) {
+    const auto base = static_cast<std::uint32_t>(i * bounds_batch::lane_count);
+    const auto remaining = bounds.size() - base;
+
+    auto mask = static_cast<std::uint32_t>(test(batches[i]));
+
+    if (remaining < bounds_batch::lane_count) {
+      mask &= (1u << remaining) - 1u;
+    }
+
+    while (mask != 0u) {
+      const auto lane = static_cast<std::uint32_t>(std::countr_zero(mask));
+
+      visible.push_back(base + lane);
+
+      mask &= mask - 1u;
+    }
+  }
+}
+
+} // namespace sbx::math
@@ -0,0 +1,133 @@
+#ifndef LIBSBX_MATH_FRUSTUM_CULLER_HPP_
+#define LIBSBX_MATH_FRUSTUM_CULLER_HPP_
+
+#include <array>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+#include <libsbx/math/volume.hpp>
+#include <libsbx/math/sphere.hpp>
+#include <libsbx/math/box.hpp>
+
+namespace sbx::math {
+
+/**
+ * @brief Bounds of up to eight objects in structure of arrays layout, so that one plane can be tested against all of them at once.
+ */
+struct alignas(32) bounds_batch {
+
+  inline static constexpr auto lane_count = std::size_t{8u};
+
+  using lane_type = std::array<std::float_t, lane_count>;
+
+  lane_type center_x;
+  lane_type center_y;
+  lane_type center_z;
+  lane_type extent_x;
+  lane_type extent_y;
+  lane_type extent_z;
+  lane_type sphere_x;
+  lane_type sphere_y;
+  lane_type sphere_z;
+  lane_type radius;
+
+}; // struct bounds_batch
+
+/**
+ * @brief World space bounds of a set of objects, packed into batches of eight.
+ *
+ * Every object has an axis aligned box and a sphere, an object is only visible if both of them are.
+ * The box is tight for axis aligned objects, the sphere for rotated ones.
+ */
+class bounds_set {
+
+public:
+
+  using size_type = std::size_t;
+
+  bounds_set() = default;
+
+  auto size() const noexcept -> size_type {
+    return _size;
+  }
+
+  auto is_empty() const noexcept -> bool {
+    return _size == 0u;
+  }
+
+  auto clear() -> void {
+    _batches.clear();
+    _size = 0u;
+  }
+
+  auto reserve(const size_type size) -> void {
+    _batches.reserve((size + bounds_batch::lane_count - 1u) / bounds_batch::lane_count);
+  }
+
+  auto push_back(const volume& aabb, const sphere& sphere) -> void;
+
+  /**
+   * @brief Adds the bounds of an object with local bounds and a model matrix.
+   */
+  auto push_back(const volume& local, const matrix4x4& model) -> void;
+
+  auto batches() const noexcept -> const std::vector<bounds_batch>& {
+    return _batches;
+  }
+
+private:
+
+  std::vector<bounds_batch> _batches;
+  size_type _size{0u};
+
+}; // class bounds_set
+
+/**
+ * @brief Tests bounds against the six planes of a frustum, eight objects at a time.
+ *
+ * Uses AVX if the translation unit is compiled with it, SSE otherwise and a scalar loop on platforms without either.
+ */
+class frustum_culler {
+
+public:
+
+  /**
+   * @param frustum Planes with normals pointing inwards.
+   * @param margin Distance an object may be outside of a plane and still count as visible.
+   */
+  explicit frustum_culler(const box& frustum, const std::float_t margin = 0.5f);
+
+  /**
+   * @brief Tests one batch.
+   *
+   * @return Bit i is set if lane i of the batch is visible. Lanes past the size of the set are unspecified.
+   */
+  auto test(const bounds_batch& batch) const noexcept -> std::uint8_t;
+
+  /**
+   * @brief Appends the indices of all visible objects of the set to visible, in ascending order.
+   */
+  auto cull(const bounds_set& bounds, std::vector<std::uint32_t>& visible) const -> void;
+
+private:
+
+  struct plane_lanes {
+    std::float_t normal_x;
+    std::float_t normal_y;
+    std::float_t normal_z;
+    std::float_t absolute_x;
+    std::float_t absolute_y;
+    std::float_t absolute_z;
+    std::float_t distance;
+  }; // struct plane_lanes
+
+  std::array<plane_lanes, 6u> _planes;
+
+}; // class frustum_culler
+
+} // namespace sbx::math
+
+#endif // LIBSBX_MATH_FRUSTUM_CULLER_HPP_
@@ -67,5 +67,10 @@
 #include <libsbx/math/sphere.hpp>
 #include <libsbx/math/plane.hpp>
 #include <libsbx/math/box.hpp>
+#include <libsbx/math/ray.hpp>
+
+#include <libsbx/math/frustum_culler.hpp>
+#include <libsbx/math/cluster_culler.hpp>
+#include <libsbx/math/occlusion_buffer.hpp>
 
 #endif // LIBSBX_MATH_HPP_
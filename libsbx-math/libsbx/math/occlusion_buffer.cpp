@@ -0,0 +1,180 @@
+#include <libsbx/math/occlusion_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+namespace sbx::math {
+
+// Clip space w below which a point is treated as being on or behind the camera
+static constexpr auto minimum_w = std::float_t{1e-5f};
+
+occlusion_buffer::occlusion_buffer(const size_type width, const size_type height)
+: _width{width},
+  _height{height},
+  _view_projection{matrix4x4::identity},
+  _depth(static_cast<std::size_t>(width) * static_cast<std::size_t>(height), 1.0f) { }
+
+auto occlusion_buffer::clear(const matrix4x4& view_projection) -> void {
+  _view_projection = view_projection;
+
+  std::ranges::fill(_depth, 1.0f);
+}
+
+auto occlusion_buffer::rasterize(const volume& occluder, const matrix4x4& model) -> void {
+  // Corner i has bit 2 set for max x, bit 1 for max y and bit 0 for max z, see volume::corners
+  static constexpr auto indices = std::array<std::uint32_t, 36u>{
+    0, 1, 3, 0, 3, 2, // -x
+    4, 6, 7, 4, 7, 5, // +x
+    0, 4, 5, 0, 5, 1, // -y
+    2, 3, 7, 2, 7, 6, // +y
+    0, 2, 6, 0, 6, 4, // -z
+    1, 5, 7, 1, 7, 3  // +z
+  };
+
+  auto corners = occluder.corners();
+
+  for (auto& corner : corners) {
+    corner = vector3{model * vector4{corner, 1.0f}};
+  }
+
+  rasterize(corners, indices);
+}
+
+auto occlusion_buffer::rasterize(std::span<const vector3> vertices, std::span<const std::uint32_t> indices) -> void {
+  for (auto i = 0u; i + 2u < indices.size(); i += 3u) {
+    const auto c0 = _view_projection * vector4{vertices[indices[i]], 1.0f};
+    const auto c1 = _view_projection * vector4{vertices[indices[i + 1u]], 1.0f};
+    const auto c2 = _view_projection * vector4{vertices[indices[i + 2u]], 1.0f};
+
+    if (c0.w() < minimum_w || c1.w() < minimum_w || c2.w() < minimum_w) {
+      continue;
+    }
+
+    const auto s0 = _to_screen(c0);
+    const auto s1 = _to_screen(c1);
+    const auto s2 = _to_screen(c2);
+
+    if (s0.z() < 0.0f || s1.z() < 0.0f || s2.z() < 0.0f) {
+      continue;
+    }
+
+    _rasterize_triangle(s0, s1, s2);
+  }
+}
+
+auto occlusion_buffer::is_visible(const volume& bounds) const -> bool {
+  auto min_x = std::numeric_limits<std::float_t>::max();
+  auto min_y = std::numeric_limits<std::float_t>::max();
+  auto max_x = std::numeric_limits<std::float_t>::lowest();
+  auto max_y = std::numeric_limits<std::float_t>::lowest();
+  auto nearest = std::numeric_limits<std::float_t>::max();
+
+  for (const auto& corner : bounds.corners()) {
+    const auto clip = _view_projection * vector4{corner, 1.0f};
+
+    // Boxes that reach behind the camera cover an unbounded part of the screen
+    if (clip.w() < minimum_w) {
+      return true;
+    }
+
+    const auto screen = _to_screen(clip);
+
+    if (screen.z() < 0.0f) {
+      return true;
+    }
+
+    min_x = std::min(min_x, screen.x());
+    min_y = std::min(min_y, screen.y());
+    max_x = std::max(max_x, screen.x());
+    max_y = std::max(max_y, screen.y());
+    nearest = std::min(nearest, screen.z());
+  }
+
+  const auto width = static_cast<std::float_t>(_width);
+  const auto height = static_cast<std::float_t>(_height);
+
+  // Not on screen, so nothing can hide it. Whether it is in view at all is up to the frustum test
+  if (max_x < 0.0f || max_y < 0.0f || min_x >= width || min_y >= height) {
+    return true;
+  }
+
+  const auto first_x = static_cast<size_type>(std::max(min_x, 0.0f));
+  const auto first_y = static_cast<size_type>(std::max(min_y, 0.0f));
+  const auto last_x = static_cast<size_type>(std::min(max_x, width - 1.0f));
+  const auto last_y = static_cast<size_type>(std::min(max_y, height - 1.0f));
+
+  for (auto y = first_y; y <= last_y; ++y) {
+    const auto* row = _depth.data() + static_cast<std::size_t>(y) * _width;
+
+    for (auto x = first_x; x <= last_x; ++x) {
+      if (row[x] >= nearest) {
+        return true;
+      }
+    }
+  }
+
+  return false;
+}
+
+auto occlusion_buffer::_to_screen(const vector4& clip) const noexcept -> vector3 {
+  const auto inverse_w = 1.0f / clip.w();
+
+  return vector3{
+    (clip.x() * inverse_w * 0.5f + 0.5f) * static_cast<std::float_t>(_width),
+    (clip.y() * inverse_w * 0.5f + 0.5f) * static_cast<std::float_t>(_height),
+    clip.z() * inverse_w
+  };
+}
+
+auto occlusion_buffer::_rasterize_triangle(const vector3& v0, const vector3& v1, const vector3& v2) -> void {
+  const auto area = (v1.x() - v0.x()) * (v2.y() - v0.y()) - (v1.y() - v0.y()) * (v2.x() - v0.x());
+
+  if (std::abs(area) < 1e-8f) {
+    return;
+  }
+
+  const auto width = static_cast<std::float_t>(_width);
+  const auto height = static_cast<std::float_t>(_height);
+
+  const auto min_x = std::max(std::min({v0.x(), v1.x(), v2.x()}), 0.0f);
+  const auto min_y = std::max(std::min({v0.y(), v1.y(), v2.y()}), 0.0f);
+  const auto max_x = std::min(std::max({v0.x(), v1.x(), v2.x()}), width - 1.0f);
+  const auto max_y = std::min(std::max({v0.y(), v1.y(), v2.y()}), height - 1.0f);
+
+  if (min_x > max_x || min_y > max_y) {
+    return;
+  }
+
+  const auto inverse_area = 1.0f / area;
+
+  // Depth after the divide by w is linear in screen space
+  const auto z0 = std::clamp(v0.z(), 0.0f, 1.0f);
+  const auto z1 = std::clamp(v1.z(), 0.0f, 1.0f);
+  const auto z2 = std::clamp(v2.z(), 0.0f, 1.0f);
+
+  for (auto y = static_cast<size_type>(min_y); y <= static_cast<size_type>(max_y); ++y) {
+    const auto py = static_cast<std::float_t>(y) + 0.5f;
+
+    auto* row = _depth.data() + static_cast<std::size_t>(y) * _width;
+
+    for (auto x = static_cast<size_type>(min_x); x <= static_cast<size_type>(max_x); ++x) {
+      const auto px = static_cast<std::float_t>(x) + 0.5f;
+
+      // Barycentric weights, all of them share the sign of the area for pixels inside of the triangle
+      const auto w0 = ((v1.x() - px) * (v2.y() - py) - (v1.y() - py) * (v2.x() - px)) * inverse_area;
+      const auto w1 = ((v2.x() - px) * (v0.y() - py) - (v2.y() - py) * (v0.x() - px)) * inverse_area;
+      const auto w2 = 1.0f - w0 - w1;
+
+      if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) {
+        continue;
+      }
+
+      const auto depth = w0 * z0 + w1 * z1 + w2 * z2;
+
+      row[x] = std::min(row[x], depth);
+    }
+  }
+}
+
+} // namespace sbx::math
@@ -0,0 +1,80 @@
+#ifndef LIBSBX_MATH_OCCLUSION_BUFFER_HPP_
+#define LIBSBX_MATH_OCCLUSION_BUFFER_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/vector4.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+#include <libsbx/math/volume.hpp>
+
+namespace sbx::math {
+
+/**
+ * @brief Low resolution depth buffer that occluders are rasterized into on the CPU.
+ *
+ * Depth is the post projection depth in the range [0, 1] with 0 at the near plane. Every pixel keeps the nearest depth of all occluders covering it.
+ * Objects are tested by their screen space rectangle and nearest depth, which is conservative for the object but not for the occluders:
+ * occluders should be closed and lie inside of the geometry they stand for.
+ */
+class occlusion_buffer {
+
+public:
+
+  using size_type = std::uint32_t;
+
+  occlusion_buffer(const size_type width = 256u, const size_type height = 128u);
+
+  auto width() const noexcept -> size_type {
+    return _width;
+  }
+
+  auto height() const noexcept -> size_type {
+    return _height;
+  }
+
+  /**
+   * @brief Resets all pixels to the far plane and sets the view projection matrix used for rasterization and tests.
+   */
+  auto clear(const matrix4x4& view_projection) -> void;
+
+  /**
+   * @brief Rasterizes the twelve triangles of a box in the space of model.
+   */
+  auto rasterize(const volume& occluder, const matrix4x4& model = matrix4x4::identity) -> void;
+
+  /**
+   * @brief Rasterizes an indexed triangle list in world space.
+   *
+   * Triangles that cross the near plane are skipped, which only ever makes the buffer less occluding.
+   */
+  auto rasterize(std::span<const vector3> vertices, std::span<const std::uint32_t> indices) -> void;
+
+  /**
+   * @brief Returns false if the box in world space is completely hidden behind the rasterized occluders.
+   */
+  auto is_visible(const volume& bounds) const -> bool;
+
+  auto depth(const size_type x, const size_type y) const -> std::float_t {
+    return _depth[y * _width + x];
+  }
+
+private:
+
+  auto _to_screen(const vector4& clip) const noexcept -> vector3;
+
+  auto _rasterize_triangle(const vector3& v0, const vector3& v1, const vector3& v2) -> void;
+
+  size_type _width;
+  size_type _height;
+  matrix4x4 _view_projection;
+  std::vector<std::float_t> _depth;
+
+}; // class occlusion_buffer
+
+} // namespace sbx::math
+
+#endif // LIBSBX_MATH_OCCLUSION_BUFFER_HPP_
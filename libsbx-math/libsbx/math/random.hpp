@@ -31,6 +31,9 @@ public:
     return distribution(_generator());
   }
 
+  /**
+   * @brief Seeds the generator of the calling thread. Every thread draws from its own generator.
+   */
   template<integral Seed>
   static auto seed(const Seed seed) -> void {
     _generator().seed(static_cast<generator_type::result_type>(seed));
@@ -39,8 +42,7 @@ public:
 private:
 
   static auto _generator() -> generator_type& {
-    static auto device = std::random_device{};
-    static auto generator = generator_type{device()};
+    thread_local auto generator = generator_type{std::random_device{}()};
 
     return generator;
   }
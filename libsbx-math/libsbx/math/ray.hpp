@@ -0,0 +1,51 @@
+#ifndef LIBSBX_MATH_RAY_HPP_
+#define LIBSBX_MATH_RAY_HPP_
+
+#include <libsbx/math/concepts.hpp>
+#include <libsbx/math/vector3.hpp>
+
+namespace sbx::math {
+
+template<scalar Type>
+class basic_ray {
+
+public:
+
+  using value_type = Type;
+  using vector_type = basic_vector3<value_type>;
+
+  basic_ray() noexcept = default;
+
+  /**
+   * @brief Creates a ray. The direction is normalized, so distances along the ray are in world units.
+   */
+  basic_ray(const vector_type& origin, const vector_type& direction) noexcept
+  : _origin{origin},
+    _direction{vector_type::normalized(direction)} { }
+
+  auto origin() const noexcept -> const vector_type& {
+    return _origin;
+  }
+
+  auto direction() const noexcept -> const vector_type& {
+    return _direction;
+  }
+
+  auto point_at(const value_type distance) const noexcept -> vector_type {
+    return _origin + _direction * distance;
+  }
+
+private:
+
+  vector_type _origin;
+  vector_type _direction;
+
+}; // class basic_ray
+
+using rayf = basic_ray<std::float_t>;
+
+using ray = rayf;
+
+} // namespace sbx::math
+
+#endif // LIBSBX_MATH_RAY_HPP_
@@ -0,0 +1,99 @@
+#ifndef LIBSBX_MATH_CLUSTER_CULLER_TESTS_HPP_
+#define LIBSBX_MATH_CLUSTER_CULLER_TESTS_HPP_
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/math/cluster_culler.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+
+#include <tests/frustum_culler_tests.hpp>
+
+TEST(libsbx_math_cluster_culler, culls_clusters_outside_of_the_frustum) {
+  const auto culler = sbx::math::cluster_culler{sbx::math::tests::make_cube_frustum(10.0f), sbx::math::vector3::zero};
+
+  const auto clusters = std::vector<sbx::math::cluster_bounds>{
+    // Inside
+    sbx::math::cluster_bounds{sbx::math::vector3{0.0f, 0.0f, 5.0f}, 1.0f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, 1.0f},
+    // Outside on +x
+    sbx::math::cluster_bounds{sbx::math::vector3{15.0f, 0.0f, 0.0f}, 1.0f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, 1.0f},
+    // Center outside but the sphere reaches into the frustum
+    sbx::math::cluster_bounds{sbx::math::vector3{0.0f, -11.0f, 0.0f}, 2.0f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, 1.0f}
+  };
+
+  auto visible = std::vector<std::uint32_t>{};
+  culler.cull(clusters, sbx::math::matrix4x4::identity, visible);
+
+  EXPECT_EQ(visible, (std::vector<std::uint32_t>{0u, 2u}));
+}
+
+TEST(libsbx_math_cluster_culler, culls_backfacing_clusters) {
+  const auto culler = sbx::math::cluster_culler{sbx::math::tests::make_cube_frustum(100.0f), sbx::math::vector3::zero};
+
+  // All triangles face +z within roughly 25 degrees
+  const auto cutoff = std::cos(sbx::math::to_radians(sbx::math::degree{25.0f}).value());
+
+  // In front of the camera on +z, facing away from it
+  const auto away = sbx::math::cluster_bounds{sbx::math::vector3{0.0f, 0.0f, 20.0f}, 1.0f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, cutoff};
+  // Same cluster facing the camera
+  const auto towards = sbx::math::cluster_bounds{sbx::math::vector3{0.0f, 0.0f, 20.0f}, 1.0f, sbx::math::vector3{0.0f, 0.0f, -1.0f}, cutoff};
+  // Seen from the side, some triangles may face the camera
+  const auto side = sbx::math::cluster_bounds{sbx::math::vector3{20.0f, 0.0f, 0.0f}, 1.0f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, cutoff};
+  // Degenerate cone, never culled by its normals
+  const auto degenerate = sbx::math::cluster_bounds{sbx::math::vector3{0.0f, 0.0f, 20.0f}, 1.0f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, 1.0f};
+
+  EXPECT_FALSE(culler.is_visible(away, sbx::math::matrix4x4::identity));
+  EXPECT_TRUE(culler.is_visible(towards, sbx::math::matrix4x4::identity));
+  EXPECT_TRUE(culler.is_visible(side, sbx::math::matrix4x4::identity));
+  EXPECT_TRUE(culler.is_visible(degenerate, sbx::math::matrix4x4::identity));
+}
+
+TEST(libsbx_math_cluster_culler, transforms_bounds_with_the_model) {
+  const auto culler = sbx::math::cluster_culler{sbx::math::tests::make_cube_frustum(100.0f), sbx::math::vector3::zero};
+
+  const auto cutoff = std::cos(sbx::math::to_radians(sbx::math::degree{25.0f}).value());
+
+  // Faces +z in mesh space and would be backfacing without the model
+  const auto cluster = sbx::math::cluster_bounds{sbx::math::vector3{0.0f, 0.0f, 20.0f}, 1.0f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, cutoff};
+
+  EXPECT_FALSE(culler.is_visible(cluster, sbx::math::matrix4x4::identity));
+
+  // Moved behind the camera the cluster still faces +z, now towards the camera
+  const auto behind = sbx::math::matrix4x4::translated(sbx::math::matrix4x4::identity, sbx::math::vector3{0.0f, 0.0f, -40.0f});
+
+  EXPECT_TRUE(culler.is_visible(cluster, behind));
+
+  // Rotating the mesh around the camera keeps the cluster facing away
+  const auto rotated = sbx::math::matrix4x4::rotated(sbx::math::matrix4x4::identity, sbx::math::vector3::up, sbx::math::degree{90.0f});
+
+  EXPECT_FALSE(culler.is_visible(cluster, rotated));
+
+  // Moved out of the frustum
+  const auto translated = sbx::math::matrix4x4::translated(sbx::math::matrix4x4::identity, sbx::math::vector3{200.0f, 0.0f, 0.0f});
+
+  EXPECT_FALSE(culler.is_visible(cluster, translated));
+
+  // Non uniform scale keeps the cluster but skips the cone test
+  const auto scaled = sbx::math::matrix4x4::scaled(sbx::math::matrix4x4::identity, sbx::math::vector3{1.0f, 2.0f, 1.0f});
+
+  EXPECT_TRUE(culler.is_visible(cluster, scaled));
+}
+
+TEST(libsbx_math_cluster_culler, matches_brute_force_normals) {
+  const auto culler = sbx::math::cluster_culler{sbx::math::tests::make_cube_frustum(1000.0f), sbx::math::vector3::zero};
+
+  // A cluster with a single normal and a zero radius is backfacing exactly when the normal points away from the camera
+  for (auto i = 0u; i < 36u; ++i) {
+    const auto angle = sbx::math::to_radians(sbx::math::degree{static_cast<std::float_t>(i) * 10.0f + 5.0f}).value();
+    const auto normal = sbx::math::vector3{std::cos(angle), 0.0f, std::sin(angle)};
+
+    const auto cluster = sbx::math::cluster_bounds{sbx::math::vector3{0.0f, 0.0f, 20.0f}, 0.0f, normal, 0.0f};
+
+    const auto is_facing = sbx::math::vector3::dot(normal, sbx::math::vector3{0.0f, 0.0f, -1.0f}) > 0.0f;
+
+    EXPECT_EQ(culler.is_visible(cluster, sbx::math::matrix4x4::identity), is_facing) << "angle " << i;
+  }
+}
+
+#endif // LIBSBX_MATH_CLUSTER_CULLER_TESTS_HPP_
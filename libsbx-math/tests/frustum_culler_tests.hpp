@@ -0,0 +1,111 @@
+#ifndef LIBSBX_MATH_FRUSTUM_CULLER_TESTS_HPP_
+#define LIBSBX_MATH_FRUSTUM_CULLER_TESTS_HPP_
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/math/frustum_culler.hpp>
+#include <libsbx/math/occlusion_buffer.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+#include <libsbx/math/angle.hpp>
+
+namespace sbx::math::tests {
+
+// Axis aligned box from -extent to extent on every axis, normals pointing inwards
+inline auto make_cube_frustum(const std::float_t extent) -> math::box {
+  return math::box{std::array<math::plane, 6u>{
+    math::plane{math::vector3{1.0f, 0.0f, 0.0f}, extent},
+    math::plane{math::vector3{-1.0f, 0.0f, 0.0f}, extent},
+    math::plane{math::vector3{0.0f, 1.0f, 0.0f}, extent},
+    math::plane{math::vector3{0.0f, -1.0f, 0.0f}, extent},
+    math::plane{math::vector3{0.0f, 0.0f, 1.0f}, extent},
+    math::plane{math::vector3{0.0f, 0.0f, -1.0f}, extent}
+  }};
+}
+
+} // namespace sbx::math::tests
+
+TEST(libsbx_math_frustum_culler, matches_scalar_box_test) {
+  const auto frustum = sbx::math::tests::make_cube_frustum(10.0f);
+  const auto culler = sbx::math::frustum_culler{frustum};
+
+  auto generator = std::mt19937{42u};
+  auto position = std::uniform_real_distribution<std::float_t>{-20.0f, 20.0f};
+  auto size = std::uniform_real_distribution<std::float_t>{0.1f, 4.0f};
+
+  auto volumes = std::vector<sbx::math::volume>{};
+  auto bounds = sbx::math::bounds_set{};
+
+  // Not a multiple of the lane count, so the last batch is partially filled
+  for (auto i = 0u; i < 1003u; ++i) {
+    const auto min = sbx::math::vector3{position(generator), position(generator), position(generator)};
+    const auto max = min + sbx::math::vector3{size(generator), size(generator), size(generator)};
+
+    volumes.emplace_back(min, max);
+
+    // A sphere that contains everything, so only the box decides
+    bounds.push_back(volumes.back(), sbx::math::sphere{sbx::math::vector3::zero, 1000.0f});
+  }
+
+  auto visible = std::vector<std::uint32_t>{};
+  culler.cull(bounds, visible);
+
+  auto expected = std::vector<std::uint32_t>{};
+
+  for (auto i = 0u; i < volumes.size(); ++i) {
+    if (frustum.intersects(volumes[i])) {
+      expected.push_back(i);
+    }
+  }
+
+  EXPECT_FALSE(expected.empty());
+  EXPECT_LT(expected.size(), volumes.size());
+  EXPECT_EQ(visible, expected);
+}
+
+TEST(libsbx_math_frustum_culler, culls_by_sphere_and_transformed_bounds) {
+  const auto culler = sbx::math::frustum_culler{sbx::math::tests::make_cube_frustum(10.0f), 0.0f};
+
+  const auto local = sbx::math::volume{sbx::math::vector3{-1.0f}, sbx::math::vector3{1.0f}};
+
+  auto bounds = sbx::math::bounds_set{};
+
+  // Inside
+  bounds.push_back(local, sbx::math::matrix4x4::translated(sbx::math::matrix4x4::identity, sbx::math::vector3{0.0f, 0.0f, 5.0f}));
+  // Outside on +x
+  bounds.push_back(local, sbx::math::matrix4x4::translated(sbx::math::matrix4x4::identity, sbx::math::vector3{15.0f, 0.0f, 0.0f}));
+  // Box overlaps the frustum but the sphere does not
+  bounds.push_back(sbx::math::volume{sbx::math::vector3{9.0f}, sbx::math::vector3{12.0f}}, sbx::math::sphere{sbx::math::vector3{20.0f}, 1.0f});
+
+  auto visible = std::vector<std::uint32_t>{};
+  culler.cull(bounds, visible);
+
+  EXPECT_EQ(visible, (std::vector<std::uint32_t>{0u}));
+}
+
+TEST(libsbx_math_occlusion_buffer, hides_boxes_behind_occluders) {
+  const auto projection = sbx::math::matrix4x4::perspective(sbx::math::degree{90.0f}, 2.0f, 0.1f, 100.0f);
+
+  // Camera at the origin looking down -z
+  auto buffer = sbx::math::occlusion_buffer{128u, 64u};
+  buffer.clear(projection);
+
+  const auto behind = sbx::math::volume{sbx::math::vector3{-1.0f, -1.0f, -12.0f}, sbx::math::vector3{1.0f, 1.0f, -10.0f}};
+  const auto beside = sbx::math::volume{sbx::math::vector3{6.0f, -1.0f, -12.0f}, sbx::math::vector3{8.0f, 1.0f, -10.0f}};
+  const auto in_front = sbx::math::volume{sbx::math::vector3{-1.0f, -1.0f, -3.0f}, sbx::math::vector3{1.0f, 1.0f, -2.0f}};
+
+  EXPECT_TRUE(buffer.is_visible(behind));
+
+  buffer.rasterize(sbx::math::volume{sbx::math::vector3{-3.0f, -3.0f, -6.0f}, sbx::math::vector3{3.0f, 3.0f, -5.0f}});
+
+  EXPECT_FALSE(buffer.is_visible(behind));
+  EXPECT_TRUE(buffer.is_visible(beside));
+  EXPECT_TRUE(buffer.is_visible(in_front));
+
+  // Boxes that reach behind the camera are never culled
+  EXPECT_TRUE(buffer.is_visible(sbx::math::volume{sbx::math::vector3{-1.0f, -1.0f, -20.0f}, sbx::math::vector3{1.0f, 1.0f, 1.0f}}));
+}
+
+#endif // LIBSBX_MATH_FRUSTUM_CULLER_TESTS_HPP_
@@ -10,6 +10,10 @@
 
 #include <tests/angle_tests.hpp>
 
+#include <tests/frustum_culler_tests.hpp>
+
+#include <tests/cluster_culler_tests.hpp>
+
 auto main(int argc, char* argv[]) -> int {
   testing::InitGoogleTest(&argc, argv);
 
@@ -0,0 +1,208 @@
+#ifndef LIBSBX_MEMORY_ALLOCATOR_HPP_
+#define LIBSBX_MEMORY_ALLOCATOR_HPP_
+
+#include <cstddef>
+#include <new>
+#include <array>
+#include <utility>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <libsbx/memory/monotonic_arena.hpp>
+#include <libsbx/memory/frame_arena.hpp>
+#include <libsbx/memory/fixed_pool.hpp>
+#include <libsbx/memory/thread_local_pool.hpp>
+
+namespace sbx::memory {
+
+template<typename Type>
+concept memory_resource = requires(Type& resource, void* pointer, std::size_t bytes, std::size_t alignment) {
+  { resource.allocate(bytes, alignment) } -> std::same_as<void*>;
+  { resource.deallocate(pointer, bytes, alignment) } -> std::same_as<void>;
+}; // concept memory_resource
+
+/**
+ * @brief Standard conforming allocator that draws its memory from a memory resource.
+ *
+ * The allocator only stores a pointer to the resource, which must outlive all containers using it. Allocators compare equal if they share the same resource.
+ * A default constructed allocator has no resource and uses the global allocator, so containers that default construct their allocator still work.
+ *
+ * @tparam Type The value type of the allocator.
+ * @tparam Resource The memory resource, e.g. monotonic_arena, frame_arena or fixed_pool.
+ */
+template<typename Type, memory_resource Resource>
+class resource_allocator {
+
+  template<typename Other, memory_resource OtherResource>
+  friend class resource_allocator;
+
+public:
+
+  using value_type = Type;
+  using resource_type = Resource;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::false_type;
+
+  template<typename Other>
+  struct rebind {
+    using other = resource_allocator<Other, Resource>;
+  }; // struct rebind
+
+  resource_allocator() noexcept
+  : _resource{nullptr} { }
+
+  resource_allocator(resource_type& resource) noexcept
+  : _resource{&resource} { }
+
+  template<typename Other>
+  resource_allocator(const resource_allocator<Other, Resource>& other) noexcept
+  : _resource{other._resource} { }
+
+  [[nodiscard]] auto allocate(const size_type count) -> value_type* {
+    if (count > std::numeric_limits<size_type>::max() / sizeof(value_type)) {
+      throw std::bad_array_new_length{};
+    }
+
+    if (_resource == nullptr) {
+      return std::allocator<value_type>{}.allocate(count);
+    }
+
+    return static_cast<value_type*>(_resource->allocate(count * sizeof(value_type), alignof(value_type)));
+  }
+
+  auto deallocate(value_type* pointer, const size_type count) noexcept -> void {
+    if (_resource == nullptr) {
+      std::allocator<value_type>{}.deallocate(pointer, count);
+      return;
+    }
+
+    _resource->deallocate(pointer, count * sizeof(value_type), alignof(value_type));
+  }
+
+  /**
+   * @brief The resource of the allocator or nullptr if it was default constructed.
+   */
+  [[nodiscard]] auto resource() const noexcept -> resource_type* {
+    return _resource;
+  }
+
+  template<typename Other>
+  auto operator==(const resource_allocator<Other, Resource>& other) const noexcept -> bool {
+    return _resource == other._resource;
+  }
+
+private:
+
+  resource_type* _resource;
+
+}; // class resource_allocator
+
+/**
+ * @brief Allocator for data that is discarded all at once, e.g. temporary containers of a system update.
+ */
+template<typename Type>
+using arena_allocator = resource_allocator<Type, monotonic_arena>;
+
+/**
+ * @brief Allocator for data that lives for at most Frames frames, e.g. draw lists that are rebuilt every frame.
+ */
+template<typename Type, std::size_t Frames = 2u>
+using frame_allocator = resource_allocator<Type, frame_arena<Frames>>;
+
+/**
+ * @brief Allocator backed by a fixed_pool, intended for node based containers.
+ */
+template<typename Type>
+using fixed_pool_allocator = resource_allocator<Type, fixed_pool>;
+
+namespace detail {
+
+inline constexpr auto pool_granularity = alignof(std::max_align_t);
+inline constexpr auto max_pooled_bytes = std::size_t{512u};
+
+struct pool_size_class {
+  void* (*allocate)();
+  void (*deallocate)(void*) noexcept;
+}; // struct pool_size_class
+
+template<std::size_t... Indices>
+constexpr auto make_pool_size_classes(std::index_sequence<Indices...>) -> std::array<pool_size_class, sizeof...(Indices)> {
+  return {pool_size_class{&thread_local_pool<(Indices + 1u) * pool_granularity>::allocate, &thread_local_pool<(Indices + 1u) * pool_granularity>::deallocate}...};
+}
+
+/**
+ * @brief One thread_local_pool per multiple of pool_granularity up to max_pooled_bytes. Allocators of all types share the pools of equal block size.
+ */
+inline constexpr auto pool_size_classes = make_pool_size_classes(std::make_index_sequence<max_pooled_bytes / pool_granularity>{});
+
+constexpr auto pool_size_class_index(const std::size_t bytes) noexcept -> std::size_t {
+  return (bytes + pool_granularity - 1u) / pool_granularity - 1u;
+}
+
+} // namespace detail
+
+/**
+ * @brief Stateless allocator that serves requests of up to 512 bytes from the thread_local_pool of the matching size class and everything else from the global allocator.
+ *
+ * Single objects as well as small arrays are pooled, e.g. the nodes and small bucket arrays of std::unordered_map or the storage of short vectors. Requests are rounded up to a multiple of alignof(std::max_align_t).
+ * Being stateless it is default constructible and can be used as a drop-in replacement for std::allocator, e.g. for std::list or for ecs::basic_registry.
+ */
+template<typename Type>
+class pool_allocator {
+
+  inline static constexpr auto is_poolable_v = alignof(Type) <= detail::pool_granularity;
+
+public:
+
+  using value_type = Type;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using is_always_equal = std::true_type;
+
+  constexpr pool_allocator() noexcept = default;
+
+  template<typename Other>
+  constexpr pool_allocator(const pool_allocator<Other>&) noexcept { }
+
+  [[nodiscard]] auto allocate(const size_type count) -> value_type* {
+    if constexpr (is_poolable_v) {
+      if (_is_pooled(count)) {
+        return static_cast<value_type*>(detail::pool_size_classes[detail::pool_size_class_index(count * sizeof(value_type))].allocate());
+      }
+    }
+
+    return std::allocator<value_type>{}.allocate(count);
+  }
+
+  auto deallocate(value_type* pointer, const size_type count) noexcept -> void {
+    if constexpr (is_poolable_v) {
+      if (_is_pooled(count)) {
+        detail::pool_size_classes[detail::pool_size_class_index(count * sizeof(value_type))].deallocate(pointer);
+        return;
+      }
+    }
+
+    std::allocator<value_type>{}.deallocate(pointer, count);
+  }
+
+  template<typename Other>
+  constexpr auto operator==(const pool_allocator<Other>&) const noexcept -> bool {
+    return true;
+  }
+
+private:
+
+  static constexpr auto _is_pooled(const size_type count) noexcept -> bool {
+    return count != 0u && count <= detail::max_pooled_bytes / sizeof(value_type);
+  }
+
+}; // class pool_allocator
+
+} // namespace sbx::memory
+
+#endif // LIBSBX_MEMORY_ALLOCATOR_HPP_
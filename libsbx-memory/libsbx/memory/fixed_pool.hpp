@@ -0,0 +1,142 @@
+#ifndef LIBSBX_MEMORY_FIXED_POOL_HPP_
+#define LIBSBX_MEMORY_FIXED_POOL_HPP_
+
+#include <cstddef>
+#include <new>
+#include <vector>
+#include <algorithm>
+#include <bit>
+
+#include <libsbx/utility/assert.hpp>
+
+#include <libsbx/memory/statistics.hpp>
+
+namespace sbx::memory {
+
+/**
+ * @brief Pool of equally sized blocks with an intrusive free list.
+ *
+ * Requests that do not fit into a block are forwarded to the global allocator, so the pool can back node based containers whose allocators are rebound to other types.
+ * Not thread-safe, see thread_local_pool for a pool that is shared between threads.
+ */
+class fixed_pool {
+
+  struct free_block {
+    free_block* next;
+  }; // struct free_block
+
+  struct chunk {
+    std::byte* data;
+    std::size_t size;
+  }; // struct chunk
+
+public:
+
+  inline static constexpr auto default_blocks_per_chunk = std::size_t{256u};
+
+  fixed_pool(const std::size_t block_size, const std::size_t block_alignment = alignof(std::max_align_t), const std::size_t blocks_per_chunk = default_blocks_per_chunk)
+  : _block_alignment{std::max(block_alignment, alignof(free_block))},
+    _block_size{_round_up(std::max(block_size, sizeof(free_block)), _block_alignment)},
+    _blocks_per_chunk{std::max(blocks_per_chunk, std::size_t{1u})},
+    _free{nullptr} {
+    utility::assert_that(std::has_single_bit(_block_alignment), "Alignment must be a power of two");
+  }
+
+  fixed_pool(const fixed_pool& other) = delete;
+
+  fixed_pool(fixed_pool&& other) = delete;
+
+  ~fixed_pool() {
+    for (const auto& entry : _chunks) {
+      ::operator delete(entry.data, entry.size, std::align_val_t{_block_alignment});
+    }
+  }
+
+  auto operator=(const fixed_pool& other) -> fixed_pool& = delete;
+
+  auto operator=(fixed_pool&& other) -> fixed_pool& = delete;
+
+  [[nodiscard]] auto block_size() const noexcept -> std::size_t {
+    return _block_size;
+  }
+
+  [[nodiscard]] auto allocate(const std::size_t bytes, const std::size_t alignment = alignof(std::max_align_t)) -> void* {
+    if (!_fits(bytes, alignment)) {
+      _statistics.on_allocate(bytes);
+      return ::operator new(bytes, std::align_val_t{alignment});
+    }
+
+    if (_free == nullptr) {
+      _grow();
+    }
+
+    auto* block = _free;
+    _free = block->next;
+
+    _statistics.on_allocate(_block_size);
+
+    return block;
+  }
+
+  auto deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment = alignof(std::max_align_t)) noexcept -> void {
+    if (!_fits(bytes, alignment)) {
+      _statistics.on_deallocate(bytes);
+      ::operator delete(pointer, bytes, std::align_val_t{alignment});
+      return;
+    }
+
+    auto* block = ::new (pointer) free_block{_free};
+    _free = block;
+
+    _statistics.on_deallocate(_block_size);
+  }
+
+  [[nodiscard]] auto statistics() const noexcept -> allocation_statistics {
+    return _statistics.snapshot();
+  }
+
+  auto reset_peak() noexcept -> void {
+    _statistics.reset_peak();
+  }
+
+  auto is_equal(const fixed_pool& other) const noexcept -> bool {
+    return this == &other;
+  }
+
+private:
+
+  static constexpr auto _round_up(const std::size_t value, const std::size_t alignment) noexcept -> std::size_t {
+    return (value + alignment - 1u) & ~(alignment - 1u);
+  }
+
+  [[nodiscard]] auto _fits(const std::size_t bytes, const std::size_t alignment) const noexcept -> bool {
+    return bytes <= _block_size && alignment <= _block_alignment;
+  }
+
+  auto _grow() -> void {
+    const auto size = _block_size * _blocks_per_chunk;
+
+    auto* data = static_cast<std::byte*>(::operator new(size, std::align_val_t{_block_alignment}));
+
+    _chunks.push_back(chunk{data, size});
+
+    // Link the blocks back to front so they are handed out in address order
+    for (auto i = _blocks_per_chunk; i > 0u; --i) {
+      _free = ::new (data + (i - 1u) * _block_size) free_block{_free};
+    }
+
+    _statistics.on_reserve(size);
+  }
+
+  std::size_t _block_alignment;
+  std::size_t _block_size;
+  std::size_t _blocks_per_chunk;
+  free_block* _free;
+  std::vector<chunk> _chunks;
+  statistics_counter _statistics;
+
+}; // class fixed_pool
+
+} // namespace sbx::memory
+
+#endif // LIBSBX_MEMORY_FIXED_POOL_HPP_
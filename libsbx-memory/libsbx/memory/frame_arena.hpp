@@ -0,0 +1,104 @@
+#ifndef LIBSBX_MEMORY_FRAME_ARENA_HPP_
+#define LIBSBX_MEMORY_FRAME_ARENA_HPP_
+
+#include <cstddef>
+#include <array>
+#include <utility>
+
+#include <libsbx/memory/statistics.hpp>
+#include <libsbx/memory/monotonic_arena.hpp>
+
+namespace sbx::memory {
+
+/**
+ * @brief Linear allocator for data that lives for at most Frames frames.
+ *
+ * Every frame allocates from its own monotonic arena. begin_frame() moves on to the next arena and resets it, so memory allocated in a frame stays valid until Frames - 1 further frames have begun.
+ * Use two frames for double buffering and three for triple buffering. Not thread-safe.
+ *
+ * @tparam Frames Number of frames an allocation stays valid for.
+ */
+template<std::size_t Frames = 2u>
+requires (Frames > 0u)
+class frame_arena {
+
+public:
+
+  inline static constexpr auto frame_count = Frames;
+
+  explicit frame_arena(const std::size_t initial_capacity = monotonic_arena::default_capacity)
+  : _arenas{_make_arenas(initial_capacity, std::make_index_sequence<Frames>{})},
+    _index{0u} { }
+
+  frame_arena(const frame_arena& other) = delete;
+
+  frame_arena(frame_arena&& other) = delete;
+
+  ~frame_arena() = default;
+
+  auto operator=(const frame_arena& other) -> frame_arena& = delete;
+
+  auto operator=(frame_arena&& other) -> frame_arena& = delete;
+
+  /**
+   * @brief Advances to the next frame. Invalidates all allocations made Frames frames ago.
+   */
+  auto begin_frame() -> void {
+    _index = (_index + 1u) % Frames;
+    _arenas[_index].reset();
+  }
+
+  [[nodiscard]] auto allocate(const std::size_t bytes, const std::size_t alignment = alignof(std::max_align_t)) -> void* {
+    return _arenas[_index].allocate(bytes, alignment);
+  }
+
+  auto deallocate(void* pointer, const std::size_t bytes, const std::size_t alignment = alignof(std::max_align_t)) noexcept -> void {
+    _arenas[_index].deallocate(pointer, bytes, alignment);
+  }
+
+  [[nodiscard]] auto current_frame() const noexcept -> std::size_t {
+    return _index;
+  }
+
+  [[nodiscard]] auto arena(const std::size_t frame) noexcept -> monotonic_arena& {
+    return _arenas[frame];
+  }
+
+  /**
+   * @brief Combined statistics of all frames. The peak is the sum of the peaks of the individual frames.
+   */
+  [[nodiscard]] auto statistics() const noexcept -> allocation_statistics {
+    auto result = allocation_statistics{};
+
+    for (const auto& entry : _arenas) {
+      const auto statistics = entry.statistics();
+
+      result.allocated_bytes += statistics.allocated_bytes;
+      result.peak_bytes += statistics.peak_bytes;
+      result.reserved_bytes += statistics.reserved_bytes;
+      result.allocations += statistics.allocations;
+      result.deallocations += statistics.deallocations;
+    }
+
+    return result;
+  }
+
+  auto is_equal(const frame_arena& other) const noexcept -> bool {
+    return this == &other;
+  }
+
+private:
+
+  template<std::size_t... Indices>
+  static auto _make_arenas(const std::size_t initial_capacity, std::index_sequence<Indices...>) -> std::array<monotonic_arena, Frames> {
+    return std::array<monotonic_arena, Frames>{((void)Indices, monotonic_arena{initial_capacity})...};
+  }
+
+  std::array<monotonic_arena, Frames> _arenas;
+  std::size_t _index;
+
+}; // class frame_arena
+
+} // namespace sbx::memory
+
+#endif // LIBSBX_MEMORY_FRAME_ARENA_HPP_
@@ -9,5 +9,11 @@
 #include <libsbx/memory/cache.hpp>
 #include <libsbx/memory/iterable_adaptor.hpp>
 #include <libsbx/memory/blob.hpp>
+#include <libsbx/memory/statistics.hpp>
+#include <libsbx/memory/monotonic_arena.hpp>
+#include <libsbx/memory/frame_arena.hpp>
+#include <libsbx/memory/fixed_pool.hpp>
+#include <libsbx/memory/thread_local_pool.hpp>
+#include <libsbx/memory/allocator.hpp>
 
 #endif // LIBSBX_MEMORY_HPP_
@@ -0,0 +1,190 @@
+#ifndef LIBSBX_MEMORY_MONOTONIC_ARENA_HPP_
+#define LIBSBX_MEMORY_MONOTONIC_ARENA_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <memory>
+#include <algorithm>
+#include <bit>
+
+#include <libsbx/utility/assert.hpp>
+
+#include <libsbx/memory/statistics.hpp>
+
+namespace sbx::memory {
+
+/**
+ * @brief Bump allocator that hands out memory from a list of growing chunks.
+ *
+ * Deallocation is a no-op unless the block is the most recent allocation, memory is reclaimed all at once by reset().
+ * After a reset the arena consolidates its chunks into one, so a workload that repeats every frame stops touching the upstream allocator after the first frame.
+ * Not thread-safe.
+ */
+class monotonic_arena {
+
+  struct chunk {
+    std::byte* data;
+    std::size_t size;
+  }; // struct chunk
+
+  inline static constexpr auto chunk_alignment = alignof(std::max_align_t);
+
+public:
+
+  inline static constexpr auto default_capacity = std::size_t{64u * 1024u};
+
+  explicit monotonic_arena(const std::size_t initial_capacity = default_capacity)
+  : _next_capacity{std::max(initial_capacity, std::size_t{256u})},
+    _current{0u},
+    _offset{0u},
+    _used{0u} { }
+
+  monotonic_arena(const monotonic_arena& other) = delete;
+
+  monotonic_arena(monotonic_arena&& other) = delete;
+
+  ~monotonic_arena() {
+    _release();
+  }
+
+  auto operator=(const monotonic_arena& other) -> monotonic_arena& = delete;
+
+  auto operator=(monotonic_arena&& other) -> monotonic_arena& = delete;
+
+  [[nodiscard]] auto allocate(const std::size_t bytes, const std::size_t alignment = alignof(std::max_align_t)) -> void* {
+    utility::assert_that(std::has_single_bit(alignment), "Alignment must be a power of two");
+
+    while (true) {
+      if (_current < _chunks.size()) {
+        auto& current = _chunks[_current];
+
+        const auto address = reinterpret_cast<std::uintptr_t>(current.data) + _offset;
+        const auto padding = (alignment - (address % alignment)) % alignment;
+
+        if (_offset + padding + bytes <= current.size) {
+          auto* result = current.data + _offset + padding;
+
+          _offset += padding + bytes;
+          _used += padding + bytes;
+
+          _statistics.on_allocate(padding + bytes);
+
+          return result;
+        }
+
+        // Reuse chunks that are left over from before the last reset
+        if (_current + 1u < _chunks.size()) {
+          ++_current;
+          _offset = 0u;
+          continue;
+        }
+      }
+
+      _grow(bytes + alignment);
+    }
+  }
+
+  /**
+   * @brief Only reclaims the block if it was the most recent allocation.
+   */
+  auto deallocate(void* pointer, const std::size_t bytes, [[maybe_unused]] const std::size_t alignment = alignof(std::max_align_t)) noexcept -> void {
+    if (_current >= _chunks.size()) {
+      return;
+    }
+
+    auto* block = static_cast<std::byte*>(pointer);
+    auto& current = _chunks[_current];
+
+    if (block + bytes == current.data + _offset && block >= current.data) {
+      const auto size = static_cast<std::size_t>((current.data + _offset) - block);
+
+      _offset -= size;
+      _used -= size;
+
+      _statistics.on_deallocate(size);
+    }
+  }
+
+  /**
+   * @brief Makes all memory available again. All pointers handed out by the arena become invalid.
+   */
+  auto reset() -> void {
+    if (_chunks.size() > 1u) {
+      // Replace the chunks by a single one that fits everything that was used since the last reset
+      const auto capacity = capacity_bytes();
+
+      _release();
+      _next_capacity = std::max(_next_capacity, capacity);
+    }
+
+    _statistics.on_deallocate(_used);
+
+    _current = 0u;
+    _offset = 0u;
+    _used = 0u;
+  }
+
+  [[nodiscard]] auto used_bytes() const noexcept -> std::size_t {
+    return _used;
+  }
+
+  [[nodiscard]] auto capacity_bytes() const noexcept -> std::size_t {
+    auto capacity = std::size_t{0u};
+
+    for (const auto& entry : _chunks) {
+      capacity += entry.size;
+    }
+
+    return capacity;
+  }
+
+  [[nodiscard]] auto statistics() const noexcept -> allocation_statistics {
+    return _statistics.snapshot();
+  }
+
+  auto reset_peak() noexcept -> void {
+    _statistics.reset_peak();
+  }
+
+  auto is_equal(const monotonic_arena& other) const noexcept -> bool {
+    return this == &other;
+  }
+
+private:
+
+  auto _grow(const std::size_t minimum) -> void {
+    const auto size = std::max(_next_capacity, minimum);
+
+    auto* data = static_cast<std::byte*>(::operator new(size, std::align_val_t{chunk_alignment}));
+
+    _chunks.push_back(chunk{data, size});
+    _current = _chunks.size() - 1u;
+    _offset = 0u;
+    _next_capacity = size * 2u;
+
+    _statistics.on_reserve(size);
+  }
+
+  auto _release() noexcept -> void {
+    for (const auto& entry : _chunks) {
+      ::operator delete(entry.data, entry.size, std::align_val_t{chunk_alignment});
+      _statistics.on_release(entry.size);
+    }
+
+    _chunks.clear();
+  }
+
+  std::vector<chunk> _chunks;
+  std::size_t _next_capacity;
+  std::size_t _current;
+  std::size_t _offset;
+  std::size_t _used;
+  statistics_counter _statistics;
+
+}; // class monotonic_arena
+
+} // namespace sbx::memory
+
+#endif // LIBSBX_MEMORY_MONOTONIC_ARENA_HPP_
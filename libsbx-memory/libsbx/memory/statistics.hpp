@@ -0,0 +1,96 @@
+#ifndef LIBSBX_MEMORY_STATISTICS_HPP_
+#define LIBSBX_MEMORY_STATISTICS_HPP_
+
+#include <cstddef>
+#include <atomic>
+
+namespace sbx::memory {
+
+/**
+ * @brief Snapshot of the allocations of a memory resource.
+ */
+struct allocation_statistics {
+  //! Bytes currently handed out
+  std::size_t allocated_bytes;
+  //! Highest value of allocated_bytes since creation or the last reset_peak
+  std::size_t peak_bytes;
+  //! Bytes currently reserved from the upstream allocator
+  std::size_t reserved_bytes;
+  std::size_t allocations;
+  std::size_t deallocations;
+}; // struct allocation_statistics
+
+/**
+ * @brief Thread-safe counters that memory resources report their allocations to.
+ */
+class statistics_counter {
+
+public:
+
+  statistics_counter() noexcept
+  : _allocated_bytes{0u},
+    _peak_bytes{0u},
+    _reserved_bytes{0u},
+    _allocations{0u},
+    _deallocations{0u} { }
+
+  statistics_counter(const statistics_counter& other) = delete;
+
+  statistics_counter(statistics_counter&& other) = delete;
+
+  ~statistics_counter() = default;
+
+  auto operator=(const statistics_counter& other) -> statistics_counter& = delete;
+
+  auto operator=(statistics_counter&& other) -> statistics_counter& = delete;
+
+  auto on_allocate(const std::size_t bytes) noexcept -> void {
+    const auto allocated = _allocated_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+
+    _allocations.fetch_add(1u, std::memory_order_relaxed);
+
+    auto peak = _peak_bytes.load(std::memory_order_relaxed);
+
+    while (allocated > peak && !_peak_bytes.compare_exchange_weak(peak, allocated, std::memory_order_relaxed)) { }
+  }
+
+  auto on_deallocate(const std::size_t bytes) noexcept -> void {
+    _allocated_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+    _deallocations.fetch_add(1u, std::memory_order_relaxed);
+  }
+
+  auto on_reserve(const std::size_t bytes) noexcept -> void {
+    _reserved_bytes.fetch_add(bytes, std::memory_order_relaxed);
+  }
+
+  auto on_release(const std::size_t bytes) noexcept -> void {
+    _reserved_bytes.fetch_sub(bytes, std::memory_order_relaxed);
+  }
+
+  auto reset_peak() noexcept -> void {
+    _peak_bytes.store(_allocated_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+
+  [[nodiscard]] auto snapshot() const noexcept -> allocation_statistics {
+    return allocation_statistics{
+      .allocated_bytes = _allocated_bytes.load(std::memory_order_relaxed),
+      .peak_bytes = _peak_bytes.load(std::memory_order_relaxed),
+      .reserved_bytes = _reserved_bytes.load(std::memory_order_relaxed),
+      .allocations = _allocations.load(std::memory_order_relaxed),
+      .deallocations = _deallocations.load(std::memory_order_relaxed)
+    };
+  }
+
+private:
+
+  std::atomic<std::size_t> _allocated_bytes;
+  std::atomic<std::size_t> _peak_bytes;
+  std::atomic<std::size_t> _reserved_bytes;
+  std::atomic<std::size_t> _allocations;
+  std::atomic<std::size_t> _deallocations;
+
+}; // class statistics_counter
+
+} // namespace sbx::memory
+
+#endif // LIBSBX_MEMORY_STATISTICS_HPP_
@@ -0,0 +1,148 @@
+#ifndef LIBSBX_MEMORY_THREAD_LOCAL_POOL_HPP_
+#define LIBSBX_MEMORY_THREAD_LOCAL_POOL_HPP_
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include <libsbx/memory/statistics.hpp>
+
+namespace sbx::memory {
+
+/**
+ * @brief Process wide pool of blocks of BlockSize bytes with a cache per thread.
+ *
+ * Allocating and freeing is a vector pop or push on the cache of the calling thread in the common case. Blocks move between the thread caches and a shared free list in batches.
+ * A block may be freed by a different thread than the one that allocated it. Memory is only returned to the system when the program exits.
+ * Freeing only allocates when it creates the cache of a thread that has never used the pool before.
+ *
+ * The statistics count the blocks that are held by threads, i.e. blocks in use plus blocks in thread caches, and are only updated when batches move.
+ *
+ * @tparam BlockSize Size of a block in bytes. Blocks are aligned to alignof(std::max_align_t).
+ */
+template<std::size_t BlockSize>
+class thread_local_pool {
+
+  inline static constexpr auto blocks_per_chunk = std::size_t{256u};
+  inline static constexpr auto cache_capacity = std::size_t{512u};
+  inline static constexpr auto batch_size = std::size_t{128u};
+
+  struct alignas(std::max_align_t) block {
+    std::byte data[BlockSize];
+  }; // struct block
+
+  struct shared {
+    std::mutex mutex;
+    std::vector<block*> free;
+    std::vector<std::unique_ptr<block[]>> chunks;
+    statistics_counter statistics;
+  }; // struct shared
+
+  struct cache {
+
+    cache() {
+      free.reserve(cache_capacity);
+    }
+
+    ~cache() {
+      auto& central = _shared();
+      auto lock = std::scoped_lock{central.mutex};
+
+      central.free.insert(central.free.end(), free.begin(), free.end());
+      central.statistics.on_deallocate(free.size() * sizeof(block));
+    }
+
+    std::vector<block*> free;
+
+  }; // struct cache
+
+public:
+
+  inline static constexpr auto block_size = sizeof(block);
+  inline static constexpr auto block_alignment = alignof(block);
+
+  [[nodiscard]] static auto allocate() -> void* {
+    auto& local = _cache();
+
+    if (local.free.empty()) {
+      _refill(local);
+    }
+
+    auto* result = local.free.back();
+    local.free.pop_back();
+
+    return result;
+  }
+
+  static auto deallocate(void* pointer) noexcept -> void {
+    auto& local = _cache();
+
+    if (local.free.size() == cache_capacity) {
+      _flush(local);
+    }
+
+    local.free.push_back(static_cast<block*>(pointer));
+  }
+
+  [[nodiscard]] static auto statistics() noexcept -> allocation_statistics {
+    return _shared().statistics.snapshot();
+  }
+
+private:
+
+  static auto _refill(cache& local) -> void {
+    auto& central = _shared();
+    auto lock = std::scoped_lock{central.mutex};
+
+    if (central.free.empty()) {
+      // The shared free list can hold every block there is, so returning blocks to it never allocates
+      central.free.reserve((central.chunks.size() + 1u) * blocks_per_chunk);
+
+      auto& chunk = central.chunks.emplace_back(std::make_unique_for_overwrite<block[]>(blocks_per_chunk));
+
+      for (auto i = 0u; i < blocks_per_chunk; ++i) {
+        central.free.push_back(&chunk[i]);
+      }
+
+      central.statistics.on_reserve(blocks_per_chunk * sizeof(block));
+    }
+
+    const auto count = std::min(batch_size, central.free.size());
+    const auto first = central.free.end() - static_cast<std::ptrdiff_t>(count);
+
+    local.free.insert(local.free.end(), first, central.free.end());
+    central.free.erase(first, central.free.end());
+
+    central.statistics.on_allocate(count * sizeof(block));
+  }
+
+  static auto _flush(cache& local) noexcept -> void {
+    auto& central = _shared();
+    auto lock = std::scoped_lock{central.mutex};
+
+    // Does not allocate, the capacity of the shared free list is reserved whenever a chunk is added in _refill
+    const auto first = local.free.end() - static_cast<std::ptrdiff_t>(batch_size);
+
+    central.free.insert(central.free.end(), first, local.free.end());
+    local.free.erase(first, local.free.end());
+
+    central.statistics.on_deallocate(batch_size * sizeof(block));
+  }
+
+  static auto _shared() -> shared& {
+    static auto instance = shared{};
+    return instance;
+  }
+
+  static auto _cache() -> cache& {
+    thread_local auto instance = cache{};
+    return instance;
+  }
+
+}; // class thread_local_pool
+
+} // namespace sbx::memory
+
+#endif // LIBSBX_MEMORY_THREAD_LOCAL_POOL_HPP_
@@ -0,0 +1,368 @@
+#ifndef LIBSBX_MEMORY_ALLOCATOR_TESTS_HPP_
+#define LIBSBX_MEMORY_ALLOCATOR_TESTS_HPP_
+
+#include <cstdint>
+#include <list>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/memory/allocator.hpp>
+
+#include <libsbx/ecs/entity.hpp>
+#include <libsbx/ecs/storage.hpp>
+#include <libsbx/ecs/registry.hpp>
+
+namespace allocator_tests {
+
+inline auto is_aligned(const void* pointer, const std::size_t alignment) -> bool {
+  return reinterpret_cast<std::uintptr_t>(pointer) % alignment == 0u;
+}
+
+struct position {
+  std::uint32_t x;
+  std::uint32_t y;
+}; // struct position
+
+struct velocity {
+  std::uint32_t value;
+}; // struct velocity
+
+/**
+ * @brief Creates entities with components, destroys every other one and checks what is left through a view.
+ */
+template<typename Registry>
+auto exercise_registry(Registry& registry) -> void {
+  auto entities = std::vector<sbx::ecs::entity>{};
+
+  for (auto i = 0u; i < 1000u; ++i) {
+    const auto entity = registry.create();
+
+    registry.template emplace<position>(entity, i, i * 2u);
+
+    if (i % 2u == 0u) {
+      registry.template emplace<velocity>(entity, i);
+    }
+
+    entities.push_back(entity);
+  }
+
+  for (auto i = 1u; i < entities.size(); i += 2u) {
+    registry.destroy(entities[i]);
+  }
+
+  auto count = 0u;
+
+  for (auto&& [entity, value, delta] : registry.template view<position, velocity>().each()) {
+    EXPECT_EQ(value.x, delta.value);
+    EXPECT_EQ(value.y, delta.value * 2u);
+    ++count;
+  }
+
+  EXPECT_EQ(count, 500u);
+}
+
+} // namespace allocator_tests
+
+TEST(libsbx_memory_monotonic_arena, allocations_are_aligned) {
+  auto arena = sbx::memory::monotonic_arena{256u};
+
+  auto* first = arena.allocate(3u, 1u);
+  auto* second = arena.allocate(8u, 64u);
+  auto* third = arena.allocate(4u, 4u);
+
+  EXPECT_NE(first, second);
+  EXPECT_TRUE(allocator_tests::is_aligned(second, 64u));
+  EXPECT_TRUE(allocator_tests::is_aligned(third, 4u));
+
+  // Allocations that do not fit into the current chunk get a new one
+  auto* large = arena.allocate(1024u);
+
+  EXPECT_NE(large, nullptr);
+  EXPECT_GE(arena.capacity_bytes(), 1024u + 256u);
+}
+
+TEST(libsbx_memory_monotonic_arena, reset_reuses_memory) {
+  auto arena = sbx::memory::monotonic_arena{128u};
+
+  for (auto i = 0u; i < 16u; ++i) {
+    [[maybe_unused]] auto* pointer = arena.allocate(64u);
+  }
+
+  EXPECT_EQ(arena.statistics().allocated_bytes, 16u * 64u);
+
+  arena.reset();
+
+  EXPECT_EQ(arena.used_bytes(), 0u);
+  EXPECT_EQ(arena.statistics().allocated_bytes, 0u);
+  EXPECT_EQ(arena.statistics().peak_bytes, 16u * 64u);
+
+  // The chunks are merged into one that fits everything that was used before the reset
+  for (auto i = 0u; i < 16u; ++i) {
+    [[maybe_unused]] auto* pointer = arena.allocate(64u);
+  }
+
+  const auto reserved = arena.statistics().reserved_bytes;
+
+  EXPECT_GE(reserved, 16u * 64u);
+
+  arena.reset();
+
+  for (auto i = 0u; i < 16u; ++i) {
+    [[maybe_unused]] auto* pointer = arena.allocate(64u);
+  }
+
+  EXPECT_EQ(arena.statistics().reserved_bytes, reserved);
+}
+
+TEST(libsbx_memory_monotonic_arena, deallocate_reclaims_last_allocation) {
+  auto arena = sbx::memory::monotonic_arena{256u};
+
+  auto* first = arena.allocate(16u);
+  auto* second = arena.allocate(16u);
+
+  arena.deallocate(first, 16u);
+
+  EXPECT_EQ(arena.used_bytes(), 32u);
+
+  arena.deallocate(second, 16u);
+
+  EXPECT_EQ(arena.used_bytes(), 16u);
+  EXPECT_EQ(arena.allocate(16u), second);
+}
+
+TEST(libsbx_memory_frame_arena, frames_are_recycled) {
+  auto arena = sbx::memory::frame_arena<2u>{256u};
+
+  auto* first = arena.allocate(32u);
+
+  arena.begin_frame();
+
+  auto* second = arena.allocate(32u);
+
+  EXPECT_NE(first, second);
+  EXPECT_EQ(arena.statistics().allocated_bytes, 64u);
+
+  // Two frames later the memory of the first frame is handed out again
+  arena.begin_frame();
+
+  EXPECT_EQ(arena.statistics().allocated_bytes, 32u);
+  EXPECT_EQ(arena.allocate(32u), first);
+}
+
+TEST(libsbx_memory_fixed_pool, blocks_are_reused) {
+  auto pool = sbx::memory::fixed_pool{24u, 8u, 4u};
+
+  EXPECT_EQ(pool.block_size(), 24u);
+
+  auto blocks = std::vector<void*>{};
+
+  for (auto i = 0u; i < 10u; ++i) {
+    blocks.push_back(pool.allocate(24u, 8u));
+  }
+
+  EXPECT_EQ(pool.statistics().allocated_bytes, 10u * 24u);
+  EXPECT_EQ(pool.statistics().reserved_bytes, 3u * 4u * 24u);
+
+  auto* last = blocks.back();
+
+  pool.deallocate(last, 24u, 8u);
+
+  EXPECT_EQ(pool.allocate(24u, 8u), last);
+
+  for (auto* block : blocks) {
+    pool.deallocate(block, 24u, 8u);
+  }
+
+  EXPECT_EQ(pool.statistics().allocated_bytes, 0u);
+}
+
+TEST(libsbx_memory_fixed_pool, oversized_requests_are_forwarded) {
+  auto pool = sbx::memory::fixed_pool{16u};
+
+  auto* large = pool.allocate(1024u);
+
+  EXPECT_EQ(pool.statistics().reserved_bytes, 0u);
+  EXPECT_EQ(pool.statistics().allocated_bytes, 1024u);
+
+  pool.deallocate(large, 1024u);
+
+  EXPECT_EQ(pool.statistics().allocated_bytes, 0u);
+}
+
+TEST(libsbx_memory_thread_local_pool, blocks_move_between_threads) {
+  // A block size that no other test uses, so the statistics only count this test
+  using pool_type = sbx::memory::thread_local_pool<208u>;
+
+  static constexpr auto count = 2000u;
+
+  auto blocks = std::vector<void*>{};
+
+  for (auto i = 0u; i < count; ++i) {
+    blocks.push_back(pool_type::allocate());
+    EXPECT_TRUE(allocator_tests::is_aligned(blocks.back(), pool_type::block_alignment));
+  }
+
+  const auto reserved = pool_type::statistics().reserved_bytes;
+
+  EXPECT_GE(reserved, count * pool_type::block_size);
+
+  // Blocks freed by another thread flow back through the shared free list
+  auto thread = std::thread{[&](){
+    for (auto* block : blocks) {
+      pool_type::deallocate(block);
+    }
+  }};
+
+  thread.join();
+
+  blocks.clear();
+
+  for (auto i = 0u; i < count; ++i) {
+    blocks.push_back(pool_type::allocate());
+  }
+
+  EXPECT_EQ(pool_type::statistics().reserved_bytes, reserved);
+
+  for (auto* block : blocks) {
+    pool_type::deallocate(block);
+  }
+}
+
+TEST(libsbx_memory_resource_allocator, uses_resource) {
+  auto arena = sbx::memory::monotonic_arena{};
+
+  auto values = std::vector<std::uint32_t, sbx::memory::arena_allocator<std::uint32_t>>{sbx::memory::arena_allocator<std::uint32_t>{arena}};
+
+  for (auto i = 0u; i < 100u; ++i) {
+    values.push_back(i);
+  }
+
+  EXPECT_GE(arena.statistics().allocated_bytes, 100u * sizeof(std::uint32_t));
+  EXPECT_EQ(values.get_allocator().resource(), &arena);
+
+  const auto rebound = sbx::memory::arena_allocator<double>{values.get_allocator()};
+
+  EXPECT_TRUE(rebound == values.get_allocator());
+}
+
+TEST(libsbx_memory_resource_allocator, default_constructed_uses_global_allocator) {
+  auto arena = sbx::memory::monotonic_arena{};
+
+  auto values = std::vector<std::uint32_t, sbx::memory::arena_allocator<std::uint32_t>>{};
+
+  for (auto i = 0u; i < 100u; ++i) {
+    values.push_back(i);
+  }
+
+  EXPECT_EQ(values.size(), 100u);
+  EXPECT_EQ(values.get_allocator().resource(), nullptr);
+  EXPECT_TRUE(values.get_allocator() == sbx::memory::arena_allocator<std::uint32_t>{});
+  EXPECT_FALSE(values.get_allocator() == sbx::memory::arena_allocator<std::uint32_t>{arena});
+
+  auto nodes = std::unordered_map<std::uint32_t, std::uint32_t, std::hash<std::uint32_t>, std::equal_to<std::uint32_t>, sbx::memory::fixed_pool_allocator<std::pair<const std::uint32_t, std::uint32_t>>>{};
+
+  nodes.emplace(1u, 2u);
+
+  EXPECT_EQ(nodes.at(1u), 2u);
+}
+
+TEST(libsbx_memory_pool_allocator, pools_small_arrays) {
+  // 48 bytes are served by the pool with 48 byte blocks
+  using pool_type = sbx::memory::thread_local_pool<48u>;
+
+  auto allocator = sbx::memory::pool_allocator<std::uint64_t>{};
+
+  const auto before = pool_type::statistics().reserved_bytes;
+
+  auto* single = allocator.allocate(1u);
+  auto* array = allocator.allocate(6u);
+
+  EXPECT_GT(pool_type::statistics().reserved_bytes, before);
+  EXPECT_TRUE(allocator_tests::is_aligned(array, alignof(std::max_align_t)));
+
+  // Requests above the largest size class are forwarded to the global allocator
+  auto* large = allocator.allocate(1000u);
+
+  for (auto i = 0u; i < 1000u; ++i) {
+    large[i] = i;
+  }
+
+  allocator.deallocate(large, 1000u);
+  allocator.deallocate(array, 6u);
+  allocator.deallocate(single, 1u);
+}
+
+TEST(libsbx_memory_pool_allocator, works_with_standard_containers) {
+  auto list = std::list<std::uint32_t, sbx::memory::pool_allocator<std::uint32_t>>{};
+  auto vector = std::vector<std::uint32_t, sbx::memory::pool_allocator<std::uint32_t>>{};
+  auto map = std::unordered_map<std::uint32_t, std::uint32_t, std::hash<std::uint32_t>, std::equal_to<std::uint32_t>, sbx::memory::pool_allocator<std::pair<const std::uint32_t, std::uint32_t>>>{};
+
+  for (auto i = 0u; i < 1000u; ++i) {
+    list.push_back(i);
+    vector.push_back(i);
+    map.emplace(i, i * 2u);
+  }
+
+  auto sum = 0u;
+
+  for (const auto value : list) {
+    sum += value;
+  }
+
+  EXPECT_EQ(sum, 999u * 1000u / 2u);
+  EXPECT_EQ(vector.back(), 999u);
+  EXPECT_EQ(map.at(500u), 1000u);
+}
+
+TEST(libsbx_memory_ecs, storage_with_arena_allocator) {
+  using allocator_type = sbx::memory::arena_allocator<allocator_tests::position>;
+
+  auto arena = sbx::memory::monotonic_arena{};
+
+  auto storage = sbx::ecs::basic_storage<allocator_tests::position, sbx::ecs::entity, allocator_type>{allocator_type{arena}};
+
+  for (auto i = 0u; i < 100u; ++i) {
+    storage.emplace(sbx::ecs::entity{i}, i, i + 1u);
+  }
+
+  EXPECT_EQ(storage.size(), 100u);
+  EXPECT_EQ(storage.get(sbx::ecs::entity{42u}).y, 43u);
+  EXPECT_EQ(storage.get_allocator().resource(), &arena);
+  EXPECT_GE(arena.statistics().allocated_bytes, 100u * sizeof(allocator_tests::position));
+
+  storage.erase(sbx::ecs::entity{42u});
+
+  EXPECT_EQ(storage.size(), 99u);
+}
+
+TEST(libsbx_memory_ecs, registry_with_arena_allocator) {
+  using allocator_type = sbx::memory::arena_allocator<sbx::ecs::entity>;
+
+  auto arena = sbx::memory::monotonic_arena{};
+
+  {
+    auto registry = sbx::ecs::basic_registry<sbx::ecs::entity, allocator_type>{allocator_type{arena}};
+
+    allocator_tests::exercise_registry(registry);
+
+    EXPECT_EQ(registry.get_allocator().resource(), &arena);
+
+    // The entities, the pools and their components all live in the arena
+    EXPECT_GE(arena.statistics().allocated_bytes, 1000u * (sizeof(sbx::ecs::entity) + sizeof(allocator_tests::position)));
+  }
+
+  arena.reset();
+
+  EXPECT_EQ(arena.statistics().allocated_bytes, 0u);
+}
+
+TEST(libsbx_memory_ecs, registry_with_pool_allocator) {
+  auto registry = sbx::ecs::basic_registry<sbx::ecs::entity, sbx::memory::pool_allocator<sbx::ecs::entity>>{};
+
+  allocator_tests::exercise_registry(registry);
+}
+
+#endif // LIBSBX_MEMORY_ALLOCATOR_TESTS_HPP_
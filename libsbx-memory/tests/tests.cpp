@@ -0,0 +1,9 @@
+#include <gtest/gtest.h>
+
+#include <tests/allocator_tests.hpp>
+
+auto main(int argc, char* argv[]) -> int {
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
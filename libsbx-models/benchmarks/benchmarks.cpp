@@ -0,0 +1,109 @@
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include <fmt/format.h>
+
+#include <libsbx/models/mesh.hpp>
+#include <libsbx/models/vertex3d.hpp>
+#include <libsbx/models/lod_builder.hpp>
+
+namespace {
+
+using clock_type = std::chrono::steady_clock;
+
+template<typename Callable>
+auto measure(const std::uint32_t iterations, Callable&& callable) -> double {
+  auto samples = std::vector<double>{};
+  samples.reserve(iterations);
+
+  for (auto i = 0u; i < iterations; ++i) {
+    const auto start = clock_type::now();
+    std::invoke(callable);
+    samples.push_back(std::chrono::duration<double, std::milli>(clock_type::now() - start).count());
+  }
+
+  std::ranges::sort(samples);
+
+  return samples[samples.size() / 2u];
+}
+
+struct mesh_data {
+  std::vector<sbx::models::vertex3d> vertices;
+  std::vector<std::uint32_t> indices;
+}; // struct mesh_data
+
+// UV sphere with a bumpy surface, so the simplifier has some detail to remove
+auto make_sphere(const std::uint32_t rings, const std::uint32_t segments) -> mesh_data {
+  auto result = mesh_data{};
+
+  for (auto ring = 0u; ring <= rings; ++ring) {
+    const auto theta = std::numbers::pi_v<std::float_t> * static_cast<std::float_t>(ring) / static_cast<std::float_t>(rings);
+
+    for (auto segment = 0u; segment <= segments; ++segment) {
+      const auto phi = 2.0f * std::numbers::pi_v<std::float_t> * static_cast<std::float_t>(segment) / static_cast<std::float_t>(segments);
+
+      const auto normal = sbx::math::vector3{std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi)};
+      const auto radius = 1.0f + 0.02f * std::sin(theta * 12.0f) * std::cos(phi * 12.0f);
+
+      auto vertex = sbx::models::vertex3d{};
+      vertex.position = normal * radius;
+      vertex.normal = normal;
+      vertex.uv = sbx::math::vector2{static_cast<std::float_t>(segment) / static_cast<std::float_t>(segments), static_cast<std::float_t>(ring) / static_cast<std::float_t>(rings)};
+
+      result.vertices.push_back(vertex);
+    }
+  }
+
+  for (auto ring = 0u; ring < rings; ++ring) {
+    for (auto segment = 0u; segment < segments; ++segment) {
+      const auto a = ring * (segments + 1u) + segment;
+      const auto b = a + segments + 1u;
+
+      result.indices.insert(result.indices.end(), {a, b, a + 1u, a + 1u, b, b + 1u});
+    }
+  }
+
+  return result;
+}
+
+auto lod_chain(const std::uint32_t rings, const std::uint32_t segments, const std::uint32_t iterations) -> void {
+  auto data = make_sphere(rings, segments);
+
+  const auto optimize_time = measure(iterations, [&]() {
+    auto copy = data;
+    sbx::models::detail::optimize(copy.vertices, copy.indices);
+  });
+
+  sbx::models::detail::optimize(data.vertices, data.indices);
+
+  auto lods = std::vector<sbx::models::lod_level>{};
+
+  const auto lod_time = measure(iterations, [&]() {
+    lods = sbx::models::build_lod_chain(data.indices, data.vertices);
+  });
+
+  const auto triangles = data.indices.size() / 3u;
+
+  fmt::print("sphere {}x{}: {} triangles\n", rings, segments, triangles);
+  fmt::print("  {:<28} {:>9.3f} ms\n", "optimization passes", optimize_time);
+  fmt::print("  {:<28} {:>9.3f} ms  ({:.2f}x of the optimization passes)\n", "lod chain", lod_time, lod_time / optimize_time);
+
+  for (auto level = 0u; level < lods.size(); ++level) {
+    const auto lod_triangles = lods[level].indices.size() / 3u;
+
+    fmt::print("  lod {:<24} {:>9} triangles ({:>5.1f}%)  error: {:.5f}\n", level + 1u, lod_triangles, 100.0 * static_cast<double>(lod_triangles) / static_cast<double>(triangles), lods[level].error);
+  }
+}
+
+} // namespace
+
+auto main() -> int {
+  lod_chain(64u, 128u, 20u);
+  lod_chain(256u, 512u, 10u);
+  lod_chain(512u, 1024u, 5u);
+
+  return 0;
+}
@@ -1,128 +1,267 @@
 #ifndef LIBSBX_MODELS_FRUSTUM_CULLING_TASK_HPP_
 #define LIBSBX_MODELS_FRUSTUM_CULLING_TASK_HPP_
 
+#include <array>
+#include <filesystem>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <cstdint>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/vector4.hpp>
+
 #include <libsbx/graphics/task.hpp>
 #include <libsbx/graphics/graphics_module.hpp>
-
-#include <libsbx/scenes/components/transform.hpp>
+#include <libsbx/graphics/render_graph.hpp>
 
 #include <libsbx/graphics/pipeline/compute_pipeline.hpp>
 
-#include <libsbx/graphics/buffers/uniform_handler.hpp>
 #include <libsbx/graphics/buffers/push_handler.hpp>
-#include <libsbx/graphics/buffers/storage_handler.hpp>
-
-#include <libsbx/graphics/descriptor/descriptor_handler.hpp>
+#include <libsbx/graphics/buffers/storage_buffer.hpp>
 
 #include <libsbx/scenes/scenes_module.hpp>
 
 #include <libsbx/scenes/components/camera.hpp>
-#include <libsbx/scenes/components/global_transform.hpp>
 
 namespace sbx::models {
 
-class frustum_culling_task final : public graphics::task {
+/**
+ * @brief Phases of the culling shader, passed to it as a push constant.
+ */
+enum class frustum_culling_phase : std::uint32_t {
+  reset = 0u,
+  cull = 1u,
+  compact = 2u
+}; // enum class frustum_culling_phase
+
+inline constexpr auto frustum_culling_local_size_x = std::uint32_t{64u};
+
+/**
+ * @brief Records the culling of the batches. Used by frustum_culling_task::execute and by the tests, which record with plain Vulkan handles.
+ *
+ * Clears the draw counts of every batch and then runs every phase for all batches before the next phase starts, so there is one barrier per phase
+ * instead of one per batch. The last phase is not followed by a barrier.
+ *
+ * @tparam Batches Range of batches with an instance_count and a command_count.
+ * @tparam Recorder Provides fill_draw_counts(batch), barrier(src_stage, src_access, dst_stage, dst_access), bind_pipeline() and
+ * dispatch(batch, phase, count, group_count).
+ */
+template<typename Batches, typename Recorder>
+auto record_frustum_culling(const Batches& batches, Recorder& recorder) -> void {
+  for (const auto& batch : batches) {
+    recorder.fill_draw_counts(batch);
+  }
 
-  using base = graphics::task;
+  recorder.barrier(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+
+  recorder.bind_pipeline();
+
+  for (const auto phase : {frustum_culling_phase::reset, frustum_culling_phase::cull, frustum_culling_phase::compact}) {
+    for (const auto& batch : batches) {
+      const auto count = (phase == frustum_culling_phase::cull) ? batch.instance_count : batch.command_count;
 
-  struct frustum_buffer {
-    sbx::math::vector4 planes[6];
-    sbx::math::vector4 corners[8];
-    std::uint32_t num_meshes_to_cull;
-    std::uint32_t num_visible_meshes;
-  }; // struct frustum_buffer
+      recorder.dispatch(batch, phase, count, (count + frustum_culling_local_size_x - 1u) / frustum_culling_local_size_x);
+    }
+
+    // The render graph synchronizes the last phase with the passes drawing the results
+    if (phase != frustum_culling_phase::compact) {
+      recorder.barrier(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT);
+    }
+  }
+}
+
+/**
+ * @brief Culls instances against the view frustum on the GPU and compacts the survivors into indirect draw commands.
+ *
+ * Every submitted batch describes the instances and commands of one pipeline of a draw list. execute runs three phases per batch
+ * (see record_frustum_culling): it resets the instance counts of the commands, appends every visible instance to its command and finally appends every command that kept an
+ * instance to its range, counting the draws per range. The result is drawn with command_buffer::draw_indexed_indirect_count.
+ *
+ * The task runs as part of a compute pass of the render graph. Passes drawing the culled commands have to use a buffer written by that pass,
+ * so the graph orders them after the culling and inserts the barrier for the indirect reads.
+ */
+class frustum_culling_task final : public graphics::task {
 
-  inline static constexpr auto usage = (VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
-  inline static constexpr auto properties = (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+  using base = graphics::task;
 
 public:
 
-  frustum_culling_task(const std::filesystem::path& path, const graphics::render_graph::compute_pass& pass)
+  struct alignas(16) cull_instance {
+    math::vector3 min;
+    std::uint32_t command_index;
+    math::vector3 max;
+    std::uint32_t instance_index;
+  }; // struct cull_instance
+
+  struct alignas(16) cull_command {
+    std::uint32_t command_index;
+    std::uint32_t range_index;
+    std::uint32_t range_offset;
+    std::uint32_t _pad0;
+  }; // struct cull_command
+
+  struct batch {
+    graphics::storage_buffer_handle source_commands;
+    graphics::storage_buffer_handle source_instances;
+    graphics::storage_buffer_handle cull_instances;
+    graphics::storage_buffer_handle cull_commands;
+    graphics::storage_buffer_handle scratch_commands;
+    graphics::storage_buffer_handle culled_commands;
+    graphics::storage_buffer_handle culled_instances;
+    graphics::storage_buffer_handle draw_counts;
+    std::uint64_t transforms;
+    std::uint32_t instance_count;
+    std::uint32_t command_count;
+    std::uint32_t range_count;
+  }; // struct batch
+
+  frustum_culling_task([[maybe_unused]] const graphics::render_graph::compute_pass& pass, const std::filesystem::path& path)
   : _pipeline{path},
     _push_handler{_pipeline} {
     auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-    _draw_commands_buffer = graphics_module.add_resource<graphics::buffer>(graphics::storage_buffer::min_size, usage, properties);
-    _bounding_box_buffer = graphics_module.add_resource<graphics::buffer>(graphics::storage_buffer::min_size, usage, properties);
-    _draw_data_buffer = graphics_module.add_resource<graphics::buffer>(graphics::storage_buffer::min_size, usage, properties);
-    _frustum_buffer = graphics_module.add_resource<graphics::buffer>(sizeof(frustum_buffer), usage, properties);
+    _frustum_buffer = graphics_module.add_resource<graphics::storage_buffer>(sizeof(frustum_data), VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
   }
 
-  ~frustum_culling_task() override = default;
+  ~frustum_culling_task() override {
+    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-  auto draw_commands_buffer() -> graphics::resource_handle<graphics::buffer> {
-    return _draw_commands_buffer;
+    graphics_module.remove_resource<graphics::storage_buffer>(_frustum_buffer);
+  }
+
+  /**
+   * @brief Queues a batch for the next call to execute. Draw lists submit their batches while they are updated, which may happen concurrently.
+   */
+  auto submit(const batch& batch) -> void {
+    if (batch.instance_count == 0u || batch.command_count == 0u) {
+      return;
+    }
+
+    auto lock = std::scoped_lock{_mutex};
+
+    _batches.push_back(batch);
   }
 
   auto execute(graphics::command_buffer& command_buffer) -> void override {
+    if (_batches.empty()) {
+      return;
+    }
+
     auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
     auto& scenes_module = core::engine::get_module<scenes::scenes_module>();
 
-    auto& logical_device = graphics_module.logical_device();
-
-    auto& draw_commands_buffer = graphics_module.get_resource<graphics::buffer>(_draw_commands_buffer);
-    auto& bounding_box_buffer = graphics_module.get_resource<graphics::buffer>(_bounding_box_buffer);
-    auto& draw_data_buffer = graphics_module.get_resource<graphics::buffer>(_draw_data_buffer);
-    auto& frustum_buffer = graphics_module.get_resource<graphics::buffer>(_frustum_buffer);
-
     auto& scene = scenes_module.scene();
 
     auto camera_node = scene.camera();
 
-    auto& transform = scene.get_component<scenes::transform>(camera_node);
-    auto& global_transform = scene.get_component<scenes::global_transform>(camera_node);
-
     const auto view = math::matrix4x4::inverted(scene.world_transform(camera_node));
 
     auto& camera = scene.get_component<scenes::camera>(camera_node);
 
-    auto frustum = camera.view_frustum(view);
+    const auto frustum = camera.view_frustum(view);
 
-    _pipeline.bind(command_buffer);
+    auto data = frustum_data{};
 
-    // _uniform_handler.push("model", math::matrix4x4::identity);
-    // _uniform_handler.push("subdivisions", 6u);
+    for (auto i = 0u; i < data.planes.size(); ++i) {
+      const auto& plane = frustum.plane(i);
 
-    // _descriptor_handler.push("uniform_parameters", _uniform_handler);
-    // _descriptor_handler.push("buffer_out_vertices", _output_vertex_storage_handler);
-    // _descriptor_handler.push("buffer_out_indices", _output_index_storage_handler);
+      data.planes[i] = math::vector4{plane.normal(), plane.distance() + margin};
+    }
 
-    _push_handler.push("draw_commands", draw_commands_buffer.address());
-    _push_handler.push("draw_data", draw_data_buffer.address());
-    _push_handler.push("bounding_boxes", bounding_box_buffer.address());
-    _push_handler.push("frustum", frustum_buffer.address());
+    auto& frustum_buffer = graphics_module.get_resource<graphics::storage_buffer>(_frustum_buffer);
 
-    // if (!_descriptor_handler.update(_pipeline)) {
-    //   return;
-    // }
+    frustum_buffer.update(&data, sizeof(frustum_data));
 
-    // _descriptor_handler.bind_descriptors(command_buffer);
-    _push_handler.bind(command_buffer);
+    auto recorder = batch_recorder{*this, graphics_module, command_buffer};
 
-    _pipeline.dispatch(command_buffer, {32u, 1u, 1u});
+    record_frustum_culling(_batches, recorder);
 
-    // const auto buffer_memory_barrier = graphics::command_buffer::release_ownership_data{
-    //   .src_stage_mask = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
-    //   .src_access_mask = VK_ACCESS_SHADER_WRITE_BIT,
-    //   .src_queue_family = logical_device.queue<graphics::queue::type::compute>().family(),
-    //   .dst_queue_family = logical_device.queue<graphics::queue::type::graphics>().family(),
-    //   .buffer = draw_commands_buffer
-    // };
-
-    // command_buffer.release_ownership({buffer_memory_barrier});
+    _batches.clear();
   }
 
 private:
 
-  graphics::compute_pipeline _pipeline;
+  // Same margin as the CPU culling, objects may be this far outside of a plane
+  inline static constexpr auto margin = std::float_t{0.5f};
+
+  struct frustum_data {
+    std::array<math::vector4, 6u> planes;
+  }; // struct frustum_data
+
+  /**
+   * @brief Records the steps of record_frustum_culling with the resources of the graphics module.
+   */
+  struct batch_recorder {
+
+    auto fill_draw_counts(const batch& batch) -> void {
+      auto& draw_counts = graphics_module.get_resource<graphics::storage_buffer>(batch.draw_counts);
+
+      command_buffer.fill_buffer(draw_counts.handle(), 0u, batch.range_count * sizeof(std::uint32_t), 0u);
+    }
+
+    auto barrier(const VkPipelineStageFlags2 src_stage, const VkAccessFlags2 src_access, const VkPipelineStageFlags2 dst_stage, const VkAccessFlags2 dst_access) -> void {
+      _barrier(command_buffer, src_stage, src_access, dst_stage, dst_access);
+    }
+
+    auto bind_pipeline() -> void {
+      task._pipeline.bind(command_buffer);
+    }
+
+    auto dispatch(const batch& batch, const frustum_culling_phase phase, const std::uint32_t count, const std::uint32_t group_count) -> void {
+      task._push(batch, phase, count);
+
+      task._push_handler.bind(command_buffer);
+
+      task._pipeline.dispatch(command_buffer, {group_count, 1u, 1u});
+    }
 
-  graphics::buffer_handle _bounding_box_buffer;
-  graphics::buffer_handle _draw_data_buffer;
-  graphics::buffer_handle _draw_commands_buffer;
-  graphics::buffer_handle _frustum_buffer;
+    frustum_culling_task& task;
+    graphics::graphics_module& graphics_module;
+    graphics::command_buffer& command_buffer;
 
+  }; // struct batch_recorder
+
+  auto _push(const batch& batch, const frustum_culling_phase current, const std::uint32_t count) -> void {
+    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+    const auto address = [&graphics_module](const graphics::storage_buffer_handle handle) {
+      return graphics_module.get_resource<graphics::storage_buffer>(handle).address();
+    };
+
+    _push_handler.push("source_commands", address(batch.source_commands));
+    _push_handler.push("source_instances", address(batch.source_instances));
+    _push_handler.push("cull_instances", address(batch.cull_instances));
+    _push_handler.push("cull_commands", address(batch.cull_commands));
+    _push_handler.push("scratch_commands", address(batch.scratch_commands));
+    _push_handler.push("culled_commands", address(batch.culled_commands));
+    _push_handler.push("culled_instances", address(batch.culled_instances));
+    _push_handler.push("draw_counts", address(batch.draw_counts));
+    _push_handler.push("transforms", batch.transforms);
+    _push_handler.push("frustum", address(_frustum_buffer));
+    _push_handler.push("phase", std::to_underlying(current));
+    _push_handler.push("count", count);
+  }
+
+  static auto _barrier(graphics::command_buffer& command_buffer, const VkPipelineStageFlags2 src_stage, const VkAccessFlags2 src_access, const VkPipelineStageFlags2 dst_stage, const VkAccessFlags2 dst_access) -> void {
+    auto memory_barrier = VkMemoryBarrier2{};
+    memory_barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2;
+    memory_barrier.srcStageMask = src_stage;
+    memory_barrier.srcAccessMask = src_access;
+    memory_barrier.dstStageMask = dst_stage;
+    memory_barrier.dstAccessMask = dst_access;
+
+    command_buffer.memory_dependency(memory_barrier);
+  }
+
+  graphics::compute_pipeline _pipeline;
   graphics::push_handler _push_handler;
 
+  graphics::storage_buffer_handle _frustum_buffer;
+
+  std::mutex _mutex;
+  std::vector<batch> _batches;
+
 }; // class frustum_culling_task
 
 } // namespace sbx::models
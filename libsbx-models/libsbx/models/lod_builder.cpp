@@ -0,0 +1,55 @@
+#include <libsbx/models/lod_builder.hpp>
+
+#include <algorithm>
+
+#include <meshoptimizer.h>
+
+namespace sbx::models {
+
+auto build_lod_chain(std::span<const std::uint32_t> indices, std::span<const vertex3d> vertices, const lod_settings& settings) -> std::vector<lod_level> {
+  auto result = std::vector<lod_level>{};
+
+  if (indices.empty() || vertices.empty()) {
+    return result;
+  }
+
+  const auto* positions = &vertices[0].position.x();
+
+  // Converts the relative error of the simplifier into the space of the mesh
+  const auto scale = meshopt_simplifyScale(positions, vertices.size(), sizeof(vertex3d));
+
+  auto previous_count = indices.size();
+
+  for (const auto& level : settings.levels) {
+    const auto target_count = static_cast<std::size_t>(static_cast<std::float_t>(indices.size()) * level.index_ratio) / 3u * 3u;
+
+    if (target_count < 3u) {
+      break;
+    }
+
+    auto lod = lod_level{};
+    lod.indices.resize(indices.size());
+
+    auto error = 0.0f;
+
+    const auto count = meshopt_simplify(lod.indices.data(), indices.data(), indices.size(), positions, vertices.size(), sizeof(vertex3d), target_count, level.target_error, meshopt_SimplifyLockBorder, &error);
+
+    // The simplifier ran into the error limit before it could remove enough triangles, coarser levels would not do better
+    if (count == 0u || static_cast<std::float_t>(count) > static_cast<std::float_t>(previous_count) * (1.0f - settings.minimum_reduction)) {
+      break;
+    }
+
+    lod.indices.resize(count);
+    lod.error = error * scale;
+
+    meshopt_optimizeVertexCache(lod.indices.data(), lod.indices.data(), lod.indices.size(), vertices.size());
+
+    previous_count = count;
+
+    result.push_back(std::move(lod));
+  }
+
+  return result;
+}
+
+} // namespace sbx::models
@@ -0,0 +1,55 @@
+#ifndef LIBSBX_MODELS_LOD_BUILDER_HPP_
+#define LIBSBX_MODELS_LOD_BUILDER_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include <libsbx/models/vertex3d.hpp>
+
+namespace sbx::models {
+
+struct lod_settings {
+
+  struct level {
+    // Fraction of the full detail indices to aim for
+    std::float_t index_ratio;
+    // Largest deviation the simplifier may introduce, relative to the extent of the mesh
+    std::float_t target_error;
+  }; // struct level
+
+  std::vector<level> levels{
+    level{0.5f, 0.01f},
+    level{0.25f, 0.02f},
+    level{0.125f, 0.05f}
+  };
+
+  // Levels that remove less than this fraction of the indices of the previous level are dropped, together with all coarser ones
+  std::float_t minimum_reduction{0.1f};
+
+}; // struct lod_settings
+
+struct lod_level {
+  std::vector<std::uint32_t> indices;
+  // Largest deviation from the full detail surface in the space of the mesh
+  std::float_t error;
+}; // struct lod_level
+
+/**
+ * @brief Builds simplified index buffers of decreasing detail for one submesh.
+ *
+ * Every level is simplified from the full detail indices, so its error is relative to the original surface and not to the previous level.
+ * Borders of the submesh are kept in place so neighbouring submeshes do not crack apart. The full detail level itself is not part of the result.
+ *
+ * @param indices Triangle list indices into vertices.
+ * @param vertices Vertices of the submesh.
+ * @param settings Target ratio and error per level.
+ *
+ * @return The levels in order of decreasing detail, at most settings.levels.size() of them.
+ */
+auto build_lod_chain(std::span<const std::uint32_t> indices, std::span<const vertex3d> vertices, const lod_settings& settings = lod_settings{}) -> std::vector<lod_level>;
+
+} // namespace sbx::models
+
+#endif // LIBSBX_MODELS_LOD_BUILDER_HPP_
@@ -0,0 +1,82 @@
+#include <libsbx/models/lod_selector.hpp>
+
+#include <algorithm>
+
+#include <easy/profiler.h>
+
+#include <libsbx/core/engine.hpp>
+
+#include <libsbx/devices/devices_module.hpp>
+
+#include <libsbx/scenes/components/camera.hpp>
+
+namespace sbx::models {
+
+auto lod_selector::begin(scenes::scene& scene) -> void {
+  const auto camera_node = scene.camera();
+
+  const auto& camera = scene.get_component<scenes::camera>(camera_node);
+
+  const auto& window = core::engine::get_module<devices::devices_module>().window();
+
+  begin(math::vector3{scene.world_transform(camera_node)[3]}, camera.near_plane(), std::abs(camera.projection()[1][1]) * static_cast<std::float_t>(window.height()) * 0.5f);
+}
+
+auto lod_selector::begin(const math::vector3& camera_position, const std::float_t near_plane, const std::float_t projection_scale) -> void {
+  ++_frame;
+
+  _camera_position = camera_position;
+  _near_plane = near_plane;
+  _projection_scale = projection_scale;
+}
+
+auto lod_selector::select(const std::uint64_t key, const graphics::submesh& submesh, const math::matrix4x4& model) -> std::uint32_t {
+  if (!_is_enabled || submesh.lod_count == 0u) {
+    return 0u;
+  }
+
+  // Errors are stored in the space of the mesh, so they grow with the largest scale of the instance
+  const auto scale = std::max({math::vector3{model[0]}.length(), math::vector3{model[1]}.length(), math::vector3{model[2]}.length()});
+
+  const auto center = math::vector3{model * math::vector4{submesh.bounds.center(), 1.0f}};
+  const auto radius = (submesh.bounds.max() - submesh.bounds.min()).length() * 0.5f * scale;
+
+  const auto distance = math::vector3::distance(center, _camera_position) - radius;
+
+  const auto projected_error = [&](const std::uint32_t level) {
+    return _projected_error(submesh.lod(level).error * scale, distance);
+  };
+
+  auto [entry, inserted] = _states.try_emplace(key, state{0u, _frame});
+
+  auto& [level, frame] = entry->second;
+
+  level = std::min(level, submesh.lod_count);
+  frame = _frame;
+
+  while (level > 0u && projected_error(level) > _pixel_error) {
+    --level;
+  }
+
+  const auto threshold = inserted ? _pixel_error : _pixel_error * (1.0f - _hysteresis);
+
+  while (level < submesh.lod_count && projected_error(level + 1u) <= threshold) {
+    ++level;
+  }
+
+  return level;
+}
+
+auto lod_selector::end() -> void {
+  EASY_FUNCTION();
+
+  std::erase_if(_states, [this](const auto& entry) {
+    return entry.second.frame != _frame;
+  });
+}
+
+auto lod_selector::_projected_error(const std::float_t error, const std::float_t distance) const noexcept -> std::float_t {
+  return error / std::max(distance, _near_plane) * _projection_scale;
+}
+
+} // namespace sbx::models
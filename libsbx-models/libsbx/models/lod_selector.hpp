@@ -0,0 +1,115 @@
+#ifndef LIBSBX_MODELS_LOD_SELECTOR_HPP_
+#define LIBSBX_MODELS_LOD_SELECTOR_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <unordered_map>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+
+#include <libsbx/graphics/pipeline/mesh.hpp>
+
+#include <libsbx/scenes/scene.hpp>
+
+namespace sbx::models {
+
+/**
+ * @brief Picks the level of detail of a submesh from the error its levels would cause on screen.
+ *
+ * The error of a level is projected with the distance of the bounds of the submesh to the camera, the coarsest level whose projected error
+ * stays below pixel_error is used. A level is only left for a coarser one once its successor is below pixel_error * (1 - hysteresis),
+ * so instances close to a threshold do not switch back and forth every frame.
+ *
+ * Usage per frame: begin, select for every submesh and then end.
+ */
+class lod_selector {
+
+public:
+
+  lod_selector() = default;
+
+  auto is_enabled() const noexcept -> bool {
+    return _is_enabled;
+  }
+
+  auto set_enabled(const bool is_enabled) noexcept -> void {
+    _is_enabled = is_enabled;
+  }
+
+  auto pixel_error() const noexcept -> std::float_t {
+    return _pixel_error;
+  }
+
+  /**
+   * @brief Sets the largest deviation from the full detail surface in pixels that is accepted.
+   */
+  auto set_pixel_error(const std::float_t pixel_error) noexcept -> void {
+    _pixel_error = pixel_error;
+  }
+
+  auto hysteresis() const noexcept -> std::float_t {
+    return _hysteresis;
+  }
+
+  auto set_hysteresis(const std::float_t hysteresis) noexcept -> void {
+    _hysteresis = hysteresis;
+  }
+
+  /**
+   * @brief Starts a frame viewed from the active camera of the scene.
+   */
+  auto begin(scenes::scene& scene) -> void;
+
+  /**
+   * @brief Starts a frame viewed from camera_position.
+   *
+   * @param near_plane Distances are clamped to the near plane.
+   * @param projection_scale Pixels per unit of world space at a distance of one unit.
+   */
+  auto begin(const math::vector3& camera_position, const std::float_t near_plane, const std::float_t projection_scale) -> void;
+
+  /**
+   * @brief Returns the level of detail to draw the submesh with, 0 is the full detail.
+   *
+   * @param key Identifies the instance of the submesh across frames.
+   * @param submesh Submesh with its levels of detail.
+   * @param model World matrix of the instance.
+   */
+  auto select(const std::uint64_t key, const graphics::submesh& submesh, const math::matrix4x4& model) -> std::uint32_t;
+
+  /**
+   * @brief Forgets the instances that were not selected this frame.
+   */
+  auto end() -> void;
+
+  static constexpr auto make_key(const std::uint32_t node, const std::uint32_t submesh_index) noexcept -> std::uint64_t {
+    return (static_cast<std::uint64_t>(node) << 32u) | static_cast<std::uint64_t>(submesh_index);
+  }
+
+private:
+
+  struct state {
+    std::uint32_t level;
+    std::uint64_t frame;
+  }; // struct state
+
+  auto _projected_error(const std::float_t error, const std::float_t distance) const noexcept -> std::float_t;
+
+  bool _is_enabled{true};
+  std::float_t _pixel_error{1.0f};
+  std::float_t _hysteresis{0.25f};
+
+  math::vector3 _camera_position{};
+  std::float_t _near_plane{0.1f};
+  // Pixels per unit of world space at a distance of one unit
+  std::float_t _projection_scale{1.0f};
+
+  std::uint64_t _frame{0u};
+  std::unordered_map<std::uint64_t, state> _states;
+
+}; // class lod_selector
+
+} // namespace sbx::models
+
+#endif // LIBSBX_MODELS_LOD_SELECTOR_HPP_
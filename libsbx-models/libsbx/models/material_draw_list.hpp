@@ -1,19 +1,26 @@
 #ifndef LIBSBX_MODELS_MATERIAL_DRAW_LIST_HPP_
 #define LIBSBX_MODELS_MATERIAL_DRAW_LIST_HPP_
 
+#include <optional>
+
 #include <magic_enum/magic_enum.hpp>
 
+#include <libsbx/memory/observer_ptr.hpp>
+
 #include <libsbx/assets/assets_module.hpp>
 
 #include <libsbx/graphics/graphics_module.hpp>
 #include <libsbx/graphics/draw_list.hpp>
 
 #include <libsbx/graphics/buffers/storage_buffer.hpp>
+#include <libsbx/graphics/buffers/slot_buffer.hpp>
 
 #include <libsbx/scenes/scenes_module.hpp>
 #include <libsbx/scenes/components/static_mesh.hpp>
+#include <libsbx/scenes/components/global_transform.hpp>
 
 #include <libsbx/models/material.hpp>
+#include <libsbx/models/frustum_culling_task.hpp>
 
 namespace sbx::models {
 
@@ -27,8 +34,25 @@ struct alignas(16) instance_data {
   std::uint32_t material_index;
   std::uint32_t object_id;
   std::uint32_t _pad0;
+
+  auto operator==(const instance_data& other) const -> bool = default;
 }; // struct instance_data
 
+/**
+ * @brief Collects the mesh submissions of a scene into per pipeline indirect draw commands and instance data.
+ *
+ * Transforms live in a persistent slot buffer with one stable slot per node, only transforms whose world version changed are uploaded.
+ * Material indices are stable as well, so the instance data and draw commands only have to be rebuilt when the submissions themselves change,
+ * e.g. when meshes are added or removed. A static scene therefore only pays for walking its submissions once per frame.
+ *
+ * The list is thread safe: the components of the scene are resolved in prepare, update only walks them and fills CPU side data and flush
+ * creates and uploads the buffers.
+ *
+ * With GPU culling enabled the camera buckets draw from compacted copies of the draw commands and instance data that a frustum_culling_task
+ * rebuilds every frame, together with a buffer holding the number of draws per range. The shadow bucket keeps drawing from the source buffers.
+ *
+ * @tparam Traits Provides the component and mesh types and enumerates the submissions of a scene.
+ */
 template<typename Traits>
 class basic_material_draw_list final : public graphics::draw_list {
 
@@ -49,11 +73,15 @@ public:
   struct range_reference {
     math::uuid mesh_id;
     graphics::draw_command_range range;
+    // Index of the draw count of the range in bucket_entry::draw_count_buffer, range.count is the maximum then
+    std::uint32_t draw_count_index{0u};
   }; // struct range_reference
 
   struct bucket_entry {
     graphics::storage_buffer_handle draw_commands_buffer{};
     graphics::storage_buffer_handle instance_data_buffer{};
+    // Only valid if the ranges are culled on the GPU
+    graphics::storage_buffer_handle draw_count_buffer{};
     std::vector<range_reference> ranges;
   }; // struct bucket_entry
 
@@ -66,98 +94,184 @@ public:
     create_buffer(transform_data_buffer_name, graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
     create_buffer(material_data_buffer_name, graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
 
-    traits_type::create_shared_buffers(*this);
+    _traits.create_shared_buffers(*this);
   }
 
   ~basic_material_draw_list() override {
     auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-    for (const auto& [key, data] : _pipeline_data) {  
-      graphics_module.remove_resource<graphics::storage_buffer>(data.draw_commands_buffer);
-      graphics_module.remove_resource<graphics::storage_buffer>(data.instance_data_buffer);
+    for (const auto& [key, data] : _pipeline_data) {
+      // Buffers are only created once the pipeline had instances in a flush
+      if (data.draw_commands_buffer) {
+        graphics_module.remove_resource<graphics::storage_buffer>(data.draw_commands_buffer);
+        graphics_module.remove_resource<graphics::storage_buffer>(data.instance_data_buffer);
+      }
+
+      if (data.culling) {
+        for (const auto handle : {data.culling->cull_instances, data.culling->cull_commands, data.culling->scratch_commands, data.culling->culled_commands, data.culling->culled_instances, data.culling->draw_counts}) {
+          graphics_module.remove_resource<graphics::storage_buffer>(handle);
+        }
+      }
     }
 
-    traits_type::destroy_shared_buffers(*this);
+    _traits.destroy_shared_buffers(*this);
   }
 
-  auto update() -> void override {
-    _transform_data.clear();
-    _material_data.clear();
+  auto is_thread_safe() const noexcept -> bool override {
+    return true;
+  }
 
-    for (auto& [key, pipeline_data] : _pipeline_data) {
-      pipeline_data.submesh_instances.clear();
-    }
+  auto prepare() -> void override {
+    auto& scenes_module = core::engine::get_module<scenes::scenes_module>();
 
-    for (auto& buckets : _bucket_ranges) {
-      buckets.clear();
-    }
+    _traits.prepare(scenes_module.scene());
+  }
 
+  auto update() -> void override {
     auto& assets_module = core::engine::get_module<assets::assets_module>();
 
-    auto& scenes_module = core::engine::get_module<scenes::scenes_module>();
-    auto& scene = scenes_module.scene();
-
+    _transforms.begin_frame();
+    _submissions.clear();
 
-    auto material_indices = std::unordered_map<math::uuid, std::uint32_t>{};
+    _traits.for_each_submission([&](const component_type& component, const scenes::node node, const scenes::global_transform& world, const math::uuid& mesh_id, std::uint32_t submesh_index, std::uint32_t lod, const math::uuid& material_id, const scenes::selection_tag& selection_tag, const bool is_visible, const instance_payload& payload) {
+      const auto& material = assets_module.get_asset<models::material>(material_id);
 
-    traits_type::for_each_submission(scene, [&](const component_type& component, const math::uuid& mesh_id, std::uint32_t submesh_index, const math::uuid& material_id, const transform_data& transform, const scenes::selection_tag& selection_tag, const instance_payload& payload) {
-      const auto transform_index = static_cast<std::uint32_t>(_transform_data.size());
-      _transform_data.push_back(transform);
+      // Instances outside of the view are still needed in the shadow pass
+      if (!is_visible && !_submits_to_shadow(material)) {
+        return;
+      }
 
-      const auto& material = assets_module.get_asset<models::material>(material_id);
+      const auto transform_index = _transforms.assign(node, world.version, [&world]() { return transform_data{world.model, world.normal}; });
 
       auto& pipeline = _get_or_create_pipeline_data(material);
 
-      auto [entry, created] = material_indices.try_emplace(material_id, static_cast<std::uint32_t>(_material_data.size()));
+      const auto material_index = _material_index(material_id);
 
-      if (created) {
-        _push_material(material);
-      }
+      _submissions.push_back(submission{&pipeline, mesh_id, submesh_index, lod, is_visible, _traits.make_instance_data(transform_index, material_index, selection_tag, payload)});
+    });
 
-      const auto instance = traits_type::make_instance_data(transform_index, entry->second, selection_tag, payload);
+    _is_released = _transforms.end_frame();
 
-      auto& per_mesh = pipeline.submesh_instances[mesh_id];
+    // Material data is small and references image indices that are rebuilt every frame, so it is always uploaded
+    _material_data.clear();
 
-      per_mesh.resize(std::max(per_mesh.size(), static_cast<std::size_t>(submesh_index + 1u)));
-      per_mesh[submesh_index].push_back(instance);
-    });
+    for (const auto& material_id : _materials) {
+      _push_material(assets_module.get_asset<models::material>(material_id));
+    }
+  }
 
-    update_buffer(_transform_data, transform_data_buffer_name);
+  auto flush() -> void override {
     update_buffer(_material_data, material_data_buffer_name);
 
-    traits_type::update_shared_buffers(*this);
+    _transforms.upload(get_buffer(transform_data_buffer_name));
 
-    for (auto& [key, pipeline_data] : _pipeline_data) {
-      if (pipeline_data.submesh_instances.empty()) {
-        continue;
-      }
+    _traits.update_shared_buffers(*this);
 
-      _build_draw_commands(key, pipeline_data);
+    if (_is_released || _submissions != _previous_submissions) {
+      _rebuild_draw_commands();
+    }
+
+    std::swap(_submissions, _previous_submissions);
+
+    // The draw ranges of the base class are cleared every frame
+    for (const auto& [hash, mesh_id, range] : _draw_command_ranges) {
+      push_draw_command_range(hash, mesh_id, range);
+    }
+
+    if (_culling_task) {
+      _submit_culling();
     }
   }
 
+  /**
+   * @brief Culls the visible instances against the view frustum on the GPU and compacts the draw commands of the camera buckets.
+   *
+   * The bounds of the submeshes are used as they are, so this is only meant for meshes that are not deformed.
+   *
+   * @param task The task of the compute pass that culls the draw list. It has to outlive the draw list.
+   */
+  auto enable_gpu_culling(frustum_culling_task& task) -> void {
+    _culling_task = &task;
+
+    // Bucket entries have to point at the culled buffers
+    _previous_submissions.clear();
+  }
+
   auto ranges(const bucket bucket) const -> const bucket_map& {
     return _bucket_ranges[magic_enum::enum_underlying(bucket)];
   }
 
+  auto traits() noexcept -> traits_type& {
+    return _traits;
+  }
+
 private:
 
+  struct culling_data {
+    graphics::storage_buffer_handle cull_instances;
+    graphics::storage_buffer_handle cull_commands;
+    graphics::storage_buffer_handle scratch_commands;
+    graphics::storage_buffer_handle culled_commands;
+    graphics::storage_buffer_handle culled_instances;
+    graphics::storage_buffer_handle draw_counts;
+    std::uint32_t instance_count{0u};
+    std::uint32_t command_count{0u};
+    std::uint32_t range_count{0u};
+
+    culling_data() {
+      auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+
+      cull_instances = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+      cull_commands = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+      scratch_commands = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+      culled_commands = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+      culled_instances = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
+      draw_counts = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+    }
+
+  }; // struct culling_data
+
   struct pipeline_data {
 
-    std::unordered_map<math::uuid, std::vector<std::vector<instance_data>>> submesh_instances;
+    // Per mesh the instances per submesh and level of detail, first of the visible ones and then of the ones only drawn into shadows
+    std::unordered_map<math::uuid, std::array<std::vector<std::vector<instance_data>>, 2u>> submesh_instances;
 
     graphics::storage_buffer_handle draw_commands_buffer;
     graphics::storage_buffer_handle instance_data_buffer;
 
-    pipeline_data() {
+    // Created on the first rebuild after GPU culling got enabled
+    std::optional<culling_data> culling;
+
+    // Pipelines are discovered while updating, so their buffers are created on their first rebuild
+    auto create_buffers() -> void {
       auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
       
-      draw_commands_buffer = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT);
+      draw_commands_buffer = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
       instance_data_buffer = graphics_module.add_resource<graphics::storage_buffer>(graphics::storage_buffer::min_size, VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT);
     }
 
   }; // struct pipeline_data
 
+  struct submission {
+    pipeline_data* pipeline;
+    math::uuid mesh_id;
+    std::uint32_t submesh_index;
+    std::uint32_t lod;
+    bool is_visible;
+    models::instance_data instance;
+
+    auto operator==(const submission& other) const -> bool = default;
+  }; // struct submission
+
+  // Every submesh gets one slot for its full detail and one per level of detail
+  static constexpr auto lod_slot_count = graphics::submesh::max_lod_count + 1u;
+
+  struct draw_command_range_entry {
+    std::size_t hash;
+    math::uuid mesh_id;
+    graphics::draw_command_range range;
+  }; // struct draw_command_range_entry
+
   static auto _classify_bucket(const models::material& material) -> bucket {
     if (material.alpha == models::alpha_mode::blend) {
       return bucket::transparent;
@@ -180,6 +294,72 @@ private:
     return entry->second;
   }
 
+  auto _material_index(const math::uuid& material_id) -> std::uint32_t {
+    auto [entry, created] = _material_indices.try_emplace(material_id, static_cast<std::uint32_t>(_materials.size()));
+
+    if (created) {
+      _materials.push_back(material_id);
+    }
+
+    return entry->second;
+  }
+
+  auto _rebuild_draw_commands() -> void {
+    for (auto& [key, pipeline_data] : _pipeline_data) {
+      pipeline_data.submesh_instances.clear();
+    }
+
+    for (auto& buckets : _bucket_ranges) {
+      buckets.clear();
+    }
+
+    _draw_command_ranges.clear();
+
+    for (const auto& submission : _submissions) {
+      auto& per_mesh = submission.pipeline->submesh_instances[submission.mesh_id][submission.is_visible ? 0u : 1u];
+
+      const auto slot = static_cast<std::size_t>(submission.submesh_index) * lod_slot_count + std::min(submission.lod, static_cast<std::uint32_t>(graphics::submesh::max_lod_count));
+
+      per_mesh.resize(std::max(per_mesh.size(), slot + 1u));
+      per_mesh[slot].push_back(submission.instance);
+    }
+
+    for (auto& [key, pipeline_data] : _pipeline_data) {
+      if (pipeline_data.submesh_instances.empty()) {
+        continue;
+      }
+
+      _build_draw_commands(key, pipeline_data);
+    }
+  }
+
+  auto _submit_culling() -> void {
+    const auto transforms = get_buffer(transform_data_buffer_name).address();
+
+    for (const auto& [key, pipeline] : _pipeline_data) {
+      if (!pipeline.culling) {
+        continue;
+      }
+
+      const auto& culling = *pipeline.culling;
+
+      _culling_task->submit(frustum_culling_task::batch{
+        .source_commands = pipeline.draw_commands_buffer,
+        .source_instances = pipeline.instance_data_buffer,
+        .cull_instances = culling.cull_instances,
+        .cull_commands = culling.cull_commands,
+        .scratch_commands = culling.scratch_commands,
+        .culled_commands = culling.culled_commands,
+        .culled_instances = culling.culled_instances,
+        .draw_counts = culling.draw_counts,
+        .transforms = transforms,
+        .instance_count = culling.instance_count,
+        .command_count = culling.command_count,
+        .range_count = culling.range_count
+      });
+    }
+  }
+
   auto _push_material(const models::material& material) -> void {
     auto data = models::material_data{};
     data.albedo_index = add_image(material.albedo);
@@ -223,48 +403,104 @@ private:
     auto instance_data = std::vector<models::instance_data>{};
     auto base_instance = std::uint32_t{0u};
 
+    auto cull_instances = std::vector<frustum_culling_task::cull_instance>{};
+    auto cull_commands = std::vector<frustum_culling_task::cull_command>{};
+    auto range_count = std::uint32_t{0u};
+
+    if (!pipeline.draw_commands_buffer) {
+      pipeline.create_buffers();
+    }
+
+    if (_culling_task && !pipeline.culling) {
+      pipeline.culling.emplace();
+    }
+
     const auto& buckets = _material_buckets.at(key);
 
-    for (auto& [mesh_id, submesh_vectors] : pipeline.submesh_instances) {
+    for (auto& [mesh_id, groups] : pipeline.submesh_instances) {
       auto& mesh = assets_module.get_asset<mesh_type>(mesh_id);
 
       auto range = graphics::draw_command_range{};
       range.offset = static_cast<std::uint32_t>(draw_commands.size());
       range.count  = 0u;
 
-      for (auto&& [submesh_index, instances] : ranges::views::enumerate(submesh_vectors)) {
-        if (instances.empty()) {
-          continue;
-        }
+      auto visible_count = std::uint32_t{0u};
+
+      for (auto&& [group_index, submesh_vectors] : ranges::views::enumerate(groups)) {
+        for (auto&& [slot, instances] : ranges::views::enumerate(submesh_vectors)) {
+          if (instances.empty()) {
+            continue;
+          }
+
+          const auto& submesh = mesh.submesh(static_cast<std::uint32_t>(slot / lod_slot_count));
+          const auto lod = submesh.lod(static_cast<std::uint32_t>(slot % lod_slot_count));
+
+          // Only the visible group goes through culling, it always comes first in the range
+          if (pipeline.culling && group_index == 0u) {
+            const auto command_index = static_cast<std::uint32_t>(draw_commands.size());
 
-        const auto& submesh = mesh.submesh(submesh_index);
+            cull_commands.push_back(frustum_culling_task::cull_command{command_index, range_count, range.offset, 0u});
 
-        auto command = VkDrawIndexedIndirectCommand{};
-        command.indexCount    = submesh.index_count;
-        command.instanceCount = static_cast<std::uint32_t>(instances.size());
-        command.firstIndex    = submesh.index_offset;
-        command.vertexOffset  = submesh.vertex_offset;
-        command.firstInstance = base_instance;
+            for (auto i = 0u; i < instances.size(); ++i) {
+              cull_instances.push_back(frustum_culling_task::cull_instance{submesh.bounds.min(), command_index, submesh.bounds.max(), base_instance + i});
+            }
+          }
 
-        draw_commands.push_back(command);
+          auto command = VkDrawIndexedIndirectCommand{};
+          command.indexCount    = lod.index_count;
+          command.instanceCount = static_cast<std::uint32_t>(instances.size());
+          command.firstIndex    = lod.index_offset;
+          command.vertexOffset  = submesh.vertex_offset;
+          command.firstInstance = base_instance;
 
-        utility::append(instance_data, std::move(instances));
+          draw_commands.push_back(command);
 
-        base_instance += command.instanceCount;
-        range.count++;
+          utility::append(instance_data, std::move(instances));
+
+          base_instance += command.instanceCount;
+          range.count++;
+        }
+
+        if (group_index == 0u) {
+          visible_count = range.count;
+        }
       }
 
       if (range.count > 0) {
         const auto hash = material_key_hash{}(key);
 
-        push_draw_command_range(hash, mesh_id, range);
+        const auto draw_count_index = range_count;
+
+        if (pipeline.culling && visible_count > 0u) {
+          ++range_count;
+        }
+
+        _draw_command_ranges.push_back(draw_command_range_entry{hash, mesh_id, range});
 
         for (const auto& bucket_type : buckets) {
+          // The commands of culled instances follow the visible ones, so only the shadow bucket draws them
+          auto bucket_range = range;
+
+          if (bucket_type != bucket::shadow) {
+            bucket_range.count = visible_count;
+          }
+
+          if (bucket_range.count == 0u) {
+            continue;
+          }
+
           auto& entry = _bucket_ranges[magic_enum::enum_underlying(bucket_type)][key];
 
-          entry.draw_commands_buffer = pipeline.draw_commands_buffer;
-          entry.instance_data_buffer = pipeline.instance_data_buffer;
-          entry.ranges.push_back(range_reference{ .mesh_id = mesh_id, .range = range });
+          if (pipeline.culling && bucket_type != bucket::shadow) {
+            entry.draw_commands_buffer = pipeline.culling->culled_commands;
+            entry.instance_data_buffer = pipeline.culling->culled_instances;
+            entry.draw_count_buffer = pipeline.culling->draw_counts;
+          } else {
+            entry.draw_commands_buffer = pipeline.draw_commands_buffer;
+            entry.instance_data_buffer = pipeline.instance_data_buffer;
+          }
+
+          entry.ranges.push_back(range_reference{ .mesh_id = mesh_id, .range = bucket_range, .draw_count_index = draw_count_index });
         }
       }
     }
@@ -273,6 +509,23 @@ private:
       _update_buffer(pipeline.draw_commands_buffer, draw_commands);
       _update_buffer(pipeline.instance_data_buffer, instance_data);
     }
+
+    if (pipeline.culling) {
+      auto& culling = *pipeline.culling;
+
+      culling.instance_count = static_cast<std::uint32_t>(cull_instances.size());
+      culling.command_count = static_cast<std::uint32_t>(cull_commands.size());
+      culling.range_count = range_count;
+
+      _update_buffer(culling.cull_instances, cull_instances);
+      _update_buffer(culling.cull_commands, cull_commands);
+
+      // Written by the compute shader, they only need to be large enough
+      _reserve_buffer(culling.scratch_commands, draw_commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+      _reserve_buffer(culling.culled_commands, draw_commands.size() * sizeof(VkDrawIndexedIndirectCommand));
+      _reserve_buffer(culling.culled_instances, instance_data.size() * sizeof(models::instance_data));
+      _reserve_buffer(culling.draw_counts, range_count * sizeof(std::uint32_t));
+    }
   }
 
 
@@ -292,14 +545,35 @@ private:
     }
   }
 
-  std::vector<transform_data> _transform_data;
+  static auto _reserve_buffer(graphics::storage_buffer_handle handle, const std::size_t required_size) -> void {
+    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
+    auto& buffer = graphics_module.get_resource<graphics::storage_buffer>(handle);
+
+    if (buffer.size() < required_size) {
+      buffer.resize(static_cast<std::size_t>(static_cast<std::float_t>(required_size) * 1.5f));
+    }
+  }
+
+  traits_type _traits;
+
+  graphics::slot_buffer<scenes::node, transform_data> _transforms;
+  bool _is_released{false};
+
+  std::vector<math::uuid> _materials;
+  std::unordered_map<math::uuid, std::uint32_t> _material_indices;
   std::vector<material_data> _material_data;
 
+  std::vector<submission> _submissions;
+  std::vector<submission> _previous_submissions;
+  std::vector<draw_command_range_entry> _draw_command_ranges;
+
   std::unordered_map<material_key, pipeline_data, material_key_hash> _pipeline_data;
 
   std::array<bucket_map, magic_enum::enum_count<bucket>()> _bucket_ranges;
 
-  inline static auto _material_buckets = std::unordered_map<material_key, std::unordered_set<bucket>, material_key_hash>{};
+  memory::observer_ptr<frustum_culling_task> _culling_task;
+
+  std::unordered_map<material_key, std::unordered_set<bucket>, material_key_hash> _material_buckets;
 
 }; // class material_draw_list
 
@@ -1,8 +1,8 @@
 #include <libsbx/models/mesh.hpp>
 
 #include <filesystem>
-#include <fstream>
 #include <cstdio>
+#include <limits>
 
 #include <fmt/format.h>
 
@@ -25,8 +25,45 @@
 
 #include <libsbx/graphics/graphics_module.hpp>
 
+#include <libsbx/models/lod_builder.hpp>
+#include <libsbx/models/meshlet_builder.hpp>
+
 namespace sbx::models {
 
+namespace detail {
+
+auto optimize(std::vector<vertex3d>& vertices, std::vector<std::uint32_t>& indices) -> void {
+  // Step 1: Generate remap to deduplicate vertices and index
+  auto remap = std::vector<std::uint32_t>{};
+  remap.resize(indices.size());
+
+  const auto vertex_count = meshopt_generateVertexRemap(remap.data(), indices.data(), indices.size(), vertices.data(), vertices.size(), sizeof(vertex3d));
+
+  // Step 2: Apply the remap to create a unique vertex buffer and remapped indices
+  auto unique_vertices = std::vector<vertex3d>{};
+  unique_vertices.resize(vertex_count);
+
+  auto remapped_indices = std::vector<std::uint32_t>{};
+  remapped_indices.resize(indices.size());
+
+  meshopt_remapVertexBuffer(unique_vertices.data(), vertices.data(), vertices.size(), sizeof(vertex3d), remap.data());
+  meshopt_remapIndexBuffer(remapped_indices.data(), indices.data(), indices.size(), remap.data());
+
+  // Step 3: Optimize index buffer for GPU vertex cache
+  meshopt_optimizeVertexCache(remapped_indices.data(), remapped_indices.data(), remapped_indices.size(), vertex_count);
+
+  // Step 4: Overdraw optimization
+  meshopt_optimizeOverdraw(remapped_indices.data(), remapped_indices.data(), remapped_indices.size(), &unique_vertices[0].position.x(), vertex_count, sizeof(vertex3d), 1.05f);
+
+  // Step 5: Vertex fetch optimization
+  meshopt_optimizeVertexFetch(unique_vertices.data(), remapped_indices.data(), remapped_indices.size(), unique_vertices.data(), vertex_count, sizeof(vertex3d));
+
+  vertices = std::move(unique_vertices);
+  indices = std::move(remapped_indices);
+}
+
+} // namespace detail
+
 static auto _convert_vec2(const aiVector2D& vector) -> math::vector2 {
   return math::vector2{vector.x, vector.y};
 }
@@ -51,7 +88,7 @@ static auto _convert_mat4(const aiMatrix4x4& matrix) -> math::matrix4x4 {
   return result;
 }
 
-static auto _load_mesh(const aiMesh* mesh, mesh::mesh_data& data, const math::matrix4x4& local_transform) -> void {
+static auto _load_mesh(const aiMesh* mesh, mesh::mesh_data& data, meshlet_data& meshlets, const math::matrix4x4& local_transform, const lod_settings& lod_settings, const meshlet_settings& meshlet_settings) -> void {
   if (!mesh->HasNormals()) {
     throw std::runtime_error{fmt::format("Mesh '{}' does not have normals", mesh->mName.C_Str())};
   }
@@ -94,64 +131,74 @@ static auto _load_mesh(const aiMesh* mesh, mesh::mesh_data& data, const math::ma
     indices.push_back(mesh->mFaces[i].mIndices[2]);
   }
 
-  // Step 1: Generate remap to deduplicate vertices and index
-  auto remap = std::vector<std::uint32_t>{};
-  remap.resize(indices.size());
+  detail::optimize(vertices, indices);
 
-  const auto vertex_count = meshopt_generateVertexRemap(remap.data(), indices.data(), indices.size(), vertices.data(), vertices.size(), sizeof(models::vertex3d));
+  // [NOTE] KAJ 2025-07-08 : Apply the "global" index offset here
+  // std::transform(indices.begin(), indices.end(), indices.begin(), [vertices_count](const auto index) { return index + vertices_count; });
 
-  // Step 2: Apply the remap to create a unique vertex buffer and remapped indices
-  auto unique_vertices = std::vector<models::vertex3d>{};
-  unique_vertices.resize(vertex_count);
+  utility::append(data.vertices, vertices);
+  utility::append(data.indices, indices);
 
-  auto remapped_indices = std::vector<std::uint32_t>{};
-  remapped_indices.resize(indices.size());
+  // The AABB of assimp is in the space of the mesh but the vertices are already transformed by the node
+  auto min = math::vector3{std::numeric_limits<std::float_t>::max()};
+  auto max = math::vector3{std::numeric_limits<std::float_t>::lowest()};
 
-  meshopt_remapVertexBuffer(unique_vertices.data(), vertices.data(), vertices.size(), sizeof(models::vertex3d), remap.data());
-  meshopt_remapIndexBuffer(remapped_indices.data(), indices.data(), indices.size(), remap.data());
+  for (const auto& vertex : vertices) {
+    min = math::vector3::min(min, vertex.position);
+    max = math::vector3::max(max, vertex.position);
+  }
 
-  // Step 3: Optimize index buffer for GPU vertex cache
-  meshopt_optimizeVertexCache(remapped_indices.data(), remapped_indices.data(), remapped_indices.size(), vertex_count);
+  submesh.bounds = math::volume{min, max};
+  submesh.local_transform = local_transform;
+  submesh.name = utility::hashed_string{mesh->mName.C_Str()};
 
-  // Step 4: Overdraw optimization
-  meshopt_optimizeOverdraw(remapped_indices.data(), remapped_indices.data(), remapped_indices.size(), &unique_vertices[0].position.x(), vertex_count, sizeof(models::vertex3d), 1.05f);
+  build_meshlets(indices, vertices, meshlets, meshlet_settings);
 
-  // Step 5: Vertex fetch optimization
-  meshopt_optimizeVertexFetch(unique_vertices.data(), remapped_indices.data(), remapped_indices.size(), unique_vertices.data(), vertex_count, sizeof(models::vertex3d));
+  // Levels of detail share the vertices of the submesh and follow its indices
+  auto lods = build_lod_chain(indices, vertices, lod_settings);
 
-  // [NOTE] KAJ 2025-07-08 : Apply the "global" index offset here
-  // std::transform(remapped_indices.begin(), remapped_indices.end(), remapped_indices.begin(), [vertices_count](const auto index) { return index + vertices_count; });
+  lods.resize(std::min(lods.size(), graphics::submesh::max_lod_count));
 
-  utility::append(data.vertices, unique_vertices);
-  utility::append(data.indices, remapped_indices);
+  for (auto level = 0u; level < lods.size(); ++level) {
+    submesh.lods[level] = graphics::submesh_lod{static_cast<std::uint32_t>(lods[level].indices.size()), static_cast<std::uint32_t>(data.indices.size()), lods[level].error};
 
-  submesh.bounds = math::volume{_convert_vec3(mesh->mAABB.mMin), _convert_vec3(mesh->mAABB.mMax)};
-  submesh.local_transform = local_transform;
-  submesh.name = utility::hashed_string{mesh->mName.C_Str()};
+    utility::append(data.indices, std::move(lods[level].indices));
+  }
+
+  submesh.lod_count = static_cast<std::uint32_t>(lods.size());
 
   data.submeshes.push_back(submesh);
 }
 
-static auto _load_node(const aiNode* node, const aiScene* scene, mesh::mesh_data& data, const math::matrix4x4& parent_transform) -> void {
+static auto _load_node(const aiNode* node, const aiScene* scene, mesh::mesh_data& data, meshlet_data& meshlets, const math::matrix4x4& parent_transform, const lod_settings& lod_settings, const meshlet_settings& meshlet_settings) -> void {
   const auto local_transform = parent_transform * _convert_mat4(node->mTransformation);
 
   for (auto i = 0u; i < node->mNumMeshes; ++i) {
-    _load_mesh(scene->mMeshes[node->mMeshes[i]], data, local_transform);
+    _load_mesh(scene->mMeshes[node->mMeshes[i]], data, meshlets, local_transform, lod_settings, meshlet_settings);
   }
 
   for (auto i = 0u; i < node->mNumChildren; ++i) {
-    _load_node(node->mChildren[i], scene, data, local_transform);
+    _load_node(node->mChildren[i], scene, data, meshlets, local_transform, lod_settings, meshlet_settings);
   }
 }
 
 mesh::mesh(const std::filesystem::path& path)
-: base{_load(path)} { }
+: mesh{_load(path)} { }
+
+mesh::mesh(source&& source)
+: base{
+    source.cache ? source.cache->vertices() : std::span<const vertex3d>{source.data.vertices},
+    source.cache ? source.cache->indices() : std::span<const std::uint32_t>{source.data.indices},
+    source.cache ? source.cache->submeshes() : std::move(source.data.submeshes),
+    source.data.bounds
+  },
+  _meshlets{source.cache ? source.cache->meshlets() : std::move(source.meshlets)} { }
 
 mesh::~mesh() {
 
 }
 
-auto mesh::_load(const std::filesystem::path& path) -> mesh_data {
+auto mesh::_load(const std::filesystem::path& path) -> source {
   auto& assets_module = core::engine::get_module<assets::assets_module>();
   const auto resolved_path = assets_module.resolve_path(path);
 
@@ -159,6 +206,45 @@ auto mesh::_load(const std::filesystem::path& path) -> mesh_data {
     throw std::runtime_error{"Mesh file not found: " + resolved_path.string()};
   }
 
+  return load_resolved(resolved_path);
+}
+
+auto mesh::load_resolved(const std::filesystem::path& resolved_path) -> source {
+  const auto cache_path = std::filesystem::path{resolved_path}.replace_extension(mesh_cache_extension);
+
+  auto result = source{};
+
+  // Empty bounds are calculated from the submeshes by graphics::mesh
+  result.data.bounds = math::volume{math::vector3::zero, math::vector3::zero};
+
+  if (mesh_cache::is_up_to_date(cache_path, resolved_path)) {
+    auto timer = utility::timer{};
+
+    try {
+      result.cache.emplace(cache_path);
+
+      utility::logger<"models">::debug("Loaded mesh cache: {}, vertices: {}, indices: {} in {:.2f}ms", cache_path.string(), result.cache->vertices().size(), result.cache->indices().size(), units::quantity_cast<units::millisecond>(timer.elapsed()).value());
+
+      return result;
+    } catch (const std::exception& exception) {
+      utility::logger<"models">::warn("Ignoring mesh cache '{}': {}", cache_path.string(), exception.what());
+    }
+  }
+
+  result.data = _import(resolved_path, result.meshlets);
+
+  try {
+    mesh_cache::write(cache_path, resolved_path, result.data, result.meshlets, _cache_compression);
+
+    utility::logger<"models">::debug("Wrote mesh cache '{}'", cache_path.string());
+  } catch (const std::exception& exception) {
+    utility::logger<"models">::warn("Failed to write mesh cache '{}': {}", cache_path.string(), exception.what());
+  }
+
+  return result;
+}
+
+auto mesh::_import(const std::filesystem::path& resolved_path, meshlet_data& meshlets) -> mesh_data {
   auto timer = utility::timer{};
 
   auto data = mesh::mesh_data{};
@@ -184,9 +270,9 @@ auto mesh::_load(const std::filesystem::path& path) -> mesh_data {
     throw std::runtime_error{fmt::format("Error loading mesh '{}': {}", resolved_path.string(), importer.GetErrorString())};
   }
 
-  _load_node(scene->mRootNode, scene, data, math::matrix4x4::identity);
+  _load_node(scene->mRootNode, scene, data, meshlets, math::matrix4x4::identity, _lod_settings, _meshlet_settings);
 
-  // [NOTE] KAJ 2024-03-20 : We need to calculate the bounds of the mesh from the submeshes.
+  // Empty bounds are calculated from the submeshes by graphics::mesh
   data.bounds = math::volume{math::vector3::zero, math::vector3::zero};
 
   const auto vertices_count = data.vertices.size();
@@ -201,81 +287,4 @@ auto mesh::_load(const std::filesystem::path& path) -> mesh_data {
   return data;
 }
 
-static auto calculate_aabb(const std::vector<vertex3d>& vertices) -> math::volume {
-  if (vertices.empty()) {
-    utility::logger<"models">::warn("Calculating AABB for empty mesh, returning default volume");
-    return math::volume{sbx::math::vector3{0.0f, 0.0f, 0.0f}, sbx::math::vector3{0.0f, 0.0f, 0.0f}};
-  }
-
-  auto min = vertices.front().position;
-  auto max = vertices.front().position;
-
-  for (const auto& vertex : vertices) {
-    min = math::vector3::min(min, vertex.position);
-    max = math::vector3::max(max, vertex.position);
-  }
-
-  return math::volume{min, max};
-}
-
-static auto calculate_sphere(const std::vector<vertex3d>& vertices) -> math::sphere {
-  if (vertices.empty()) {
-    utility::logger<"models">::warn("Calculating sphere for empty mesh, returning default sphere");
-    return math::sphere{sbx::math::vector3{0.0f, 0.0f, 0.0f}, 0.0f};
-  }
-
-  auto center = sbx::math::vector3{0.0f, 0.0f, 0.0f};
-
-  for (const auto& vertex : vertices) {
-    center += vertex.position;
-  }
-
-  center /= static_cast<float>(vertices.size());
-
-  auto radius = 0.0f;
-
-  for (const auto& vertex : vertices) {
-    const auto distance = math::vector3::distance(center, vertex.position);
-    radius = std::max(radius, std::abs(distance));
-  }
-
-  return math::sphere{center, radius};
-}
-
-auto mesh::_process(const std::filesystem::path& path, const mesh_data& data) -> void {
-  const auto output_path = std::filesystem::path{path}.replace_extension(".sbxmsh");
-
-  auto output_file = std::ofstream{output_path, std::ios::binary};
-
-  if (!output_file.is_open()) {
-    throw std::runtime_error{fmt::format("Failed to open output file: {}", output_path.string())};
-  }
-
-  auto header = file_header{};
-  header.magic = 69u;
-  header.version = 1u;
-  header.index_type_size = sizeof(std::uint32_t);
-  header.index_count = static_cast<std::uint32_t>(data.indices.size());
-  header.vertex_type_size = sizeof(vertex3d);
-  header.vertex_count = static_cast<std::uint32_t>(data.vertices.size());
-  header.submesh_count = static_cast<std::uint32_t>(data.submeshes.size());
-
-  output_file.write(reinterpret_cast<const char*>(&header), sizeof(file_header));
-
-  output_file.write(reinterpret_cast<const char*>(data.indices.data()), data.indices.size() * sizeof(std::uint32_t));
-  output_file.write(reinterpret_cast<const char*>(data.vertices.data()), data.vertices.size() * sizeof(vertex3d));
-  output_file.write(reinterpret_cast<const char*>(data.submeshes.data()), data.submeshes.size() * sizeof(graphics::submesh));
-
-  const auto aabb = calculate_aabb(data.vertices);
-  output_file.write(reinterpret_cast<const char*>(&aabb), sizeof(math::volume));
-
-  const auto sphere = calculate_sphere(data.vertices);
-  output_file.write(reinterpret_cast<const char*>(&sphere), sizeof(math::sphere));
-
-  utility::logger<"models">::debug("Processed mesh file '{}' to .sbxmsh format", output_path.string());
-
-  output_file.flush();
-  output_file.close();
-}
-
 } // namespace sbx::models
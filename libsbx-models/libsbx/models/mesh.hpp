@@ -1,7 +1,10 @@
 #ifndef LIBSBX_MODELS_MESH_HPP_
 #define LIBSBX_MODELS_MESH_HPP_
 
+#include <cstdint>
+#include <vector>
 #include <filesystem>
+#include <optional>
 
 #include <libsbx/utility/hash.hpp>
 
@@ -13,38 +16,93 @@
 #include <libsbx/graphics/pipeline/mesh.hpp>
 
 #include <libsbx/models/vertex3d.hpp>
+#include <libsbx/models/mesh_cache.hpp>
+#include <libsbx/models/lod_builder.hpp>
+#include <libsbx/models/meshlet_builder.hpp>
 
 namespace sbx::models {
 
+namespace detail {
+
+/**
+ * @brief Runs the meshoptimizer passes of the import on one submesh: deduplicates the vertices and reorders the indices for the vertex cache
+ * and overdraw and the vertices for vertex fetch. The levels of detail and meshlets are built from the result.
+ */
+auto optimize(std::vector<vertex3d>& vertices, std::vector<std::uint32_t>& indices) -> void;
+
+} // namespace detail
+
 class mesh : public graphics::mesh<vertex3d>, public io::loader_factory<mesh, graphics::mesh<vertex3d>::mesh_data> {
 
   using base = graphics::mesh<vertex3d>;
 
 public:
 
-  struct file_header {
-    std::uint32_t magic;
-    std::uint32_t version;
-    std::uint32_t index_type_size;
-    std::uint32_t index_count;
-    std::uint32_t vertex_type_size;
-    std::uint32_t vertex_count;
-    std::uint32_t submesh_count;
-  }; // struct file_header
-
   using mesh_data = graphics::mesh<vertex3d>::mesh_data;
 
+  // Either a mapped cache or freshly imported data, only alive until the upload is done
+  struct source {
+    std::optional<mesh_cache> cache;
+    mesh_data data;
+    meshlet_data meshlets;
+  }; // struct source
+
   using base::mesh;
 
+  /**
+   * @brief Loads the mesh from its .sbxmsh cache if the cache is up to date, otherwise imports the source file and writes the cache.
+   */
   mesh(const std::filesystem::path& path);
 
   ~mesh() override;
 
+  /**
+   * @brief Sets the compression of newly written caches. Compressed caches are smaller but have to be decompressed before the upload.
+   */
+  static auto set_cache_compression(const mesh_cache_compression compression) -> void {
+    _cache_compression = compression;
+  }
+
+  /**
+   * @brief Sets the levels of detail generated for newly imported meshes. Existing caches keep their levels until the source changes.
+   */
+  static auto set_lod_settings(const lod_settings& settings) -> void {
+    _lod_settings = settings;
+  }
+
+  /**
+   * @brief Sets the limits of the meshlets generated for newly imported meshes.
+   */
+  static auto set_meshlet_settings(const meshlet_settings& settings) -> void {
+    _meshlet_settings = settings;
+  }
+
+  /**
+   * @brief Meshlets of the full detail indices of every submesh with their culling bounds, kept on the CPU.
+   */
+  auto meshlets() const noexcept -> const meshlet_data& {
+    return _meshlets;
+  }
+
+  /**
+   * @brief Opens the cache of a source file whose path is already resolved. Caches that are stale or fail to open, for example because of a
+   * checksum mismatch, are replaced by importing the source file again. Does not need a running engine.
+   */
+  static auto load_resolved(const std::filesystem::path& resolved_path) -> source;
+
 private:
 
-  static auto _load(const std::filesystem::path& path) -> mesh_data;
+  mesh(source&& source);
+
+  static auto _load(const std::filesystem::path& path) -> source;
+
+  static auto _import(const std::filesystem::path& path, meshlet_data& meshlets) -> mesh_data;
+
+  inline static auto _cache_compression = mesh_cache_compression::none;
+  inline static auto _lod_settings = lod_settings{};
+  inline static auto _meshlet_settings = meshlet_settings{};
 
-  static auto _process(const std::filesystem::path& path, const mesh_data& data) -> void;
+  meshlet_data _meshlets;
 
 }; // class mesh
 
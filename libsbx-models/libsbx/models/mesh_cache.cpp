@@ -0,0 +1,347 @@
+#include <libsbx/models/mesh_cache.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+
+#include <libsbx/utility/exception.hpp>
+#include <libsbx/utility/hash.hpp>
+#include <libsbx/utility/compression.hpp>
+
+namespace sbx::models {
+
+static_assert(std::endian::native == std::endian::little, "The mesh cache format is only supported on little endian targets");
+
+static_assert(std::is_trivially_copyable_v<mesh_cache_header>);
+static_assert(std::is_trivially_copyable_v<mesh_cache_submesh>);
+static_assert(std::is_trivially_copyable_v<vertex3d>);
+static_assert(std::is_trivially_copyable_v<meshlet>);
+static_assert(std::is_trivially_copyable_v<math::cluster_bounds>);
+
+namespace {
+
+constexpr auto section_alignment = std::size_t{16u};
+
+constexpr auto align_up(const std::size_t value, const std::size_t alignment) noexcept -> std::size_t {
+  return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+struct payload_layout {
+  std::size_t vertices;
+  std::size_t indices;
+  std::size_t submeshes;
+  std::size_t names;
+  std::size_t meshlets;
+  std::size_t meshlet_bounds;
+  std::size_t meshlet_vertices;
+  std::size_t meshlet_triangles;
+  std::size_t size;
+}; // struct payload_layout
+
+auto make_layout(const mesh_cache_header& header) -> payload_layout {
+  auto layout = payload_layout{};
+
+  layout.vertices = 0u;
+  layout.indices = align_up(layout.vertices + std::size_t{header.vertex_count} * sizeof(vertex3d), section_alignment);
+  layout.submeshes = align_up(layout.indices + std::size_t{header.index_count} * sizeof(std::uint32_t), section_alignment);
+  layout.names = align_up(layout.submeshes + std::size_t{header.submesh_count} * sizeof(mesh_cache_submesh), section_alignment);
+  layout.meshlets = align_up(layout.names + std::size_t{header.name_size}, section_alignment);
+  layout.meshlet_bounds = align_up(layout.meshlets + std::size_t{header.meshlet_count} * sizeof(meshlet), section_alignment);
+  layout.meshlet_vertices = align_up(layout.meshlet_bounds + std::size_t{header.meshlet_count} * sizeof(math::cluster_bounds), section_alignment);
+  layout.meshlet_triangles = align_up(layout.meshlet_vertices + std::size_t{header.meshlet_vertex_count} * sizeof(std::uint32_t), section_alignment);
+  layout.size = layout.meshlet_triangles + std::size_t{header.meshlet_triangle_size};
+
+  return layout;
+}
+
+auto checksum(const std::span<const char> bytes) -> std::uint64_t {
+  return utility::xxhash64{}(bytes);
+}
+
+auto header_checksum(mesh_cache_header header) -> std::uint64_t {
+  header.header_checksum = 0u;
+
+  return checksum(std::span<const char>{reinterpret_cast<const char*>(&header), sizeof(mesh_cache_header)});
+}
+
+auto stored_payload(const utility::mapped_file& file, const mesh_cache_header& header) -> std::span<const char> {
+  return std::span<const char>{reinterpret_cast<const char*>(file.data().data() + sizeof(mesh_cache_header)), static_cast<std::size_t>(header.stored_size)};
+}
+
+struct source_stamp {
+  std::uint64_t size;
+  std::int64_t time;
+}; // struct source_stamp
+
+auto make_source_stamp(const std::filesystem::path& source) -> source_stamp {
+  return source_stamp{
+    static_cast<std::uint64_t>(std::filesystem::file_size(source)),
+    static_cast<std::int64_t>(std::filesystem::last_write_time(source).time_since_epoch().count())
+  };
+}
+
+} // namespace
+
+mesh_cache::mesh_cache(const std::filesystem::path& path)
+: _file{path} {
+  const auto bytes = _file.data();
+
+  if (bytes.size() < sizeof(mesh_cache_header)) {
+    throw utility::runtime_error{"Mesh cache '{}' is too small", path.string()};
+  }
+
+  std::memcpy(&_header, bytes.data(), sizeof(mesh_cache_header));
+
+  if (_header.magic != mesh_cache_magic) {
+    throw utility::runtime_error{"Mesh cache '{}' has an invalid magic", path.string()};
+  }
+
+  if (_header.version != mesh_cache_version || _header.vertex_size != sizeof(vertex3d)) {
+    throw utility::runtime_error{"Mesh cache '{}' has version {} with vertex size {}, expected version {} with vertex size {}", path.string(), _header.version, _header.vertex_size, mesh_cache_version, sizeof(vertex3d)};
+  }
+
+  if (header_checksum(_header) != _header.header_checksum) {
+    throw utility::runtime_error{"Mesh cache '{}' failed its header checksum", path.string()};
+  }
+
+  if (_header.stored_size != bytes.size() - sizeof(mesh_cache_header)) {
+    throw utility::runtime_error{"Mesh cache '{}' is truncated", path.string()};
+  }
+
+  const auto layout = make_layout(_header);
+
+  if (layout.size != _header.payload_size) {
+    throw utility::runtime_error{"Mesh cache '{}' has an inconsistent payload size", path.string()};
+  }
+
+  const auto stored = stored_payload(_file, _header);
+
+  // A corrupt payload can still have valid section bounds, so it is hashed before any of it is used
+  if (checksum(stored) != _header.checksum) {
+    throw utility::runtime_error{"Mesh cache '{}' failed its payload checksum", path.string()};
+  }
+
+  auto payload = stored;
+
+  switch (_header.compression) {
+    case mesh_cache_compression::none: {
+      if (stored.size() != _header.payload_size) {
+        throw utility::runtime_error{"Mesh cache '{}' has an inconsistent payload size", path.string()};
+      }
+
+      break;
+    }
+    case mesh_cache_compression::lz4: {
+      _decompressed = utility::compressor::decompress(stored, static_cast<std::size_t>(_header.payload_size));
+
+      if (_decompressed.size() != _header.payload_size) {
+        throw utility::runtime_error{"Mesh cache '{}' decompressed to {} bytes, expected {}", path.string(), _decompressed.size(), _header.payload_size};
+      }
+
+      payload = _decompressed;
+
+      break;
+    }
+    default: {
+      throw utility::runtime_error{"Mesh cache '{}' uses unknown compression {}", path.string(), std::to_underlying(_header.compression)};
+    }
+  }
+
+  _vertices = std::span<const vertex3d>{reinterpret_cast<const vertex3d*>(payload.data() + layout.vertices), _header.vertex_count};
+  _indices = std::span<const std::uint32_t>{reinterpret_cast<const std::uint32_t*>(payload.data() + layout.indices), _header.index_count};
+  _submeshes = std::span<const mesh_cache_submesh>{reinterpret_cast<const mesh_cache_submesh*>(payload.data() + layout.submeshes), _header.submesh_count};
+  _names = std::string_view{payload.data() + layout.names, _header.name_size};
+  _meshlets = std::span<const meshlet>{reinterpret_cast<const meshlet*>(payload.data() + layout.meshlets), _header.meshlet_count};
+  _meshlet_bounds = std::span<const math::cluster_bounds>{reinterpret_cast<const math::cluster_bounds*>(payload.data() + layout.meshlet_bounds), _header.meshlet_count};
+  _meshlet_vertices = std::span<const std::uint32_t>{reinterpret_cast<const std::uint32_t*>(payload.data() + layout.meshlet_vertices), _header.meshlet_vertex_count};
+  _meshlet_triangles = std::span<const std::uint8_t>{reinterpret_cast<const std::uint8_t*>(payload.data() + layout.meshlet_triangles), _header.meshlet_triangle_size};
+
+  for (const auto& submesh : _submeshes) {
+    if (std::size_t{submesh.name_offset} + submesh.name_length > _names.size()) {
+      throw utility::runtime_error{"Mesh cache '{}' has a submesh name out of bounds", path.string()};
+    }
+
+    if (std::size_t{submesh.index_offset} + submesh.index_count > _indices.size() || submesh.vertex_offset > _vertices.size()) {
+      throw utility::runtime_error{"Mesh cache '{}' has a submesh out of bounds", path.string()};
+    }
+
+    if (submesh.lod_count > submesh.lods.size()) {
+      throw utility::runtime_error{"Mesh cache '{}' has a submesh with {} levels of detail", path.string(), submesh.lod_count};
+    }
+
+    for (auto level = 0u; level < submesh.lod_count; ++level) {
+      if (std::size_t{submesh.lods[level].index_offset} + submesh.lods[level].index_count > _indices.size()) {
+        throw utility::runtime_error{"Mesh cache '{}' has a level of detail out of bounds", path.string()};
+      }
+    }
+
+    if (std::size_t{submesh.meshlets.offset} + submesh.meshlets.count > _meshlets.size()) {
+      throw utility::runtime_error{"Mesh cache '{}' has a submesh with meshlets out of bounds", path.string()};
+    }
+  }
+
+  for (const auto& cluster : _meshlets) {
+    if (std::size_t{cluster.vertex_offset} + cluster.vertex_count > _meshlet_vertices.size() || std::size_t{cluster.triangle_offset} + std::size_t{cluster.triangle_count} * 3u > _meshlet_triangles.size()) {
+      throw utility::runtime_error{"Mesh cache '{}' has a meshlet out of bounds", path.string()};
+    }
+  }
+}
+
+auto mesh_cache::is_up_to_date(const std::filesystem::path& path, const std::filesystem::path& source) -> bool {
+  auto error = std::error_code{};
+
+  if (!std::filesystem::exists(path, error) || !std::filesystem::exists(source, error)) {
+    return false;
+  }
+
+  auto file = std::ifstream{path, std::ios::binary};
+
+  auto header = mesh_cache_header{};
+
+  if (!file.read(reinterpret_cast<char*>(&header), sizeof(mesh_cache_header))) {
+    return false;
+  }
+
+  if (header.magic != mesh_cache_magic || header.version != mesh_cache_version || header.vertex_size != sizeof(vertex3d)) {
+    return false;
+  }
+
+  const auto stamp = make_source_stamp(source);
+
+  return header.source_size == stamp.size && header.source_time == stamp.time;
+}
+
+auto mesh_cache::write(const std::filesystem::path& path, const std::filesystem::path& source, const mesh_data& data, const meshlet_data& meshlets, const mesh_cache_compression compression) -> void {
+  if (meshlets.submeshes.size() != data.submeshes.size()) {
+    throw utility::runtime_error{"Mesh cache '{}' has {} meshlet ranges for {} submeshes", path.string(), meshlets.submeshes.size(), data.submeshes.size()};
+  }
+
+  auto names = std::string{};
+  auto submeshes = std::vector<mesh_cache_submesh>{};
+  submeshes.reserve(data.submeshes.size());
+
+  for (auto i = 0u; i < data.submeshes.size(); ++i) {
+    const auto& submesh = data.submeshes[i];
+    const auto name = submesh.name.str();
+
+    submeshes.push_back(mesh_cache_submesh{
+      .index_count = submesh.index_count,
+      .index_offset = submesh.index_offset,
+      .vertex_offset = submesh.vertex_offset,
+      .name_offset = static_cast<std::uint32_t>(names.size()),
+      .name_length = static_cast<std::uint32_t>(name.size()),
+      .bounds = submesh.bounds,
+      .local_transform = submesh.local_transform,
+      .lod_count = submesh.lod_count,
+      .lods = submesh.lods,
+      .meshlets = meshlets.submeshes[i]
+    });
+
+    names.append(name);
+  }
+
+  const auto stamp = make_source_stamp(source);
+
+  auto header = mesh_cache_header{};
+  header.magic = mesh_cache_magic;
+  header.version = mesh_cache_version;
+  header.compression = compression;
+  header.vertex_size = sizeof(vertex3d);
+  header.vertex_count = static_cast<std::uint32_t>(data.vertices.size());
+  header.index_count = static_cast<std::uint32_t>(data.indices.size());
+  header.submesh_count = static_cast<std::uint32_t>(submeshes.size());
+  header.source_size = stamp.size;
+  header.source_time = stamp.time;
+  header.name_size = static_cast<std::uint32_t>(names.size());
+  header.meshlet_count = static_cast<std::uint32_t>(meshlets.meshlets.size());
+  header.meshlet_vertex_count = static_cast<std::uint32_t>(meshlets.vertices.size());
+  header.meshlet_triangle_size = static_cast<std::uint32_t>(meshlets.triangles.size());
+
+  const auto layout = make_layout(header);
+
+  auto payload = std::vector<char>(layout.size, char{0});
+
+  std::memcpy(payload.data() + layout.vertices, data.vertices.data(), data.vertices.size() * sizeof(vertex3d));
+  std::memcpy(payload.data() + layout.indices, data.indices.data(), data.indices.size() * sizeof(std::uint32_t));
+  std::memcpy(payload.data() + layout.submeshes, submeshes.data(), submeshes.size() * sizeof(mesh_cache_submesh));
+  std::memcpy(payload.data() + layout.names, names.data(), names.size());
+  std::memcpy(payload.data() + layout.meshlets, meshlets.meshlets.data(), meshlets.meshlets.size() * sizeof(meshlet));
+  std::memcpy(payload.data() + layout.meshlet_bounds, meshlets.bounds.data(), meshlets.bounds.size() * sizeof(math::cluster_bounds));
+  std::memcpy(payload.data() + layout.meshlet_vertices, meshlets.vertices.data(), meshlets.vertices.size() * sizeof(std::uint32_t));
+  std::memcpy(payload.data() + layout.meshlet_triangles, meshlets.triangles.data(), meshlets.triangles.size());
+
+  if (compression == mesh_cache_compression::lz4) {
+    payload = utility::compressor::compress(payload);
+  }
+
+  header.payload_size = layout.size;
+  header.stored_size = payload.size();
+  header.checksum = checksum(payload);
+  header.header_checksum = header_checksum(header);
+
+  // Write to a temporary file first so a crash never leaves a truncated cache behind
+  auto temporary_path = path;
+  temporary_path += ".tmp";
+
+  {
+    auto file = std::ofstream{temporary_path, std::ios::binary | std::ios::trunc};
+
+    if (!file.is_open()) {
+      throw utility::runtime_error{"Failed to open mesh cache '{}' for writing", temporary_path.string()};
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(mesh_cache_header));
+    file.write(payload.data(), static_cast<std::streamsize>(payload.size()));
+
+    if (!file) {
+      throw utility::runtime_error{"Failed to write mesh cache '{}'", temporary_path.string()};
+    }
+  }
+
+  std::filesystem::rename(temporary_path, path);
+}
+
+auto mesh_cache::verify() const -> bool {
+  return checksum(stored_payload(_file, _header)) == _header.checksum;
+}
+
+auto mesh_cache::submeshes() const -> std::vector<graphics::submesh> {
+  auto result = std::vector<graphics::submesh>{};
+  result.reserve(_submeshes.size());
+
+  for (const auto& submesh : _submeshes) {
+    result.push_back(graphics::submesh{
+      .index_count = submesh.index_count,
+      .index_offset = submesh.index_offset,
+      .vertex_offset = submesh.vertex_offset,
+      .bounds = submesh.bounds,
+      .local_transform = submesh.local_transform,
+      .name = utility::hashed_string{std::string{_names.substr(submesh.name_offset, submesh.name_length)}},
+      .lod_count = submesh.lod_count,
+      .lods = submesh.lods
+    });
+  }
+
+  return result;
+}
+
+auto mesh_cache::meshlets() const -> meshlet_data {
+  auto result = meshlet_data{};
+
+  result.meshlets.assign(_meshlets.begin(), _meshlets.end());
+  result.bounds.assign(_meshlet_bounds.begin(), _meshlet_bounds.end());
+  result.vertices.assign(_meshlet_vertices.begin(), _meshlet_vertices.end());
+  result.triangles.assign(_meshlet_triangles.begin(), _meshlet_triangles.end());
+
+  result.submeshes.reserve(_submeshes.size());
+
+  for (const auto& submesh : _submeshes) {
+    result.submeshes.push_back(submesh.meshlets);
+  }
+
+  return result;
+}
+
+} // namespace sbx::models
@@ -0,0 +1,159 @@
+#ifndef LIBSBX_MODELS_MESH_CACHE_HPP_
+#define LIBSBX_MODELS_MESH_CACHE_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <span>
+#include <vector>
+#include <string_view>
+#include <filesystem>
+
+#include <libsbx/utility/noncopyable.hpp>
+#include <libsbx/utility/mapped_file.hpp>
+
+#include <libsbx/math/volume.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+
+#include <libsbx/graphics/pipeline/mesh.hpp>
+
+#include <libsbx/models/vertex3d.hpp>
+#include <libsbx/models/meshlet_builder.hpp>
+
+namespace sbx::models {
+
+/**
+ * @brief Binary cache of an imported mesh, stored next to the source file with the .sbxmsh extension.
+ *
+ * The file starts with a mesh_cache_header followed by the payload. The payload holds eight sections, each starting at a 16 byte aligned offset:
+ * vertices, indices, one mesh_cache_submesh per submesh, the character data of the submesh names, the meshlets, their bounds, their vertices
+ * and their triangles. Uncompressed payloads are used in place
+ * from the memory mapped file, LZ4 compressed payloads are decompressed once when the cache is opened.
+ *
+ * The header records the size and modification time of the source file, a cache is only used while both still match.
+ * Opening a cache verifies the checksums of the header and of the stored payload, both are 64-bit xxHash values.
+ * Data is stored in little endian byte order.
+ */
+inline constexpr auto mesh_cache_extension = std::string_view{".sbxmsh"};
+
+inline constexpr auto mesh_cache_magic = std::array<char, 8u>{'S', 'B', 'X', 'M', 'E', 'S', 'H', '\0'};
+
+inline constexpr auto mesh_cache_version = std::uint32_t{6u};
+
+enum class mesh_cache_compression : std::uint32_t {
+  none = 0u,
+  lz4 = 1u
+}; // enum class mesh_cache_compression
+
+struct mesh_cache_header {
+  std::array<char, 8u> magic;
+  std::uint32_t version;
+  mesh_cache_compression compression;
+  std::uint32_t vertex_size;
+  std::uint32_t vertex_count;
+  std::uint32_t index_count;
+  std::uint32_t submesh_count;
+  std::uint64_t source_size;
+  std::int64_t source_time;
+  // Size of the payload after decompression
+  std::uint64_t payload_size;
+  // Size of the payload as stored in the file
+  std::uint64_t stored_size;
+  // xxHash64 of the stored payload
+  std::uint64_t checksum;
+  // xxHash64 of the header with this field set to zero
+  std::uint64_t header_checksum;
+  std::uint32_t name_size;
+  std::uint32_t meshlet_count;
+  std::uint32_t meshlet_vertex_count;
+  // Size of the meshlet triangles in bytes
+  std::uint32_t meshlet_triangle_size;
+}; // struct mesh_cache_header
+
+static_assert(sizeof(mesh_cache_header) % 16u == 0u, "Payload has to start 16 byte aligned");
+
+struct mesh_cache_submesh {
+  std::uint32_t index_count;
+  std::uint32_t index_offset;
+  std::uint32_t vertex_offset;
+  std::uint32_t name_offset;
+  std::uint32_t name_length;
+  math::volume bounds;
+  math::matrix4x4 local_transform;
+  std::uint32_t lod_count;
+  std::array<graphics::submesh_lod, graphics::submesh::max_lod_count> lods;
+  meshlet_range meshlets;
+}; // struct mesh_cache_submesh
+
+/**
+ * @brief Read-only view of a .sbxmsh file.
+ *
+ * The constructor validates the header, the checksums and the section bounds and throws a utility::runtime_error if the file is malformed.
+ * Whether the cache still belongs to its source file is checked separately by is_up_to_date.
+ */
+class mesh_cache final : public utility::noncopyable {
+
+public:
+
+  using mesh_data = graphics::mesh<vertex3d>::mesh_data;
+
+  explicit mesh_cache(const std::filesystem::path& path);
+
+  mesh_cache(mesh_cache&& other) noexcept = default;
+
+  ~mesh_cache() = default;
+
+  auto operator=(mesh_cache&& other) noexcept -> mesh_cache& = default;
+
+  /**
+   * @brief Returns true if the cache at path exists, has the current version and matches the size and modification time of source.
+   *
+   * Only reads the header.
+   */
+  static auto is_up_to_date(const std::filesystem::path& path, const std::filesystem::path& source) -> bool;
+
+  /**
+   * @brief Writes the cache for data that was imported from source.
+   */
+  static auto write(const std::filesystem::path& path, const std::filesystem::path& source, const mesh_data& data, const meshlet_data& meshlets, const mesh_cache_compression compression = mesh_cache_compression::none) -> void;
+
+  auto vertices() const noexcept -> std::span<const vertex3d> {
+    return _vertices;
+  }
+
+  auto indices() const noexcept -> std::span<const std::uint32_t> {
+    return _indices;
+  }
+
+  auto submeshes() const -> std::vector<graphics::submesh>;
+
+  auto meshlets() const -> meshlet_data;
+
+  auto compression() const noexcept -> mesh_cache_compression {
+    return _header.compression;
+  }
+
+  /**
+   * @brief Returns true if the stored payload still matches its checksum, for example after the file was modified while it was mapped.
+   */
+  auto verify() const -> bool;
+
+private:
+
+  utility::mapped_file _file;
+  mesh_cache_header _header;
+  std::vector<char> _decompressed;
+  std::span<const vertex3d> _vertices;
+  std::span<const std::uint32_t> _indices;
+  std::span<const mesh_cache_submesh> _submeshes;
+  std::string_view _names;
+  std::span<const meshlet> _meshlets;
+  std::span<const math::cluster_bounds> _meshlet_bounds;
+  std::span<const std::uint32_t> _meshlet_vertices;
+  std::span<const std::uint8_t> _meshlet_triangles;
+
+}; // class mesh_cache
+
+} // namespace sbx::models
+
+#endif // LIBSBX_MODELS_MESH_CACHE_HPP_
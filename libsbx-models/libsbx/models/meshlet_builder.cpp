@@ -0,0 +1,56 @@
+#include <libsbx/models/meshlet_builder.hpp>
+
+#include <meshoptimizer.h>
+
+namespace sbx::models {
+
+auto build_meshlets(std::span<const std::uint32_t> indices, std::span<const vertex3d> vertices, meshlet_data& data, const meshlet_settings& settings) -> void {
+  auto range = meshlet_range{static_cast<std::uint32_t>(data.meshlets.size()), 0u};
+
+  if (indices.empty() || vertices.empty()) {
+    data.submeshes.push_back(range);
+    return;
+  }
+
+  const auto* positions = &vertices[0].position.x();
+
+  const auto max_meshlets = meshopt_buildMeshletsBound(indices.size(), settings.max_vertices, settings.max_triangles);
+
+  auto meshlets = std::vector<meshopt_Meshlet>(max_meshlets);
+  auto meshlet_vertices = std::vector<std::uint32_t>(max_meshlets * settings.max_vertices);
+  auto meshlet_triangles = std::vector<std::uint8_t>(max_meshlets * settings.max_triangles * 3u);
+
+  const auto count = meshopt_buildMeshlets(meshlets.data(), meshlet_vertices.data(), meshlet_triangles.data(), indices.data(), indices.size(), positions, vertices.size(), sizeof(vertex3d), settings.max_vertices, settings.max_triangles, settings.cone_weight);
+
+  for (auto i = 0u; i < count; ++i) {
+    const auto& source = meshlets[i];
+
+    // Improves the vertex reuse inside of the meshlet, the meshlet itself keeps its triangles
+    meshopt_optimizeMeshlet(&meshlet_vertices[source.vertex_offset], &meshlet_triangles[source.triangle_offset], source.triangle_count, source.vertex_count);
+
+    const auto bounds = meshopt_computeMeshletBounds(&meshlet_vertices[source.vertex_offset], &meshlet_triangles[source.triangle_offset], source.triangle_count, positions, vertices.size(), sizeof(vertex3d));
+
+    data.meshlets.push_back(meshlet{
+      .vertex_offset = static_cast<std::uint32_t>(data.vertices.size()),
+      .triangle_offset = static_cast<std::uint32_t>(data.triangles.size()),
+      .vertex_count = source.vertex_count,
+      .triangle_count = source.triangle_count
+    });
+
+    data.bounds.push_back(math::cluster_bounds{
+      .center = math::vector3{bounds.center[0], bounds.center[1], bounds.center[2]},
+      .radius = bounds.radius,
+      .cone_axis = math::vector3{bounds.cone_axis[0], bounds.cone_axis[1], bounds.cone_axis[2]},
+      .cone_cutoff = bounds.cone_cutoff
+    });
+
+    data.vertices.insert(data.vertices.end(), meshlet_vertices.begin() + source.vertex_offset, meshlet_vertices.begin() + source.vertex_offset + source.vertex_count);
+    data.triangles.insert(data.triangles.end(), meshlet_triangles.begin() + source.triangle_offset, meshlet_triangles.begin() + source.triangle_offset + source.triangle_count * 3u);
+  }
+
+  range.count = static_cast<std::uint32_t>(count);
+
+  data.submeshes.push_back(range);
+}
+
+} // namespace sbx::models
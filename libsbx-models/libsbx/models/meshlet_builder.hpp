@@ -0,0 +1,67 @@
+#ifndef LIBSBX_MODELS_MESHLET_BUILDER_HPP_
+#define LIBSBX_MODELS_MESHLET_BUILDER_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include <libsbx/math/cluster_culler.hpp>
+
+#include <libsbx/models/vertex3d.hpp>
+
+namespace sbx::models {
+
+struct meshlet_settings {
+  // Limits of the mesh shading hardware, 64 and 124 fit the output arrays of most implementations
+  std::uint32_t max_vertices{64u};
+  std::uint32_t max_triangles{124u};
+  // Between 0 and 1, higher values give tighter normal cones at the cost of larger bounding spheres
+  std::float_t cone_weight{0.25f};
+}; // struct meshlet_settings
+
+/**
+ * @brief A cluster of at most meshlet_settings::max_triangles triangles that reference at most meshlet_settings::max_vertices vertices.
+ */
+struct meshlet {
+  // First entry of the meshlet in meshlet_data::vertices
+  std::uint32_t vertex_offset;
+  // First entry of the meshlet in meshlet_data::triangles
+  std::uint32_t triangle_offset;
+  std::uint32_t vertex_count;
+  std::uint32_t triangle_count;
+}; // struct meshlet
+
+struct meshlet_range {
+  std::uint32_t offset;
+  std::uint32_t count;
+}; // struct meshlet_range
+
+/**
+ * @brief Meshlets of all submeshes of a mesh.
+ *
+ * Entries of vertices are indices into the vertices of the submesh, just like the indices of the mesh. Every triangle is stored as three
+ * bytes in triangles, each indexing into the vertices of its meshlet. bounds holds the culling data of every meshlet in mesh space.
+ */
+struct meshlet_data {
+  std::vector<meshlet> meshlets;
+  std::vector<math::cluster_bounds> bounds;
+  std::vector<std::uint32_t> vertices;
+  std::vector<std::uint8_t> triangles;
+  // Meshlets of every submesh, in the order of the submeshes
+  std::vector<meshlet_range> submeshes;
+}; // struct meshlet_data
+
+/**
+ * @brief Splits the triangles of one submesh into meshlets and appends them to data, together with a new entry in data.submeshes.
+ *
+ * @param indices Triangle list indices into vertices.
+ * @param vertices Vertices of the submesh.
+ * @param data Meshlets of the mesh so far.
+ * @param settings Limits of a meshlet.
+ */
+auto build_meshlets(std::span<const std::uint32_t> indices, std::span<const vertex3d> vertices, meshlet_data& data, const meshlet_settings& settings = meshlet_settings{}) -> void;
+
+} // namespace sbx::models
+
+#endif // LIBSBX_MODELS_MESHLET_BUILDER_HPP_
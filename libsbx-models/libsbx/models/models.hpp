@@ -5,8 +5,13 @@
 
 #include <libsbx/models/vertex3d.hpp>
 #include <libsbx/models/mesh.hpp>
+#include <libsbx/models/mesh_cache.hpp>
+#include <libsbx/models/lod_builder.hpp>
+#include <libsbx/models/lod_selector.hpp>
+#include <libsbx/models/meshlet_builder.hpp>
 
 #include <libsbx/models/material_draw_list.hpp>
+#include <libsbx/models/visibility_culler.hpp>
 #include <libsbx/models/static_mesh_subrenderer.hpp>
 
 #endif // LIBSBX_MODELS_HPP_
@@ -65,6 +65,8 @@
 #include <libsbx/models/mesh.hpp>
 #include <libsbx/models/material.hpp>
 #include <libsbx/models/material_draw_list.hpp>
+#include <libsbx/models/visibility_culler.hpp>
+#include <libsbx/models/lod_selector.hpp>
 
 namespace sbx::models {
 
@@ -75,34 +77,72 @@ struct static_mesh_traits {
   struct instance_payload { };
 
   template<typename DarwList>
-  static auto create_shared_buffers([[maybe_unused]] DarwList& draw_list) -> void {
+  auto create_shared_buffers([[maybe_unused]] DarwList& draw_list) -> void {
 
   }
 
   template<typename DarwList>
-  static auto destroy_shared_buffers([[maybe_unused]] DarwList& draw_list) -> void {
+  auto destroy_shared_buffers([[maybe_unused]] DarwList& draw_list) -> void {
 
   }
 
   template<typename DarwList>
-  static auto update_shared_buffers([[maybe_unused]] DarwList& draw_list) -> void {
+  auto update_shared_buffers([[maybe_unused]] DarwList& draw_list) -> void {
 
   }
 
+  auto prepare(scenes::scene& scene) -> void {
+    auto& assets_module = core::engine::get_module<assets::assets_module>();
+
+    auto group = scene.group<component_type>(ecs::get<const scenes::selection_tag>);
+
+    _candidates.clear();
+    _culler.begin(scene);
+    _lod_selector.begin(scene);
+
+    for (auto&& [node, component, selection_tag] : group.each()) {
+      const auto& world = scene.world(node);
+      const auto& mesh = assets_module.get_asset<mesh_type>(component.mesh_id());
+
+      _culler.push_back(mesh.bounds(), world.model);
+      _candidates.push_back(candidate{node, &component, &world, &selection_tag, &mesh});
+    }
+  }
+
   template<class Callable>
-  static void for_each_submission(scenes::scene& scene, Callable&& callable) {
-    auto query = scene.query<const component_type, const scenes::selection_tag>();
+  auto for_each_submission(Callable&& callable) -> void {
+    _culler.cull();
 
-    for (auto&& [node, component, selection_tag] : query.each()) {
-      const auto transform_data = models::transform_data{ scene.world_transform(node), scene.world_normal(node) };
+    for (const auto& [index, entry] : ranges::views::enumerate(_candidates)) {
+      const auto is_visible = _culler.is_visible(index);
 
-      for (const auto& submesh : component.submeshes()) {
-        std::invoke(callable, component, component.mesh_id(), submesh.index, submesh.material, transform_data, selection_tag, instance_payload{});
+      for (const auto& submesh : entry.component->submeshes()) {
+        // Instances outside of the view still cast shadows into it, so they are selected by their distance to the camera as well. This
+        // keeps their level while they cross the border of the view and avoids popping shadows of close casters
+        const auto lod = _lod_selector.select(lod_selector::make_key(static_cast<std::uint32_t>(entry.node), submesh.index), entry.mesh->submesh(submesh.index), entry.world->model);
+
+        std::invoke(callable, *entry.component, entry.node, *entry.world, entry.component->mesh_id(), submesh.index, lod, submesh.material, *entry.selection_tag, is_visible, instance_payload{});
       }
     }
+
+    _lod_selector.end();
+  }
+
+  /**
+   * @brief Culls the static meshes of the active camera. Occlusion culling is disabled by default.
+   */
+  auto culler() -> visibility_culler& {
+    return _culler;
   }
 
-  static auto make_instance_data(std::uint32_t transform_index, std::uint32_t material_index, const scenes::selection_tag& selection_tag, const instance_payload& payload) -> instance_data {
+  /**
+   * @brief Selects the levels of detail of the static meshes of the active camera.
+   */
+  auto lod_selector() -> models::lod_selector& {
+    return _lod_selector;
+  }
+
+  auto make_instance_data(std::uint32_t transform_index, std::uint32_t material_index, const scenes::selection_tag& selection_tag, const instance_payload& payload) -> instance_data {
     auto [entry, created] = _selection_tags.try_emplace(selection_tag, 0u);
 
     if (created && selection_tag != scenes::selection_tag::null) {
@@ -114,7 +154,18 @@ struct static_mesh_traits {
 
 private:
 
-  inline static auto _selection_tags = std::unordered_map<scenes::selection_tag, std::uint32_t>{};
+  struct candidate {
+    scenes::node node;
+    const component_type* component;
+    const scenes::global_transform* world;
+    const scenes::selection_tag* selection_tag;
+    const mesh_type* mesh;
+  }; // struct candidate
+
+  std::unordered_map<scenes::selection_tag, std::uint32_t> _selection_tags;
+  std::vector<candidate> _candidates;
+  visibility_culler _culler;
+  models::lod_selector _lod_selector;
 
 }; // static_mesh_traits
 
@@ -137,10 +188,38 @@ public:
   static_mesh_subrenderer(const graphics::render_graph::graphics_pass& pass, const std::filesystem::path& base_pipeline, const static_mesh_material_draw_list::bucket bucket)
   : graphics::subrenderer{pass},
     _base_pipeline{base_pipeline},
-    _bucket{bucket} { }
+    _bucket{bucket} {
+    auto& graphics_module = core::engine::get_module<graphics::graphics_module>();
 
-  ~static_mesh_subrenderer() override {
-    _pipeline_cache.clear();
+    auto requests = std::vector<graphics::compiler::compile_request>{};
+    requests.reserve(_entry_point.size());
+
+    for (const auto& entry_point : _entry_point) {
+      requests.push_back(graphics::compiler::compile_request{
+        .path = _base_pipeline,
+        .per_stage = {
+          {SLANG_STAGE_VERTEX, {.entry_point = "static_main"}},
+          {SLANG_STAGE_FRAGMENT, {.entry_point = entry_point}}
+        }
+      });
+    }
+
+    // The alpha mode variants are independent, so they are compiled in parallel up front instead of one by one on first use
+    _compiled_shaders = graphics_module.compiler().compile(requests);
+  }
+
+  ~static_mesh_subrenderer() override = default;
+
+  auto is_thread_safe() const noexcept -> bool override {
+    return true;
+  }
+
+  auto prepare() -> void override {
+    auto& draw_list = pass().draw_list<models::static_mesh_material_draw_list>("static_mesh_material");
+
+    for (const auto& [key, data] : draw_list.ranges(_bucket)) {
+      _get_or_create_pipeline(key, pass());
+    }
   }
 
   auto render(graphics::command_buffer& command_buffer) -> void override {
@@ -158,15 +237,16 @@ public:
     auto& draw_list = pass().draw_list<models::static_mesh_material_draw_list>("static_mesh_material");
 
     for (auto& [key, data] : draw_list.ranges(_bucket)) {
-      auto& pipeline_data = _get_or_create_pipeline(key, pass());
+      // Created in prepare, render may run on a worker thread
+      auto& pipeline_data = _pipeline_cache.at(key);
 
       auto& pipeline = graphics_module.get_resource<graphics::graphics_pipeline>(pipeline_data.pipeline);
 
       pipeline.bind(command_buffer);
 
-      pipeline_data.scene_descriptor_handler.push("scene", scene.uniform_handler());
-      pipeline_data.scene_descriptor_handler.push("images_sampler", draw_list.sampler());
-      pipeline_data.scene_descriptor_handler.push("images", draw_list.images());
+      pipeline_data.scene_descriptor_handler.push(pipeline_data.scene_slot, scene.uniform_handler());
+      pipeline_data.scene_descriptor_handler.push(pipeline_data.images_sampler_slot, draw_list.sampler());
+      pipeline_data.scene_descriptor_handler.push(pipeline_data.images_slot, draw_list.images());
 
       if (!pipeline_data.scene_descriptor_handler.update(pipeline)) {
         return;
@@ -184,7 +264,7 @@ public:
 
       const auto hash = material_key_hash{}(key);
 
-      for (const auto& [mesh_id, range] : data.ranges) {
+      for (const auto& [mesh_id, range, draw_count_index] : data.ranges) {
         auto& mesh = assets_module.get_asset<models::mesh>(mesh_id);
         
         mesh.bind(command_buffer);
@@ -195,7 +275,13 @@ public:
 
         auto& draw_commands_buffer = graphics_module.get_resource<graphics::storage_buffer>(data.draw_commands_buffer);
 
-        command_buffer.draw_indexed_indirect(draw_commands_buffer, range.offset, range.count);
+        if (data.draw_count_buffer) {
+          auto& draw_count_buffer = graphics_module.get_resource<graphics::storage_buffer>(data.draw_count_buffer);
+
+          command_buffer.draw_indexed_indirect_count(draw_commands_buffer, range.offset, draw_count_buffer, draw_count_index, range.count);
+        } else {
+          command_buffer.draw_indexed_indirect(draw_commands_buffer, range.offset, range.count);
+        }
       }
     }
   }
@@ -207,11 +293,17 @@ private:
     graphics::graphics_pipeline_handle pipeline;
     graphics::push_handler push_handler;
     graphics::descriptor_handler scene_descriptor_handler;
+    graphics::descriptor_handler::binding_slot scene_slot;
+    graphics::descriptor_handler::binding_slot images_sampler_slot;
+    graphics::descriptor_handler::binding_slot images_slot;
 
     pipeline_data(const graphics::graphics_pipeline_handle& handle)
     : pipeline{handle},
       push_handler{pipeline},
-      scene_descriptor_handler{pipeline, 0u} { }
+      scene_descriptor_handler{pipeline, 0u},
+      scene_slot{scene_descriptor_handler.slot("scene")},
+      images_sampler_slot{scene_descriptor_handler.slot("images_sampler")},
+      images_slot{scene_descriptor_handler.slot("images")} { }
 
   }; // struct pipeline_data
 
@@ -227,17 +319,7 @@ private:
     definition.rasterization_state.cull_mode = key.is_double_sided ? graphics::cull_mode::none : graphics::cull_mode::back;
     definition.uses_transparency = (static_cast<alpha_mode>(key.alpha) == alpha_mode::blend);
 
-    auto& compiler = graphics_module.compiler();
-
-    const auto request = graphics::compiler::compile_request{
-      .path = _base_pipeline,
-      .per_stage = {
-        {SLANG_STAGE_VERTEX, { .entry_point = "static_main" }},
-        {SLANG_STAGE_FRAGMENT, { .entry_point = _entry_point.at(key.alpha) }}
-      }
-    };
-
-    const auto result = compiler.compile(request);
+    const auto& result = _compiled_shaders.at(key.alpha);
 
     auto compiled_shaders = graphics::graphics_pipeline::compiled_shaders{_base_pipeline.filename().string(), result.code};
 
@@ -256,8 +338,8 @@ private:
 
   std::filesystem::path _base_pipeline;
   static_mesh_material_draw_list::bucket _bucket;
-
-  inline static auto _pipeline_cache = std::unordered_map<material_key, pipeline_data, material_key_hash>{};
+  std::vector<graphics::compiler::compile_result> _compiled_shaders;
+  std::unordered_map<material_key, pipeline_data, material_key_hash> _pipeline_cache;
 
 }; // class static_mesh_subrenderer
 
@@ -0,0 +1,71 @@
+#include <libsbx/models/visibility_culler.hpp>
+
+#include <easy/profiler.h>
+
+#include <libsbx/scenes/components/camera.hpp>
+#include <libsbx/scenes/components/occluder.hpp>
+
+namespace sbx::models {
+
+visibility_culler::visibility_culler()
+: _is_occlusion_enabled{false},
+  _frustum_culler{math::box{}} { }
+
+auto visibility_culler::begin(scenes::scene& scene) -> void {
+  EASY_FUNCTION();
+
+  _bounds.clear();
+  _instances.clear();
+  _visible.clear();
+  _is_visible.clear();
+
+  const auto camera_node = scene.camera();
+
+  const auto view = math::matrix4x4::inverted(scene.world_transform(camera_node));
+
+  const auto& camera = scene.get_component<scenes::camera>(camera_node);
+
+  _frustum_culler = math::frustum_culler{camera.view_frustum(view)};
+
+  if (!_is_occlusion_enabled) {
+    return;
+  }
+
+  _occlusion_buffer.clear(camera.projection() * view);
+
+  auto occluders = scene.query<const scenes::occluder>();
+
+  for (auto&& [node, occluder] : occluders.each()) {
+    _occlusion_buffer.rasterize(occluder.local, scene.world(node).model);
+  }
+}
+
+auto visibility_culler::push_back(const math::volume& local, const math::matrix4x4& model) -> void {
+  _bounds.push_back(local, model);
+
+  if (_is_occlusion_enabled) {
+    _instances.push_back(instance{local, &model});
+  }
+}
+
+auto visibility_culler::cull() -> void {
+  EASY_FUNCTION();
+
+  _frustum_culler.cull(_bounds, _visible);
+
+  if (_is_occlusion_enabled) {
+    std::erase_if(_visible, [this](const std::uint32_t index) {
+      const auto& instance = _instances[index];
+
+      return !_occlusion_buffer.is_visible(math::volume::transformed(instance.local, *instance.model));
+    });
+  }
+
+  _is_visible.assign(_bounds.size(), 0u);
+
+  for (const auto index : _visible) {
+    _is_visible[index] = 1u;
+  }
+}
+
+} // namespace sbx::models
@@ -0,0 +1,79 @@
+#ifndef LIBSBX_MODELS_VISIBILITY_CULLER_HPP_
+#define LIBSBX_MODELS_VISIBILITY_CULLER_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include <libsbx/math/volume.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+#include <libsbx/math/frustum_culler.hpp>
+#include <libsbx/math/occlusion_buffer.hpp>
+
+#include <libsbx/scenes/scene.hpp>
+
+namespace sbx::models {
+
+/**
+ * @brief Decides which instances of a frame can be seen from the active camera of a scene.
+ *
+ * Instances are first tested against the view frustum eight at a time. If occlusion culling is enabled the nodes with a scenes::occluder are
+ * rasterized into a small depth buffer and every instance that survived the frustum test is tested against it.
+ *
+ * Usage per frame: begin, push_back for every instance, cull and then is_visible with the index of the push.
+ */
+class visibility_culler {
+
+public:
+
+  visibility_culler();
+
+  auto is_occlusion_enabled() const noexcept -> bool {
+    return _is_occlusion_enabled;
+  }
+
+  auto set_occlusion_enabled(const bool is_enabled) noexcept -> void {
+    _is_occlusion_enabled = is_enabled;
+  }
+
+  auto begin(scenes::scene& scene) -> void;
+
+  /**
+   * @brief Adds an instance with bounds in local space. The matrix has to outlive the call to cull.
+   */
+  auto push_back(const math::volume& local, const math::matrix4x4& model) -> void;
+
+  auto cull() -> void;
+
+  auto is_visible(const std::size_t index) const noexcept -> bool {
+    return _is_visible[index] != 0u;
+  }
+
+  auto size() const noexcept -> std::size_t {
+    return _bounds.size();
+  }
+
+  auto visible_count() const noexcept -> std::size_t {
+    return _visible.size();
+  }
+
+private:
+
+  struct instance {
+    math::volume local;
+    const math::matrix4x4* model;
+  }; // struct instance
+
+  bool _is_occlusion_enabled;
+  math::frustum_culler _frustum_culler;
+  math::occlusion_buffer _occlusion_buffer;
+
+  math::bounds_set _bounds;
+  std::vector<instance> _instances;
+  std::vector<std::uint32_t> _visible;
+  std::vector<std::uint8_t> _is_visible;
+
+}; // class visibility_culler
+
+} // namespace sbx::models
+
+#endif // LIBSBX_MODELS_VISIBILITY_CULLER_HPP_
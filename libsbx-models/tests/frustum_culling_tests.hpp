@@ -0,0 +1,302 @@
+#ifndef LIBSBX_MODELS_FRUSTUM_CULLING_TESTS_HPP_
+#define LIBSBX_MODELS_FRUSTUM_CULLING_TESTS_HPP_
+
+#include <array>
+#include <vector>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+
+#include <gtest/gtest.h>
+
+#include <vulkan/vulkan.h>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/vector4.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+
+#include <libsbx/models/frustum_culling_task.hpp>
+#include <libsbx/models/material_draw_list.hpp>
+
+#include <graphics_tests/headless_device.hpp>
+
+namespace frustum_culling_tests {
+
+using graphics_tests::headless_device;
+
+// Mirrors the push constants of the culling shader
+struct push_data {
+  VkDeviceAddress source_commands;
+  VkDeviceAddress source_instances;
+  VkDeviceAddress cull_instances;
+  VkDeviceAddress cull_commands;
+  VkDeviceAddress scratch_commands;
+  VkDeviceAddress culled_commands;
+  VkDeviceAddress culled_instances;
+  VkDeviceAddress draw_counts;
+  VkDeviceAddress transforms;
+  VkDeviceAddress frustum;
+  std::uint32_t phase;
+  std::uint32_t count;
+}; // struct push_data
+
+inline auto read_binary(const std::filesystem::path& path) -> std::vector<std::uint32_t> {
+  auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+
+  const auto size = static_cast<std::size_t>(file.tellg());
+
+  auto code = std::vector<std::uint32_t>(size / sizeof(std::uint32_t));
+
+  file.seekg(0);
+  file.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(size));
+
+  return code;
+}
+
+template<typename Type>
+inline auto read(const headless_device::buffer& buffer, const std::size_t count) -> std::vector<Type> {
+  auto result = std::vector<Type>(count);
+  std::memcpy(result.data(), buffer.mapped, count * sizeof(Type));
+  return result;
+}
+
+/**
+ * @brief The buffers of one batch, created on the headless device instead of through the graphics module.
+ */
+struct batch {
+  headless_device::buffer source_commands;
+  headless_device::buffer source_instances;
+  headless_device::buffer cull_instances;
+  headless_device::buffer cull_commands;
+  headless_device::buffer scratch_commands;
+  headless_device::buffer culled_commands;
+  headless_device::buffer culled_instances;
+  headless_device::buffer draw_counts;
+  headless_device::buffer transforms;
+  headless_device::buffer frustum;
+  std::uint32_t instance_count;
+  std::uint32_t command_count;
+  std::uint32_t range_count;
+}; // struct batch
+
+/**
+ * @brief Records the steps of sbx::models::record_frustum_culling with plain Vulkan commands.
+ */
+struct batch_recorder {
+
+  auto fill_draw_counts(const batch& batch) -> void {
+    vkCmdFillBuffer(command_buffer, batch.draw_counts.handle, 0u, batch.range_count * sizeof(std::uint32_t), 0u);
+  }
+
+  auto barrier(const VkPipelineStageFlags2 src_stage, const VkAccessFlags2 src_access, const VkPipelineStageFlags2 dst_stage, const VkAccessFlags2 dst_access) -> void {
+    graphics_tests::memory_barrier(command_buffer, src_stage, src_access, dst_stage, dst_access);
+  }
+
+  auto bind_pipeline() -> void {
+    vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+  }
+
+  auto dispatch(const batch& batch, const sbx::models::frustum_culling_phase phase, const std::uint32_t count, const std::uint32_t group_count) -> void {
+    const auto push = push_data{
+      .source_commands = batch.source_commands.address,
+      .source_instances = batch.source_instances.address,
+      .cull_instances = batch.cull_instances.address,
+      .cull_commands = batch.cull_commands.address,
+      .scratch_commands = batch.scratch_commands.address,
+      .culled_commands = batch.culled_commands.address,
+      .culled_instances = batch.culled_instances.address,
+      .draw_counts = batch.draw_counts.address,
+      .transforms = batch.transforms.address,
+      .frustum = batch.frustum.address,
+      .phase = std::to_underlying(phase),
+      .count = count
+    };
+
+    vkCmdPushConstants(command_buffer, pipeline_layout, VK_SHADER_STAGE_COMPUTE_BIT, 0u, sizeof(push_data), &push);
+    vkCmdDispatch(command_buffer, group_count, 1u, 1u);
+  }
+
+  VkCommandBuffer command_buffer;
+  VkPipeline pipeline;
+  VkPipelineLayout pipeline_layout;
+
+}; // struct batch_recorder
+
+} // namespace frustum_culling_tests
+
+TEST(libsbx_models_frustum_culling, layouts_match_the_shader) {
+  EXPECT_EQ(sizeof(sbx::models::frustum_culling_task::cull_instance), 32u);
+  EXPECT_EQ(sizeof(sbx::models::frustum_culling_task::cull_command), 16u);
+  EXPECT_EQ(sizeof(sbx::models::instance_data), 16u);
+  EXPECT_EQ(sizeof(sbx::models::transform_data), 128u);
+  EXPECT_EQ(sizeof(frustum_culling_tests::push_data), 88u);
+}
+
+TEST(libsbx_models_frustum_culling, compacts_visible_draws) {
+  using namespace frustum_culling_tests;
+
+  using cull_instance = sbx::models::frustum_culling_task::cull_instance;
+  using cull_command = sbx::models::frustum_culling_task::cull_command;
+
+  auto device = headless_device{};
+
+  if (!device.is_valid()) {
+    GTEST_SKIP() << "No Vulkan 1.3 device available";
+  }
+
+  const auto shader_path = std::filesystem::path{SBX_FRUSTUM_CULLING_SHADER};
+
+  ASSERT_TRUE(std::filesystem::exists(shader_path));
+
+  // Two ranges laid out like a material draw list does: range 0 holds commands 0 and 1, range 1 holds command 2 and the shadow only command 3
+  const auto source_commands = std::array<VkDrawIndexedIndirectCommand, 4u>{
+    VkDrawIndexedIndirectCommand{36u, 2u, 0u, 0, 0u},
+    VkDrawIndexedIndirectCommand{12u, 1u, 36u, 8, 2u},
+    VkDrawIndexedIndirectCommand{6u, 2u, 48u, 16, 3u},
+    VkDrawIndexedIndirectCommand{6u, 1u, 48u, 16, 5u}
+  };
+
+  const auto source_instances = std::array<sbx::models::instance_data, 6u>{
+    sbx::models::instance_data{0u, 0u, 10u, 0u},
+    sbx::models::instance_data{1u, 0u, 11u, 0u},
+    sbx::models::instance_data{1u, 0u, 12u, 0u},
+    sbx::models::instance_data{0u, 1u, 13u, 0u},
+    sbx::models::instance_data{0u, 1u, 14u, 0u},
+    sbx::models::instance_data{1u, 1u, 15u, 0u}
+  };
+
+  // Transform 0 is inside of the frustum, transform 1 far outside of it
+  const auto transforms = std::array<sbx::models::transform_data, 2u>{
+    sbx::models::transform_data{sbx::math::matrix4x4::identity, sbx::math::matrix4x4::identity},
+    sbx::models::transform_data{sbx::math::matrix4x4::translated(sbx::math::matrix4x4::identity, sbx::math::vector3{1000.0f, 0.0f, 0.0f}), sbx::math::matrix4x4::identity}
+  };
+
+  const auto min = sbx::math::vector3{-1.0f, -1.0f, -1.0f};
+  const auto max = sbx::math::vector3{1.0f, 1.0f, 1.0f};
+
+  const auto cull_instances = std::array<cull_instance, 5u>{
+    cull_instance{min, 0u, max, 0u},
+    cull_instance{min, 0u, max, 1u},
+    cull_instance{min, 1u, max, 2u},
+    cull_instance{min, 2u, max, 3u},
+    cull_instance{min, 2u, max, 4u}
+  };
+
+  const auto cull_commands = std::array<cull_command, 3u>{
+    cull_command{0u, 0u, 0u, 0u},
+    cull_command{1u, 0u, 0u, 0u},
+    cull_command{2u, 1u, 2u, 0u}
+  };
+
+  // A box of size 20 around the origin, the planes point inwards
+  const auto planes = std::array<sbx::math::vector4, 6u>{
+    sbx::math::vector4{1.0f, 0.0f, 0.0f, 10.0f},
+    sbx::math::vector4{-1.0f, 0.0f, 0.0f, 10.0f},
+    sbx::math::vector4{0.0f, 1.0f, 0.0f, 10.0f},
+    sbx::math::vector4{0.0f, -1.0f, 0.0f, 10.0f},
+    sbx::math::vector4{0.0f, 0.0f, 1.0f, 10.0f},
+    sbx::math::vector4{0.0f, 0.0f, -1.0f, 10.0f}
+  };
+
+  static constexpr auto range_count = 2u;
+
+  const auto batches = std::array<batch, 1u>{
+    batch{
+      .source_commands = device.create_buffer(sizeof(source_commands), source_commands.data()),
+      .source_instances = device.create_buffer(sizeof(source_instances), source_instances.data()),
+      .cull_instances = device.create_buffer(sizeof(cull_instances), cull_instances.data()),
+      .cull_commands = device.create_buffer(sizeof(cull_commands), cull_commands.data()),
+      .scratch_commands = device.create_buffer(sizeof(source_commands)),
+      .culled_commands = device.create_buffer(sizeof(source_commands)),
+      .culled_instances = device.create_buffer(sizeof(source_instances)),
+      .draw_counts = device.create_buffer(range_count * sizeof(std::uint32_t)),
+      .transforms = device.create_buffer(sizeof(transforms), transforms.data()),
+      .frustum = device.create_buffer(sizeof(planes), planes.data()),
+      .instance_count = static_cast<std::uint32_t>(cull_instances.size()),
+      .command_count = static_cast<std::uint32_t>(cull_commands.size()),
+      .range_count = range_count
+    }
+  };
+
+  const auto& results = batches[0u];
+
+  const auto code = read_binary(shader_path);
+
+  auto shader_module_create_info = VkShaderModuleCreateInfo{};
+  shader_module_create_info.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+  shader_module_create_info.codeSize = code.size() * sizeof(std::uint32_t);
+  shader_module_create_info.pCode = code.data();
+
+  auto shader_module = VkShaderModule{};
+  ASSERT_EQ(vkCreateShaderModule(device.handle(), &shader_module_create_info, nullptr, &shader_module), VK_SUCCESS);
+
+  auto push_constant_range = VkPushConstantRange{};
+  push_constant_range.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+  push_constant_range.size = sizeof(push_data);
+
+  auto pipeline_layout_create_info = VkPipelineLayoutCreateInfo{};
+  pipeline_layout_create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+  pipeline_layout_create_info.pushConstantRangeCount = 1u;
+  pipeline_layout_create_info.pPushConstantRanges = &push_constant_range;
+
+  auto pipeline_layout = VkPipelineLayout{};
+  ASSERT_EQ(vkCreatePipelineLayout(device.handle(), &pipeline_layout_create_info, nullptr, &pipeline_layout), VK_SUCCESS);
+
+  auto pipeline_create_info = VkComputePipelineCreateInfo{};
+  pipeline_create_info.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+  pipeline_create_info.stage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+  pipeline_create_info.stage.stage = VK_SHADER_STAGE_COMPUTE_BIT;
+  pipeline_create_info.stage.module = shader_module;
+  pipeline_create_info.stage.pName = "main";
+  pipeline_create_info.layout = pipeline_layout;
+
+  auto pipeline = VkPipeline{};
+  ASSERT_EQ(vkCreateComputePipelines(device.handle(), VK_NULL_HANDLE, 1u, &pipeline_create_info, nullptr, &pipeline), VK_SUCCESS);
+
+  device.submit([&](VkCommandBuffer command_buffer) {
+    auto recorder = batch_recorder{command_buffer, pipeline, pipeline_layout};
+
+    sbx::models::record_frustum_culling(batches, recorder);
+
+    // Makes the results of the last phase visible to the host
+    recorder.barrier(VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT, VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT, VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_HOST_READ_BIT);
+  });
+
+  const auto draw_counts = read<std::uint32_t>(results.draw_counts, range_count);
+
+  // Command 1 lost its only instance, so each range draws a single command
+  EXPECT_EQ(draw_counts[0u], 1u);
+  EXPECT_EQ(draw_counts[1u], 1u);
+
+  const auto culled_commands = read<VkDrawIndexedIndirectCommand>(results.culled_commands, source_commands.size());
+
+  EXPECT_EQ(culled_commands[0u].indexCount, 36u);
+  EXPECT_EQ(culled_commands[0u].instanceCount, 1u);
+  EXPECT_EQ(culled_commands[0u].firstIndex, 0u);
+  EXPECT_EQ(culled_commands[0u].vertexOffset, 0);
+  EXPECT_EQ(culled_commands[0u].firstInstance, 0u);
+
+  EXPECT_EQ(culled_commands[2u].indexCount, 6u);
+  EXPECT_EQ(culled_commands[2u].instanceCount, 2u);
+  EXPECT_EQ(culled_commands[2u].firstIndex, 48u);
+  EXPECT_EQ(culled_commands[2u].vertexOffset, 16);
+  EXPECT_EQ(culled_commands[2u].firstInstance, 3u);
+
+  const auto culled_instances = read<sbx::models::instance_data>(results.culled_instances, source_instances.size());
+
+  EXPECT_EQ(culled_instances[0u], source_instances[0u]);
+
+  // Instances of a command are appended in any order
+  auto object_ids = std::vector<std::uint32_t>{culled_instances[3u].object_id, culled_instances[4u].object_id};
+  std::ranges::sort(object_ids);
+
+  EXPECT_EQ(object_ids, (std::vector<std::uint32_t>{13u, 14u}));
+
+  vkDestroyPipeline(device.handle(), pipeline, nullptr);
+  vkDestroyPipelineLayout(device.handle(), pipeline_layout, nullptr);
+  vkDestroyShaderModule(device.handle(), shader_module, nullptr);
+}
+
+#endif // LIBSBX_MODELS_FRUSTUM_CULLING_TESTS_HPP_
@@ -0,0 +1,136 @@
+#ifndef LIBSBX_MODELS_LOD_SELECTOR_TESTS_HPP_
+#define LIBSBX_MODELS_LOD_SELECTOR_TESTS_HPP_
+
+#include <cstdint>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/math/vector3.hpp>
+#include <libsbx/math/matrix4x4.hpp>
+
+#include <libsbx/models/lod_selector.hpp>
+
+namespace lod_selector_tests {
+
+// With a projection scale of 1000 and a pixel error of 1 the levels reach their threshold at a distance of 10, 100 and 1000
+inline constexpr auto projection_scale = 1000.0f;
+
+inline auto make_submesh() -> sbx::graphics::submesh {
+  auto submesh = sbx::graphics::submesh{};
+
+  submesh.index_count = 36u;
+  submesh.index_offset = 0u;
+  submesh.vertex_offset = 0u;
+  // Bounds of a point, so the distance to the bounds is the distance to the origin of the instance
+  submesh.bounds = sbx::math::volume{sbx::math::vector3{0.0f, 0.0f, 0.0f}, sbx::math::vector3{0.0f, 0.0f, 0.0f}};
+  submesh.local_transform = sbx::math::matrix4x4::identity;
+  submesh.lod_count = 3u;
+  submesh.lods[0u] = sbx::graphics::submesh_lod{24u, 36u, 0.01f};
+  submesh.lods[1u] = sbx::graphics::submesh_lod{12u, 60u, 0.1f};
+  submesh.lods[2u] = sbx::graphics::submesh_lod{6u, 72u, 1.0f};
+
+  return submesh;
+}
+
+inline auto at_distance(const std::float_t distance) -> sbx::math::matrix4x4 {
+  return sbx::math::matrix4x4::translated(sbx::math::matrix4x4::identity, sbx::math::vector3{0.0f, 0.0f, distance});
+}
+
+/**
+ * @brief Runs one frame that selects a single instance.
+ */
+inline auto select(sbx::models::lod_selector& selector, const std::uint64_t key, const sbx::graphics::submesh& submesh, const std::float_t distance) -> std::uint32_t {
+  selector.begin(sbx::math::vector3{0.0f, 0.0f, 0.0f}, 0.1f, projection_scale);
+
+  const auto level = selector.select(key, submesh, at_distance(distance));
+
+  selector.end();
+
+  return level;
+}
+
+} // namespace lod_selector_tests
+
+TEST(libsbx_models_lod_selector, screen_size_thresholds) {
+  const auto submesh = lod_selector_tests::make_submesh();
+
+  auto selector = sbx::models::lod_selector{};
+
+  // Every key is new, so no hysteresis applies
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 5.0f), 0u);
+  EXPECT_EQ(lod_selector_tests::select(selector, 1u, submesh, 11.0f), 1u);
+  EXPECT_EQ(lod_selector_tests::select(selector, 2u, submesh, 99.0f), 1u);
+  EXPECT_EQ(lod_selector_tests::select(selector, 3u, submesh, 101.0f), 2u);
+  EXPECT_EQ(lod_selector_tests::select(selector, 4u, submesh, 5000.0f), 3u);
+
+  // Larger instances have larger errors
+  selector.begin(sbx::math::vector3{0.0f, 0.0f, 0.0f}, 0.1f, lod_selector_tests::projection_scale);
+
+  const auto scaled = sbx::math::matrix4x4::scaled(lod_selector_tests::at_distance(101.0f), sbx::math::vector3{2.0f, 2.0f, 2.0f});
+
+  EXPECT_EQ(selector.select(5u, submesh, scaled), 1u);
+
+  selector.end();
+}
+
+TEST(libsbx_models_lod_selector, hysteresis_delays_coarser_levels) {
+  const auto submesh = lod_selector_tests::make_submesh();
+
+  auto selector = sbx::models::lod_selector{};
+
+  ASSERT_EQ(selector.hysteresis(), 0.25f);
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 50.0f), 1u);
+
+  // Past the threshold of level 2, but not past it by the hysteresis of 25%
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 110.0f), 1u);
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 130.0f), 1u);
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 140.0f), 2u);
+}
+
+TEST(libsbx_models_lod_selector, hysteresis_keeps_coarser_levels) {
+  const auto submesh = lod_selector_tests::make_submesh();
+
+  auto selector = sbx::models::lod_selector{};
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 140.0f), 2u);
+
+  // Level 2 is kept until its error actually exceeds the pixel error
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 101.0f), 2u);
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 95.0f), 1u);
+
+  // Moving back out does not switch right away again
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 105.0f), 1u);
+}
+
+TEST(libsbx_models_lod_selector, forgets_unselected_instances) {
+  const auto submesh = lod_selector_tests::make_submesh();
+
+  auto selector = sbx::models::lod_selector{};
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 50.0f), 1u);
+
+  // A frame without the instance drops its state, so it comes back without hysteresis
+  lod_selector_tests::select(selector, 1u, submesh, 50.0f);
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 110.0f), 2u);
+}
+
+TEST(libsbx_models_lod_selector, disabled_selects_full_detail) {
+  auto submesh = lod_selector_tests::make_submesh();
+
+  auto selector = sbx::models::lod_selector{};
+
+  selector.set_enabled(false);
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 0u, submesh, 5000.0f), 0u);
+
+  selector.set_enabled(true);
+  submesh.lod_count = 0u;
+
+  EXPECT_EQ(lod_selector_tests::select(selector, 1u, submesh, 5000.0f), 0u);
+}
+
+#endif // LIBSBX_MODELS_LOD_SELECTOR_TESTS_HPP_
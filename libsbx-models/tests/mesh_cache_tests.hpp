@@ -0,0 +1,277 @@
+#ifndef LIBSBX_MODELS_MESH_CACHE_TESTS_HPP_
+#define LIBSBX_MODELS_MESH_CACHE_TESTS_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <string_view>
+#include <fstream>
+#include <filesystem>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/utility/exception.hpp>
+
+#include <libsbx/models/mesh.hpp>
+#include <libsbx/models/mesh_cache.hpp>
+
+namespace mesh_cache_tests {
+
+inline auto write_file(const std::filesystem::path& path, const std::string& contents) -> void {
+  auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+  file << contents;
+}
+
+/**
+ * @brief A source file and the path of its cache in a temporary directory that is removed again at the end of the test.
+ */
+class scoped_files {
+
+public:
+
+  explicit scoped_files(const std::string& name)
+  : _directory{std::filesystem::temp_directory_path() / name} {
+    std::filesystem::create_directories(_directory);
+
+    write_file(source(), "o 1\nv 0 0 0\n");
+  }
+
+  ~scoped_files() {
+    auto error = std::error_code{};
+    std::filesystem::remove_all(_directory, error);
+  }
+
+  auto source() const -> std::filesystem::path {
+    return _directory / "mesh.obj";
+  }
+
+  auto cache() const -> std::filesystem::path {
+    return _directory / "mesh.sbxmsh";
+  }
+
+private:
+
+  std::filesystem::path _directory;
+
+}; // class scoped_files
+
+// A quad with normals and uvs, which is all the importer needs
+inline constexpr auto quad_obj = std::string_view{
+  "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+  "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+  "vn 0 0 1\n"
+  "f 1/1/1 2/2/1 3/3/1\nf 1/1/1 3/3/1 4/4/1\n"
+};
+
+inline auto corrupt_payload(const std::filesystem::path& path) -> void {
+  auto file = std::fstream{path, std::ios::binary | std::ios::in | std::ios::out};
+  file.seekp(static_cast<std::streamoff>(sizeof(sbx::models::mesh_cache_header)));
+  file.put('\x7f');
+}
+
+inline auto make_vertex(const std::float_t x, const std::float_t y) -> sbx::models::vertex3d {
+  return sbx::models::vertex3d{
+    sbx::math::vector3{x, y, 0.0f},
+    sbx::math::vector3{0.0f, 0.0f, 1.0f},
+    sbx::math::vector2{x, y},
+    sbx::math::vector4{1.0f, 0.0f, 0.0f, 1.0f}
+  };
+}
+
+// A quad with one submesh, one level of detail and one meshlet
+inline auto make_mesh_data() -> sbx::models::mesh_cache::mesh_data {
+  auto data = sbx::models::mesh_cache::mesh_data{};
+
+  data.vertices = {make_vertex(0.0f, 0.0f), make_vertex(1.0f, 0.0f), make_vertex(1.0f, 1.0f), make_vertex(0.0f, 1.0f)};
+  data.indices = {0u, 1u, 2u, 0u, 2u, 3u, 0u, 1u, 2u};
+
+  auto submesh = sbx::graphics::submesh{};
+  submesh.index_count = 6u;
+  submesh.index_offset = 0u;
+  submesh.vertex_offset = 0u;
+  submesh.bounds = sbx::math::volume{sbx::math::vector3{0.0f, 0.0f, 0.0f}, sbx::math::vector3{1.0f, 1.0f, 0.0f}};
+  submesh.local_transform = sbx::math::matrix4x4::identity;
+  submesh.name = sbx::utility::hashed_string{"quad"};
+  submesh.lod_count = 1u;
+  submesh.lods[0u] = sbx::graphics::submesh_lod{3u, 6u, 0.5f};
+
+  data.submeshes.push_back(submesh);
+
+  return data;
+}
+
+inline auto make_meshlet_data() -> sbx::models::meshlet_data {
+  auto data = sbx::models::meshlet_data{};
+
+  data.meshlets.push_back(sbx::models::meshlet{0u, 0u, 4u, 2u});
+  data.bounds.push_back(sbx::math::cluster_bounds{sbx::math::vector3{0.5f, 0.5f, 0.0f}, 0.75f, sbx::math::vector3{0.0f, 0.0f, 1.0f}, 0.5f});
+  data.vertices = {0u, 1u, 2u, 3u};
+  data.triangles = {0u, 1u, 2u, 0u, 2u, 3u};
+  data.submeshes.push_back(sbx::models::meshlet_range{0u, 1u});
+
+  return data;
+}
+
+inline auto expect_round_trip(const sbx::models::mesh_cache& cache) -> void {
+  const auto data = make_mesh_data();
+  const auto meshlets = make_meshlet_data();
+
+  EXPECT_TRUE(cache.verify());
+
+  ASSERT_EQ(cache.vertices().size(), data.vertices.size());
+
+  for (auto i = 0u; i < data.vertices.size(); ++i) {
+    EXPECT_EQ(cache.vertices()[i], data.vertices[i]);
+  }
+
+  EXPECT_EQ(std::vector<std::uint32_t>(cache.indices().begin(), cache.indices().end()), data.indices);
+
+  const auto submeshes = cache.submeshes();
+
+  ASSERT_EQ(submeshes.size(), 1u);
+  EXPECT_EQ(submeshes[0u].index_count, 6u);
+  EXPECT_EQ(submeshes[0u].name, sbx::utility::hashed_string{"quad"});
+  EXPECT_EQ(submeshes[0u].bounds.max(), (sbx::math::vector3{1.0f, 1.0f, 0.0f}));
+  EXPECT_EQ(submeshes[0u].lod_count, 1u);
+  EXPECT_EQ(submeshes[0u].lods[0u].index_count, 3u);
+  EXPECT_EQ(submeshes[0u].lods[0u].index_offset, 6u);
+
+  const auto result = cache.meshlets();
+
+  ASSERT_EQ(result.meshlets.size(), 1u);
+  EXPECT_EQ(result.meshlets[0u].vertex_count, 4u);
+  EXPECT_EQ(result.meshlets[0u].triangle_count, 2u);
+  EXPECT_EQ(result.bounds[0u].radius, 0.75f);
+  EXPECT_EQ(result.vertices, meshlets.vertices);
+  EXPECT_EQ(result.triangles, meshlets.triangles);
+  ASSERT_EQ(result.submeshes.size(), 1u);
+  EXPECT_EQ(result.submeshes[0u].count, 1u);
+}
+
+} // namespace mesh_cache_tests
+
+TEST(libsbx_models_mesh_cache, round_trip) {
+  const auto files = mesh_cache_tests::scoped_files{"libsbx_models_mesh_cache_round_trip"};
+
+  sbx::models::mesh_cache::write(files.cache(), files.source(), mesh_cache_tests::make_mesh_data(), mesh_cache_tests::make_meshlet_data());
+
+  ASSERT_TRUE(sbx::models::mesh_cache::is_up_to_date(files.cache(), files.source()));
+
+  const auto cache = sbx::models::mesh_cache{files.cache()};
+
+  EXPECT_EQ(cache.compression(), sbx::models::mesh_cache_compression::none);
+
+  mesh_cache_tests::expect_round_trip(cache);
+}
+
+TEST(libsbx_models_mesh_cache, compressed_round_trip) {
+  const auto files = mesh_cache_tests::scoped_files{"libsbx_models_mesh_cache_compressed_round_trip"};
+
+  sbx::models::mesh_cache::write(files.cache(), files.source(), mesh_cache_tests::make_mesh_data(), mesh_cache_tests::make_meshlet_data(), sbx::models::mesh_cache_compression::lz4);
+
+  const auto cache = sbx::models::mesh_cache{files.cache()};
+
+  EXPECT_EQ(cache.compression(), sbx::models::mesh_cache_compression::lz4);
+
+  mesh_cache_tests::expect_round_trip(cache);
+}
+
+TEST(libsbx_models_mesh_cache, changed_source_is_stale) {
+  const auto files = mesh_cache_tests::scoped_files{"libsbx_models_mesh_cache_changed_source_is_stale"};
+
+  sbx::models::mesh_cache::write(files.cache(), files.source(), mesh_cache_tests::make_mesh_data(), mesh_cache_tests::make_meshlet_data());
+
+  ASSERT_TRUE(sbx::models::mesh_cache::is_up_to_date(files.cache(), files.source()));
+
+  mesh_cache_tests::write_file(files.source(), "o 1\nv 0 0 0\nv 1 0 0\n");
+
+  EXPECT_FALSE(sbx::models::mesh_cache::is_up_to_date(files.cache(), files.source()));
+
+  // Same size, but a different modification time
+  sbx::models::mesh_cache::write(files.cache(), files.source(), mesh_cache_tests::make_mesh_data(), mesh_cache_tests::make_meshlet_data());
+
+  ASSERT_TRUE(sbx::models::mesh_cache::is_up_to_date(files.cache(), files.source()));
+
+  std::filesystem::last_write_time(files.source(), std::filesystem::last_write_time(files.source()) + std::chrono::seconds{10});
+
+  EXPECT_FALSE(sbx::models::mesh_cache::is_up_to_date(files.cache(), files.source()));
+
+  std::filesystem::remove(files.source());
+
+  EXPECT_FALSE(sbx::models::mesh_cache::is_up_to_date(files.cache(), files.source()));
+}
+
+TEST(libsbx_models_mesh_cache, corrupt_header_throws) {
+  const auto files = mesh_cache_tests::scoped_files{"libsbx_models_mesh_cache_corrupt_header_throws"};
+
+  sbx::models::mesh_cache::write(files.cache(), files.source(), mesh_cache_tests::make_mesh_data(), mesh_cache_tests::make_meshlet_data());
+
+  {
+    auto file = std::fstream{files.cache(), std::ios::binary | std::ios::in | std::ios::out};
+    file.seekp(static_cast<std::streamoff>(offsetof(sbx::models::mesh_cache_header, vertex_count)));
+
+    const auto vertex_count = std::uint32_t{3u};
+    file.write(reinterpret_cast<const char*>(&vertex_count), sizeof(vertex_count));
+  }
+
+  EXPECT_THROW(sbx::models::mesh_cache{files.cache()}, sbx::utility::runtime_error);
+}
+
+TEST(libsbx_models_mesh_cache, corrupt_payload_throws) {
+  const auto files = mesh_cache_tests::scoped_files{"libsbx_models_mesh_cache_corrupt_payload_throws"};
+
+  sbx::models::mesh_cache::write(files.cache(), files.source(), mesh_cache_tests::make_mesh_data(), mesh_cache_tests::make_meshlet_data());
+
+  mesh_cache_tests::corrupt_payload(files.cache());
+
+  // The payload is still structurally valid, only its checksum catches the corruption
+  EXPECT_THROW(sbx::models::mesh_cache{files.cache()}, sbx::utility::runtime_error);
+}
+
+TEST(libsbx_models_mesh_cache, load_reimports_corrupt_payload) {
+  const auto files = mesh_cache_tests::scoped_files{"libsbx_models_mesh_cache_load_reimports_corrupt_payload"};
+
+  mesh_cache_tests::write_file(files.source(), std::string{mesh_cache_tests::quad_obj});
+
+  const auto imported = sbx::models::mesh::load_resolved(files.source());
+
+  EXPECT_FALSE(imported.cache.has_value());
+  ASSERT_FALSE(imported.data.vertices.empty());
+  ASSERT_TRUE(sbx::models::mesh_cache::is_up_to_date(files.cache(), files.source()));
+
+  {
+    const auto cached = sbx::models::mesh::load_resolved(files.source());
+
+    ASSERT_TRUE(cached.cache.has_value());
+    EXPECT_EQ(cached.cache->vertices().size(), imported.data.vertices.size());
+  }
+
+  mesh_cache_tests::corrupt_payload(files.cache());
+
+  // The cache is still up to date with its source, but fails to open and the source is imported again
+  const auto reimported = sbx::models::mesh::load_resolved(files.source());
+
+  EXPECT_FALSE(reimported.cache.has_value());
+  EXPECT_EQ(reimported.data.vertices.size(), imported.data.vertices.size());
+  EXPECT_EQ(reimported.data.indices, imported.data.indices);
+
+  // The import replaced the corrupt cache
+  const auto rewritten = sbx::models::mesh::load_resolved(files.source());
+
+  ASSERT_TRUE(rewritten.cache.has_value());
+  EXPECT_TRUE(rewritten.cache->verify());
+}
+
+TEST(libsbx_models_mesh_cache, truncated_file_throws) {
+  const auto files = mesh_cache_tests::scoped_files{"libsbx_models_mesh_cache_truncated_file_throws"};
+
+  sbx::models::mesh_cache::write(files.cache(), files.source(), mesh_cache_tests::make_mesh_data(), mesh_cache_tests::make_meshlet_data());
+
+  std::filesystem::resize_file(files.cache(), std::filesystem::file_size(files.cache()) - 4u);
+
+  EXPECT_THROW(sbx::models::mesh_cache{files.cache()}, sbx::utility::runtime_error);
+}
+
+#endif // LIBSBX_MODELS_MESH_CACHE_TESTS_HPP_
@@ -0,0 +1,186 @@
+#ifndef LIBSBX_MODELS_MESHLET_BUILDER_TESTS_HPP_
+#define LIBSBX_MODELS_MESHLET_BUILDER_TESTS_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <span>
+#include <vector>
+#include <array>
+#include <algorithm>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/math/vector3.hpp>
+
+#include <libsbx/models/meshlet_builder.hpp>
+
+namespace meshlet_builder_tests {
+
+using triangle = std::array<std::uint32_t, 3u>;
+
+struct grid {
+  std::vector<sbx::models::vertex3d> vertices;
+  std::vector<std::uint32_t> indices;
+}; // struct grid
+
+/**
+ * @brief A flat grid of size x size quads in the xy plane facing +z.
+ */
+inline auto make_grid(const std::uint32_t size) -> grid {
+  auto result = grid{};
+
+  for (auto y = 0u; y <= size; ++y) {
+    for (auto x = 0u; x <= size; ++x) {
+      result.vertices.push_back(sbx::models::vertex3d{
+        sbx::math::vector3{static_cast<std::float_t>(x), static_cast<std::float_t>(y), 0.0f},
+        sbx::math::vector3{0.0f, 0.0f, 1.0f},
+        sbx::math::vector2{static_cast<std::float_t>(x), static_cast<std::float_t>(y)},
+        sbx::math::vector4{1.0f, 0.0f, 0.0f, 1.0f}
+      });
+    }
+  }
+
+  for (auto y = 0u; y < size; ++y) {
+    for (auto x = 0u; x < size; ++x) {
+      const auto i = y * (size + 1u) + x;
+
+      result.indices.insert(result.indices.end(), {i, i + 1u, i + size + 2u, i, i + size + 2u, i + size + 1u});
+    }
+  }
+
+  return result;
+}
+
+// Rotates the smallest index to the front, this keeps the winding of the triangle
+inline auto normalized(const triangle& value) -> triangle {
+  auto result = value;
+
+  std::ranges::rotate(result, std::ranges::min_element(result));
+
+  return result;
+}
+
+inline auto triangles_of(std::span<const std::uint32_t> indices) -> std::vector<triangle> {
+  auto result = std::vector<triangle>{};
+
+  for (auto i = 0u; i < indices.size(); i += 3u) {
+    result.push_back(normalized(triangle{indices[i], indices[i + 1u], indices[i + 2u]}));
+  }
+
+  std::ranges::sort(result);
+
+  return result;
+}
+
+/**
+ * @brief Checks the limits, the bounds and that the meshlets of one submesh contain exactly the triangles of the submesh.
+ */
+inline auto expect_valid(const sbx::models::meshlet_data& data, const sbx::models::meshlet_range& range, const grid& mesh, const sbx::models::meshlet_settings& settings) -> void {
+  auto triangles = std::vector<triangle>{};
+
+  for (auto i = range.offset; i < range.offset + range.count; ++i) {
+    const auto& meshlet = data.meshlets[i];
+    const auto& bounds = data.bounds[i];
+
+    EXPECT_GT(meshlet.vertex_count, 0u);
+    EXPECT_LE(meshlet.vertex_count, settings.max_vertices);
+    EXPECT_GT(meshlet.triangle_count, 0u);
+    EXPECT_LE(meshlet.triangle_count, settings.max_triangles);
+
+    ASSERT_LE(meshlet.vertex_offset + meshlet.vertex_count, data.vertices.size());
+    ASSERT_LE(meshlet.triangle_offset + meshlet.triangle_count * 3u, data.triangles.size());
+
+    for (auto j = 0u; j < meshlet.vertex_count; ++j) {
+      const auto vertex = data.vertices[meshlet.vertex_offset + j];
+
+      ASSERT_LT(vertex, mesh.vertices.size());
+
+      const auto distance = sbx::math::vector3::distance(mesh.vertices[vertex].position, bounds.center);
+
+      EXPECT_LE(distance, bounds.radius + 1e-4f) << "meshlet " << i;
+    }
+
+    // The grid is flat, so all triangles of a meshlet face the same direction
+    EXPECT_NEAR(bounds.cone_axis.z(), 1.0f, 1e-3f) << "meshlet " << i;
+    EXPECT_LE(bounds.cone_cutoff, 1.0f);
+
+    for (auto j = 0u; j < meshlet.triangle_count; ++j) {
+      auto value = triangle{};
+
+      for (auto k = 0u; k < 3u; ++k) {
+        const auto local = data.triangles[meshlet.triangle_offset + j * 3u + k];
+
+        ASSERT_LT(local, meshlet.vertex_count);
+
+        value[k] = data.vertices[meshlet.vertex_offset + local];
+      }
+
+      triangles.push_back(normalized(value));
+    }
+  }
+
+  std::ranges::sort(triangles);
+
+  EXPECT_EQ(triangles, triangles_of(mesh.indices));
+}
+
+} // namespace meshlet_builder_tests
+
+TEST(libsbx_models_meshlet_builder, respects_the_limits) {
+  const auto mesh = meshlet_builder_tests::make_grid(16u);
+
+  const auto settings = sbx::models::meshlet_settings{32u, 32u, 0.25f};
+
+  auto data = sbx::models::meshlet_data{};
+
+  sbx::models::build_meshlets(mesh.indices, mesh.vertices, data, settings);
+
+  ASSERT_EQ(data.submeshes.size(), 1u);
+  EXPECT_EQ(data.submeshes[0u].offset, 0u);
+  EXPECT_EQ(data.submeshes[0u].count, data.meshlets.size());
+  EXPECT_EQ(data.bounds.size(), data.meshlets.size());
+
+  // 512 triangles with at most 32 in every meshlet
+  EXPECT_GE(data.meshlets.size(), 16u);
+
+  meshlet_builder_tests::expect_valid(data, data.submeshes[0u], mesh, settings);
+}
+
+TEST(libsbx_models_meshlet_builder, default_settings) {
+  const auto mesh = meshlet_builder_tests::make_grid(32u);
+
+  auto data = sbx::models::meshlet_data{};
+
+  sbx::models::build_meshlets(mesh.indices, mesh.vertices, data);
+
+  ASSERT_EQ(data.submeshes.size(), 1u);
+
+  meshlet_builder_tests::expect_valid(data, data.submeshes[0u], mesh, sbx::models::meshlet_settings{});
+}
+
+TEST(libsbx_models_meshlet_builder, appends_submeshes) {
+  const auto first = meshlet_builder_tests::make_grid(4u);
+  const auto second = meshlet_builder_tests::make_grid(8u);
+
+  const auto settings = sbx::models::meshlet_settings{16u, 16u, 0.25f};
+
+  auto data = sbx::models::meshlet_data{};
+
+  sbx::models::build_meshlets(first.indices, first.vertices, data, settings);
+  sbx::models::build_meshlets(std::span<const std::uint32_t>{}, second.vertices, data, settings);
+  sbx::models::build_meshlets(second.indices, second.vertices, data, settings);
+
+  ASSERT_EQ(data.submeshes.size(), 3u);
+
+  // An empty submesh gets an empty range
+  EXPECT_EQ(data.submeshes[1u].offset, data.submeshes[0u].count);
+  EXPECT_EQ(data.submeshes[1u].count, 0u);
+
+  EXPECT_EQ(data.submeshes[2u].offset, data.submeshes[0u].count);
+  EXPECT_EQ(data.submeshes[2u].offset + data.submeshes[2u].count, data.meshlets.size());
+
+  meshlet_builder_tests::expect_valid(data, data.submeshes[0u], first, settings);
+  meshlet_builder_tests::expect_valid(data, data.submeshes[2u], second, settings);
+}
+
+#endif // LIBSBX_MODELS_MESHLET_BUILDER_TESTS_HPP_
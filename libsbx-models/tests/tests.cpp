@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+
+#include <tests/frustum_culling_tests.hpp>
+#include <tests/lod_selector_tests.hpp>
+#include <tests/meshlet_builder_tests.hpp>
+#include <tests/mesh_cache_tests.hpp>
+
+auto main(int argc, char* argv[]) -> int {
+  testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
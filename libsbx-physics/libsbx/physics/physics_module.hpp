@@ -28,7 +28,7 @@ namespace sbx::physics {
 
 class physics_module : public core::module<physics_module> {
 
-  inline static const auto is_registered = register_module(stage::fixed, dependencies<scenes::scenes_module>{});
+  inline static const auto is_registered = register_module(stage::fixed, dependencies<scenes::scenes_module>{}, reads<physics::collider>{}, writes<physics::rigidbody, scenes::transform>{});
 
 public:
 
@@ -102,11 +102,11 @@ private:
     auto& scenes_module = core::engine::get_module<scenes::scenes_module>();
     auto& scene = scenes_module.scene();
 
-    auto query = scene.query<scenes::transform, const scenes::global_transform, physics::rigidbody>();
+    auto group = scene.group<physics::rigidbody>(ecs::get<scenes::transform, const scenes::global_transform>);
 
     const auto delta_time = core::engine::fixed_delta_time();
 
-    for (auto&& [node, transform, global_transform, rigidbody] : query.each()) {
+    for (auto&& [node, rigidbody, transform, global_transform] : group.each()) {
       if (rigidbody.is_static()) {
         continue;
       }
@@ -149,9 +149,9 @@ private:
     auto& scene = scenes_module.scene();
 
     auto tree = containers::octree<math::uuid, 16u, 8u>{math::volume{math::vector3{-100.0f}, math::vector3{100.0f}}};
-    auto query = scene.query<const physics::collider, const scenes::transform, const scenes::global_transform, const scenes::id>();
+    auto group = scene.group<physics::collider>(ecs::get<const scenes::transform, const scenes::global_transform, const scenes::id>);
 
-    for (auto&& [node, collider, transform, global_transform, id] : query.each()) {
+    for (auto&& [node, collider, transform, global_transform, id] : group.each()) {
       const auto volume = bounding_volume(collider, get_translation(global_transform.model));
 
       if (std::holds_alternative<physics::box>(collider)) {
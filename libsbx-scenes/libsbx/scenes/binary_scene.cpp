@@ -0,0 +1,258 @@
+#include <libsbx/scenes/binary_scene.hpp>
+
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <algorithm>
+#include <type_traits>
+
+#include <libsbx/utility/exception.hpp>
+
+namespace sbx::scenes {
+
+static_assert(std::endian::native == std::endian::little, "The binary scene format is only supported on little endian targets");
+
+static_assert(std::is_trivially_copyable_v<binary_node_record> && sizeof(binary_node_record) == 24u);
+static_assert(std::is_trivially_copyable_v<binary_transform_record> && sizeof(binary_transform_record) == 40u);
+static_assert(std::is_trivially_copyable_v<binary_asset_record> && sizeof(binary_asset_record) == 32u);
+static_assert(std::is_trivially_copyable_v<binary_component_header> && sizeof(binary_component_header) == 16u);
+
+namespace {
+
+constexpr auto chunk_alignment = std::size_t{16u};
+
+constexpr auto align_up(const std::size_t value, const std::size_t alignment) noexcept -> std::size_t {
+  return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+template<typename Type>
+auto append(std::vector<std::byte>& buffer, const Type* data, const std::size_t count) -> void {
+  const auto* bytes = reinterpret_cast<const std::byte*>(data);
+  buffer.insert(buffer.end(), bytes, bytes + count * sizeof(Type));
+}
+
+template<typename Type>
+auto read(const std::span<const std::byte> bytes, const std::size_t offset) -> Type {
+  if (offset + sizeof(Type) > bytes.size()) {
+    throw utility::runtime_error{"Unexpected end of binary scene data"};
+  }
+
+  auto result = Type{};
+  std::memcpy(&result, bytes.data() + offset, sizeof(Type));
+
+  return result;
+}
+
+} // namespace
+
+auto binary_scene_writer::add_string(const std::string_view value) -> binary_string {
+  if (auto entry = _string_lookup.find(std::string{value}); entry != _string_lookup.end()) {
+    return entry->second;
+  }
+
+  const auto result = binary_string{static_cast<std::uint32_t>(_strings.size()), static_cast<std::uint32_t>(value.size())};
+
+  _strings.append(value);
+  _string_lookup.emplace(std::string{value}, result);
+
+  return result;
+}
+
+auto binary_scene_writer::add_node(const std::uint64_t id, const std::uint32_t parent, const std::string_view tag, const binary_transform_record& transform, const binary_node_flags flags) -> std::uint32_t {
+  const auto index = static_cast<std::uint32_t>(_nodes.size());
+
+  if (parent != binary_scene_no_parent && parent >= index) {
+    throw utility::runtime_error{"Parent {} of binary scene node {} has not been added yet", parent, index};
+  }
+
+  _nodes.push_back(binary_node_record{id, parent, flags, add_string(tag)});
+  _transforms.push_back(transform);
+
+  return index;
+}
+
+auto binary_scene_writer::add_asset(const std::string_view type, const std::string_view name, const std::string_view path, const std::string_view source) -> void {
+  _assets.push_back(binary_asset_record{add_string(type), add_string(name), add_string(path), add_string(source)});
+}
+
+auto binary_scene_writer::add_component(const std::string_view name, std::vector<std::uint32_t> nodes, std::vector<std::byte> payload) -> void {
+  _components.push_back(component_block{add_string(name), std::move(nodes), std::move(payload)});
+}
+
+auto binary_scene_writer::build() const -> std::vector<std::byte> {
+  auto chunks = std::vector<std::pair<binary_scene_chunk, std::vector<std::byte>>>{};
+
+  const auto add_chunk = [&chunks](const binary_scene_chunk_id id, const std::size_t count, std::vector<std::byte> bytes) {
+    chunks.emplace_back(binary_scene_chunk{id, static_cast<std::uint32_t>(count), 0u, 0u}, std::move(bytes));
+  };
+
+  const auto to_bytes = [](const auto& values) {
+    auto bytes = std::vector<std::byte>{};
+    append(bytes, values.data(), values.size());
+    return bytes;
+  };
+
+  add_chunk(binary_scene_chunk_id::strings, _strings.size(), to_bytes(_strings));
+  add_chunk(binary_scene_chunk_id::nodes, _nodes.size(), to_bytes(_nodes));
+  add_chunk(binary_scene_chunk_id::transforms, _transforms.size(), to_bytes(_transforms));
+  add_chunk(binary_scene_chunk_id::assets, _assets.size(), to_bytes(_assets));
+
+  for (const auto& component : _components) {
+    auto bytes = std::vector<std::byte>{};
+
+    const auto header = binary_component_header{component.name, static_cast<std::uint32_t>(component.nodes.size()), 0u};
+
+    append(bytes, &header, 1u);
+    append(bytes, component.nodes.data(), component.nodes.size());
+    bytes.resize(align_up(bytes.size(), alignof(std::uint64_t)));
+    append(bytes, component.payload.data(), component.payload.size());
+
+    add_chunk(binary_scene_chunk_id::component, component.nodes.size(), std::move(bytes));
+  }
+
+  auto offset = align_up(sizeof(binary_scene_header) + chunks.size() * sizeof(binary_scene_chunk), chunk_alignment);
+
+  for (auto& [chunk, bytes] : chunks) {
+    chunk.offset = offset;
+    chunk.size = bytes.size();
+
+    offset = align_up(offset + bytes.size(), chunk_alignment);
+  }
+
+  auto result = std::vector<std::byte>{};
+  result.reserve(offset);
+
+  const auto header = binary_scene_header{binary_scene_magic, binary_scene_version, static_cast<std::uint32_t>(chunks.size())};
+
+  append(result, &header, 1u);
+
+  for (const auto& [chunk, bytes] : chunks) {
+    append(result, &chunk, 1u);
+  }
+
+  for (const auto& [chunk, bytes] : chunks) {
+    result.resize(chunk.offset);
+    result.insert(result.end(), bytes.begin(), bytes.end());
+  }
+
+  result.resize(offset);
+
+  return result;
+}
+
+auto binary_scene_writer::write(const std::filesystem::path& path) const -> void {
+  const auto data = build();
+
+  auto stream = std::ofstream{path, std::ios::binary | std::ios::trunc};
+
+  if (!stream.is_open()) {
+    throw utility::runtime_error{"Could not open '{}' for writing", path.string()};
+  }
+
+  stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+binary_scene_view::binary_scene_view(const std::span<const std::byte> data) {
+  const auto header = read<binary_scene_header>(data, 0u);
+
+  if (header.magic != binary_scene_magic) {
+    throw utility::runtime_error{"Data is not a binary scene"};
+  }
+
+  if (header.version != binary_scene_version) {
+    throw utility::runtime_error{"Unsupported binary scene version {} (expected {})", header.version, binary_scene_version};
+  }
+
+  for (auto index = 0u; index < header.chunk_count; ++index) {
+    const auto chunk = read<binary_scene_chunk>(data, sizeof(binary_scene_header) + index * sizeof(binary_scene_chunk));
+
+    if (chunk.offset % chunk_alignment != 0u || chunk.offset > data.size() || chunk.size > data.size() - chunk.offset) {
+      throw utility::runtime_error{"Binary scene chunk {} is out of bounds", index};
+    }
+
+    const auto bytes = data.subspan(chunk.offset, chunk.size);
+
+    switch (chunk.id) {
+      case binary_scene_chunk_id::strings: {
+        _strings = std::string_view{reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+        break;
+      }
+      case binary_scene_chunk_id::nodes: {
+        _nodes = _as_span<binary_node_record>(bytes, chunk.count);
+        break;
+      }
+      case binary_scene_chunk_id::transforms: {
+        _transforms = _as_span<binary_transform_record>(bytes, chunk.count);
+        break;
+      }
+      case binary_scene_chunk_id::assets: {
+        _assets = _as_span<binary_asset_record>(bytes, chunk.count);
+        break;
+      }
+      case binary_scene_chunk_id::component: {
+        const auto component = read<binary_component_header>(bytes, 0u);
+        const auto payload_offset = align_up(sizeof(binary_component_header) + component.count * sizeof(std::uint32_t), alignof(std::uint64_t));
+
+        if (payload_offset > bytes.size()) {
+          throw utility::runtime_error{"Binary scene component chunk {} is out of bounds", index};
+        }
+
+        _components.push_back(component_block{
+          .name = string(component.name),
+          .nodes = _as_span<std::uint32_t>(bytes.subspan(sizeof(binary_component_header)), component.count),
+          .payload = bytes.subspan(payload_offset)
+        });
+
+        break;
+      }
+      default: {
+        // Unknown chunks are skipped to allow adding new chunks without bumping the version
+        break;
+      }
+    }
+  }
+
+  if (_transforms.size() != _nodes.size()) {
+    throw utility::runtime_error{"Binary scene has {} nodes but {} transforms", _nodes.size(), _transforms.size()};
+  }
+
+  for (auto index = std::size_t{0u}; index < _nodes.size(); ++index) {
+    if (const auto parent = _nodes[index].parent; parent != binary_scene_no_parent && parent >= index) {
+      throw utility::runtime_error{"Binary scene node {} references invalid parent {}", index, parent};
+    }
+  }
+
+  for (const auto& component : _components) {
+    if (std::ranges::any_of(component.nodes, [this](const auto node) { return node >= _nodes.size(); })) {
+      throw utility::runtime_error{"Binary scene component block '{}' references invalid nodes", component.name};
+    }
+  }
+}
+
+auto binary_scene_view::string(const binary_string& value) const -> std::string_view {
+  if (value.offset > _strings.size() || value.size > _strings.size() - value.offset) {
+    throw utility::runtime_error{"Binary scene string is out of bounds"};
+  }
+
+  return _strings.substr(value.offset, value.size);
+}
+
+template<typename Type>
+auto binary_scene_view::_as_span(const std::span<const std::byte> bytes, const std::size_t count) -> std::span<const Type> {
+  if (count > bytes.size() / sizeof(Type)) {
+    throw utility::runtime_error{"Binary scene chunk is too small for {} records", count};
+  }
+
+  if (count == 0u) {
+    return {};
+  }
+
+  // Chunks are aligned in the file and mappings are page aligned, so the records can be used in place
+  if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(Type) != 0u) {
+    throw utility::runtime_error{"Binary scene chunk is misaligned"};
+  }
+
+  return {reinterpret_cast<const Type*>(bytes.data()), count};
+}
+
+} // namespace sbx::scenes
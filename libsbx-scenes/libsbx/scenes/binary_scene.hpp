@@ -0,0 +1,198 @@
+#ifndef LIBSBX_SCENES_BINARY_SCENE_HPP_
+#define LIBSBX_SCENES_BINARY_SCENE_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <array>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <limits>
+#include <filesystem>
+#include <unordered_map>
+
+namespace sbx::scenes {
+
+/**
+ * @brief Binary scene format, stored in files with the .sbxscn extension.
+ *
+ * The file starts with a binary_scene_header followed by a table of binary_scene_chunk entries. Every chunk starts at a 16 byte aligned offset.
+ * Chunks hold flat arrays of the records below, so a memory mapped file is used in place without parsing or copying:
+ * - strings: character data referenced by binary_string
+ * - nodes: binary_node_record per node in depth-first order, parents always precede their children
+ * - transforms: binary_transform_record per node, same order as the nodes
+ * - assets: binary_asset_record per referenced asset
+ * - component: one chunk per component type, see binary_component_header
+ *
+ * Data is stored in little endian byte order.
+ */
+inline constexpr auto binary_scene_extension = std::string_view{".sbxscn"};
+
+inline constexpr auto binary_scene_magic = std::array<char, 8u>{'S', 'B', 'X', 'S', 'C', 'E', 'N', 'E'};
+
+inline constexpr auto binary_scene_version = std::uint32_t{1u};
+
+inline constexpr auto binary_scene_no_parent = std::numeric_limits<std::uint32_t>::max();
+
+enum class binary_scene_chunk_id : std::uint32_t {
+  strings = 0x53525453, // "STRS"
+  nodes = 0x45444f4e, // "NODE"
+  transforms = 0x4d524658, // "XFRM"
+  assets = 0x54535341, // "ASST"
+  component = 0x504d4f43 // "COMP"
+}; // enum class binary_scene_chunk_id
+
+enum class binary_node_flags : std::uint32_t {
+  none = 0u,
+  camera = 1u << 0u
+}; // enum class binary_node_flags
+
+struct binary_scene_header {
+  std::array<char, 8u> magic;
+  std::uint32_t version;
+  std::uint32_t chunk_count;
+}; // struct binary_scene_header
+
+struct binary_scene_chunk {
+  binary_scene_chunk_id id;
+  std::uint32_t count;
+  std::uint64_t offset;
+  std::uint64_t size;
+}; // struct binary_scene_chunk
+
+struct binary_string {
+  std::uint32_t offset;
+  std::uint32_t size;
+}; // struct binary_string
+
+struct binary_node_record {
+  std::uint64_t id;
+  std::uint32_t parent;
+  binary_node_flags flags;
+  binary_string tag;
+}; // struct binary_node_record
+
+struct binary_transform_record {
+  std::array<std::float_t, 3u> position;
+  std::array<std::float_t, 4u> rotation;
+  std::array<std::float_t, 3u> scale;
+}; // struct binary_transform_record
+
+struct binary_asset_record {
+  binary_string type;
+  binary_string name;
+  binary_string path;
+  binary_string source;
+}; // struct binary_asset_record
+
+/**
+ * @brief Header of a component chunk. It is followed by count node indices, padding to 8 bytes and a payload with one record per node.
+ *
+ * Every record is a u64 byte length followed by the bytes written by the binary save hook of the component.
+ */
+struct binary_component_header {
+  binary_string name;
+  std::uint32_t count;
+  std::uint32_t reserved;
+}; // struct binary_component_header
+
+/**
+ * @brief Collects the contents of a binary scene and serializes them.
+ */
+class binary_scene_writer {
+
+public:
+
+  binary_scene_writer() = default;
+
+  auto add_string(const std::string_view value) -> binary_string;
+
+  /**
+   * @brief Adds a node. Parents have to be added before their children.
+   *
+   * @return The index of the node, used to reference it as parent or in component blocks.
+   */
+  auto add_node(const std::uint64_t id, const std::uint32_t parent, const std::string_view tag, const binary_transform_record& transform, const binary_node_flags flags = binary_node_flags::none) -> std::uint32_t;
+
+  auto add_asset(const std::string_view type, const std::string_view name, const std::string_view path, const std::string_view source) -> void;
+
+  /**
+   * @brief Adds a component block. The payload has to hold one length prefixed record per node.
+   */
+  auto add_component(const std::string_view name, std::vector<std::uint32_t> nodes, std::vector<std::byte> payload) -> void;
+
+  [[nodiscard]] auto build() const -> std::vector<std::byte>;
+
+  auto write(const std::filesystem::path& path) const -> void;
+
+private:
+
+  struct component_block {
+    binary_string name;
+    std::vector<std::uint32_t> nodes;
+    std::vector<std::byte> payload;
+  }; // struct component_block
+
+  std::string _strings;
+  std::unordered_map<std::string, binary_string> _string_lookup;
+
+  std::vector<binary_node_record> _nodes;
+  std::vector<binary_transform_record> _transforms;
+  std::vector<binary_asset_record> _assets;
+  std::vector<component_block> _components;
+
+}; // class binary_scene_writer
+
+/**
+ * @brief Read-only view of a binary scene in memory. All accessors return views into the underlying data, which has to outlive the view.
+ *
+ * The constructor validates the header and all chunk bounds and throws a utility::runtime_error if the data is malformed.
+ */
+class binary_scene_view {
+
+public:
+
+  struct component_block {
+    std::string_view name;
+    std::span<const std::uint32_t> nodes;
+    std::span<const std::byte> payload;
+  }; // struct component_block
+
+  explicit binary_scene_view(const std::span<const std::byte> data);
+
+  [[nodiscard]] auto nodes() const noexcept -> std::span<const binary_node_record> {
+    return _nodes;
+  }
+
+  [[nodiscard]] auto transforms() const noexcept -> std::span<const binary_transform_record> {
+    return _transforms;
+  }
+
+  [[nodiscard]] auto assets() const noexcept -> std::span<const binary_asset_record> {
+    return _assets;
+  }
+
+  [[nodiscard]] auto components() const noexcept -> std::span<const component_block> {
+    return _components;
+  }
+
+  [[nodiscard]] auto string(const binary_string& value) const -> std::string_view;
+
+private:
+
+  template<typename Type>
+  [[nodiscard]] static auto _as_span(const std::span<const std::byte> bytes, const std::size_t count) -> std::span<const Type>;
+
+  std::string_view _strings;
+  std::span<const binary_node_record> _nodes;
+  std::span<const binary_transform_record> _transforms;
+  std::span<const binary_asset_record> _assets;
+  std::vector<component_block> _components;
+
+}; // class binary_scene_view
+
+} // namespace sbx::scenes
+
+#endif // LIBSBX_SCENES_BINARY_SCENE_HPP_
@@ -0,0 +1,30 @@
+#ifndef LIBSBX_SCENES_COMPONENTS_BOUNDING_VOLUME_HPP_
+#define LIBSBX_SCENES_COMPONENTS_BOUNDING_VOLUME_HPP_
+
+#include <cstdint>
+
+#include <libsbx/math/volume.hpp>
+
+namespace sbx::scenes {
+
+/**
+ * @brief Bounds of a node in its local space. Nodes with bounds are tracked by the spatial index of the scene.
+ *
+ * The bounds can be changed with patch or replace, the scene refits the node on its next spatial index update.
+ */
+struct bounding_volume {
+  math::volume local;
+}; // struct bounding_volume
+
+/**
+ * @brief Entry of a node in the spatial index of the scene. Added and removed together with the bounding_volume and owned by the scene, never modify it.
+ */
+struct spatial_proxy {
+  std::uint32_t id;
+  //! Version of the global transform the world bounds were last fitted to, 0 if the bounds need to be refitted
+  std::uint64_t world_seen{0u};
+}; // struct spatial_proxy
+
+} // namespace sbx::scenes
+
+#endif // LIBSBX_SCENES_COMPONENTS_BOUNDING_VOLUME_HPP_
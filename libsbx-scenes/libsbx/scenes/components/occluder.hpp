@@ -0,0 +1,19 @@
+#ifndef LIBSBX_SCENES_COMPONENTS_OCCLUDER_HPP_
+#define LIBSBX_SCENES_COMPONENTS_OCCLUDER_HPP_
+
+#include <libsbx/math/volume.hpp>
+
+namespace sbx::scenes {
+
+/**
+ * @brief Marks a node as hiding what is behind it for CPU occlusion culling.
+ *
+ * The box is in the local space of the node and has to lie inside of the visible geometry, otherwise objects that are partially visible get culled.
+ */
+struct occluder {
+  math::volume local;
+}; // struct occluder
+
+} // namespace sbx::scenes
+
+#endif // LIBSBX_SCENES_COMPONENTS_OCCLUDER_HPP_
@@ -1,5 +1,8 @@
 #include <libsbx/scenes/scene.hpp>
 
+#include <cstring>
+#include <ranges>
+#include <vector>
 #include <unordered_map>
 
 // #include <portable-file-dialogs.h>
@@ -13,6 +16,7 @@
 #include <libsbx/utility/timer.hpp>
 #include <libsbx/utility/logger.hpp>
 #include <libsbx/utility/target.hpp>
+#include <libsbx/utility/mapped_file.hpp>
 
 #include <libsbx/math/angle.hpp>
 #include <libsbx/math/vector3.hpp>
@@ -39,10 +43,32 @@ namespace sbx::scenes {
 
 scene::scene(const std::filesystem::path& path)
 : _registry{}, 
+  _hierarchy{},
   _root{_registry.create()},
   _camera{_registry.create()},
   _light{math::vector3{-1.0, -1.0, -1.0}, math::color{1.0f, 1.0f, 1.0f, 1.0f}},
-  _octtree{math::volume{math::vector3{-1000.0f, -1000.0f, -1000.0f}, math::vector3{1000.0f, 1000.0f, 1000.0f}}} {
+  _spatial_index{} {
+  _registry.on_construct<scenes::bounding_volume>().connect([this](registry_type& registry, const node_type node) {
+    const auto& bounding_volume = registry.get<scenes::bounding_volume>(node);
+    const auto& world = registry.all_of<scenes::global_transform>(node) ? registry.get<scenes::global_transform>(node).model : math::matrix4x4::identity;
+
+    // world_seen stays 0, so the next update refits the bounds with the final world transform
+    registry.emplace<scenes::spatial_proxy>(node, _spatial_index.insert(math::volume::transformed(bounding_volume.local, world), node));
+  });
+
+  // The proxy lives in its own component, so replacing or patching the bounds keeps it and only schedules a refit
+  _registry.on_update<scenes::bounding_volume>().connect([](registry_type& registry, const node_type node) {
+    registry.get<scenes::spatial_proxy>(node).world_seen = 0u;
+  });
+
+  _registry.on_destroy<scenes::bounding_volume>().connect([](registry_type& registry, const node_type node) {
+    registry.remove<scenes::spatial_proxy>(node);
+  });
+
+  _registry.on_destroy<scenes::spatial_proxy>().connect([this](registry_type& registry, const node_type node) {
+    _spatial_index.remove(registry.get<scenes::spatial_proxy>(node).id);
+  });
+
   // [NOTE] KAJ 2023-10-17 : Initialize root node
   const auto& root_id = add_component<scenes::id>(_root);
   _nodes.insert({root_id, _root});
@@ -70,6 +96,11 @@ scene::scene(const std::filesystem::path& path)
 
   add_component<scenes::camera>(_camera, math::angle{math::degree{60.0f}}, window.aspect_ratio(), 0.1f, 1000.0f);
 
+  if (path.extension() == binary_scene_extension) {
+    _load_binary(path);
+    return;
+  }
+
   // window.on_framebuffer_resized() += [this](const devices::framebuffer_resized_event& event) {
   //   auto& camera = get_component<scenes::camera>(_camera);
   //   camera.set_aspect_ratio(static_cast<std::float_t>(event.width) / static_cast<std::float_t>(event.height));
@@ -91,9 +122,13 @@ scene::scene(const std::filesystem::path& path)
 }
 
 auto scene::create_child_node(const node_type parent, const std::string& tag, const scenes::transform& transform, const selection_tag& selection_tag) -> node_type {
+  return _create_node(parent, scenes::id{}, tag, transform, selection_tag);
+}
+
+auto scene::_create_node(const node_type parent, const scenes::id& id, const std::string& tag, const scenes::transform& transform, const selection_tag& selection_tag) -> node_type {
   auto node = _registry.create();
 
-  const auto& id = add_component<scenes::id>(node);
+  add_component<scenes::id>(node, id);
 
   _nodes.insert({id, node});
 
@@ -108,6 +143,8 @@ auto scene::create_child_node(const node_type parent, const std::string& tag, co
 
   add_component<scenes::selection_tag>(node, selection_tag);
 
+  _hierarchy.invalidate();
+
   return node;
 }
 
@@ -129,6 +166,25 @@ auto scene::destroy_node(const node_type node) -> void {
   _nodes.erase(id);
 
   _registry.destroy(node);
+
+  _hierarchy.invalidate();
+}
+
+auto scene::update_spatial_index() -> void {
+  EASY_FUNCTION();
+
+  for (auto&& [node, proxy, bounding_volume, world] : _registry.view<scenes::spatial_proxy, const scenes::bounding_volume, const scenes::global_transform>().each()) {
+    if (proxy.world_seen == world.version) {
+      continue;
+    }
+
+    const auto bounds = math::volume::transformed(bounding_volume.local, world.model);
+    const auto displacement = bounds.center() - _spatial_index.bounds(proxy.id).center();
+
+    _spatial_index.update(proxy.id, bounds, displacement);
+
+    proxy.world_seen = world.version;
+  }
 }
 
 auto scene::_ensure_world(const node_type node) -> const scenes::global_transform& {
@@ -174,6 +230,12 @@ auto scene::_ensure_world(const node_type node) -> const scenes::global_transfor
   return get_component<scenes::global_transform>(node);
 }
 
+auto scene::world(const node_type node) -> const scenes::global_transform& {
+  EASY_FUNCTION();
+
+  return _ensure_world(node);
+}
+
 auto scene::world_transform(const node_type node) -> math::matrix4x4 {
   EASY_FUNCTION();
 
@@ -242,6 +304,11 @@ auto scene::save(const std::filesystem::path& path)-> void {
 
   const auto resolved_path = assets_module.resolve_path(path);
 
+  if (resolved_path.extension() == binary_scene_extension) {
+    _save_binary(resolved_path);
+    return;
+  }
+
   // _registry.invoke("save", [this](const auto node) {
   //   return (node != _root);
   // });
@@ -301,6 +368,195 @@ auto scene::_load_nodes(const YAML::Node& nodes) -> void {
 
 }
 
+auto scene::_save_binary(const std::filesystem::path& path) -> void {
+  EASY_FUNCTION();
+
+  auto& scenes_module = core::engine::get_module<scenes::scenes_module>();
+
+  auto writer = binary_scene_writer{};
+
+  const auto add_assets = [&writer](const std::string_view type, const auto& metadata) {
+    for (const auto& [handle, entry] : metadata) {
+      writer.add_asset(type, entry.name, entry.path.string(), entry.source);
+    }
+  };
+
+  add_assets("image", _image_metadata);
+  add_assets("cube_image", _cube_image_metadata);
+  add_assets("mesh", _mesh_metadata);
+  add_assets("material", _material_metadata);
+
+  // Depth-first, so that parents are always written before their children
+  auto nodes = std::vector<node_type>{};
+  auto stack = std::vector<std::pair<node_type, std::uint32_t>>{};
+
+  for (const auto child : get_component<scenes::relationship>(_root).children() | std::views::reverse) {
+    stack.emplace_back(child, binary_scene_no_parent);
+  }
+
+  while (!stack.empty()) {
+    const auto [node, parent] = stack.back();
+    stack.pop_back();
+
+    if (!_registry.is_valid(node)) {
+      continue;
+    }
+
+    const auto& transform = get_component<scenes::transform>(node);
+    const auto& position = transform.position();
+    const auto& rotation = transform.rotation();
+    const auto& scale = transform.scale();
+
+    const auto record = binary_transform_record{
+      .position = {position.x(), position.y(), position.z()},
+      .rotation = {rotation.x(), rotation.y(), rotation.z(), rotation.w()},
+      .scale = {scale.x(), scale.y(), scale.z()}
+    };
+
+    const auto flags = (node == _camera) ? binary_node_flags::camera : binary_node_flags::none;
+    const auto index = writer.add_node(get_component<scenes::id>(node).value(), parent, get_component<scenes::tag>(node).str(), record, flags);
+
+    nodes.push_back(node);
+
+    for (const auto child : get_component<scenes::relationship>(node).children() | std::views::reverse) {
+      stack.emplace_back(child, index);
+    }
+  }
+
+  for (auto&& [type, container] : _registry.storage()) {
+    if (!scenes_module.has_component_io(type)) {
+      continue;
+    }
+
+    auto& component_io = scenes_module.component_io(type);
+
+    if (!component_io.save_binary) {
+      continue;
+    }
+
+    auto indices = std::vector<std::uint32_t>{};
+    auto payload = std::vector<std::byte>{};
+    auto payload_writer = ecs::snapshot_writer{payload};
+
+    for (auto index = 0u; index < nodes.size(); ++index) {
+      if (!container.contains(nodes[index])) {
+        continue;
+      }
+
+      const auto start = payload.size();
+
+      payload_writer.write(std::uint64_t{0u});
+      component_io.save_binary(payload_writer, *this, nodes[index]);
+
+      const auto length = std::uint64_t{payload.size() - start - sizeof(std::uint64_t)};
+      std::memcpy(payload.data() + start, &length, sizeof(length));
+
+      indices.push_back(index);
+    }
+
+    if (!indices.empty()) {
+      writer.add_component(component_io.name, std::move(indices), std::move(payload));
+    }
+  }
+
+  utility::logger<"scenes">::debug("Writing binary scene with {} nodes to {}", nodes.size(), path.string());
+
+  writer.write(path);
+}
+
+auto scene::_load_binary(const std::filesystem::path& path) -> void {
+  EASY_FUNCTION();
+
+  auto& scenes_module = core::engine::get_module<scenes::scenes_module>();
+
+  const auto file = utility::mapped_file{path};
+  const auto view = binary_scene_view{file.data()};
+
+  for (const auto& asset : view.assets()) {
+    const auto type = view.string(asset.type);
+    const auto name = std::string{view.string(asset.name)};
+    const auto asset_path = std::filesystem::path{view.string(asset.path)};
+
+    // Meshes and materials are owned by other modules, components reference them by name and they have to be added before loading
+    if (type == "image" && !_image_ids.contains(name)) {
+      add_image(name, asset_path);
+    } else if (type == "cube_image" && !_cube_image_ids.contains(name)) {
+      add_cube_image(name, asset_path);
+    }
+  }
+
+  const auto records = view.nodes();
+  const auto transforms = view.transforms();
+
+  const auto reserve = [this, &records]<typename... Type>() {
+    (_registry.storage<Type>().reserve(_registry.storage<Type>().size() + records.size()), ...);
+  };
+
+  reserve.template operator()<scenes::id, scenes::relationship, scenes::global_transform, scenes::transform, scenes::tag, scenes::selection_tag>();
+
+  _nodes.reserve(_nodes.size() + records.size());
+
+  auto nodes = std::vector<node_type>{};
+  nodes.reserve(records.size());
+
+  for (auto index = 0u; index < records.size(); ++index) {
+    const auto& record = records[index];
+    const auto& data = transforms[index];
+
+    const auto transform = scenes::transform{
+      math::vector3{data.position[0], data.position[1], data.position[2]},
+      math::quaternion{data.rotation[0], data.rotation[1], data.rotation[2], data.rotation[3]},
+      math::vector3{data.scale[0], data.scale[1], data.scale[2]}
+    };
+
+    const auto id = scenes::id{math::uuid::from_value(record.id)};
+    const auto tag = std::string{view.string(record.tag)};
+
+    if ((std::to_underlying(record.flags) & std::to_underlying(binary_node_flags::camera)) != 0u) {
+      // The camera node always exists, it only takes over the saved state
+      _nodes.erase(get_component<scenes::id>(_camera));
+      _nodes.insert({id, _camera});
+
+      get_component<scenes::id>(_camera) = id;
+      get_component<scenes::transform>(_camera) = transform;
+      get_component<scenes::tag>(_camera) = scenes::tag{tag};
+
+      nodes.push_back(_camera);
+
+      continue;
+    }
+
+    const auto parent = (record.parent != binary_scene_no_parent) ? nodes[record.parent] : _root;
+
+    nodes.push_back(_create_node(parent, id, tag, transform, selection_tag::null));
+  }
+
+  for (const auto& block : view.components()) {
+    const auto name = std::string{block.name};
+
+    if (!scenes_module.has_component_io(name) || !scenes_module.component_io(name).load_binary) {
+      utility::logger<"scenes">::warn("Skipping unknown component '{}' in scene {}", name, path.string());
+      continue;
+    }
+
+    auto& component_io = scenes_module.component_io(name);
+
+    auto reader = ecs::snapshot_reader{block.payload};
+
+    for (const auto index : block.nodes) {
+      auto record = ecs::snapshot_reader{reader.read_bytes(reader.read<std::uint64_t>())};
+
+      try {
+        component_io.load_binary(record, *this, nodes[index]);
+      } catch (const std::exception& exception) {
+        utility::logger<"scenes">::warn("Could not load component '{}' of node {}: {}", name, view.string(records[index].tag), exception.what());
+      }
+    }
+  }
+
+  utility::logger<"scenes">::debug("Loaded binary scene {} with {} nodes", path.string(), nodes.size());
+}
+
 auto scene::_save_assets(YAML::Emitter& emitter) -> void {
   emitter << YAML::Key << "images";
   emitter << YAML::Value << YAML::BeginSeq;
@@ -4,8 +4,10 @@
 #include <algorithm>
 #include <filesystem>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <numbers>
+#include <optional>
 #include <ranges>
 #include <ranges>
 #include <typeindex>
@@ -22,15 +24,20 @@
 #include <libsbx/utility/hashed_string.hpp>
 #include <libsbx/utility/iterator.hpp>
 
-#include <libsbx/containers/octree.hpp>
+#include <libsbx/containers/dynamic_aabb_tree.hpp>
 
 #include <libsbx/ecs/registry.hpp>
+#include <libsbx/ecs/observer.hpp>
+#include <libsbx/ecs/command_buffer.hpp>
+#include <libsbx/ecs/snapshot.hpp>
 #include <libsbx/ecs/entity.hpp>
+#include <libsbx/ecs/parallel.hpp>
 
 #include <libsbx/math/uuid.hpp>
 #include <libsbx/math/vector3.hpp>
 #include <libsbx/math/quaternion.hpp>
 #include <libsbx/math/matrix_cast.hpp>
+#include <libsbx/math/ray.hpp>
 
 #include <libsbx/core/engine.hpp>
 
@@ -42,6 +49,8 @@
 #include <libsbx/signals/signal.hpp>
 
 #include <libsbx/scenes/node.hpp>
+#include <libsbx/scenes/transform_hierarchy.hpp>
+#include <libsbx/scenes/binary_scene.hpp>
 #include <libsbx/scenes/components/directional_light.hpp>
 #include <libsbx/scenes/components/id.hpp>
 #include <libsbx/scenes/components/selection_tag.hpp>
@@ -49,6 +58,7 @@
 #include <libsbx/scenes/components/camera.hpp>
 #include <libsbx/scenes/components/transform.hpp>
 #include <libsbx/scenes/components/global_transform.hpp>
+#include <libsbx/scenes/components/bounding_volume.hpp>
 #include <libsbx/scenes/components/static_mesh.hpp>
 #include <libsbx/scenes/components/skinned_mesh.hpp>
 
@@ -62,6 +72,10 @@ public:
 
   using node_type = node;
   using registry_type = ecs::basic_registry<node_type>;
+  using observer_type = ecs::basic_observer<registry_type>;
+  using command_buffer_type = ecs::basic_command_buffer<registry_type>;
+  using hierarchy_type = basic_transform_hierarchy<registry_type>;
+  using spatial_index_type = containers::dynamic_aabb_tree<node_type>;
 
   // template<typename... Get, typename... Exclude>
   // using query_result = ecs::basic_view
@@ -74,8 +88,17 @@ public:
 
   scene(const std::filesystem::path& path);
 
+  // The scene listens to signals of its own registry, so it has to stay in place
+  scene(const scene& other) = delete;
+
+  scene(scene&& other) = delete;
+
   virtual ~scene() = default;
 
+  auto operator=(const scene& other) -> scene& = delete;
+
+  auto operator=(scene&& other) -> scene& = delete;
+
   auto create_child_node(const node_type parent, const std::string& tag = "Node", const scenes::transform& transform = scenes::transform{}, const selection_tag& selection_tag = selection_tag::null) -> node_type;
 
   auto create_node(const std::string& tag = "Node", const scenes::transform& transform = scenes::transform{}, const selection_tag& selection_tag = selection_tag::null) -> node_type;  
@@ -90,6 +113,11 @@ public:
     _camera = camera;
   }
 
+  /**
+   * @brief Returns the world and normal matrix of the node, updating it and its ancestors if needed.
+   */
+  auto world(const node_type node) -> const scenes::global_transform&;
+
   auto world_transform(const node_type node) -> math::matrix4x4;
 
   auto world_normal(const node_type node) -> math::matrix4x4;
@@ -102,6 +130,45 @@ public:
 
   auto world_scale(const node_type node) -> math::vector3;
 
+  /**
+   * @brief Recomputes the world transforms of all nodes in one batched pass instead of lazily per query.
+   */
+  auto update_hierarchy() -> void {
+    _hierarchy.update(_registry, _root);
+    update_spatial_index();
+  }
+
+  template<ecs::parallel_executor Executor>
+  auto update_hierarchy(Executor& executor) -> void {
+    _hierarchy.update(_registry, _root, executor);
+    update_spatial_index();
+  }
+
+  /**
+   * @brief Refits the world bounds of all nodes with a bounding_volume whose world transform or bounds changed. Called by update_hierarchy.
+   */
+  auto update_spatial_index() -> void;
+
+  /**
+   * @brief Dynamic AABB tree over the world bounds of all nodes with a bounding_volume component, for culling and proximity queries.
+   *
+   * Bounds are refitted by update_spatial_index, queries in between see the bounds as of the last update.
+   */
+  auto spatial_index() const -> const spatial_index_type& {
+    return _spatial_index;
+  }
+
+  /**
+   * @brief Returns the closest node whose world bounds are hit by the ray.
+   */
+  auto pick(const math::ray& ray, const std::float_t max_distance = std::numeric_limits<std::float_t>::max()) const -> std::optional<node_type> {
+    if (const auto hit = _spatial_index.ray_cast(ray, max_distance); hit) {
+      return hit->value;
+    }
+
+    return std::nullopt;
+  }
+
   auto is_valid(const node_type node) const -> bool {
     return _registry.is_valid(node);
   }
@@ -116,6 +183,40 @@ public:
     return _registry.view<Type, Other...>(ecs::exclude<Exclude...>);
   }
 
+  template<typename... Owned, typename... Get, typename... Exclude>
+  auto group(ecs::get_t<Get...> = ecs::get_t{}, ecs::exclude_t<Exclude...> = ecs::exclude_t{}) -> decltype(auto) {
+    return _registry.group<Owned...>(ecs::get<Get...>, ecs::exclude<Exclude...>);
+  }
+
+  /**
+   * @brief Applies the commands recorded in the buffer to the scene. Must be called from a sync point, i.e. while no system iterates the scene.
+   *
+   * Nodes created or destroyed through a command buffer are plain entities, they are not linked into the node hierarchy.
+   */
+  auto playback(command_buffer_type& buffer) -> void {
+    buffer.playback(_registry);
+  }
+
+  template<bool Construct, bool Update, typename... Type, typename... Get, typename... Exclude>
+  auto observe(ecs::watch_t<Construct, Update, Type...> watch, ecs::get_t<Get...> = ecs::get_t{}, ecs::exclude_t<Exclude...> = ecs::exclude_t{}) -> observer_type {
+    return observer_type{_registry, watch, ecs::get<Get...>, ecs::exclude<Exclude...>};
+  }
+
+  template<typename Component>
+  auto on_component_added() -> registry_type::signal_type& {
+    return _registry.on_construct<Component>();
+  }
+
+  template<typename Component>
+  auto on_component_updated() -> registry_type::signal_type& {
+    return _registry.on_update<Component>();
+  }
+
+  template<typename Component>
+  auto on_component_removed() -> registry_type::signal_type& {
+    return _registry.on_destroy<Component>();
+  }
+
   template<typename Type, typename Compare, typename Sort = utility::std_sort, typename... Args>
   auto sort(Compare compare, Sort sort = Sort{}, Args&&... args) -> void {
     _registry.sort<Type>(std::move(compare), std::move(sort), std::forward<Args>(args)...);
@@ -141,6 +242,11 @@ public:
     return _registry.get<Component>(node);
   }
 
+  template<typename Component, typename... Function>
+  auto patch_component(const node_type node, Function&&... function) -> Component& {
+    return _registry.patch<Component>(node, std::forward<Function>(function)...);
+  }
+
   template<typename Component, typename... Args>
   auto get_or_add_component(const node_type node, Args&&... args) -> Component& {
     return _registry.get_or_emplace<Component>(node, std::forward<Args>(args)...);
@@ -218,6 +324,9 @@ public:
     return node_type::null;
   }
 
+  /**
+   * @brief Saves the scene. Paths with the binary_scene_extension are written in the binary scene format, all others as YAML.
+   */
   auto save(const std::filesystem::path& path)-> void;
 
   template<typename... Args>
@@ -377,17 +486,24 @@ private:
 
   auto _load_nodes(const YAML::Node& nodes) -> void;
 
+  auto _save_binary(const std::filesystem::path& path) -> void;
+
+  auto _load_binary(const std::filesystem::path& path) -> void;
+
+  auto _create_node(const node_type parent, const scenes::id& id, const std::string& tag, const scenes::transform& transform, const selection_tag& selection_tag) -> node_type;
+
   auto _ensure_world(const node_type node) -> const scenes::global_transform&;
 
   std::unordered_map<math::uuid, node_type> _nodes;
 
   registry_type _registry;
+  hierarchy_type _hierarchy;
   node_type _root;
   node_type _camera;
 
   std::string _name;
 
-  containers::octree<math::uuid> _octtree;
+  spatial_index_type _spatial_index;
 
   directional_light _light;
 
@@ -410,6 +526,8 @@ struct component_io {
   std::string name;
   std::function<void(YAML::Emitter&, scene& scene, const node)> save; 
   std::function<void(const YAML::Node&, scene& scene, const node)> load; 
+  std::function<void(ecs::snapshot_writer&, scene& scene, const node)> save_binary;
+  std::function<void(ecs::snapshot_reader&, scene& scene, const node)> load_binary;
 }; // struct component_io
 
 class component_io_registry {
@@ -422,16 +540,40 @@ public:
 
     _by_name[name] = id;
 
-    _by_id[id] = component_io{
-      .name = name,
-      .save = [name, s = std::forward<Save>(save)](YAML::Emitter& yaml, scene& scene, const node node) -> void {
-        const auto& component = scene.get_component<Type>(node);
+    auto& entry = _by_id[id];
+
+    entry.name = name;
+
+    entry.save = [name, s = std::forward<Save>(save)](YAML::Emitter& yaml, scene& scene, const node node) -> void {
+      const auto& component = scene.get_component<Type>(node);
+
+      std::invoke(s, yaml, scene, component);
+    };
+
+    entry.load = [name, l = std::forward<Load>(load)](const YAML::Node& yaml, scene& scene, const node node) -> void {
+      scene.add_component<Type>(node, std::invoke(l, yaml));
+    };
+  }
+
+  /**
+   * @brief Registers the hooks used by the binary scene format. The component is identified by name, which may be shared with the YAML hooks.
+   */
+  template<typename Type, std::invocable<ecs::snapshot_writer&, scene&, const Type&> Save, std::invocable<ecs::snapshot_reader&, scene&> Load>
+  auto register_binary_component(const std::string& name, Save&& save, Load&& load) -> void {
+    const auto id = ecs::type_id<Type>::value();
+
+    _by_name[name] = id;
+
+    auto& entry = _by_id[id];
+
+    entry.name = name;
+
+    entry.save_binary = [s = std::forward<Save>(save)](ecs::snapshot_writer& writer, scene& scene, const node node) -> void {
+      std::invoke(s, writer, scene, scene.get_component<Type>(node));
+    };
 
-        std::invoke(s, yaml, scene, component);
-      },
-      .load = [name, l = std::forward<Load>(load)](const YAML::Node& yaml, scene& scene, const node node) -> void {
-        scene.add_component<Type>(node, std::invoke(l, yaml));
-      }
+    entry.load_binary = [l = std::forward<Load>(load)](ecs::snapshot_reader& reader, scene& scene, const node node) -> void {
+      scene.add_component<Type>(node, std::invoke(l, reader, scene));
     };
   }
 
@@ -447,6 +589,10 @@ public:
     return _by_id.at(_by_name.at(name));
   }
 
+  auto has(const std::string& name) -> bool {
+    return _by_name.contains(name);
+  }
+
 private:
 
   std::unordered_map<std::uint32_t, component_io> _by_id;
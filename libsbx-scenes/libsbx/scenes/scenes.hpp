@@ -5,6 +5,7 @@
 
 #include <libsbx/scenes/scenes_module.hpp>
 #include <libsbx/scenes/scene.hpp>
+#include <libsbx/scenes/binary_scene.hpp>
 #include <libsbx/scenes/hierarchy_module.hpp>
 
 #include <libsbx/scenes/skybox_subrenderer.hpp>
@@ -21,5 +22,7 @@
 #include <libsbx/scenes/components/gizmo.hpp>
 #include <libsbx/scenes/components/skybox.hpp>
 #include <libsbx/scenes/components/selection_tag.hpp>
+#include <libsbx/scenes/components/bounding_volume.hpp>
+#include <libsbx/scenes/components/occluder.hpp>
 
 #endif // LIBSBX_SCENE_HPP_
@@ -3,6 +3,7 @@
 #include <libsbx/assets/assets_module.hpp>
 
 #include <libsbx/scenes/scene.hpp>
+#include <libsbx/scenes/hierarchy_module.hpp>
 
 #include <libsbx/scenes/components/transform.hpp>
 #include <libsbx/scenes/components/skybox.hpp>
@@ -73,6 +74,55 @@ scenes_module::scenes_module()
       return {math::uuid::null(), math::uuid::null()};
     }
   );
+
+  _component_io_registry.register_binary_component<scenes::point_light>(
+    "point_light",
+    [](ecs::snapshot_writer& writer, scenes::scene& scene, const scenes::point_light& point_light) -> void {
+      const auto& color = point_light.color();
+
+      writer.write(color.r());
+      writer.write(color.g());
+      writer.write(color.b());
+      writer.write(color.a());
+      writer.write(point_light.radius());
+    },
+    [](ecs::snapshot_reader& reader, scenes::scene& scene) -> scenes::point_light {
+      const auto r = reader.read<std::float_t>();
+      const auto g = reader.read<std::float_t>();
+      const auto b = reader.read<std::float_t>();
+      const auto a = reader.read<std::float_t>();
+
+      return {math::color{r, g, b, a}, reader.read<std::float_t>()};
+    }
+  );
+
+  // Meshes and materials are referenced by name, they have to be added to the scene under the same names before loading
+  _component_io_registry.register_binary_component<scenes::static_mesh>(
+    "static_mesh",
+    [](ecs::snapshot_writer& writer, scenes::scene& scene, const scenes::static_mesh& static_mesh) -> void {
+      writer.write_string(scene.mesh_metadata(static_mesh.mesh_id()).name);
+      writer.write(static_cast<std::uint32_t>(static_mesh.submeshes().size()));
+
+      for (const auto& submesh : static_mesh.submeshes()) {
+        writer.write(submesh.index);
+        writer.write_string(scene.material_metadata(submesh.material).name);
+      }
+    },
+    [](ecs::snapshot_reader& reader, scenes::scene& scene) -> scenes::static_mesh {
+      const auto mesh = scene.get_mesh(reader.read_string());
+      const auto count = reader.read<std::uint32_t>();
+
+      auto submeshes = std::vector<scenes::static_mesh::submesh>{};
+      submeshes.reserve(count);
+
+      for (auto i = 0u; i < count; ++i) {
+        const auto index = reader.read<std::uint32_t>();
+        submeshes.push_back({index, scene.get_material(reader.read_string())});
+      }
+
+      return {mesh, submeshes};
+    }
+  );
 }
 
 scenes_module::~scenes_module() {
@@ -101,10 +151,18 @@ auto scenes_module::component_io(const std::uint32_t id) -> scenes::component_io
   return _component_io_registry.get(id);
 }
 
+auto scenes_module::component_io(const std::string& name) -> scenes::component_io& {
+  return _component_io_registry.get(name);
+}
+
 auto scenes_module::has_component_io(const std::uint32_t id) -> bool {
   return _component_io_registry.has(id);
 }
 
+auto scenes_module::has_component_io(const std::string& name) -> bool {
+  return _component_io_registry.has(name);
+}
+
 auto scenes_module::debug_lines() const -> const std::vector<line>& {
   return _debug_lines;
 }
@@ -13,13 +13,16 @@
 
 #include <libsbx/scenes/scene.hpp>
 
+#include <libsbx/scenes/components/relationship.hpp>
+
 namespace sbx::scenes {
 
 class scenes_module final : public core::module<scenes_module> {
 
   friend class scene;
 
-  inline static const auto is_registered = register_module(stage::normal);
+  // The scene uniforms are updated from the camera, world transforms are resolved lazily
+  inline static const auto is_registered = register_module(stage::normal, reads<scenes::camera, scenes::transform, scenes::relationship>{}, writes<scenes::global_transform, scenes::scene>{});
 
 public:
 
@@ -49,10 +52,19 @@ public:
     _component_io_registry.register_component<Type>(name, std::forward<Save>(save), std::forward<Load>(load));
   }
 
+  template<typename Type, std::invocable<ecs::snapshot_writer&, scenes::scene&, const Type&> Save, std::invocable<ecs::snapshot_reader&, scenes::scene&> Load>
+  auto register_binary_component(const std::string& name, Save&& save, Load&& load) -> void {
+    _component_io_registry.register_binary_component<Type>(name, std::forward<Save>(save), std::forward<Load>(load));
+  }
+
   auto component_io(const std::uint32_t id) -> component_io&;
 
+  auto component_io(const std::string& name) -> scenes::component_io&;
+
   auto has_component_io(const std::uint32_t id) -> bool;
 
+  auto has_component_io(const std::string& name) -> bool;
+
   auto debug_lines() const -> const std::vector<line>&;
 
   auto clear_debug_lines() -> void;
@@ -0,0 +1,253 @@
+#ifndef LIBSBX_SCENES_TRANSFORM_HIERARCHY_HPP_
+#define LIBSBX_SCENES_TRANSFORM_HIERARCHY_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <vector>
+#include <utility>
+
+#include <libsbx/math/matrix4x4.hpp>
+
+#include <libsbx/ecs/registry.hpp>
+#include <libsbx/ecs/parallel.hpp>
+
+#include <libsbx/scenes/node.hpp>
+#include <libsbx/scenes/components/relationship.hpp>
+#include <libsbx/scenes/components/transform.hpp>
+#include <libsbx/scenes/components/global_transform.hpp>
+
+namespace sbx::scenes {
+
+/**
+ * @brief Propagates local transforms to world transforms for a whole node hierarchy at once.
+ *
+ * The nodes are kept in depth-first order in packed arrays, so every parent is processed before its children and a subtree is a contiguous range.
+ * An update is a single linear pass that compares versions and only recomputes the world and normal matrices of nodes whose local transform or parent changed.
+ * Subtrees that do not share an ancestor below the split points are processed in parallel.
+ *
+ * The versions written to global_transform are the ones scene::world_transform uses for its lazy updates, so both can be mixed freely.
+ * The order is rebuilt lazily after invalidate() was called, which has to happen whenever nodes are added, removed or reparented.
+ *
+ * @tparam Registry The registry type the nodes live in.
+ */
+template<typename Registry>
+class basic_transform_hierarchy {
+
+  inline static constexpr auto npos = std::numeric_limits<std::uint32_t>::max();
+
+  struct range {
+    std::uint32_t first;
+    std::uint32_t last;
+  }; // struct range
+
+public:
+
+  using registry_type = Registry;
+  using node_type = typename registry_type::entity_type;
+  using size_type = std::size_t;
+
+  /**
+   * @brief Subtrees up to this many nodes are never split between threads.
+   */
+  inline static constexpr auto segment_size = std::uint32_t{512u};
+
+  basic_transform_hierarchy()
+  : _root{node_type::null},
+    _is_outdated{true} { }
+
+  /**
+   * @brief Marks the order as outdated. It is rebuilt by the next update.
+   */
+  auto invalidate() noexcept -> void {
+    _is_outdated = true;
+  }
+
+  [[nodiscard]] auto size() const noexcept -> size_type {
+    return _nodes.size();
+  }
+
+  /**
+   * @brief The nodes in depth-first order as of the last update.
+   */
+  [[nodiscard]] auto nodes() const noexcept -> std::span<const node_type> {
+    return _nodes;
+  }
+
+  auto update(registry_type& registry, const node_type root) -> void {
+    auto executor = ecs::sequential_executor{};
+    update(registry, root, executor);
+  }
+
+  /**
+   * @brief Updates the world transforms of the hierarchy below root.
+   *
+   * Must not run concurrently with anything that adds or removes transform, global_transform or relationship components.
+   */
+  template<ecs::parallel_executor Executor>
+  auto update(registry_type& registry, const node_type root, Executor& executor) -> void {
+    if (_is_outdated || _root != root) {
+      _rebuild(registry, root);
+    }
+
+    if (_nodes.empty()) {
+      return;
+    }
+
+    // Resolve the storages up front, worker threads must not touch the type ids of the registry
+    auto& transforms = registry.template storage<scenes::transform>();
+    auto& global_transforms = registry.template storage<scenes::global_transform>();
+
+    for (const auto index : _serial) {
+      _propagate(transforms, global_transforms, index);
+    }
+
+    executor.parallel_for(_segments.size(), [this, &transforms, &global_transforms](const std::size_t segment) {
+      const auto [first, last] = _segments[segment];
+
+      for (auto index = first; index < last; ++index) {
+        _propagate(transforms, global_transforms, index);
+      }
+    });
+  }
+
+private:
+
+  template<typename Transforms, typename GlobalTransforms>
+  auto _propagate(const Transforms& transforms, GlobalTransforms& global_transforms, const std::uint32_t index) -> void {
+    const auto node = _nodes[index];
+    const auto parent = _parents[index];
+
+    const auto& local = transforms.get(node);
+    auto& world = global_transforms.get(node);
+
+    const auto parent_version = (parent != npos) ? _versions[parent] : std::uint64_t{0u};
+
+    if (world.local_seen != local.version() || world.parent_seen != parent_version) {
+      const auto& parent_world = (parent != npos) ? _world[parent] : math::matrix4x4::identity;
+
+      world.model = parent_world * local.local_transform();
+      world.normal = math::matrix4x4::transposed(math::matrix4x4::inverted(world.model));
+      world.local_seen = local.version();
+      world.parent_seen = parent_version;
+
+      ++world.version;
+    }
+
+    // Also picks up nodes that were updated lazily through the scene since the last pass
+    if (_versions[index] != world.version) {
+      _world[index] = world.model;
+      _versions[index] = world.version;
+    }
+  }
+
+  auto _rebuild(registry_type& registry, const node_type root) -> void {
+    _root = root;
+    _is_outdated = false;
+
+    _nodes.clear();
+    _parents.clear();
+    _ends.clear();
+    _serial.clear();
+    _segments.clear();
+
+    if (!_is_hierarchy_node(registry, root)) {
+      _world.clear();
+      _versions.clear();
+      return;
+    }
+
+    auto stack = std::vector<std::pair<node_type, std::uint32_t>>{};
+    stack.emplace_back(root, npos);
+
+    while (!stack.empty()) {
+      const auto [current, parent] = stack.back();
+      stack.pop_back();
+
+      const auto index = static_cast<std::uint32_t>(_nodes.size());
+
+      _nodes.push_back(current);
+      _parents.push_back(parent);
+
+      const auto& children = registry.template get<scenes::relationship>(current).children();
+
+      // Pushed in reverse so that children end up in their original order
+      for (auto child = children.rbegin(); child != children.rend(); ++child) {
+        if (_is_hierarchy_node(registry, *child)) {
+          stack.emplace_back(*child, index);
+        }
+      }
+    }
+
+    const auto count = static_cast<std::uint32_t>(_nodes.size());
+
+    _ends.resize(count);
+
+    for (auto index = 0u; index < count; ++index) {
+      _ends[index] = index + 1u;
+    }
+
+    for (auto index = count - 1u; index > 0u; --index) {
+      _ends[_parents[index]] = std::max(_ends[_parents[index]], _ends[index]);
+    }
+
+    _split(0u);
+
+    _world.resize(count);
+    _versions.resize(count);
+
+    // Seed the cached parent data, clean nodes are not written by the next update
+    for (auto index = 0u; index < count; ++index) {
+      const auto& world = registry.template get<scenes::global_transform>(_nodes[index]);
+
+      _world[index] = world.model;
+      _versions[index] = world.version;
+    }
+  }
+
+  /**
+   * @brief Schedules the subtree at index. Small subtrees become a parallel segment, the root of a large one is processed serially and its children are split further.
+   */
+  auto _split(const std::uint32_t index) -> void {
+    if (_ends[index] - index <= segment_size) {
+      if (!_segments.empty() && _segments.back().last == index && _ends[index] - _segments.back().first <= segment_size) {
+        _segments.back().last = _ends[index];
+      } else {
+        _segments.push_back(range{index, _ends[index]});
+      }
+
+      return;
+    }
+
+    _serial.push_back(index);
+
+    for (auto child = index + 1u; child < _ends[index]; child = _ends[child]) {
+      _split(child);
+    }
+  }
+
+  [[nodiscard]] static auto _is_hierarchy_node(const registry_type& registry, const node_type node) -> bool {
+    return node != node_type::null && registry.is_valid(node) && registry.template all_of<scenes::relationship, scenes::transform, scenes::global_transform>(node);
+  }
+
+  node_type _root;
+  bool _is_outdated;
+
+  std::vector<node_type> _nodes;
+  std::vector<std::uint32_t> _parents;
+  std::vector<std::uint32_t> _ends;
+
+  std::vector<math::matrix4x4> _world;
+  std::vector<std::uint64_t> _versions;
+
+  std::vector<std::uint32_t> _serial;
+  std::vector<range> _segments;
+
+}; // class basic_transform_hierarchy
+
+using transform_hierarchy = basic_transform_hierarchy<ecs::basic_registry<node>>;
+
+} // namespace sbx::scenes
+
+#endif // LIBSBX_SCENES_TRANSFORM_HIERARCHY_HPP_
@@ -0,0 +1,64 @@
+#ifndef LIBSBX_SCENES_BINARY_SCENE_TESTS_HPP_
+#define LIBSBX_SCENES_BINARY_SCENE_TESTS_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <libsbx/utility/exception.hpp>
+
+#include <libsbx/ecs/snapshot.hpp>
+
+#include <libsbx/scenes/binary_scene.hpp>
+
+TEST(libsbx_scenes_binary_scene, round_trips_through_view) {
+  auto writer = sbx::scenes::binary_scene_writer{};
+
+  const auto transform = sbx::scenes::binary_transform_record{{1.0f, 2.0f, 3.0f}, {0.0f, 0.0f, 0.0f, 1.0f}, {1.0f, 1.0f, 1.0f}};
+
+  const auto parent = writer.add_node(42u, sbx::scenes::binary_scene_no_parent, "parent", transform);
+  const auto child = writer.add_node(43u, parent, "child", transform, sbx::scenes::binary_node_flags::camera);
+
+  writer.add_asset("image", "albedo", "textures/albedo.png", "disk");
+
+  auto payload = std::vector<std::byte>{};
+  auto payload_writer = sbx::ecs::snapshot_writer{payload};
+
+  payload_writer.write(std::uint64_t{sizeof(std::float_t)});
+  payload_writer.write(std::float_t{0.5f});
+
+  writer.add_component("point_light", {child}, std::move(payload));
+
+  const auto data = writer.build();
+  const auto view = sbx::scenes::binary_scene_view{data};
+
+  ASSERT_EQ(view.nodes().size(), 2u);
+  EXPECT_EQ(view.nodes()[0].id, 42u);
+  EXPECT_EQ(view.nodes()[1].parent, parent);
+  EXPECT_EQ(view.nodes()[1].flags, sbx::scenes::binary_node_flags::camera);
+  EXPECT_EQ(view.string(view.nodes()[1].tag), "child");
+  EXPECT_FLOAT_EQ(view.transforms()[1].position[2], 3.0f);
+
+  ASSERT_EQ(view.assets().size(), 1u);
+  EXPECT_EQ(view.string(view.assets()[0].path), "textures/albedo.png");
+
+  ASSERT_EQ(view.components().size(), 1u);
+  EXPECT_EQ(view.components()[0].name, "point_light");
+  EXPECT_EQ(view.components()[0].nodes[0], child);
+
+  auto reader = sbx::ecs::snapshot_reader{view.components()[0].payload};
+  auto record = sbx::ecs::snapshot_reader{reader.read_bytes(reader.read<std::uint64_t>())};
+
+  EXPECT_FLOAT_EQ(record.read<std::float_t>(), 0.5f);
+
+  auto corrupted = data;
+  corrupted[0] = std::byte{'X'};
+
+  EXPECT_THROW(sbx::scenes::binary_scene_view{corrupted}, sbx::utility::runtime_error);
+  EXPECT_THROW(sbx::scenes::binary_scene_view{std::span{data}.first(20u)}, sbx::utility::runtime_error);
+}
+
+#endif // LIBSBX_SCENES_BINARY_SCENE_TESTS_HPP_
@@ -1,12 +1,93 @@
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include <libsbx/containers/executor.hpp>
+
 #include <libsbx/scenes/scenes_module.hpp>
+#include <libsbx/scenes/transform_hierarchy.hpp>
 
+#include <tests/binary_scene_tests.hpp>
 
 TEST(libsbx_scenes_scene, initialize) {
   
 }
 
+TEST(libsbx_scenes_transform_hierarchy, propagates_world_transforms) {
+  using registry_type = sbx::ecs::basic_registry<sbx::scenes::node>;
+
+  auto registry = registry_type{};
+  auto hierarchy = sbx::scenes::basic_transform_hierarchy<registry_type>{};
+
+  const auto add_node = [&registry](const sbx::scenes::node parent, const sbx::math::vector3& position) {
+    const auto node = registry.create();
+
+    registry.emplace<sbx::scenes::relationship>(node, parent);
+    registry.emplace<sbx::scenes::transform>(node, position);
+    registry.emplace<sbx::scenes::global_transform>(node);
+
+    if (parent != sbx::scenes::node::null) {
+      registry.get<sbx::scenes::relationship>(parent).add_child(node);
+    }
+
+    return node;
+  };
+
+  const auto root = add_node(sbx::scenes::node::null, sbx::math::vector3{1.0f, 0.0f, 0.0f});
+
+  auto leaves = std::vector<sbx::scenes::node>{};
+
+  // Wide enough to be split into several segments
+  for (auto i = 0u; i < 8u; ++i) {
+    auto parent = add_node(root, sbx::math::vector3{0.0f, 1.0f, 0.0f});
+
+    for (auto depth = 0u; depth < 200u; ++depth) {
+      parent = add_node(parent, sbx::math::vector3{0.0f, 0.0f, 1.0f});
+    }
+
+    leaves.push_back(parent);
+  }
+
+  auto executor = sbx::containers::executor{4u};
+  auto parallel = sbx::ecs::task_executor{executor};
+
+  hierarchy.update(registry, root, parallel);
+
+  EXPECT_EQ(hierarchy.size(), 1u + 8u * 201u);
+  EXPECT_EQ(hierarchy.nodes().front(), root);
+
+  for (const auto leaf : leaves) {
+    const auto position = sbx::math::vector3{registry.get<sbx::scenes::global_transform>(leaf).model[3]};
+
+    EXPECT_FLOAT_EQ(position.x(), 1.0f);
+    EXPECT_FLOAT_EQ(position.y(), 1.0f);
+    EXPECT_FLOAT_EQ(position.z(), 200.0f);
+  }
+
+  const auto version = registry.get<sbx::scenes::global_transform>(leaves[1]).version;
+
+  registry.get<sbx::scenes::transform>(root).set_position(sbx::math::vector3{2.0f, 0.0f, 0.0f});
+  registry.get<sbx::scenes::transform>(registry.get<sbx::scenes::relationship>(leaves[0]).parent()).move_by(sbx::math::vector3{0.0f, 0.0f, 1.0f});
+
+  hierarchy.update(registry, root, parallel);
+
+  const auto first = sbx::math::vector3{registry.get<sbx::scenes::global_transform>(leaves[0]).model[3]};
+  const auto second = sbx::math::vector3{registry.get<sbx::scenes::global_transform>(leaves[1]).model[3]};
+
+  EXPECT_FLOAT_EQ(first.x(), 2.0f);
+  EXPECT_FLOAT_EQ(first.z(), 201.0f);
+  EXPECT_FLOAT_EQ(second.x(), 2.0f);
+  EXPECT_FLOAT_EQ(second.z(), 200.0f);
+  EXPECT_GT(registry.get<sbx::scenes::global_transform>(leaves[1]).version, version);
+
+  // Nothing changed, nothing is recomputed
+  const auto unchanged = registry.get<sbx::scenes::global_transform>(leaves[1]).version;
+
+  hierarchy.update(registry, root);
+
+  EXPECT_EQ(registry.get<sbx::scenes::global_transform>(leaves[1]).version, unchanged);
+}
+
 auto main(int argc, char* argv[]) -> int {
   testing::InitGoogleTest(&argc, argv);
 
@@ -24,6 +24,7 @@ struct scripts {
 
 class scripting_module final : public core::module<scripting_module> {
 
+  // Stays exclusive, scripts may access any component
   inline static const auto is_registered = register_module(stage::normal, dependencies<scenes::scenes_module>{});
 
 public:
@@ -24,7 +24,8 @@ namespace sbx::ui {
 
 class ui_module : public core::module<ui_module> {
 
-  inline static const auto is_registered = register_module(stage::rendering, dependencies<graphics::graphics_module>{});
+  // Widgets are drawn by the ui subrenderer, the update itself does not touch any shared state
+  inline static const auto is_registered = register_module(stage::rendering, dependencies<graphics::graphics_module>{}, reads<>{});
 
 public:
 
@@ -38,9 +38,12 @@
 #include <string>
 #include <string_view>
 #include <span>
+#include <array>
 #include <iostream>
 #include <concepts>
 #include <cinttypes>
+#include <cstring>
+#include <bit>
 
 namespace sbx::utility {
 
@@ -174,6 +177,97 @@ struct djb2_hash {
 
 }; // struct djb2_hash
 
+/**
+ * @brief Functor that implements the 64-bit xxHash algorithm.
+ *
+ * Processes the input in 32 byte stripes and is considerably faster than fnv1a_hash on large buffers, which makes it the choice for checksums of
+ * file contents.
+ *
+ * @see https://github.com/Cyan4973/xxHash/blob/dev/doc/xxhash_spec.md
+ */
+struct xxhash64 {
+
+  using hash_type = std::uint64_t;
+
+  inline static constexpr auto prime1 = std::uint64_t{0x9e3779b185ebca87};
+  inline static constexpr auto prime2 = std::uint64_t{0xc2b2ae3d27d4eb4f};
+  inline static constexpr auto prime3 = std::uint64_t{0x165667b19e3779f9};
+  inline static constexpr auto prime4 = std::uint64_t{0x85ebca77c2b2ae63};
+  inline static constexpr auto prime5 = std::uint64_t{0x27d4eb2f165667c5};
+
+  /**
+   * @brief Hashes the given bytes.
+   *
+   * @param bytes The bytes to hash.
+   * @param seed The seed of the hash.
+   *
+   * @return hash_type The hash of the bytes.
+   */
+  inline auto operator()(std::span<const char> bytes, const hash_type seed = 0u) const noexcept -> hash_type {
+    const auto* data = bytes.data();
+    const auto* end = data + bytes.size();
+
+    auto hash = hash_type{};
+
+    if (bytes.size() >= 32u) {
+      auto lanes = std::array<hash_type, 4u>{seed + prime1 + prime2, seed + prime2, seed, seed - prime1};
+
+      for (; end - data >= 32; data += 32) {
+        for (auto i = 0u; i < lanes.size(); ++i) {
+          lanes[i] = _round(lanes[i], _read<std::uint64_t>(data + i * 8u));
+        }
+      }
+
+      hash = std::rotl(lanes[0], 1) + std::rotl(lanes[1], 7) + std::rotl(lanes[2], 12) + std::rotl(lanes[3], 18);
+
+      for (const auto lane : lanes) {
+        hash = (hash ^ _round(0u, lane)) * prime1 + prime4;
+      }
+    } else {
+      hash = seed + prime5;
+    }
+
+    hash += bytes.size();
+
+    for (; end - data >= 8; data += 8) {
+      hash = std::rotl(hash ^ _round(0u, _read<std::uint64_t>(data)), 27) * prime1 + prime4;
+    }
+
+    if (end - data >= 4) {
+      hash = std::rotl(hash ^ (static_cast<hash_type>(_read<std::uint32_t>(data)) * prime1), 23) * prime2 + prime3;
+      data += 4;
+    }
+
+    for (; data != end; ++data) {
+      hash = std::rotl(hash ^ (static_cast<hash_type>(static_cast<std::uint8_t>(*data)) * prime5), 11) * prime1;
+    }
+
+    hash ^= hash >> 33u;
+    hash *= prime2;
+    hash ^= hash >> 29u;
+    hash *= prime3;
+    hash ^= hash >> 32u;
+
+    return hash;
+  }
+
+private:
+
+  template<std::unsigned_integral Type>
+  inline static auto _read(const char* data) noexcept -> Type {
+    auto value = Type{};
+
+    std::memcpy(&value, data, sizeof(Type));
+
+    return value;
+  }
+
+  inline static constexpr auto _round(const hash_type accumulator, const hash_type input) noexcept -> hash_type {
+    return std::rotl(accumulator + input * prime2, 31) * prime1;
+  }
+
+}; // struct xxhash64
+
 } // namespace sbx::utility
 
 #endif // LIBSBX_UTILITY_HASH_HPP_
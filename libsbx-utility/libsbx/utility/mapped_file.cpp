@@ -0,0 +1,141 @@
+#include <libsbx/utility/mapped_file.hpp>
+
+#include <utility>
+
+#include <libsbx/utility/target.hpp>
+#include <libsbx/utility/exception.hpp>
+
+#if defined(SBX_WINDOWS)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace sbx::utility {
+
+mapped_file::mapped_file(const std::filesystem::path& path)
+: _path{path},
+  _data{nullptr},
+  _size{0u},
+  _handle{nullptr} {
+#if defined(SBX_WINDOWS)
+  auto file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+  if (file == INVALID_HANDLE_VALUE) {
+    throw utility::runtime_error{"Could not open file '{}'", path.string()};
+  }
+
+  auto size = LARGE_INTEGER{};
+
+  if (!GetFileSizeEx(file, &size)) {
+    CloseHandle(file);
+    throw utility::runtime_error{"Could not query size of file '{}'", path.string()};
+  }
+
+  _size = static_cast<std::size_t>(size.QuadPart);
+
+  if (_size == 0u) {
+    CloseHandle(file);
+    return;
+  }
+
+  auto mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+  CloseHandle(file);
+
+  if (!mapping) {
+    throw utility::runtime_error{"Could not map file '{}'", path.string()};
+  }
+
+  auto* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+
+  if (!view) {
+    CloseHandle(mapping);
+    throw utility::runtime_error{"Could not map file '{}'", path.string()};
+  }
+
+  _data = static_cast<const std::byte*>(view);
+  _handle = mapping;
+#else
+  const auto file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+  if (file < 0) {
+    throw utility::runtime_error{"Could not open file '{}'", path.string()};
+  }
+
+  struct stat status{};
+
+  if (::fstat(file, &status) != 0) {
+    ::close(file);
+    throw utility::runtime_error{"Could not query size of file '{}'", path.string()};
+  }
+
+  _size = static_cast<std::size_t>(status.st_size);
+
+  if (_size == 0u) {
+    ::close(file);
+    return;
+  }
+
+  auto* view = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+
+  // The mapping keeps its own reference to the file
+  ::close(file);
+
+  if (view == MAP_FAILED) {
+    throw utility::runtime_error{"Could not map file '{}'", path.string()};
+  }
+
+  // Loaders read the file front to back
+  ::madvise(view, _size, MADV_SEQUENTIAL);
+
+  _data = static_cast<const std::byte*>(view);
+#endif
+}
+
+mapped_file::mapped_file(mapped_file&& other) noexcept
+: _path{std::move(other._path)},
+  _data{std::exchange(other._data, nullptr)},
+  _size{std::exchange(other._size, 0u)},
+  _handle{std::exchange(other._handle, nullptr)} { }
+
+mapped_file::~mapped_file() {
+  _unmap();
+}
+
+auto mapped_file::operator=(mapped_file&& other) noexcept -> mapped_file& {
+  if (this != &other) {
+    _unmap();
+
+    _path = std::move(other._path);
+    _data = std::exchange(other._data, nullptr);
+    _size = std::exchange(other._size, 0u);
+    _handle = std::exchange(other._handle, nullptr);
+  }
+
+  return *this;
+}
+
+auto mapped_file::_unmap() noexcept -> void {
+  if (!_data) {
+    return;
+  }
+
+#if defined(SBX_WINDOWS)
+  UnmapViewOfFile(_data);
+  CloseHandle(_handle);
+#else
+  ::munmap(const_cast<std::byte*>(_data), _size);
+#endif
+
+  _data = nullptr;
+  _size = 0u;
+  _handle = nullptr;
+}
+
+} // namespace sbx::utility
@@ -0,0 +1,54 @@
+#ifndef LIBSBX_UTILITY_MAPPED_FILE_HPP_
+#define LIBSBX_UTILITY_MAPPED_FILE_HPP_
+
+#include <cstddef>
+#include <span>
+#include <filesystem>
+
+#include <libsbx/utility/noncopyable.hpp>
+
+namespace sbx::utility {
+
+/**
+ * @brief Read-only memory mapping of a whole file. The contents are paged in by the operating system on first access.
+ *
+ * Opening a file that does not exist or cannot be mapped throws a utility::runtime_error. Empty files map to an empty span.
+ */
+class mapped_file final : public noncopyable {
+
+public:
+
+  explicit mapped_file(const std::filesystem::path& path);
+
+  mapped_file(mapped_file&& other) noexcept;
+
+  ~mapped_file();
+
+  auto operator=(mapped_file&& other) noexcept -> mapped_file&;
+
+  [[nodiscard]] auto data() const noexcept -> std::span<const std::byte> {
+    return {_data, _size};
+  }
+
+  [[nodiscard]] auto size() const noexcept -> std::size_t {
+    return _size;
+  }
+
+  [[nodiscard]] auto path() const noexcept -> const std::filesystem::path& {
+    return _path;
+  }
+
+private:
+
+  auto _unmap() noexcept -> void;
+
+  std::filesystem::path _path;
+  const std::byte* _data;
+  std::size_t _size;
+  void* _handle;
+
+}; // class mapped_file
+
+} // namespace sbx::utility
+
+#endif // LIBSBX_UTILITY_MAPPED_FILE_HPP_
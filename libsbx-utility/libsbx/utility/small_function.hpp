@@ -0,0 +1,140 @@
+#ifndef LIBSBX_UTILITY_SMALL_FUNCTION_HPP_
+#define LIBSBX_UTILITY_SMALL_FUNCTION_HPP_
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+namespace sbx::utility {
+
+template<typename Signature, std::size_t Capacity = 48u>
+class small_function;
+
+/**
+ * @brief A move-only type-erased callable that stores callables of up to Capacity bytes inline.
+ *
+ * Larger callables and callables that are not nothrow move constructible are stored on the heap.
+ *
+ * @tparam Return The return type of the call operator.
+ * @tparam Args The argument types of the call operator.
+ * @tparam Capacity Size of the inline storage in bytes.
+ */
+template<typename Return, typename... Args, std::size_t Capacity>
+class small_function<Return(Args...), Capacity> {
+
+  static_assert(Capacity >= sizeof(void*), "Inline storage must be able to hold a pointer");
+
+  struct vtable {
+    Return (*invoke)(void*, Args&&...);
+    void (*move)(void*, void*) noexcept;
+    void (*destroy)(void*) noexcept;
+  }; // struct vtable
+
+  template<typename Callable>
+  inline static constexpr auto is_inline_v = sizeof(Callable) <= Capacity && alignof(Callable) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Callable>;
+
+  template<typename Callable>
+  inline static constexpr auto inline_vtable = vtable{
+    .invoke = [](void* storage, Args&&... args) -> Return {
+      return std::invoke(*static_cast<Callable*>(storage), std::forward<Args>(args)...);
+    },
+    .move = [](void* destination, void* source) noexcept -> void {
+      std::construct_at(static_cast<Callable*>(destination), std::move(*static_cast<Callable*>(source)));
+      std::destroy_at(static_cast<Callable*>(source));
+    },
+    .destroy = [](void* storage) noexcept -> void {
+      std::destroy_at(static_cast<Callable*>(storage));
+    }
+  };
+
+  template<typename Callable>
+  inline static constexpr auto heap_vtable = vtable{
+    .invoke = [](void* storage, Args&&... args) -> Return {
+      return std::invoke(**static_cast<Callable**>(storage), std::forward<Args>(args)...);
+    },
+    .move = [](void* destination, void* source) noexcept -> void {
+      *static_cast<Callable**>(destination) = std::exchange(*static_cast<Callable**>(source), nullptr);
+    },
+    .destroy = [](void* storage) noexcept -> void {
+      delete *static_cast<Callable**>(storage);
+    }
+  };
+
+public:
+
+  inline static constexpr auto capacity = Capacity;
+
+  small_function() noexcept
+  : _vtable{nullptr} { }
+
+  template<typename Callable>
+  requires (!std::is_same_v<std::remove_cvref_t<Callable>, small_function> && std::is_invocable_r_v<Return, std::decay_t<Callable>&, Args...>)
+  small_function(Callable&& callable)
+  : _vtable{nullptr} {
+    using callable_type = std::decay_t<Callable>;
+
+    if constexpr (is_inline_v<callable_type>) {
+      std::construct_at(reinterpret_cast<callable_type*>(_storage), std::forward<Callable>(callable));
+      _vtable = &inline_vtable<callable_type>;
+    } else {
+      *reinterpret_cast<callable_type**>(_storage) = new callable_type{std::forward<Callable>(callable)};
+      _vtable = &heap_vtable<callable_type>;
+    }
+  }
+
+  small_function(const small_function& other) = delete;
+
+  small_function(small_function&& other) noexcept
+  : _vtable{std::exchange(other._vtable, nullptr)} {
+    if (_vtable) {
+      _vtable->move(_storage, other._storage);
+    }
+  }
+
+  ~small_function() {
+    _reset();
+  }
+
+  auto operator=(const small_function& other) -> small_function& = delete;
+
+  auto operator=(small_function&& other) noexcept -> small_function& {
+    if (this != &other) {
+      _reset();
+
+      _vtable = std::exchange(other._vtable, nullptr);
+
+      if (_vtable) {
+        _vtable->move(_storage, other._storage);
+      }
+    }
+
+    return *this;
+  }
+
+  auto operator()(Args... args) -> Return {
+    return _vtable->invoke(_storage, std::forward<Args>(args)...);
+  }
+
+  explicit operator bool() const noexcept {
+    return _vtable != nullptr;
+  }
+
+private:
+
+  auto _reset() noexcept -> void {
+    if (_vtable) {
+      _vtable->destroy(_storage);
+      _vtable = nullptr;
+    }
+  }
+
+  alignas(std::max_align_t) std::byte _storage[Capacity];
+  const vtable* _vtable;
+
+}; // class small_function
+
+} // namespace sbx::utility
+
+#endif // LIBSBX_UTILITY_SMALL_FUNCTION_HPP_
@@ -46,6 +46,7 @@
 #include <libsbx/utility/assert.hpp>
 #include <libsbx/utility/bitmask.hpp>
 #include <libsbx/utility/compression.hpp>
+#include <libsbx/utility/mapped_file.hpp>
 #include <libsbx/utility/concepts.hpp>
 #include <libsbx/utility/enable_private_constructor.hpp>
 #include <libsbx/utility/enum.hpp>
@@ -59,6 +60,7 @@
 #include <libsbx/utility/multimap_key_range.hpp>
 #include <libsbx/utility/overload.hpp>
 #include <libsbx/utility/primitive.hpp>
+#include <libsbx/utility/small_function.hpp>
 #include <libsbx/utility/small_string.hpp>
 #include <libsbx/utility/string_literal.hpp>
 #include <libsbx/utility/target.hpp>